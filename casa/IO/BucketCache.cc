@@ -28,6 +28,10 @@
 #include <casacore/casa/IO/BucketCache.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <utility>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -60,7 +64,12 @@ BucketCache::BucketCache (BucketFile* file, Int64 startOffset,
   its_LRUCounter    (0),
   its_Buffer        (0),
   its_NrOfFree      (0),
-  its_FirstFree     (-1)
+  its_FirstFree     (-1),
+  its_PrefetchSeqnr (0),
+  its_MaxPending    (0),
+  its_SyncBytes     (0),
+  its_Writing       (False),
+  its_StopWriter    (False)
 {
     initStatistics();
     // The bucketsize must be set.
@@ -91,6 +100,10 @@ BucketCache::BucketCache (BucketFile* file, Int64 startOffset,
 
 BucketCache::~BucketCache()
 {
+    // Finish writing the buckets written behind.
+    // An error cannot be reported anymore.
+    stopWriter();
+    its_WriteError = std::exception_ptr();
     // Clear the entire cache.
     // It is not flushed (that should have been done before).
     // In that way no needless flushes are done for a temporary table.
@@ -103,6 +116,15 @@ void BucketCache::clear (uInt fromSlot, Bool doFlush)
     if (doFlush) {
         flush (fromSlot);
     }
+    // Buckets read ahead might be outdated if the entire cache is cleared.
+    // The buckets written behind have to be in the file, because the file
+    // might be removed or reread hereafter.
+    if (fromSlot == 0) {
+        clearPrefetch();
+        std::unique_lock<std::mutex> lock(its_WriteMutex);
+        its_WrittenCond.wait (lock, [this] ()
+                              { return its_WriteQueue.empty() && !its_Writing; });
+    }
     for (uInt i=fromSlot; i<its_CacheSizeUsed; i++) {
 	its_DeleteCallBack (its_Owner, its_Cache[i]);
 	its_Cache[i] = 0;
@@ -130,6 +152,7 @@ Bool BucketCache::flush (uInt fromSlot)
 	    hasWritten = True;
 	}
     }
+    waitWriteBehind();
     return hasWritten;
 }
 
@@ -259,6 +282,7 @@ uInt BucketCache::addBucket (char* data)
 		   CanonicalConversion::canonicalSize (static_cast<Int*>(0)));
 	CanonicalConversion::toLocal (its_FirstFree, its_Buffer);
 	its_NrOfFree--;
+	removePrefetch (bucketNr);
     }else{
 	// No free buckets, so extend the file.
 	// Initialize all uninitialized buckets before the newly added bucket.
@@ -281,6 +305,10 @@ void BucketCache::removeBucket()
     // Thus store the bucket nr of the first free in this bucket
     // and make this bucket the first free.
     uInt bucketNr = its_BucketNr[its_ActualSlot];
+    // An older version of the bucket written behind must not overwrite it.
+    if (its_MaxPending > 0  &&  pendingBucket (bucketNr)) {
+        waitWriteBehind();
+    }
     CanonicalConversion::fromLocal (its_Buffer, its_FirstFree);
     its_file->seek (its_StartOffset + Int64(bucketNr) * its_BucketSize);
     its_file->write (its_Buffer, its_BucketSize);
@@ -350,6 +378,10 @@ void BucketCache::getSlot (uInt bucketNr)
 void BucketCache::writeBucket (uInt slotNr)
 {
 ///    cout << "write " << its_BucketNr[slotNr] << " " << slotNr;
+    if (its_MaxPending > 0) {
+        writeBehindBucket (slotNr);
+        return;
+    }
     its_WriteCallBack (its_Owner, its_Buffer, its_Cache[slotNr]);
     its_file->seek (its_StartOffset +
 		    Int64(its_BucketNr[slotNr]) * its_BucketSize);
@@ -360,12 +392,325 @@ void BucketCache::writeBucket (uInt slotNr)
 void BucketCache::readBucket (uInt slotNr)
 {
 ///    cout << "read " << its_BucketNr[slotNr] << " " << slotNr;
+    // Use the bucket if it is still waiting to be written behind.
+    if (its_MaxPending > 0) {
+        std::shared_ptr<std::vector<char>> data =
+          pendingBucket (its_BucketNr[slotNr]);
+        if (data) {
+            its_Cache[slotNr] = its_ReadCallBack (its_Owner, data->data());
+            nread_p++;
+            return;
+        }
+    }
+    // Use the bucket if read ahead. Do a normal read if that failed.
+    if (! its_Prefetch.empty()) {
+        auto iter = its_Prefetch.find (its_BucketNr[slotNr]);
+        if (iter != its_Prefetch.end()) {
+            std::vector<char> data;
+            try {
+                data = iter->second.data.get();
+            } catch (const std::exception&) {
+                data.clear();
+            }
+            its_Prefetch.erase (iter);
+            if (data.size() == its_BucketSize) {
+                its_Cache[slotNr] = its_ReadCallBack (its_Owner, data.data());
+                nread_p++;
+                return;
+            }
+        }
+    }
     its_file->seek (its_StartOffset +
 		    Int64(its_BucketNr[slotNr]) * its_BucketSize);
     its_file->read (its_Buffer, its_BucketSize);
     its_Cache[slotNr] = its_ReadCallBack (its_Owner, its_Buffer);
     nread_p++;
 }
+void BucketCache::prefetch (const std::vector<uInt>& bucketNrs,
+                            uInt maxPrefetch)
+{
+    if (! its_file->hasConcurrentRead()) {
+        return;
+    }
+    // Remove the administration of the tasks that finished.
+    for (auto iter=its_PrefetchTasks.begin(); iter!=its_PrefetchTasks.end();) {
+        if (iter->wait_for (std::chrono::seconds(0)) ==
+            std::future_status::ready) {
+            iter = its_PrefetchTasks.erase (iter);
+        } else {
+            ++iter;
+        }
+    }
+    // Determine the buckets to be read.
+    std::vector<uInt> wanted;
+    for (uInt bucketNr : bucketNrs) {
+        if (wanted.size() >= maxPrefetch) {
+            break;
+        }
+        if (bucketNr < its_CurNrOfBuckets  &&  its_SlotNr[bucketNr] < 0
+        &&  its_Prefetch.find (bucketNr) == its_Prefetch.end()
+        &&  (its_MaxPending == 0  ||  !pendingBucket (bucketNr))) {
+            wanted.push_back (bucketNr);
+        }
+    }
+    // Buckets read ahead, but never used (e.g. because the access pattern
+    // changed) would block all further read-ahead. So discard the oldest
+    // ones not requested again to make room for the new ones.
+    // Discarding a bucket still being read is fine; the read is finished
+    // in the background.
+    while (its_Prefetch.size() + wanted.size() > maxPrefetch) {
+        auto oldest = its_Prefetch.end();
+        for (auto iter=its_Prefetch.begin(); iter!=its_Prefetch.end(); ++iter) {
+            if ((oldest == its_Prefetch.end()
+                 ||  iter->second.seqnr < oldest->second.seqnr)
+            &&  std::find (bucketNrs.begin(), bucketNrs.end(), iter->first)
+                == bucketNrs.end()) {
+                oldest = iter;
+            }
+        }
+        if (oldest == its_Prefetch.end()) {
+            break;
+        }
+        its_Prefetch.erase (oldest);
+    }
+    // Determine the offsets in the file of the buckets to read.
+    std::vector<std::pair<Int64, std::promise<std::vector<char>>>> todo;
+    for (uInt bucketNr : wanted) {
+        if (its_Prefetch.size() >= maxPrefetch) {
+            break;
+        }
+        std::promise<std::vector<char>> promise;
+        its_Prefetch[bucketNr] = Prefetched{promise.get_future(),
+                                            ++its_PrefetchSeqnr};
+        todo.emplace_back (its_StartOffset + Int64(bucketNr) * its_BucketSize,
+                           std::move(promise));
+    }
+    if (todo.empty()) {
+        return;
+    }
+    nprefetch_p += todo.size();
+    // Read the buckets in order in a single background task.
+    // pread is used, so the file pointer used by the other functions
+    // is not affected.
+    BucketFile* file = its_file;
+    uInt bucketSize  = its_BucketSize;
+    its_PrefetchTasks.push_back
+      (std::async (std::launch::async,
+                   [file, bucketSize, todo=std::move(todo)] () mutable {
+                     for (auto& bucket : todo) {
+                       try {
+                         std::vector<char> data(bucketSize);
+                         file->pread (data.data(), bucketSize, bucket.first);
+                         bucket.second.set_value (std::move(data));
+                       } catch (...) {
+                         bucket.second.set_exception (std::current_exception());
+                       }
+                     }
+                   }));
+}
+
+void BucketCache::readBatch (const std::vector<uInt>& bucketNrs,
+                             uInt maxBatch)
+{
+    std::vector<uInt> todo;
+    for (uInt bucketNr : bucketNrs) {
+        if (todo.size() >= maxBatch) {
+            break;
+        }
+        if (bucketNr < its_CurNrOfBuckets  &&  its_SlotNr[bucketNr] < 0
+        &&  its_Prefetch.find (bucketNr) == its_Prefetch.end()
+        &&  (its_MaxPending == 0  ||  !pendingBucket (bucketNr))) {
+            todo.push_back (bucketNr);
+        }
+    }
+    if (todo.size() < 2) {
+        return;
+    }
+    std::vector<std::vector<char>> data(todo.size());
+    std::vector<BucketFile::BatchRead> reads(todo.size());
+    for (size_t i=0; i<todo.size(); ++i) {
+        data[i].resize (its_BucketSize);
+        reads[i].buffer = data[i].data();
+        reads[i].length = its_BucketSize;
+        reads[i].offset = its_StartOffset + Int64(todo[i]) * its_BucketSize;
+    }
+    its_file->readBatch (reads);
+    nbatch_p += todo.size();
+    // Keep the buckets in the read-ahead buffers.
+    for (size_t i=0; i<todo.size(); ++i) {
+        std::promise<std::vector<char>> promise;
+        its_Prefetch[todo[i]] = Prefetched{promise.get_future(),
+                                           ++its_PrefetchSeqnr};
+        promise.set_value (std::move(data[i]));
+    }
+}
+
+void BucketCache::clearPrefetch()
+{
+    // Destructing a future returned by std::async waits for the task.
+    its_PrefetchTasks.clear();
+    its_Prefetch.clear();
+}
+
+void BucketCache::removePrefetch (uInt bucketNr)
+{
+    auto iter = its_Prefetch.find (bucketNr);
+    if (iter != its_Prefetch.end()) {
+        iter->second.data.wait();
+        its_Prefetch.erase (iter);
+    }
+}
+
+Bool BucketCache::setWriteBehind (uInt maxPending, Int64 syncBytes)
+{
+    // The background thread uses pwrite, so the file pointer used by
+    // the other functions is not affected.
+    if (maxPending > 0
+    &&  !(its_file->hasConcurrentRead()  &&  its_file->isCached())) {
+        return False;
+    }
+    // The thread is started when the first bucket is written behind, so
+    // no thread is used for a cache that is only read.
+    stopWriter();
+    waitWriteBehind();
+    its_FreeBuffers.clear();
+    its_MaxPending = maxPending;
+    its_SyncBytes  = syncBytes;
+    return True;
+}
+
+void BucketCache::waitWriteBehind()
+{
+    std::unique_lock<std::mutex> lock(its_WriteMutex);
+    its_WrittenCond.wait (lock, [this] ()
+                          { return its_WriteQueue.empty() && !its_Writing; });
+    checkWriteError();
+}
+
+void BucketCache::checkWriteError()
+{
+    // The error is kept, so all later writes and flushes fail as well.
+    if (its_WriteError) {
+        try {
+            std::rethrow_exception (its_WriteError);
+        } catch (const std::exception& x) {
+            throw AipsError ("BucketCache: writing a bucket behind in file " +
+                             its_file->name() + " failed: " + x.what());
+        }
+    }
+}
+
+std::shared_ptr<std::vector<char>> BucketCache::pendingBucket (uInt bucketNr)
+{
+    std::lock_guard<std::mutex> lock(its_WriteMutex);
+    auto iter = its_Pending.find (bucketNr);
+    if (iter == its_Pending.end()) {
+        return std::shared_ptr<std::vector<char>>();
+    }
+    return iter->second;
+}
+
+void BucketCache::writeBehindBucket (uInt slotNr)
+{
+    std::shared_ptr<std::vector<char>> data;
+    {
+        // Wait until there is room in the queue.
+        std::unique_lock<std::mutex> lock(its_WriteMutex);
+        checkWriteError();
+        if (its_WriteQueue.size() >= its_MaxPending) {
+            nwritewait_p++;
+            its_WrittenCond.wait (lock, [this] ()
+                                  { return its_WriteQueue.size() < its_MaxPending
+                                      || its_WriteError; });
+            checkWriteError();
+        }
+        if (! its_FreeBuffers.empty()) {
+            data = std::move (its_FreeBuffers.back());
+            its_FreeBuffers.pop_back();
+        }
+    }
+    // Convert outside the lock, so the background thread can continue.
+    if (! data) {
+        data = std::make_shared<std::vector<char>> (its_BucketSize);
+    }
+    its_WriteCallBack (its_Owner, data->data(), its_Cache[slotNr]);
+    uInt bucketNr = its_BucketNr[slotNr];
+    if (! its_Writer.joinable()) {
+        its_StopWriter = False;
+        its_Writer = std::thread (&BucketCache::runWriter, this);
+    }
+    {
+        std::lock_guard<std::mutex> lock(its_WriteMutex);
+        its_Pending[bucketNr] = data;
+        its_WriteQueue.push_back (PendingWrite{bucketNr, std::move(data)});
+    }
+    its_WriteCond.notify_one();
+    its_Dirty[slotNr] = 0;
+    nwrite_p++;
+    nwritebehind_p++;
+}
+
+void BucketCache::stopWriter()
+{
+    if (its_Writer.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(its_WriteMutex);
+            its_StopWriter = True;
+        }
+        its_WriteCond.notify_one();
+        its_Writer.join();
+    }
+    its_MaxPending = 0;
+}
+
+void BucketCache::runWriter()
+{
+    Int64 nrUnsynced = 0;
+    std::unique_lock<std::mutex> lock(its_WriteMutex);
+    while (True) {
+        its_WriteCond.wait (lock, [this] ()
+                            { return !its_WriteQueue.empty() || its_StopWriter; });
+        // Only stop after all buckets are written.
+        if (its_WriteQueue.empty()) {
+            break;
+        }
+        PendingWrite pending = std::move (its_WriteQueue.front());
+        its_WriteQueue.pop_front();
+        its_Writing = True;
+        its_WrittenCond.notify_all();
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+            its_file->pwrite (pending.data->data(), its_BucketSize,
+                              its_StartOffset +
+                              Int64(pending.bucketNr) * its_BucketSize);
+            nrUnsynced += its_BucketSize;
+            if (its_SyncBytes > 0  &&  nrUnsynced >= its_SyncBytes) {
+                its_file->fsync();
+                nrUnsynced = 0;
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+        lock.lock();
+        if (error  &&  !its_WriteError) {
+            its_WriteError = error;
+        }
+        // The bucket is not pending anymore, unless a newer version of it
+        // is waiting to be written.
+        auto iter = its_Pending.find (pending.bucketNr);
+        if (iter != its_Pending.end()  &&  iter->second == pending.data) {
+            its_Pending.erase (iter);
+        }
+        if (pending.data.use_count() == 1
+        &&  its_FreeBuffers.size() < its_MaxPending) {
+            its_FreeBuffers.push_back (std::move (pending.data));
+        }
+        its_Writing = False;
+        its_WrittenCond.notify_all();
+    }
+}
+
 void BucketCache::initializeBuckets (uInt bucketNr)
 {
     // Initialize this bucket and all uninitialized ones before it.
@@ -401,6 +746,16 @@ void BucketCache::showStatistics (ostream& os) const
     if (nwrite_p > 0) {
 	os << "#writes:   " << nwrite_p << endl;
     }
+    if (nprefetch_p > 0) {
+	os << "#prefetch: " << nprefetch_p << endl;
+    }
+    if (nbatch_p > 0) {
+	os << "#batched:  " << nbatch_p << endl;
+    }
+    if (nwritebehind_p > 0) {
+	os << "#wbehind:  " << nwritebehind_p
+	   << "         (#waits: " << nwritewait_p << ")" << endl;
+    }
     os << "#accesses: " << naccess_p;
     if (naccess_p > 0) {
 	os << "        hit-rate:  "
@@ -416,6 +771,10 @@ void BucketCache::initStatistics()
     nread_p   = 0;
     ninit_p   = 0;
     nwrite_p  = 0;
+    nprefetch_p = 0;
+    nbatch_p    = 0;
+    nwritebehind_p = 0;
+    nwritewait_p   = 0;
 }
 
 } //# NAMESPACE CASACORE - END
@@ -31,6 +31,15 @@
 #include <casacore/casa/IO/BucketFile.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/OS/CanonicalConversion.h>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 //# Forward clarations
 #include <casacore/casa/iosfwd.h>
@@ -141,6 +150,35 @@ typedef void (*BucketCacheDeleteBuffer) (void* ownerObject, char* buffer);
 // <p>
 // Statistics are kept to know how efficient the cache is working.
 // It is possible to initialize and show the statistics.
+// <p>
+// Buckets can be read ahead asynchronously using function
+// <src>prefetch</src>. A background thread reads them (in external format)
+// into separate buffers, so disk latency overlaps with the computations
+// done by the caller. When such a bucket is acquired by
+// <src>getBucket</src>, it is taken from its buffer (waiting for the read
+// to finish if needed) instead of being read from the file.
+// Read-ahead is only done if the BucketFile supports concurrent reads.
+// <br>
+// Function <src>readBatch</src> is similar, but reads the buckets
+// synchronously using <src>BucketFile::readBatch</src>, so the buckets
+// needed for an access can be read using only a few system calls.
+// <p>
+// Optionally dirty buckets are written behind using function
+// <src>setWriteBehind</src>. A bucket that has to be written (because its
+// slot is needed for another bucket) is converted to external format and
+// handed to a background thread that writes it into the file, so the
+// caller does not have to wait for the disk. The number of buckets waiting
+// to be written is bounded; only when that number is reached, the caller
+// waits until the background thread has written a bucket. A bucket that is
+// reacquired before it is written, is taken from its pending buffer.
+// Function <src>flush</src> (and <src>clear</src>) wait until all buckets
+// are written, so after a flush the file is up-to-date as usual.
+// The background thread can also fsync the file regularly (after a given
+// number of bytes), which avoids a large amount of dirty pages in the
+// kernel's file cache that have to be written at the next explicit fsync.
+// An error in the background thread is reported as an exception by the
+// next write or flush.
+// Write-behind is only done if the BucketFile supports concurrent IO.
 // </synopsis> 
 
 // <motivation>
@@ -311,6 +349,48 @@ public:
     // Get the number of free buckets.
     uInt nFreeBucket() const;
 
+    // Start reading the given buckets in the background.
+    // Buckets that are already cached, already being read ahead or
+    // not in the file yet are skipped. At most <src>maxPrefetch</src>
+    // buckets are kept. If needed, the oldest buckets read ahead that were
+    // not used and are not requested again are discarded to make room.
+    // Nothing is done if the file does not support concurrent reads.
+    void prefetch (const std::vector<uInt>& bucketNrs, uInt maxPrefetch);
+
+    // Read the given buckets in a single batch (using
+    // <src>BucketFile::readBatch</src>) and keep them like buckets read
+    // ahead until they are acquired by <src>getBucket</src>.
+    // Buckets that are already cached, already being read ahead or
+    // not in the file yet are skipped. At most <src>maxBatch</src>
+    // buckets are read. Nothing is done if fewer than 2 buckets have
+    // to be read.
+    void readBatch (const std::vector<uInt>& bucketNrs, uInt maxBatch);
+
+    // Wait for the buckets being read ahead and discard them.
+    void clearPrefetch();
+
+    // Get the number of buckets being read ahead.
+    uInt nPrefetch() const;
+
+    // Write dirty buckets behind using a background thread.
+    // At most <src>maxPending</src> buckets can wait to be written.
+    // If <src>syncBytes</src> is positive, the background thread fsyncs
+    // the file after every <src>syncBytes</src> bytes written.
+    // A zero <src>maxPending</src> switches write-behind off (after waiting
+    // until all pending buckets are written).
+    // It returns False if write-behind is not possible for the file, in
+    // which case buckets are written synchronously.
+    Bool setWriteBehind (uInt maxPending, Int64 syncBytes=0);
+
+    // Get the maximum number of buckets waiting to be written behind.
+    // 0 means that write-behind is not used.
+    uInt writeBehind() const;
+
+    // Wait until all buckets written behind are in the file.
+    // An exception is thrown if the background thread failed to write
+    // a bucket.
+    void waitWriteBehind();
+
     // (Re)initialize the cache statistics.
     void initStatistics();
 
@@ -367,6 +447,51 @@ private:
     uInt nread_p;
     uInt ninit_p;
     uInt nwrite_p;
+    uInt nprefetch_p;
+    uInt nbatch_p;
+    // A bucket being read ahead (in external format). The sequence number
+    // tells the order in which the buckets were requested.
+    struct Prefetched {
+      std::future<std::vector<char>> data;
+      uInt64 seqnr;
+    };
+    // The buckets being read ahead.
+    std::map<uInt, Prefetched> its_Prefetch;
+    // The sequence number of the last bucket read ahead.
+    uInt64 its_PrefetchSeqnr;
+    // The background tasks reading the buckets ahead.
+    std::vector<std::future<void>> its_PrefetchTasks;
+    // A bucket (in external format) waiting to be written behind.
+    struct PendingWrite {
+      uInt bucketNr;
+      std::shared_ptr<std::vector<char>> data;
+    };
+    // The maximum number of buckets waiting to be written (0 = no
+    // write-behind).
+    uInt its_MaxPending;
+    // The number of bytes after which the background thread does an fsync.
+    Int64 its_SyncBytes;
+    // The buckets waiting to be written, in order of writing.
+    std::deque<PendingWrite> its_WriteQueue;
+    // The last pending version of the buckets waiting to be written.
+    // It also contains the bucket being written by the background thread.
+    std::map<uInt, std::shared_ptr<std::vector<char>>> its_Pending;
+    // Buffers that can be reused for the buckets to write.
+    std::vector<std::shared_ptr<std::vector<char>>> its_FreeBuffers;
+    // Is the background thread writing a bucket?
+    Bool its_Writing;
+    // Should the background thread stop?
+    Bool its_StopWriter;
+    // The first error in the background thread.
+    std::exception_ptr its_WriteError;
+    std::mutex its_WriteMutex;
+    // Signals a new bucket to write or a stop request.
+    std::condition_variable its_WriteCond;
+    // Signals that a bucket has been written.
+    std::condition_variable its_WrittenCond;
+    std::thread its_Writer;
+    uInt nwritebehind_p;
+    uInt nwritewait_p;
 
 
     // Copy constructor is not possible.
@@ -385,8 +510,29 @@ private:
     void writeBucket (uInt slotNr);
 
     // Read a bucket.
+    // It is taken from the read-ahead buffers if prefetched.
     void readBucket (uInt slotNr);
 
+    // Discard a possible read-ahead of the given bucket.
+    void removePrefetch (uInt bucketNr);
+
+    // Hand a bucket to the background thread writing it.
+    void writeBehindBucket (uInt slotNr);
+
+    // Get the pending buffer of a bucket waiting to be written.
+    // A null pointer is returned if the bucket is not pending.
+    std::shared_ptr<std::vector<char>> pendingBucket (uInt bucketNr);
+
+    // Throw an exception if the background thread failed.
+    // The lock on its_WriteMutex must be held.
+    void checkWriteError();
+
+    // Stop the background writing thread (after writing all buckets).
+    void stopWriter();
+
+    // The function executed by the background writing thread.
+    void runWriter();
+
     // Initialize the bucket buffer.
     // The uninitialized buckets before this bucket are also initialized.
     // It returns a pointer to the buffer.
@@ -407,6 +553,12 @@ inline Int BucketCache::firstFreeBucket() const
 inline uInt BucketCache::nFreeBucket() const
     { return its_NrOfFree; }
 
+inline uInt BucketCache::nPrefetch() const
+    { return its_Prefetch.size(); }
+
+inline uInt BucketCache::writeBehind() const
+    { return its_MaxPending; }
+
 
 
 
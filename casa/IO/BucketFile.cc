@@ -30,6 +30,7 @@
 #include <casacore/casa/IO/MMapfdIO.h>
 #include <casacore/casa/IO/FilebufIO.h>
 #include <casacore/casa/IO/MFFileIO.h>
+#include <casacore/casa/IO/RegularFileIO.h>
 #include <casacore/casa/OS/Path.h>
 #include <casacore/casa/OS/DOos.h>
 #include <casacore/casa/Logging/LogIO.h>
@@ -37,9 +38,17 @@
 #include <casacore/casa/Exceptions/Error.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <sys/uio.h>              // needed for preadv
 #include <fcntl.h>
+#include <limits.h>               // needed for IOV_MAX
+#include <stdlib.h>               // needed for posix_memalign
 #include <errno.h>                // needed for errno
 #include <casacore/casa/string.h>          // needed for strerror
+#include <algorithm>
+#include <cstring>
+
+//# The alignment needed for O_DIRECT.
+#define bf_od_align (Int64(4096))
 
 #if defined(AIPS_DARWIN) || defined(AIPS_BSD)
 #undef trace3OPEN
@@ -63,7 +72,9 @@ BucketFile::BucketFile (const String& fileName,
   file_p         (),
   mappedFile_p   (0),
   bufferedFile_p (0),
-  mfile_p        (mfile)
+  mfile_p        (mfile),
+  directRead_p   (False),
+  directFd_p     (-1)
 {
     // Create the file.
     if (mfile_p) {
@@ -88,7 +99,9 @@ BucketFile::BucketFile (const String& fileName, Bool isWritable,
   file_p         (),
   mappedFile_p   (0),
   bufferedFile_p (0),
-  mfile_p        (mfile)
+  mfile_p        (mfile),
+  directRead_p   (False),
+  directFd_p     (-1)
 {
   if (mfile_p) {
     isMapped_p = False;
@@ -112,6 +125,10 @@ std::shared_ptr<ByteIO> BucketFile::makeFilebufIO (uInt bufferSize)
 
 void BucketFile::close()
 {
+    if (directFd_p >= 0) {
+        FiledesIO::close (directFd_p);
+        directFd_p = -1;
+    }
     if (file_p) {
         deleteMapBuf();
 	file_p.reset();
@@ -203,6 +220,150 @@ uInt BucketFile::read (void* buffer, uInt length)
   return file_p->read (length, buffer);
 }
 
+uInt BucketFile::pread (void* buffer, uInt length, Int64 offset)
+{
+  return file_p->pread (length, offset, buffer);
+}
+
+void BucketFile::pwrite (const void* buffer, uInt length, Int64 offset)
+{
+  file_p->pwrite (length, offset, buffer);
+}
+
+void BucketFile::setDirectRead (Bool directRead)
+{
+#ifdef HAVE_O_DIRECT
+    directRead_p = directRead  &&  !mfile_p;
+#else
+    directRead_p = False;
+#endif
+}
+
+void BucketFile::readBatch (const std::vector<BatchRead>& reads)
+{
+    // Sort the pieces on file offset.
+    std::vector<const BatchRead*> sorted;
+    sorted.reserve (reads.size());
+    for (const BatchRead& rd : reads) {
+        if (rd.length > 0) {
+            sorted.push_back (&rd);
+        }
+    }
+    std::sort (sorted.begin(), sorted.end(),
+               [](const BatchRead* left, const BatchRead* right)
+               { return left->offset < right->offset; });
+    // A MultiFileBase does not have a file descriptor, so read piecewise.
+    if (fd_p < 0) {
+        for (const BatchRead* rd : sorted) {
+            file_p->pread (rd->length, rd->offset, rd->buffer);
+        }
+        return;
+    }
+    // Read adjacent pieces jointly.
+    size_t first = 0;
+    while (first < sorted.size()) {
+        Int64 end = sorted[first]->offset + sorted[first]->length;
+        size_t last = first + 1;
+        while (last < sorted.size()  &&  last - first < IOV_MAX
+               &&  sorted[last]->offset == end) {
+            end += sorted[last]->length;
+            last++;
+        }
+        if (directRead_p) {
+            readDirect (sorted, first, last);
+        } else {
+            readVectored (sorted, first, last);
+        }
+        first = last;
+    }
+}
+
+void BucketFile::readVectored (const std::vector<const BatchRead*>& reads,
+                               size_t first, size_t last)
+{
+    std::vector<iovec> iov(last - first);
+    for (size_t i=first; i<last; ++i) {
+        iov[i-first].iov_base = reads[i]->buffer;
+        iov[i-first].iov_len  = reads[i]->length;
+    }
+    Int64 offset = reads[first]->offset;
+    iovec* iovPtr = iov.data();
+    int nrIov = iov.size();
+    // Continue after a short read.
+    while (nrIov > 0) {
+        ssize_t nr = ::preadv (fd_p, iovPtr, nrIov, offset);
+        if (nr < 0  &&  errno == EINTR) {
+            continue;
+        }
+        if (nr <= 0) {
+            throw AipsError ("BucketFile::readBatch " + name_p +
+                             (nr < 0 ?
+                              " - error returned by system call: " +
+                              String(strerror(errno)) :
+                              String(" - premature end-of-file")));
+        }
+        offset += nr;
+        while (nrIov > 0  &&  size_t(nr) >= iovPtr->iov_len) {
+            nr -= iovPtr->iov_len;
+            iovPtr++;
+            nrIov--;
+        }
+        if (nr > 0) {
+            iovPtr->iov_base = static_cast<char*>(iovPtr->iov_base) + nr;
+            iovPtr->iov_len -= nr;
+        }
+    }
+}
+
+void BucketFile::readDirect (const std::vector<const BatchRead*>& reads,
+                             size_t first, size_t last)
+{
+    if (directFd_p < 0) {
+        directFd_p = RegularFileIO::openCreate (RegularFile(name_p),
+                                                ByteIO::Old, True);
+    }
+    // O_DIRECT requires the offset, size and buffer to be aligned.
+    Int64 start  = reads[first]->offset;
+    Int64 end    = reads[last-1]->offset + reads[last-1]->length;
+    Int64 astart = start / bf_od_align * bf_od_align;
+    Int64 aend   = (end + bf_od_align - 1) / bf_od_align * bf_od_align;
+    void* buf;
+    if (posix_memalign (&buf, bf_od_align, aend - astart) != 0) {
+        throw AipsError ("BucketFile::readBatch " + name_p +
+                         " - could not allocate aligned buffer");
+    }
+    std::unique_ptr<char, void(*)(void*)> buffer(static_cast<char*>(buf),
+                                                 free);
+    // Read until the data needed are there. A read near the end of the file
+    // will be shorter than requested.
+    Int64 nrdone = 0;
+    while (astart + nrdone < end) {
+        ssize_t nr = ::tracePREAD (directFd_p, buffer.get() + nrdone,
+                                   aend - astart - nrdone, astart + nrdone);
+        if (nr < 0  &&  errno == EINTR) {
+            continue;
+        }
+        if (nr < 0) {
+            throw AipsError ("BucketFile::readBatch " + name_p +
+                             " - error returned by system call: " +
+                             String(strerror(errno)));
+        }
+        nrdone += nr;
+        // Stop at end-of-file or if a next read would be unaligned.
+        if (nr == 0  ||  nrdone % bf_od_align != 0) {
+            break;
+        }
+    }
+    if (astart + nrdone < end) {
+        throw AipsError ("BucketFile::readBatch " + name_p +
+                         " - premature end-of-file");
+    }
+    for (size_t i=first; i<last; ++i) {
+        memcpy (reads[i]->buffer, buffer.get() + (reads[i]->offset - astart),
+                reads[i]->length);
+    }
+}
+
 uInt BucketFile::write (const void* buffer, uInt length)
 {
   file_p->write (length, buffer);
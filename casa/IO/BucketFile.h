@@ -34,6 +34,7 @@
 #include <casacore/casa/BasicSL/String.h>
 #include <unistd.h>
 #include <memory>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -77,6 +78,13 @@ class MultiFileBase;
 //       the access using the FilebufIO member.
 // </ul>
 // A MultiFileBase file can only be accessed in the unbuffered way.
+// <p>
+// Function <src>readBatch</src> reads many pieces (e.g. tiles) of the file
+// at once. The pieces are sorted on file offset and adjacent pieces are
+// read with a single vectored read (<src>preadv</src>), so only a few system
+// calls are needed. Optionally the batched reads can be done with O_DIRECT
+// (using a separate file descriptor), which is meant for huge sequential
+// scans that should not pollute the kernel's file cache.
 // </synopsis> 
 
 // <motivation>
@@ -170,6 +178,39 @@ public:
     // Read bytes from the file.
     virtual uInt read (void* buffer, uInt length);
 
+    // Read bytes from the file at the given offset.
+    // It does not use nor change the file pointer, so it can be done
+    // by another thread while the file is used in the normal way
+    // (provided <src>hasConcurrentRead()</src> is True).
+    virtual uInt pread (void* buffer, uInt length, Int64 offset);
+
+    // Write bytes into the file at the given offset.
+    // Like <src>pread</src>, it does not use nor change the file pointer.
+    virtual void pwrite (const void* buffer, uInt length, Int64 offset);
+
+    // Description of a piece of the file to be read by <src>readBatch</src>.
+    struct BatchRead {
+      // The buffer to read into.
+      void*  buffer;
+      // The number of bytes to read.
+      uInt   length;
+      // The offset in the file.
+      Int64  offset;
+    };
+
+    // Read a batch of pieces of the file. The pieces can be given in any
+    // order. Like <src>pread</src>, it does not use nor change the file
+    // pointer. An exception is thrown if a piece cannot be read entirely.
+    virtual void readBatch (const std::vector<BatchRead>& reads);
+
+    // Tell if <src>readBatch</src> should use O_DIRECT to bypass the
+    // kernel's file cache. It is ignored for a MultiFileBase or if the
+    // OS does not support O_DIRECT.
+    // <group>
+    void setDirectRead (Bool directRead);
+    Bool directRead() const;
+    // </group>
+
     // Write bytes into the file.
     virtual uInt write (const void* buffer, uInt length);
 
@@ -190,6 +231,11 @@ public:
     Bool isBuffered() const;
     // </group>
 
+    // Can <src>pread</src> and <src>pwrite</src> be used concurrently with
+    // the other IO functions?
+    // This is only possible for an ordinary file (not for a MultiFileBase).
+    Bool hasConcurrentRead() const;
+
 private:
     // The file name.
     String name_p;
@@ -206,6 +252,10 @@ private:
     FilebufIO* bufferedFile_p;
     // The possibly used MultiFileBase.
     std::shared_ptr<MultiFileBase> mfile_p;
+    // Use O_DIRECT for readBatch?
+    Bool directRead_p;
+    // The fd of the file opened with O_DIRECT (opened when first needed).
+    int  directFd_p;
 	    
 
     // Create the mapped or buffered file object.
@@ -213,6 +263,16 @@ private:
 
     // Delete the possible mapped or buffered file object.
     void deleteMapBuf();
+
+    // Read a group of adjacent pieces (in the sorted vector from index
+    // <src>first</src> till <src>last</src>) in the normal way or using
+    // O_DIRECT.
+    // <group>
+    void readVectored (const std::vector<const BatchRead*>& reads,
+                       size_t first, size_t last);
+    void readDirect (const std::vector<const BatchRead*>& reads,
+                     size_t first, size_t last);
+    // </group>
 };
 
 
@@ -231,6 +291,10 @@ inline Bool BucketFile::isMapped() const
     { return isMapped_p; }
 inline Bool BucketFile::isBuffered() const
     { return bufSize_p>0; }
+inline Bool BucketFile::hasConcurrentRead() const
+    { return fd_p >= 0  &&  !mfile_p; }
+inline Bool BucketFile::directRead() const
+    { return directRead_p; }
 
 
 } //# NAMESPACE CASACORE - END
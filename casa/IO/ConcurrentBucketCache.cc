@@ -0,0 +1,407 @@
+//# ConcurrentBucketCache.cc: Thread-safe cache for buckets in a part of a file
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+
+//# Includes
+#include <casacore/casa/IO/ConcurrentBucketCache.h>
+#include <casacore/casa/IO/BucketFile.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/iostream.h>
+#include <algorithm>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+ConcurrentBucketCache::ConcurrentBucketCache
+                          (BucketFile* file, Int64 startOffset,
+                           uInt bucketSize, uInt nrOfBuckets,
+                           uInt cacheSize, void* ownerObject,
+                           BucketCacheToLocal readCallBack,
+                           BucketCacheFromLocal writeCallBack,
+                           BucketCacheAddBuffer initCallBack,
+                           BucketCacheDeleteBuffer deleteCallBack,
+                           uInt nrShards)
+: itsFile           (file),
+  itsOwner          (ownerObject),
+  itsReadCallBack   (readCallBack),
+  itsWriteCallBack  (writeCallBack),
+  itsInitCallBack   (initCallBack),
+  itsDeleteCallBack (deleteCallBack),
+  itsStartOffset    (startOffset),
+  itsBucketSize     (bucketSize),
+  itsCurNrOfBuckets (0),
+  itsNewNrOfBuckets (nrOfBuckets),
+  itsCacheSize      (0),
+  itsLRUCounter     (0)
+{
+    initStatistics();
+    // The bucketsize must be set.
+    if (bucketSize == 0) {
+	throw (AipsError ("ConcurrentBucketCache::ConcurrentBucketCache; "
+                          "bucketsize=0"));
+    }
+    // There should be at least one shard.
+    // Note that resize ensures each shard can contain a bucket.
+    if (nrShards == 0) {
+        nrShards = 1;
+    }
+    itsShards.reserve (nrShards);
+    for (uInt i=0; i<nrShards; i++) {
+        itsShards.push_back (std::unique_ptr<Shard> (new Shard));
+    }
+    resize (cacheSize);
+    // Open the file if not open yet and get its physical size.
+    // Use that to determine the number of buckets in the file.
+    itsFile->open();
+    Int64 size = itsFile->fileSize();
+    if (size > startOffset) {
+        uInt nrb = (size - startOffset) / bucketSize;
+	itsCurNrOfBuckets = std::min (nrb, nrOfBuckets);
+    }
+}
+
+ConcurrentBucketCache::~ConcurrentBucketCache()
+{
+    // Delete the buckets in the cache.
+    // They are not flushed (that should have been done before).
+    for (auto& shard : itsShards) {
+        for (auto& bucket : shard->buckets) {
+            if (bucket.second->data != 0) {
+                itsDeleteCallBack (itsOwner, bucket.second->data);
+            }
+        }
+    }
+}
+
+
+PinnedBucket ConcurrentBucketCache::getBucket (uInt bucketNr)
+{
+    if (bucketNr >= itsNewNrOfBuckets) {
+	throw (indexError<Int> (bucketNr));
+    }
+    naccess_p++;
+    Shard& shard = getShard (bucketNr);
+    std::unique_lock<std::mutex> lock(shard.mutex);
+    auto iter = shard.buckets.find (bucketNr);
+    if (iter != shard.buckets.end()) {
+        // The bucket is in the cache, but might still be read by
+        // another thread, so wait for it.
+        Entry* entry = iter->second.get();
+        entry->nrPin++;
+        entry->lastUsed = ++itsLRUCounter;
+        shard.loaded.wait (lock, [entry]{ return !entry->loading; });
+        if (entry->data == 0) {
+            // Reading the bucket failed in the other thread.
+            if (--entry->nrPin == 0) {
+                shard.buckets.erase (bucketNr);
+            }
+            throw AipsError ("ConcurrentBucketCache::getBucket: bucket " +
+                             String::toString(bucketNr) +
+                             " could not be read");
+        }
+        return PinnedBucket (this, entry);
+    }
+    // Not in the cache, so make room for it and add an empty entry
+    // telling it is being read.
+    makeRoom (shard, shard.capacity);
+    Entry* entry = new Entry;
+    entry->data     = 0;
+    entry->bucketNr = bucketNr;
+    entry->nrPin    = 1;
+    entry->dirty    = False;
+    entry->loading  = True;
+    entry->lastUsed = ++itsLRUCounter;
+    shard.buckets[bucketNr] = std::unique_ptr<Entry> (entry);
+    // Read the bucket without holding the lock, so other threads can
+    // use the shard meanwhile.
+    lock.unlock();
+    try {
+        loadBucket (entry);
+    } catch (...) {
+        lock.lock();
+        entry->loading = False;
+        if (--entry->nrPin == 0) {
+            shard.buckets.erase (bucketNr);
+        }
+        shard.loaded.notify_all();
+        throw;
+    }
+    lock.lock();
+    entry->loading = False;
+    shard.loaded.notify_all();
+    return PinnedBucket (this, entry);
+}
+
+void ConcurrentBucketCache::loadBucket (Entry* entry)
+{
+    uInt bucketNr = entry->bucketNr;
+    // Get a new initialized bucket if not in the file yet.
+    // It is written (and the buckets before it initialized) when flushed.
+    if (bucketNr >= itsCurNrOfBuckets) {
+        if (! itsFile->isWritable()) {
+            throw AipsError ("ConcurrentBucketCache::getBucket: bucket " +
+                             String::toString(bucketNr) +
+                             " exceeds nr of buckets");
+        }
+        entry->data  = itsInitCallBack (itsOwner);
+        entry->dirty = True;
+        ninit_p++;
+        return;
+    }
+    std::vector<char> buffer(itsBucketSize);
+    Int64 offset = itsStartOffset + Int64(bucketNr) * itsBucketSize;
+    if (itsFile->hasConcurrentRead()) {
+        itsFile->pread (buffer.data(), itsBucketSize, offset);
+    } else {
+        std::lock_guard<std::mutex> lock(itsFileMutex);
+        itsFile->seek (offset);
+        itsFile->read (buffer.data(), itsBucketSize);
+    }
+    entry->data = itsReadCallBack (itsOwner, buffer.data());
+    nread_p++;
+}
+
+void ConcurrentBucketCache::writeBucket (Entry* entry)
+{
+    std::vector<char> buffer(itsBucketSize, 0);
+    itsWriteCallBack (itsOwner, buffer.data(), entry->data);
+    std::lock_guard<std::mutex> lock(itsFileMutex);
+    // Initialize all uninitialized buckets before this one.
+    initializeBuckets (entry->bucketNr);
+    writeExternal (entry->bucketNr, buffer.data());
+    if (entry->bucketNr >= itsCurNrOfBuckets) {
+        itsCurNrOfBuckets = entry->bucketNr + 1;
+    }
+    entry->dirty = False;
+    nwrite_p++;
+}
+
+void ConcurrentBucketCache::initializeBuckets (uInt bucketNr)
+{
+    if (itsCurNrOfBuckets >= bucketNr) {
+        return;
+    }
+    std::vector<char> buffer(itsBucketSize, 0);
+    char* data = itsInitCallBack (itsOwner);
+    itsWriteCallBack (itsOwner, buffer.data(), data);
+    itsDeleteCallBack (itsOwner, data);
+    // Buckets in the cache that are part of this range are dirty,
+    // so they will be written thereafter.
+    for (uInt i=itsCurNrOfBuckets; i<bucketNr; i++) {
+        writeExternal (i, buffer.data());
+        ninit_p++;
+    }
+    itsCurNrOfBuckets = bucketNr;
+}
+
+void ConcurrentBucketCache::writeExternal (uInt bucketNr,
+                                           const char* external)
+{
+    itsFile->seek (itsStartOffset + Int64(bucketNr) * itsBucketSize);
+    itsFile->write (external, itsBucketSize);
+}
+
+void ConcurrentBucketCache::makeRoom (Shard& shard, uInt maxSize)
+{
+    while (shard.buckets.size() >= maxSize) {
+        // Find the least recently used bucket that can be removed.
+        auto lru = shard.buckets.end();
+        for (auto iter=shard.buckets.begin(); iter!=shard.buckets.end();
+             ++iter) {
+            const Entry& entry = *iter->second;
+            if (entry.nrPin == 0  &&  !entry.loading
+            &&  (lru == shard.buckets.end()
+                 ||  entry.lastUsed < lru->second->lastUsed)) {
+                lru = iter;
+            }
+        }
+        // Let the shard grow if all buckets are pinned.
+        if (lru == shard.buckets.end()) {
+            break;
+        }
+        Entry* entry = lru->second.get();
+        if (entry->dirty) {
+            writeBucket (entry);
+        }
+        itsDeleteCallBack (itsOwner, entry->data);
+        shard.buckets.erase (lru);
+    }
+}
+
+void ConcurrentBucketCache::unpin (Entry* entry)
+{
+    Shard& shard = getShard (entry->bucketNr);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    entry->nrPin--;
+}
+
+void ConcurrentBucketCache::setDirty (Entry* entry)
+{
+    Shard& shard = getShard (entry->bucketNr);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    entry->dirty = True;
+}
+
+
+Bool ConcurrentBucketCache::flush()
+{
+    Bool hasWritten = False;
+    for (auto& shard : itsShards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (auto& bucket : shard->buckets) {
+            Entry* entry = bucket.second.get();
+            // A pinned bucket is skipped, because its data can be changed
+            // by another thread while writing it. It stays dirty, so it is
+            // written by a later flush or when removed from the cache.
+            if (entry->dirty  &&  !entry->loading  &&  entry->nrPin == 0) {
+                writeBucket (entry);
+                hasWritten = True;
+            }
+        }
+    }
+    // Initialize the remaining buckets.
+    std::lock_guard<std::mutex> lock(itsFileMutex);
+    initializeBuckets (itsNewNrOfBuckets);
+    return hasWritten;
+}
+
+void ConcurrentBucketCache::clear (Bool doFlush)
+{
+    if (doFlush) {
+        flush();
+    }
+    for (auto& shard : itsShards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (auto iter=shard->buckets.begin(); iter!=shard->buckets.end();) {
+            Entry* entry = iter->second.get();
+            if (entry->nrPin == 0  &&  !entry->loading) {
+                itsDeleteCallBack (itsOwner, entry->data);
+                iter = shard->buckets.erase (iter);
+            } else {
+                ++iter;
+            }
+        }
+    }
+}
+
+void ConcurrentBucketCache::resize (uInt cacheSize)
+{
+    // The cache must contain at least one slot per shard.
+    if (cacheSize < itsShards.size()) {
+        cacheSize = itsShards.size();
+    }
+    itsCacheSize = cacheSize;
+    uInt nshard = itsShards.size();
+    for (uInt i=0; i<nshard; i++) {
+        Shard& shard = *itsShards[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        // Spread the remainder over the first shards.
+        shard.capacity = cacheSize / nshard + (i < cacheSize%nshard ? 1:0);
+        makeRoom (shard, shard.capacity + 1);
+    }
+}
+
+void ConcurrentBucketCache::resync (uInt nrBucket)
+{
+    // Clear the entire cache, so data will be reread.
+    // Set it to the new size.
+    clear();
+    if (nrBucket > itsNewNrOfBuckets) {
+	extend (nrBucket - itsNewNrOfBuckets);
+    }
+    itsCurNrOfBuckets = nrBucket;
+}
+
+void ConcurrentBucketCache::extend (uInt nrBucket)
+{
+    itsNewNrOfBuckets += nrBucket;
+}
+
+
+void ConcurrentBucketCache::showStatistics (ostream& os) const
+{
+    os << "cacheSize: " << itsCacheSize << " (*" << itsBucketSize
+       << ")" << endl;
+    os << "#shards:   " << itsShards.size() << endl;
+    os << "#buckets:  " << itsCurNrOfBuckets << endl;
+    if (nread_p > 0) {
+	os << "#reads:    " << nread_p << endl;
+    }
+    if (ninit_p > 0) {
+	os << "#inits:    " << ninit_p << endl;
+    }
+    if (nwrite_p > 0) {
+	os << "#writes:   " << nwrite_p << endl;
+    }
+    os << "#accesses: " << naccess_p;
+    if (naccess_p > 0) {
+	os << "        hit-rate:  "
+	   << 100 * float(naccess_p - nread_p - ninit_p) /
+	                               float(naccess_p) << "%";
+    }
+    os << endl;
+}
+
+void ConcurrentBucketCache::initStatistics()
+{
+    naccess_p = 0;
+    nread_p   = 0;
+    ninit_p   = 0;
+    nwrite_p  = 0;
+}
+
+
+
+PinnedBucket::PinnedBucket (PinnedBucket&& that)
+  : itsCache (that.itsCache),
+    itsEntry (that.itsEntry)
+{
+    that.itsCache = 0;
+    that.itsEntry = 0;
+}
+
+PinnedBucket& PinnedBucket::operator= (PinnedBucket&& that)
+{
+    if (this != &that) {
+        release();
+        itsCache = that.itsCache;
+        itsEntry = that.itsEntry;
+        that.itsCache = 0;
+        that.itsEntry = 0;
+    }
+    return *this;
+}
+
+void PinnedBucket::release()
+{
+    if (itsEntry != 0) {
+        itsCache->unpin (itsEntry);
+        itsCache = 0;
+        itsEntry = 0;
+    }
+}
+
+} //# NAMESPACE CASACORE - END
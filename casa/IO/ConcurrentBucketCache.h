@@ -0,0 +1,373 @@
+//# ConcurrentBucketCache.h: Thread-safe cache for buckets in a part of a file
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef CASA_CONCURRENTBUCKETCACHE_H
+#define CASA_CONCURRENTBUCKETCACHE_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/IO/BucketCache.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+//# Forward declarations
+#include <casacore/casa/iosfwd.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward declarations
+class PinnedBucket;
+
+
+// <summary>
+// Thread-safe cache for buckets in a part of a file
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tConcurrentBucketCache" demos="">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=BucketCache>BucketCache</linkto>
+//   <li> <linkto class=BucketFile>BucketFile</linkto>
+// </prerequisite>
+
+// <etymology>
+// ConcurrentBucketCache is a BucketCache that can be used by multiple
+// threads concurrently.
+// </etymology>
+
+// <synopsis>
+// ConcurrentBucketCache caches buckets in (a part of) a file in the same
+// way as <linkto class=BucketCache>BucketCache</linkto> and uses the
+// same <linkto group=BucketCache_CallBack>callback functions</linkto>
+// to convert the data to and from local format. However, it can be used
+// by multiple threads at the same time. Note that the callback functions
+// can be called by multiple threads simultaneously, so they have to be
+// thread-safe.
+// <p>
+// Unlike BucketCache there is no notion of a current bucket, because each
+// thread accesses its own buckets. Instead <src>getBucket</src> returns a
+// <linkto class=PinnedBucket>PinnedBucket</linkto> object. As long as it
+// exists, the bucket is pinned in the cache, thus cannot be removed from it.
+// The data pointer it contains remains valid during that time.
+// Writing data in a bucket is possible, but it is the responsibility of the
+// caller to ensure that no two threads access the same bucket when one of
+// them is writing.
+// <p>
+// The cache is divided into shards (lock stripes). Bucket i is held in
+// shard <src>i % nShard()</src>, each of which has its own lock and its
+// own least recently used administration. Hence threads accessing buckets in
+// different shards do not hinder each other. Reading a bucket from the file
+// is done without holding a lock; other threads needing the same bucket wait
+// until it has been read. If the file supports concurrent reads (see
+// <linkto class=BucketFile>BucketFile</linkto>::hasConcurrentRead), reads are
+// done in parallel using pread. Writes are serialized.
+// <p>
+// When a shard is full, its least recently used bucket that is not pinned
+// is removed (and written if it has been changed). If all buckets in a shard
+// are pinned, the shard temporarily grows beyond its size.
+// <p>
+// The functions <src>flush</src>, <src>clear</src>, <src>resize</src>,
+// <src>resync</src> and <src>extend</src> can be used at any time.
+// Note that flush does not write buckets that are pinned, because other
+// threads might change their data meanwhile.
+// <br>
+// ConcurrentBucketCache does not maintain a list of free buckets, so
+// it does not support adding and removing buckets like BucketCache does.
+// The file part can be extended, however.
+// </synopsis>
+
+// <motivation>
+// Multiple threads reading from the same file through one cache avoids
+// duplicating caches (thus memory) and file descriptors.
+// </motivation>
+
+// <example>
+// <srcblock>
+//  // Create a cache of 64 buckets in 16 shards for the 1000 buckets
+//  // of 32768 bytes in the file starting at offset 512.
+//  BucketFile file(...);
+//  ConcurrentBucketCache cache (&file, 512, 32768, 1000, 64, 0,
+//                               bToLocal, bFromLocal, bAddBuffer,
+//                               bDeleteBuffer, 16);
+//  #pragma omp parallel for
+//  for (uInt i=0; i<1000; i++) {
+//    PinnedBucket bucket = cache.getBucket (i);
+//    process (bucket.data());
+//  }
+// </srcblock>
+// </example>
+
+class ConcurrentBucketCache
+{
+public:
+    // Create the cache for (a part of) a file.
+    // The arguments are the same as for BucketCache. Furthermore the number
+    // of shards can be given. Because each shard should be able to hold a
+    // bucket, the cache size is at least the number of shards.
+    ConcurrentBucketCache (BucketFile* file, Int64 startOffset,
+                           uInt bucketSize, uInt nrOfBuckets,
+                           uInt cacheSize, void* ownerObject,
+                           BucketCacheToLocal readCallBack,
+                           BucketCacheFromLocal writeCallBack,
+                           BucketCacheAddBuffer addCallBack,
+                           BucketCacheDeleteBuffer deleteCallBack,
+                           uInt nrShards=16);
+
+    // The cache is not flushed; that should have been done before.
+    ~ConcurrentBucketCache();
+
+    // Forbid copy constructor.
+    ConcurrentBucketCache (const ConcurrentBucketCache&) = delete;
+
+    // Forbid assignment.
+    ConcurrentBucketCache& operator= (const ConcurrentBucketCache&) = delete;
+
+    // Get a bucket and pin it in the cache.
+    // It is read and converted using the ToLocal callback function if not
+    // in the cache yet. When the bucket does not exist yet in the file,
+    // it gets initialized using the AddBuffer callback function.
+    PinnedBucket getBucket (uInt bucketNr);
+
+    // Write all changed buckets that are not pinned.
+    // When the file was extended, possibly remaining uninitialized buckets
+    // will be initialized first.
+    // A True status is returned when buckets had to be written.
+    Bool flush();
+
+    // Remove all buckets that are not pinned from the cache.
+    // If wanted, they are flushed to the file before removing them.
+    void clear (Bool doFlush = True);
+
+    // Resize the cache (given in buckets).
+    // If the cache gets smaller, the least recently used buckets are
+    // removed from it. The size cannot be less than the number of shards.
+    void resize (uInt cacheSize);
+
+    // Resynchronize the object (after another process updated the file).
+    // It clears the cache (so all data will be reread) and sets
+    // the new size.
+    void resync (uInt nrBucket);
+
+    // Extend the file with the given number of buckets.
+    // The buckets get initialized when they are acquired
+    // (using getBucket) for the first time.
+    void extend (uInt nrBucket);
+
+    // Get the current nr of buckets in the file.
+    uInt nBucket() const
+      { return itsNewNrOfBuckets; }
+
+    // Get the current cache size (in buckets).
+    uInt cacheSize() const
+      { return itsCacheSize; }
+
+    // Get the number of shards.
+    uInt nShard() const
+      { return itsShards.size(); }
+
+    // (Re)initialize the cache statistics.
+    void initStatistics();
+
+    // Show the statistics.
+    void showStatistics (ostream& os) const;
+
+private:
+    friend class PinnedBucket;
+
+    // A bucket in the cache.
+    struct Entry {
+      // The bucket in local format.
+      char*  data;
+      uInt   bucketNr;
+      // The number of PinnedBucket objects referencing it.
+      uInt   nrPin;
+      // Has the bucket changed?
+      Bool   dirty;
+      // Is the bucket being read by a thread?
+      Bool   loading;
+      // LRU counter value of the last time the bucket was used.
+      uInt64 lastUsed;
+    };
+
+    // A part of the cache with its own lock.
+    struct Shard {
+      std::mutex mutex;
+      // Signaled when a bucket has been read.
+      std::condition_variable loaded;
+      std::unordered_map<uInt, std::unique_ptr<Entry>> buckets;
+      uInt capacity;
+    };
+
+    // Get the shard a bucket belongs to.
+    Shard& getShard (uInt bucketNr)
+      { return *itsShards[bucketNr % itsShards.size()]; }
+
+    // Unpin a bucket.
+    void unpin (Entry* entry);
+
+    // Set the dirty flag of a bucket.
+    void setDirty (Entry* entry);
+
+    // Remove the least recently used unpinned buckets from a shard,
+    // until it has fewer buckets than the given number.
+    // The shard must be locked by the caller.
+    void makeRoom (Shard& shard, uInt maxSize);
+
+    // Read a bucket from the file and convert it using the ToLocal
+    // callback function. A bucket not yet in the file gets initialized.
+    void loadBucket (Entry* entry);
+
+    // Write a bucket. The shard must be locked by the caller.
+    void writeBucket (Entry* entry);
+
+    // Initialize the buckets not written yet before the given bucket.
+    // The file mutex must be locked by the caller.
+    void initializeBuckets (uInt bucketNr);
+
+    // Write a bucket in external format. The file mutex must be locked.
+    void writeExternal (uInt bucketNr, const char* external);
+
+
+    // The file used.
+    BucketFile* itsFile;
+    // The owner object.
+    void*    itsOwner;
+    // The callback functions.
+    BucketCacheToLocal      itsReadCallBack;
+    BucketCacheFromLocal    itsWriteCallBack;
+    BucketCacheAddBuffer    itsInitCallBack;
+    BucketCacheDeleteBuffer itsDeleteCallBack;
+    // The starting offset of the buckets in the file.
+    Int64    itsStartOffset;
+    // The bucket size.
+    uInt     itsBucketSize;
+    // The current nr of buckets in the file.
+    std::atomic<uInt> itsCurNrOfBuckets;
+    // The new nr of buckets in the file (after extension).
+    std::atomic<uInt> itsNewNrOfBuckets;
+    // The size of the cache (i.e. #buckets fitting in it).
+    uInt     itsCacheSize;
+    // The shards.
+    std::vector<std::unique_ptr<Shard>> itsShards;
+    // The lock for writing (and non-concurrent reading) the file.
+    std::mutex itsFileMutex;
+    // The Least Recently Used counter.
+    std::atomic<uInt64> itsLRUCounter;
+    // The statistics.
+    std::atomic<uInt> naccess_p;
+    std::atomic<uInt> nread_p;
+    std::atomic<uInt> ninit_p;
+    std::atomic<uInt> nwrite_p;
+};
+
+
+
+// <summary>
+// Pinned reference to a bucket in a ConcurrentBucketCache
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tConcurrentBucketCache" demos="">
+// </reviewed>
+
+// <synopsis>
+// A PinnedBucket object is returned by ConcurrentBucketCache::getBucket.
+// As long as it exists (and is not released), the bucket cannot be removed
+// from the cache, so the data pointer remains valid.
+// <br>The object can be moved, but not copied.
+// </synopsis>
+
+class PinnedBucket
+{
+public:
+    // Create a null object.
+    PinnedBucket()
+      : itsCache (0),
+        itsEntry (0)
+    {}
+
+    // Move the pin to this object.
+    // <group>
+    PinnedBucket (PinnedBucket&& that);
+    PinnedBucket& operator= (PinnedBucket&& that);
+    // </group>
+
+    // Unpin the bucket.
+    ~PinnedBucket()
+      { release(); }
+
+    // Forbid copy constructor and assignment.
+    // <group>
+    PinnedBucket (const PinnedBucket&) = delete;
+    PinnedBucket& operator= (const PinnedBucket&) = delete;
+    // </group>
+
+    // Is the object null?
+    Bool isNull() const
+      { return itsEntry == 0; }
+
+    // Get the bucket data in local format.
+    char* data() const
+      { return itsEntry->data; }
+
+    // Get the bucket number.
+    uInt bucketNr() const
+      { return itsEntry->bucketNr; }
+
+    // Mark the bucket as changed, so it gets written.
+    void setDirty()
+      { itsCache->setDirty (itsEntry); }
+
+    // Unpin the bucket. The object becomes null.
+    void release();
+
+private:
+    friend class ConcurrentBucketCache;
+
+    PinnedBucket (ConcurrentBucketCache* cache,
+                  ConcurrentBucketCache::Entry* entry)
+      : itsCache (cache),
+        itsEntry (entry)
+    {}
+
+    ConcurrentBucketCache*        itsCache;
+    ConcurrentBucketCache::Entry* itsEntry;
+};
+
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -35,6 +35,12 @@
 #include <casacore/casa/Exceptions/Error.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <errno.h>
+#if defined(AIPS_LINUX)
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <poll.h>
+#endif
 #include <casacore/casa/iostream.h>
 #include <casacore/casa/sstream.h>
 
@@ -79,7 +85,8 @@ LockFile::LockFile (const String& fileName, double inspectInterval,
 ///  itsHostId    (gethostid()),     gethostid is not declared in unistd.h
   itsHostId      (0),
   itsReqId       (SIZEREQID/SIZEINT, (Int)0),
-  itsInspectCount(0)
+  itsInspectCount(0),
+  itsNotifyFd    (-1)
 {
     AlwaysAssert (SIZEINT == CanonicalConversion::canonicalSize (static_cast<Int*>(0)),
 		  AipsError);
@@ -140,6 +147,77 @@ LockFile::~LockFile()
     if (fd >= 0) {
 	FiledesIO::close (fd);
     }
+    if (itsNotifyFd >= 0) {
+        traceCLOSE (itsNotifyFd);
+    }
+}
+
+Bool LockFile::enableNotification()
+{
+#if defined(AIPS_LINUX)
+    if (itsNotifyFd < 0  &&  itsFileIO) {
+        itsNotifyFd = inotify_init1 (IN_NONBLOCK | IN_CLOEXEC);
+        if (itsNotifyFd >= 0) {
+            //# A write (e.g. of the request list) gives IN_MODIFY,
+            //# touching the file after a release gives IN_ATTRIB.
+            if (inotify_add_watch (itsNotifyFd, itsName.chars(),
+                                   IN_MODIFY | IN_ATTRIB) < 0) {
+                traceCLOSE (itsNotifyFd);
+                itsNotifyFd = -1;
+            }
+        }
+    }
+#endif
+    return itsNotifyFd >= 0;
+}
+
+Bool LockFile::readEvents()
+{
+    Bool changed = False;
+#if defined(AIPS_LINUX)
+    //# The events themselves are not needed; only if there are any.
+    alignas(struct inotify_event) char buffer[4096];
+    while (::read (itsNotifyFd, buffer, sizeof(buffer)) > 0) {
+        changed = True;
+    }
+#endif
+    return changed;
+}
+
+Bool LockFile::waitForChange (int msec)
+{
+#if defined(AIPS_LINUX)
+    struct pollfd pfd;
+    pfd.fd      = itsNotifyFd;
+    pfd.events  = POLLIN;
+    pfd.revents = 0;
+    if (::poll (&pfd, 1, msec) > 0) {
+        return readEvents();
+    }
+#else
+    (void)msec;
+#endif
+    return False;
+}
+
+Bool LockFile::acquireNotified (FileLocker::LockType type, uInt nattempts)
+{
+    //# Discard the changes made before the first attempt.
+    readEvents();
+    for (uInt i=0; nattempts == 0  ||  i < nattempts; i++) {
+        if (itsLocker.acquire (type, 1)) {
+            return True;
+        }
+        //# Stop if something else than a lock held elsewhere went wrong.
+        int error = itsLocker.lastError();
+        if (error != EAGAIN  &&  error != EACCES) {
+            break;
+        }
+        if (nattempts == 0  ||  i < nattempts-1) {
+            waitForChange (1000);
+        }
+    }
+    return False;
 }
 
 Bool LockFile::isMultiUsed()
@@ -170,7 +248,12 @@ Bool LockFile::acquire (MemoryIO* info, FileLocker::LockType type,
 	    addReqId();
 	    added = True;
 	}
-	succ = itsLocker.acquire (type, nattempts);
+	//# When notified, waiting (nattempts=0) is done by the kernel.
+	if (itsNotifyFd >= 0  &&  nattempts != 0) {
+	    succ = acquireNotified (type, nattempts);
+	} else {
+	    succ = itsLocker.acquire (type, nattempts);
+	}
     }
     //# Do not read info if we did not acquire the lock.
     if (!succ) {
@@ -205,7 +288,14 @@ Bool LockFile::release (const MemoryIO* info)
     if (info != 0) {
 	putInfo (*info);
     }
-    return itsLocker.release();
+    Bool succ = itsLocker.release();
+#if defined(AIPS_LINUX)
+    //# Touch the file to notify processes waiting for the lock.
+    if (itsNotifyFd >= 0  &&  itsWritable) {
+        futimens (itsLocker.fd(), 0);
+    }
+#endif
+    return succ;
 }
 
 Bool LockFile::inspect (Bool always)
@@ -224,7 +314,10 @@ Bool LockFile::inspect (Bool always)
       itsInspectCount = 0;
 
       //# Only inspect if time interval has passed.
-      if (itsInterval > 0  &&  itsLastTime.age() < itsInterval) {
+      //# If notified, inspect at once if the lock file has changed, because
+      //# another process might have added a request.
+      if (itsInterval > 0  &&  itsLastTime.age() < itsInterval
+      &&  !(itsNotifyFd >= 0  &&  readEvents())) {
 	return False;
       }
     }
@@ -130,6 +130,17 @@ class CanonicalIO;
 // locks held by the other LockFile objects. This behaviour is due to the way
 // file locking is working on UNIX machines (certainly on Solaris 2.6).
 // One can use the test program tLockFile to test for this behaviour.
+// <p>
+// Optionally (on Linux only) the lock file can be watched using inotify
+// to be notified immediately about changes made by other processes.
+// When enabled, a process releasing a lock touches the lock file, so
+// a process waiting for the lock can retry at once instead of after the
+// 1 second interval between attempts. Furthermore, the request list
+// is inspected at once (regardless of the inspection interval) when the
+// lock file has been changed, thus when another process might have
+// added a request. Note that inotify does not see changes made on other
+// hosts (e.g., on an NFS file system), so the waiting and inspection
+// intervals are still used as a fallback.
 // </synopsis>
 
 // <example>
@@ -204,6 +215,15 @@ public:
     // the table gets deleted.
     ~LockFile();
 
+    // Enable the notification about changes in the lock file using inotify.
+    // It returns False if not possible (i.e., not supported by the OS or
+    // if there is no lock file).
+    Bool enableNotification();
+
+    // Is notification enabled?
+    Bool hasNotification() const
+      { return itsNotifyFd >= 0; }
+
     // Is the file associated with the LockFile object in use in
     // another process?
     Bool isMultiUsed();
@@ -312,6 +332,20 @@ private:
     // Get the number of request id's.
     Int getNrReqId() const;
 
+    // Read all pending notification events.
+    // It returns True if there were events, thus if the file has changed.
+    Bool readEvents();
+
+    // Wait for a change in the lock file (for at most the given number
+    // of milliseconds).
+    // It returns True if the file has changed.
+    Bool waitForChange (int msec);
+
+    // Try to acquire the lock the given number of times (0 is forever).
+    // Between the attempts it waits for a change in the lock file, but at
+    // most 1 second.
+    Bool acquireNotified (FileLocker::LockType type, uInt nattempts);
+
 
     //# The member variables.
     FileLocker   itsLocker;
@@ -330,6 +364,7 @@ private:
     Int          itsInspectCount;     //# The number of times inspect() has
                                       //# been called since the last elapsed
                                       //# time check.
+    int          itsNotifyFd;         //# inotify fd (<0 is no notification)
 };
 
 
@@ -27,6 +27,7 @@
 #include <casacore/casa/IO/BucketFile.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/iostream.h>
 
 #include <casacore/casa/namespace.h>
@@ -38,6 +39,8 @@ void a (Bool);
 void b (Bool);
 void c (uInt bufSize);
 void d (uInt bufSize);
+void e();
+void f();
 
 int main (int argc, const char*[])
 {
@@ -52,6 +55,8 @@ int main (int argc, const char*[])
 //	d (1024);
 //	d (32768);
 //	d (327680);
+	e();
+	f();
     } catch (std::exception& x) {
 	cout << "Caught an exception: " << x.what() << endl;
 	return 1;
@@ -254,3 +259,87 @@ void d (uInt)
     timer.show();
     cout << "<<<" << endl;
 }
+
+// Read ahead buckets and check if the data are the same as read directly.
+void e()
+{
+    BucketFile file("tBucketCache_tmp.data", False);
+    file.open();
+    AlwaysAssertExit (file.hasConcurrentRead());
+    Int rec[128];
+    file.read ((char*)rec, 512);
+    BucketCache cache1 (&file, 512, 32768, rec[0], 2, 0, aToLocal, aFromLocal,
+                        aInitBuffer, aDeleteBuffer);
+    BucketCache cache2 (&file, 512, 32768, rec[0], 2, 0, aToLocal, aFromLocal,
+                        aInitBuffer, aDeleteBuffer);
+    for (uInt i=0; i<cache1.nBucket(); i++) {
+        std::vector<uInt> next {i, i+1, i+2};
+        cache1.prefetch (next, 2);
+        AlwaysAssertExit (cache1.nPrefetch() <= 2);
+        char* buf1 = cache1.getBucket(i);
+        char* buf2 = cache2.getBucket(i);
+        AlwaysAssertExit (memcmp (buf1, buf2, 32768) == 0);
+    }
+    // Buckets read ahead, but never used, make room for new ones.
+    AlwaysAssertExit (cache1.nPrefetch() == 0);
+    cache1.prefetch (std::vector<uInt>{10, 11}, 2);
+    AlwaysAssertExit (cache1.nPrefetch() == 2);
+    cache1.prefetch (std::vector<uInt>{20, 21}, 2);
+    AlwaysAssertExit (cache1.nPrefetch() == 2);
+    // A bucket requested again is kept.
+    cache1.prefetch (std::vector<uInt>{21, 30}, 2);
+    AlwaysAssertExit (cache1.nPrefetch() == 2);
+    AlwaysAssertExit (memcmp (cache1.getBucket(21), cache2.getBucket(21),
+                              32768) == 0);
+    AlwaysAssertExit (cache1.nPrefetch() == 1);
+    AlwaysAssertExit (memcmp (cache1.getBucket(30), cache2.getBucket(30),
+                              32768) == 0);
+    AlwaysAssertExit (cache1.nPrefetch() == 0);
+    // Clearing the cache discards the pending read-aheads.
+    cache1.prefetch (std::vector<uInt>(1, 0), 2);
+    cache1.clear();
+    AlwaysAssertExit (cache1.nPrefetch() == 0);
+    cout << "prefetched " << cache1.nBucket() << " buckets" << endl;
+}
+
+// Write buckets behind and check if the file contains the same data as
+// written directly.
+void f()
+{
+    BucketFile file("tBucketCache_tmp.data", True);
+    file.open();
+    Int rec[128];
+    file.read ((char*)rec, 512);
+    BucketCache cache (&file, 512, 32768, rec[0], 2, 0, aToLocal, aFromLocal,
+                       aInitBuffer, aDeleteBuffer);
+    AlwaysAssertExit (cache.setWriteBehind (3, 65536));
+    AlwaysAssertExit (cache.writeBehind() == 3);
+    uInt nbucket = cache.nBucket();
+    for (uInt j=0; j<2; j++) {
+        for (uInt i=0; i<nbucket; i++) {
+            char* buf = cache.getBucket(i);
+            *(Int*)(buf+4) = i + 1000*j;
+            cache.setDirty();
+            // Reacquire a bucket that is likely still waiting to be written.
+            if (i >= 3) {
+                buf = cache.getBucket(i-3);
+                AlwaysAssertExit (*(Int*)(buf+4) == Int(i-3 + 1000*j));
+            }
+        }
+    }
+    // Removing a bucket has to wait for the bucket being written behind.
+    cache.getBucket (nbucket-1);
+    cache.removeBucket();
+    cache.flush();
+    AlwaysAssertExit (cache.nFreeBucket() == 1);
+    // Switch off write-behind and check the file with another cache.
+    AlwaysAssertExit (cache.setWriteBehind (0));
+    AlwaysAssertExit (cache.writeBehind() == 0);
+    BucketCache cache2 (&file, 512, 32768, rec[0], 2, 0, aToLocal, aFromLocal,
+                        aInitBuffer, aDeleteBuffer);
+    for (uInt i=0; i<nbucket-1; i++) {
+        char* buf = cache2.getBucket(i);
+        AlwaysAssertExit (*(Int*)(buf+4) == Int(i + 1000));
+    }
+    cout << "wrote behind " << nbucket << " buckets" << endl;
+}
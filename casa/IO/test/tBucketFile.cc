@@ -29,6 +29,7 @@
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/OS/RegularFile.h>
 #include <casacore/casa/iostream.h>
+#include <vector>
 
 #include <casacore/casa/namespace.h>
 // <summary>
@@ -38,6 +39,7 @@
 void a(const std::shared_ptr<MultiFileBase>&);
 void b(const std::shared_ptr<MultiFileBase>&);
 void c(const std::shared_ptr<MultiFileBase>&);
+void d(const std::shared_ptr<MultiFileBase>&, Bool directRead);
 
 int main (int argc, const char*[])
 {
@@ -49,6 +51,8 @@ int main (int argc, const char*[])
         }
 	a(mfile);
 	b(mfile);
+	d(mfile, False);
+	d(mfile, True);
 	// Do exceptional things only when needed.
 	if (argc < 2) {
 	    cout << ">>>" << endl;
@@ -174,3 +178,55 @@ void c(const std::shared_ptr<MultiFileBase>& mfile)
     // Make it writable again.
     rfile.setPermissions (0644);
 }
+
+// Read pieces of a file in a batch.
+void d(const std::shared_ptr<MultiFileBase>& mfile, Bool directRead)
+{
+    const Int n = 10000;
+    {
+        BucketFile file ("tBucketFile_tmp.data2", 0, False, mfile);
+        std::vector<Int> vals(n);
+        for (Int i=0; i<n; ++i) {
+            vals[i] = i;
+        }
+        file.write (vals.data(), n*sizeof(Int));
+    }
+    BucketFile file ("tBucketFile_tmp.data2", False, 0, False, mfile);
+    file.open();
+    file.setDirectRead (directRead);
+    AlwaysAssertExit (!file.directRead()  ||  !mfile);
+    // Read pieces of 10 values in reversed order; pieces are adjacent
+    // except for every 7th piece (which is skipped).
+    std::vector<Int> result(n, -1);
+    std::vector<BucketFile::BatchRead> reads;
+    for (Int i=n/10-1; i>=0; --i) {
+        if (i%7 != 3) {
+            BucketFile::BatchRead rd;
+            rd.buffer = &(result[10*i]);
+            rd.length = 10*sizeof(Int);
+            rd.offset = 10*i*sizeof(Int);
+            reads.push_back (rd);
+        }
+    }
+    file.readBatch (reads);
+    for (Int i=0; i<n; ++i) {
+        if ((i/10)%7 == 3) {
+            AlwaysAssertExit (result[i] == -1);
+        } else {
+            AlwaysAssertExit (result[i] == i);
+        }
+    }
+    // Reading beyond the end of the file is an error.
+    Int val;
+    reads.resize (1);
+    reads[0].buffer = &val;
+    reads[0].length = sizeof(Int);
+    reads[0].offset = n*sizeof(Int);
+    Bool flag = False;
+    try {
+        file.readBatch (reads);
+    } catch (const std::exception&) {
+        flag = True;
+    }
+    AlwaysAssertExit (flag);
+}
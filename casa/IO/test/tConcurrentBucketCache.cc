@@ -0,0 +1,222 @@
+//# tConcurrentBucketCache.cc: Test program for the ConcurrentBucketCache class
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/casa/IO/ConcurrentBucketCache.h>
+#include <casacore/casa/IO/BucketFile.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+// <summary>
+// Test program for the ConcurrentBucketCache class
+// </summary>
+
+// The callback functions. The buckets contain Int values.
+// Note they have to be thread-safe.
+const uInt bucketSize = 4096;
+
+char* cToLocal (void*, const char* data)
+{
+    char* ptr = new char[bucketSize];
+    memcpy (ptr, data, bucketSize);
+    return ptr;
+}
+void cFromLocal (void*, char* data, const char* local)
+{
+    memcpy (data, local, bucketSize);
+}
+char* cInitBuffer (void*)
+{
+    char* ptr = new char[bucketSize];
+    memset (ptr, 0, bucketSize);
+    return ptr;
+}
+void cDeleteBuffer (void*, char* buffer)
+{
+    delete [] buffer;
+}
+
+// Fill a bucket with its bucket number and a value.
+void fillBucket (char* data, uInt bucketNr, Int value)
+{
+    Int* ptr = reinterpret_cast<Int*>(data);
+    for (uInt i=0; i<bucketSize/sizeof(Int); ++i) {
+        ptr[i] = bucketNr + value + i;
+    }
+}
+
+// Check if a bucket has the correct contents.
+Bool checkBucket (const char* data, uInt bucketNr, Int value)
+{
+    const Int* ptr = reinterpret_cast<const Int*>(data);
+    for (uInt i=0; i<bucketSize/sizeof(Int); ++i) {
+        if (ptr[i] != Int(bucketNr + value + i)) {
+            return False;
+        }
+    }
+    return True;
+}
+
+
+// Create the file with 100 buckets in a single thread.
+void a()
+{
+    BucketFile file ("tConcurrentBucketCache_tmp.data");
+    file.open();
+    ConcurrentBucketCache cache (&file, 512, bucketSize, 100, 10, 0,
+                                 cToLocal, cFromLocal,
+                                 cInitBuffer, cDeleteBuffer, 4);
+    AlwaysAssertExit (cache.nShard() == 4);
+    AlwaysAssertExit (cache.cacheSize() == 10);
+    // Fill in a non-sequential order, so uninitialized buckets get
+    // written before.
+    for (uInt i=0; i<100; ++i) {
+        uInt bucketNr = (i*37) % 100;
+        PinnedBucket bucket = cache.getBucket (bucketNr);
+        AlwaysAssertExit (bucket.bucketNr() == bucketNr);
+        fillBucket (bucket.data(), bucketNr, 0);
+        bucket.setDirty();
+    }
+    cache.flush();
+    AlwaysAssertExit (file.fileSize() == 512 + 100*Int64(bucketSize));
+    // The cache should contain at least a bucket per shard.
+    cache.resize (2);
+    AlwaysAssertExit (cache.cacheSize() == 4);
+    cout << "created 100 buckets" << endl;
+}
+
+// Read the file using multiple threads.
+void b (uInt nthread)
+{
+    BucketFile file ("tConcurrentBucketCache_tmp.data", False);
+    file.open();
+    ConcurrentBucketCache cache (&file, 512, bucketSize, 100, 16, 0,
+                                 cToLocal, cFromLocal,
+                                 cInitBuffer, cDeleteBuffer, 8);
+    std::atomic<uInt> nrError(0);
+    std::vector<std::thread> threads;
+    for (uInt t=0; t<nthread; ++t) {
+        threads.emplace_back ([&cache, &nrError, t]() {
+            // Each thread reads all buckets a few times in its own order.
+            for (uInt j=0; j<5; ++j) {
+                for (uInt i=0; i<100; ++i) {
+                    uInt bucketNr = (i*(2*t+1) + j) % 100;
+                    PinnedBucket bucket = cache.getBucket (bucketNr);
+                    if (! checkBucket (bucket.data(), bucketNr, 0)) {
+                        nrError++;
+                    }
+                    // Keep a second bucket pinned to test growing the shard.
+                    PinnedBucket bucket2 = cache.getBucket (99-bucketNr);
+                    if (! checkBucket (bucket2.data(), 99-bucketNr, 0)) {
+                        nrError++;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    AlwaysAssertExit (nrError == 0);
+    // Reading beyond the end of a readonly file is not possible.
+    Bool ok = False;
+    try {
+        cache.getBucket (100);
+    } catch (const std::exception&) {
+        ok = True;
+    }
+    AlwaysAssertExit (ok);
+    cout << "read 100 buckets in " << nthread << " threads" << endl;
+}
+
+// Update and extend the file using multiple threads, each writing
+// its own buckets.
+void c (uInt nthread)
+{
+    BucketFile file ("tConcurrentBucketCache_tmp.data", True);
+    file.open();
+    ConcurrentBucketCache cache (&file, 512, bucketSize, 100, 12, 0,
+                                 cToLocal, cFromLocal,
+                                 cInitBuffer, cDeleteBuffer, 3);
+    cache.extend (100);
+    AlwaysAssertExit (cache.nBucket() == 200);
+    std::vector<std::thread> threads;
+    for (uInt t=0; t<nthread; ++t) {
+        threads.emplace_back ([&cache, nthread, t]() {
+            for (uInt i=t; i<200; i+=nthread) {
+                PinnedBucket bucket = cache.getBucket (i);
+                fillBucket (bucket.data(), i, 10);
+                bucket.setDirty();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    cache.flush();
+    cache.clear();
+    // Check the contents in the cache and the file.
+    for (uInt i=0; i<200; ++i) {
+        PinnedBucket bucket = cache.getBucket (i);
+        AlwaysAssertExit (checkBucket (bucket.data(), i, 10));
+    }
+    std::vector<char> buf(bucketSize);
+    for (uInt i=0; i<200; ++i) {
+        file.pread (buf.data(), bucketSize, 512 + Int64(i)*bucketSize);
+        AlwaysAssertExit (checkBucket (buf.data(), i, 10));
+    }
+    // A pinned bucket is not written by flush, but stays dirty.
+    {
+        PinnedBucket bucket = cache.getBucket (5);
+        fillBucket (bucket.data(), 5, 20);
+        bucket.setDirty();
+        cache.flush();
+        file.pread (buf.data(), bucketSize, 512 + 5*bucketSize);
+        AlwaysAssertExit (checkBucket (buf.data(), 5, 10));
+    }
+    cache.flush();
+    file.pread (buf.data(), bucketSize, 512 + 5*bucketSize);
+    AlwaysAssertExit (checkBucket (buf.data(), 5, 20));
+    cout << "updated 200 buckets in " << nthread << " threads" << endl;
+}
+
+int main()
+{
+    try {
+        a();
+        b (1);
+        b (4);
+        c (4);
+    } catch (std::exception& x) {
+        cout << "Caught an exception: " << x.what() << endl;
+        return 1;
+    }
+    return 0;                           // exit with success status
+}
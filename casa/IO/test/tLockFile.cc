@@ -35,6 +35,8 @@
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
 #include <casacore/casa/sstream.h>
+#include <unistd.h>
+#include <sys/wait.h>
 
 
 #include <casacore/casa/namespace.h>
@@ -195,6 +197,49 @@ void doTest()
     }
 }
 
+// Test the notification using another process requesting the lock.
+void doNotify()
+{
+    // Use a long inspection interval to check that the request is
+    // noticed immediately.
+    LockFile lock ("tLockFile_tmp.data", 100);
+    if (! lock.enableNotification()) {
+        cout << "inotify is not supported" << endl;
+        return;
+    }
+    AlwaysAssertExit (lock.hasNotification());
+    AlwaysAssertExit (lock.acquire());
+    pid_t pid = fork();
+    AlwaysAssertExit (pid >= 0);
+    if (pid == 0) {
+        // The child waits for the lock, which is released by the parent
+        // once it has noticed the request. The bound on the elapsed time
+        // is generous to avoid failures on loaded machines; the order of
+        // the events is checked by the parent.
+        LockFile lock2 ("tLockFile_tmp.data", 100);
+        AlwaysAssertExit (lock2.enableNotification());
+        Timer timer;
+        Bool succ = lock2.acquire (FileLocker::Write, 30);
+        double elapsed = timer.real();
+        lock2.release();
+        _exit (succ  &&  elapsed < 20  ?  0 : 1);
+    }
+    // Wait until the child has requested the lock. Because of the
+    // notification, the request is noticed although the inspection
+    // interval is 100 seconds.
+    Timer timer;
+    Bool requested = False;
+    while (!requested  &&  timer.real() < 20) {
+        requested = lock.inspect();
+        usleep (1000);
+    }
+    AlwaysAssertExit (requested);
+    AlwaysAssertExit (lock.release());
+    int status;
+    AlwaysAssertExit (waitpid (pid, &status, 0) == pid);
+    AlwaysAssertExit (WIFEXITED(status)  &&  WEXITSTATUS(status) == 0);
+}
+
 int main (int argc, const char* argv[])
 {
     try {
@@ -209,6 +254,7 @@ int main (int argc, const char* argv[])
 	    doIt (argv[1], interval);
 	}else{
 	    doTest();
+	    doNotify();
 	    cout << "Run as:   tLockFile <fileName> [inspectionInterval]"
 		 << endl;
 	    cout << "for a manual control of acquiring and releasing locks."
@@ -133,6 +133,11 @@ size_t CanonicalConversion::TOLOCAL (void* to, const void* from, \
     if (CONVERT == 0) { \
 	assert (sizeof(T) == SIZE); \
 	memcpy (to, from, nr*SIZE); \
+    }else if (sizeof(T) == SIZE) { \
+	/* Only the byte order differs, so use the vectorized swap. */ \
+	(SIZE == 2 ? Conversion::byteSwap2 : \
+	 SIZE == 4 ? Conversion::byteSwap4 : Conversion::byteSwap8) \
+	  (to, from, nr); \
     }else{ \
 	const char* data = (const char*)from; \
         T* dest = (T*)to; \
@@ -151,6 +156,10 @@ size_t CanonicalConversion::FROMLOCAL (void* to, const void* from, \
     if (CONVERT == 0) { \
 	assert (sizeof(T) == SIZE); \
 	memcpy (to, from, nr*SIZE); \
+    }else if (sizeof(T) == SIZE) { \
+	(SIZE == 2 ? Conversion::byteSwap2 : \
+	 SIZE == 4 ? Conversion::byteSwap4 : Conversion::byteSwap8) \
+	  (to, from, nr); \
     }else{ \
 	char* data = (char*)to; \
 	const T* src = (const T*)from; \
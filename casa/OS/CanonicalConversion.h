@@ -726,7 +726,7 @@ inline size_t CanonicalConversion::fromLocal (void* to,
 #else
     move8 (to, &from);
 #endif
-    return SIZE_CAN_FLOAT;
+    return SIZE_CAN_DOUBLE;
 }
 
 
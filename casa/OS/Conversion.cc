@@ -28,13 +28,21 @@
 #include <assert.h>
 #include <casacore/casa/aips.h>
 #include <casacore/casa/OS/Conversion.h>
+#include <casacore/casa/OS/CanonicalConversion.h>
 #include <casacore/casa/iostream.h>
 #ifdef __SSE2__
 #include <emmintrin.h>
 #endif
+#if defined(__x86_64__) && defined(__GNUC__)
+#define CONVERSION_X86_64
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 #ifdef _OPENMP
 #include <omp.h>
 #endif
+#include <atomic>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -522,5 +530,172 @@ size_t Conversion::valueCopy (void* to, const void* from,
 }
 
 
+#ifdef CONVERSION_X86_64
+//# The byte shuffle masks reversing the bytes of 2, 4 and 8 byte values.
+alignas(16) static const char swapMask2[16] =
+  {1,0, 3,2, 5,4, 7,6, 9,8, 11,10, 13,12, 15,14};
+alignas(16) static const char swapMask4[16] =
+  {3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12};
+alignas(16) static const char swapMask8[16] =
+  {7,6,5,4,3,2,1,0, 15,14,13,12,11,10,9,8};
+
+//# AVX2 can shuffle the bytes in 32 byte vectors.
+//# It is compiled for AVX2 regardless of the compiler flags, so it must
+//# only be called if the CPU supports it.
+__attribute__((target("avx2")))
+static size_t byteSwapAVX2 (char* to, const char* from, size_t nbytes,
+                            const char* maskPtr)
+{
+    const __m256i mask = _mm256_broadcastsi128_si256
+      (_mm_load_si128 (reinterpret_cast<const __m128i*>(maskPtr)));
+    size_t n = nbytes - nbytes%32;
+    for (size_t i=0; i<n; i+=32) {
+        __m256i v = _mm256_loadu_si256
+          (reinterpret_cast<const __m256i*>(from+i));
+        _mm256_storeu_si256 (reinterpret_cast<__m256i*>(to+i),
+                             _mm256_shuffle_epi8 (v, mask));
+    }
+    return n;
+}
+
+//# SSE2 (always available on x86_64) does not have a byte shuffle.
+//# So first the 16-bit words are reversed, whereafter the bytes in
+//# the words are swapped using shifts.
+template<int VALUESIZE>
+static size_t byteSwapSSE2 (char* to, const char* from, size_t nbytes)
+{
+    size_t n = nbytes - nbytes%16;
+    for (size_t i=0; i<n; i+=16) {
+        __m128i v = _mm_loadu_si128 (reinterpret_cast<const __m128i*>(from+i));
+        if (VALUESIZE == 4) {
+            v = _mm_shufflelo_epi16 (v, _MM_SHUFFLE(2,3,0,1));
+            v = _mm_shufflehi_epi16 (v, _MM_SHUFFLE(2,3,0,1));
+        } else if (VALUESIZE == 8) {
+            v = _mm_shufflelo_epi16 (v, _MM_SHUFFLE(0,1,2,3));
+            v = _mm_shufflehi_epi16 (v, _MM_SHUFFLE(0,1,2,3));
+        }
+        v = _mm_or_si128 (_mm_slli_epi16 (v, 8), _mm_srli_epi16 (v, 8));
+        _mm_storeu_si128 (reinterpret_cast<__m128i*>(to+i), v);
+    }
+    return n;
+}
+
+//# Determine once if the CPU supports AVX2.
+static bool hasAVX2()
+{
+    static const bool avx2 = (__builtin_cpu_init(),
+                              __builtin_cpu_supports ("avx2") != 0);
+    return avx2;
+}
+#endif
+
+//# The fastest byte swap implementation available on this machine.
+static Conversion::ByteSwapImpl bestByteSwapImpl()
+{
+#if defined(CONVERSION_X86_64)
+    return hasAVX2() ? Conversion::AVX2Swap : Conversion::SSE2Swap;
+#elif defined(__ARM_NEON)
+    return Conversion::NEONSwap;
+#else
+    return Conversion::ScalarSwap;
+#endif
+}
+
+//# The byte swap implementation forced by setByteSwapImpl.
+static std::atomic<int> forcedByteSwapImpl (Conversion::AutoSwap);
+
+Bool Conversion::setByteSwapImpl (ByteSwapImpl impl)
+{
+    ByteSwapImpl best = bestByteSwapImpl();
+    Bool avail = (impl == AutoSwap  ||  impl == ScalarSwap  ||  impl == best);
+#if defined(CONVERSION_X86_64)
+    //# SSE2 is always available on x86_64.
+    avail = avail  ||  impl == SSE2Swap;
+#endif
+    if (avail) {
+        forcedByteSwapImpl.store (impl, std::memory_order_relaxed);
+    }
+    return avail;
+}
+
+Conversion::ByteSwapImpl Conversion::byteSwapImpl()
+{
+    ByteSwapImpl impl = ByteSwapImpl
+      (forcedByteSwapImpl.load (std::memory_order_relaxed));
+    return impl == AutoSwap ? bestByteSwapImpl() : impl;
+}
+
+size_t Conversion::byteSwapVector (char* to, const char* from,
+                                   size_t nbytes, int valueSize)
+{
+    ByteSwapImpl impl = byteSwapImpl();
+    if (impl == ScalarSwap) {
+        return 0;
+    }
+#if defined(CONVERSION_X86_64)
+    if (impl == AVX2Swap) {
+        return byteSwapAVX2 (to, from, nbytes,
+                             valueSize == 2 ? swapMask2 :
+                             valueSize == 4 ? swapMask4 : swapMask8);
+    }
+    switch (valueSize) {
+    case 2:
+        return byteSwapSSE2<2> (to, from, nbytes);
+    case 4:
+        return byteSwapSSE2<4> (to, from, nbytes);
+    default:
+        return byteSwapSSE2<8> (to, from, nbytes);
+    }
+#elif defined(__ARM_NEON)
+    size_t n = nbytes - nbytes%16;
+    for (size_t i=0; i<n; i+=16) {
+        uint8x16_t v = vld1q_u8 (reinterpret_cast<const uint8_t*>(from+i));
+        if (valueSize == 2) {
+            v = vrev16q_u8 (v);
+        } else if (valueSize == 4) {
+            v = vrev32q_u8 (v);
+        } else {
+            v = vrev64q_u8 (v);
+        }
+        vst1q_u8 (reinterpret_cast<uint8_t*>(to+i), v);
+    }
+    return n;
+#else
+    (void)to; (void)from; (void)nbytes; (void)valueSize;
+    return 0;
+#endif
+}
+
+void Conversion::byteSwap2 (void* to, const void* from, size_t nvalues)
+{
+    char* out = static_cast<char*>(to);
+    const char* in = static_cast<const char*>(from);
+    size_t nbytes = 2*nvalues;
+    for (size_t i=byteSwapVector(out, in, nbytes, 2); i<nbytes; i+=2) {
+        CanonicalConversion::reverse2 (out+i, in+i);
+    }
+}
+
+void Conversion::byteSwap4 (void* to, const void* from, size_t nvalues)
+{
+    char* out = static_cast<char*>(to);
+    const char* in = static_cast<const char*>(from);
+    size_t nbytes = 4*nvalues;
+    for (size_t i=byteSwapVector(out, in, nbytes, 4); i<nbytes; i+=4) {
+        CanonicalConversion::reverse4 (out+i, in+i);
+    }
+}
+
+void Conversion::byteSwap8 (void* to, const void* from, size_t nvalues)
+{
+    char* out = static_cast<char*>(to);
+    const char* in = static_cast<const char*>(from);
+    size_t nbytes = 8*nvalues;
+    for (size_t i=byteSwapVector(out, in, nbytes, 8); i<nbytes; i+=8) {
+        CanonicalConversion::reverse8 (out+i, in+i);
+    }
+}
+
+
 } //# NAMESPACE CASACORE - END
 
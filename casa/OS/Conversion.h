@@ -60,6 +60,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // <li>
 // It defines a private version of memcpy for compilers having a
 // different signature for memcpy (e.g. ObjectCenter and DEC-Alpha).
+// <li>
+// It defines functions to reverse the bytes of an array of 2, 4 or 8 byte
+// values. They are used by the canonical and little endian canonical
+// conversions if the local and external formats only differ in byte order.
+// They use vector instructions (AVX2 if the CPU supports it, otherwise
+// SSE2 on x86_64 and NEON on ARM) to handle 16 or 32 bytes at a time.
+// For testing purposes another implementation can be forced.
 // </ul>
 // Static functions in the classes
 // <linkto class=CanonicalConversion>CanonicalConversion</linkto>,
@@ -106,6 +113,17 @@ public:
     typedef void* ByteFunction (void* to, const void* from,
 				size_t nbytes);
 
+    // Define the implementations of the byte swap functions.
+    enum ByteSwapImpl {
+      // Use the fastest implementation available on this machine.
+      AutoSwap,
+      // Swap value by value (no vector instructions).
+      ScalarSwap,
+      SSE2Swap,
+      AVX2Swap,
+      NEONSwap
+    };
+
     // Convert a stream of Bools to output format (as bits).
     // The variable <src>startBit</src> (0-relative) indicates
     // where to start in the <src>to</src> buffer.
@@ -139,11 +157,36 @@ public:
     // Get a pointer to the memcpy function.
     static ByteFunction* getmemcpy();
 
+    // Reverse the bytes of <src>nvalues</src> values of 2, 4 or 8 bytes.
+    // The buffers do not need to be aligned. They should not overlap,
+    // but they can be the same (to swap in place).
+    // <group>
+    static void byteSwap2 (void* to, const void* from, size_t nvalues);
+    static void byteSwap4 (void* to, const void* from, size_t nvalues);
+    static void byteSwap8 (void* to, const void* from, size_t nvalues);
+    // </group>
+
+    // Force the implementation used by the byte swap functions, which is
+    // meant to test all implementations on a machine. AutoSwap restores the
+    // default. False is returned (and nothing is changed) if the
+    // implementation is not available on this machine.
+    static Bool setByteSwapImpl (ByteSwapImpl impl);
+
+    // Get the implementation used by the byte swap functions
+    // (it is never AutoSwap).
+    static ByteSwapImpl byteSwapImpl();
+
 private:
     // Copy bits to Bool in an unoptimized way needed when 'to' is not
     // aligned properly.
     static size_t bitToBool_ (void* to, const void* from,
                               size_t nvalues);
+
+    // Reverse the bytes of the values in a vectorized way.
+    // It returns the number of bytes done, which is a multiple of the
+    // vector length. The remaining bytes have to be done by the caller.
+    static size_t byteSwapVector (char* to, const char* from,
+                                  size_t nbytes, int valueSize);
 };
 
 
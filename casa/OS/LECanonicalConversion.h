@@ -730,7 +730,7 @@ inline size_t LECanonicalConversion::fromLocal (void* to,
 #else
     move8 (to, &from);
 #endif
-    return SIZE_LECAN_FLOAT;
+    return SIZE_LECAN_DOUBLE;
 }
 
 
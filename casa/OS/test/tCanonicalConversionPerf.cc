@@ -0,0 +1,146 @@
+//# tCanonicalConversionPerf.cc: Performance test of the canonical conversions
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+
+#include <casacore/casa/aips.h>
+#include <casacore/casa/OS/CanonicalConversion.h>
+#include <casacore/casa/OS/LECanonicalConversion.h>
+#include <casacore/casa/OS/PrecTimer.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <algorithm>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+// This program compares the throughput of the bulk canonical conversions
+// (which use vectorized byte swapping) with a loop converting the values
+// one by one (as was done before).
+
+// Convert the values one by one.
+template<typename T>
+void scalarToLocal (T* to, const void* from, size_t nr)
+{
+  const char* data = static_cast<const char*>(from);
+  for (size_t i=0; i<nr; ++i) {
+    data += CanonicalConversion::toLocal (to[i], data);
+  }
+}
+
+template<typename T>
+void scalarFromLocal (void* to, const T* from, size_t nr)
+{
+  char* data = static_cast<char*>(to);
+  for (size_t i=0; i<nr; ++i) {
+    data += CanonicalConversion::fromLocal (data, from[i]);
+  }
+}
+
+// Show the throughput in MB/s.
+void showRate (const String& name, const String& type, size_t nbytes,
+               PrecTimer& timer)
+{
+  timer.stop();
+  double sec = std::max (timer.getReal(), 1e-6);
+  cout << "  " << name << ' ' << type << ": "
+       << Int64(nbytes / sec / 1e6) << " MB/s" << endl;
+}
+
+// Time the conversions of nr values of type T (repeated niter times).
+// A Complex is converted as two floats, as done in the table system.
+template<typename T, typename BASE>
+void timeType (const String& type, size_t nr, uInt niter)
+{
+  size_t nbase = nr * sizeof(T) / sizeof(BASE);
+  size_t nbytes = nbase * sizeof(BASE) * niter;
+  std::vector<BASE> local(nbase), loc1(nbase), loc2(nbase);
+  std::vector<char> ext1(nbase*sizeof(BASE)), ext2(nbase*sizeof(BASE));
+  for (size_t i=0; i<nbase; ++i) {
+    local[i] = BASE(i%1000 * 3 + 1);
+  }
+  cout << type << endl;
+  PrecTimer timer;
+  timer.start();
+  for (uInt i=0; i<niter; ++i) {
+    scalarFromLocal (ext1.data(), local.data(), nbase);
+  }
+  showRate ("scalar fromLocal", type, nbytes, timer);
+  timer.reset();
+  timer.start();
+  for (uInt i=0; i<niter; ++i) {
+    CanonicalConversion::fromLocal (ext2.data(), local.data(), nbase);
+  }
+  showRate ("bulk   fromLocal", type, nbytes, timer);
+  AlwaysAssertExit (ext1 == ext2);
+  timer.reset();
+  timer.start();
+  for (uInt i=0; i<niter; ++i) {
+    scalarToLocal (loc1.data(), ext1.data(), nbase);
+  }
+  showRate ("scalar toLocal  ", type, nbytes, timer);
+  timer.reset();
+  timer.start();
+  for (uInt i=0; i<niter; ++i) {
+    CanonicalConversion::toLocal (loc2.data(), ext1.data(), nbase);
+  }
+  showRate ("bulk   toLocal  ", type, nbytes, timer);
+  AlwaysAssertExit (loc1 == local  &&  loc2 == local);
+  // The little endian canonical conversion is a memcpy on little endian
+  // machines, so it shows the maximum throughput.
+  timer.reset();
+  timer.start();
+  for (uInt i=0; i<niter; ++i) {
+    LECanonicalConversion::toLocal (loc2.data(), ext1.data(), nbase);
+  }
+  showRate ("LE     toLocal  ", type, nbytes, timer);
+}
+
+int main (int argc, const char* argv[])
+{
+  try {
+    // The number of values and iterations can be given as arguments.
+    size_t nr = 1000000;
+    uInt niter = 20;
+    if (argc > 1) {
+      nr = atol(argv[1]);
+    }
+    if (argc > 2) {
+      niter = atoi(argv[2]);
+    }
+    timeType<Short,Short>        ("Short   ", nr, niter);
+    timeType<Int,Int>            ("Int     ", nr, niter);
+    timeType<Int64,Int64>        ("Int64   ", nr, niter);
+    timeType<Float,Float>        ("Float   ", nr, niter);
+    timeType<Double,Double>      ("Double  ", nr, niter);
+    timeType<Complex,Float>      ("Complex ", nr, niter);
+    timeType<DComplex,Double>    ("DComplex", nr, niter);
+  } catch (const std::exception& x) {
+    cout << "Exception caught: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -68,6 +68,54 @@ void checkAll()
   }
 }
 
+// Check the byte swap functions for various lengths and alignments
+// (to test the vectorized parts and the remainders).
+void checkByteSwap (Conversion::ByteSwapImpl impl)
+{
+  // Skip the implementations not available on this machine.
+  if (! Conversion::setByteSwapImpl (impl)) {
+    return;
+  }
+  AlwaysAssertExit (Conversion::byteSwapImpl() == impl  ||
+                    impl == Conversion::AutoSwap);
+  const uInt nbytes = 8*101;
+  char in[nbytes+8], out[nbytes+8], inplace[nbytes+8];
+  for (uInt i=0; i<nbytes+8; ++i) {
+    in[i] = i%251;
+  }
+  for (uInt size=2; size<=8; size*=2) {
+    for (uInt offset=0; offset<3; ++offset) {
+      for (uInt nval=0; nval<=nbytes/size; nval+=7) {
+        memset (out, 0, sizeof(out));
+        memcpy (inplace, in, sizeof(in));
+        const char* from = in+offset;
+        if (size == 2) {
+          Conversion::byteSwap2 (out+offset, from, nval);
+          Conversion::byteSwap2 (inplace+offset, inplace+offset, nval);
+        } else if (size == 4) {
+          Conversion::byteSwap4 (out+offset, from, nval);
+          Conversion::byteSwap4 (inplace+offset, inplace+offset, nval);
+        } else {
+          Conversion::byteSwap8 (out+offset, from, nval);
+          Conversion::byteSwap8 (inplace+offset, inplace+offset, nval);
+        }
+        for (uInt i=0; i<nval; ++i) {
+          for (uInt j=0; j<size; ++j) {
+            AlwaysAssertExit (out[offset + i*size + j] ==
+                              from[i*size + size-1-j]);
+            AlwaysAssertExit (inplace[offset + i*size + j] ==
+                              from[i*size + size-1-j]);
+          }
+        }
+        // Nothing after the values should be changed.
+        for (uInt i=offset+nval*size; i<sizeof(out); ++i) {
+          AlwaysAssertExit (out[i] == 0);
+        }
+      }
+    }
+  }
+}
+
 int main()
 {
     uInt nbool = 100;
@@ -153,6 +201,13 @@ int main()
     delete [] bits;
 
     checkAll();
+    cout << "checkByteSwap ..." << endl;
+    checkByteSwap (Conversion::AutoSwap);
+    checkByteSwap (Conversion::ScalarSwap);
+    checkByteSwap (Conversion::SSE2Swap);
+    checkByteSwap (Conversion::AVX2Swap);
+    checkByteSwap (Conversion::NEONSwap);
+    AlwaysAssertExit (Conversion::setByteSwapImpl (Conversion::AutoSwap));
     cout << "OK" << endl;
     return 0;
 }
@@ -141,7 +141,23 @@ protected:
 // </DL>
 // The default is to use QuickSort for small arrays or if only a single
 // thread can be used. Otherwise ParSort is the default.
-// 
+// <p>
+// The algorithms above compare the records using the (virtual) comparison
+// objects, which is relatively slow for large arrays sorted on multiple
+// keys. Therefore, for <src>DefaultSort</src> and <src>ParSort</src>,
+// Sort first tries to pack the keys of each record in a single fixed-width
+// unsigned integer having the same ordering, which is sorted with a stable
+// (parallel) radix sort without calling the comparison objects. It can be
+// done if all keys have a standard numeric data type or String and use
+// the comparison object created by <src>sortKey</src>, and if the packed
+// key fits in 256 bits. Each key is narrowed to the range of its values and
+// String values are replaced by their rank, so a sort on, say, TIME,
+// ANTENNA1 and ANTENNA2 needs about 6 bytes per record. If a floating
+// point key contains a NaN value, the normal algorithms are used.
+// Note that the packed keys need extra memory, about twice the size
+// of the packed key plus index per record.
+// The packed sort is not used if <src>tryGenSort=False</src> is given.
+//
 // All sort algorithms are <em>stable</em>, which means that the original
 // order is kept when keys are equal.
 //
@@ -381,6 +397,14 @@ private:
     void addKey (SortKey*);
     // </group>
 
+    // Try to sort using packed keys and a radix sort.
+    // It can be done if all keys have a standard data type and use the
+    // standard comparison object, and if the packed key fits in 256 bits.
+    // It returns False if not possible; otherwise the index array is filled
+    // and n is set to the resulting number of records.
+    template<typename T>
+    Bool packedSort (T nrrec, T* inx, Bool nodup, int nthr, T& n) const;
+
     // Do an insertion sort, optionally skipping duplicates.
     // <group>
     template<typename T>
@@ -30,6 +30,11 @@
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/Utilities/SortError.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <vector>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -37,6 +42,251 @@
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+  //# Information about a sort key needed to make the packed keys.
+  struct SortPackedKeyInfo
+  {
+    DataType      dtype;
+    const char*   data;
+    uInt          incr;
+    Bool          descending;
+    uInt64        minEnc;      //# encoded minimum value
+    uInt64        range;       //# encoded maximum - minimum value
+    uInt          nbits;       //# nr of bits needed for the range
+    Vector<Int64> ranks;       //# ranks of String values
+  };
+
+  //# A packed key and the index of its record.
+  //# The first word is the most significant one.
+  template<int NW, typename T>
+  struct SortPackedRec
+  {
+    uInt64 key[NW];
+    T      index;
+  };
+
+  //# Map a value to an unsigned integer having the same ordering.
+  //# A negative zero is mapped like a positive zero.
+  template<typename U>
+  inline uInt64 sortEncode (U val)
+  {
+    if constexpr (std::is_floating_point<U>::value) {
+      typedef typename std::conditional<sizeof(U)==4, uInt, uInt64>::type UU;
+      if (val == 0) {
+        val = 0;
+      }
+      UU bits;
+      memcpy (&bits, &val, sizeof(U));
+      const UU sign = UU(1) << (8*sizeof(U) - 1);
+      return (bits & sign)  ?  uInt64(UU(~bits)) : uInt64(bits | sign);
+    } else if constexpr (std::is_signed<U>::value) {
+      typedef typename std::make_unsigned<U>::type UU;
+      return uInt64(UU(val)) ^ (uInt64(1) << (8*sizeof(U) - 1));
+    } else {
+      return uInt64(val);
+    }
+  }
+
+  //# Determine the range of the encoded values of a key.
+  //# It returns False if a NaN value is found.
+  template<typename U>
+  static Bool sortKeyRange (SortPackedKeyInfo& info, Int64 nrrec)
+  {
+    uInt64 minEnc = ~uInt64(0);
+    uInt64 maxEnc = 0;
+    Bool   hasNaN = False;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(min:minEnc) reduction(max:maxEnc) reduction(||:hasNaN)
+#endif
+    for (Int64 i=0; i<nrrec; ++i) {
+      U val = *reinterpret_cast<const U*>(info.data + i*info.incr);
+      if constexpr (std::is_floating_point<U>::value) {
+        if (val != val) {
+          hasNaN = True;
+        }
+      }
+      uInt64 enc = sortEncode (val);
+      if (enc < minEnc) minEnc = enc;
+      if (enc > maxEnc) maxEnc = enc;
+    }
+    info.minEnc = minEnc;
+    info.range  = maxEnc - minEnc;
+    info.nbits  = 0;
+    while (info.nbits < 64  &&  (info.range >> info.nbits) != 0) {
+      ++info.nbits;
+    }
+    return !hasNaN;
+  }
+
+  //# Put the (narrowed) encoded values of a key in the packed keys.
+  //# The key occupies <src>info.nbits</src> bits starting at bit
+  //# <src>shift</src> counted from the least significant bit.
+  template<typename U, int NW, typename T>
+  static void sortPackKey (SortPackedRec<NW,T>* recs, Int64 nrrec,
+                           const SortPackedKeyInfo& info, uInt shift)
+  {
+    const uInt word = NW - 1 - shift/64;
+    const uInt off  = shift%64;
+    const Bool span = (off + info.nbits > 64);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (Int64 i=0; i<nrrec; ++i) {
+      uInt64 val = sortEncode
+        (*reinterpret_cast<const U*>(info.data + i*info.incr)) - info.minEnc;
+      if (info.descending) {
+        val = info.range - val;
+      }
+      recs[i].key[word] |= val << off;
+      if (span) {
+        recs[i].key[word-1] |= val >> (64-off);
+      }
+    }
+  }
+
+  //# Do a parallel stable LSD radix sort on the lowest nbytes bytes of the
+  //# packed keys. Each thread handles a contiguous part of the records,
+  //# so the scatter keeps the order of equal keys.
+  //# Passes where all records have the same byte value are skipped.
+  //# It returns a pointer to the buffer containing the sorted records.
+  template<int NW, typename T>
+  static SortPackedRec<NW,T>* sortPackedRadix (SortPackedRec<NW,T>* recs,
+                                               SortPackedRec<NW,T>* tmp,
+                                               Int64 nrrec, uInt nbytes,
+                                               int nthr)
+  {
+    std::vector<Int64> counts(256*nthr);
+    const Int64 step = (nrrec + nthr - 1) / nthr;
+    for (uInt byte=0; byte<nbytes; ++byte) {
+      const uInt word = NW - 1 - byte/8;
+      const uInt off  = (byte%8) * 8;
+      std::fill (counts.begin(), counts.end(), Int64(0));
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthr)
+#endif
+      for (int t=0; t<nthr; ++t) {
+        Int64* cnt = &counts[256*t];
+        Int64 end = std::min (nrrec, (t+1)*step);
+        for (Int64 i=t*step; i<end; ++i) {
+          cnt[(recs[i].key[word] >> off) & 255]++;
+        }
+      }
+      // Skip the pass if all records have the same byte value.
+      const uInt first = (recs[0].key[word] >> off) & 255;
+      Int64 nfirst = 0;
+      for (int t=0; t<nthr; ++t) {
+        nfirst += counts[256*t + first];
+      }
+      if (nfirst == nrrec) {
+        continue;
+      }
+      // Turn the counts into output offsets, ordered by value and thread.
+      Int64 sum = 0;
+      for (uInt v=0; v<256; ++v) {
+        for (int t=0; t<nthr; ++t) {
+          Int64 cnt = counts[256*t + v];
+          counts[256*t + v] = sum;
+          sum += cnt;
+        }
+      }
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthr)
+#endif
+      for (int t=0; t<nthr; ++t) {
+        Int64* pos = &counts[256*t];
+        Int64 end = std::min (nrrec, (t+1)*step);
+        for (Int64 i=t*step; i<end; ++i) {
+          tmp[pos[(recs[i].key[word] >> off) & 255]++] = recs[i];
+        }
+      }
+      std::swap (recs, tmp);
+    }
+    return recs;
+  }
+
+  //# Make the packed keys, sort them and store the resulting indices.
+  //# It returns the number of resulting records.
+  //# If reverse is True, the result is reversed (used if all keys are
+  //# descending, because equal keys are then in descending index order).
+  template<int NW, typename T>
+  static T sortPacked (std::vector<SortPackedKeyInfo>& info, T nrrec,
+                       T* inx, Bool nodup, Bool reverse, int nthr)
+  {
+    // Note that the vector elements are zero-initialized.
+    std::vector<SortPackedRec<NW,T>> recs(nrrec);
+    std::vector<SortPackedRec<NW,T>> tmp(nrrec);
+    Int64 nr = nrrec;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (Int64 i=0; i<nr; ++i) {
+      recs[i].index = i;
+    }
+    // Pack the keys; the least significant one comes first.
+    uInt shift = 0;
+    for (auto iter=info.rbegin(); iter!=info.rend(); ++iter) {
+      if (iter->nbits == 0) {
+        continue;
+      }
+      switch (iter->dtype) {
+      case TpBool:
+        sortPackKey<Bool>   (recs.data(), nr, *iter, shift);
+        break;
+      case TpChar:
+        sortPackKey<Char>   (recs.data(), nr, *iter, shift);
+        break;
+      case TpUChar:
+        sortPackKey<uChar>  (recs.data(), nr, *iter, shift);
+        break;
+      case TpShort:
+        sortPackKey<Short>  (recs.data(), nr, *iter, shift);
+        break;
+      case TpUShort:
+        sortPackKey<uShort> (recs.data(), nr, *iter, shift);
+        break;
+      case TpInt:
+        sortPackKey<Int>    (recs.data(), nr, *iter, shift);
+        break;
+      case TpUInt:
+        sortPackKey<uInt>   (recs.data(), nr, *iter, shift);
+        break;
+      case TpFloat:
+        sortPackKey<Float>  (recs.data(), nr, *iter, shift);
+        break;
+      case TpDouble:
+        sortPackKey<Double> (recs.data(), nr, *iter, shift);
+        break;
+      default:
+        // Int64 and the ranks of String values.
+        sortPackKey<Int64>  (recs.data(), nr, *iter, shift);
+        break;
+      }
+      shift += iter->nbits;
+    }
+    SortPackedRec<NW,T>* res = sortPackedRadix (recs.data(), tmp.data(), nr,
+                                                (shift+7)/8, nthr);
+    if (reverse) {
+      std::reverse (res, res+nr);
+    }
+    if (!nodup) {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (Int64 i=0; i<nr; ++i) {
+        inx[i] = res[i].index;
+      }
+      return nrrec;
+    }
+    // Skip the records having the same key as the previous one,
+    // so the first one of equal records is kept.
+    T n = 0;
+    for (Int64 i=0; i<nr; ++i) {
+      if (i == 0  ||  memcmp (res[i].key, res[i-1].key, sizeof(res[i].key))) {
+        inx[n++] = res[i].index;
+      }
+    }
+    return n;
+  }
+
   template<typename T>
   T Sort::doSort (Vector<T>& indexVector, T nrrec, int opt,
                   Bool doTryGenSort) const
@@ -67,11 +317,17 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Do not use more threads than there are values.
     if (uInt(nthr) > nrrec) nthr = nrrec;
 #endif
-    if (type == DefaultSort) {
+    T n = 0;
+    // Try if the keys can be packed, so a radix sort can be used.
+    if (doTryGenSort  &&  (type == DefaultSort  ||  type == ParSort)
+    &&  packedSort (nrrec, inx, nodup, nthr, n)) {
+      type = -1;
+    } else if (type == DefaultSort) {
       type = (nrrec<1000 || nthr==1  ?  QuickSort : ParSort);
     }
-    T n = 0;
     switch (type) {
+    case -1:
+      break;
     case QuickSort:
       if (nodup) {
         n = quickSortNoDup (nrrec, inx);
@@ -111,6 +367,106 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return n;
   }
 
+  template<typename T>
+  Bool Sort::packedSort (T nrrec, T* inx, Bool nodup, int nthr, T& n) const
+  {
+    if (nrkey_p == 0) {
+      return False;
+    }
+    std::vector<SortPackedKeyInfo> info(nrkey_p);
+    uInt nbits = 0;
+    for (size_t i=0; i<nrkey_p; ++i) {
+      const SortKey& key = *keys_p[i];
+      SortPackedKeyInfo& ki = info[i];
+      ki.dtype      = key.cmpObj_p->dataType();
+      ki.data       = static_cast<const char*>(key.data_p);
+      ki.incr       = key.incr_p;
+      // If all keys are descending, an ascending sort is done and reversed.
+      ki.descending = (key.order_p == Descending  &&  order_p != Descending);
+      Bool ok = True;
+      switch (ki.dtype) {
+      case TpBool:
+        ok = sortKeyRange<Bool>   (ki, nrrec);
+        break;
+      case TpChar:
+        ok = sortKeyRange<Char>   (ki, nrrec);
+        break;
+      case TpUChar:
+        ok = sortKeyRange<uChar>  (ki, nrrec);
+        break;
+      case TpShort:
+        ok = sortKeyRange<Short>  (ki, nrrec);
+        break;
+      case TpUShort:
+        ok = sortKeyRange<uShort> (ki, nrrec);
+        break;
+      case TpInt:
+        ok = sortKeyRange<Int>    (ki, nrrec);
+        break;
+      case TpUInt:
+        ok = sortKeyRange<uInt>   (ki, nrrec);
+        break;
+      case TpInt64:
+        ok = sortKeyRange<Int64>  (ki, nrrec);
+        break;
+      case TpFloat:
+        ok = sortKeyRange<Float>  (ki, nrrec);
+        break;
+      case TpDouble:
+        ok = sortKeyRange<Double> (ki, nrrec);
+        break;
+      case TpString:
+        {
+          // Replace the strings by their ranks.
+          const char* data = ki.data;
+          const uInt incr = ki.incr;
+          auto str = [data, incr](T j) -> const String&
+            { return *reinterpret_cast<const String*>(data + j*incr); };
+          std::vector<T> order(nrrec);
+          for (T j=0; j<nrrec; ++j) {
+            order[j] = j;
+          }
+          std::sort (order.begin(), order.end(),
+                     [&str](T j1, T j2) { return str(j1) < str(j2); });
+          ki.ranks.resize (nrrec);
+          Int64 rank = 0;
+          ki.ranks[order[0]] = 0;
+          for (T j=1; j<nrrec; ++j) {
+            if (str(order[j]) != str(order[j-1])) {
+              ++rank;
+            }
+            ki.ranks[order[j]] = rank;
+          }
+          ki.dtype = TpInt64;
+          ki.data  = reinterpret_cast<const char*>(ki.ranks.data());
+          ki.incr  = sizeof(Int64);
+          ok = sortKeyRange<Int64> (ki, nrrec);
+        }
+        break;
+      default:
+        // Other types or a non-standard comparison object.
+        return False;
+      }
+      if (!ok) {
+        return False;
+      }
+      nbits += ki.nbits;
+    }
+    Bool reverse = (order_p == Descending);
+    if (nbits <= 64) {
+      n = sortPacked<1> (info, nrrec, inx, nodup, reverse, nthr);
+    } else if (nbits <= 128) {
+      n = sortPacked<2> (info, nrrec, inx, nodup, reverse, nthr);
+    } else if (nbits <= 192) {
+      n = sortPacked<3> (info, nrrec, inx, nodup, reverse, nthr);
+    } else if (nbits <= 256) {
+      n = sortPacked<4> (info, nrrec, inx, nodup, reverse, nthr);
+    } else {
+      return False;
+    }
+    return True;
+  }
+
   template<typename T>
   T Sort::doUnique (Vector<T>& uniqueVector, T nrrec) const
   {
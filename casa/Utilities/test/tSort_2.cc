@@ -0,0 +1,184 @@
+//# tSort_2.cc: Test program for the packed key sort of class Sort
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include <casacore/casa/Utilities/Sort.h>
+#include <casacore/casa/Utilities/Compare.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/stdlib.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+// This program tests the packed key (radix) sort of class Sort
+// by comparing its results with the results of the merge sort,
+// which uses the comparison objects.
+
+
+// Check that the packed sort gives the same result as a merge sort
+// (which keeps the first record of equal records if NoDuplicates is given).
+// The number of resulting records is checked if expNr > 0.
+void check (const Sort& sort, uInt nr, int opt, uInt expNr=0)
+{
+  Vector<uInt> inx1, inx2;
+  uInt n1 = sort.sort (inx1, nr, opt);
+  uInt n2 = sort.sort (inx2, nr, (opt & Sort::NoDuplicates) | Sort::ParSort,
+                       False);
+  AlwaysAssertExit (n1 == n2);
+  AlwaysAssertExit (allEQ (inx1, inx2));
+  AlwaysAssertExit (expNr == 0  ||  n1 == expNr);
+  // Also check the 64-bit index version.
+  Vector<uInt64> inx3;
+  uInt64 n3 = sort.sort (inx3, uInt64(nr), opt);
+  AlwaysAssertExit (n3 == n1);
+  for (uInt i=0; i<n1; ++i) {
+    AlwaysAssertExit (inx3[i] == inx1[i]);
+  }
+}
+
+// Sort on MS-like keys TIME, ANTENNA1, ANTENNA2.
+void sortMS (uInt nr)
+{
+  Vector<Double> time(nr);
+  Vector<Int> ant1(nr), ant2(nr);
+  for (uInt i=0; i<nr; ++i) {
+    time[i] = 4.8e9 + 10 * (rand() % 50);
+    ant1[i] = rand() % 20;
+    ant2[i] = rand() % 20;
+  }
+  for (int opt : {int(Sort::DefaultSort), int(Sort::ParSort)}) {
+    Sort sort;
+    sort.sortKey (time.data(), TpDouble);
+    sort.sortKey (ant1.data(), TpInt);
+    sort.sortKey (ant2.data(), TpInt, 0, Sort::Descending);
+    check (sort, nr, opt, nr);
+    check (sort, nr, opt | Sort::NoDuplicates);
+  }
+}
+
+// Sort on keys of various types in a struct.
+void sortStruct (uInt nr)
+{
+  struct Rec {
+    Short  s;
+    uChar  c;
+    Bool   b;
+    Int64  l;
+    Float  f;
+    String str;
+  };
+  std::vector<Rec> recs(nr);
+  for (uInt i=0; i<nr; ++i) {
+    recs[i].s   = rand()%7 - 3;
+    recs[i].c   = rand()%256;
+    recs[i].b   = rand()%2;
+    recs[i].l   = Int64(rand()%5 - 2) << 40;
+    recs[i].f   = (rand()%9 - 4) * 0.5;
+    recs[i].str = String::toString (rand()%13);
+  }
+  // A negative zero must be equal to a positive zero.
+  recs[0].f = -0.;
+  recs[1].f = 0.;
+  {
+    Sort sort (recs.data(), sizeof(Rec));
+    sort.sortKey ((char*)&recs[0].str - (char*)&recs[0], TpString);
+    sort.sortKey ((char*)&recs[0].f - (char*)&recs[0], TpFloat,
+                  Sort::Descending);
+    sort.sortKey ((char*)&recs[0].s - (char*)&recs[0], TpShort);
+    check (sort, nr, Sort::DefaultSort, nr);
+    check (sort, nr, Sort::NoDuplicates);
+  }
+  {
+    Sort sort;
+    sort.sortKey (&recs[0].b, TpBool, sizeof(Rec), Sort::Descending);
+    sort.sortKey (&recs[0].l, TpInt64, sizeof(Rec));
+    sort.sortKey (&recs[0].c, TpUChar, sizeof(Rec));
+    check (sort, nr, Sort::DefaultSort, nr);
+    check (sort, nr, Sort::NoDuplicates);
+  }
+  // Strings in separate array and descending.
+  Vector<String> strs(nr);
+  Vector<uInt> uints(nr);
+  for (uInt i=0; i<nr; ++i) {
+    strs[i]  = recs[i].str;
+    uints[i] = rand();
+  }
+  {
+    Sort sort;
+    sort.sortKey (strs.data(), TpString, 0, Sort::Descending);
+    sort.sortKey (uints.data(), TpUInt);
+    check (sort, nr, Sort::DefaultSort, nr);
+  }
+}
+
+// Check that NaN values and custom comparison objects still work.
+void sortFallback (uInt nr)
+{
+  Vector<Double> vals(nr);
+  Vector<Int> ivals(nr);
+  for (uInt i=0; i<nr; ++i) {
+    vals[i]  = rand() % 10;
+    ivals[i] = rand() % 100;
+  }
+  vals[nr/2] = doubleNaN();
+  {
+    Sort sort;
+    sort.sortKey (vals.data(), TpDouble);
+    sort.sortKey (ivals.data(), TpInt);
+    Vector<uInt> inx;
+    AlwaysAssertExit (sort.sort (inx, nr) == nr);
+  }
+  {
+    // Sort on intervals of 10, thus the last digit is ignored.
+    Sort sort;
+    sort.sortKey (ivals.data(),
+                  std::make_shared<CompareIntervalInt<Int>>(10, 0), sizeof(Int));
+    sort.sortKey (vals.data(), TpDouble);
+    Vector<uInt> inx;
+    AlwaysAssertExit (sort.sort (inx, nr) == nr);
+    for (uInt i=1; i<nr; ++i) {
+      AlwaysAssertExit (ivals[inx[i-1]]/10 <= ivals[inx[i]]/10);
+    }
+  }
+}
+
+int main()
+{
+  try {
+    for (uInt nr : {10u, 999u, 1000u, 25000u}) {
+      sortMS (nr);
+      sortStruct (nr);
+      sortFallback (nr);
+    }
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
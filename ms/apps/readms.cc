@@ -32,6 +32,7 @@
 #include <casacore/tables/Tables/ArrayColumn.h>
 #include <casacore/tables/TaQL/TableParse.h>
 #include <casacore/tables/DataMan/TiledStManAccessor.h>
+#include <casacore/tables/DataMan/TSMOption.h>
 #include <casacore/casa/HDF5/HDF5File.h>
 #include <casacore/casa/HDF5/HDF5Group.h>
 #include <casacore/casa/HDF5/HDF5Record.h>
@@ -63,6 +64,7 @@ int    myNChan;
 int    myCacheSizeData;
 int    myCacheSizeFlag;
 int    myCacheSizeWeight;
+int    myNThreadRead;
 String myMsName;
 String myBaselines;
 String mySelection;
@@ -140,6 +142,9 @@ bool readParms (int argc, char* argv[])
   params.create ("weightcachesize", "0",
                  "TiledStMan cache size for WEIGHT column (in tiles)",
                  "int");
+  params.create ("nthreadread", "1",
+                 "Number of threads to read a column in parallel (>1 uses a thread-safe TiledStMan cache)",
+                 "int");
   // Fill the input structure from the command line.
   params.readArguments (argc, argv);
   // Get the various parameters.
@@ -171,6 +176,7 @@ bool readParms (int argc, char* argv[])
   myCacheSizeData      = params.getInt    ("datacachesize");
   myCacheSizeFlag      = params.getInt    ("flagcachesize");
   myCacheSizeWeight    = params.getInt    ("weightcachesize");
+  myNThreadRead        = params.getInt    ("nthreadread");
   myIterCols1 = stringToVector(params.getString ("iteration1"));
   myIterCols2 = stringToVector(params.getString ("iteration2"));
   mySortCols  = stringToVector(params.getString ("sort"));
@@ -320,6 +326,31 @@ void showParms()
   ///possibly show ntimes, etc. of selection subset
 }
 
+// Read an entire column serially or in parallel.
+template<typename T>
+void readColumn (ArrayColumn<T>& col)
+{
+  if (myNThreadRead > 1  &&  col.nrow() > 0) {
+    Array<T> arr;
+    col.getColumnRangeParallel (Slicer(IPosition(1,0), IPosition(1,col.nrow())),
+                                arr, True, myNThreadRead);
+  } else {
+    col.getColumn();
+  }
+}
+
+// Read a range of rows serially or in parallel.
+template<typename T>
+void readColumnRange (ArrayColumn<T>& col, const Slicer& rowRange,
+                      Array<T>& arr)
+{
+  if (myNThreadRead > 1) {
+    col.getColumnRangeParallel (rowRange, arr, True, myNThreadRead);
+  } else {
+    col.getColumnRange (rowRange, arr, True);
+  }
+}
+
 void readRows (ArrayColumn<Complex>& dataCol,
                ArrayColumn<float>& floatDataCol,
                ArrayColumn<Bool>& flagCol,
@@ -342,16 +373,16 @@ void readRows (ArrayColumn<Complex>& dataCol,
     }
   } else {
     if (myReadData) {
-      dataCol.getColumn();
+      readColumn (dataCol);
     }
     if (myReadFloatData) {
-      floatDataCol.getColumn();
+      readColumn (floatDataCol);
     }
     if (myReadFlag) {
-      flagCol.getColumn();
+      readColumn (flagCol);
     }
     if (myReadWeightSpectrum) {
-      weightCol.getColumn();
+      readColumn (weightCol);
     }
   }
 }
@@ -444,10 +475,10 @@ Int64 readNoIter (MeasurementSet& tab, Int64& niter)
         if (myReadWeightSpectrum) weightSpectrumCol.getColumnRange (rowRange, slicer, weights, True);
         niter++;
       } else {
-        if (myReadData) dataCol.getColumnRange (rowRange, data, True);
-        if (myReadFloatData) floatDataCol.getColumnRange (rowRange, floatData, True);
-        if (myReadFlag) flagCol.getColumnRange (rowRange, flags, True);
-        if (myReadWeightSpectrum) weightSpectrumCol.getColumnRange (rowRange, weights, True);
+        if (myReadData) readColumnRange (dataCol, rowRange, data);
+        if (myReadFloatData) readColumnRange (floatDataCol, rowRange, floatData);
+        if (myReadFlag) readColumnRange (flagCol, rowRange, flags);
+        if (myReadWeightSpectrum) readColumnRange (weightSpectrumCol, rowRange, weights);
         niter++;
       }
     }
@@ -816,7 +847,12 @@ std::vector<Int64> doOne (int seqnr, const String& msName)
   vector<Int64> res(2);
   // Open the MS.
   Timer timer;
-  Table tab(name);
+  // Use a thread-safe cache for the tiled columns if reading in parallel.
+  TSMOption tsmOpt;
+  if (myNThreadRead > 1) {
+    tsmOpt = TSMOption (TSMOption::Cache, 0, -2, -2, 4*myNThreadRead);
+  }
+  Table tab(name, Table::Old, tsmOpt);
   // Set cache sizes where applicable.
   if (myReadData) {
     setTSMCacheSize (tab, "DATA", myCacheSizeData);
@@ -889,6 +925,10 @@ void doAll()
   }
   cout << "For each part " << selNrow << " rows out of " << nrow
        << " have been read" << endl;
+  if (myNThreadRead > 1) {
+    cout << "Columns have been read using " << myNThreadRead
+         << " threads" << endl;
+  }
 }
 
 int main (int argc, char* argv[])
@@ -0,0 +1,782 @@
+//# stmanbench.cc: Benchmark storage managers for visibility data
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+
+#include <casacore/ms/MeasurementSets/MeasurementSet.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
+#include <casacore/tables/DataMan/DataManager.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/IO/ArrayIO.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Inputs/Input.h>
+#include <casacore/casa/OS/Directory.h>
+#include <casacore/casa/OS/DirectoryIterator.h>
+#include <casacore/casa/OS/Path.h>
+#include <casacore/casa/OS/OMP.h>
+#include <casacore/casa/Utilities/Regex.h>
+#include <casacore/casa/Exceptions/Error.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace casacore;
+using namespace std;
+
+
+// Define the global variables shared between the main functions.
+int    myNAnt;
+int    myNChan;
+int    myNPol;
+int    myNTime;
+int    myNBaseline;
+int    myChanSize;
+int    myDyscoBits;
+bool   myKeep;
+bool   myJson;
+bool   myStokesIData;
+String myMsName;
+Vector<String> myStMans;
+Block<Int> myNThreads;
+Matrix<double> myAntPos;
+vector<pair<Int,Int> > myBaselines;
+
+// The start time and time step (in sec) of the synthetic observation.
+const double theStartTime = 4.8e9;
+const double theStepTime  = 10.;
+// The noise level of the visibilities and the fraction of flagged data.
+const double theNoise     = 0.1;
+const double theFlagFraction = 0.05;
+
+
+// The results of a benchmark phase for one storage manager.
+struct BenchResult
+{
+  String stman;
+  int    nthread;
+  String phase;
+  String columns;
+  rownr_t nrow;
+  double mbytes;
+  double realTime;
+  double cpuTime;
+  Int64  stmanBytes;
+  Int64  msBytes;
+  double maxError;
+};
+
+
+// Measure the elapsed real time and the CPU time used by the process
+// (in all threads). The Timer class is not used, because its resolution
+// is too coarse for short benchmark phases.
+class BenchTimer
+{
+public:
+  BenchTimer()
+    : itsStart    (std::chrono::steady_clock::now()),
+      itsCpuStart (std::clock())
+  {}
+
+  double real() const
+    { return std::chrono::duration<double>
+        (std::chrono::steady_clock::now() - itsStart).count(); }
+
+  double cpu() const
+    { return double(std::clock() - itsCpuStart) / CLOCKS_PER_SEC; }
+
+private:
+  std::chrono::steady_clock::time_point itsStart;
+  std::clock_t itsCpuStart;
+};
+
+
+void showHelp()
+{
+  cout << "The program benchmarks the storage managers for visibility data."
+       << endl;
+  cout << "It writes a synthetic MeasurementSet with each storage manager and"
+       << endl;
+  cout << "number of threads and reads it back in row, channel and baseline"
+       << endl;
+  cout << "order. The results are written in CSV or JSON format." << endl;
+  cout << "The data written for StokesIStMan have zero cross-hand and equal"
+       << endl;
+  cout << "parallel-hand correlations, because only those can be stored."
+       << endl;
+  cout << "Run as:" << endl;
+  cout << "      stmanbench parm=value parm=value ..." << endl;
+  cout << "Use   stmanbench -h   to see the possible parameters." << endl;
+}
+
+
+bool readParms (int argc, char* argv[])
+{
+  // enable input in no-prompt mode
+  Input params(1);
+  // define the input structure
+  params.version("2026Oct16");
+  params.create ("msname", "stmanbench_tmp.ms",
+                 "Name of the MeasurementSets (the storage manager name "
+                 "and number of threads are appended)",
+                 "string");
+  params.create ("stman", "tiled,dysco,stokesi,uvw,antennapair",
+                 "Storage managers to benchmark "
+                 "(tiled, dysco, stokesi, uvw, antennapair)",
+                 "string vector");
+  params.create ("nthreads", "1",
+                 "Numbers of threads to use",
+                 "int vector");
+  params.create ("nant", "16",
+                 "Number of antennas (all baselines including autocorrelations are written)",
+                 "int");
+  params.create ("ntime", "50",
+                 "Number of time slots",
+                 "int");
+  params.create ("nchan", "64",
+                 "Number of channels",
+                 "int");
+  params.create ("npol", "4",
+                 "Number of polarizations",
+                 "int");
+  params.create ("chansize", "1",
+                 "Number of channels to read jointly in channel order",
+                 "int");
+  params.create ("dyscobits", "8",
+                 "Number of bits per data value for DyscoStMan",
+                 "int");
+  params.create ("format", "csv",
+                 "Output format (csv or json)",
+                 "string");
+  params.create ("keep", "false",
+                 "Keep the MeasurementSets after the benchmark?",
+                 "bool");
+  // Fill the input structure from the command line.
+  params.readArguments (argc, argv);
+  // Get the various parameters.
+  myMsName    = params.getString ("msname");
+  myStMans    = stringToVector (params.getString ("stman"));
+  myNThreads  = params.getIntArray ("nthreads");
+  myNAnt      = params.getInt ("nant");
+  myNTime     = params.getInt ("ntime");
+  myNChan     = params.getInt ("nchan");
+  myNPol      = params.getInt ("npol");
+  myChanSize  = std::max (1, params.getInt ("chansize"));
+  myDyscoBits = params.getInt ("dyscobits");
+  myKeep      = params.getBool ("keep");
+  String format = params.getString ("format");
+  format.downcase();
+  myJson = (format == "json");
+  if (myMsName.empty()  ||  myNAnt < 2  ||  myNTime < 1  ||  myNChan < 1) {
+    showHelp();
+    return false;
+  }
+  AlwaysAssert (myNPol==1  ||  myNPol==2  ||  myNPol==4, AipsError);
+  AlwaysAssert (format == "csv"  ||  format == "json", AipsError);
+  return true;
+}
+
+
+// Fill the antenna positions (random within 3 km) and the baselines.
+// The baselines are ordered by antenna1 as needed by UvwStMan.
+void makeArray()
+{
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> pos(-1500., 1500.);
+  myAntPos.resize (3, myNAnt);
+  for (int i=0; i<myNAnt; ++i) {
+    myAntPos(0,i) = pos(rng);
+    myAntPos(1,i) = pos(rng);
+    myAntPos(2,i) = 0.1 * pos(rng);
+  }
+  myBaselines.clear();
+  for (int a1=0; a1<myNAnt; ++a1) {
+    for (int a2=a1; a2<myNAnt; ++a2) {
+      myBaselines.push_back (make_pair(a1, a2));
+    }
+  }
+  myNBaseline = myBaselines.size();
+}
+
+// Calculate the UVW coordinates of all baselines in time slot t.
+// The earth rotation is mimicked by rotating the baselines around the z-axis.
+void makeUvw (int t, Matrix<double>& uvw)
+{
+  uvw.resize (3, myNBaseline);
+  double angle = 2.0*M_PI * t * theStepTime / 86400.;
+  double sa = sin(angle);
+  double ca = cos(angle);
+  for (int i=0; i<myNBaseline; ++i) {
+    int a1 = myBaselines[i].first;
+    int a2 = myBaselines[i].second;
+    double x = myAntPos(0,a2) - myAntPos(0,a1);
+    double y = myAntPos(1,a2) - myAntPos(1,a1);
+    uvw(0,i) = x*ca - y*sa;
+    uvw(1,i) = x*sa + y*ca;
+    uvw(2,i) = myAntPos(2,a2) - myAntPos(2,a1);
+  }
+}
+
+// Generate the visibilities and flags of time slot t.
+// The visibilities contain an unpolarized point source with a phase
+// depending on the uv-coordinates and frequency, and Gaussian noise.
+// A fixed seed per time slot is used, so the same data can be generated
+// again to check the data read back.
+// For StokesIStMan the cross-hands are zero and the parallel hands equal.
+void makeData (int t, Cube<Complex>& data, Cube<Bool>& flags)
+{
+  data.resize (myNPol, myNChan, myNBaseline);
+  flags.resize (myNPol, myNChan, myNBaseline);
+  Matrix<double> uvw;
+  makeUvw (t, uvw);
+  std::mt19937 rng(1000 + t);
+  std::normal_distribution<float> noise(0., theNoise);
+  std::uniform_real_distribution<double> unif(0., 1.);
+  for (int i=0; i<myNBaseline; ++i) {
+    for (int c=0; c<myNChan; ++c) {
+      // Wavelengths per meter for frequencies around 150 MHz.
+      double scale = (1.4 + 0.2*c/myNChan) * 0.5;
+      double phase = 2.0*M_PI * scale * (uvw(0,i) * 1e-3 + uvw(1,i) * 2e-3);
+      Complex source (cos(phase), sin(phase));
+      Bool flag = unif(rng) < theFlagFraction;
+      for (int p=0; p<myNPol; ++p) {
+        Complex val (noise(rng), noise(rng));
+        // Only the parallel hands contain the source.
+        if (p == 0  ||  p == myNPol-1) {
+          val += source;
+        } else if (myStokesIData) {
+          val = Complex();
+        }
+        data(p,c,i)  = val;
+        flags(p,c,i) = flag;
+      }
+      if (myStokesIData) {
+        data(myNPol-1,c,i) = data(0,c,i);
+      }
+    }
+  }
+}
+
+
+// Does the column have a channel axis?
+bool hasChannels (const String& column)
+{
+  return column == "DATA"  ||  column == "FLAG";
+}
+
+// Get the storage manager to benchmark and the columns it has to contain.
+// The storage managers are created using their registered names, so
+// DyscoStMan is only available if casacore is built with it.
+// DyscoStMan uses the given number of threads to compress the data.
+std::unique_ptr<DataManager> makeStMan (const String& stman, int nthread,
+                                        vector<String>& columns)
+{
+  Record spec;
+  String type;
+  if (stman == "tiled") {
+    columns = {"DATA", "FLAG"};
+    IPosition tileShape(3, myNPol, myNChan, max(1, 32768 / (myNPol*myNChan)));
+    return std::unique_ptr<DataManager>
+      (new TiledColumnStMan ("BenchStMan", tileShape));
+  } else if (stman == "dysco") {
+    columns = {"DATA"};
+    type = "DyscoStMan";
+    spec.define ("dataBitCount", myDyscoBits);
+    spec.define ("weightBitCount", 12);
+    spec.define ("distribution", "TruncatedGaussian");
+    spec.define ("distributionTruncation", 2.5);
+    spec.define ("normalization", "AF");
+    spec.define ("threadCount", nthread);
+  } else if (stman == "stokesi") {
+    columns = {"DATA", "FLAG"};
+    type = "StokesIStMan";
+  } else if (stman == "uvw") {
+    columns = {"UVW"};
+    type = "UvwStMan";
+  } else if (stman == "antennapair") {
+    columns = {"ANTENNA1", "ANTENNA2"};
+    type = "AntennaPairStMan";
+  } else {
+    throw AipsError ("unknown storage manager " + stman);
+  }
+  if (! DataManager::isRegistered (type)) {
+    // Try to load it from a shared library.
+    try {
+      DataManager::getCtor (type);
+    } catch (const std::exception&) {
+    }
+    if (! DataManager::isRegistered (type)) {
+      throw AipsError ("storage manager " + type + " is not available");
+    }
+  }
+  return std::unique_ptr<DataManager>
+    (DataManager::getCtor(type) ("BenchStMan", spec));
+}
+
+// Create the MS with the given storage manager for the benchmarked columns.
+// The other data columns are stored with the TiledColumnStMan, the
+// remaining columns with the StandardStMan.
+MeasurementSet createMS (const String& msName, DataManager& stman,
+                         const vector<String>& columns)
+{
+  TableDesc td = MS::requiredTableDesc();
+  MS::addColumnToDesc (td, MS::DATA, 2);
+  IPosition dataShape(2, myNPol, myNChan);
+  td.rwColumnDesc(MS::columnName(MS::DATA)).setShape (dataShape, True);
+  td.rwColumnDesc(MS::columnName(MS::FLAG)).setShape (dataShape, True);
+  SetupNewTable newTab(msName, td, Table::New);
+  StandardStMan ssm("SSM", 32768);
+  newTab.bindAll (ssm);
+  IPosition tileShape(3, myNPol, myNChan, max(1, 32768 / (myNPol*myNChan)));
+  TiledColumnStMan tsm("TiledData", tileShape);
+  newTab.bindColumn (MS::columnName(MS::DATA), tsm);
+  newTab.bindColumn (MS::columnName(MS::FLAG), tsm);
+  for (const String& col : columns) {
+    newTab.bindColumn (col, stman);
+  }
+  MeasurementSet ms(newTab, 0);
+  ms.createDefaultSubtables (Table::New);
+  return ms;
+}
+
+// Write the given column for the rows of time slot t.
+// Column ANTENNA2 is written together with ANTENNA1.
+// It returns the number of bytes written.
+double writeColumn (MeasurementSet& ms, const String& column, int t,
+                    const Cube<Complex>& data, const Cube<Bool>& flags,
+                    const Matrix<double>& uvw)
+{
+  Slicer rows(IPosition(1, rownr_t(t)*myNBaseline), IPosition(1, myNBaseline));
+  if (column == "DATA") {
+    ArrayColumn<Complex>(ms, column).putColumnRange (rows, data);
+    return data.size() * sizeof(Complex);
+  } else if (column == "FLAG") {
+    ArrayColumn<Bool>(ms, column).putColumnRange (rows, flags);
+    return flags.size() * sizeof(Bool);
+  } else if (column == "UVW") {
+    ArrayColumn<Double>(ms, column).putColumnRange (rows, uvw);
+    return uvw.size() * sizeof(Double);
+  } else if (column == "ANTENNA1") {
+    // Both antenna columns are written row by row, because AntennaPairStMan
+    // requires that.
+    ScalarColumn<Int> ant1(ms, "ANTENNA1");
+    ScalarColumn<Int> ant2(ms, "ANTENNA2");
+    rownr_t row = rownr_t(t) * myNBaseline;
+    for (int i=0; i<myNBaseline; ++i, ++row) {
+      ant1.put (row, myBaselines[i].first);
+      ant2.put (row, myBaselines[i].second);
+    }
+    return 2. * myNBaseline * sizeof(Int);
+  } else if (column == "TIME"  ||  column == "TIME_CENTROID") {
+    Vector<Double> times(myNBaseline, theStartTime + (t+0.5)*theStepTime);
+    ScalarColumn<Double>(ms, column).putColumnRange (rows, times);
+    return times.size() * sizeof(Double);
+  } else if (column == "INTERVAL"  ||  column == "EXPOSURE") {
+    Vector<Double> intervals(myNBaseline, theStepTime);
+    ScalarColumn<Double>(ms, column).putColumnRange (rows, intervals);
+    return intervals.size() * sizeof(Double);
+  }
+  return 0;
+}
+
+// Write the MS. First the rows are added and the columns not being
+// benchmarked are written, because some storage managers (UvwStMan and
+// DyscoStMan) need the antenna and time columns. Thereafter the benchmarked
+// columns are written and flushed while timing.
+BenchResult writeMS (MeasurementSet& ms, const vector<String>& columns)
+{
+  const vector<String> allColumns = {"TIME", "TIME_CENTROID", "INTERVAL",
+                                     "EXPOSURE", "ANTENNA1", "ANTENNA2",
+                                     "UVW", "DATA", "FLAG"};
+  Cube<Complex> data;
+  Cube<Bool> flags;
+  Matrix<double> uvw;
+  for (int t=0; t<myNTime; ++t) {
+    ms.addRow (myNBaseline);
+    makeData (t, data, flags);
+    makeUvw (t, uvw);
+    for (const String& col : allColumns) {
+      if (std::find (columns.begin(), columns.end(), col) == columns.end()) {
+        writeColumn (ms, col, t, data, flags, uvw);
+      }
+    }
+  }
+  ms.flush (True);
+  // Generate the data in advance if not too large to leave it out of the
+  // timing.
+  vector<Cube<Complex> > allData;
+  vector<Cube<Bool> > allFlags;
+  bool preGenerate = (double(myNTime) * myNBaseline * myNChan * myNPol <
+                      64. * 1024*1024);
+  if (preGenerate) {
+    allData.resize (myNTime);
+    allFlags.resize (myNTime);
+    for (int t=0; t<myNTime; ++t) {
+      makeData (t, allData[t], allFlags[t]);
+    }
+  }
+  BenchResult res;
+  res.phase = "write";
+  res.mbytes = 0;
+  BenchTimer timer;
+  for (int t=0; t<myNTime; ++t) {
+    if (! preGenerate) {
+      makeData (t, data, flags);
+    }
+    makeUvw (t, uvw);
+    for (const String& col : columns) {
+      res.mbytes += writeColumn (ms, col, t,
+                                 preGenerate ? allData[t] : data,
+                                 preGenerate ? allFlags[t] : flags, uvw);
+    }
+  }
+  ms.flush (True);
+  res.realTime = timer.real();
+  res.cpuTime  = timer.cpu();
+  res.mbytes  /= 1024. * 1024.;
+  res.nrow = ms.nrow();
+  return res;
+}
+
+
+// Read an array column in row order in chunks of a time slot.
+template<typename T>
+double readRowOrder (const Table& tab, const String& column, int nthread)
+{
+  ArrayColumn<T> col(tab, column);
+  Array<T> arr;
+  for (int t=0; t<myNTime; ++t) {
+    Slicer rows(IPosition(1, rownr_t(t)*myNBaseline),
+                IPosition(1, myNBaseline));
+    if (nthread > 1) {
+      col.getColumnRangeParallel (rows, arr, True, nthread);
+    } else {
+      col.getColumnRange (rows, arr, True);
+    }
+  }
+  return double(tab.nrow()) * col.shape(0).product() * sizeof(T);
+}
+
+// Read an array column in channel order, thus for each channel block
+// all rows (in chunks of a time slot).
+template<typename T>
+double readChannelOrder (const Table& tab, const String& column)
+{
+  ArrayColumn<T> col(tab, column);
+  IPosition shape = col.shape(0);
+  Array<T> arr;
+  for (int c=0; c<myNChan; c+=myChanSize) {
+    int nc = std::min (myChanSize, myNChan-c);
+    Slicer section(IPosition(2, 0, c), IPosition(2, shape[0], nc));
+    for (int t=0; t<myNTime; ++t) {
+      Slicer rows(IPosition(1, rownr_t(t)*myNBaseline),
+                  IPosition(1, myNBaseline));
+      col.getColumnRange (rows, section, arr, True);
+    }
+  }
+  return double(tab.nrow()) * shape.product() * sizeof(T);
+}
+
+// Read an array column in baseline order, thus for each baseline the
+// rows of all time slots.
+template<typename T>
+double readBaselineOrder (const Table& tab, const String& column, int nthread)
+{
+  ArrayColumn<T> col(tab, column);
+  Array<T> arr;
+  for (int i=0; i<myNBaseline; ++i) {
+    RefRows rows(i, i + rownr_t(myNTime-1)*myNBaseline, myNBaseline);
+    if (nthread > 1) {
+      col.getColumnCellsParallel (rows, arr, True, nthread);
+    } else {
+      col.getColumnCells (rows, arr, True);
+    }
+  }
+  return double(tab.nrow()) * col.shape(0).product() * sizeof(T);
+}
+
+// Read a scalar column in row or baseline order.
+double readScalar (const Table& tab, const String& column, bool baselineOrder)
+{
+  ScalarColumn<Int> col(tab, column);
+  Vector<Int> vec;
+  if (baselineOrder) {
+    for (int i=0; i<myNBaseline; ++i) {
+      RefRows rows(i, i + rownr_t(myNTime-1)*myNBaseline, myNBaseline);
+      col.getColumnCells (rows, vec, True);
+    }
+  } else {
+    for (int t=0; t<myNTime; ++t) {
+      Slicer rows(IPosition(1, rownr_t(t)*myNBaseline),
+                  IPosition(1, myNBaseline));
+      col.getColumnRange (rows, vec, True);
+    }
+  }
+  return double(tab.nrow()) * sizeof(Int);
+}
+
+// Read the benchmarked columns in the given order.
+// The MS is reopened, so nothing is cached in the table system.
+// If multiple threads are used, the tiled storage managers use a sharded
+// cache, because only then the rows are read in parallel. DyscoStMan
+// decompresses using that number of threads.
+// An empty result is returned if no column can be read in that order.
+bool readMS (const String& msName, const vector<String>& columns,
+             const String& phase, int nthread, BenchResult& res)
+{
+  TSMOption tsmOpt(TSMOption::Cache, -2, -2, -2, nthread > 1 ? nthread : 0);
+  Table tab(msName, Table::Old, tsmOpt);
+  DataManager* stman = tab.findDataManager (columns[0], True);
+  if (stman->dataManagerType() == "DyscoStMan") {
+    Record props;
+    props.define ("threadCount", nthread);
+    stman->setProperties (props);
+  }
+  res.phase  = phase;
+  res.mbytes = 0;
+  res.nrow   = tab.nrow();
+  bool done = false;
+  BenchTimer timer;
+  for (const String& col : columns) {
+    if (phase == "read_channel") {
+      if (col == "DATA") {
+        res.mbytes += readChannelOrder<Complex> (tab, col);
+        done = true;
+      } else if (col == "FLAG") {
+        res.mbytes += readChannelOrder<Bool> (tab, col);
+        done = true;
+      }
+    } else if (phase == "read_row") {
+      done = true;
+      if (col == "DATA") {
+        res.mbytes += readRowOrder<Complex> (tab, col, nthread);
+      } else if (col == "FLAG") {
+        res.mbytes += readRowOrder<Bool> (tab, col, nthread);
+      } else if (col == "UVW") {
+        res.mbytes += readRowOrder<Double> (tab, col, nthread);
+      } else {
+        res.mbytes += readScalar (tab, col, false);
+      }
+    } else {
+      done = true;
+      if (col == "DATA") {
+        res.mbytes += readBaselineOrder<Complex> (tab, col, nthread);
+      } else if (col == "FLAG") {
+        res.mbytes += readBaselineOrder<Bool> (tab, col, nthread);
+      } else if (col == "UVW") {
+        res.mbytes += readBaselineOrder<Double> (tab, col, nthread);
+      } else {
+        res.mbytes += readScalar (tab, col, true);
+      }
+    }
+  }
+  res.realTime = timer.real();
+  res.cpuTime  = timer.cpu();
+  res.mbytes  /= 1024. * 1024.;
+  return done;
+}
+
+// Determine the maximum absolute difference between the values written
+// and read back. A flag or antenna difference counts as 1.
+double checkMS (const String& msName, const vector<String>& columns)
+{
+  Table tab(msName);
+  double maxErr = 0;
+  Cube<Complex> data;
+  Cube<Bool> flags;
+  Matrix<double> uvw;
+  for (int t=0; t<myNTime; ++t) {
+    Slicer rows(IPosition(1, rownr_t(t)*myNBaseline),
+                IPosition(1, myNBaseline));
+    makeData (t, data, flags);
+    makeUvw (t, uvw);
+    for (const String& col : columns) {
+      if (col == "DATA") {
+        Cube<Complex> vals (ArrayColumn<Complex>(tab, col).getColumnRange(rows));
+        for (size_t i=0; i<vals.size(); ++i) {
+          maxErr = std::max (maxErr, double(abs(vals.data()[i] -
+                                                data.data()[i])));
+        }
+      } else if (col == "FLAG") {
+        Cube<Bool> vals (ArrayColumn<Bool>(tab, col).getColumnRange(rows));
+        if (! std::equal (vals.begin(), vals.end(), flags.begin())) {
+          maxErr = std::max (maxErr, 1.);
+        }
+      } else if (col == "UVW") {
+        Matrix<Double> vals (ArrayColumn<Double>(tab, col).getColumnRange(rows));
+        for (size_t i=0; i<vals.size(); ++i) {
+          maxErr = std::max (maxErr, fabs(vals.data()[i] - uvw.data()[i]));
+        }
+      } else {
+        Vector<Int> vals (ScalarColumn<Int>(tab, col).getColumnRange(rows));
+        for (int i=0; i<myNBaseline; ++i) {
+          Int ant = (col == "ANTENNA1" ?
+                     myBaselines[i].first : myBaselines[i].second);
+          if (vals[i] != ant) {
+            maxErr = std::max (maxErr, 1.);
+          }
+        }
+      }
+    }
+  }
+  return maxErr;
+}
+
+// Get the number of bytes on disk used by the storage managers of the
+// given columns. The files of a storage manager start with its file name.
+Int64 stmanBytes (const String& msName, const vector<String>& columns)
+{
+  Table tab(msName);
+  std::set<String> fileNames;
+  for (const String& col : columns) {
+    fileNames.insert (Path(tab.findDataManager(col, True)->fileName())
+                      .baseName());
+  }
+  Int64 nbytes = 0;
+  Directory dir(msName);
+  for (const String& name : fileNames) {
+    DirectoryIterator iter(dir, Regex(Regex::fromString(name) + "(i|_.*)?"));
+    for (; !iter.pastEnd(); iter++) {
+      nbytes += iter.file().size();
+    }
+  }
+  return nbytes;
+}
+
+
+void showHeader()
+{
+  if (! myJson) {
+    cout << "stman,nthread,phase,columns,nrow,mbytes,real_s,cpu_s,"
+            "mb_per_s,stman_bytes,ms_bytes,max_error" << endl;
+  }
+}
+
+void showResult (const BenchResult& res)
+{
+  double rate = (res.realTime > 0  ?  res.mbytes / res.realTime : 0);
+  if (myJson) {
+    cout << "{\"stman\": \"" << res.stman << "\", \"nthread\": "
+         << res.nthread << ", \"phase\": \"" << res.phase
+         << "\", \"columns\": \"" << res.columns << "\", \"nrow\": "
+         << res.nrow << ", \"mbytes\": " << res.mbytes << ", \"real_s\": "
+         << res.realTime << ", \"cpu_s\": " << res.cpuTime
+         << ", \"mb_per_s\": " << rate << ", \"stman_bytes\": "
+         << res.stmanBytes << ", \"ms_bytes\": " << res.msBytes
+         << ", \"max_error\": " << res.maxError << "}" << endl;
+  } else {
+    cout << res.stman << ',' << res.nthread << ',' << res.phase << ','
+         << res.columns << ',' << res.nrow << ',' << res.mbytes << ','
+         << res.realTime << ',' << res.cpuTime << ',' << rate << ','
+         << res.stmanBytes << ',' << res.msBytes << ',' << res.maxError
+         << endl;
+  }
+}
+
+// Benchmark a storage manager using the given number of threads.
+void doBench (const String& stmanName, int nthread)
+{
+  OMP::setNumThreads (nthread);
+  myStokesIData = (stmanName == "stokesi");
+  String msName = myMsName + '_' + stmanName + String::format("_t%d", nthread);
+  vector<String> columns;
+  std::unique_ptr<DataManager> stman = makeStMan (stmanName, nthread, columns);
+  vector<BenchResult> results;
+  {
+    MeasurementSet ms = createMS (msName, *stman, columns);
+    results.push_back (writeMS (ms, columns));
+  }
+  const char* phases[] = {"read_row", "read_channel", "read_baseline"};
+  for (const char* phase : phases) {
+    BenchResult res;
+    if (readMS (msName, columns, phase, nthread, res)) {
+      results.push_back (res);
+    }
+  }
+  double maxErr = checkMS (msName, columns);
+  Int64 nbytes  = stmanBytes (msName, columns);
+  Int64 msBytes = Directory(msName).size();
+  String colNames;
+  for (const String& col : columns) {
+    if (! colNames.empty()) {
+      colNames += ';';
+    }
+    colNames += col;
+  }
+  for (BenchResult& res : results) {
+    res.stman      = stmanName;
+    res.nthread    = nthread;
+    res.columns    = colNames;
+    res.stmanBytes = nbytes;
+    res.msBytes    = msBytes;
+    res.maxError   = maxErr;
+    showResult (res);
+  }
+  if (! myKeep) {
+    Table tab(msName, Table::Delete);
+  }
+}
+
+
+int main (int argc, char* argv[])
+{
+  try {
+    if (!readParms (argc, argv)) {
+      return 1;
+    }
+    makeArray();
+    showHeader();
+    for (const String& stman : myStMans) {
+      for (Int nthread : myNThreads) {
+        try {
+          doBench (stman, std::max(1, nthread));
+        } catch (const std::exception& x) {
+          cerr << "stmanbench: " << stman << " skipped: " << x.what()
+               << endl;
+        }
+      }
+    }
+  } catch (const std::exception& x) {
+    cerr << "Exception caught: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
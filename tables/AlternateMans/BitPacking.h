@@ -1,47 +1,75 @@
 #ifndef CASACORE_TABLES_BITPACKING_H_
 #define CASACORE_TABLES_BITPACKING_H_
 
+#include <cstdint>
 #include <cstring>
 
+/**
+ * Pack an array of bools into bits, with the first bool in the least
+ * significant bit of the first byte. Unused bits in the last byte are set to
+ * zero.
+ *
+ * Eight booleans are packed at once by treating them as the bytes of a 64-bit
+ * integer: a multiplication moves the lowest bit of each of the bytes to the
+ * top byte. This relies on bools being stored as bytes with value 0 or 1.
+ * Big-endian machines use a plain loop instead.
+ */
 inline void PackBoolArray(unsigned char* packed_buffer, const bool* input,
                           size_t n) {
+  static_assert(sizeof(bool) == 1, "Bit packing requires single-byte bools");
   const size_t limit = n / 8;
-  const bool* end = input + n;
   for (size_t i = 0; i != limit; ++i) {
-    *packed_buffer = 0;
-    for (size_t b = 0; b != 8; ++b) {
-      *packed_buffer |= (*input) << b;
-      ++input;
-    }
-    ++packed_buffer;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t bools;
+    std::memcpy(&bools, input, 8);
+    // Byte i has its value at bit 8i, which the multiplication moves to bit
+    // 56 + i. The other products do not touch the top byte nor overlap.
+    packed_buffer[i] =
+        static_cast<unsigned char>((bools * 0x0102040810204080ULL) >> 56);
+#else
+    packed_buffer[i] = 0;
+    for (size_t b = 0; b != 8; ++b) packed_buffer[i] |= input[b] << b;
+#endif
+    input += 8;
   }
-  size_t b = 0;
-  if (input != end) {
+  packed_buffer += limit;
+  const size_t remainder = n % 8;
+  if (remainder != 0) {
     *packed_buffer = 0;
-    do {
+    for (size_t b = 0; b != remainder; ++b) {
       *packed_buffer |= (*input) << b;
       ++input;
-      ++b;
-    } while (input != end);
+    }
   }
 }
 
+/**
+ * Unpack bits packed with @ref PackBoolArray(). Eight bits are unpacked at once
+ * by spreading the byte over the bytes of a 64-bit integer and selecting one
+ * bit in each.
+ */
 inline void UnpackBoolArray(bool* output, const unsigned char* packed_input,
                             size_t n) {
-  bool* end = output + n;
   const size_t limit = n / 8;
-  for (size_t i = 0; i != limit; i++) {
-    for (size_t b = 0; b != 8; ++b) {
-      *output = (*packed_input >> b) & 0x1;
-      ++output;
-    }
-    ++packed_input;
+  for (size_t i = 0; i != limit; ++i) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    // Byte b of 'bits' contains only bit b of the input. Adding 0x7F to it
+    // sets bit 7 when it is non-zero, without carrying to the next byte.
+    const uint64_t bits =
+        (packed_input[i] * 0x0101010101010101ULL) & 0x8040201008040201ULL;
+    const uint64_t bools =
+        ((bits + 0x7F7F7F7F7F7F7F7FULL) >> 7) & 0x0101010101010101ULL;
+    std::memcpy(output, &bools, 8);
+#else
+    for (size_t b = 0; b != 8; ++b) output[b] = (packed_input[i] >> b) & 0x1;
+#endif
+    output += 8;
   }
-  size_t b = 0;
-  while (output != end) {
+  packed_input += limit;
+  const size_t remainder = n % 8;
+  for (size_t b = 0; b != remainder; ++b) {
     *output = (*packed_input >> b) & 0x1;
     ++output;
-    ++b;
   }
 }
 
@@ -45,8 +45,7 @@ class VarBufferedColumnarFile : private RowBasedFile {
 
   VarBufferedColumnarFile(const VarBufferedColumnarFile& rhs) = delete;
   VarBufferedColumnarFile(VarBufferedColumnarFile&& rhs) noexcept
-      : packed_buffer_(std::move(rhs.packed_buffer_)),
-        block_changed_(rhs.block_changed_),
+      : block_changed_(rhs.block_changed_),
         active_block_(rhs.active_block_),
         rows_per_block_(rhs.rows_per_block_),
         block_buffer_(std::move(rhs.block_buffer_)) {
@@ -71,7 +70,6 @@ class VarBufferedColumnarFile : private RowBasedFile {
   VarBufferedColumnarFile& operator=(VarBufferedColumnarFile&& rhs) {
     Close();
     RowBasedFile::operator=(std::move(rhs));
-    std::swap(packed_buffer_, rhs.packed_buffer_);
     std::swap(block_changed_, rhs.block_changed_);
     std::swap(active_block_, rhs.active_block_);
     std::swap(rows_per_block_, rhs.rows_per_block_);
@@ -162,17 +160,15 @@ class VarBufferedColumnarFile : private RowBasedFile {
    * stored with bit-packing.
    */
   void Read(uint64_t row, uint64_t column_offset, bool* data, uint64_t n) {
-    const size_t byte_size = (n + 7) / 8;
-    assert(column_offset + byte_size <= Stride());
-    ActivateBlock(row);
+    assert(column_offset + (n + 7) / 8 <= Stride());
     if (row >= NRows()) {
       std::fill_n(data, n, false);
     } else {
-      Seek(row * Stride() + column_offset + DataLocation(), SEEK_SET);
-      ReadData(packed_buffer_.data(), byte_size);
-      UnpackBoolArray(data, packed_buffer_.data(), n);
+      ActivateBlock(row);
+      UnpackBoolArray(data, CellPointer(row, column_offset), n);
     }
   }
+
   /**
    * Write one cell containing an array of floats. If the row is past the end of
    * the file, the file is enlarged (making NRows() = row + 1).
@@ -220,13 +216,11 @@ class VarBufferedColumnarFile : private RowBasedFile {
    */
   void Write(uint64_t row, uint64_t column_offset, const bool* data,
              uint64_t n) {
-    const size_t byte_size = (n + 7) / 8;
-    assert(column_offset + byte_size <= Stride());
+    assert(column_offset + (n + 7) / 8 <= Stride());
     ActivateBlock(row);
-    PackBoolArray(packed_buffer_.data(), data, n);
-    Seek(row * Stride() + column_offset + DataLocation(), SEEK_SET);
-    WriteData(packed_buffer_.data(), byte_size);
+    PackBoolArray(CellPointer(row, column_offset), data, n);
     SetNRows(std::max(row + 1, NRows()));
+    block_changed_ = true;
   }
 
   /**
@@ -235,7 +229,6 @@ class VarBufferedColumnarFile : private RowBasedFile {
    */
   void SetStride(uint64_t new_stride) {
     RowBasedFile::SetStride(new_stride);
-    packed_buffer_.resize(new_stride);
     active_block_ = std::numeric_limits<uint64_t>::max();
     rows_per_block_ =
         new_stride == 0 ? 0 : std::max<size_t>(1, BufferSize / new_stride);
@@ -248,7 +241,6 @@ class VarBufferedColumnarFile : private RowBasedFile {
   VarBufferedColumnarFile(const std::string& filename, uint64_t header_size,
                           uint64_t stride)
       : RowBasedFile(filename, header_size, stride),
-        packed_buffer_(stride),
         rows_per_block_(stride == 0 ? 0
                                     : std::max<size_t>(1, BufferSize / stride)),
         block_buffer_(rows_per_block_ * stride) {}
@@ -257,7 +249,6 @@ class VarBufferedColumnarFile : private RowBasedFile {
   VarBufferedColumnarFile(const std::string& filename, size_t header_size)
       : RowBasedFile(filename, header_size) {
     if (Stride() != 0) {
-      packed_buffer_.resize(Stride());
       rows_per_block_ = std::max<size_t>(1, BufferSize / Stride());
       block_buffer_.resize(rows_per_block_ * Stride());
     }
@@ -286,6 +277,15 @@ class VarBufferedColumnarFile : private RowBasedFile {
     }
   }
 
+  /**
+   * Pointer to the data of a column in the given row. The row should be
+   * in the active block.
+   */
+  unsigned char* CellPointer(uint64_t row, uint64_t column_offset) {
+    const uint64_t block_row = active_block_ * rows_per_block_;
+    return block_buffer_.data() + (row - block_row) * Stride() + column_offset;
+  }
+
   template <typename ValueType>
   void ReadImplementation(uint64_t row, uint64_t column_offset, ValueType* data,
                           uint64_t n) {
@@ -294,10 +294,7 @@ class VarBufferedColumnarFile : private RowBasedFile {
       std::fill_n(data, n, ValueType());
     } else {
       ActivateBlock(row);
-      const uint64_t block_row = active_block_ * rows_per_block_;
-      const unsigned char* position =
-          block_buffer_.data() + (row - block_row) * Stride() + column_offset;
-      std::copy_n(position, n * sizeof(ValueType),
+      std::copy_n(CellPointer(row, column_offset), n * sizeof(ValueType),
                   reinterpret_cast<unsigned char*>(data));
     }
   }
@@ -307,11 +304,8 @@ class VarBufferedColumnarFile : private RowBasedFile {
                            const ValueType* data, uint64_t n) {
     assert(column_offset + n * sizeof(ValueType) <= Stride());
     ActivateBlock(row);
-    const uint64_t block_row = active_block_ * rows_per_block_;
-    unsigned char* position =
-        block_buffer_.data() + (row - block_row) * Stride() + column_offset;
     std::copy_n(reinterpret_cast<const unsigned char*>(data),
-                n * sizeof(ValueType), position);
+                n * sizeof(ValueType), CellPointer(row, column_offset));
     SetNRows(std::max(row + 1, NRows()));
     block_changed_ = true;
   }
@@ -325,12 +319,6 @@ class VarBufferedColumnarFile : private RowBasedFile {
     block_changed_ = false;
   }
 
-  /**
-   * This buffer is used temporarily for (un)packing booleans. Storing it as a
-   * member avoids memory allocations.
-   */
-  std::vector<unsigned char> packed_buffer_;
-
   bool block_changed_ = false;
   uint64_t active_block_ = 0;
   uint64_t rows_per_block_ = 0;
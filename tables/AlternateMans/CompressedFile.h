@@ -0,0 +1,403 @@
+#ifndef CASACORE_COMPRESSED_FILE_H_
+#define CASACORE_COMPRESSED_FILE_H_
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace casacore {
+
+/**
+ * Location of an encoded tile in a @ref CompressedFile.
+ */
+struct CompressedFileSlot {
+  // Start of the slot in the file. Zero means the tile was never written.
+  uint64_t offset = 0;
+  // Number of bytes used by the encoded tile.
+  uint64_t size = 0;
+  // Number of bytes available in the slot.
+  uint64_t capacity = 0;
+};
+
+/**
+ * File that stores variable-sized blobs, such as compressed tiles, together
+ * with an index describing them. The file does not interpret the blobs nor
+ * the index: this is left to the user of the class (see @ref CompressedStMan).
+ *
+ * The file consists of a fixed header, followed by the blobs and the index.
+ * A blob that is rewritten is stored in its old slot when it fits. Otherwise
+ * the old slot is released and the blob is stored in the first free extent
+ * that is large enough, or appended to the end of the file. Free extents are
+ * kept in memory only; after opening a file they are recovered from the slots
+ * in use with @ref InitFreeSpace().
+ * The index is written after the last blob by @ref WriteIndex(), which also
+ * updates the header. Like the other files of the alternate storage managers,
+ * access is not transactional: the index has to be written before closing the
+ * file to keep the file consistent.
+ *
+ * The header consists of (in little endian, see @ref RowBasedFile):
+ * - u32: "Cmpf" (magic file tag)
+ * - u32: file version
+ * - u64: number of rows
+ * - u64: offset of the index
+ * - u64: size of the index
+ *
+ * The class uses exceptions to handle any I/O errors.
+ */
+class CompressedFile {
+ public:
+  CompressedFile() noexcept = default;
+
+  CompressedFile(const CompressedFile&) = delete;
+  CompressedFile(CompressedFile&& rhs) noexcept
+      : file_(rhs.file_),
+        writable_(rhs.writable_),
+        n_rows_(rhs.n_rows_),
+        end_(rhs.end_),
+        free_(std::move(rhs.free_)),
+        index_(std::move(rhs.index_)),
+        filename_(std::move(rhs.filename_)) {
+    rhs.file_ = -1;
+    rhs.writable_ = false;
+    rhs.n_rows_ = 0;
+    rhs.end_ = kHeaderSize;
+  }
+
+  ~CompressedFile() noexcept {
+    try {
+      Close();
+    } catch (...) {
+    }
+  }
+
+  CompressedFile& operator=(CompressedFile&& rhs) {
+    Close();
+    std::swap(file_, rhs.file_);
+    std::swap(writable_, rhs.writable_);
+    std::swap(n_rows_, rhs.n_rows_);
+    std::swap(end_, rhs.end_);
+    std::swap(free_, rhs.free_);
+    std::swap(index_, rhs.index_);
+    std::swap(filename_, rhs.filename_);
+    return *this;
+  }
+
+  /**
+   * Create a new file on disk. If the file exists, it is overwritten.
+   */
+  static CompressedFile CreateNew(const std::string& filename) {
+    CompressedFile file;
+    file.filename_ = filename;
+    file.file_ = open(filename.c_str(), O_CREAT | O_RDWR | O_TRUNC,
+                      S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (file.file_ < 0)
+      throw std::runtime_error("I/O error: could not create new file '" +
+                               filename + "'");
+    file.writable_ = true;
+    file.WriteHeader();
+    return file;
+  }
+
+  /**
+   * Open an existing file from disk and read its index. If the file does not
+   * exist, an exception is thrown. The file is opened read-only if it cannot
+   * be opened for writing.
+   */
+  static CompressedFile OpenExisting(const std::string& filename) {
+    CompressedFile file;
+    file.filename_ = filename;
+    file.file_ = open(filename.c_str(), O_RDWR);
+    file.writable_ = true;
+    if (file.file_ < 0) {
+      file.file_ = open(filename.c_str(), O_RDONLY);
+      file.writable_ = false;
+      if (file.file_ < 0)
+        throw std::runtime_error("I/O error: could not open file '" +
+                                 filename + "'");
+    }
+    std::array<unsigned char, kHeaderSize> header;
+    file.ReadData(0, header.data(), header.size());
+    uint32_t magic_tag;
+    uint32_t version;
+    uint64_t index_size;
+    std::memcpy(&magic_tag, &header[0], sizeof(uint32_t));
+    std::memcpy(&version, &header[4], sizeof(uint32_t));
+    std::memcpy(&file.n_rows_, &header[8], sizeof(uint64_t));
+    std::memcpy(&file.end_, &header[16], sizeof(uint64_t));
+    std::memcpy(&index_size, &header[24], sizeof(uint64_t));
+    if (magic_tag != kMagicFileTag) {
+      throw std::runtime_error(
+          "Could not read file " + filename +
+          ": file does not obey the Casacore compressed file format: either "
+          "the file is damaged, or this is not a Casacore compressed file");
+    }
+    if ((version & 0xFF00) > (kFileVersion & 0xFF00)) {
+      throw std::runtime_error("The file " + filename +
+                               " requires a newer reader of compressed files");
+    }
+    file.index_.resize(index_size);
+    file.ReadData(file.end_, file.index_.data(), index_size);
+    return file;
+  }
+
+  /**
+   * Close the file. The index has to be written before by
+   * @ref WriteIndex(), otherwise blobs written after the last
+   * call to it cannot be found when the file is reopened.
+   */
+  void Close() {
+    if (IsOpen()) {
+      const int result = close(file_);
+      file_ = -1;
+      writable_ = false;
+      if (result < 0)
+        throw std::runtime_error("Could not close file " + filename_);
+    }
+  }
+
+  bool IsOpen() const { return file_ >= 0; }
+  bool IsWritable() const { return writable_; }
+  const std::string& Filename() const { return filename_; }
+
+  /**
+   * Total number of rows stored in this file. The rows are not used by
+   * the file itself; the number is stored in the header when writing the
+   * index.
+   */
+  uint64_t NRows() const { return n_rows_; }
+  void SetNRows(uint64_t n_rows) { n_rows_ = n_rows; }
+
+  /**
+   * Number of bytes used by the header, blobs and free extents, i.e. the
+   * file size without the index.
+   */
+  uint64_t DataSize() const { return end_; }
+
+  /**
+   * Read the blob in the given slot into @p data, which should have space
+   * for slot.size bytes.
+   */
+  void ReadBlob(const CompressedFileSlot& slot, unsigned char* data) {
+    ReadData(slot.offset, data, slot.size);
+  }
+
+  /**
+   * Write a blob. It is written into the given slot if it fits, otherwise
+   * the slot is released and the blob is written to newly allocated space.
+   * The slot is updated accordingly.
+   */
+  void WriteBlob(const unsigned char* data, uint64_t size,
+                 CompressedFileSlot& slot) {
+    if (slot.offset == 0 || size > slot.capacity) {
+      ReleaseSlot(slot);
+      slot.offset = Allocate(size);
+      slot.capacity = size;
+    }
+    slot.size = size;
+    WriteData(slot.offset, data, size);
+  }
+
+  /**
+   * Release the space of a slot, such that it can be reused by later
+   * blobs. The slot is reset to an unwritten slot.
+   */
+  void ReleaseSlot(CompressedFileSlot& slot) {
+    if (slot.offset != 0 && slot.capacity != 0) {
+      Free(slot.offset, slot.capacity);
+    }
+    slot = CompressedFileSlot();
+  }
+
+  /**
+   * Determine the free extents from the slots that are in use. This should
+   * be called after opening an existing file, with the slots of all blobs
+   * as read from the index.
+   */
+  void InitFreeSpace(std::vector<CompressedFileSlot> used) {
+    free_.clear();
+    std::sort(used.begin(), used.end(),
+              [](const CompressedFileSlot& a, const CompressedFileSlot& b) {
+                return a.offset < b.offset;
+              });
+    uint64_t position = kHeaderSize;
+    for (const CompressedFileSlot& slot : used) {
+      if (slot.offset == 0 || slot.capacity == 0) continue;
+      if (slot.offset > position) {
+        free_.emplace(position, slot.offset - position);
+      }
+      position = std::max(position, slot.offset + slot.capacity);
+    }
+    if (position < end_) {
+      free_.emplace(position, end_ - position);
+    }
+    // Trailing free space can be given back to the end of the file.
+    TrimEnd();
+  }
+
+  /**
+   * Number of bytes between the header and the index that are not used
+   * by any blob.
+   */
+  uint64_t FreeSize() const {
+    uint64_t size = 0;
+    for (const std::pair<const uint64_t, uint64_t>& extent : free_)
+      size += extent.second;
+    return size;
+  }
+
+  /**
+   * The index as read from the file or as last written.
+   */
+  const std::vector<unsigned char>& Index() const { return index_; }
+
+  /**
+   * Write the index after the last blob, update the header and remove
+   * anything after the index from the file.
+   */
+  void WriteIndex(std::vector<unsigned char> index, bool do_fsync) {
+    index_ = std::move(index);
+    WriteData(end_, index_.data(), index_.size());
+    WriteHeader();
+    if (ftruncate(file_, end_ + index_.size()) < 0) {
+      throw std::runtime_error("I/O error: could not truncate file '" +
+                               filename_ + "': " + std::strerror(errno));
+    }
+    if (do_fsync && fsync(file_) < 0) {
+      throw std::runtime_error("I/O error: could not sync file '" +
+                               filename_ + "'");
+    }
+  }
+
+ private:
+  /**
+   * Return the offset of @p size bytes of space, using the first free
+   * extent that is large enough or else the end of the file.
+   */
+  uint64_t Allocate(uint64_t size) {
+    for (std::map<uint64_t, uint64_t>::iterator i = free_.begin();
+         i != free_.end(); ++i) {
+      if (i->second >= size) {
+        const uint64_t offset = i->first;
+        const uint64_t remainder = i->second - size;
+        free_.erase(i);
+        if (remainder != 0) free_.emplace(offset + size, remainder);
+        return offset;
+      }
+    }
+    const uint64_t offset = end_;
+    end_ += size;
+    return offset;
+  }
+
+  /**
+   * Add an extent to the free space, merging it with adjacent free extents.
+   */
+  void Free(uint64_t offset, uint64_t size) {
+    std::map<uint64_t, uint64_t>::iterator next = free_.lower_bound(offset);
+    if (next != free_.end() && offset + size == next->first) {
+      size += next->second;
+      next = free_.erase(next);
+    }
+    if (next != free_.begin()) {
+      std::map<uint64_t, uint64_t>::iterator previous = std::prev(next);
+      if (previous->first + previous->second == offset) {
+        offset = previous->first;
+        size += previous->second;
+        free_.erase(previous);
+      }
+    }
+    free_.emplace(offset, size);
+    TrimEnd();
+  }
+
+  /**
+   * Remove a free extent at the end of the blobs by moving the end back.
+   */
+  void TrimEnd() {
+    if (!free_.empty()) {
+      std::map<uint64_t, uint64_t>::iterator last = std::prev(free_.end());
+      if (last->first + last->second == end_) {
+        end_ = last->first;
+        free_.erase(last);
+      }
+    }
+  }
+
+  void WriteHeader() {
+    std::array<unsigned char, kHeaderSize> header;
+    const uint64_t index_size = index_.size();
+    std::memcpy(&header[0], &kMagicFileTag, sizeof(uint32_t));
+    std::memcpy(&header[4], &kFileVersion, sizeof(uint32_t));
+    std::memcpy(&header[8], &n_rows_, sizeof(uint64_t));
+    std::memcpy(&header[16], &end_, sizeof(uint64_t));
+    std::memcpy(&header[24], &index_size, sizeof(uint64_t));
+    WriteData(0, header.data(), header.size());
+  }
+
+  void ReadData(uint64_t offset, unsigned char* data, uint64_t size) {
+    while (size > 0) {
+      const ssize_t result = pread(file_, data, size, offset);
+      if (result <= 0)
+        throw std::runtime_error("I/O error: could not read from file '" +
+                                 filename_ + "'");
+      data += result;
+      offset += result;
+      size -= result;
+    }
+  }
+
+  void WriteData(uint64_t offset, const unsigned char* data, uint64_t size) {
+    if (!writable_)
+      throw std::runtime_error("I/O error: file '" + filename_ +
+                               "' is not writable");
+    while (size > 0) {
+      const ssize_t result = pwrite(file_, data, size, offset);
+      if (result <= 0)
+        throw std::runtime_error("I/O error: could not write to file '" +
+                                 filename_ + "'");
+      data += result;
+      offset += result;
+      size -= result;
+    }
+  }
+
+  constexpr static size_t kHeaderSize = 2 * sizeof(uint32_t) +
+                                        3 * sizeof(uint64_t);
+
+  /**
+   * First four bytes of a file. This spells out "Cmpf" when stored as a
+   * little endian number, which stands for "Casacore compressed file".
+   */
+  constexpr static uint32_t kMagicFileTag = 0x66706d43;
+
+  /**
+   * Version of this file, in format 0xaabb, where aa is the major version and
+   * bb is the minor version (see @ref RowBasedFile).
+   */
+  constexpr static uint32_t kFileVersion = 0x0100;
+
+  int file_ = -1;
+  bool writable_ = false;
+  uint64_t n_rows_ = 0;
+  // End of the header and blobs, which is where the index starts.
+  uint64_t end_ = kHeaderSize;
+  // Unused extents between the header and end_, as offset -> size.
+  std::map<uint64_t, uint64_t> free_;
+  std::vector<unsigned char> index_;
+  std::string filename_;
+};
+
+}  // namespace casacore
+
+#endif
@@ -0,0 +1,223 @@
+#include "CompressedStMan.h"
+
+#include "CompressedStManColumn.h"
+
+#include <stdexcept>
+
+namespace casacore {
+namespace {
+constexpr uint64_t kDefaultTileSize = 256 * 1024;
+
+/**
+ * Create an object with given name and spec.
+ * This methods gets registered in the DataManager "constructor" map.
+ * The caller has to delete the object.
+ */
+DataManager* Make(const String& name, const Record& spec) {
+  return new CompressedStMan(name, spec);
+}
+}  // namespace
+
+CompressedStMan::CompressedStMan(const String& name, const Record& spec)
+    : DataManager(),
+      name_(name),
+      tile_size_(kDefaultTileSize),
+      shuffle_(true) {
+  if (spec.isDefined("TILESIZE")) {
+    const Int64 tile_size = spec.asInt64("TILESIZE");
+    if (tile_size <= 0) {
+      throw std::runtime_error("CompressedStMan: TILESIZE should be positive");
+    }
+    tile_size_ = tile_size;
+  }
+  if (spec.isDefined("SHUFFLE")) {
+    shuffle_ = spec.asBool("SHUFFLE");
+  }
+}
+
+CompressedStMan::CompressedStMan(const CompressedStMan& source)
+    : DataManager(),
+      name_(source.name_),
+      tile_size_(source.tile_size_),
+      shuffle_(source.shuffle_) {}
+
+CompressedStMan::~CompressedStMan() noexcept = default;
+
+Record CompressedStMan::dataManagerSpec() const {
+  Record spec;
+  spec.define("TILESIZE", Int64(tile_size_));
+  spec.define("SHUFFLE", shuffle_);
+  return spec;
+}
+
+uint64_t CompressedStMan::StoredSize() const {
+  uint64_t size = 0;
+  for (const std::unique_ptr<CompressedStManColumn>& column : columns_) {
+    size += column->StoredSize();
+  }
+  return size;
+}
+
+void CompressedStMan::registerClass() {
+  DataManager::registerCtor("CompressedStMan", Make);
+}
+
+Bool CompressedStMan::flush(AipsIO&, Bool doFsync) {
+  for (std::unique_ptr<CompressedStManColumn>& column : columns_) {
+    if (column->Flush()) index_changed_ = true;
+  }
+  if (index_changed_) {
+    WriteIndex(doFsync);
+  }
+  return false;
+}
+
+void CompressedStMan::WriteIndex(bool doFsync) {
+  std::vector<unsigned char> index;
+  const uint64_t n_columns = columns_.size();
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&n_columns);
+  index.insert(index.end(), bytes, bytes + sizeof(uint64_t));
+  for (const std::unique_ptr<CompressedStManColumn>& column : columns_) {
+    column->WriteIndex(index);
+  }
+  file_.WriteIndex(std::move(index), doFsync);
+  index_changed_ = false;
+}
+
+void CompressedStMan::create64(rownr_t nRow) {
+  file_ = CompressedFile::CreateNew(fileName());
+  file_.SetNRows(nRow);
+  index_changed_ = true;
+}
+
+rownr_t CompressedStMan::open64(rownr_t /*nRow*/, AipsIO&) {
+  file_ = CompressedFile::OpenExisting(fileName());
+  const std::vector<unsigned char>& index = file_.Index();
+  const unsigned char* position = index.data();
+  const unsigned char* end = index.data() + index.size();
+  uint64_t n_columns = 0;
+  if (index.size() >= sizeof(uint64_t)) {
+    std::copy_n(position, sizeof(uint64_t),
+                reinterpret_cast<unsigned char*>(&n_columns));
+    position += sizeof(uint64_t);
+  }
+  if (n_columns != columns_.size()) {
+    throw std::runtime_error(
+        "The CompressedStMan file " + fileName() + " contains " +
+        String::toString(n_columns) + " columns instead of " +
+        String::toString(columns_.size()) + ": the table may be damaged");
+  }
+  for (std::unique_ptr<CompressedStManColumn>& column : columns_) {
+    position = column->ReadIndex(position, end);
+  }
+  InitFreeSpace();
+  return file_.NRows();
+}
+
+void CompressedStMan::InitFreeSpace() {
+  std::vector<CompressedFileSlot> used;
+  for (const std::unique_ptr<CompressedStManColumn>& column : columns_) {
+    const std::vector<CompressedFileSlot>& slots = column->Slots();
+    used.insert(used.end(), slots.begin(), slots.end());
+  }
+  file_.InitFreeSpace(std::move(used));
+}
+
+DataManagerColumn* CompressedStMan::makeScalarColumn(
+    const String& /*name*/, int dataType, const String& /*dataTypeID*/) {
+  return MakeColumn(dataType, false);
+}
+
+DataManagerColumn* CompressedStMan::makeDirArrColumn(
+    const String& /*name*/, int dataType, const String& /*dataTypeID*/) {
+  return MakeColumn(dataType, true);
+}
+
+DataManagerColumn* CompressedStMan::makeIndArrColumn(
+    const String& /*name*/, int /*dataType*/, const String& /*dataTypeID*/) {
+  throw std::runtime_error(
+      "makeIndArrColumn() called on CompressedStMan. CompressedStMan can only "
+      "create scalar and direct array columns!\nUse "
+      "casacore::ColumnDesc::Direct as option in the column desc "
+      "constructor");
+}
+
+DataManagerColumn* CompressedStMan::MakeColumn(int dataType, bool isArray) {
+  switch (dataType) {
+    case TpBool:
+    case TpUChar:
+    case TpShort:
+    case TpUShort:
+    case TpInt:
+    case TpUInt:
+    case TpInt64:
+    case TpFloat:
+    case TpDouble:
+    case TpComplex:
+    case TpDComplex:
+      return columns_
+          .emplace_back(std::make_unique<CompressedStManColumn>(
+              file_, static_cast<DataType>(dataType), isArray, tile_size_,
+              shuffle_))
+          .get();
+    default:
+      throw std::runtime_error(
+          "CompressedStMan can only store columns of numerical types or Bool");
+  }
+}
+
+void CompressedStMan::deleteManager() { unlink(fileName().c_str()); }
+
+void CompressedStMan::prepare() {
+  for (std::unique_ptr<CompressedStManColumn>& column : columns_) {
+    column->CheckCellSize(column->columnName());
+  }
+}
+
+void CompressedStMan::reopenRW() {
+  if (!file_.IsWritable()) {
+    file_ = CompressedFile::OpenExisting(fileName());
+    InitFreeSpace();
+  }
+}
+
+void CompressedStMan::addRow64(rownr_t nrrow) {
+  file_.SetNRows(file_.NRows() + nrrow);
+  index_changed_ = true;
+}
+
+void CompressedStMan::removeRow64(rownr_t rowNr) {
+  if (rowNr != file_.NRows() - 1)
+    throw std::runtime_error(
+        "Trying to remove a row in the middle of the file: "
+        "the CompressedStMan does not support this");
+  for (std::unique_ptr<CompressedStManColumn>& column : columns_) {
+    column->ClearCell(rowNr);
+  }
+  file_.SetNRows(rowNr);
+  index_changed_ = true;
+}
+
+void CompressedStMan::addColumn(DataManagerColumn* /*column*/) {
+  // The column was already added by makeScalarColumn or makeDirArrColumn.
+  index_changed_ = true;
+}
+
+void CompressedStMan::removeColumn(DataManagerColumn* column) {
+  for (std::vector<std::unique_ptr<CompressedStManColumn>>::iterator i =
+           columns_.begin();
+       i != columns_.end(); ++i) {
+    if (i->get() == column) {
+      // Give the space of the column's tiles back to the file.
+      std::vector<CompressedFileSlot> slots = (*i)->Slots();
+      for (CompressedFileSlot& slot : slots) file_.ReleaseSlot(slot);
+      columns_.erase(i);
+      index_changed_ = true;
+      return;
+    }
+  }
+  throw std::runtime_error(
+      "Trying to remove column that was not part of the storage manager");
+}
+
+}  // namespace casacore
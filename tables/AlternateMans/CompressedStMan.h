@@ -0,0 +1,161 @@
+#ifndef CASACORE_COMPRESSED_STORAGE_MANAGER_H_
+#define CASACORE_COMPRESSED_STORAGE_MANAGER_H_
+
+#include <casacore/tables/DataMan/DataManager.h>
+
+#include <casacore/casa/Containers/Record.h>
+
+#include "CompressedFile.h"
+
+#include <memory>
+#include <vector>
+
+namespace casacore {
+
+class CompressedStManColumn;
+
+/**
+ * Storage manager that stores its columns with lossless compression. The
+ * values of each column are stored in tiles of a fixed number of rows, which
+ * are compressed independently with a fast LZ codec (see @ref TileCodec.h).
+ * This keeps random access possible: reading a row only requires the tile
+ * containing it to be decompressed. Before compressing, booleans are packed
+ * into bits and the bytes of numerical values are shuffled, which makes
+ * columns like FLAG, WEIGHT_SPECTRUM and MODEL_DATA compress well.
+ *
+ * It can be used for scalar columns and direct (fixed shape) array columns of
+ * all numerical types and Bool. The specification record can contain the
+ * following fields:
+ * - TILESIZE: the approximate number of bytes in an uncompressed tile
+ *   (default 256 KiB). Larger tiles can compress better, but random access
+ *   needs to decompress more data.
+ * - SHUFFLE: whether the bytes of the values are shuffled before compressing
+ *   (default true).
+ *
+ * A tile that is rewritten and does not fit in its previous space anymore is
+ * written at the end of the file, so data that is rewritten many times can
+ * make the file larger than needed. Rows can only be removed at the end.
+ */
+class CompressedStMan final : public DataManager {
+ public:
+  /**
+   * Create the storage manager with the settings given in @p spec.
+   * For an existing table @p spec is empty and the default settings are used.
+   * They only matter for the compression of new columns.
+   */
+  CompressedStMan(const String& name, const Record& spec);
+
+  /**
+   * Copy constructor that initializes a storage manager with similar specs.
+   * The columns are not copied: the new manager will be empty.
+   */
+  CompressedStMan(const CompressedStMan& source);
+
+  ~CompressedStMan() noexcept;
+
+  CompressedStMan& operator=(const CompressedStMan& source) = delete;
+
+  DataManager* clone() const final { return new CompressedStMan(*this); }
+
+  /**
+   * Create an object with given name and spec.
+   * This methods gets registered in the DataManager "constructor" map.
+   * The caller has to delete the object.
+   */
+  static DataManager* makeObject(const String& name, const Record& spec) {
+    return new CompressedStMan(name, spec);
+  }
+
+  String dataManagerType() const final { return "CompressedStMan"; }
+
+  String dataManagerName() const final { return name_; }
+
+  Record dataManagerSpec() const final;
+
+  Bool canAddRow() const final { return true; }
+
+  Bool canRemoveRow() const final { return true; }
+
+  Bool canAddColumn() const final { return true; }
+
+  Bool canRemoveColumn() const final { return true; }
+
+  /**
+   * Total number of bytes of the compressed tiles of all columns.
+   */
+  uint64_t StoredSize() const;
+
+  /**
+   * This function makes the CompressedStMan known to Casacore.
+   */
+  static void registerClass();
+
+ private:
+  // Write the changed tiles and the index of the columns.
+  Bool flush(AipsIO&, Bool doFsync) final;
+
+  // Let the storage manager create the file for a new table.
+  void create64(rownr_t nRow) final;
+
+  // Open the storage manager file for an existing table.
+  // Return the number of rows in the data file.
+  rownr_t open64(rownr_t nRow, AipsIO&) final;
+
+  // Create a column in the storage manager on behalf of a table column.
+  // The caller will NOT delete the newly created object.
+  // Create a scalar column.
+  DataManagerColumn* makeScalarColumn(const String& name, int dataType,
+                                      const String& dataTypeID) final;
+
+  // Create a direct array column.
+  DataManagerColumn* makeDirArrColumn(const String& name, int dataType,
+                                      const String& dataTypeID) final;
+
+  // Create an indirect array column.
+  DataManagerColumn* makeIndArrColumn(const String& name, int dataType,
+                                      const String& dataTypeID) final;
+
+  rownr_t resync64(rownr_t nRow) final { return nRow; }
+
+  void deleteManager() final;
+
+  // Check if the stored cell sizes match the column shapes.
+  void prepare() final;
+
+  // Reopen the storage manager files for read/write.
+  void reopenRW() final;
+
+  // Add rows to the storage manager.
+  void addRow64(rownr_t nrrow) final;
+
+  // Delete a row from all columns.
+  void removeRow64(rownr_t rowNr) final;
+
+  // Do the final addition of a column.
+  void addColumn(DataManagerColumn*) final;
+
+  // Remove a column from the data file.
+  void removeColumn(DataManagerColumn*) final;
+
+  DataManagerColumn* MakeColumn(int dataType, bool isArray);
+
+  // Write the changed tiles and the index of all columns into the file.
+  void WriteIndex(bool doFsync);
+
+  // Determine the free space in the file from the tiles of all columns.
+  void InitFreeSpace();
+
+  String name_;
+  uint64_t tile_size_;
+  bool shuffle_;
+  // Has the index changed since it was written?
+  bool index_changed_ = false;
+  // The item-type needs to be a pointer, because StManColumnBase
+  // does not have move construct/assignment.
+  std::vector<std::unique_ptr<CompressedStManColumn>> columns_;
+  CompressedFile file_;
+};
+
+}  // namespace casacore
+
+#endif
@@ -0,0 +1,326 @@
+#ifndef CASACORE_COMPRESSED_ST_MAN_COLUMN_H_
+#define CASACORE_COMPRESSED_ST_MAN_COLUMN_H_
+
+#include <casacore/tables/DataMan/StManColumnBase.h>
+
+#include <casacore/casa/Arrays/ArrayBase.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Utilities/ValType.h>
+
+#include "BitPacking.h"
+#include "CompressedFile.h"
+#include "TileCodec.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace casacore {
+
+/**
+ * Column of the @ref CompressedStMan. The values of a column are stored in
+ * tiles of a fixed number of rows, which are compressed independently. The
+ * last accessed tile is kept decompressed in memory, so consecutive access
+ * of rows only decompresses a tile once, while random access only needs to
+ * decompress a single tile.
+ *
+ * Before compressing a tile, booleans are packed into bits and the bytes of
+ * other values are shuffled (see @ref EncodeTile()).
+ */
+class CompressedStManColumn final : public StManColumnBase {
+ public:
+  /**
+   * @param file The file holding the tiles of all columns.
+   * @param dtype The column's type as defined by Casacore.
+   * @param is_array True for a (direct) array column, false for a scalar.
+   * @param tile_size Approximate number of bytes in a tile of a new column.
+   * @param shuffle Shuffle the bytes of the values before compressing.
+   */
+  CompressedStManColumn(CompressedFile& file, DataType dtype, bool is_array,
+                        uint64_t tile_size, bool shuffle)
+      : StManColumnBase(dtype),
+        file_(file),
+        is_array_(is_array),
+        tile_size_(tile_size),
+        shuffle_(shuffle),
+        value_size_(ComponentSize(dtype)) {
+    UpdateCellSize();
+  }
+
+  CompressedStManColumn(const CompressedStManColumn&) = delete;
+  CompressedStManColumn& operator=(const CompressedStManColumn&) = delete;
+
+  Bool isWritable() const final { return true; }
+
+  /** Set the dimensions of the values in an array column. */
+  void setShapeColumn(const IPosition& shape) final {
+    shape_ = shape;
+    UpdateCellSize();
+  }
+
+  Bool isShapeDefined(rownr_t) final { return true; }
+  uInt ndim(rownr_t) final { return shape_.size(); }
+  IPosition shape(rownr_t) final { return shape_; }
+
+  void getBool(rownr_t row, Bool* data) final { GetCell(row, data); }
+  void getuChar(rownr_t row, uChar* data) final { GetCell(row, data); }
+  void getShort(rownr_t row, Short* data) final { GetCell(row, data); }
+  void getuShort(rownr_t row, uShort* data) final { GetCell(row, data); }
+  void getInt(rownr_t row, Int* data) final { GetCell(row, data); }
+  void getuInt(rownr_t row, uInt* data) final { GetCell(row, data); }
+  void getInt64(rownr_t row, Int64* data) final { GetCell(row, data); }
+  void getfloat(rownr_t row, float* data) final { GetCell(row, data); }
+  void getdouble(rownr_t row, double* data) final { GetCell(row, data); }
+  void getComplex(rownr_t row, Complex* data) final { GetCell(row, data); }
+  void getDComplex(rownr_t row, DComplex* data) final { GetCell(row, data); }
+
+  void putBool(rownr_t row, const Bool* data) final { PutCell(row, data); }
+  void putuChar(rownr_t row, const uChar* data) final { PutCell(row, data); }
+  void putShort(rownr_t row, const Short* data) final { PutCell(row, data); }
+  void putuShort(rownr_t row, const uShort* data) final { PutCell(row, data); }
+  void putInt(rownr_t row, const Int* data) final { PutCell(row, data); }
+  void putuInt(rownr_t row, const uInt* data) final { PutCell(row, data); }
+  void putInt64(rownr_t row, const Int64* data) final { PutCell(row, data); }
+  void putfloat(rownr_t row, const float* data) final { PutCell(row, data); }
+  void putdouble(rownr_t row, const double* data) final { PutCell(row, data); }
+  void putComplex(rownr_t row, const Complex* data) final {
+    PutCell(row, data);
+  }
+  void putDComplex(rownr_t row, const DComplex* data) final {
+    PutCell(row, data);
+  }
+
+  /**
+   * Read the array in a particular row.
+   */
+  void getArrayV(rownr_t row, ArrayBase& data) final {
+    bool delete_it;
+    void* storage = data.getVStorage(delete_it);
+    GetCell(row, storage);
+    data.putVStorage(storage, delete_it);
+  }
+
+  /**
+   * Write the array in a particular row.
+   */
+  void putArrayV(rownr_t row, const ArrayBase& data) final {
+    bool delete_it;
+    const void* storage = data.getVStorage(delete_it);
+    PutCell(row, storage);
+    data.freeVStorage(storage, delete_it);
+  }
+
+  /**
+   * Set the values in the given row to zero. It is used when removing
+   * the last row, so the row has no values when it is added again.
+   */
+  void ClearCell(rownr_t row) {
+    ActivateTile(row / rows_per_tile_);
+    std::memset(CellPointer(row), 0, cell_size_);
+    tile_changed_ = true;
+  }
+
+  /**
+   * Write the active tile if it was changed.
+   * @returns Whether the tile was written.
+   */
+  bool Flush() {
+    if (!tile_changed_) return false;
+    WriteActiveTile();
+    return true;
+  }
+
+  /**
+   * Check if the cell size given by the shape matches the cell size of the
+   * stored tiles.
+   */
+  void CheckCellSize(const std::string& name) const {
+    if (stored_cell_size_ != 0 && stored_cell_size_ != cell_size_) {
+      throw std::runtime_error(
+          "The cell size of CompressedStMan column " + name +
+          " does not match the stored data: the table may be damaged");
+    }
+  }
+
+  /**
+   * Total number of bytes of the encoded tiles of this column.
+   */
+  uint64_t StoredSize() const {
+    uint64_t size = 0;
+    for (const CompressedFileSlot& slot : tiles_) size += slot.size;
+    return size;
+  }
+
+  /**
+   * The file slots of the tiles of this column.
+   */
+  const std::vector<CompressedFileSlot>& Slots() const { return tiles_; }
+
+  /**
+   * Append the index of this column to @p index. The index contains the
+   * cell size, the number of rows per tile and the slots of the tiles.
+   */
+  void WriteIndex(std::vector<unsigned char>& index) const {
+    AppendValue(index, uint64_t(cell_size_));
+    AppendValue(index, uint64_t(rows_per_tile_));
+    AppendValue(index, uint64_t(tiles_.size()));
+    for (const CompressedFileSlot& slot : tiles_) {
+      AppendValue(index, slot.offset);
+      AppendValue(index, slot.size);
+      AppendValue(index, slot.capacity);
+    }
+  }
+
+  /**
+   * Read the index of this column written by @ref WriteIndex().
+   * @returns The position after the column's index.
+   */
+  const unsigned char* ReadIndex(const unsigned char* position,
+                                 const unsigned char* end) {
+    stored_cell_size_ = ExtractValue(position, end);
+    rows_per_tile_ = ExtractValue(position, end);
+    tiles_.resize(ExtractValue(position, end));
+    for (CompressedFileSlot& slot : tiles_) {
+      slot.offset = ExtractValue(position, end);
+      slot.size = ExtractValue(position, end);
+      slot.capacity = ExtractValue(position, end);
+    }
+    active_tile_ = kNoTile;
+    tile_changed_ = false;
+    return position;
+  }
+
+ private:
+  static size_t ComponentSize(DataType dtype) {
+    switch (dtype) {
+      case TpComplex:
+        return sizeof(float);
+      case TpDComplex:
+        return sizeof(double);
+      default:
+        return ValType::getTypeSize(dtype);
+    }
+  }
+
+  static void AppendValue(std::vector<unsigned char>& index, uint64_t value) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+    index.insert(index.end(), bytes, bytes + sizeof(uint64_t));
+  }
+
+  static uint64_t ExtractValue(const unsigned char*& position,
+                               const unsigned char* end) {
+    if (end - position < std::ptrdiff_t(sizeof(uint64_t))) {
+      throw std::runtime_error(
+          "The index of a CompressedStMan file is truncated");
+    }
+    uint64_t value;
+    std::memcpy(&value, position, sizeof(uint64_t));
+    position += sizeof(uint64_t);
+    return value;
+  }
+
+  void UpdateCellSize() {
+    const size_t n_values = is_array_ ? shape_.product() : 1;
+    cell_size_ = n_values * ValType::getTypeSize(dtype());
+    if (tiles_.empty() && active_tile_ == kNoTile && cell_size_ != 0) {
+      // The tile shape is fixed once data has been written.
+      rows_per_tile_ = std::max<uint64_t>(1, tile_size_ / cell_size_);
+    }
+    tile_buffer_.clear();
+    active_tile_ = kNoTile;
+  }
+
+  unsigned char* CellPointer(rownr_t row) {
+    return tile_buffer_.data() + (row % rows_per_tile_) * cell_size_;
+  }
+
+  void GetCell(rownr_t row, void* data) {
+    if (row >= file_.NRows()) {
+      std::memset(data, 0, cell_size_);
+    } else {
+      ActivateTile(row / rows_per_tile_);
+      std::memcpy(data, CellPointer(row), cell_size_);
+    }
+  }
+
+  void PutCell(rownr_t row, const void* data) {
+    ActivateTile(row / rows_per_tile_);
+    std::memcpy(CellPointer(row), data, cell_size_);
+    tile_changed_ = true;
+  }
+
+  void ActivateTile(uint64_t tile) {
+    if (active_tile_ != tile) {
+      if (tile_changed_) WriteActiveTile();
+      const size_t n_bytes = rows_per_tile_ * cell_size_;
+      tile_buffer_.resize(n_bytes);
+      if (tile < tiles_.size() && tiles_[tile].size != 0) {
+        const CompressedFileSlot& slot = tiles_[tile];
+        encoded_.resize(slot.size);
+        file_.ReadBlob(slot, encoded_.data());
+        if (dtype() == TpBool) {
+          const size_t n_packed = (n_bytes + 7) / 8;
+          packed_.resize(n_packed);
+          DecodeTile(encoded_.data(), encoded_.size(), packed_.data(), n_packed,
+                     1, scratch_);
+          UnpackBoolArray(reinterpret_cast<bool*>(tile_buffer_.data()),
+                          packed_.data(), n_bytes);
+        } else {
+          DecodeTile(encoded_.data(), encoded_.size(), tile_buffer_.data(),
+                     n_bytes, value_size_, scratch_);
+        }
+      } else {
+        std::fill(tile_buffer_.begin(), tile_buffer_.end(), 0);
+      }
+      active_tile_ = tile;
+    }
+  }
+
+  void WriteActiveTile() {
+    const size_t n_bytes = tile_buffer_.size();
+    if (dtype() == TpBool) {
+      packed_.resize((n_bytes + 7) / 8);
+      PackBoolArray(packed_.data(),
+                    reinterpret_cast<const bool*>(tile_buffer_.data()),
+                    n_bytes);
+      EncodeTile(packed_.data(), packed_.size(), 1, encoded_, scratch_);
+    } else {
+      EncodeTile(tile_buffer_.data(), n_bytes, shuffle_ ? value_size_ : 1,
+                 encoded_, scratch_);
+    }
+    if (active_tile_ >= tiles_.size()) tiles_.resize(active_tile_ + 1);
+    file_.WriteBlob(encoded_.data(), encoded_.size(), tiles_[active_tile_]);
+    stored_cell_size_ = cell_size_;
+    tile_changed_ = false;
+  }
+
+  constexpr static uint64_t kNoTile = std::numeric_limits<uint64_t>::max();
+
+  CompressedFile& file_;
+  bool is_array_;
+  uint64_t tile_size_;
+  bool shuffle_;
+  size_t value_size_;
+  // Shape of the array in a cell; it is empty for a scalar column.
+  IPosition shape_;
+  size_t cell_size_ = 0;
+  // Cell size of the stored tiles (0 if nothing stored yet).
+  uint64_t stored_cell_size_ = 0;
+  uint64_t rows_per_tile_ = 1;
+  std::vector<CompressedFileSlot> tiles_;
+  uint64_t active_tile_ = kNoTile;
+  bool tile_changed_ = false;
+  // The decompressed active tile.
+  std::vector<unsigned char> tile_buffer_;
+  std::vector<unsigned char> encoded_;
+  std::vector<unsigned char> packed_;
+  std::vector<unsigned char> scratch_;
+};
+
+}  // namespace casacore
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef CASACORE_FLAG_CODEC_H_
+#define CASACORE_FLAG_CODEC_H_
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "BitPacking.h"
+
+namespace casacore {
+
+/**
+ * Kind of a run in a run-length encoded flag tile, see @ref EncodeFlags().
+ */
+enum class FlagRunKind : unsigned char {
+  kLiteral = 0,
+  kUnflagged = 1,
+  kFlagged = 2
+};
+
+namespace flag_codec {
+
+/**
+ * Minimum number of equal bytes that is stored as a run. A run header
+ * takes one or two bytes, and splitting a literal adds another header.
+ */
+constexpr size_t kMinRunLength = 4;
+
+inline void AppendHeader(std::vector<unsigned char>& output, FlagRunKind kind,
+                         uint64_t length) {
+  // The header is stored as a variable-length integer of 7 bits per byte,
+  // with the kind in the two lowest bits.
+  uint64_t value = (length << 2) | static_cast<uint64_t>(kind);
+  while (value >= 0x80) {
+    output.push_back(static_cast<unsigned char>(value) | 0x80);
+    value >>= 7;
+  }
+  output.push_back(static_cast<unsigned char>(value));
+}
+
+inline void ExtractHeader(const unsigned char*& input, const unsigned char* end,
+                          FlagRunKind& kind, uint64_t& length) {
+  uint64_t value = 0;
+  unsigned shift = 0;
+  unsigned char byte;
+  do {
+    if (input == end || shift > 63)
+      throw std::runtime_error("Flag data is damaged: truncated run header");
+    byte = *input;
+    ++input;
+    value |= uint64_t(byte & 0x7F) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+  if ((value & 3) > static_cast<uint64_t>(FlagRunKind::kFlagged))
+    throw std::runtime_error("Flag data is damaged: invalid run kind");
+  kind = static_cast<FlagRunKind>(value & 3);
+  length = value >> 2;
+}
+
+inline size_t RunLength(const unsigned char* data, size_t n) {
+  const unsigned char value = *data;
+  size_t length = 1;
+  while (length != n && data[length] == value) ++length;
+  return length;
+}
+
+}  // namespace flag_codec
+
+/**
+ * Run-length encode bit-packed flags (see @ref PackBoolArray()). Flags
+ * typically consist of long stretches that are fully flagged (e.g. a flagged
+ * antenna or time range) or fully unflagged, interrupted by a few flagged
+ * channels. Runs of at least @ref flag_codec::kMinRunLength bytes
+ * that are all zero or all one, i.e. runs of at least 32 equal flags, are
+ * stored as just their length. Other bytes are stored literally.
+ *
+ * The encoded data is a sequence of runs, each starting with a header that
+ * holds the kind of the run (see @ref FlagRunKind) and its length in bytes.
+ * A literal run is followed by its bytes.
+ *
+ * @param output Is cleared and filled with the encoded data.
+ */
+inline void EncodeFlags(const unsigned char* packed, size_t n,
+                        std::vector<unsigned char>& output) {
+  using namespace flag_codec;
+  output.clear();
+  size_t literal_start = 0;
+  size_t position = 0;
+  const auto FlushLiteral = [&]() {
+    if (position != literal_start) {
+      AppendHeader(output, FlagRunKind::kLiteral, position - literal_start);
+      output.insert(output.end(), packed + literal_start, packed + position);
+    }
+  };
+  while (position != n) {
+    const unsigned char value = packed[position];
+    size_t length = 1;
+    if (value == 0x00 || value == 0xFF) {
+      length = RunLength(packed + position, n - position);
+      if (length >= kMinRunLength) {
+        FlushLiteral();
+        AppendHeader(output,
+                     value ? FlagRunKind::kFlagged : FlagRunKind::kUnflagged,
+                     length);
+        position += length;
+        literal_start = position;
+        continue;
+      }
+    }
+    position += length;
+  }
+  FlushLiteral();
+}
+
+/**
+ * Decode flags encoded with @ref EncodeFlags() into packed bits.
+ * @param n The number of packed bytes, which should be equal to the number
+ * of encoded bytes.
+ * @throws std::runtime_error when the encoded data is damaged.
+ */
+inline void DecodeFlags(const unsigned char* encoded, size_t size,
+                        unsigned char* packed, size_t n) {
+  using namespace flag_codec;
+  const unsigned char* end = encoded + size;
+  size_t position = 0;
+  while (encoded != end) {
+    FlagRunKind kind;
+    uint64_t length;
+    ExtractHeader(encoded, end, kind, length);
+    if (length > n - position)
+      throw std::runtime_error("Flag data is damaged: too many flags");
+    switch (kind) {
+      case FlagRunKind::kLiteral:
+        if (length > uint64_t(end - encoded))
+          throw std::runtime_error("Flag data is damaged: truncated literal");
+        std::memcpy(packed + position, encoded, length);
+        encoded += length;
+        break;
+      case FlagRunKind::kUnflagged:
+        std::memset(packed + position, 0x00, length);
+        break;
+      case FlagRunKind::kFlagged:
+        std::memset(packed + position, 0xFF, length);
+        break;
+    }
+    position += length;
+  }
+  if (position != n)
+    throw std::runtime_error("Flag data is damaged: too few flags");
+}
+
+}  // namespace casacore
+
+#endif
@@ -0,0 +1,191 @@
+#include "FlagStMan.h"
+
+#include "FlagStManColumn.h"
+
+#include <stdexcept>
+
+namespace casacore {
+namespace {
+constexpr uint64_t kDefaultTileSize = 128 * 1024;
+
+/**
+ * Create an object with given name and spec.
+ * This methods gets registered in the DataManager "constructor" map.
+ * The caller has to delete the object.
+ */
+DataManager* Make(const String& name, const Record& spec) {
+  return new FlagStMan(name, spec);
+}
+}  // namespace
+
+FlagStMan::FlagStMan(const String& name, const Record& spec)
+    : DataManager(), name_(name), tile_size_(kDefaultTileSize) {
+  if (spec.isDefined("TILESIZE")) {
+    const Int64 tile_size = spec.asInt64("TILESIZE");
+    if (tile_size <= 0) {
+      throw std::runtime_error("FlagStMan: TILESIZE should be positive");
+    }
+    tile_size_ = tile_size;
+  }
+}
+
+FlagStMan::FlagStMan(const FlagStMan& source)
+    : DataManager(), name_(source.name_), tile_size_(source.tile_size_) {}
+
+FlagStMan::~FlagStMan() noexcept = default;
+
+Record FlagStMan::dataManagerSpec() const {
+  Record spec;
+  spec.define("TILESIZE", Int64(tile_size_));
+  return spec;
+}
+
+uint64_t FlagStMan::StoredSize() const {
+  uint64_t size = 0;
+  for (const std::unique_ptr<FlagStManColumn>& column : columns_) {
+    size += column->StoredSize();
+  }
+  return size;
+}
+
+void FlagStMan::registerClass() {
+  DataManager::registerCtor("FlagStMan", Make);
+}
+
+Bool FlagStMan::flush(AipsIO&, Bool doFsync) {
+  for (std::unique_ptr<FlagStManColumn>& column : columns_) {
+    if (column->Flush()) index_changed_ = true;
+  }
+  if (index_changed_) {
+    WriteIndex(doFsync);
+  }
+  return false;
+}
+
+void FlagStMan::WriteIndex(bool doFsync) {
+  std::vector<unsigned char> index;
+  const uint64_t n_columns = columns_.size();
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&n_columns);
+  index.insert(index.end(), bytes, bytes + sizeof(uint64_t));
+  for (const std::unique_ptr<FlagStManColumn>& column : columns_) {
+    column->WriteIndex(index);
+  }
+  file_.WriteIndex(std::move(index), doFsync);
+  index_changed_ = false;
+}
+
+void FlagStMan::create64(rownr_t nRow) {
+  file_ = CompressedFile::CreateNew(fileName());
+  file_.SetNRows(nRow);
+  index_changed_ = true;
+}
+
+rownr_t FlagStMan::open64(rownr_t /*nRow*/, AipsIO&) {
+  file_ = CompressedFile::OpenExisting(fileName());
+  const std::vector<unsigned char>& index = file_.Index();
+  const unsigned char* position = index.data();
+  const unsigned char* end = index.data() + index.size();
+  uint64_t n_columns = 0;
+  if (index.size() >= sizeof(uint64_t)) {
+    std::copy_n(position, sizeof(uint64_t),
+                reinterpret_cast<unsigned char*>(&n_columns));
+    position += sizeof(uint64_t);
+  }
+  if (n_columns != columns_.size()) {
+    throw std::runtime_error(
+        "The FlagStMan file " + fileName() + " contains " +
+        String::toString(n_columns) + " columns instead of " +
+        String::toString(columns_.size()) + ": the table may be damaged");
+  }
+  for (std::unique_ptr<FlagStManColumn>& column : columns_) {
+    position = column->ReadIndex(position, end);
+  }
+  return file_.NRows();
+}
+
+DataManagerColumn* FlagStMan::makeScalarColumn(const String& name,
+                                               int dataType,
+                                               const String& /*dataTypeID*/) {
+  return MakeColumn(name, dataType, false);
+}
+
+DataManagerColumn* FlagStMan::makeDirArrColumn(const String& name,
+                                               int dataType,
+                                               const String& /*dataTypeID*/) {
+  return MakeColumn(name, dataType, true);
+}
+
+DataManagerColumn* FlagStMan::makeIndArrColumn(const String& /*name*/,
+                                               int /*dataType*/,
+                                               const String& /*dataTypeID*/) {
+  throw std::runtime_error(
+      "makeIndArrColumn() called on FlagStMan. FlagStMan can only "
+      "create scalar and direct array columns!\nUse "
+      "casacore::ColumnDesc::Direct as option in the column desc "
+      "constructor");
+}
+
+DataManagerColumn* FlagStMan::MakeColumn(const String& name, int dataType,
+                                         bool isArray) {
+  if (dataType != TpBool) {
+    throw std::runtime_error("FlagStMan can only store Bool columns, column " +
+                             name + " has a different type");
+  }
+  return columns_
+      .emplace_back(std::make_unique<FlagStManColumn>(file_, isArray,
+                                                      tile_size_))
+      .get();
+}
+
+void FlagStMan::deleteManager() { unlink(fileName().c_str()); }
+
+void FlagStMan::prepare() {
+  for (std::unique_ptr<FlagStManColumn>& column : columns_) {
+    column->CheckCellSize(column->columnName());
+  }
+}
+
+void FlagStMan::reopenRW() {
+  if (!file_.IsWritable()) {
+    file_ = CompressedFile::OpenExisting(fileName());
+  }
+}
+
+void FlagStMan::addRow64(rownr_t nrrow) {
+  file_.SetNRows(file_.NRows() + nrrow);
+  index_changed_ = true;
+}
+
+void FlagStMan::removeRow64(rownr_t rowNr) {
+  if (rowNr != file_.NRows() - 1)
+    throw std::runtime_error(
+        "Trying to remove a row in the middle of the file: "
+        "the FlagStMan does not support this");
+  for (std::unique_ptr<FlagStManColumn>& column : columns_) {
+    column->ClearCell(rowNr);
+  }
+  file_.SetNRows(rowNr);
+  index_changed_ = true;
+}
+
+void FlagStMan::addColumn(DataManagerColumn* /*column*/) {
+  // The column was already added by makeScalarColumn or makeDirArrColumn.
+  index_changed_ = true;
+}
+
+void FlagStMan::removeColumn(DataManagerColumn* column) {
+  for (std::vector<std::unique_ptr<FlagStManColumn>>::iterator i =
+           columns_.begin();
+       i != columns_.end(); ++i) {
+    if (i->get() == column) {
+      // The tiles of the column remain in the file as unused space.
+      columns_.erase(i);
+      index_changed_ = true;
+      return;
+    }
+  }
+  throw std::runtime_error(
+      "Trying to remove column that was not part of the storage manager");
+}
+
+}  // namespace casacore
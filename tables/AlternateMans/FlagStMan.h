@@ -0,0 +1,160 @@
+#ifndef CASACORE_FLAG_STORAGE_MANAGER_H_
+#define CASACORE_FLAG_STORAGE_MANAGER_H_
+
+#include <casacore/tables/DataMan/DataManager.h>
+
+#include <casacore/casa/Containers/Record.h>
+
+#include "CompressedFile.h"
+
+#include <memory>
+#include <vector>
+
+namespace casacore {
+
+class FlagStManColumn;
+
+/**
+ * Storage manager for flag columns. Flags are stored as packed bits, i.e.
+ * eight times smaller than a Bool column in a regular storage manager.
+ * Furthermore, flags normally contain long runs of fully flagged or unflagged
+ * channels, rows or baselines. Such runs are stored run-length encoded
+ * (see @ref EncodeFlags()), which makes a FLAG column with few flags or with
+ * flagged blocks take only a fraction of its packed size.
+ *
+ * Compared to storing flags with the BitFlagsEngine, which packs the flags of
+ * one element in an integer per element, this stores all flags of a cell as
+ * bits and needs no separate integer column. The flags are stored in tiles of
+ * a fixed number of rows. Reading flags only unpacks the bits of the requested
+ * cells from the tile in memory, eight flags at a time. Reading the full column
+ * directly unpacks into the result array.
+ *
+ * It can be used for scalar and direct (fixed shape) array columns of type
+ * Bool. The specification record can contain the following field:
+ * - TILESIZE: the approximate number of packed bytes in a tile (default 128
+ *   KiB). Smaller tiles speed up random access, larger tiles give fewer runs.
+ *
+ * A tile that is rewritten and does not fit in its previous space anymore is
+ * written at the end of the file, so flags that are rewritten many times can
+ * make the file larger than needed. Rows can only be removed at the end.
+ */
+class FlagStMan final : public DataManager {
+ public:
+  /**
+   * Create the storage manager with the settings given in @p spec.
+   * For an existing table @p spec is empty and the default settings are used.
+   * They only matter for new columns.
+   */
+  FlagStMan(const String& name, const Record& spec);
+
+  /**
+   * Copy constructor that initializes a storage manager with similar specs.
+   * The columns are not copied: the new manager will be empty.
+   */
+  FlagStMan(const FlagStMan& source);
+
+  ~FlagStMan() noexcept;
+
+  FlagStMan& operator=(const FlagStMan& source) = delete;
+
+  DataManager* clone() const final { return new FlagStMan(*this); }
+
+  /**
+   * Create an object with given name and spec.
+   * This methods gets registered in the DataManager "constructor" map.
+   * The caller has to delete the object.
+   */
+  static DataManager* makeObject(const String& name, const Record& spec) {
+    return new FlagStMan(name, spec);
+  }
+
+  String dataManagerType() const final { return "FlagStMan"; }
+
+  String dataManagerName() const final { return name_; }
+
+  Record dataManagerSpec() const final;
+
+  Bool canAddRow() const final { return true; }
+
+  Bool canRemoveRow() const final { return true; }
+
+  Bool canAddColumn() const final { return true; }
+
+  Bool canRemoveColumn() const final { return true; }
+
+  /**
+   * Total number of bytes of the encoded tiles of all columns.
+   */
+  uint64_t StoredSize() const;
+
+  /**
+   * This function makes the FlagStMan known to Casacore.
+   */
+  static void registerClass();
+
+ private:
+  // Write the changed tiles and the index of the columns.
+  Bool flush(AipsIO&, Bool doFsync) final;
+
+  // Let the storage manager create the file for a new table.
+  void create64(rownr_t nRow) final;
+
+  // Open the storage manager file for an existing table.
+  // Return the number of rows in the data file.
+  rownr_t open64(rownr_t nRow, AipsIO&) final;
+
+  // Create a column in the storage manager on behalf of a table column.
+  // The caller will NOT delete the newly created object.
+  // Create a scalar column.
+  DataManagerColumn* makeScalarColumn(const String& name, int dataType,
+                                      const String& dataTypeID) final;
+
+  // Create a direct array column.
+  DataManagerColumn* makeDirArrColumn(const String& name, int dataType,
+                                      const String& dataTypeID) final;
+
+  // Create an indirect array column.
+  DataManagerColumn* makeIndArrColumn(const String& name, int dataType,
+                                      const String& dataTypeID) final;
+
+  rownr_t resync64(rownr_t nRow) final { return nRow; }
+
+  void deleteManager() final;
+
+  // Check if the stored cell sizes match the column shapes.
+  void prepare() final;
+
+  // Reopen the storage manager files for read/write.
+  void reopenRW() final;
+
+  // Add rows to the storage manager.
+  void addRow64(rownr_t nrrow) final;
+
+  // Delete a row from all columns.
+  void removeRow64(rownr_t rowNr) final;
+
+  // Do the final addition of a column.
+  void addColumn(DataManagerColumn*) final;
+
+  // Remove a column from the data file.
+  void removeColumn(DataManagerColumn*) final;
+
+  DataManagerColumn* MakeColumn(const String& name, int dataType,
+                                bool isArray);
+
+  // Write the changed tiles and the index of all columns into the file.
+  void WriteIndex(bool doFsync);
+
+  String name_;
+  uint64_t tile_size_;
+  // Has the index changed since it was written?
+  bool index_changed_ = false;
+  // The item-type needs to be a pointer, because StManColumnBase
+  // does not have move construct/assignment.
+  std::vector<std::unique_ptr<FlagStManColumn>> columns_;
+  CompressedFile file_;
+};
+
+}  // namespace casacore
+
+#endif
@@ -0,0 +1,334 @@
+#ifndef CASACORE_FLAG_ST_MAN_COLUMN_H_
+#define CASACORE_FLAG_ST_MAN_COLUMN_H_
+
+#include <casacore/tables/DataMan/StManColumnBase.h>
+
+#include <casacore/casa/Arrays/ArrayBase.h>
+#include <casacore/casa/Arrays/IPosition.h>
+
+#include "BitPacking.h"
+#include "CompressedFile.h"
+#include "FlagCodec.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace casacore {
+
+/**
+ * Column of the @ref FlagStMan. The flags of a column are stored in tiles of
+ * a fixed number of rows. The active tile is kept in memory as packed bits,
+ * with each cell starting at a byte boundary, and is run-length encoded when
+ * it is written (see @ref EncodeFlags()).
+ *
+ * Reading a cell therefore only has to unpack its bits, which is done eight
+ * flags at a time. Reading a whole column unpacks the cells of a tile in one
+ * go when the cells fill whole bytes.
+ */
+class FlagStManColumn final : public StManColumnBase {
+ public:
+  /**
+   * @param file The file holding the tiles of all columns.
+   * @param is_array True for a (direct) array column, false for a scalar.
+   * @param tile_size Approximate number of packed bytes in a tile of a new
+   * column.
+   */
+  FlagStManColumn(CompressedFile& file, bool is_array, uint64_t tile_size)
+      : StManColumnBase(TpBool),
+        file_(file),
+        is_array_(is_array),
+        tile_size_(tile_size) {
+    UpdateCellSize();
+  }
+
+  FlagStManColumn(const FlagStManColumn&) = delete;
+  FlagStManColumn& operator=(const FlagStManColumn&) = delete;
+
+  Bool isWritable() const final { return true; }
+
+  /** Set the dimensions of the flags in an array column. */
+  void setShapeColumn(const IPosition& shape) final {
+    shape_ = shape;
+    UpdateCellSize();
+  }
+
+  Bool isShapeDefined(rownr_t) final { return true; }
+  uInt ndim(rownr_t) final { return shape_.size(); }
+  IPosition shape(rownr_t) final { return shape_; }
+
+  void getBool(rownr_t row, Bool* data) final { ReadRows(row, 1, data); }
+
+  void putBool(rownr_t row, const Bool* data) final {
+    WriteRows(row, 1, data);
+  }
+
+  /**
+   * Read the flags in a particular row.
+   */
+  void getArrayV(rownr_t row, ArrayBase& data) final {
+    bool delete_it;
+    void* storage = data.getVStorage(delete_it);
+    ReadRows(row, 1, static_cast<Bool*>(storage));
+    data.putVStorage(storage, delete_it);
+  }
+
+  /**
+   * Write the flags in a particular row.
+   */
+  void putArrayV(rownr_t row, const ArrayBase& data) final {
+    bool delete_it;
+    const void* storage = data.getVStorage(delete_it);
+    WriteRows(row, 1, static_cast<const Bool*>(storage));
+    data.freeVStorage(storage, delete_it);
+  }
+
+  /**
+   * Read the flags of all rows of a scalar column.
+   */
+  void getScalarColumnV(ArrayBase& data) final {
+    bool delete_it;
+    void* storage = data.getVStorage(delete_it);
+    ReadRows(0, data.nelements(), static_cast<Bool*>(storage));
+    data.putVStorage(storage, delete_it);
+  }
+
+  /**
+   * Write the flags of all rows of a scalar column.
+   */
+  void putScalarColumnV(const ArrayBase& data) final {
+    bool delete_it;
+    const void* storage = data.getVStorage(delete_it);
+    WriteRows(0, data.nelements(), static_cast<const Bool*>(storage));
+    data.freeVStorage(storage, delete_it);
+  }
+
+  /**
+   * Read the flags of all rows of an array column.
+   */
+  void getArrayColumnV(ArrayBase& data) final {
+    bool delete_it;
+    void* storage = data.getVStorage(delete_it);
+    ReadRows(0, data.shape().last(), static_cast<Bool*>(storage));
+    data.putVStorage(storage, delete_it);
+  }
+
+  /**
+   * Write the flags of all rows of an array column.
+   */
+  void putArrayColumnV(const ArrayBase& data) final {
+    bool delete_it;
+    const void* storage = data.getVStorage(delete_it);
+    WriteRows(0, data.shape().last(), static_cast<const Bool*>(storage));
+    data.freeVStorage(storage, delete_it);
+  }
+
+  /**
+   * Unflag the given row. It is used when removing the last row, so the row
+   * has no flags when it is added again.
+   */
+  void ClearCell(rownr_t row) {
+    ActivateTile(row / rows_per_tile_);
+    std::memset(CellPointer(row), 0, cell_bytes_);
+    tile_changed_ = true;
+  }
+
+  /**
+   * Write the active tile if it was changed.
+   * @returns Whether the tile was written.
+   */
+  bool Flush() {
+    if (!tile_changed_) return false;
+    WriteActiveTile();
+    return true;
+  }
+
+  /**
+   * Check if the cell size given by the shape matches the cell size of the
+   * stored tiles.
+   */
+  void CheckCellSize(const std::string& name) const {
+    if (stored_cell_bytes_ != 0 && stored_cell_bytes_ != cell_bytes_) {
+      throw std::runtime_error(
+          "The cell size of FlagStMan column " + name +
+          " does not match the stored data: the table may be damaged");
+    }
+  }
+
+  /**
+   * Total number of bytes of the encoded tiles of this column.
+   */
+  uint64_t StoredSize() const {
+    uint64_t size = 0;
+    for (const CompressedFileSlot& slot : tiles_) size += slot.size;
+    return size;
+  }
+
+  /**
+   * Append the index of this column to @p index. The index contains the
+   * number of packed bytes per cell, the number of rows per tile and the
+   * slots of the tiles.
+   */
+  void WriteIndex(std::vector<unsigned char>& index) const {
+    AppendValue(index, uint64_t(cell_bytes_));
+    AppendValue(index, uint64_t(rows_per_tile_));
+    AppendValue(index, uint64_t(tiles_.size()));
+    for (const CompressedFileSlot& slot : tiles_) {
+      AppendValue(index, slot.offset);
+      AppendValue(index, slot.size);
+      AppendValue(index, slot.capacity);
+    }
+  }
+
+  /**
+   * Read the index of this column written by @ref WriteIndex().
+   * @returns The position after the column's index.
+   */
+  const unsigned char* ReadIndex(const unsigned char* position,
+                                 const unsigned char* end) {
+    stored_cell_bytes_ = ExtractValue(position, end);
+    rows_per_tile_ = ExtractValue(position, end);
+    tiles_.resize(ExtractValue(position, end));
+    for (CompressedFileSlot& slot : tiles_) {
+      slot.offset = ExtractValue(position, end);
+      slot.size = ExtractValue(position, end);
+      slot.capacity = ExtractValue(position, end);
+    }
+    active_tile_ = kNoTile;
+    tile_changed_ = false;
+    return position;
+  }
+
+ private:
+  static void AppendValue(std::vector<unsigned char>& index, uint64_t value) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+    index.insert(index.end(), bytes, bytes + sizeof(uint64_t));
+  }
+
+  static uint64_t ExtractValue(const unsigned char*& position,
+                               const unsigned char* end) {
+    if (end - position < std::ptrdiff_t(sizeof(uint64_t))) {
+      throw std::runtime_error("The index of a FlagStMan file is truncated");
+    }
+    uint64_t value;
+    std::memcpy(&value, position, sizeof(uint64_t));
+    position += sizeof(uint64_t);
+    return value;
+  }
+
+  void UpdateCellSize() {
+    n_flags_ = is_array_ ? shape_.product() : 1;
+    cell_bytes_ = (n_flags_ + 7) / 8;
+    if (tiles_.empty() && active_tile_ == kNoTile && cell_bytes_ != 0) {
+      // The tile shape is fixed once data has been written.
+      rows_per_tile_ = std::max<uint64_t>(1, tile_size_ / cell_bytes_);
+    }
+    tile_buffer_.clear();
+    active_tile_ = kNoTile;
+  }
+
+  unsigned char* CellPointer(rownr_t row) {
+    return tile_buffer_.data() + (row % rows_per_tile_) * cell_bytes_;
+  }
+
+  /**
+   * Read the flags of @p n_rows consecutive rows into @p data. When the
+   * cells fill whole bytes, the packed cells in a tile are contiguous and
+   * are unpacked at once.
+   */
+  void ReadRows(rownr_t row, uint64_t n_rows, Bool* data) {
+    const rownr_t end_row = row + n_rows;
+    const rownr_t stored_end = std::min<rownr_t>(end_row, file_.NRows());
+    while (row < stored_end) {
+      ActivateTile(row / rows_per_tile_);
+      const rownr_t tile_end =
+          std::min<rownr_t>((active_tile_ + 1) * rows_per_tile_, stored_end);
+      if (n_flags_ % 8 == 0) {
+        const uint64_t n = (tile_end - row) * n_flags_;
+        UnpackBoolArray(data, CellPointer(row), n);
+        data += n;
+        row = tile_end;
+      } else {
+        for (; row != tile_end; ++row) {
+          UnpackBoolArray(data, CellPointer(row), n_flags_);
+          data += n_flags_;
+        }
+      }
+    }
+    if (row < end_row) {
+      std::fill_n(data, (end_row - row) * n_flags_, false);
+    }
+  }
+
+  void WriteRows(rownr_t row, uint64_t n_rows, const Bool* data) {
+    const rownr_t end_row = row + n_rows;
+    while (row < end_row) {
+      ActivateTile(row / rows_per_tile_);
+      const rownr_t tile_end =
+          std::min<rownr_t>((active_tile_ + 1) * rows_per_tile_, end_row);
+      if (n_flags_ % 8 == 0) {
+        const uint64_t n = (tile_end - row) * n_flags_;
+        PackBoolArray(CellPointer(row), data, n);
+        data += n;
+        row = tile_end;
+      } else {
+        for (; row != tile_end; ++row) {
+          PackBoolArray(CellPointer(row), data, n_flags_);
+          data += n_flags_;
+        }
+      }
+      tile_changed_ = true;
+    }
+  }
+
+  void ActivateTile(uint64_t tile) {
+    if (active_tile_ != tile) {
+      if (tile_changed_) WriteActiveTile();
+      tile_buffer_.resize(rows_per_tile_ * cell_bytes_);
+      if (tile < tiles_.size() && tiles_[tile].size != 0) {
+        const CompressedFileSlot& slot = tiles_[tile];
+        encoded_.resize(slot.size);
+        file_.ReadBlob(slot, encoded_.data());
+        DecodeFlags(encoded_.data(), encoded_.size(), tile_buffer_.data(),
+                    tile_buffer_.size());
+      } else {
+        std::fill(tile_buffer_.begin(), tile_buffer_.end(), 0);
+      }
+      active_tile_ = tile;
+    }
+  }
+
+  void WriteActiveTile() {
+    EncodeFlags(tile_buffer_.data(), tile_buffer_.size(), encoded_);
+    if (active_tile_ >= tiles_.size()) tiles_.resize(active_tile_ + 1);
+    file_.WriteBlob(encoded_.data(), encoded_.size(), tiles_[active_tile_]);
+    stored_cell_bytes_ = cell_bytes_;
+    tile_changed_ = false;
+  }
+
+  constexpr static uint64_t kNoTile = std::numeric_limits<uint64_t>::max();
+
+  CompressedFile& file_;
+  bool is_array_;
+  uint64_t tile_size_;
+  // Shape of the array in a cell; it is empty for a scalar column.
+  IPosition shape_;
+  size_t n_flags_ = 0;
+  size_t cell_bytes_ = 0;
+  // Cell size of the stored tiles (0 if nothing stored yet).
+  uint64_t stored_cell_bytes_ = 0;
+  uint64_t rows_per_tile_ = 1;
+  std::vector<CompressedFileSlot> tiles_;
+  uint64_t active_tile_ = kNoTile;
+  bool tile_changed_ = false;
+  // The active tile as packed bits.
+  std::vector<unsigned char> tile_buffer_;
+  std::vector<unsigned char> encoded_;
+};
+
+}  // namespace casacore
+
+#endif
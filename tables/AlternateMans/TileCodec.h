@@ -0,0 +1,277 @@
+#ifndef CASACORE_TILE_CODEC_H_
+#define CASACORE_TILE_CODEC_H_
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace casacore {
+
+/**
+ * Methods that can be used to store an encoded tile. The method is stored as
+ * the first byte of an encoded tile, so that a tile can be decoded without
+ * knowing how the storage manager was configured when it was written.
+ */
+enum class TileCodecMethod : unsigned char {
+  // The data is stored as is, because it could not be compressed.
+  kRaw = 0,
+  // The data is compressed with the LZ codec.
+  kLz = 1,
+  // The bytes of the values are shuffled, then compressed with the LZ codec.
+  kShuffleLz = 2
+};
+
+/**
+ * Shuffles the bytes of @p n_values values of @p value_size bytes each, such
+ * that first the first byte of all values is stored, then the second byte of
+ * all values, etc. For numerical data, in particular floating point values,
+ * the high-order bytes of consecutive values tend to be equal, which makes the
+ * shuffled data much better compressible than the unshuffled data.
+ * @param output Buffer of at least @p n_values * @p value_size bytes.
+ */
+inline void ShuffleBytes(unsigned char* output, const unsigned char* input,
+                         size_t n_values, size_t value_size) {
+  for (size_t b = 0; b != value_size; ++b) {
+    const unsigned char* in = input + b;
+    for (size_t i = 0; i != n_values; ++i) {
+      *output = *in;
+      ++output;
+      in += value_size;
+    }
+  }
+}
+
+/**
+ * Reverses @ref ShuffleBytes().
+ */
+inline void UnshuffleBytes(unsigned char* output, const unsigned char* input,
+                           size_t n_values, size_t value_size) {
+  for (size_t b = 0; b != value_size; ++b) {
+    unsigned char* out = output + b;
+    for (size_t i = 0; i != n_values; ++i) {
+      *out = *input;
+      ++input;
+      out += value_size;
+    }
+  }
+}
+
+namespace tile_codec_internal {
+
+constexpr size_t kMinMatch = 4;
+constexpr size_t kMaxOffset = 65535;
+constexpr unsigned kHashBits = 14;
+
+inline uint32_t Load32(const unsigned char* p) {
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+inline uint32_t Hash(uint32_t sequence) {
+  return (sequence * 2654435761u) >> (32 - kHashBits);
+}
+
+inline void WriteLength(std::vector<unsigned char>& output, size_t length) {
+  while (length >= 255) {
+    output.push_back(255);
+    length -= 255;
+  }
+  output.push_back(static_cast<unsigned char>(length));
+}
+
+inline size_t ReadLength(const unsigned char*& input,
+                         const unsigned char* input_end) {
+  size_t length = 0;
+  unsigned char byte;
+  do {
+    if (input == input_end) {
+      throw std::runtime_error("Compressed tile is truncated");
+    }
+    byte = *input;
+    ++input;
+    length += byte;
+  } while (byte == 255);
+  return length;
+}
+
+// Writes a sequence of literals followed by a match. A match length of zero
+// indicates the last sequence, which has no match.
+inline void WriteSequence(std::vector<unsigned char>& output,
+                          const unsigned char* literals, size_t n_literals,
+                          size_t offset, size_t match_length) {
+  const size_t literal_code = n_literals < 15 ? n_literals : 15;
+  size_t match_code = 0;
+  if (match_length != 0) {
+    match_code = match_length - kMinMatch < 15 ? match_length - kMinMatch : 15;
+  }
+  output.push_back(static_cast<unsigned char>((literal_code << 4) | match_code));
+  if (literal_code == 15) WriteLength(output, n_literals - 15);
+  output.insert(output.end(), literals, literals + n_literals);
+  if (match_length != 0) {
+    output.push_back(static_cast<unsigned char>(offset & 0xFF));
+    output.push_back(static_cast<unsigned char>(offset >> 8));
+    if (match_code == 15) WriteLength(output, match_length - kMinMatch - 15);
+  }
+}
+
+}  // namespace tile_codec_internal
+
+/**
+ * Compresses a buffer with a fast byte-oriented LZ77 codec. The format is
+ * similar to an LZ4 block: a sequence of tokens, each containing a number of
+ * literal bytes followed by a match (offset and length) into the previously
+ * decoded data. Matches are searched using a hash table of 4-byte sequences,
+ * which makes compression fast, while decompression only needs to copy bytes.
+ * The compressed data is appended to @p output.
+ */
+inline void LzCompress(const unsigned char* input, size_t n,
+                       std::vector<unsigned char>& output) {
+  using namespace tile_codec_internal;
+  std::vector<uint32_t> table(size_t(1) << kHashBits, 0);
+  size_t anchor = 0;
+  size_t pos = 0;
+  while (pos + kMinMatch <= n) {
+    const uint32_t sequence = Load32(input + pos);
+    uint32_t& entry = table[Hash(sequence)];
+    const size_t candidate = entry;
+    entry = static_cast<uint32_t>(pos);
+    if (candidate < pos && pos - candidate <= kMaxOffset &&
+        Load32(input + candidate) == sequence) {
+      size_t length = kMinMatch;
+      while (pos + length < n && input[candidate + length] == input[pos + length])
+        ++length;
+      WriteSequence(output, input + anchor, pos - anchor, pos - candidate,
+                    length);
+      pos += length;
+      anchor = pos;
+    } else {
+      // Skip faster through data that does not compress.
+      pos += 1 + ((pos - anchor) >> 6);
+    }
+  }
+  WriteSequence(output, input + anchor, n - anchor, 0, 0);
+}
+
+/**
+ * Decompresses a buffer compressed with @ref LzCompress(). The size of the
+ * decompressed data has to be known. An exception is thrown if the input is
+ * inconsistent with that size or otherwise damaged.
+ */
+inline void LzDecompress(const unsigned char* input, size_t input_size,
+                         unsigned char* output, size_t n) {
+  using namespace tile_codec_internal;
+  const unsigned char* input_end = input + input_size;
+  unsigned char* const output_start = output;
+  unsigned char* const output_end = output + n;
+  while (input != input_end) {
+    const unsigned char token = *input;
+    ++input;
+    size_t n_literals = token >> 4;
+    if (n_literals == 15) n_literals += ReadLength(input, input_end);
+    if (n_literals > size_t(input_end - input) ||
+        n_literals > size_t(output_end - output)) {
+      throw std::runtime_error("Compressed tile is damaged");
+    }
+    std::memcpy(output, input, n_literals);
+    input += n_literals;
+    output += n_literals;
+    if (input == input_end) break;
+    if (input_end - input < 2) {
+      throw std::runtime_error("Compressed tile is truncated");
+    }
+    const size_t offset = size_t(input[0]) | (size_t(input[1]) << 8);
+    input += 2;
+    size_t length = (token & 0x0F) + kMinMatch;
+    if ((token & 0x0F) == 15) length += ReadLength(input, input_end);
+    if (offset == 0 || offset > size_t(output - output_start) ||
+        length > size_t(output_end - output)) {
+      throw std::runtime_error("Compressed tile is damaged");
+    }
+    const unsigned char* match = output - offset;
+    if (offset >= length) {
+      std::memcpy(output, match, length);
+      output += length;
+    } else {
+      // Overlapping match, which repeats the last offset bytes.
+      for (size_t i = 0; i != length; ++i) {
+        *output = *match;
+        ++output;
+        ++match;
+      }
+    }
+  }
+  if (output != output_end) {
+    throw std::runtime_error("Compressed tile has an incorrect size");
+  }
+}
+
+/**
+ * Encodes a tile of @p n bytes into @p encoded. If @p value_size is more than
+ * one, the bytes of the values are shuffled before compressing (see
+ * @ref ShuffleBytes()). If the data does not compress, it is stored raw, so the
+ * encoded tile is at most one byte longer than the tile itself.
+ * @param scratch Buffer used for the shuffled data. Passing it avoids an
+ * allocation for every tile.
+ */
+inline void EncodeTile(const unsigned char* data, size_t n, size_t value_size,
+                       std::vector<unsigned char>& encoded,
+                       std::vector<unsigned char>& scratch) {
+  encoded.clear();
+  const unsigned char* to_compress = data;
+  TileCodecMethod method = TileCodecMethod::kLz;
+  if (value_size > 1 && n % value_size == 0) {
+    scratch.resize(n);
+    ShuffleBytes(scratch.data(), data, n / value_size, value_size);
+    to_compress = scratch.data();
+    method = TileCodecMethod::kShuffleLz;
+  }
+  encoded.push_back(static_cast<unsigned char>(method));
+  LzCompress(to_compress, n, encoded);
+  if (encoded.size() > n) {
+    encoded.resize(1);
+    encoded[0] = static_cast<unsigned char>(TileCodecMethod::kRaw);
+    encoded.insert(encoded.end(), data, data + n);
+  }
+}
+
+/**
+ * Decodes a tile encoded with @ref EncodeTile() into @p data, which should
+ * have space for the @p n bytes of the tile.
+ */
+inline void DecodeTile(const unsigned char* encoded, size_t encoded_size,
+                       unsigned char* data, size_t n, size_t value_size,
+                       std::vector<unsigned char>& scratch) {
+  if (encoded_size == 0) {
+    throw std::runtime_error("Compressed tile is empty");
+  }
+  const TileCodecMethod method = static_cast<TileCodecMethod>(encoded[0]);
+  ++encoded;
+  --encoded_size;
+  switch (method) {
+    case TileCodecMethod::kRaw:
+      if (encoded_size != n) {
+        throw std::runtime_error("Raw tile has an incorrect size");
+      }
+      std::memcpy(data, encoded, n);
+      break;
+    case TileCodecMethod::kLz:
+      LzDecompress(encoded, encoded_size, data, n);
+      break;
+    case TileCodecMethod::kShuffleLz:
+      if (value_size <= 1 || n % value_size != 0) {
+        throw std::runtime_error("Shuffled tile has an incorrect size");
+      }
+      scratch.resize(n);
+      LzDecompress(encoded, encoded_size, scratch.data(), n);
+      UnshuffleBytes(data, scratch.data(), n / value_size, value_size);
+      break;
+    default:
+      throw std::runtime_error("Tile is encoded with an unknown method");
+  }
+}
+
+}  // namespace casacore
+
+#endif
@@ -2,6 +2,9 @@
 
 #include <casacore/tables/AlternateMans/BitPacking.h>
 
+#include <random>
+#include <vector>
+
 BOOST_AUTO_TEST_SUITE(bit_packing)
 
 BOOST_AUTO_TEST_CASE(pack_and_unpack) {
@@ -20,5 +23,25 @@ BOOST_AUTO_TEST_CASE(pack_and_unpack) {
   BOOST_CHECK_EQUAL_COLLECTIONS(unpacked_a.begin(), unpacked_a.end(), input_a.begin(), input_a.end());
 }
 
+BOOST_AUTO_TEST_CASE(long_arrays) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> dist(0, 1);
+  for (size_t n : {0, 1, 7, 8, 9, 63, 64, 65, 1001}) {
+    std::vector<char> input(n);
+    for (char& value : input) value = dist(rng);
+    const bool* bools = reinterpret_cast<const bool*>(input.data());
+    std::vector<unsigned char> packed((n + 7) / 8, 0xFF);
+    PackBoolArray(packed.data(), bools, n);
+    for (size_t i = 0; i != n; ++i) {
+      BOOST_CHECK_EQUAL((packed[i / 8] >> (i % 8)) & 1, input[i]);
+    }
+    if (n % 8 != 0) BOOST_CHECK_EQUAL(packed.back() >> (n % 8), 0);
+    std::vector<char> unpacked(n, 2);
+    UnpackBoolArray(reinterpret_cast<bool*>(unpacked.data()), packed.data(), n);
+    BOOST_CHECK_EQUAL_COLLECTIONS(unpacked.begin(), unpacked.end(),
+                                  input.begin(), input.end());
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -9,6 +9,8 @@
 #include <casacore/tables/AlternateMans/SimpleColumnarFile.h>
 #include <casacore/tables/AlternateMans/BufferedColumnarFile.h>
 
+#include <algorithm>
+
 using casacore::VarBufferedColumnarFile;
 using casacore::SimpleColumnarFile;
 
@@ -260,4 +262,41 @@ BOOST_AUTO_TEST_CASE(buffered_file_edge_case) {
   unlink(filename.c_str());
 }
 
+BOOST_AUTO_TEST_CASE(buffered_bools) {
+  // Booleans and other values in the same block should be consistent with
+  // each other, both when reading and when writing.
+  constexpr size_t kStride = sizeof(float) + 2;
+  const std::string filename = "columnar_file_test.tmp";
+  casacore::VarBufferedColumnarFile file =
+      casacore::VarBufferedColumnarFile<kStride * 4>::CreateNew(filename, 0,
+                                                                kStride);
+  const float value = 3.0f;
+  const bool flags[10] = {true, false, true, true, false,
+                          false, false, true, false, true};
+  file.Write(1, 0, &value, 1);
+  file.Write(1, sizeof(float), flags, 10);
+  file.Write(2, sizeof(float), flags, 10);
+  bool result[10];
+  file.Read(1, sizeof(float), result, 10);
+  BOOST_CHECK_EQUAL_COLLECTIONS(result, result + 10, flags, flags + 10);
+  // Activate another block, which writes the first block.
+  file.Write(6, 0, &value, 1);
+  file.Read(2, sizeof(float), result, 10);
+  BOOST_CHECK_EQUAL_COLLECTIONS(result, result + 10, flags, flags + 10);
+  file.Close();
+
+  file = casacore::VarBufferedColumnarFile<kStride * 4>::OpenExisting(filename,
+                                                                     0);
+  BOOST_CHECK_EQUAL(file.NRows(), 7);
+  float float_result = 0.0f;
+  file.Read(1, 0, &float_result, 1);
+  BOOST_CHECK_EQUAL(float_result, value);
+  file.Read(1, sizeof(float), result, 10);
+  BOOST_CHECK_EQUAL_COLLECTIONS(result, result + 10, flags, flags + 10);
+  file.Read(5, sizeof(float), result, 10);
+  BOOST_CHECK(std::none_of(result, result + 10, [](bool b) { return b; }));
+  file.Close();
+  unlink(filename.c_str());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,253 @@
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <casacore/tables/AlternateMans/CompressedStMan.h>
+
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/TableUtil.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/Slicer.h>
+
+#include <cmath>
+
+using casacore::Array;
+using casacore::ArrayColumn;
+using casacore::ArrayColumnDesc;
+using casacore::Bool;
+using casacore::ColumnDesc;
+using casacore::Complex;
+using casacore::CompressedStMan;
+using casacore::IPosition;
+using casacore::Record;
+using casacore::ScalarColumn;
+using casacore::ScalarColumnDesc;
+using casacore::SetupNewTable;
+using casacore::Slicer;
+using casacore::Table;
+using casacore::TableDesc;
+
+namespace TableUtil = casacore::TableUtil;
+
+namespace {
+const std::string kTableName = "compressed_st_man_test.tmp";
+constexpr size_t kNRows = 500;
+const IPosition kShape(2, 4, 64);
+
+Bool FlagValue(size_t row, size_t index) {
+  // Flag runs of channels, like RFI in a single channel.
+  return (index / 4) % 16 == row % 7 || row % 50 == 0;
+}
+
+float WeightValue(size_t row, size_t index) {
+  return 1.0f + 0.25f * ((row / 10 + index / 4) % 3);
+}
+
+float RewrittenValue(size_t row, size_t index) {
+  return std::sin(row * 0.01f + index);
+}
+
+Complex DataValue(size_t row, size_t index) {
+  return Complex(std::sin(row * 0.01f + index), std::cos(row * 0.02f));
+}
+
+template <typename T, typename Function>
+Array<T> MakeArray(size_t row, Function function) {
+  Array<T> array(kShape);
+  size_t index = 0;
+  for (T& value : array) {
+    value = function(row, index);
+    ++index;
+  }
+  return array;
+}
+
+void MakeTable(const Record& spec) {
+  TableDesc description;
+  description.addColumn(ScalarColumnDesc<double>("TIME"));
+  description.addColumn(ScalarColumnDesc<int>("ANTENNA1"));
+  description.addColumn(
+      ArrayColumnDesc<Bool>("FLAG", kShape, ColumnDesc::Direct));
+  description.addColumn(
+      ArrayColumnDesc<float>("WEIGHT_SPECTRUM", kShape, ColumnDesc::Direct));
+  description.addColumn(
+      ArrayColumnDesc<Complex>("DATA", kShape, ColumnDesc::Direct));
+  SetupNewTable setup(kTableName, description, Table::New);
+  CompressedStMan stman("compressed", spec);
+  setup.bindAll(stman);
+  Table table(setup, kNRows);
+  ScalarColumn<double> time(table, "TIME");
+  ScalarColumn<int> antenna1(table, "ANTENNA1");
+  ArrayColumn<Bool> flag(table, "FLAG");
+  ArrayColumn<float> weight(table, "WEIGHT_SPECTRUM");
+  ArrayColumn<Complex> data(table, "DATA");
+  for (size_t row = 0; row != kNRows; ++row) {
+    time.put(row, 4.0e9 + (row / 10) * 2.0);
+    antenna1.put(row, row % 10);
+    flag.put(row, MakeArray<Bool>(row, FlagValue));
+    weight.put(row, MakeArray<float>(row, WeightValue));
+    data.put(row, MakeArray<Complex>(row, DataValue));
+  }
+}
+
+void CheckTable(const Table& table, size_t n_rows) {
+  BOOST_REQUIRE_EQUAL(table.nrow(), n_rows);
+  ScalarColumn<double> time(table, "TIME");
+  ScalarColumn<int> antenna1(table, "ANTENNA1");
+  ArrayColumn<Bool> flag(table, "FLAG");
+  ArrayColumn<float> weight(table, "WEIGHT_SPECTRUM");
+  ArrayColumn<Complex> data(table, "DATA");
+  // Read in a random order to access the tiles randomly.
+  for (size_t i = 0; i != n_rows; ++i) {
+    const size_t row = (i * 7919) % n_rows;
+    BOOST_CHECK_EQUAL(time(row), 4.0e9 + (row / 10) * 2.0);
+    BOOST_CHECK_EQUAL(antenna1(row), int(row % 10));
+    BOOST_CHECK(allEQ(flag(row), MakeArray<Bool>(row, FlagValue)));
+    BOOST_CHECK(allEQ(weight(row), MakeArray<float>(row, WeightValue)));
+    BOOST_CHECK(allEQ(data(row), MakeArray<Complex>(row, DataValue)));
+  }
+}
+
+uint64_t RawSize() {
+  const uint64_t n_values = kShape.product();
+  return kNRows * (sizeof(double) + sizeof(int) +
+                   n_values * (sizeof(Bool) + sizeof(float) + sizeof(Complex)));
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(compressed_st_man)
+
+BOOST_AUTO_TEST_CASE(write_and_read) {
+  MakeTable(Record());
+  {
+    Table table(kTableName);
+    CheckTable(table, kNRows);
+    const Record spec = table.dataManagerInfo().subRecord(0).subRecord("SPEC");
+    BOOST_CHECK_EQUAL(spec.asInt64("TILESIZE"), 256 * 1024);
+    BOOST_CHECK(spec.asBool("SHUFFLE"));
+  }
+  // The random DATA values hardly compress, but FLAG, WEIGHT_SPECTRUM and
+  // the scalar columns compress very well.
+  const uint64_t file_size =
+      boost::filesystem::file_size(kTableName + "/table.f0");
+  const uint64_t data_size = kNRows * kShape.product() * sizeof(Complex);
+  BOOST_CHECK_LT(file_size, data_size + (RawSize() - data_size) / 10);
+  TableUtil::deleteTable(kTableName);
+}
+
+BOOST_AUTO_TEST_CASE(small_tiles) {
+  Record spec;
+  spec.define("TILESIZE", casacore::Int64(5000));
+  spec.define("SHUFFLE", false);
+  MakeTable(spec);
+  {
+    Table table(kTableName, Table::Update);
+    CheckTable(table, kNRows);
+    // Rewrite values, which changes the size of the encoded tiles.
+    ArrayColumn<float> weight(table, "WEIGHT_SPECTRUM");
+    for (size_t row = 0; row < kNRows; row += 3) {
+      weight.put(row, MakeArray<float>(row, RewrittenValue));
+    }
+  }
+  {
+    Table table(kTableName);
+    ArrayColumn<float> weight(table, "WEIGHT_SPECTRUM");
+    for (size_t row = 0; row != kNRows; ++row) {
+      const Array<float> expected = row % 3 == 0
+                                        ? MakeArray<float>(row, RewrittenValue)
+                                        : MakeArray<float>(row, WeightValue);
+      BOOST_CHECK(allEQ(weight(row), expected));
+    }
+    // Slices are taken from the arrays in the tiles.
+    const Slicer slicer(IPosition(2, 1, 10), IPosition(2, 2, 5));
+    ArrayColumn<Bool> flag(table, "FLAG");
+    BOOST_CHECK(allEQ(flag.getSlice(42, slicer),
+                      MakeArray<Bool>(42, FlagValue)(slicer)));
+  }
+  TableUtil::deleteTable(kTableName);
+}
+
+BOOST_AUTO_TEST_CASE(reuse_space) {
+  Record spec;
+  spec.define("TILESIZE", casacore::Int64(5000));
+  MakeTable(spec);
+  const std::string filename = kTableName + "/table.f0";
+  uint64_t rewritten_size = 0;
+  // Alternately rewrite the values such that the tiles grow and shrink.
+  for (size_t i = 0; i != 6; ++i) {
+    {
+      Table table(kTableName, Table::Update);
+      ArrayColumn<float> weight(table, "WEIGHT_SPECTRUM");
+      for (size_t row = 0; row != kNRows; ++row) {
+        weight.put(row, i % 2 == 0 ? MakeArray<float>(row, RewrittenValue)
+                                   : MakeArray<float>(row, WeightValue));
+      }
+    }
+    const uint64_t file_size = boost::filesystem::file_size(filename);
+    if (i == 0) {
+      rewritten_size = file_size;
+    } else {
+      // The space of the old tiles is reused, so the file does not keep
+      // growing.
+      BOOST_CHECK_LE(file_size, rewritten_size + rewritten_size / 10);
+    }
+  }
+  {
+    Table table(kTableName);
+    CheckTable(table, kNRows);
+  }
+  TableUtil::deleteTable(kTableName);
+}
+
+BOOST_AUTO_TEST_CASE(add_and_remove) {
+  MakeTable(Record());
+  {
+    Table table(kTableName, Table::Update);
+    table.removeRow(kNRows - 1);
+    table.removeRow(kNRows - 2);
+    BOOST_CHECK_THROW(table.removeRow(0), std::runtime_error);
+    table.flush();
+    const uint64_t file_size =
+        boost::filesystem::file_size(kTableName + "/table.f0");
+    table.removeColumn("DATA");
+    table.addColumn(ScalarColumnDesc<float>("EXTRA"), "compressed");
+    ScalarColumn<float> extra(table, "EXTRA");
+    for (size_t row = 0; row != table.nrow(); ++row) extra.put(row, row);
+    table.flush();
+    // The new column is stored in the space of the removed column.
+    BOOST_CHECK_LE(boost::filesystem::file_size(kTableName + "/table.f0"),
+                   file_size);
+  }
+  {
+    Table table(kTableName, Table::Update);
+    BOOST_CHECK_EQUAL(table.nrow(), kNRows - 2);
+    BOOST_CHECK(!table.tableDesc().isColumn("DATA"));
+    ScalarColumn<float> extra(table, "EXTRA");
+    ArrayColumn<Bool> flag(table, "FLAG");
+    for (size_t row = 0; row != table.nrow(); ++row) {
+      BOOST_CHECK_EQUAL(extra(row), float(row));
+      BOOST_CHECK(allEQ(flag(row), MakeArray<Bool>(row, FlagValue)));
+    }
+    // Removed rows are empty when added again.
+    table.addRow(2);
+    BOOST_CHECK(allEQ(flag(kNRows - 1), false));
+    BOOST_CHECK_EQUAL(extra(kNRows - 1), 0.0f);
+  }
+  TableUtil::deleteTable(kTableName);
+}
+
+BOOST_AUTO_TEST_CASE(unsupported_columns) {
+  TableDesc description;
+  description.addColumn(ScalarColumnDesc<casacore::String>("NAME"));
+  SetupNewTable setup(kTableName, description, Table::New);
+  CompressedStMan stman("compressed", Record());
+  setup.bindAll(stman);
+  BOOST_CHECK_THROW(Table(setup, 1), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,97 @@
+#include <boost/test/unit_test.hpp>
+
+#include <casacore/tables/AlternateMans/FlagCodec.h>
+
+#include <random>
+#include <vector>
+
+using casacore::DecodeFlags;
+using casacore::EncodeFlags;
+using casacore::FlagRunKind;
+
+namespace {
+std::vector<unsigned char> RoundTrip(const std::vector<unsigned char>& input) {
+  std::vector<unsigned char> encoded;
+  EncodeFlags(input.data(), input.size(), encoded);
+  std::vector<unsigned char> output(input.size());
+  DecodeFlags(encoded.data(), encoded.size(), output.data(), output.size());
+  return output;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(flag_codec)
+
+BOOST_AUTO_TEST_CASE(runs) {
+  std::vector<unsigned char> encoded;
+  EncodeFlags(nullptr, 0, encoded);
+  BOOST_CHECK(encoded.empty());
+  BOOST_CHECK(RoundTrip({}).empty());
+
+  // A long unflagged run followed by a short flagged run and a literal.
+  std::vector<unsigned char> input(1000, 0x00);
+  input.insert(input.end(), 4, 0xFF);
+  input.push_back(0x12);
+  EncodeFlags(input.data(), input.size(), encoded);
+  const std::vector<unsigned char> reference = {
+      // 1000 << 2 | 1 = 4001 as a variable-length integer
+      0xA1, 0x1F,
+      // 4 << 2 | 2
+      0x12,
+      // 1 << 2 | 0, followed by the literal
+      0x04, 0x12};
+  BOOST_CHECK_EQUAL_COLLECTIONS(encoded.begin(), encoded.end(),
+                                reference.begin(), reference.end());
+  BOOST_CHECK(RoundTrip(input) == input);
+
+  // Short runs are part of literals.
+  const std::vector<unsigned char> short_runs = {0x00, 0x00, 0x00, 0x01,
+                                                 0xFF, 0xFF, 0x02};
+  EncodeFlags(short_runs.data(), short_runs.size(), encoded);
+  BOOST_CHECK_EQUAL(encoded.size(), short_runs.size() + 1);
+  BOOST_CHECK_EQUAL(encoded[0],
+                    short_runs.size() << 2 |
+                        static_cast<unsigned char>(FlagRunKind::kLiteral));
+  BOOST_CHECK(RoundTrip(short_runs) == short_runs);
+}
+
+BOOST_AUTO_TEST_CASE(random_flags) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<unsigned char> input(50000);
+  for (unsigned char& value : input) value = dist(rng);
+  BOOST_CHECK(RoundTrip(input) == input);
+  // Mix in runs of all sizes.
+  size_t position = 0;
+  while (position < input.size()) {
+    const size_t length = std::min<size_t>(dist(rng), input.size() - position);
+    const unsigned char value = (position / 7) % 2 ? 0xFF : 0x00;
+    std::fill_n(input.begin() + position, length, value);
+    position += length + dist(rng) % 10;
+  }
+  BOOST_CHECK(RoundTrip(input) == input);
+}
+
+BOOST_AUTO_TEST_CASE(damaged_input) {
+  std::vector<unsigned char> input(1000, 0xFF);
+  input[500] = 0x10;
+  std::vector<unsigned char> encoded;
+  EncodeFlags(input.data(), input.size(), encoded);
+  std::vector<unsigned char> output(input.size());
+  // Wrong output size.
+  BOOST_CHECK_THROW(DecodeFlags(encoded.data(), encoded.size(), output.data(),
+                                output.size() - 1),
+                    std::runtime_error);
+  BOOST_CHECK_THROW(DecodeFlags(encoded.data(), encoded.size(), output.data(),
+                                output.size() + 1),
+                    std::runtime_error);
+  // Truncated input.
+  BOOST_CHECK_THROW(DecodeFlags(encoded.data(), 1, output.data(),
+                                output.size()),
+                    std::runtime_error);
+  // Invalid run kind.
+  const unsigned char invalid[1] = {0x07};
+  BOOST_CHECK_THROW(DecodeFlags(invalid, 1, output.data(), 1),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
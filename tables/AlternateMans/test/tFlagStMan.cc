@@ -0,0 +1,196 @@
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <casacore/tables/AlternateMans/FlagStMan.h>
+
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/TableUtil.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Slicer.h>
+
+using casacore::Array;
+using casacore::ArrayColumn;
+using casacore::ArrayColumnDesc;
+using casacore::Bool;
+using casacore::ColumnDesc;
+using casacore::FlagStMan;
+using casacore::IPosition;
+using casacore::Record;
+using casacore::ScalarColumn;
+using casacore::ScalarColumnDesc;
+using casacore::SetupNewTable;
+using casacore::Slicer;
+using casacore::Table;
+using casacore::TableDesc;
+
+namespace TableUtil = casacore::TableUtil;
+
+namespace {
+const std::string kTableName = "flag_st_man_test.tmp";
+constexpr size_t kNRows = 600;
+const IPosition kShape(2, 4, 64);
+// A shape whose cells do not fill whole bytes.
+const IPosition kOddShape(2, 3, 5);
+
+Bool FlagValue(size_t row, size_t index) {
+  // A flagged channel that moves per row, and fully flagged rows.
+  return (index / 4) % 16 == row % 7 || (row / 10) % 13 == 3;
+}
+
+Bool OddFlagValue(size_t row, size_t index) { return (row + index) % 3 == 0; }
+
+template <typename Function>
+Array<Bool> MakeFlags(size_t row, const IPosition& shape, Function function) {
+  Array<Bool> array(shape);
+  size_t index = 0;
+  for (Bool& value : array) {
+    value = function(row, index);
+    ++index;
+  }
+  return array;
+}
+
+void MakeTable(const Record& spec) {
+  TableDesc description;
+  description.addColumn(
+      ArrayColumnDesc<Bool>("FLAG", kShape, ColumnDesc::Direct));
+  description.addColumn(
+      ArrayColumnDesc<Bool>("ODD_FLAG", kOddShape, ColumnDesc::Direct));
+  description.addColumn(ScalarColumnDesc<Bool>("FLAG_ROW"));
+  SetupNewTable setup(kTableName, description, Table::New);
+  FlagStMan stman("flags", spec);
+  setup.bindAll(stman);
+  Table table(setup, kNRows);
+  ArrayColumn<Bool> flag(table, "FLAG");
+  ArrayColumn<Bool> odd_flag(table, "ODD_FLAG");
+  ScalarColumn<Bool> flag_row(table, "FLAG_ROW");
+  for (size_t row = 0; row != kNRows; ++row) {
+    flag.put(row, MakeFlags(row, kShape, FlagValue));
+    odd_flag.put(row, MakeFlags(row, kOddShape, OddFlagValue));
+    flag_row.put(row, row % 5 == 0);
+  }
+}
+
+void CheckTable(const Table& table, size_t n_rows) {
+  BOOST_REQUIRE_EQUAL(table.nrow(), n_rows);
+  ArrayColumn<Bool> flag(table, "FLAG");
+  ArrayColumn<Bool> odd_flag(table, "ODD_FLAG");
+  ScalarColumn<Bool> flag_row(table, "FLAG_ROW");
+  // Read in a random order to access the tiles randomly.
+  for (size_t i = 0; i != n_rows; ++i) {
+    const size_t row = (i * 7919) % n_rows;
+    BOOST_CHECK(allEQ(flag(row), MakeFlags(row, kShape, FlagValue)));
+    BOOST_CHECK(
+        allEQ(odd_flag(row), MakeFlags(row, kOddShape, OddFlagValue)));
+    BOOST_CHECK_EQUAL(flag_row(row), row % 5 == 0);
+  }
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(flag_st_man)
+
+BOOST_AUTO_TEST_CASE(write_and_read) {
+  MakeTable(Record());
+  {
+    Table table(kTableName);
+    CheckTable(table, kNRows);
+    const Record spec = table.dataManagerInfo().subRecord(0).subRecord("SPEC");
+    BOOST_CHECK_EQUAL(spec.asInt64("TILESIZE"), 128 * 1024);
+    BOOST_CHECK_EQUAL(table.dataManagerInfo().subRecord(0).asString("TYPE"),
+                      "FlagStMan");
+  }
+  // The packed flags take an eighth of the Bool size, and the fully flagged
+  // rows are run-length encoded.
+  const uint64_t file_size =
+      boost::filesystem::file_size(kTableName + "/table.f0");
+  const uint64_t packed_size = kNRows * kShape.product() / 8;
+  BOOST_CHECK_LT(file_size, packed_size * 95 / 100);
+  TableUtil::deleteTable(kTableName);
+}
+
+BOOST_AUTO_TEST_CASE(column_access) {
+  Record spec;
+  spec.define("TILESIZE", casacore::Int64(1000));
+  MakeTable(spec);
+  {
+    Table table(kTableName, Table::Update);
+    CheckTable(table, kNRows);
+    // Reading a full column unpacks the tiles directly into the result.
+    ArrayColumn<Bool> flag(table, "FLAG");
+    const Array<Bool> all_flags = flag.getColumn();
+    BOOST_REQUIRE_EQUAL(all_flags.shape(), IPosition(3, 4, 64, kNRows));
+    ArrayColumn<Bool> odd_flag(table, "ODD_FLAG");
+    const Array<Bool> all_odd_flags = odd_flag.getColumn();
+    ScalarColumn<Bool> flag_row(table, "FLAG_ROW");
+    const casacore::Vector<Bool> all_flag_rows = flag_row.getColumn();
+    for (size_t row = 0; row != kNRows; ++row) {
+      const Slicer slicer(IPosition(3, 0, 0, row), IPosition(3, 4, 64, 1));
+      BOOST_CHECK(allEQ(all_flags(slicer).reform(kShape),
+                        MakeFlags(row, kShape, FlagValue)));
+      const Slicer odd_slicer(IPosition(3, 0, 0, row), IPosition(3, 3, 5, 1));
+      BOOST_CHECK(allEQ(all_odd_flags(odd_slicer).reform(kOddShape),
+                        MakeFlags(row, kOddShape, OddFlagValue)));
+      BOOST_CHECK_EQUAL(all_flag_rows[row], row % 5 == 0);
+    }
+    // Slices are taken from the unpacked cells.
+    const Slicer slicer(IPosition(2, 1, 10), IPosition(2, 2, 5));
+    BOOST_CHECK(allEQ(flag.getSlice(42, slicer),
+                      MakeFlags(42, kShape, FlagValue)(slicer)));
+    // Rewrite the full column with all flags set.
+    flag.putColumn(Array<Bool>(all_flags.shape(), true));
+    flag_row.putColumn(casacore::Vector<Bool>(kNRows, false));
+  }
+  {
+    Table table(kTableName);
+    ArrayColumn<Bool> flag(table, "FLAG");
+    ScalarColumn<Bool> flag_row(table, "FLAG_ROW");
+    BOOST_CHECK(allEQ(flag.getColumn(), true));
+    BOOST_CHECK(allEQ(flag_row.getColumn(), false));
+  }
+  TableUtil::deleteTable(kTableName);
+}
+
+BOOST_AUTO_TEST_CASE(add_and_remove) {
+  MakeTable(Record());
+  {
+    Table table(kTableName, Table::Update);
+    table.removeRow(kNRows - 1);
+    BOOST_CHECK_THROW(table.removeRow(0), std::runtime_error);
+    table.removeColumn("ODD_FLAG");
+    table.addColumn(ScalarColumnDesc<Bool>("EXTRA"), "flags");
+    ScalarColumn<Bool> extra(table, "EXTRA");
+    for (size_t row = 0; row != table.nrow(); ++row) extra.put(row, row % 2);
+  }
+  {
+    Table table(kTableName, Table::Update);
+    BOOST_CHECK_EQUAL(table.nrow(), kNRows - 1);
+    BOOST_CHECK(!table.tableDesc().isColumn("ODD_FLAG"));
+    ScalarColumn<Bool> extra(table, "EXTRA");
+    ArrayColumn<Bool> flag(table, "FLAG");
+    for (size_t row = 0; row != table.nrow(); ++row) {
+      BOOST_CHECK_EQUAL(extra(row), row % 2 == 1);
+      BOOST_CHECK(allEQ(flag(row), MakeFlags(row, kShape, FlagValue)));
+    }
+    // A removed row is unflagged when added again.
+    table.addRow();
+    BOOST_CHECK(allEQ(flag(kNRows - 1), false));
+  }
+  TableUtil::deleteTable(kTableName);
+}
+
+BOOST_AUTO_TEST_CASE(unsupported_columns) {
+  TableDesc description;
+  description.addColumn(ScalarColumnDesc<float>("WEIGHT"));
+  SetupNewTable setup(kTableName, description, Table::New);
+  FlagStMan stman("flags", Record());
+  setup.bindAll(stman);
+  BOOST_CHECK_THROW(Table(setup, 1), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
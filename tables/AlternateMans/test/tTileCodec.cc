@@ -0,0 +1,129 @@
+#include <boost/test/unit_test.hpp>
+
+#include <casacore/tables/AlternateMans/TileCodec.h>
+
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+
+using casacore::DecodeTile;
+using casacore::EncodeTile;
+using casacore::LzCompress;
+using casacore::LzDecompress;
+using casacore::ShuffleBytes;
+using casacore::TileCodecMethod;
+using casacore::UnshuffleBytes;
+
+namespace {
+std::vector<unsigned char> RoundTrip(const std::vector<unsigned char>& input) {
+  std::vector<unsigned char> compressed;
+  LzCompress(input.data(), input.size(), compressed);
+  std::vector<unsigned char> output(input.size());
+  LzDecompress(compressed.data(), compressed.size(), output.data(),
+               output.size());
+  return output;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(tile_codec)
+
+BOOST_AUTO_TEST_CASE(shuffle) {
+  const unsigned char input[6] = {1, 2, 3, 4, 5, 6};
+  unsigned char shuffled[6];
+  ShuffleBytes(shuffled, input, 3, 2);
+  const unsigned char reference[6] = {1, 3, 5, 2, 4, 6};
+  BOOST_CHECK_EQUAL_COLLECTIONS(shuffled, shuffled + 6, reference,
+                                reference + 6);
+  unsigned char output[6];
+  UnshuffleBytes(output, shuffled, 3, 2);
+  BOOST_CHECK_EQUAL_COLLECTIONS(output, output + 6, input, input + 6);
+}
+
+BOOST_AUTO_TEST_CASE(lz_round_trip) {
+  BOOST_CHECK(RoundTrip({}).empty());
+  const std::vector<unsigned char> short_input = {7, 8, 9};
+  BOOST_CHECK(RoundTrip(short_input) == short_input);
+
+  // Long runs give overlapping matches and extended lengths.
+  std::vector<unsigned char> runs(100000, 0);
+  std::fill(runs.begin() + 5000, runs.begin() + 5300, 1);
+  std::vector<unsigned char> compressed;
+  LzCompress(runs.data(), runs.size(), compressed);
+  BOOST_CHECK_LT(compressed.size(), 1000);
+  BOOST_CHECK(RoundTrip(runs) == runs);
+
+  // Random data does not compress, but has to survive the round trip.
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<unsigned char> random(70000);
+  for (unsigned char& value : random) value = dist(rng);
+  BOOST_CHECK(RoundTrip(random) == random);
+
+  // Repeated patterns beyond the maximum match offset.
+  std::vector<unsigned char> pattern(300000);
+  for (size_t i = 0; i != pattern.size(); ++i)
+    pattern[i] = random[i % random.size()];
+  BOOST_CHECK(RoundTrip(pattern) == pattern);
+}
+
+BOOST_AUTO_TEST_CASE(lz_damaged_input) {
+  std::vector<unsigned char> input(1000);
+  for (size_t i = 0; i != input.size(); ++i) input[i] = i % 7;
+  std::vector<unsigned char> compressed;
+  LzCompress(input.data(), input.size(), compressed);
+  std::vector<unsigned char> output(input.size());
+  // Wrong output size.
+  BOOST_CHECK_THROW(LzDecompress(compressed.data(), compressed.size(),
+                                 output.data(), output.size() - 1),
+                    std::runtime_error);
+  // Truncated input.
+  BOOST_CHECK_THROW(LzDecompress(compressed.data(), compressed.size() / 2,
+                                 output.data(), output.size()),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(encode_tile) {
+  std::vector<unsigned char> encoded;
+  std::vector<unsigned char> scratch;
+
+  // Smoothly varying floats compress better when shuffled.
+  std::vector<float> values(20000);
+  for (size_t i = 0; i != values.size(); ++i)
+    values[i] = 1.0f + 1.0e-3f * std::sin(i * 0.01f);
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(values.data());
+  const size_t n_bytes = values.size() * sizeof(float);
+  EncodeTile(data, n_bytes, 1, encoded, scratch);
+  const size_t unshuffled_size = encoded.size();
+  BOOST_CHECK_EQUAL(encoded[0], static_cast<unsigned char>(TileCodecMethod::kLz));
+  EncodeTile(data, n_bytes, sizeof(float), encoded, scratch);
+  BOOST_CHECK_EQUAL(encoded[0],
+                    static_cast<unsigned char>(TileCodecMethod::kShuffleLz));
+  BOOST_CHECK_LT(encoded.size(), unshuffled_size);
+  BOOST_CHECK_LT(encoded.size(), n_bytes);
+  std::vector<float> decoded(values.size());
+  DecodeTile(encoded.data(), encoded.size(),
+             reinterpret_cast<unsigned char*>(decoded.data()), n_bytes,
+             sizeof(float), scratch);
+  BOOST_CHECK(decoded == values);
+
+  // Random data is stored raw.
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<unsigned char> random(4096);
+  for (unsigned char& value : random) value = dist(rng);
+  EncodeTile(random.data(), random.size(), 4, encoded, scratch);
+  BOOST_CHECK_EQUAL(encoded[0], static_cast<unsigned char>(TileCodecMethod::kRaw));
+  BOOST_CHECK_EQUAL(encoded.size(), random.size() + 1);
+  std::vector<unsigned char> output(random.size());
+  DecodeTile(encoded.data(), encoded.size(), output.data(), output.size(), 4,
+             scratch);
+  BOOST_CHECK(output == random);
+
+  encoded[0] = 99;
+  BOOST_CHECK_THROW(DecodeTile(encoded.data(), encoded.size(), output.data(),
+                               output.size(), 4, scratch),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -26,6 +26,8 @@
 
 //# Includes
 #include <casacore/tables/AlternateMans/AntennaPairStMan.h>
+#include <casacore/tables/AlternateMans/CompressedStMan.h>
+#include <casacore/tables/AlternateMans/FlagStMan.h>
 #include <casacore/tables/AlternateMans/StokesIStMan.h>
 #include <casacore/tables/AlternateMans/UvwStMan.h>
 #include <casacore/tables/DataMan/DataManager.h>
@@ -98,6 +100,9 @@ void DataManager::setProperties (const Record&)
 Bool DataManager::isStorageManager() const
     { return True; }
 
+Bool DataManager::canAccessConcurrently() const
+    { return False; }
+
 
 
 void DataManager::create64 (rownr_t nrrow)
@@ -169,7 +174,9 @@ void DataManager::setMultiFile (const std::shared_ptr<MultiFileBase>& mfile)
   multiFile_p = mfile;
   // Only caching can be used with a MultiFile.
   if (multiFile_p) {
-    tsmOption_p = TSMOption(TSMOption::Cache, 0, tsmOption_p.maxCacheSizeMB());
+    tsmOption_p = TSMOption(TSMOption::Cache, 0, tsmOption_p.maxCacheSizeMB(),
+                            tsmOption_p.prefetchSize(),
+                            tsmOption_p.nrShards());
   }
 }
 
@@ -424,6 +431,8 @@ std::map<String,DataManagerCtor> DataManager::initRegisterMap()
   theirRegisterMap.insert (std::make_pair("TiledShapeStMan",  TiledShapeStMan::makeObject));
   theirRegisterMap.insert (std::make_pair("MemoryStMan",      MemoryStMan::makeObject));
   theirRegisterMap.insert (std::make_pair("AntennaPairStMan", AntennaPairStMan::makeObject));
+  theirRegisterMap.insert (std::make_pair("CompressedStMan",  CompressedStMan::makeObject));
+  theirRegisterMap.insert (std::make_pair("FlagStMan",        FlagStMan::makeObject));
   theirRegisterMap.insert (std::make_pair("StokesIStMan",     StokesIStMan::makeObject));
   theirRegisterMap.insert (std::make_pair("UvwStMan",         UvwStMan::makeObject));
 #ifdef HAVE_ADIOS2
@@ -270,6 +270,12 @@ public:
     // The default is yes.
     virtual Bool isStorageManager() const;
 
+    // Can the columns of this data manager be read by multiple threads
+    // concurrently (i.e., in parallel with the columns of other
+    // data managers)?
+    // The default is no.
+    virtual Bool canAccessConcurrently() const;
+
     // Tell if the data manager wants to reallocate the data manager
     // column objects.
     // This is used by the tiling storage manager.
@@ -28,10 +28,18 @@
 #include <casacore/tables/DataMan/DataManagerColumn.h>
 #include <casacore/tables/Tables/RefRows.h>
 #include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Slice.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/Utilities/DataType.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/OS/OMP.h>
 #include <casacore/tables/DataMan/DataManError.h>
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -88,6 +96,22 @@ Bool DataManagerColumn::canChangeShape() const
     return False;
 }
 
+Bool DataManagerColumn::canAccessConcurrently() const
+{
+    return False;
+}
+
+rownr_t DataManagerColumn::rowChunkSize() const
+{
+    return 1;
+}
+
+Bool DataManagerColumn::getZoneMap (Vector<rownr_t>&, Vector<Double>&,
+                                    Vector<Double>&)
+{
+    return False;
+}
+
 
 String DataManagerColumn::dataTypeId() const
     { return String(); }
@@ -309,6 +333,74 @@ void DataManagerColumn::putArrayColumnCellsV (const RefRows& rows,
 {
   putArrayColumnCellsBase (rows, arr);
 }
+void DataManagerColumn::getArrayColumnCellsParallel (const RefRows& rows,
+                                                     ArrayBase& arr,
+                                                     uInt nthreads)
+{
+  if (nthreads == 0) {
+    nthreads = OMP::maxThreads();
+  }
+  rownr_t nrow = rows.nrows();
+  if (nthreads <= 1  ||  nrow <= 1  ||  !canAccessConcurrently()) {
+    getArrayColumnCellsV (rows, arr);
+    return;
+  }
+  // Split the rows in chunks of about equal size, but only start a new
+  // chunk where a new row chunk (e.g. tile) of the data manager starts.
+  // Use a few chunks per thread to balance the load.
+  RowNumbers rownrs = rows.convert();
+  rownr_t rowsPerChunk = std::max (rownr_t(1), rowChunkSize());
+  rownr_t minSize   = std::max (rownr_t(1), nrow / (4*nthreads));
+  std::vector<rownr_t> bounds(1, 0);
+  for (rownr_t i=1; i<nrow; ++i) {
+    if (i - bounds.back() >= minSize  &&
+        rownrs[i] / rowsPerChunk != rownrs[i-1] / rowsPerChunk) {
+      bounds.push_back (i);
+    }
+  }
+  bounds.push_back (nrow);
+  // Make the row selection and array section (referencing the output
+  // array) for each chunk, so the data are read without extra copies.
+  Int nchunk = bounds.size() - 1;
+  uInt lastAxis = arr.ndim() - 1;
+  IPosition start(arr.ndim(), 0);
+  IPosition length(arr.shape());
+  std::vector<RefRows> chunkRows;
+  std::vector<std::unique_ptr<ArrayBase>> sections;
+  chunkRows.reserve (nchunk);
+  sections.reserve (nchunk);
+  for (Int i=0; i<nchunk; ++i) {
+    start[lastAxis]  = bounds[i];
+    length[lastAxis] = bounds[i+1] - bounds[i];
+    chunkRows.push_back (RefRows(Vector<rownr_t>(rownrs(Slice(bounds[i],
+                                                        length[lastAxis]))),
+                                 False, True));
+    sections.push_back (arr.getSection (Slicer(start, length)));
+  }
+  // Read the chunks in parallel.
+  // An exception cannot leave a parallel loop, so rethrow it thereafter.
+  std::exception_ptr excp;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+#endif
+  for (Int i=0; i<nchunk; ++i) {
+    try {
+      getArrayColumnCellsV (chunkRows[i], *sections[i]);
+    } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical(DataManagerColumn_getArrayColumnCellsParallel)
+#endif
+      {
+        if (!excp) {
+          excp = std::current_exception();
+        }
+      }
+    }
+  }
+  if (excp) {
+    std::rethrow_exception (excp);
+  }
+}
 void DataManagerColumn::getSliceV (rownr_t rownr, const Slicer& slicer, ArrayBase& arr)
 {
   getSliceBase (rownr, slicer, arr);
@@ -318,6 +410,15 @@ void DataManagerColumn::putSliceV (rownr_t rownr, const Slicer& slicer,
 {
   putSliceBase (rownr, slicer, arr);
 }
+Bool DataManagerColumn::getArrayViewV (rownr_t, const Slicer*,
+                                        const void*&, IPosition&, Slicer&)
+{
+  return False;
+}
+Bool DataManagerColumn::getColumnViewV (const void*&, IPosition&)
+{
+  return False;
+}
 void DataManagerColumn::getColumnSliceV (const Slicer& slicer, ArrayBase& arr)
 {
   getColumnSliceBase (slicer, arr);
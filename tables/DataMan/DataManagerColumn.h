@@ -32,6 +32,7 @@
 #include <casacore/tables/Tables/ColumnCache.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Arrays/ArrayFwd.h>
 #include <memory>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -227,6 +228,28 @@ public:
     // Default is no.
     virtual Bool canChangeShape() const;
 
+    // Can the data of the column be read by multiple threads concurrently?
+    // Default is no.
+    virtual Bool canAccessConcurrently() const;
+
+    // Get the number of rows forming a natural unit for reading the column
+    // (e.g., the number of rows in a tile). It is used to align the chunks
+    // read concurrently by getArrayColumnCellsParallel.
+    // Default is 1.
+    virtual rownr_t rowChunkSize() const;
+
+    // Get the zone map of a scalar column, thus the minimum and maximum
+    // value in each zone (range of rows) of the column. A zone starts at
+    // the given row and ends before the start of the next zone.
+    // NaN values are ignored; a zone without values has min > max.
+    // It can be used by a selection to skip zones not containing
+    // the values to select.
+    // It returns False if the data manager does not have a zone map for
+    // the column, which is the default.
+    virtual Bool getZoneMap (Vector<rownr_t>& zoneStarts,
+                             Vector<Double>& minValues,
+                             Vector<Double>& maxValues);
+
     // Get access to the ColumnCache object.
     // <group>
     ColumnCache& columnCache()
@@ -366,6 +389,16 @@ public:
     virtual void getArrayColumnCellsV (const RefRows& rownrs,
 				       ArrayBase& data);
 
+    // Get some array values in the column using multiple threads.
+    // If the column can be accessed concurrently, the rows are split in
+    // chunks aligned with <src>rowChunkSize()</src>, which are read in
+    // parallel directly into the corresponding part of <src>data</src>
+    // using getArrayColumnCellsV. Otherwise getArrayColumnCellsV is called.
+    // The array given in <src>data</src> has to have the correct shape.
+    // A value 0 for <src>nthreads</src> means using OMP::maxThreads().
+    void getArrayColumnCellsParallel (const RefRows& rownrs,
+                                      ArrayBase& data, uInt nthreads);
+
     // Put some array values in the column.
     // The array given in <src>data</src> has to have the correct shape
     // (which is guaranteed by the ArrayColumn getColumn function).
@@ -386,6 +419,31 @@ public:
     virtual void putSliceV (rownr_t rownr, const Slicer& slicer,
 			    const ArrayBase& data);
 
+    // Get a read-only view of the array (or a section of it if a slicer
+    // is given) in the given row without copying the data.
+    // This is only possible if the data manager holds the data in memory
+    // in the local format, for instance in a memory-mapped file.
+    // If possible, True is returned and <src>data</src> is set to the start
+    // of a contiguous block in memory with shape <src>blockShape</src>
+    // of which <src>section</src> is the requested cell (slice).
+    // The block can have more axes than the cell; the section has length 1
+    // in those trailing axes.
+    // <br>The default implementation returns False.
+    virtual Bool getArrayViewV (rownr_t rownr, const Slicer* slicer,
+                                const void*& data, IPosition& blockShape,
+                                Slicer& section);
+
+    // Get a read-only view of the data in the entire column without
+    // copying them. It is only possible if the data manager holds the
+    // values of all rows in a single contiguous block of memory in the
+    // local format, as done by MemoryStMan in arena mode.
+    // If possible, True is returned and <src>data</src> is set to the start
+    // of the block. <src>shape</src> is set to the shape of a cell
+    // with the number of rows as the last axis (thus only the number of rows
+    // for a scalar column).
+    // <br>The default implementation returns False.
+    virtual Bool getColumnViewV (const void*& data, IPosition& shape);
+
     // Get a section of all arrays in the column.
     // The array given in <src>data</src> has to have the correct shape
     // (which is guaranteed by the ArrayColumn getColumn function).
@@ -33,6 +33,7 @@
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Utilities/ValType.h>
+#include <casacore/casa/Utilities/DataType.h>
 #include <casacore/casa/IO/BucketCache.h>
 #include <casacore/casa/IO/BucketFile.h>
 #include <casacore/casa/IO/AipsIO.h>
@@ -63,6 +64,7 @@ ISMBase::ISMBase (uInt bucketSize, Bool checkBucketSize, uInt cacheSize)
   bucketSize_p      (bucketSize),
   checkBucketSize_p (checkBucketSize),
   dataChanged_p     (False),
+  zoneMaps_p        (False),
   tempBuffer_p      (0)
 {}
 
@@ -84,6 +86,7 @@ ISMBase::ISMBase (const String& dataManagerName,
   bucketSize_p      (bucketSize),
   checkBucketSize_p (checkBucketSize),
   dataChanged_p     (False),
+  zoneMaps_p        (False),
   tempBuffer_p      (0)
 {}
 
@@ -104,6 +107,7 @@ ISMBase::ISMBase (const String& dataManagerName, const Record& spec)
   bucketSize_p      (32768),
   checkBucketSize_p (False),
   dataChanged_p     (False),
+  zoneMaps_p        (False),
   tempBuffer_p      (0)
 {
     if (spec.isDefined ("BUCKETSIZE")) {
@@ -115,6 +119,9 @@ ISMBase::ISMBase (const String& dataManagerName, const Record& spec)
     if (spec.isDefined ("PERSCACHESIZE")) {
         persCacheSize_p = spec.asuInt ("PERSCACHESIZE");
     }
+    if (spec.isDefined ("ZoneMaps")) {
+        zoneMaps_p = spec.asBool ("ZoneMaps");
+    }
 }
 
 ISMBase::ISMBase (const ISMBase& that)
@@ -134,6 +141,7 @@ ISMBase::ISMBase (const ISMBase& that)
   bucketSize_p      (that.bucketSize_p),
   checkBucketSize_p (that.checkBucketSize_p),
   dataChanged_p     (False),
+  zoneMaps_p        (that.zoneMaps_p),
   tempBuffer_p      (0)
 {}
 
@@ -168,6 +176,9 @@ Record ISMBase::dataManagerSpec() const
   Record rec = getProperties();
   rec.define ("BUCKETSIZE", Int(bucketSize_p));
   rec.define ("PERSCACHESIZE", persCacheSize_p);
+  if (zoneMaps_p) {
+    rec.define ("ZoneMaps", True);
+  }
   return rec;
 }
 
@@ -231,14 +242,24 @@ DataManagerColumn* ISMBase::makeScalarColumn (const String&,
 	colSet_p.resize (colSet_p.nelements() + 32);
     }
     ISMColumn* colp = new ISMColumn (this, dataType, ncolumn());
+    colp->setIsScalar();
+    if (zoneMaps_p) {
+	colp->makeZoneMap();
+    }
     colSet_p[ncolumn()] = colp;
     return colp;
 }
-DataManagerColumn* ISMBase::makeDirArrColumn (const String& name,
+DataManagerColumn* ISMBase::makeDirArrColumn (const String&,
 					      int dataType,
-					      const String& dataTypeId)
+					      const String&)
 {
-    return makeScalarColumn (name, dataType, dataTypeId);
+    //# Extend colSet_p block if needed.
+    if (ncolumn() >= colSet_p.nelements()) {
+	colSet_p.resize (colSet_p.nelements() + 32);
+    }
+    ISMColumn* colp = new ISMColumn (this, dataType, ncolumn());
+    colSet_p[ncolumn()] = colp;
+    return colp;
 }
 DataManagerColumn* ISMBase::makeIndArrColumn (const String&,
 					      int dataType,
@@ -352,6 +373,29 @@ void ISMBase::readIndex()
     Int64 off = nbucketInit_p;
     os.setpos (512 + off * bucketSize_p);
     index_p->get (os);
+    // The zone maps (if any) follow the index. Their presence tells
+    // that zone maps are used, so make them for the columns.
+    // Use them only if they match the index, because an older version
+    // of Casacore might have written a shorter index (leaving the zone maps
+    // of a previous write behind).
+    uInt nrcol = ncolumn();
+    if (os.getpos() < fio->length()) {
+	zoneMaps_p = True;
+	for (uInt i=0; i<nrcol; i++) {
+	    colSet_p[i]->makeZoneMap();
+	}
+	try {
+	    getZoneMaps (os);
+	} catch (const AipsError&) {
+	    for (uInt i=0; i<nrcol; i++) {
+		colSet_p[i]->clearZoneMap();
+	    }
+	}
+    } else {
+	for (uInt i=0; i<nrcol; i++) {
+	    colSet_p[i]->clearZoneMap();
+	}
+    }
     os.close();
 }
 
@@ -360,6 +404,13 @@ void ISMBase::writeIndex()
     if (index_p == 0) {
 	return;
     }
+    // Bring the zone maps up-to-date before writing them.
+    uInt nrcol = ncolumn();
+    if (zoneMaps_p) {
+	for (uInt i=0; i<nrcol; i++) {
+	    colSet_p[i]->updateZoneMap();
+	}
+    }
     uInt nbuckets = getCache().nBucket();
     // Write a few items at the beginning of the file.
     file_p->seek (0);
@@ -392,8 +443,71 @@ void ISMBase::writeIndex()
     Int64 off = nbuckets;
     os.setpos (512 + off * bucketSize_p);
     index_p->put (os);
+    // Write the zone maps after it; older software does not read them.
+    if (zoneMaps_p) {
+	putZoneMaps (os);
+    }
     os.close();
 }
+
+Vector<rownr_t> ISMBase::getStartRows()
+{
+    return getIndex().getStartRows();
+}
+
+Bool ISMBase::zoneMapsChanged()
+{
+    for (uInt i=0; i<ncolumn(); i++) {
+	ZoneMap* zoneMap = colSet_p[i]->zoneMap();
+	if (zoneMap  &&  zoneMap->isChanged()) {
+	    return True;
+	}
+    }
+    return False;
+}
+
+void ISMBase::putZoneMaps (AipsIO& os)
+{
+    uInt nrmap = 0;
+    for (uInt i=0; i<ncolumn(); i++) {
+	if (colSet_p[i]->zoneMap()) {
+	    nrmap++;
+	}
+    }
+    os.putstart ("ISMZoneMaps", 1);
+    os << nrmap;
+    for (uInt i=0; i<ncolumn(); i++) {
+	ZoneMap* zoneMap = colSet_p[i]->zoneMap();
+	if (zoneMap) {
+	    os << i;
+	    zoneMap->put (os);
+	}
+    }
+    os.putend();
+}
+
+void ISMBase::getZoneMaps (AipsIO& os)
+{
+    os.getstart ("ISMZoneMaps");
+    uInt nrmap;
+    os >> nrmap;
+    for (uInt i=0; i<nrmap; i++) {
+	uInt colnr;
+	os >> colnr;
+	ZoneMap* zoneMap = 0;
+	if (colnr < ncolumn()) {
+	    zoneMap = colSet_p[colnr]->zoneMap();
+	}
+	if (zoneMap) {
+	    zoneMap->get (os);
+	} else {
+	    // Skip a zone map of a column not having one.
+	    ZoneMap dummy(TpOther);
+	    dummy.get (os);
+	}
+    }
+    os.getend();
+}
     
 
 ISMBucket* ISMBase::getBucket (rownr_t rownr, rownr_t& bucketStartRow,
@@ -474,6 +588,7 @@ void ISMBase::removeRow64 (rownr_t rownr)
     uInt nrcol = ncolumn();
     for (i=0; i<nrcol; i++) {
 	colSet_p[i]->remove (bucketRownr, bucket, bucketNrrow, nrrow_p-1);
+	colSet_p[i]->removeZoneRow (rownr);
     }
     // Remove the row from the index.
     Int emptyBucket = getIndex().removeRow (rownr);
@@ -567,7 +682,8 @@ Bool ISMBase::flush (AipsIO& ios, Bool fsync)
     if (cache_p != 0) {
 	cache_p->flush();
     }
-    if (dataChanged_p) {
+    // Write the index if data or the zone maps have changed.
+    if (dataChanged_p  ||  zoneMapsChanged()) {
 	writeIndex();
 	if (fsync) {
 	    file_p->fsync();
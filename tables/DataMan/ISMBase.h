@@ -147,6 +147,17 @@ public:
     // Get the current cache size (in buckets).
     uInt cacheSize() const;
 
+    // Keep a zone map (the minimum and maximum per bucket) for the numeric
+    // scalar columns, which can be used by table selections.
+    // It has to be set before the table is created; it is the same as
+    // giving <src>ZoneMaps=True</src> in the specification record.
+    // The zone maps are stored in the table, so they are kept
+    // when the table is reopened.
+    void setZoneMaps (Bool zoneMaps);
+
+    // Does the storage manager keep zone maps?
+    Bool hasZoneMaps();
+
     // Clear the cache used by this storage manager.
     // It will flush the cache as needed and remove all buckets from it.
     void clearCache();
@@ -196,6 +207,9 @@ public:
     // Get the number of rows in this storage manager.
     rownr_t nrow() const;
 
+    // Get the start row of each bucket.
+    Vector<rownr_t> getStartRows();
+
     // Can the storage manager add rows? (yes)
     virtual Bool canAddRow() const;
 
@@ -337,6 +351,15 @@ private:
     // Write the index (at the end of the file).
     void writeIndex();
 
+    // Has a zone map of one of the columns changed?
+    Bool zoneMapsChanged();
+
+    // Write the zone maps of the columns (after the index).
+    void putZoneMaps (AipsIO& os);
+
+    // Read the zone maps of the columns.
+    void getZoneMaps (AipsIO& os);
+
 
     //# Declare member variables.
     // Name of data manager.
@@ -373,6 +396,8 @@ private:
     Bool checkBucketSize_p;
     // Has the data changed since the last flush?
     Bool dataChanged_p;
+    // Are zone maps kept for the numeric scalar columns?
+    Bool zoneMaps_p;
     // The size of a uInt in external format (local or canonical).
     uInt uIntSize_p;
     // The size of a rownr in external format (local or canonical).
@@ -392,6 +417,18 @@ inline uInt ISMBase::cacheSize() const
     return cacheSize_p;
 }
 
+inline void ISMBase::setZoneMaps (Bool zoneMaps)
+{
+    zoneMaps_p = zoneMaps;
+}
+
+inline Bool ISMBase::hasZoneMaps()
+{
+    // The index has to be read to know if the zone maps exist in the file.
+    getIndex();
+    return zoneMaps_p;
+}
+
 inline uInt ISMBase::uniqueNr()
 {
     return uniqnr_p++;
@@ -35,6 +35,7 @@
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/OS/CanonicalConversion.h>
 #include <casacore/casa/OS/LECanonicalConversion.h>
+#include <limits>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -48,7 +49,8 @@ ISMColumn::ISMColumn (ISMBase* parent, int dataType, uInt colnr)
   startRow_p     (1),
   endRow_p       (0),
   lastValue_p    (0),
-  lastRowPut_p   (0)
+  lastRowPut_p   (0),
+  isScalar_p     (False)
 {
     //# The increment in the column cache is always 0,
     //# because multiple rows refer to the same value.
@@ -121,9 +123,47 @@ IPosition ISMColumn::shape (rownr_t)
 }
 
 
-void ISMColumn::addRow (rownr_t, rownr_t)
+void ISMColumn::makeZoneMap()
 {
-    //# Nothing to do.
+    if (isScalar_p  &&  ZoneMap::isSupported (dataType())) {
+	zoneMap_p.reset (new ZoneMap (dataType()));
+    }
+}
+
+void ISMColumn::clearZoneMap()
+{
+    if (zoneMap_p) {
+	zoneMap_p->invalidate();
+    }
+}
+
+void ISMColumn::updateZoneMap()
+{
+    if (zoneMap_p) {
+	Vector<rownr_t> startRows = stmanPtr_p->getStartRows();
+	zoneMap_p->update (startRows, stmanPtr_p->nrow(), *this);
+    }
+}
+
+Bool ISMColumn::getZoneMap (Vector<rownr_t>& zoneStarts,
+			    Vector<Double>& minValues,
+			    Vector<Double>& maxValues)
+{
+    if (! stmanPtr_p->hasZoneMaps()  ||  ! zoneMap_p) {
+	return False;
+    }
+    updateZoneMap();
+    zoneStarts.reference (zoneMap_p->zoneStarts().copy());
+    minValues.reference (zoneMap_p->minValues().copy());
+    maxValues.reference (zoneMap_p->maxValues().copy());
+    return True;
+}
+
+void ISMColumn::addRow (rownr_t newNrrow, rownr_t)
+{
+    if (zoneMap_p) {
+	zoneMap_p->addRows (newNrrow);
+    }
 }
 
 void ISMColumn::remove (rownr_t bucketRownr, ISMBucket* bucket, rownr_t bucketNrrow,
@@ -667,6 +707,13 @@ void ISMColumn::putValue (rownr_t rownr, const void* value)
 	afterLastRowPut = True;
 	lastRowPut_p    = rownr+1;
     }
+    // After the last row put, the value is used for all further rows.
+    if (zoneMap_p) {
+	zoneMap_p->putValue (rownr, (afterLastRowPut  ?
+                                     std::numeric_limits<rownr_t>::max()
+                                     : rownr),
+			     value);
+    }
     // Invalidate the last value read.
     columnCache().invalidate();
     startRow_p = 1;
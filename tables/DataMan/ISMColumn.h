@@ -31,10 +31,12 @@
 #include <casacore/casa/aips.h>
 #include <casacore/tables/DataMan/StManColumnBase.h>
 #include <casacore/tables/DataMan/ISMBase.h>
+#include <casacore/tables/DataMan/ZoneMap.h>
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Utilities/Compare.h>
 #include <casacore/casa/OS/Conversion.h>
+#include <memory>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -242,6 +244,35 @@ public:
     // Get the nr of elements in this data value.
     uInt nelements() const;
 
+    // Tell that the column is a scalar column.
+    // It is called by ISMBase when the column is made.
+    void setIsScalar()
+      { isScalar_p = True; }
+
+    // Make a zone map for the column if it is a numeric scalar column.
+    // It is called by ISMBase if it keeps zone maps.
+    void makeZoneMap();
+
+    // Get the zone map (a null pointer if the column does not have one).
+    ZoneMap* zoneMap()
+      { return zoneMap_p.get(); }
+
+    // Invalidate the zone map (if any), so it has to be fully recalculated.
+    void clearZoneMap();
+
+    // Update the zone map (if any) to the current contents of the column.
+    void updateZoneMap();
+
+    // Tell the zone map (if any) that a row has been removed.
+    void removeZoneRow (rownr_t rownr)
+      { if (zoneMap_p) zoneMap_p->removeRow (rownr); }
+
+    // Get the zone map. The zones are the buckets of the storage manager.
+    // It returns False if the column does not have a zone map.
+    virtual Bool getZoneMap (Vector<rownr_t>& zoneStarts,
+                             Vector<Double>& minValues,
+                             Vector<Double>& maxValues);
+
 
 protected:
     // Test if the last value is invalid for this row.
@@ -285,6 +316,10 @@ protected:
     Conversion::ValueFunction* readFunc_p;
     // Pointer to a compare function.
     ObjCompareFunc*   compareFunc_p;
+    // Is it a scalar column?
+    Bool              isScalar_p;
+    // The zone map (only for numeric scalar columns).
+    std::unique_ptr<ZoneMap> zoneMap_p;
 
 
 private:
@@ -98,6 +98,13 @@ void ISMIndex::addBucketNr (rownr_t rownr, uInt bucketNr)
     nused_p++;
 }
 
+Vector<rownr_t> ISMIndex::getStartRows() const
+{
+    Vector<rownr_t> rows(nused_p);
+    std::copy (rows_p.begin(), rows_p.begin() + nused_p, rows.begin());
+    return rows;
+}
+
 void ISMIndex::addRow (rownr_t nrrow)
 {
     rows_p[nused_p] += nrrow;
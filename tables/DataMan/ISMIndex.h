@@ -29,6 +29,7 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/Arrays/Vector.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -126,6 +127,9 @@ public:
     Bool nextBucketNr (uInt& cursor, rownr_t& bucketStartRow,
                        rownr_t& bucketNrrow, uInt& bucketNr) const;
 
+    // Get the start row of all buckets.
+    Vector<rownr_t> getStartRows() const;
+
     // Show the index.
     void show (std::ostream&) const;
 
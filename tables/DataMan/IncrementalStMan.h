@@ -147,6 +147,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //          <linkto class=ROIncrementalStManAccessor>
 //          ROIncrementalStManAccessor</linkto>.
 // </ul>
+// <p>
+// Optionally the minimum and maximum value per bucket (a zone map) is kept
+// for the numeric scalar columns (see <linkto class=ZoneMap>ZoneMap</linkto>).
+// A table selection uses it to skip buckets not containing the values
+// to select. It is enabled by <src>setZoneMaps(True)</src> or by
+// <src>ZoneMaps=True</src> in the specification record when creating
+// the table.
 //
 // <note>This class contains many public functions which are only used
 // by other ISM classes. The only useful function for the user is the
@@ -28,6 +28,7 @@
 #include <casacore/tables/DataMan/MSMDirColumn.h>
 #include <casacore/tables/DataMan/MSMIndColumn.h>
 #include <casacore/tables/DataMan/DataManError.h>
+#include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Utilities/Assert.h>
 
 
@@ -38,7 +39,9 @@ MSMBase::MSMBase()
   nrrow_p       (0),
   nrrowCreate_p (0),
   colSet_p      (0),
-  hasPut_p      (False)
+  hasPut_p      (False),
+  arena_p       (False),
+  arenaRows_p   (0)
 {}
 
 MSMBase::MSMBase (const String& storageManagerName)
@@ -47,18 +50,41 @@ MSMBase::MSMBase (const String& storageManagerName)
   nrrow_p       (0),
   nrrowCreate_p (0),
   colSet_p      (0),
-  hasPut_p      (False)
+  hasPut_p      (False),
+  arena_p       (False),
+  arenaRows_p   (0)
 {}
 
-MSMBase::MSMBase (const String& storageManagerName, const Record&)
+MSMBase::MSMBase (const String& storageManagerName, Bool arena,
+                  rownr_t arenaRows)
 : DataManager   (),
   stmanName_p   (storageManagerName),
   nrrow_p       (0),
   nrrowCreate_p (0),
   colSet_p      (0),
-  hasPut_p      (False)
+  hasPut_p      (False),
+  arena_p       (arena),
+  arenaRows_p   (arenaRows)
 {}
 
+MSMBase::MSMBase (const String& storageManagerName, const Record& spec)
+: DataManager   (),
+  stmanName_p   (storageManagerName),
+  nrrow_p       (0),
+  nrrowCreate_p (0),
+  colSet_p      (0),
+  hasPut_p      (False),
+  arena_p       (False),
+  arenaRows_p   (0)
+{
+  if (spec.isDefined ("ARENA")) {
+    arena_p = spec.asBool ("ARENA");
+  }
+  if (spec.isDefined ("ARENAROWS")  &&  spec.asInt64 ("ARENAROWS") > 0) {
+    arenaRows_p = spec.asInt64 ("ARENAROWS");
+  }
+}
+
 MSMBase::~MSMBase()
 {
   for (uInt i=0; i<ncolumn(); i++) {
@@ -68,7 +94,7 @@ MSMBase::~MSMBase()
 
 DataManager* MSMBase::clone() const
 {
-  MSMBase* smp = new MSMBase (stmanName_p);
+  MSMBase* smp = new MSMBase (stmanName_p, arena_p, arenaRows_p);
   return smp;
 }
 
@@ -89,6 +115,14 @@ String MSMBase::dataManagerName() const
   return stmanName_p;
 }
 
+Record MSMBase::dataManagerSpec() const
+{
+  Record rec;
+  rec.define ("ARENA", arena_p);
+  rec.define ("ARENAROWS", Int64(arenaRows_p));
+  return rec;
+}
+
 //# Does the storage manager allow to add rows? (yes)
 Bool MSMBase::canAddRow() const
 {
@@ -75,8 +75,14 @@ public:
   // add a column to this storage manager.
   // <br> Note that the 2nd constructor is needed for table creation
   // from a record specification.
+  // <br>If <src>arena</src> is True, the columns are held in arena mode
+  // (see <linkto class=MemoryStMan>MemoryStMan</linkto>) for which
+  // <src>arenaRows</src> rows are reserved when the first rows are added.
+  // The record can define the fields ARENA and ARENAROWS for them.
   // <group>
   MSMBase (const String& storageManagerName);
+  MSMBase (const String& storageManagerName, Bool arena,
+           rownr_t arenaRows = 0);
   MSMBase (const String& storageManagerName, const Record&);
   // </group>
 
@@ -92,6 +98,18 @@ public:
   // Get the name given to this storage manager.
   virtual String dataManagerName() const;
 
+  // Get a record containing data manager specifications
+  // (i.e., ARENA and ARENAROWS).
+  virtual Record dataManagerSpec() const;
+
+  // Are the columns held in arena mode?
+  Bool isArena() const
+    { return arena_p; }
+
+  // Get the nr of rows to reserve in arena mode.
+  rownr_t arenaRows() const
+    { return arenaRows_p; }
+
   // Set the hasPut_p flag. In this way the StManAipsIOColumn objects
   // can indicate that data have been put.
   void setHasPut()
@@ -192,6 +210,10 @@ protected:
   PtrBlock<MSMColumn*> colSet_p;
   // Has anything been put since the last flush?
   Bool    hasPut_p;
+  // Are the columns held in a single block each?
+  Bool    arena_p;
+  // The nr of rows to reserve in arena mode.
+  rownr_t arenaRows_p;
 };
 
 
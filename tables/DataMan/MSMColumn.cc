@@ -44,6 +44,8 @@ MSMColumn::MSMColumn (MSMBase* smptr, int dataType, Bool byPtr)
 : StManColumnBase(dataType),
   stmanPtr_p (smptr),
   byPtr_p    (byPtr),
+  arena_p    (!byPtr  &&  smptr->isArena()),
+  nrvalRow_p (1),
   nralloc_p  (0),
   nrext_p    (0),
   data_p     (EXTBLSZ,static_cast<void*>(0)),
@@ -65,8 +67,13 @@ void MSMColumn::doCreate (rownr_t nrrow)
 void MSMColumn::addRow (rownr_t nrnew, rownr_t)
 {
   //# Extend the column sizes if needed.
+  //# In arena mode the size is at least doubled to make adding a row
+  //# amortized O(1).
   if (nrnew > nralloc_p) {
     rownr_t n = nralloc_p + 4096;
+    if (arena_p) {
+      n = max(2*nralloc_p, stmanPtr_p->arenaRows());
+    }
     if (n < nrnew) {
       n = nrnew;
     }
@@ -76,6 +83,26 @@ void MSMColumn::addRow (rownr_t nrnew, rownr_t)
 
 void MSMColumn::resize (rownr_t nr)
 {
+  //# In arena mode the single extension is replaced by a larger one.
+  if (arena_p  &&  nrext_p > 0) {
+    void* datap = allocData (nr*nrvalRow_p, False);
+    rownr_t nrval = nralloc_p*nrvalRow_p;
+    if (dtype() == TpString) {
+      String* to = static_cast<String*>(datap);
+      String* from = static_cast<String*>(data_p[1]);
+      for (rownr_t i=0; i<nrval; ++i) {
+        to[i] = std::move(from[i]);
+      }
+    } else {
+      memcpy (datap, data_p[1], nrval*elemSize());
+    }
+    deleteData (data_p[1], False);
+    data_p[1] = datap;
+    ncum_p[1] = nr;
+    nralloc_p = nr;
+    columnCache().invalidate();
+    return;
+  }
   //# Extend internal blocks if needed.
   if (nrext_p+1 >= data_p.nelements()) {
     //#cout << "resize internal blocks " << nrext_p << endl;
@@ -83,7 +110,7 @@ void MSMColumn::resize (rownr_t nr)
     ncum_p.resize(nrext_p + 1+EXTBLSZ);
   }
   //# Allocate another block of the correct data type.
-  data_p[nrext_p+1] = allocData (nr-nralloc_p, byPtr_p);
+  data_p[nrext_p+1] = allocData ((nr-nralloc_p)*nrvalRow_p, byPtr_p);
   //#cout << "allocated new block " << nr-nralloc_p << endl;
   nrext_p++;
   ncum_p[nrext_p] = nr;
@@ -126,6 +153,26 @@ uInt MSMColumn::findExt (rownr_t index, Bool setCache)
 
 
 void MSMColumn::getScalarColumnV (ArrayBase& vec)
+{
+  getColumnData (vec);
+}
+
+void MSMColumn::putScalarColumnV (const ArrayBase& vec)
+{
+  putColumnData (vec);
+}
+
+Bool MSMColumn::getColumnViewV (const void*& data, IPosition& shape)
+{
+  if (byPtr_p  ||  nrext_p != 1) {
+    return False;
+  }
+  data  = data_p[1];
+  shape = IPosition (1, stmanPtr_p->nrow());
+  return True;
+}
+
+void MSMColumn::getColumnData (ArrayBase& vec)
 {
   rownr_t nrow = stmanPtr_p->nrow();
   // Get a pointer to the destination data.
@@ -138,7 +185,7 @@ void MSMColumn::getScalarColumnV (ArrayBase& vec)
     String* to = static_cast<String*>(ptr);
     for (uInt i=1; i<=nrext_p; ++i) {
       const String* from = static_cast<String*>(data_p[i]);
-      rownr_t nr = min(nrow, ncum_p[i]) - ncum_p[i-1];
+      rownr_t nr = (min(nrow, ncum_p[i]) - ncum_p[i-1]) * nrvalRow_p;
       for (rownr_t j=0; j<nr; ++j) {
         *to++ = from[j];
       }
@@ -147,7 +194,7 @@ void MSMColumn::getScalarColumnV (ArrayBase& vec)
     char* to = static_cast<char*>(ptr);
     for (uInt i=1; i<=nrext_p; ++i) {
       const char* from = static_cast<char*>(data_p[i]);
-      rownr_t nr = min(nrow, ncum_p[i]) - ncum_p[i-1];
+      rownr_t nr = (min(nrow, ncum_p[i]) - ncum_p[i-1]) * nrvalRow_p;
       memcpy (to, from, nr * elemSize());
       to += nr * elemSize();
     }
@@ -156,7 +203,7 @@ void MSMColumn::getScalarColumnV (ArrayBase& vec)
   vec.putVStorage (ptr, deleteIt);
 }
 
-void MSMColumn::putScalarColumnV (const ArrayBase& vec)
+void MSMColumn::putColumnData (const ArrayBase& vec)
 {
   rownr_t nrow = stmanPtr_p->nrow();
   // Get a pointer to the destination data.
@@ -169,7 +216,7 @@ void MSMColumn::putScalarColumnV (const ArrayBase& vec)
     const String* from = static_cast<const String*>(ptr);
     for (uInt i=1; i<=nrext_p; ++i) {
       String* to = static_cast<String*>(data_p[i]);
-      rownr_t nr = min(nrow, ncum_p[i]) - ncum_p[i-1];
+      rownr_t nr = (min(nrow, ncum_p[i]) - ncum_p[i-1]) * nrvalRow_p;
       for (rownr_t j=0; j<nr; ++j) {
         to[j] = *from++;
       }
@@ -178,7 +225,7 @@ void MSMColumn::putScalarColumnV (const ArrayBase& vec)
     const char* from = static_cast<const char*>(ptr);
     for (uInt i=1; i<=nrext_p; ++i) {
       char* to = static_cast<char*>(data_p[i]);
-      rownr_t nr = min(nrow, ncum_p[i]) - ncum_p[i-1];
+      rownr_t nr = (min(nrow, ncum_p[i]) - ncum_p[i-1]) * nrvalRow_p;
       memcpy (to, from, nr * elemSize());
       from += nr * elemSize();
     }
@@ -553,15 +600,19 @@ void MSMColumn::removeData (void* dp, rownr_t inx, rownr_t nrvalAfter)
   if (inx >= nrvalAfter) {
     return;
   }
+  //# Take multiple values per row into account.
+  inx        *= nrvalRow_p;
+  nrvalAfter *= nrvalRow_p;
+  rownr_t nr  = nrvalRow_p;
   if (byPtr_p) {
     objmove (static_cast<void**>(dp) + inx,
-             static_cast<void**>(dp) + inx+1, nrvalAfter-inx);
+             static_cast<void**>(dp) + inx+nr, nrvalAfter-inx);
   } else if (dtype() == TpString) {
     objmove (static_cast<String*>(dp) + inx,
-             static_cast<String*>(dp) + inx+1, nrvalAfter-inx);
+             static_cast<String*>(dp) + inx+nr, nrvalAfter-inx);
   } else {
     memmove (static_cast<char*>(dp) + inx*elemSize(),
-             static_cast<char*>(dp) + (inx+1)*elemSize(),
+             static_cast<char*>(dp) + (inx+nr)*elemSize(),
              (nrvalAfter-inx)*elemSize());
   }
 }
@@ -583,6 +634,10 @@ void MSMColumn::initData (void* datap, rownr_t nrval)
 void* MSMColumn::getArrayPtr (rownr_t rownr)
 {
   uInt extnr = findExt(rownr, False);
+  if (!byPtr_p) {
+    return static_cast<char*>(data_p[extnr]) +
+           (rownr-ncum_p[extnr-1]) * nrvalRow_p * elemSize();
+  }
   return (static_cast<void**>(data_p[extnr])) [rownr-ncum_p[extnr-1]];
 }
 
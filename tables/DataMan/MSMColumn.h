@@ -84,6 +84,10 @@ class MSMBase;
 // super block. Accessing a row means finding the appropriate extension
 // via a binary search. Because there is only 1 extension when a table is
 // read back, the overhead in finding a row is small.
+// <br>In arena mode of the MemoryStMan, the column is held in a single
+// extension that is reallocated with at least twice its size when rows
+// are added. Furthermore, an extension can hold multiple values per row,
+// which is used by MSMDirColumn to store fixed shaped arrays directly.
 // </synopsis> 
 
 // <motivation>
@@ -160,11 +164,16 @@ public:
   // (which is guaranteed by the ScalarColumn putColumn function).
   virtual void putScalarColumnV (const ArrayBase& data);
 
+  // Get a view of the values in the column, which is possible if they
+  // are held in a single extension.
+  virtual Bool getColumnViewV (const void*& data, IPosition& shape);
+
   // Add (newNrrow-oldNrrow) rows to the column.
   virtual void addRow (rownr_t newNrrow, rownr_t oldNrrow);
 
   // Resize the data blocks.
-  // This adds an extension when needed.
+  // This adds an extension when needed. In arena mode the single
+  // extension is reallocated.
   void resize (rownr_t nrval);
 
   // Remove the given row.
@@ -193,6 +202,10 @@ protected:
   MSMBase* stmanPtr_p;
   // The data is indirectly accessed via a pointer (for the derived classes).
   Bool     byPtr_p;
+  // Is the column held in a single extension (arena mode)?
+  Bool     arena_p;
+  // The nr of values per row in an extension.
+  rownr_t  nrvalRow_p;
   // The number of allocated rows in the column.
   rownr_t  nralloc_p;
   // The nr of extensions in use.
@@ -222,11 +235,19 @@ protected:
   // one position to the left.
   void removeData (void* datap, rownr_t inx, rownr_t nrvalAfter);
 
+  // Get or put the values of all rows (as done by get/putScalarColumnV).
+  // <group>
+  void getColumnData (ArrayBase& data);
+  void putColumnData (const ArrayBase& data);
+  // </group>
+
   // Initialize the data (after an open).
   virtual void initData (void* datap, rownr_t nrval);
 
   // Get the pointer for the given row.
   // This is for the derived classes like StManArrayColumnMemory.
+  // If the data are not accessed via a pointer, it returns the address
+  // of the values of the row in the extension.
   void* getArrayPtr (rownr_t rownr);
 
   // Put the pointer for the given row.
@@ -39,15 +39,18 @@
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 MSMDirColumn::MSMDirColumn (MSMBase* smptr, int dataType)
-: MSMColumn (smptr, dataType, True),
+: MSMColumn (smptr, dataType, !smptr->isArena()),
   nrelem_p  (0)
 {}
 
 MSMDirColumn::~MSMDirColumn()
 {
-  rownr_t nr = stmanPtr_p->nrow();
-  for (rownr_t i=0; i<nr; i++) {
-    deleteArray (i);
+  //# In arena mode the arrays are deleted with the extension.
+  if (byPtr_p) {
+    rownr_t nr = stmanPtr_p->nrow();
+    for (rownr_t i=0; i<nr; i++) {
+      deleteArray (i);
+    }
   }
 }
 
@@ -56,6 +59,9 @@ void MSMDirColumn::setShapeColumn (const IPosition& shape)
 {
   shape_p  = shape;
   nrelem_p = shape.product();
+  if (!byPtr_p) {
+    nrvalRow_p = nrelem_p;
+  }
 }
 
 
@@ -64,19 +70,28 @@ void MSMDirColumn::addRow (rownr_t nrnew, rownr_t nrold)
   //# Extend data blocks if needed.
   MSMColumn::addRow (nrnew, nrold);
   //# Allocate the fixed shape data arrays.
-  void* ptr;
-  for (; nrold<nrnew; nrold++) {
-    ptr = allocData (nrelem_p, False);
-    putArrayPtr (nrold, ptr);
+  //# In arena mode they are part of the data blocks.
+  if (byPtr_p) {
+    void* ptr;
+    for (; nrold<nrnew; nrold++) {
+      ptr = allocData (nrelem_p, False);
+      putArrayPtr (nrold, ptr);
+    }
   }
 }
 
 void MSMDirColumn::doCreate (rownr_t nrrow)
 {
   addRow (nrrow, 0);
-  for (rownr_t i=0; i<nrrow; i++) {
-    initData (getArrayPtr(i), nrelem_p);
-  } 
+  if (!byPtr_p) {
+    if (nrrow > 0) {
+      initData (data_p[1], nrrow*nrelem_p);
+    }
+  } else {
+    for (rownr_t i=0; i<nrrow; i++) {
+      initData (getArrayPtr(i), nrelem_p);
+    }
+  }
 }
 
 uInt MSMDirColumn::ndim (rownr_t)
@@ -210,9 +225,56 @@ void MSMDirColumn::putSliceV (rownr_t rownr, const Slicer& slicer, const ArrayBa
 }
 
 
+void MSMDirColumn::getArrayColumnV (ArrayBase& arr)
+{
+  if (byPtr_p) {
+    MSMColumn::getArrayColumnV (arr);
+  } else {
+    getColumnData (arr);
+  }
+}
+
+void MSMDirColumn::putArrayColumnV (const ArrayBase& arr)
+{
+  if (byPtr_p) {
+    MSMColumn::putArrayColumnV (arr);
+  } else {
+    putColumnData (arr);
+    stmanPtr_p->setHasPut();
+  }
+}
+
+Bool MSMDirColumn::getArrayViewV (rownr_t rownr, const Slicer* slicer,
+                                   const void*& data, IPosition& blockShape,
+                                   Slicer& section)
+{
+  data       = getArrayPtr (rownr);
+  blockShape = shape_p;
+  if (slicer == 0) {
+    section = Slicer (IPosition(shape_p.size(), 0), shape_p);
+  } else {
+    IPosition blc, trc, inc;
+    slicer->inferShapeFromSource (shape_p, blc, trc, inc);
+    section = Slicer (blc, trc, inc, Slicer::endIsLast);
+  }
+  return True;
+}
+
+Bool MSMDirColumn::getColumnViewV (const void*& data, IPosition& shape)
+{
+  if (! MSMColumn::getColumnViewV (data, shape)) {
+    return False;
+  }
+  shape = shape_p.concatenate (shape);
+  return True;
+}
+
+
 void MSMDirColumn::remove (rownr_t rownr)
 {
-  deleteArray (rownr);
+  if (byPtr_p) {
+    deleteArray (rownr);
+  }
   MSMColumn::remove (rownr);
 }
 
@@ -53,6 +53,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // <synopsis> 
 // MSMDirColumn handles arrays in a table column.
 // It only keeps them in memory, so they are not persistent.
+// Normally each array is allocated separately and MSMColumn holds
+// a pointer to it. In arena mode of the MemoryStMan the arrays are
+// stored directly one after the other in the single extension of
+// MSMColumn, so the column forms a strided block of memory.
 // </synopsis> 
 
 //# <todo asof="$DATE:$">
@@ -110,6 +114,24 @@ public:
   // (which is guaranteed by the ArrayColumn putSlice function).
   virtual void putSliceV (rownr_t rownr, const Slicer&, const ArrayBase& arr);
 
+  // Get all arrays in the column.
+  // In arena mode the data are copied directly.
+  virtual void getArrayColumnV (ArrayBase& arr);
+
+  // Put all arrays in the column.
+  // In arena mode the data are copied directly.
+  virtual void putArrayColumnV (const ArrayBase& arr);
+
+  // Get a view of the array (section) in the given row.
+  // It is always possible, because the array is held in memory.
+  virtual Bool getArrayViewV (rownr_t rownr, const Slicer* slicer,
+                              const void*& data, IPosition& blockShape,
+                              Slicer& section);
+
+  // Get a view of the arrays in the column, which is possible in arena
+  // mode.
+  virtual Bool getColumnViewV (const void*& data, IPosition& shape);
+
   // Remove the value in the given row.
   void remove (rownr_t rownr);
 
@@ -37,6 +37,11 @@ MemoryStMan::MemoryStMan (const String& storageManagerName)
 : MSMBase (storageManagerName)
 {}
 
+MemoryStMan::MemoryStMan (const String& storageManagerName, Bool arena,
+                          rownr_t arenaRows)
+: MSMBase (storageManagerName, arena, arenaRows)
+{}
+
 
 MemoryStMan::~MemoryStMan()
 {}
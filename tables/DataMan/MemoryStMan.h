@@ -69,8 +69,39 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // process changed data or added or deleted rows. If the number or rows
 // has changed, rows will be added or deleted as needed. Row deletion
 // will be done at the end of the table.
+//
+// By default the data of a column are held in extensions of at least 4096
+// rows, while each array in a column is allocated separately.
+// For large scratch tables that are filled at a high rate it is better to
+// use arena mode. In that mode each scalar and fixed shaped array column
+// is held in a single contiguous block of memory (the arena), in which the
+// arrays are stored one after the other. The arena grows by reallocating it
+// with at least twice its size, so adding rows is amortized O(1) and
+// deleting the table only frees one block per column. The number of rows
+// to reserve initially can be given to avoid reallocations.
+// Columns with variable shaped arrays are not affected by arena mode.
+// <br>Because all rows are contiguous, the data of an arena column can be
+// obtained without copying them by means of the getColumnView
+// functions in <linkto class=ScalarColumn>ScalarColumn</linkto> and
+// <linkto class=ArrayColumn>ArrayColumn</linkto>.
+// Note that adding rows can reallocate the arena, which invalidates
+// such views.
 // </synopsis> 
 
+// <example>
+// <srcblock>
+// // Create a memory table with 1000000 rows reserved in arena mode.
+// SetupNewTable newtab ("", td, Table::New);
+// MemoryStMan stman ("arena", True, 1000000);
+// newtab.bindAll (stman);
+// Table tab (newtab, Table::Memory);
+// ...
+// ArrayColumn<Complex> dataCol (tab, "DATA");
+// Array<Complex> data;
+// dataCol.getColumnView (data);     // no copy
+// </srcblock>
+// </example>
+
 //# <todo asof="$DATE:$">
 //# A List of bugs, limitations, extensions or planned refinements.
 //# </todo>
@@ -88,6 +119,12 @@ public:
   // add a column to this storage manager.
   MemoryStMan (const String& storageManagerName);
 
+  // Create an Memory storage manager with the given name, which uses
+  // arena mode if <src>arena</src> is True. In that case
+  // <src>arenaRows</src> rows are reserved when the first rows are added.
+  MemoryStMan (const String& storageManagerName, Bool arena,
+               rownr_t arenaRows = 0);
+
   ~MemoryStMan();
 };
 
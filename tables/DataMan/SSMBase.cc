@@ -35,6 +35,7 @@
 #include <casacore/casa/Containers/BlockIO.h>
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Utilities/ValType.h>
+#include <casacore/casa/Utilities/DataType.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/IO/BucketCache.h>
 #include <casacore/casa/IO/BucketFile.h>
@@ -62,6 +63,8 @@ SSMBase::SSMBase (Int aBucketSize, uInt aCacheSize)
   itsStringHandler     (0),
   itsPersCacheSize     (std::max(aCacheSize,uInt(2))),
   itsCacheSize         (0),
+  itsWriteBehindSize   (0),
+  itsSyncSizeMB        (0),
   itsNrBuckets         (0), 
   itsNrIdxBuckets      (0),
   itsFirstIdxBucket    (-1),
@@ -72,7 +75,8 @@ SSMBase::SSMBase (Int aBucketSize, uInt aCacheSize)
   itsFirstFreeBucket   (-1),
   itsBucketSize        (0),
   itsBucketRows        (0),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsZoneMaps          (False)
 { 
   if (aBucketSize < 0) {
     itsBucketRows = -aBucketSize;
@@ -94,6 +98,8 @@ SSMBase::SSMBase (const String& aDataManName,
   itsStringHandler     (0),
   itsPersCacheSize     (std::max(aCacheSize,uInt(2))),
   itsCacheSize         (0),
+  itsWriteBehindSize   (0),
+  itsSyncSizeMB        (0),
   itsNrBuckets         (0), 
   itsNrIdxBuckets      (0),
   itsFirstIdxBucket    (-1),
@@ -104,7 +110,8 @@ SSMBase::SSMBase (const String& aDataManName,
   itsFirstFreeBucket   (-1),
   itsBucketSize        (0),
   itsBucketRows        (0),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsZoneMaps          (False)
 { 
   if (aBucketSize < 0) {
     itsBucketRows = -aBucketSize;
@@ -126,6 +133,8 @@ SSMBase::SSMBase (const String& aDataManName,
   itsStringHandler     (0),
   itsPersCacheSize     (2),
   itsCacheSize         (0),
+  itsWriteBehindSize   (0),
+  itsSyncSizeMB        (0),
   itsNrBuckets         (0), 
   itsNrIdxBuckets      (0),
   itsFirstIdxBucket    (-1),
@@ -136,7 +145,8 @@ SSMBase::SSMBase (const String& aDataManName,
   itsFirstFreeBucket   (-1),
   itsBucketSize        (0),
   itsBucketRows        (0),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsZoneMaps          (False)
 { 
   // Get nr of rows per bucket if defined.
   if (spec.isDefined ("BUCKETROWS")) {
@@ -155,6 +165,15 @@ SSMBase::SSMBase (const String& aDataManName,
   if (spec.isDefined ("PERSCACHESIZE")) {
     itsPersCacheSize = max(2, spec.asInt ("PERSCACHESIZE"));
   }
+  if (spec.isDefined ("WriteBehindSize")) {
+    itsWriteBehindSize = max(0, spec.asInt ("WriteBehindSize"));
+  }
+  if (spec.isDefined ("SyncSizeMB")) {
+    itsSyncSizeMB = max(0, spec.asInt ("SyncSizeMB"));
+  }
+  if (spec.isDefined ("ZoneMaps")) {
+    itsZoneMaps = spec.asBool ("ZoneMaps");
+  }
 }
 
 SSMBase::SSMBase (const SSMBase& that)
@@ -167,6 +186,8 @@ SSMBase::SSMBase (const SSMBase& that)
   itsStringHandler     (0),
   itsPersCacheSize     (that.itsPersCacheSize),
   itsCacheSize         (0),
+  itsWriteBehindSize   (that.itsWriteBehindSize),
+  itsSyncSizeMB        (that.itsSyncSizeMB),
   itsNrBuckets         (0),
   itsNrIdxBuckets      (0),
   itsFirstIdxBucket    (-1),
@@ -177,7 +198,8 @@ SSMBase::SSMBase (const SSMBase& that)
   itsFirstFreeBucket   (-1),
   itsBucketSize        (that.itsBucketSize),
   itsBucketRows        (that.itsBucketRows),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsZoneMaps          (that.itsZoneMaps)
 {}
 
 SSMBase::~SSMBase()
@@ -215,6 +237,9 @@ Record SSMBase::dataManagerSpec() const
   rec.define ("BUCKETSIZE", Int(itsBucketSize));
   rec.define ("PERSCACHESIZE", Int(itsPersCacheSize));
   rec.define ("IndexLength", Int(itsIndexLength));
+  if (itsZoneMaps) {
+    rec.define ("ZoneMaps", True);
+  }
   return rec;
 }
 
@@ -224,6 +249,12 @@ Record SSMBase::getProperties() const
   const_cast<SSMBase*>(this)->getCache();
   Record rec;
   rec.define ("MaxCacheSize", Int(itsCacheSize));
+  if (itsWriteBehindSize > 0) {
+    rec.define ("WriteBehindSize", Int(itsWriteBehindSize));
+  }
+  if (itsSyncSizeMB > 0) {
+    rec.define ("SyncSizeMB", Int(itsSyncSizeMB));
+  }
   return rec;
 }
 
@@ -232,6 +263,23 @@ void SSMBase::setProperties (const Record& rec)
   if (rec.isDefined("MaxCacheSize")) {
     setCacheSize (rec.asInt("MaxCacheSize"), False);
   }
+  if (rec.isDefined("WriteBehindSize")  ||  rec.isDefined("SyncSizeMB")) {
+    if (rec.isDefined("WriteBehindSize")) {
+      itsWriteBehindSize = max(0, rec.asInt("WriteBehindSize"));
+    }
+    if (rec.isDefined("SyncSizeMB")) {
+      itsSyncSizeMB = max(0, rec.asInt("SyncSizeMB"));
+    }
+    setWriteBehind();
+  }
+}
+
+void SSMBase::setWriteBehind()
+{
+  if (itsCache != 0) {
+    itsCache->setWriteBehind (itsWriteBehindSize,
+                              Int64(itsSyncSizeMB) * 1024 * 1024);
+  }
 }
 
 void SSMBase::clearCache()
@@ -293,6 +341,10 @@ DataManagerColumn* SSMBase::makeScalarColumn (const String&,
     itsPtrColumn.resize (itsPtrColumn.nelements() + 32);
   }
   SSMColumn* aColumn = new SSMColumn (this, aDataType, ncolumn());
+  aColumn->setIsScalar();
+  if (itsZoneMaps) {
+    aColumn->makeZoneMap();
+  }
   itsPtrColumn[ncolumn()] = aColumn;
   return aColumn;
 }
@@ -371,6 +423,7 @@ void SSMBase::makeCache()
 				SSMBase::deleteCallBack);
     itsCache->resync (itsNrBuckets, itsFreeBucketsNr, 
 		      itsFirstFreeBucket);
+    setWriteBehind();
 
     if (forceFill) {
       readIndexBuckets();
@@ -383,6 +436,12 @@ uInt SSMBase::getRowsPerBucket(uInt aColumn) const
   return itsPtrIndex[itsColIndexMap[aColumn]]->getRowsPerBucket();
 }
 
+Vector<rownr_t> SSMBase::getStartRows (uInt aColumn)
+{
+  getCache();
+  return itsPtrIndex[itsColIndexMap[aColumn]]->getStartRows();
+}
+
 uInt SSMBase::getNewBucket()
 {
   char* aBucketPtr = new char[itsBucketSize];
@@ -501,12 +560,33 @@ void SSMBase::readIndexBuckets()
     itsPtrIndex[i] = new SSMIndex(this);
     itsPtrIndex[i]->get(anMOs);
   }
+
+  // The zone maps (if any) follow the indices. Their presence tells
+  // that zone maps are used, so make them for the columns.
+  if (anMOs.getpos() < Int64(itsIndexLength)) {
+    itsZoneMaps = True;
+    for (uInt i=0; i<ncolumn(); i++) {
+      itsPtrColumn[i]->makeZoneMap();
+    }
+    getZoneMaps (anMOs);
+  } else {
+    for (uInt i=0; i<ncolumn(); i++) {
+      itsPtrColumn[i]->clearZoneMap();
+    }
+  }
   
   anMOs.close();
 }
 
 void SSMBase::writeIndex()
 {
+  // Bring the zone maps up-to-date before writing them.
+  if (itsZoneMaps) {
+    for (uInt i=0; i<ncolumn(); i++) {
+      itsPtrColumn[i]->updateZoneMap();
+    }
+  }
+
   std::shared_ptr<TypeIO> aTio;
   std::shared_ptr<TypeIO> aMio;
   auto aMemBuf = std::make_shared<MemoryIO>();
@@ -531,6 +611,9 @@ void SSMBase::writeIndex()
   for (uInt i=0;i<aNrIdx; i++ ){
     itsPtrIndex[i]->put(anMOs);
   }
+  if (itsZoneMaps) {
+    putZoneMaps (anMOs);
+  }
   anMOs.close();
 
   // Write total Mio in buckets.
@@ -945,6 +1028,60 @@ void SSMBase::recreate()
   isDataChanged = True;
 }
 
+Bool SSMBase::zoneMapsChanged()
+{
+  for (uInt i=0; i<ncolumn(); i++) {
+    ZoneMap* aZoneMap = itsPtrColumn[i]->zoneMap();
+    if (aZoneMap  &&  aZoneMap->isChanged()) {
+      return True;
+    }
+  }
+  return False;
+}
+
+void SSMBase::putZoneMaps (AipsIO& anOs)
+{
+  uInt aNrMap = 0;
+  for (uInt i=0; i<ncolumn(); i++) {
+    if (itsPtrColumn[i]->zoneMap()) {
+      aNrMap++;
+    }
+  }
+  anOs.putstart ("SSMZoneMaps", 1);
+  anOs << aNrMap;
+  for (uInt i=0; i<ncolumn(); i++) {
+    ZoneMap* aZoneMap = itsPtrColumn[i]->zoneMap();
+    if (aZoneMap) {
+      anOs << i;
+      aZoneMap->put (anOs);
+    }
+  }
+  anOs.putend();
+}
+
+void SSMBase::getZoneMaps (AipsIO& anOs)
+{
+  anOs.getstart ("SSMZoneMaps");
+  uInt aNrMap;
+  anOs >> aNrMap;
+  for (uInt i=0; i<aNrMap; i++) {
+    uInt aColNr;
+    anOs >> aColNr;
+    ZoneMap* aZoneMap = 0;
+    if (aColNr < ncolumn()) {
+      aZoneMap = itsPtrColumn[aColNr]->zoneMap();
+    }
+    if (aZoneMap) {
+      aZoneMap->get (anOs);
+    } else {
+      // Skip a zone map of a column not having one (anymore).
+      ZoneMap aDummy(TpOther);
+      aDummy.get (anOs);
+    }
+  }
+  anOs.getend();
+}
+
 Bool SSMBase::hasMultiFileSupport() const
   { return True; }
 
@@ -959,7 +1096,8 @@ Bool SSMBase::flush (AipsIO& ios, Bool doFsync)
   if (itsCache) {
     itsCache->flush();
   }
-  if (isDataChanged) {
+  // Write the index if data or the zone maps have changed.
+  if (isDataChanged  ||  zoneMapsChanged()) {
     writeIndex();
     if (doFsync) {
       itsFile->fsync();
@@ -987,6 +1125,7 @@ rownr_t SSMBase::resync64 (rownr_t aNrRows)
   if (itsCache != 0) {
     itsCache->resync (itsNrBuckets, itsFreeBucketsNr, 
 		      itsFirstFreeBucket);
+    setWriteBehind();
   }
   if (itsPtrIndex.nelements() != 0) {
     readIndexBuckets();
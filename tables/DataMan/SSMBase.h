@@ -187,13 +187,18 @@ public:
   virtual Record dataManagerSpec() const;
 
   // Get data manager properties that can be modified.
-  // It is only ActualCacheSize (the actual cache size in buckets).
+  // They are MaxCacheSize (the actual cache size in buckets),
+  // WriteBehindSize and SyncSizeMB (the latter two only if nonzero).
   // It is a subset of the data manager specification.
   virtual Record getProperties() const;
 
   // Modify data manager properties.
-  // Only MaxCacheSize can be used. It is similar to function setCacheSize
+  // MaxCacheSize is similar to function setCacheSize
   // with <src>canExceedNrBuckets=False</src>.
+  // WriteBehindSize gives the maximum number of buckets waiting to be
+  // written behind (0 = no write-behind) and SyncSizeMB after how many
+  // MibiBytes written behind the file is fsync-ed (0 = no fsync).
+  // See <linkto class=BucketCache>BucketCache</linkto> for more info.
   virtual void setProperties (const Record& spec);
 
   // Get the version of the class.
@@ -209,6 +214,17 @@ public:
 
   // Get the current cache size (in buckets).
   uInt getCacheSize() const;
+
+  // Keep a zone map (the minimum and maximum per bucket) for the numeric
+  // scalar columns, which can be used by table selections.
+  // It has to be set before the table is created; it is the same as
+  // giving <src>ZoneMaps=True</src> in the specification record.
+  // The zone maps are stored in the table, so they are kept
+  // when the table is reopened.
+  void setZoneMaps (Bool zoneMaps);
+
+  // Does the storage manager keep zone maps?
+  Bool hasZoneMaps();
   
   // Clear the cache used by this storage manager.
   // It will flush the cache as needed and remove all buckets from it.
@@ -281,6 +297,9 @@ public:
   // Get rows per bucket for the given column.
   uInt getRowsPerBucket (uInt aColumn) const;
 
+  // Get the first row of each bucket used by the given column.
+  Vector<rownr_t> getStartRows (uInt aColumn);
+
   // Return a pointer to the (one and only) StringHandler object.
   SSMStringHandler* getStringHandler();
 
@@ -379,6 +398,9 @@ private:
   
   // Construct the cache object (if not constructed yet).
   void makeCache();
+
+  // Set the write-behind parameters in the cache (if constructed).
+  void setWriteBehind();
   
   // Read the header.
   void readHeader();
@@ -389,6 +411,16 @@ private:
   // Write the header and the indices.
   void writeIndex();
 
+  // Has a zone map of one of the columns changed?
+  Bool zoneMapsChanged();
+
+  // Write the zone maps of the columns.
+  // They are written after the indices, so older software ignores them.
+  void putZoneMaps (AipsIO& anOs);
+
+  // Read the zone maps of the columns.
+  void getZoneMaps (AipsIO& anOs);
+
 
   //# Declare member variables.
   // Name of data manager.
@@ -423,6 +455,12 @@ private:
   
   // The actual cache size.
   uInt itsCacheSize;
+
+  // The maximum number of buckets waiting to be written behind.
+  uInt itsWriteBehindSize;
+
+  // The number of MibiBytes written behind after which to fsync.
+  uInt itsSyncSizeMB;
   
   // The initial number of buckets in the cache.
   uInt itsNrBuckets;
@@ -458,6 +496,9 @@ private:
   
   // Has the data changed since the last flush?
   Bool isDataChanged;
+
+  // Are zone maps kept for the numeric scalar columns?
+  Bool itsZoneMaps;
 };
 
 
@@ -489,6 +530,18 @@ inline BucketCache& SSMBase::getCache()
   return *itsCache;
 }
 
+inline void SSMBase::setZoneMaps (Bool zoneMaps)
+{
+  itsZoneMaps = zoneMaps;
+}
+
+inline Bool SSMBase::hasZoneMaps()
+{
+  // The cache has to be made to know if the zone maps exist in the file.
+  getCache();
+  return itsZoneMaps;
+}
+
 inline SSMColumn& SSMBase::getColumn (uInt aColNr)
 {
   return *(itsPtrColumn[aColNr]);
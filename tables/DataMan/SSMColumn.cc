@@ -48,7 +48,8 @@ SSMColumn::SSMColumn (SSMBase* aParent, int aDataType, uInt aColNr)
   itsMaxLen      (0),
   itsNrElem      (1),
   itsNrCopy      (0),
-  itsData        (0)
+  itsData        (0),
+  itsIsScalar    (False)
 {
   init();
 }
@@ -91,6 +92,9 @@ void SSMColumn::getFile(rownr_t)
 
 void SSMColumn::addRow (rownr_t aNewNrRows, rownr_t, Bool doInit)
 {
+  if (itsZoneMap) {
+    itsZoneMap->addRows (aNewNrRows);
+  }
   if (doInit  &&  dataType() == TpString) {
     rownr_t aRowNr=0;
     rownr_t aNrRows=aNewNrRows;
@@ -112,6 +116,9 @@ void SSMColumn::addRow (rownr_t aNewNrRows, rownr_t, Bool doInit)
 
 void SSMColumn::deleteRow(rownr_t aRowNr)
 {
+  if (itsZoneMap) {
+    itsZoneMap->removeRow (aRowNr);
+  }
   char*   aValue;
   rownr_t aSRow;
   rownr_t anERow;
@@ -332,6 +339,7 @@ void SSMColumn::putBool (rownr_t aRowNr, const Bool* aValue)
   Conversion::boolToBit(aDummy+(anOff/8),
 			aValue,anOff%8,1);
   itsSSMPtr->setBucketDirty();
+  putZoneValue (aRowNr, aValue);
 
   if (aRowNr >= columnCache().start()  &&  aRowNr <= columnCache().end()) {
     getDataPtr()[aRowNr-columnCache().start()] = 
@@ -470,6 +478,7 @@ void SSMColumn::putValue(rownr_t aRowNr, const void* aValue)
   itsWriteFunc (aDummy+(aRowNr-aStartRow)*itsExternalSizeBytes,
   		aValue, itsNrCopy);
   itsSSMPtr->setBucketDirty();
+  putZoneValue (aRowNr, aValue);
 }
 
 void SSMColumn::putValueShortString(rownr_t aRowNr, const void* aValue,
@@ -559,6 +568,12 @@ void SSMColumn::putColumnValue(const void* anArray,rownr_t aNrRows)
     itsSSMPtr->setBucketDirty();
   }
 
+  if (itsZoneMap) {
+    const char* aValPtr = static_cast<const char*>(anArray);
+    for (rownr_t i=0; i<aNrRows; i++) {
+      itsZoneMap->putValue (i, aValPtr + i*itsLocalSize);
+    }
+  }
   // Be sure cache will be emptied
   columnCache().invalidate();
 }
@@ -576,6 +591,42 @@ void SSMColumn::removeColumn()
   }
 }
   
+void SSMColumn::makeZoneMap()
+{
+  if (itsIsScalar  &&  ZoneMap::isSupported (dataType())) {
+    itsZoneMap.reset (new ZoneMap (dataType()));
+  }
+}
+
+void SSMColumn::clearZoneMap()
+{
+  if (itsZoneMap) {
+    itsZoneMap->invalidate();
+  }
+}
+
+void SSMColumn::updateZoneMap()
+{
+  if (itsZoneMap) {
+    Vector<rownr_t> startRows = itsSSMPtr->getStartRows (itsColNr);
+    itsZoneMap->update (startRows, itsSSMPtr->getNRow(), *this);
+  }
+}
+
+Bool SSMColumn::getZoneMap (Vector<rownr_t>& zoneStarts,
+                            Vector<Double>& minValues,
+                            Vector<Double>& maxValues)
+{
+  if (! itsSSMPtr->hasZoneMaps()  ||  ! itsZoneMap) {
+    return False;
+  }
+  updateZoneMap();
+  zoneStarts.reference (itsZoneMap->zoneStarts().copy());
+  minValues.reference (itsZoneMap->minValues().copy());
+  maxValues.reference (itsZoneMap->maxValues().copy());
+  return True;
+}
+
 void SSMColumn::init()
 {
   DataType aDT = static_cast<DataType>(dataType());
@@ -31,9 +31,11 @@
 #include <casacore/casa/aips.h>
 #include <casacore/tables/DataMan/StManColumnBase.h>
 #include <casacore/tables/DataMan/SSMBase.h>
+#include <casacore/tables/DataMan/ZoneMap.h>
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/OS/Conversion.h>
+#include <memory>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -201,6 +203,31 @@ public:
   // as is the case with Strings, it can be done here.
   void removeColumn();
 
+  // Tell that the column is a scalar column.
+  // It is called by SSMBase when the column is made.
+  void setIsScalar()
+    { itsIsScalar = True; }
+
+  // Make a zone map for the column if it is a numeric scalar column.
+  // It is called by SSMBase if it keeps zone maps.
+  void makeZoneMap();
+
+  // Get the zone map (a null pointer if the column does not have one).
+  ZoneMap* zoneMap()
+    { return itsZoneMap.get(); }
+
+  // Invalidate the zone map (if any), so it has to be fully recalculated.
+  void clearZoneMap();
+
+  // Update the zone map (if any) to the current contents of the column.
+  void updateZoneMap();
+
+  // Get the zone map. The zones are the buckets used by the column.
+  // It returns False if the column does not have a zone map.
+  virtual Bool getZoneMap (Vector<rownr_t>& zoneStarts,
+                           Vector<Double>& minValues,
+                           Vector<Double>& maxValues);
+
 protected:
   // Shift the rows in the bucket one to the left when removing the given row.
   void shiftRows (char* aValue, rownr_t rowNr, rownr_t startRow, rownr_t endRow);
@@ -257,6 +284,10 @@ protected:
   Conversion::ValueFunction* itsWriteFunc;
   // Pointer to a convert function for reading.
   Conversion::ValueFunction* itsReadFunc;
+  // Is it a scalar column?
+  Bool itsIsScalar;
+  // The zone map (only for numeric scalar columns).
+  std::unique_ptr<ZoneMap> itsZoneMap;
   
 private:
   // Initialize part of the object.
@@ -266,6 +297,11 @@ private:
 
   // Get the pointer to the cache. It is created if not done yet.
   char* getDataPtr();
+
+protected:
+  // Tell the zone map (if any) that a value is put into the given row.
+  void putZoneValue (rownr_t aRowNr, const void* aValue)
+    { if (itsZoneMap) itsZoneMap->putValue (aRowNr, aValue); }
 };
 
 
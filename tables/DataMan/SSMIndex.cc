@@ -287,6 +287,15 @@ Vector<uInt> SSMIndex::getBuckets() const
   return aBucketList;
 }
 
+Vector<rownr_t> SSMIndex::getStartRows() const
+{
+  Vector<rownr_t> aStartRows(itsNUsed);
+  for (uInt i=0; i< itsNUsed; i++) {
+    aStartRows(i) = (i==0  ?  0 : itsLastRow[i-1]+1);
+  }
+  return aStartRows;
+}
+
 Int SSMIndex::getFree (Int& anOffset, uInt nbits) const
 {
   Int aLength = (itsRowsPerBucket * nbits + 7) / 8;
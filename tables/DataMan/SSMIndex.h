@@ -107,6 +107,9 @@ public:
   // Return the nr of buckets used.
   uInt getNrBuckets() const;
 
+  // Return the first row number of all buckets used.
+  Vector<rownr_t> getStartRows() const;
+
   // Set nr of columns use this index.
   void setNrColumns (Int aNrColumns, uInt aSizeUsed);
 
@@ -104,6 +104,24 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // <p>
 // As said above all string arrays and variable length scalar strings
 // are stored in separate string buckets. 
+// <p>
+// A process filling a table (e.g. putting the rows one by one) can let
+// StandardStMan write the changed buckets behind. A bucket leaving the
+// cache is then written by a background thread, so the process does not
+// have to wait for the disk. It is enabled by setting the data manager
+// property <src>WriteBehindSize</src> to the maximum number of buckets
+// waiting to be written. Property <src>SyncSizeMB</src> tells after how
+// many MibiBytes written the background thread does an fsync.
+// The properties can also be given in the specification record when
+// constructing the storage manager. They are not stored in the table.
+// Write-behind is not possible if the table is stored in a MultiFile.
+// <p>
+// Optionally the minimum and maximum value per bucket (a zone map) is kept
+// for the numeric scalar columns (see <linkto class=ZoneMap>ZoneMap</linkto>).
+// A table selection uses it to skip buckets not containing the values
+// to select. It is enabled by <src>setZoneMaps(True)</src> or by
+// <src>ZoneMaps=True</src> in the specification record when creating
+// the table. Contrary to the properties, it is stored in the table.
 // </synopsis>
 
 // <motivation>
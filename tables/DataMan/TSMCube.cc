@@ -37,12 +37,14 @@
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/IO/BucketCache.h>
+#include <casacore/casa/IO/BucketFile.h>
 #include <casacore/casa/IO/AipsIO.h>
 #include <casacore/casa/IO/ArrayIO.h>
 #include <casacore/casa/OS/Conversion.h>
 #include <casacore/casa/OS/HostInfo.h>
 #include <casacore/casa/string.h>                           // for memcpy
 #include <casacore/casa/iostream.h>
+#include <vector>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -377,6 +379,12 @@ void TSMCube::makeCache()
                                    bucketSize_p, nrTiles_p, 1, this,
                                    readCallBack, writeCallBack,
                                    initCallBack, deleteCallBack);
+        const TSMOption& tsmOption = stmanPtr_p->tsmOption();
+        if (tsmOption.writeBehindSize() > 0) {
+            cache_p->setWriteBehind (tsmOption.writeBehindSize(),
+                                     Int64(max(0, tsmOption.syncSizeMB()))
+                                     * 1024 * 1024);
+        }
     }
 }
 
@@ -705,6 +713,53 @@ char* TSMCube::initCallBack (void* owner)
     return buffer;
 }
 
+const char* TSMCube::getTileData (const IPosition&, uInt)
+{
+    return 0;
+}
+
+Int64 TSMCube::copyTiles (TSMCube& that)
+{
+    // A hypercube without a shape has no tiles.
+    if (nrdim_p == 0  ||  filePtr_p == 0) {
+        return 0;
+    }
+    Int64 length = Int64(nrTiles_p) * bucketSize_p;
+    if (length == 0) {
+        return 0;
+    }
+    // Write the tiles of the source still in its cache.
+    that.flushCache();
+    // The tiles in the cache of this hypercube get obsolete.
+    deleteCache();
+    BucketFile* fromFile = that.filePtr_p->bucketFile();
+    BucketFile* toFile   = filePtr_p->bucketFile();
+    that.filePtr_p->open();
+    filePtr_p->open();
+    toFile->setRW();
+    Int64 fromSize = fromFile->fileSize();
+    // Copy in chunks of entire tiles.
+    Int64 chunkSize = std::max (Int64(1), Int64(16*1024*1024) / bucketSize_p)
+                      * bucketSize_p;
+    std::vector<char> buffer (std::min (chunkSize, length));
+    for (Int64 done=0; done<length; done+=chunkSize) {
+        uInt nb = std::min (chunkSize, length-done);
+        Int64 offset = that.fileOffset_p + done;
+        // Tiles past the end of the file have never been written, so they
+        // are zero (as done by initCallBack).
+        uInt nr = std::max (Int64(0), std::min (Int64(nb), fromSize - offset));
+        if (nr > 0) {
+            fromFile->pread (buffer.data(), nr, offset);
+        }
+        if (nr < nb) {
+            memset (buffer.data() + nr, 0, nb - nr);
+        }
+        toFile->seek (fileOffset_p + done);
+        toFile->write (buffer.data(), nb);
+    }
+    return length;
+}
+
 uInt TSMCube::cacheSize() const
 {
     if (cache_p == 0) {
@@ -910,33 +965,18 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
     if (writeFlag) {
 	stmanPtr_p->setDataChanged();
     }
-    // Prepare for the iteration through the necessary tiles.
-    uInt i, j;
-
-    // Initialize the various variables and determine the number of
-    // tiles needed (which will determine the cache size).
+    // Determine the tiles needed (which will determine the cache size).
     // Also determine if the slice happens to be an entire slice
     // or if it is a line (this cases occur quite often and can be
     // handled in a more optimal way).
-    Bool oneEntireTile = True;
+    Bool oneEntireTile = findSectionTiles (start, end, nrTileSection_p,
+                                           startTile_p, endTile_p,
+                                           startPixelInFirstTile_p,
+                                           endPixelInFirstTile_p,
+                                           endPixelInLastTile_p);
     uInt lineIndex = 0;
     uInt nOneLong = 0;
-    for (i=0; i<nrdim_p; i++) {
-        startTile_p(i) = start(i) / tileShape_p(i);
-        endTile_p(i)   = end(i) / tileShape_p(i);
-        nrTileSection_p(i)   = 1 + endTile_p(i) - startTile_p(i);
-        startPixelInFirstTile_p(i) = start(i) - startTile_p(i)*tileShape_p(i);
-        endPixelInLastTile_p(i)    = end(i) - endTile_p(i) * tileShape_p(i);
-        endPixelInFirstTile_p(i)   = tileShape_p(i) - 1;
-        if (nrTileSection_p(i) == 1) {
-            endPixelInFirstTile_p(i) = endPixelInLastTile_p(i);
-            if (startPixelInFirstTile_p(i) != 0
-            ||  endPixelInFirstTile_p(i) != tileShape_p(i) - 1) {
-                oneEntireTile = False;
-            }
-        }else{
-            oneEntireTile = False;
-        }
+    for (uInt i=0; i<nrdim_p; i++) {
         if (start(i) == end(i)) {
             nOneLong++;
         }else{
@@ -945,13 +985,15 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
     }
     // Get the cache.
     BucketCache* cachePtr = getCache();
-    
-//    cout << "nrTileSection_p=" << nrTileSection_p << endl;
-//    cout << "startTile_p=" << startTile_p << endl;
-//    cout << "endTile_p=" << endTile_p << endl;
-//    cout << "startPixelInFirstTile_p" << startPixelInFirstTile_p << endl;
-//    cout << "endPixelInFirstTile_p" << endPixelInFirstTile_p << endl;
-//    cout << "endPixelInLastTile_p" << endPixelInLastTile_p << endl;
+    // Read ahead the tiles for the next access if wanted.
+    if (!writeFlag  &&  stmanPtr_p->tsmOption().prefetchSize() > 0) {
+        prefetchTiles (start, end, cachePtr,
+                       stmanPtr_p->tsmOption().prefetchSize());
+    }
+    // Read the tiles needed in a batch if wanted.
+    if (!writeFlag  &&  stmanPtr_p->tsmOption().option() == TSMOption::Batch) {
+        batchReadTiles (cachePtr);
+    }
 
     // A tile can contain more than one data array.
     // Each array is contiguous, so the first pixel of an array
@@ -987,18 +1029,70 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
         return;
     }
 
-    // At this point we start looping through all tiles.
+    // Loop through all tiles. Set a tile to dirty if we are writing.
+    accessTiles (start, end, section, pixelOffset, localPixelSize, writeFlag,
+                 nrTileSection_p, startTile_p, endTile_p,
+                 startPixelInFirstTile_p, endPixelInFirstTile_p,
+                 endPixelInLastTile_p,
+                 [cachePtr, writeFlag] (uInt tileNr) {
+                     char* dataArray = cachePtr->getBucket (tileNr);
+                     if (writeFlag) {
+                         cachePtr->setDirty();
+                     }
+                     return dataArray;
+                 });
+}
+
+Bool TSMCube::findSectionTiles (const IPosition& start, const IPosition& end,
+                                IPosition& nrTileSection,
+                                IPosition& startTile, IPosition& endTile,
+                                IPosition& startPixelInFirstTile,
+                                IPosition& endPixelInFirstTile,
+                                IPosition& endPixelInLastTile) const
+{
+    Bool oneEntireTile = True;
+    for (uInt i=0; i<nrdim_p; i++) {
+        startTile(i) = start(i) / tileShape_p(i);
+        endTile(i)   = end(i) / tileShape_p(i);
+        nrTileSection(i)         = 1 + endTile(i) - startTile(i);
+        startPixelInFirstTile(i) = start(i) - startTile(i) * tileShape_p(i);
+        endPixelInLastTile(i)    = end(i) - endTile(i) * tileShape_p(i);
+        endPixelInFirstTile(i)   = tileShape_p(i) - 1;
+        if (nrTileSection(i) == 1) {
+            endPixelInFirstTile(i) = endPixelInLastTile(i);
+            if (startPixelInFirstTile(i) != 0
+            ||  endPixelInFirstTile(i) != tileShape_p(i) - 1) {
+                oneEntireTile = False;
+            }
+        }else{
+            oneEntireTile = False;
+        }
+    }
+    return oneEntireTile;
+}
+
+void TSMCube::accessTiles (const IPosition& start, const IPosition& end,
+                           char* section, uInt pixelOffset,
+                           uInt localPixelSize, Bool writeFlag,
+                           const IPosition& nrTileSection,
+                           const IPosition& startTile,
+                           const IPosition& endTile,
+                           const IPosition& startPixelInFirstTile,
+                           const IPosition& endPixelInFirstTile,
+                           const IPosition& endPixelInLastTile,
+                           const std::function<char*(uInt)>& getTile)
+{
+    uInt i, j;
     // startPixel and endPixel will contain the first and last pixels
     // needed in the current tile.
     // tilePos contains the position of the current tile.
-    IPosition startSection (start);            // start of section in cube
-    IPosition sectionShape (end - start + 1);  // section shape
+    IPosition sectionShape (end - start + 1);
     TSMShape expandedSectionShape (sectionShape);
-    IPosition startPixel (startPixelInFirstTile_p);
-    IPosition endPixel   (endPixelInFirstTile_p);
-    IPosition tilePos    (startTile_p);
+    IPosition startPixel (startPixelInFirstTile);
+    IPosition endPixel   (endPixelInFirstTile);
+    IPosition tilePos    (startTile);
     IPosition tileIncr = 
-      expandedTilesPerDim_p.offsetIncrement (nrTileSection_p);
+      expandedTilesPerDim_p.offsetIncrement (nrTileSection);
     IPosition dataLength(nrdim_p);
     IPosition dataPos   (nrdim_p);
     IPosition sectionPos(nrdim_p);
@@ -1007,16 +1101,8 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
     uInt tileNr = expandedTilesPerDim_p.offset (tilePos);
 
     while (True) {
-//      cout << "tilePos=" << tilePos << endl;
-//      cout << "tileNr=" << tileNr << endl;
-//      cout << "start=" << startPixel << endl;
-//      cout << "end=" << endPixel << endl;
-        // Get the tile from the cache.
-        // Set it to dirty if we are writing.
-        char* dataArray = cachePtr->getBucket (tileNr);
-        if (writeFlag) {
-            cachePtr->setDirty();
-        }
+        // Get the tile data.
+        char* dataArray = getTile (tileNr);
 
         // At this point we start looping through all pixels in the tile.
         // We do a vector at a time.
@@ -1026,7 +1112,7 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
             dataLength(i) = 1 + endPixel(i) - startPixel(i);
             dataPos(i)    = startPixel(i);
             sectionPos(i) = tilePos(i) * tileShape_p(i)
-                            + startPixel(i) - startSection(i);
+                            + startPixel(i) - start(i);
         }
         dataOffset = pixelOffset + localPixelSize *
                             expandedTileShape_p.offset (startPixel);
@@ -1078,18 +1164,18 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
         for (i=0; i<nrdim_p; i++) {
             tileNr += tileIncr(i);
             startPixel(i) = 0;
-            if (++tilePos(i) < endTile_p(i)) {
+            if (++tilePos(i) < endTile(i)) {
                 break;                                 // not at last tile
             }
-            if (tilePos(i) == endTile_p(i)) {
-                endPixel(i) = endPixelInLastTile_p(i);   // last tile
+            if (tilePos(i) == endTile(i)) {
+                endPixel(i) = endPixelInLastTile(i);   // last tile
                 break;
             }
             // Past last tile in this dimension.
             // Reset start and end.
-            tilePos(i) = startTile_p(i);
-            startPixel(i) = startPixelInFirstTile_p(i);
-            endPixel(i)   = endPixelInFirstTile_p(i);
+            tilePos(i) = startTile(i);
+            startPixel(i) = startPixelInFirstTile(i);
+            endPixel(i)   = endPixelInFirstTile(i);
         }
         if (i == nrdim_p) {
             break;                                     // ready
@@ -1097,6 +1183,103 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
     }
 }
 
+void TSMCube::prefetchTiles (const IPosition& start, const IPosition& end,
+                             BucketCache* cachePtr, uInt maxPrefetch)
+{
+    // Determine the step between the previous and this access.
+    // For the first access (or the same section again) assume stepping
+    // along the last axis.
+    IPosition step(nrdim_p, 0);
+    if (prefetchStart_p.nelements() == nrdim_p) {
+        step = start - prefetchStart_p;
+    } else {
+        prefetchStart_p.resize (nrdim_p);
+    }
+    prefetchStart_p = start;
+    if (step.isEqual (IPosition(nrdim_p, 0))) {
+        step(nrdim_p-1) = 1 + end(nrdim_p-1) - start(nrdim_p-1);
+    }
+    // Only read ahead if the access entered a new tile; otherwise the
+    // tiles have been requested already by a previous access.
+    if (startTile_p.isEqual (prefetchTile_p)) {
+        return;
+    }
+    prefetchTile_p = startTile_p;
+    // Determine the number of steps needed to get into the next tile(s).
+    Int64 nstep = -1;
+    for (uInt i=0; i<nrdim_p; i++) {
+        Int64 n = -1;
+        if (step(i) > 0) {
+            Int64 boundary = (endTile_p(i) + 1) * tileShape_p(i);
+            n = (boundary - end(i) + step(i) - 1) / step(i);
+        } else if (step(i) < 0) {
+            Int64 boundary = startTile_p(i) * tileShape_p(i) - 1;
+            n = (start(i) - boundary - step(i) - 1) / -step(i);
+        }
+        if (n > 0  &&  (nstep < 0  ||  n < nstep)) {
+            nstep = n;
+        }
+    }
+    if (nstep < 0) {
+        return;
+    }
+    // Get the tiles of the predicted section (as far as inside the cube).
+    IPosition nextStartTile(nrdim_p);
+    IPosition nextEndTile(nrdim_p);
+    for (uInt i=0; i<nrdim_p; i++) {
+        Int64 st = std::max (Int64(0), Int64(start(i) + nstep * step(i)));
+        Int64 en = std::min (Int64(cubeShape_p(i) - 1),
+                             Int64(end(i) + nstep * step(i)));
+        if (st > en) {
+            return;
+        }
+        nextStartTile(i) = st / tileShape_p(i);
+        nextEndTile(i)   = en / tileShape_p(i);
+    }
+    std::vector<uInt> tiles;
+    IPosition tilePos(nextStartTile);
+    while (tiles.size() < maxPrefetch) {
+        tiles.push_back (expandedTilesPerDim_p.offset (tilePos));
+        uInt i;
+        for (i=0; i<nrdim_p; i++) {
+            if (++tilePos(i) <= nextEndTile(i)) {
+                break;
+            }
+            tilePos(i) = nextStartTile(i);
+        }
+        if (i == nrdim_p) {
+            break;
+        }
+    }
+    cachePtr->prefetch (tiles, maxPrefetch);
+}
+
+void TSMCube::batchReadTiles (BucketCache* cachePtr)
+{
+    // Do not read more tiles than fit in the cache, otherwise they might
+    // be removed from the cache again before being used.
+    uInt maxBatch = cachePtr->cacheSize();
+    if (maxBatch < 2  ||  nrTileSection_p.product() < 2) {
+        return;
+    }
+    std::vector<uInt> tiles;
+    IPosition tilePos(startTile_p);
+    while (tiles.size() < maxBatch) {
+        tiles.push_back (expandedTilesPerDim_p.offset (tilePos));
+        uInt i;
+        for (i=0; i<nrdim_p; i++) {
+            if (++tilePos(i) <= endTile_p(i)) {
+                break;
+            }
+            tilePos(i) = startTile_p(i);
+        }
+        if (i == nrdim_p) {
+            break;
+        }
+    }
+    cachePtr->readBatch (tiles, maxBatch);
+}
+
 void TSMCube::accessLine (char* section, uInt pixelOffset,
                           uInt localPixelSize,
                           Bool writeFlag, BucketCache* cachePtr,
@@ -34,6 +34,9 @@
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/OS/Conversion.h>
 #include <casacore/casa/iosfwd.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -89,6 +92,18 @@ template<class T> class Block;
 // The description of class
 // <linkto class=ROTiledStManAccessor>ROTiledStManAccessor</linkto>
 // contains a discussion about the effect of setting the maximum cache size.
+// <p>
+// If a prefetch size is given in the <linkto class=TSMOption>TSMOption</linkto>
+// the tiles needed by the next read access are read ahead asynchronously.
+// They are predicted by assuming that the next access continues with the
+// same step as between the last two accesses (or along the last axis for
+// the first access). Read-ahead is done as soon as the accessed section
+// enters a new tile, so the background read has as much time as possible.
+// <br>
+// If TSMOption::Batch is used, the tiles of an accessed section that are
+// not in the cache are read in a single batch using
+// <linkto class=BucketFile>BucketFile::readBatch</linkto>, which combines
+// adjacent tiles in the file in a single vectored read.
 // </synopsis> 
 
 // <motivation>
@@ -143,13 +158,13 @@ public:
 
     // Clear the cache, so data will be reread.
     // If wanted, the data is flushed before the cache is cleared.
-    void clearCache (Bool doFlush = True);
+    virtual void clearCache (Bool doFlush = True);
 
     // Empty the cache.
     // It will flush the cache as needed and remove all buckets from it
     // resulting in a possibly large drop in memory used.
     // It'll also clear the <src>userSetCache_p</src> flag.
-    void emptyCache();
+    virtual void emptyCache();
 
     // Show the cache statistics.
     virtual void showCacheStatistics (ostream& os) const;
@@ -232,8 +247,25 @@ public:
                                 uInt localPixelSize, uInt externalPixelSize,
                                 Bool writeFlag);
 
+    // Get a read-only pointer to the data of the given column in the tile
+    // at the given tile position (i.e., the tile number in each axis).
+    // The data are in external format, so they can only be used directly
+    // if no conversion is needed.
+    // A null pointer is returned if the tile cannot be accessed directly
+    // in memory, which is the case for this class because it uses a cache.
+    virtual const char* getTileData (const IPosition& tilePos, uInt colnr);
+
+    // Copy the tiles of that hypercube as raw bytes into the tiles of
+    // this hypercube. The caller has to ensure that both hypercubes have
+    // the same shape, tile shape and tile layout (thus data types and
+    // external format). The tiles of that hypercube still in its cache are
+    // written first, while the cache of this hypercube is removed without
+    // flushing, because all its tiles are overwritten.
+    // It returns the number of bytes copied.
+    Int64 copyTiles (TSMCube& that);
+
     // Get the current cache size (in buckets).
-    uInt cacheSize() const;
+    virtual uInt cacheSize() const;
 
     // Calculate the cache size (in buckets) for the given slice
     // and access path.
@@ -284,7 +316,11 @@ public:
     // Functions for TSMDataColumn to keep track of the last type of
     // access to a hypercube. It uses it to determine if the cache
     // has to be reset.
+    // <br>Because a cube can be accessed by multiple threads if a
+    // thread-safe cache is used, the caller has to lock the mutex
+    // returned by <src>lastColMutex</src> while using these functions.
     // <group>
+    std::mutex& lastColMutex();
     AccessType getLastColAccess() const;
     const IPosition& getLastColSlice() const;
     void setLastColAccess (AccessType type);
@@ -308,6 +344,31 @@ protected:
     // if nrdim_p changes value.
     void resizeTileSections();
 
+    // Determine the tiles containing the section from start till end
+    // and the first and last pixel needed in them.
+    // It returns True if the section is exactly one entire tile.
+    Bool findSectionTiles (const IPosition& start, const IPosition& end,
+                           IPosition& nrTileSection,
+                           IPosition& startTile, IPosition& endTile,
+                           IPosition& startPixelInFirstTile,
+                           IPosition& endPixelInFirstTile,
+                           IPosition& endPixelInLastTile) const;
+
+    // Loop through the tiles found by findSectionTiles and copy the data
+    // of the section from or to them.
+    // The function <src>getTile</src> is called to get the data (in local
+    // format) of a tile. The pointer it returns must remain valid until
+    // the next call. When writing, it has to mark the tile as changed.
+    void accessTiles (const IPosition& start, const IPosition& end,
+                      char* section, uInt pixelOffset,
+                      uInt localPixelSize, Bool writeFlag,
+                      const IPosition& nrTileSection,
+                      const IPosition& startTile, const IPosition& endTile,
+                      const IPosition& startPixelInFirstTile,
+                      const IPosition& endPixelInFirstTile,
+                      const IPosition& endPixelInLastTile,
+                      const std::function<char*(uInt)>& getTile);
+
 private:
     // Get the cache object.
     // This will construct the cache object if not present yet.
@@ -322,6 +383,17 @@ private:
     // Delete the cache object.
     virtual void deleteCache();
 
+    // Read ahead the tiles needed by the next access assuming it continues
+    // in the same way as the previous ones.
+    // It is only done if the access enters a new tile.
+    // At most <src>maxPrefetch</src> tiles are read ahead.
+    void prefetchTiles (const IPosition& start, const IPosition& end,
+                        BucketCache* cachePtr, uInt maxPrefetch);
+
+    // Read the tiles of the section being accessed (as far as not cached)
+    // in a single batch. It is used for TSMOption::Batch.
+    void batchReadTiles (BucketCache* cachePtr);
+
     // Access a line in a more optimized way.
     void accessLine (char* section, uInt pixelOffset,
 		     uInt localPixelSize,
@@ -395,9 +467,17 @@ protected:
     // Did the user set the cache size?
     Bool            userSetCache_p;
     // Was the last column access to a cell, slice, or column?
-    AccessType      lastColAccess_p;
+    // It is atomic, because a cube can be accessed by multiple threads
+    // if a thread-safe cache is used.
+    std::atomic<AccessType> lastColAccess_p;
     // The slice shape of the last column access to a slice.
     IPosition       lastColSlice_p;
+    // Mutex guarding the last column access info and cache sizing.
+    std::mutex      lastColMutex_p;
+    // The start of the last section read (used to predict the next one).
+    IPosition       prefetchStart_p;
+    // The first tile of the last section for which tiles were read ahead.
+    IPosition       prefetchTile_p;
 
     // IPosition variables used in accessSection(); declared here
     // as member variables to avoid significant construction and
@@ -453,6 +533,10 @@ inline Bool TSMCube::userSetCache() const
 {
     return userSetCache_p;
 }
+inline std::mutex& TSMCube::lastColMutex()
+{
+    return lastColMutex_p;
+}
 inline TSMCube::AccessType TSMCube::getLastColAccess() const
 {
     return lastColAccess_p;
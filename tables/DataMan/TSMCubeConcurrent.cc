@@ -0,0 +1,331 @@
+//# TSMCubeConcurrent.cc: Tiled hypercube in a table using a thread-safe cache
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/DataMan/TSMCubeConcurrent.h>
+#include <casacore/tables/DataMan/TiledStMan.h>
+#include <casacore/tables/DataMan/TSMFile.h>
+#include <casacore/tables/DataMan/TSMColumn.h>
+#include <casacore/tables/DataMan/DataManError.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/IO/ConcurrentBucketCache.h>
+#include <casacore/casa/string.h>                           // for memcpy
+#include <casacore/casa/iostream.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+
+TSMCubeConcurrent::TSMCubeConcurrent (TiledStMan* stman, TSMFile* file,
+                                      const IPosition& cubeShape,
+                                      const IPosition& tileShape,
+                                      const Record& values,
+                                      Int64 fileOffset)
+  : TSMCube (stman, file, cubeShape, tileShape, values, fileOffset, True),
+    cache_p (0)
+{
+  // Note that the TSMCube constructor can call setShape.
+  // However, because it is in the constructor TSMCube's setShape is called.
+  // Hence we have to make the cache here.
+  if (fileOffset < 0  &&  nrTiles_p > 0) {
+    makeCache();
+  }
+}
+
+TSMCubeConcurrent::TSMCubeConcurrent (TiledStMan* stman, AipsIO& ios)
+  : TSMCube (stman, ios, True),
+    cache_p (0)
+{}
+
+TSMCubeConcurrent::~TSMCubeConcurrent()
+{
+    delete cache_p;
+}
+
+void TSMCubeConcurrent::clearCache (Bool doFlush)
+{
+    if (doFlush) {
+        flushCache();
+    }
+    if (cache_p != 0) {
+        cache_p.load()->clear (False);
+    }
+}
+
+void TSMCubeConcurrent::emptyCache()
+{
+    if (cache_p != 0) {
+        cache_p.load()->clear (True);
+        cache_p.load()->resize (0);
+    }
+    userSetCache_p = False;
+    lastColAccess_p = NoAccess;
+}
+
+void TSMCubeConcurrent::showCacheStatistics (ostream& os) const
+{
+    if (cache_p != 0) {
+        os << ">>> TSMCube cache statistics (thread-safe):" << endl;
+        os << "cubeShape: " << cubeShape_p << endl;
+        os << "tileShape: " << tileShape_p << endl;
+        os << "maxCacheSz:" << stmanPtr_p->maximumCacheSize() << " MiB" << endl;
+        cache_p.load()->showStatistics (os);
+        os << "<<<" << endl;
+    }
+}
+
+
+void TSMCubeConcurrent::makeCache()
+{
+    // If there is no cache, make one with initially 1 slot per shard.
+    // Lock, because multiple threads might try to make it.
+    std::lock_guard<std::mutex> lock(cacheMutex_p);
+    if (cache_p == 0) {
+        cache_p = new ConcurrentBucketCache (filePtr_p->bucketFile(),
+                                             fileOffset_p, bucketSize_p,
+                                             nrTiles_p, 1, this,
+                                             readCallBack, writeCallBack,
+                                             initCallBack, deleteCallBack,
+                                             stmanPtr_p->tsmOption().nrShards());
+    }
+}
+
+void TSMCubeConcurrent::flushCache()
+{
+    if (cache_p != 0) {
+        cache_p.load()->flush();
+    }
+}
+
+void TSMCubeConcurrent::resyncCache()
+{
+    if (cache_p != 0) {
+        cache_p.load()->resync (nrTiles_p);
+    }
+}
+
+void TSMCubeConcurrent::deleteCache()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_p);
+    delete cache_p;
+    cache_p = 0;
+}
+
+void TSMCubeConcurrent::setShape (const IPosition& cubeShape,
+                                  const IPosition& tileShape)
+{
+    TSMCube::setShape (cubeShape, tileShape);
+    makeCache();
+}
+
+void TSMCubeConcurrent::extend (uInt64 nr, const Record& coordValues,
+                                const TSMColumn* lastCoordColumn)
+{
+    if (!extensible_p) {
+      throw TSMError ("Hypercube in TSM " + stmanPtr_p->dataManagerName() +
+                      " is not extensible");
+    }
+    // Make the cache here, otherwise nrTiles_p is too high.
+    makeCache();
+    uInt lastDim = nrdim_p - 1;
+    uInt nrold = nrTiles_p;
+    cubeShape_p(lastDim) += nr;
+    tilesPerDim_p(lastDim) = (cubeShape_p(lastDim) + tileShape_p(lastDim) - 1)
+                             / tileShape_p(lastDim);
+    nrTiles_p = nrTilesSubCube_p * tilesPerDim_p(lastDim);
+    getCache()->extend (nrTiles_p - nrold);
+    filePtr_p->extend ((nrTiles_p - nrold) * bucketSize_p);
+    // Update the last coordinate (if there).
+    if (lastCoordColumn != 0) {
+        extendCoordinates (coordValues, lastCoordColumn->columnName(),
+                           cubeShape_p(lastDim));
+    }
+}
+
+
+char* TSMCubeConcurrent::readCallBack (void* owner, const char* external)
+{
+    TSMCubeConcurrent* cube = static_cast<TSMCubeConcurrent*>(owner);
+    char* local = new char[cube->localTileLength_p];
+    cube->stmanPtr_p->readTile (local, cube->localOffset_p,
+                                external, cube->externalOffset_p,
+                                cube->tileSize_p);
+    return local;
+}
+void TSMCubeConcurrent::writeCallBack (void* owner, char* external,
+                                       const char* local)
+{
+    TSMCubeConcurrent* cube = static_cast<TSMCubeConcurrent*>(owner);
+    cube->stmanPtr_p->writeTile (external, cube->externalOffset_p,
+                                 local, cube->localOffset_p,
+                                 cube->tileSize_p);
+}
+char* TSMCubeConcurrent::initCallBack (void* owner)
+{
+    uInt64 size = static_cast<TSMCubeConcurrent*>(owner)->localTileLength();
+    char* buffer = new char[size];
+    memset (buffer, 0, size);
+    return buffer;
+}
+void TSMCubeConcurrent::deleteCallBack (void*, char* buffer)
+{
+    delete [] buffer;
+}
+
+
+uInt TSMCubeConcurrent::cacheSize() const
+{
+    if (cache_p == 0) {
+        return 0;
+    }
+    return cache_p.load()->cacheSize();
+}
+
+void TSMCubeConcurrent::setCacheSize (uInt cacheSize, Bool forceSmaller,
+                                      Bool userSet)
+{
+    // Resize the cache in the expectation that this access is
+    // the first of a bunch of accesses at the same tiles.
+    // However, don't let the cache exceed the maximum,
+    // unless it is only 10% more.
+    ConcurrentBucketCache* cachePtr = getCache();
+    cacheSize = validateCacheSize (cacheSize);
+    if (forceSmaller  ||  cacheSize > cachePtr->cacheSize()) {
+        cachePtr->resize (cacheSize);
+    }
+    userSetCache_p = userSet;
+}
+
+
+void TSMCubeConcurrent::accessSection (const IPosition& start,
+                                       const IPosition& end,
+                                       char* section, uInt colnr,
+                                       uInt localPixelSize, uInt,
+                                       Bool writeFlag)
+{
+    // Set flag if writing.
+    if (writeFlag) {
+        stmanPtr_p->setDataChanged();
+    }
+    // Determine the tiles needed and the first and last pixel in them.
+    // Unlike TSMCube, local variables are used to be thread-safe.
+    // Also determine if the slice happens to be an entire tile.
+    IPosition nrTileSection (nrdim_p);
+    IPosition startTile (nrdim_p);
+    IPosition endTile (nrdim_p);
+    IPosition startPixelInFirstTile (nrdim_p);
+    IPosition endPixelInFirstTile (nrdim_p);
+    IPosition endPixelInLastTile (nrdim_p);
+    Bool oneEntireTile = findSectionTiles (start, end, nrTileSection,
+                                           startTile, endTile,
+                                           startPixelInFirstTile,
+                                           endPixelInFirstTile,
+                                           endPixelInLastTile);
+    // Get the cache.
+    ConcurrentBucketCache* cachePtr = getCache();
+    // A tile can contain more than one data array.
+    // Each array is contiguous, so the first pixel of an array
+    // starts after the other arrays.
+    uInt pixelOffset = localOffset_p[colnr];
+
+    // If the section matches the tile shape, we can simply
+    // copy all values and do not have to do difficult iterations.
+    if (oneEntireTile) {
+        uInt tileNr = expandedTilesPerDim_p.offset (startTile);
+        PinnedBucket tile = cachePtr->getBucket (tileNr);
+        char* dataArray = tile.data();
+        if (writeFlag) {
+            memcpy (dataArray+pixelOffset, section,
+                    tileSize_p * localPixelSize);
+            tile.setDirty();
+        }else{
+            memcpy (section, dataArray+pixelOffset,
+                    tileSize_p * localPixelSize);
+        }
+        return;
+    }
+
+    // Loop through all tiles. The tile in use is pinned in the cache
+    // until the next one is acquired. Set it to dirty if we are writing.
+    PinnedBucket tile;
+    accessTiles (start, end, section, pixelOffset, localPixelSize, writeFlag,
+                 nrTileSection, startTile, endTile,
+                 startPixelInFirstTile, endPixelInFirstTile,
+                 endPixelInLastTile,
+                 [cachePtr, writeFlag, &tile] (uInt tileNr) {
+                     tile = cachePtr->getBucket (tileNr);
+                     if (writeFlag) {
+                         tile.setDirty();
+                     }
+                     return tile.data();
+                 });
+}
+
+void TSMCubeConcurrent::accessStrided (const IPosition& start,
+                                       const IPosition& end,
+                                       const IPosition& stride,
+                                       char* section, uInt colnr,
+                                       uInt localPixelSize,
+                                       uInt externalPixelSize,
+                                       Bool writeFlag)
+{
+  // If no strides, use accessSection.
+  if (stride.allOne()) {
+    accessSection (start, end, section, colnr,
+                   localPixelSize, externalPixelSize, writeFlag);
+    return;
+  }
+  // Get the data by getting the array part and stride it thereafter
+  // (as done in TSMCubeMMap). When writing it is the opposite.
+  // Handle the arrays as chars to be type-agnostic, so add an axis for it.
+  IPosition sectShape ((end - start + stride) / stride);
+  IPosition fullShape (end - start + 1);
+  IPosition incr(stride);
+  if (localPixelSize != 1) {
+    sectShape.prepend (IPosition(1, localPixelSize));
+    fullShape.prepend (IPosition(1, localPixelSize));
+    incr.prepend (IPosition(1,1));
+  }
+  IPosition fst(incr.size(), 0);
+  IPosition fend(fullShape - 1);
+  Array<char> fullArr(fullShape);
+  Array<char> partArr = fullArr(fst, fend, incr);
+  Array<char> sectArr(sectShape, section, SHARE);
+  accessSection (start, end, fullArr.data(), colnr,
+                 localPixelSize, externalPixelSize, False);
+  if (writeFlag) {
+    partArr = sectArr;
+    accessSection (start, end, fullArr.data(), colnr,
+                   localPixelSize, externalPixelSize, True);
+  } else {
+    sectArr = partArr;
+  }
+}
+
+
+} //# NAMESPACE CASACORE - END
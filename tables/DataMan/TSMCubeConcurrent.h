@@ -0,0 +1,211 @@
+//# TSMCubeConcurrent.h: Tiled hypercube in a table using a thread-safe cache
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_TSMCUBECONCURRENT_H
+#define TABLES_TSMCUBECONCURRENT_H
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/DataMan/TSMCube.h>
+#include <atomic>
+#include <mutex>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward declarations
+class ConcurrentBucketCache;
+
+// <summary>
+// Tiled hypercube in a table using a thread-safe cache
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tTiledColumnStMan">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class=TSMCube>TSMCube</linkto>
+//   <li> <linkto class=ConcurrentBucketCache>ConcurrentBucketCache</linkto>
+// </prerequisite>
+
+// <etymology>
+// TSMCubeConcurrent represents a hypercube in the Tiled Storage Manager
+// that can be read by multiple threads concurrently.
+// </etymology>
+
+// <synopsis>
+// TSMCubeConcurrent defines a tiled hypercube like
+// <linkto class=TSMCube>TSMCube</linkto>, but the tiles are accessed
+// using a <linkto class=ConcurrentBucketCache>ConcurrentBucketCache</linkto>
+// object. The tiles are held in the cache in local format.
+// <br>
+// Unlike TSMCube, the access functions do not use member variables
+// for the iteration through the tiles, so multiple threads can access
+// the hypercube at the same time. Each thread pins the tile it is using,
+// so it cannot be removed from the cache by another thread. Note that it
+// is the responsibility of the caller that threads do not write the same
+// part of the hypercube. Read-ahead of tiles (see TSMOption) is not done,
+// because concurrent reads give parallel I/O already.
+// <p>
+// A TSMCubeConcurrent object is used if TSMOption::Cache is in use and the
+// TSMOption gives a positive number of shards for the cache.
+// </synopsis>
+
+// <motivation>
+// Multiple threads reading the same data column should not need to open
+// the table multiple times.
+// </motivation>
+
+
+class TSMCubeConcurrent: public TSMCube
+{
+public:
+    // Construct the hypercube using the given file with the given shape.
+    // The record contains the id and possible coordinate values.
+    // <br>If the cubeshape is empty, the hypercube is still undefined and
+    // can be added later with setShape. That is only used by TiledCellStMan.
+    // <br> The fileOffset argument is meant for class TiledFileAccess.
+    TSMCubeConcurrent (TiledStMan* stman, TSMFile* file,
+                       const IPosition& cubeShape,
+                       const IPosition& tileShape,
+                       const Record& values,
+                       Int64 fileOffset);
+
+    // Reconstruct the hypercube by reading its data from the AipsIO stream.
+    // It will link itself to the correct TSMFile. The TSMFile objects
+    // must have been reconstructed in advance.
+    TSMCubeConcurrent (TiledStMan* stman, AipsIO& ios);
+
+    virtual ~TSMCubeConcurrent();
+
+    // Forbid copy constructor.
+    TSMCubeConcurrent (const TSMCubeConcurrent&) = delete;
+
+    // Forbid assignment.
+    TSMCubeConcurrent& operator= (const TSMCubeConcurrent&) = delete;
+
+    // Flush the data in the cache.
+    virtual void flushCache();
+
+    // Clear the cache, so data will be reread.
+    // If wanted, the data is flushed before the cache is cleared.
+    virtual void clearCache (Bool doFlush = True);
+
+    // Empty the cache.
+    virtual void emptyCache();
+
+    // Show the cache statistics.
+    virtual void showCacheStatistics (ostream& os) const;
+
+    // Set the hypercube shape.
+    // This is only possible if the shape was not defined yet.
+    virtual void setShape (const IPosition& cubeShape,
+                           const IPosition& tileShape);
+
+    // Extend the last dimension of the cube with the given number.
+    // The record can contain the coordinates of the elements added.
+    virtual void extend (uInt64 nr, const Record& coordValues,
+                         const TSMColumn* lastCoordColumn);
+
+    // Read or write a section in the cube.
+    // It is assumed that the section buffer is long enough.
+    virtual void accessSection (const IPosition& start, const IPosition& end,
+                                char* section, uInt colnr,
+                                uInt localPixelSize, uInt externalPixelSize,
+                                Bool writeFlag);
+
+    // Read or write a section in a strided way.
+    // It is assumed that the section buffer is long enough.
+    virtual void accessStrided (const IPosition& start, const IPosition& end,
+                                const IPosition& stride,
+                                char* section, uInt colnr,
+                                uInt localPixelSize, uInt externalPixelSize,
+                                Bool writeFlag);
+
+    // Get the current cache size (in buckets).
+    virtual uInt cacheSize() const;
+
+    // Resize the cache object.
+    // If forceSmaller is False, the cache will only be resized when it grows.
+    // If the given size exceeds the maximum size with more
+    // than 10%, the maximum size will be used.
+    // The cacheSize has to be given in buckets.
+    virtual void setCacheSize (uInt cacheSize, Bool forceSmaller, Bool userSet);
+
+    // The cache size for a given slice and access path is determined
+    // as in TSMCube.
+    using TSMCube::setCacheSize;
+
+private:
+    // Get the cache object.
+    // This will construct the cache object if not present yet.
+    ConcurrentBucketCache* getCache();
+
+    // Construct the cache object (if not constructed yet).
+    virtual void makeCache();
+
+    // Resync the cache object.
+    virtual void resyncCache();
+
+    // Delete the cache object.
+    virtual void deleteCache();
+
+    // Define the callback functions for the ConcurrentBucketCache.
+    // Unlike the TSMCube ones, they do not reuse a tile buffer, because
+    // they can be called by multiple threads.
+    // <group>
+    static char* readCallBack (void* owner, const char* external);
+    static void writeCallBack (void* owner, char* external,
+                               const char* local);
+    static char* initCallBack (void* owner);
+    static void deleteCallBack (void* owner, char* buffer);
+    // </group>
+
+    //# Declare member variables.
+    // The bucket cache.
+    std::atomic<ConcurrentBucketCache*> cache_p;
+    // The lock to make the cache only once.
+    std::mutex cacheMutex_p;
+};
+
+
+
+inline ConcurrentBucketCache* TSMCubeConcurrent::getCache()
+{
+    ConcurrentBucketCache* cache = cache_p;
+    if (cache == 0) {
+        makeCache();
+        cache = cache_p;
+    }
+    return cache;
+}
+
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -402,6 +402,12 @@ void TSMCubeMMap::accessSection (const IPosition& start, const IPosition& end,
   }
 }
 
+const char* TSMCubeMMap::getTileData (const IPosition& tilePos, uInt colnr)
+{
+  uInt tileNr = expandedTilesPerDim_p.offset (tilePos);
+  return getCache()->getBucket (tileNr) + externalOffset_p[colnr];
+}
+
 void TSMCubeMMap::accessStrided (const IPosition& start, const IPosition& end,
                                  const IPosition& stride,
                                  char* section, uInt colnr,
@@ -150,6 +150,11 @@ public:
                                 uInt localPixelSize, uInt externalPixelSize,
                                 Bool writeFlag);
 
+    // Get a read-only pointer to the data of the given column in the tile
+    // at the given tile position. It points into the memory-mapped file,
+    // so it is only valid until the cube is extended or closed.
+    virtual const char* getTileData (const IPosition& tilePos, uInt colnr);
+
     // Set the cache size for the given slice and access path.
     virtual void setCacheSize (const IPosition& sliceShape,
                                const IPosition& windowStart,
@@ -37,6 +37,9 @@
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/string.h>
 #include <casacore/casa/iostream.h>
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -84,6 +87,26 @@ Bool TSMDataColumn::canChangeShape() const
     return stmanPtr_p->canChangeShape();
 }
 
+Bool TSMDataColumn::canAccessConcurrently() const
+{
+    return stmanPtr_p->canAccessConcurrently();
+}
+
+rownr_t TSMDataColumn::rowChunkSize() const
+{
+    // Only hypercubes with the rows mapped to a single axis can be used.
+    if (stmanPtr_p->nrow() == 0) {
+	return 1;
+    }
+    IPosition rowpos;
+    const TSMCube* hypercube = stmanPtr_p->getHypercube (0, rowpos);
+    uInt nrdim = hypercube->tileShape().nelements();
+    if (nrdim != stmanPtr_p->nrCoordVector() + 1) {
+	return 1;
+    }
+    return hypercube->tileShape()(nrdim-1);
+}
+
 void TSMDataColumn::setShape (rownr_t rownr, const IPosition& shape)
 {
     setShapeTiled (rownr, shape, stmanPtr_p->defaultTileShape());
@@ -171,8 +194,11 @@ void TSMDataColumn::accessCell (rownr_t rownr, const void* dataPtr,
     }
     // Size the cache if the user has not done it and if the
     // last access was not to a cell.
+    // Lock, because the cube can be accessed by multiple threads.
     if (hypercube->getLastColAccess() != TSMCube::CellAccess) {
-	if (! stmanPtr_p->userSetCache (rownr)) {
+        std::lock_guard<std::mutex> lock(hypercube->lastColMutex());
+	if (hypercube->getLastColAccess() != TSMCube::CellAccess
+        &&  ! stmanPtr_p->userSetCache (rownr)) {
 	    hypercube->setCacheSize (1 + end - start, IPosition(),
 				     IPosition(), IPosition(), True, False);
 	    hypercube->setLastColAccess (TSMCube::CellAccess);
@@ -202,6 +228,8 @@ void TSMDataColumn::accessCellSlice (rownr_t rownr, const Slicer& ns,
     }
     // Size the cache if the user has not done it
     // and if the access type or slice shape differs.
+    // Lock, because the cube can be accessed by multiple threads.
+    std::unique_lock<std::mutex> lock(hypercube->lastColMutex());
     if (hypercube->getLastColAccess() != TSMCube::SliceAccess
     ||  ! slice.isEqual (hypercube->getLastColSlice())) {
 	if (! stmanPtr_p->userSetCache (rownr)) {
@@ -221,6 +249,7 @@ void TSMDataColumn::accessCellSlice (rownr_t rownr, const Slicer& ns,
 	    hypercube->setLastColSlice (slice);
 	}
     }
+    lock.unlock();
     hypercube->accessStrided (start, end, stride,
 			      (char*)dataPtr, colnr_p,
 			      localPixelSize_p, tilePixelSize_p, writeFlag);
@@ -234,10 +263,13 @@ void TSMDataColumn::accessColumn (const void* dataPtr, Bool writeFlag)
     end -= 1;
     IPosition start (end.nelements(), 0);
     // Size the cache if the user has not done it.
-    if (! stmanPtr_p->userSetCache (0)) {
-	hypercube->setCacheSize (end + 1, IPosition(),
-				 IPosition(), IPosition(), True, False);
-	hypercube->setLastColAccess (TSMCube::ColumnAccess);
+    {
+        std::lock_guard<std::mutex> lock(hypercube->lastColMutex());
+        if (! stmanPtr_p->userSetCache (0)) {
+            hypercube->setCacheSize (end + 1, IPosition(),
+                                     IPosition(), IPosition(), True, False);
+            hypercube->setLastColAccess (TSMCube::ColumnAccess);
+        }
     }
     hypercube->accessSection (start, end, (char*)dataPtr, colnr_p,
 			      localPixelSize_p, tilePixelSize_p, writeFlag);
@@ -266,6 +298,8 @@ void TSMDataColumn::accessColumnSlice (const Slicer& ns,
     }
     // Size the cache if the user has not done it
     // and if the access type or slice shape differs.
+    // Lock, because the cube can be accessed by multiple threads.
+    std::unique_lock<std::mutex> lock(hypercube->lastColMutex());
     if (hypercube->getLastColAccess() != TSMCube::ColumnSliceAccess
     ||  ! slice.isEqual (hypercube->getLastColSlice())) {
 	if (! stmanPtr_p->userSetCache (0)) {
@@ -289,6 +323,7 @@ void TSMDataColumn::accessColumnSlice (const Slicer& ns,
 	    hypercube->setLastColSlice (slice);
 	}
     }
+    lock.unlock();
     hypercube->accessStrided (start, end, stride,
 			      (char*)dataPtr, colnr_p,
 			      localPixelSize_p, tilePixelSize_p, writeFlag);
@@ -460,11 +495,15 @@ void TSMDataColumn::accessFullCells (TSMCube* hypercube,
 {
   //  cout << "accessFullCells " << start << end << incr << endl;
   // Size the cache if the user has not done it.
-  if (! stmanPtr_p->userSetCache (0)) {
-    if (hypercube->getLastColAccess() != TSMCube::ColumnAccess) {
-      hypercube->setCacheSize (hypercube->cubeShape(), IPosition(),
-			       IPosition(), IPosition(), True, False);
-      hypercube->setLastColAccess (TSMCube::ColumnAccess);
+  // Lock, because the cells can be accessed by multiple threads.
+  {
+    std::lock_guard<std::mutex> lock(hypercube->lastColMutex());
+    if (! stmanPtr_p->userSetCache (0)) {
+      if (hypercube->getLastColAccess() != TSMCube::ColumnAccess) {
+        hypercube->setCacheSize (hypercube->cubeShape(), IPosition(),
+                                 IPosition(), IPosition(), True, False);
+        hypercube->setLastColAccess (TSMCube::ColumnAccess);
+      }
     }
   }
   hypercube->accessStrided (start, end, incr, dataPtr, colnr_p,
@@ -492,6 +531,8 @@ void TSMDataColumn::accessSlicedCells (TSMCube* hypercube,
       sliceShp(i) = 1 + end(i) - start(i);
     }
     // Set only if a different slice is accessed.
+    // Lock, because the cells can be accessed by multiple threads.
+    std::lock_guard<std::mutex> lock(hypercube->lastColMutex());
     if (hypercube->getLastColAccess() != TSMCube::ColumnSliceAccess
     ||  ! sliceShp.isEqual (hypercube->getLastColSlice())) {
       // The further access path is along the trailing axes.
@@ -553,6 +594,52 @@ void TSMDataColumn::putSliceV (rownr_t rownr, const Slicer& ns,
     dataPtr.freeVStorage (data, deleteIt);
 }
 
+Bool TSMDataColumn::getArrayViewV (rownr_t rownr, const Slicer* slicer,
+                                    const void*& data, IPosition& blockShape,
+                                    Slicer& section)
+{
+    // The tile data can only be used if no conversion is needed.
+    if (mustConvert_p  ||  tilePixelSize_p != localPixelSize_p) {
+        return False;
+    }
+    IPosition end;
+    TSMCube* hypercube = stmanPtr_p->getHypercube (rownr, end);
+    IPosition start (end);
+    IPosition stride (end.nelements(), 1);
+    if (slicer == 0) {
+        for (uInt i=0; i<stmanPtr_p->nrCoordVector(); i++) {
+            start(i) = 0;
+            end(i)--;
+        }
+    } else {
+        IPosition blc, trc, inc;
+        slicer->inferShapeFromSource (shape(rownr), blc, trc, inc);
+        for (uInt i=0; i<stmanPtr_p->nrCoordVector(); i++) {
+            start(i)  = blc(i);
+            end(i)    = trc(i);
+            stride(i) = inc(i);
+        }
+    }
+    // The cell (slice) must be contained in a single tile.
+    const IPosition& tileShape = hypercube->tileShape();
+    IPosition tilePos (start / tileShape);
+    if (! (start <= end)  ||  ! tilePos.isEqual (end / tileShape)) {
+        return False;
+    }
+    const char* tileData = hypercube->getTileData (tilePos, colnr_p);
+    if (tileData == 0  ||
+        reinterpret_cast<std::uintptr_t>(tileData) %
+        std::min(localPixelSize_p, 8u) != 0) {
+        return False;
+    }
+    IPosition tileStart (tilePos * tileShape);
+    data       = tileData;
+    blockShape = tileShape;
+    section    = Slicer (start - tileStart, end - tileStart, stride,
+                         Slicer::endIsLast);
+    return True;
+}
+
 void TSMDataColumn::getArrayColumnV (ArrayBase& dataPtr)
 {
   if (! stmanPtr_p->canAccessColumn()) {
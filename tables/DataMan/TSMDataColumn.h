@@ -123,6 +123,13 @@ public:
     // parent tiled storage manager can handle it.
     Bool canChangeShape() const;
 
+    // The column can be read concurrently if the storage manager allows it.
+    virtual Bool canAccessConcurrently() const;
+
+    // Get the number of rows in a tile, so concurrent reads of a column
+    // do not need the same tiles.
+    virtual rownr_t rowChunkSize() const;
+
     // Set the shape of the data array in the given row.
     // It will check if it matches already defined data and coordinates shapes.
     // It will define undefined data and coordinates shapes.
@@ -201,6 +208,14 @@ public:
     virtual void putSliceV (rownr_t rownr, const Slicer& slicer,
                     const ArrayBase& data);
 
+    // Get a read-only view of the array (or a slice of it) in the given row.
+    // It is only possible if the hypercube is memory-mapped (see
+    // <linkto class=TSMCubeMMap>TSMCubeMMap</linkto>), the data are stored
+    // in local byte order, and the cell (slice) is contained in a single tile.
+    virtual Bool getArrayViewV (rownr_t rownr, const Slicer* slicer,
+                                const void*& data, IPosition& blockShape,
+                                Slicer& section);
+
     // Get all array values in the column.
     // The array given in <src>data</src> has to have the correct shape
     // (which is guaranteed by the ArrayColumn getColumn function).
@@ -52,6 +52,8 @@ TSMFile::TSMFile (const TiledStMan* stman, uInt fileSequenceNr,
       bufSize = tsmOpt.bufferSize();
     }
     file_p = new BucketFile (fileName, bufSize, mapOpt, mfile);
+    file_p->setDirectRead (tsmOpt.option() == TSMOption::Batch  &&
+                           tsmOpt.useODirect());
 }
 
 TSMFile::TSMFile (const String& fileName, Bool writable,
@@ -68,6 +70,8 @@ TSMFile::TSMFile (const String& fileName, Bool writable,
       bufSize = tsmOpt.bufferSize();
     }
     file_p = new BucketFile (fileName, writable, bufSize, mapOpt, mfile);
+    file_p->setDirectRead (tsmOpt.option() == TSMOption::Batch  &&
+                           tsmOpt.useODirect());
 }
 
 TSMFile::TSMFile (const TiledStMan* stman, AipsIO& ios, uInt seqnr,
@@ -90,6 +94,8 @@ TSMFile::TSMFile (const TiledStMan* stman, AipsIO& ios, uInt seqnr,
     }
     file_p = new BucketFile (fileName, stman->table().isWritable(),
                              bufSize, mapOpt, mfile);
+    file_p->setDirectRead (tsmOpt.option() == TSMOption::Batch  &&
+                           tsmOpt.useODirect());
 }
 
 TSMFile::~TSMFile()
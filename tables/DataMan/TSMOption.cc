@@ -29,10 +29,18 @@
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
   TSMOption::TSMOption (TSMOption::Option option, Int bufferSize,
-                        Int maxCacheSizeMB)
+                        Int maxCacheSizeMB, Int prefetchSize,
+                        Int nrShards, Int useODirect,
+                        Int writeBehindSize, Int syncSizeMB)
     : itsOption       (option),
       itsBufferSize   (bufferSize),
-      itsMaxCacheSize (maxCacheSizeMB)
+      itsMaxCacheSize (maxCacheSizeMB),
+      itsPrefetchSize (prefetchSize),
+      itsNrShards     (nrShards),
+      itsUseODirect   (useODirect>0),
+      itsUseAipsrcODirect (useODirect<0),
+      itsWriteBehindSize (writeBehindSize),
+      itsSyncSizeMB   (syncSizeMB)
   {}
 
   void TSMOption::fillOption (Bool newTable)
@@ -46,6 +54,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
         itsOption = TSMOption::MMap;
       } else if (opt == "cache") {
         itsOption = TSMOption::Cache;
+      } else if (opt == "batch") {
+        itsOption = TSMOption::Batch;
         ///      } else if (opt == "buffer") {
         ///        itsOption = TSMOption::Buffer;
       } else if (opt == "default32") {
@@ -65,6 +75,27 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     if (itsMaxCacheSize <= -2) {
       AipsrcValue<Int>::find (itsMaxCacheSize, "table.tsm.maxcachesizemb", -1);
     }
+    // Default is no read-ahead.
+    if (itsPrefetchSize <= -2) {
+      AipsrcValue<Int>::find (itsPrefetchSize, "table.tsm.prefetch", 0);
+    }
+    // Default is the normal (not thread-safe) cache.
+    if (itsNrShards <= -2) {
+      AipsrcValue<Int>::find (itsNrShards, "table.tsm.nrshards", 0);
+    }
+    // Default O_DIRECT support is False.
+    if (itsUseAipsrcODirect) {
+      AipsrcValue<Bool>::find (itsUseODirect, "table.tsm.odirect", False);
+      itsUseAipsrcODirect = False;
+    }
+    // Default is no write-behind.
+    if (itsWriteBehindSize <= -2) {
+      AipsrcValue<Int>::find (itsWriteBehindSize, "table.tsm.writebehind", 0);
+    }
+    // Default is no fsync by the write-behind thread.
+    if (itsSyncSizeMB <= -2) {
+      AipsrcValue<Int>::find (itsSyncSizeMB, "table.tsm.syncmb", 0);
+    }
     // Default is to use the old caching behaviour
     // Abandoned default to use mmap for existing files on 64 bit systems.
     if (itsOption == TSMOption::Default) {
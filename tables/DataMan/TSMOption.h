@@ -83,7 +83,32 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //       otherwise Buffer.
 //  <li> <src>TSMOption::Aipsrc</src>
 //       Use the option as defined in the aipsrc file.
+//  <li> <src>TSMOption::Batch</src>
+//       Like <src>TSMOption::Cache</src>, but the tiles needed by an access
+//       that are not in the cache are read in a single batch. Adjacent
+//       tiles in the file are combined in a vectored read, so far fewer
+//       system calls are done than reading tile by tile.
+//       It can be told that these reads should use O_DIRECT (if supported),
+//       which is meant for huge sequential scans that should not pollute
+//       the kernel's file cache.
 // </ul>
+// For option <src>TSMOption::Cache</src> it is possible to read tiles
+// ahead asynchronously. The tiles needed by the next access are predicted
+// from the last accesses (e.g., stepping row by row through a column) and
+// read in a background thread, so disk latency overlaps with computation.
+// The maximum number of tiles being read ahead can be given as a
+// constructor argument. A value 0 means no read-ahead.
+// <br>For options <src>TSMOption::Cache</src> and <src>TSMOption::Batch</src>
+// it is also possible to write tiles behind. A changed tile that has to
+// leave the cache is then written by a background thread, so a process
+// filling a column does not have to wait for the disk. The maximum number
+// of tiles waiting to be written can be given as a constructor argument;
+// only when that number is reached, writing a tile waits. A value 0 means
+// no write-behind. Furthermore it can be given after how many MibiBytes
+// written the background thread does an fsync. That avoids that a huge
+// amount of data has to be written at the next explicit fsync (e.g., when
+// the table is closed). A value 0 means no fsync by the background thread.
+// Write-behind is not possible when the table is stored in a MultiFile.
 // The aipsrc variables are:
 // <ul>
 //  <li> <src>table.tsm.option</src> gives the option as the case-insensitive
@@ -94,6 +119,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //    <li> <src>mmapold</src> (or <src>mapold</src>) means TSMMap for existing
 //         tables and TSMDefault for new tables.
 //    <li> <src>buffer</src> means TSMBuffer.
+//    <li> <src>batch</src> means TSMBatch.
 //    <li> <src>default</src> means TSMDefault.
 //   </ul>
 //       It defaults to value <src>default</src>.
@@ -107,6 +133,25 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //  <li> <src>table.tsm.buffersize</src> gives the buffer size for option
 //       <src>TSMOption::Buffer</src>. A value <=0 means use the default 4096.
 //       It defaults to 0.
+//  <li> <src>table.tsm.prefetch</src> gives the maximum number of tiles
+//       to read ahead for option <src>TSMOption::Cache</src>.
+//       A value <=0 means no read-ahead. It defaults to 0.
+//  <li> <src>table.tsm.nrshards</src> gives the number of shards (lock
+//       stripes) of the thread-safe cache (class ConcurrentBucketCache)
+//       for option <src>TSMOption::Cache</src>. Such a cache makes it
+//       possible for multiple threads to read the same column concurrently.
+//       A value <=0 means the normal (not thread-safe) cache is used.
+//       It defaults to 0.
+//  <li> <src>table.tsm.odirect</src> tells if the batched reads of option
+//       <src>TSMOption::Batch</src> should use O_DIRECT.
+//       It defaults to False.
+//  <li> <src>table.tsm.writebehind</src> gives the maximum number of tiles
+//       waiting to be written behind for options <src>TSMOption::Cache</src>
+//       and <src>TSMOption::Batch</src>.
+//       A value <=0 means no write-behind. It defaults to 0.
+//  <li> <src>table.tsm.syncmb</src> gives the number of MibiBytes written
+//       behind after which the file is fsync-ed.
+//       A value <=0 means no fsync. It defaults to 0.
 // </ul>
 // </synopsis>
 
@@ -125,7 +170,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       // Use default.
       Default,
       // Use as defined in the aipsrc file.
-      Aipsrc
+      Aipsrc,
+      // Use unbuffered file IO with internal TSM caching and batched
+      // reading of the tiles needed by an access.
+      Batch
     };
 
     // Create an option object.
@@ -133,8 +181,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // A size value -2 means reading that size from the aipsrc file.
     // The buffer size has to be given in bytes.
     // The maximum cache size has to be given in MibiBytes (1024*1024 bytes).
+    // The prefetch size has to be given in tiles.
+    // <br>useODirect<0 means reading the O_DIRECT option from the aipsrc file.
+    // <br>The write-behind size has to be given in tiles, the sync interval
+    // in MibiBytes.
     TSMOption (Option option=Aipsrc, Int bufferSize=-2,
-               Int maxCacheSizeMB=-2);
+               Int maxCacheSizeMB=-2, Int prefetchSize=-2,
+               Int nrShards=-2, Int useODirect=-2,
+               Int writeBehindSize=-2, Int syncSizeMB=-2);
 
     // Fill the option in case Aipsrc or Default was given.
     // It is done as explained in the synopsis.
@@ -152,10 +206,39 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Int maxCacheSizeMB() const
       { return itsMaxCacheSize; }
 
+    // Get the maximum number of tiles to read ahead. <=0 means none.
+    Int prefetchSize() const
+      { return itsPrefetchSize; }
+
+    // Get the number of shards of the thread-safe cache.
+    // <=0 means that the normal cache is used.
+    Int nrShards() const
+      { return itsNrShards; }
+
+    // Should the batched reads of option Batch use O_DIRECT?
+    Bool useODirect() const
+      { return itsUseODirect; }
+
+    // Get the maximum number of tiles waiting to be written behind.
+    // <=0 means no write-behind.
+    Int writeBehindSize() const
+      { return itsWriteBehindSize; }
+
+    // Get the number of MibiBytes written behind after which the file
+    // is fsync-ed. <=0 means no fsync.
+    Int syncSizeMB() const
+      { return itsSyncSizeMB; }
+
   private:
     Option itsOption;
     Int    itsBufferSize;
     Int    itsMaxCacheSize;
+    Int    itsPrefetchSize;
+    Int    itsNrShards;
+    Bool   itsUseODirect;
+    Bool   itsUseAipsrcODirect;
+    Int    itsWriteBehindSize;
+    Int    itsSyncSizeMB;
   };
 
 } //# NAMESPACE CASACORE - END
@@ -98,6 +98,11 @@ Bool TiledColumnStMan::canAccessColumn () const
     return True;
 }
 
+Bool TiledColumnStMan::copyLayout (const TiledStMan& that)
+{
+    return (nrrow_p == that.nrow());
+}
+
 
 void TiledColumnStMan::create64 (rownr_t nrrow)
 {
@@ -189,6 +189,11 @@ public:
     // TiledColumnStMan can always access a column.
     virtual Bool canAccessColumn() const;
 
+    // The single hypercube is created when the table is created, so its
+    // layout only depends on the cell shape and number of rows.
+    // Thus it returns True if that storage manager has the same nr of rows.
+    virtual Bool copyLayout (const TiledStMan& that);
+
     // Get the type name of the data manager (i.e. TiledColumnStMan).
     virtual String dataManagerType() const;
 
@@ -116,6 +116,50 @@ Bool TiledShapeStMan::canAccessColumn() const
     return (nrUsedRowMap_p == 1  &&  rowMap_p[0] == nrrow_p-1);
 }
 
+Bool TiledShapeStMan::canAccessConcurrently() const
+{
+    return False;
+}
+
+
+Bool TiledShapeStMan::copyLayout (const TiledStMan& that)
+{
+    const TiledShapeStMan* other = dynamic_cast<const TiledShapeStMan*>(&that);
+    if (other == 0  ||  other->nrrow_p != nrrow_p) {
+        return False;
+    }
+    if (! sameRowMap (*other)) {
+        if (nrUsedRowMap_p > 0) {
+            return False;
+        }
+        // Define the cell shapes in row order.
+        rownr_t rownr = 0;
+        for (uInt i=0; i<other->nrUsedRowMap_p; ++i) {
+            const TSMCube* cube = other->cubeSet_p[other->cubeMap_p[i]];
+            for (; rownr<=other->rowMap_p[i]; ++rownr) {
+                if (other->cubeMap_p[i] > 0) {
+                    setShape (rownr, 0, cube->cellShape(), cube->tileShape());
+                }
+            }
+        }
+    }
+    return sameRowMap (*other);
+}
+
+Bool TiledShapeStMan::sameRowMap (const TiledShapeStMan& that) const
+{
+    if (nrUsedRowMap_p != that.nrUsedRowMap_p) {
+        return False;
+    }
+    for (uInt i=0; i<nrUsedRowMap_p; ++i) {
+        if (rowMap_p[i] != that.rowMap_p[i]
+        ||  cubeMap_p[i] != that.cubeMap_p[i]
+        ||  posMap_p[i] != that.posMap_p[i]) {
+            return False;
+        }
+    }
+    return True;
+}
 
 TSMCube* TiledShapeStMan::singleHypercube()
 {
@@ -221,6 +221,20 @@ public:
     // and the first one is empty.
     virtual Bool canAccessColumn() const;
 
+    // TiledShapeStMan cannot be read concurrently, because finding the
+    // hypercube of a row keeps track of the last hypercube used.
+    virtual Bool canAccessConcurrently() const;
+
+    // Give the hypercubes the same layout as in that storage manager
+    // (which must be a TiledShapeStMan with the same nr of rows).
+    // If not the same yet, the layout can only be copied if no cell shape
+    // has been defined yet. In that case the cell shapes are defined in
+    // row order with the cell and tile shapes of that storage manager.
+    // It returns False if the layouts are different thereafter, which
+    // is the case if the hypercubes in that storage manager were not
+    // filled in row order.
+    virtual Bool copyLayout (const TiledStMan& that);
+
     // Test if only one hypercube is used by this storage manager.
     // If not, throw an exception. Otherwise return the hypercube.
     virtual TSMCube* singleHypercube();
@@ -254,6 +268,10 @@ private:
     // It returns -1 when not found.
     Int findHypercube (const IPosition& shape);
 
+    // Test if that storage manager has the same mapping of rows to
+    // hypercubes.
+    Bool sameRowMap (const TiledShapeStMan& that) const;
+
     // Add a hypercube.
     // The number of rows in the table must be large enough to
     // accommodate this hypercube.
@@ -31,6 +31,7 @@
 #include <casacore/tables/DataMan/TSMCube.h>
 #include <casacore/tables/DataMan/TSMCubeMMap.h>
 #include <casacore/tables/DataMan/TSMCubeBuff.h>
+#include <casacore/tables/DataMan/TSMCubeConcurrent.h>
 #include <casacore/tables/DataMan/TSMFile.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/TableDesc.h>
@@ -360,6 +361,67 @@ Bool TiledStMan::canChangeShape() const
     return False;
 }
 
+Bool TiledStMan::canAccessConcurrently() const
+{
+    return tsmOption().option() == TSMOption::Cache
+       &&  tsmOption().nrShards() > 0;
+}
+
+Bool TiledStMan::copyLayout (const TiledStMan&)
+{
+    return False;
+}
+
+Bool TiledStMan::copyTiles (TiledStMan& that, Int64& nbytes)
+{
+    nbytes = 0;
+    // The tiles are read and written using the files, so mapped or
+    // buffered files cannot be used.
+    for (const TiledStMan* stman : {static_cast<const TiledStMan*>(this),
+                                    static_cast<const TiledStMan*>(&that)}) {
+        if (stman->tsmOption().option() == TSMOption::MMap
+        ||  stman->tsmOption().option() == TSMOption::Buffer
+        ||  stman->ncolumn() != stman->dataCols_p.nelements()) {
+            return False;
+        }
+    }
+    if (dataManagerType() != that.dataManagerType()
+    ||  asBigEndian() != that.asBigEndian()
+    ||  nrrow_p != that.nrrow_p
+    ||  dataCols_p.nelements() != that.dataCols_p.nelements()) {
+        return False;
+    }
+    for (uInt i=0; i<dataCols_p.nelements(); ++i) {
+        if (dataCols_p[i]->columnName() != that.dataCols_p[i]->columnName()
+        ||  dataCols_p[i]->dataType() != that.dataCols_p[i]->dataType()) {
+            return False;
+        }
+    }
+    if (! copyLayout (that)) {
+        return False;
+    }
+    if (cubeSet_p.nelements() != that.cubeSet_p.nelements()) {
+        return False;
+    }
+    for (uInt i=0; i<cubeSet_p.nelements(); ++i) {
+        const TSMCube* cube  = cubeSet_p[i];
+        const TSMCube* tcube = that.cubeSet_p[i];
+        // A hypercube without a shape (e.g., the dummy one of
+        // TiledShapeStMan) has no tiles, so its bucket size is irrelevant.
+        if (! cube->cubeShape().isEqual (tcube->cubeShape())
+        ||  ! cube->tileShape().isEqual (tcube->tileShape())
+        ||  (cube->cubeShape().nelements() > 0  &&
+             cube->bucketSize() != tcube->bucketSize())) {
+            return False;
+        }
+    }
+    for (uInt i=0; i<cubeSet_p.nelements(); ++i) {
+        nbytes += cubeSet_p[i]->copyTiles (*that.cubeSet_p[i]);
+    }
+    setDataChanged();
+    return True;
+}
+
 Bool TiledStMan::canAccessColumn() const
 {
     return (nhypercubes() == 1);
@@ -392,6 +454,12 @@ TSMCube* TiledStMan::makeTSMCube (TSMFile* file, const IPosition& cubeShape,
         AlwaysAssert (file->bucketFile()->isBuffered(), AipsError);
         hypercube = new TSMCubeBuff (this, file, cubeShape, tileShape,
                                      values, fileOffset);
+    } else if (tsmOption().option() == TSMOption::Cache
+           &&  tsmOption().nrShards() > 0) {
+        //cout << "concurrent caching TSM1" << endl;
+        AlwaysAssert (file->bucketFile()->isCached(), AipsError);
+        hypercube = new TSMCubeConcurrent (this, file, cubeShape, tileShape,
+                                           values, fileOffset);
     } else {
         //cout << "caching TSM1" << endl;
         AlwaysAssert (file->bucketFile()->isCached(), AipsError);
@@ -1224,6 +1292,10 @@ uInt TiledStMan::headerFileGet (AipsIO& headerFile, rownr_t tabNrrow,
             } else if (tsmOption().option() == TSMOption::Buffer) {
                 //cout << "buffered TSM" << endl;
                 cubeSet_p[i] = new TSMCubeBuff (this, headerFile);
+            } else if (tsmOption().option() == TSMOption::Cache
+                   &&  tsmOption().nrShards() > 0) {
+                //cout << "concurrent caching TSM" << endl;
+                cubeSet_p[i] = new TSMCubeConcurrent (this, headerFile);
             }else{
                 //cout << "caching TSM" << endl;
 	        cubeSet_p[i] = new TSMCube (this, headerFile);
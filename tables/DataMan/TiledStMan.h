@@ -199,6 +199,13 @@ public:
     // The default implementation returns True if there is only 1 hypercube.
     virtual Bool canAccessColumn() const;
 
+    // Can the data be read by multiple threads concurrently?
+    // That requires that the hypercubes use a thread-safe cache
+    // (i.e., TSMOption::Cache with a positive number of shards) and
+    // that finding the hypercube of a row does not change any state.
+    // The default implementation only checks the TSMOption.
+    virtual Bool canAccessConcurrently() const;
+
     // The data manager supports use of MultiFile.
     virtual Bool hasMultiFileSupport() const;
 
@@ -304,6 +311,25 @@ public:
     // It also returns the position of the row in that hypercube.
     virtual TSMCube* getHypercube (rownr_t rownr, IPosition& position) = 0;
 
+    // Copy the data of that storage manager by copying the tiles of its
+    // hypercubes as raw bytes, thus without converting and caching them.
+    // That is only possible if both storage managers have the same type
+    // and the same data columns (with the same data types) in the same
+    // external format, and if the hypercubes have the same shapes, tile
+    // shapes and row mapping (which is first created using
+    // <src>copyLayout</src>). Furthermore, coordinate and id columns
+    // cannot be used and the data must be accessed using a file
+    // (thus not with TSMOption::MMap or TSMOption::Buffer).
+    // It returns False if the tiles could not be copied.
+    // Otherwise <src>nbytes</src> tells the number of bytes copied.
+    Bool copyTiles (TiledStMan& that, Int64& nbytes);
+
+    // Give the hypercubes of this storage manager the same layout (shapes
+    // and mapping of rows) as those of that storage manager.
+    // It returns False if not possible.
+    // The default implementation returns False.
+    virtual Bool copyLayout (const TiledStMan& that);
+
     // Make the correct TSMCube type (depending on tsmOption()).
     TSMCube* makeTSMCube (TSMFile* file, const IPosition& cubeShape,
                           const IPosition& tileShape,
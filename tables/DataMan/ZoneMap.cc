@@ -0,0 +1,385 @@
+//# ZoneMap.cc: Minimum and maximum value per bucket of a scalar column
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/DataMan/ZoneMap.h>
+#include <casacore/tables/DataMan/DataManagerColumn.h>
+#include <casacore/tables/DataMan/DataManError.h>
+#include <casacore/tables/Tables/RefRows.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/IO/AipsIO.h>
+#include <casacore/casa/IO/ArrayIO.h>
+#include <casacore/casa/Utilities/DataType.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# The number of rows per chunk of the rows added since the last update.
+static const rownr_t theirChunkRows = 32;
+
+//# Get the range of Doubles containing a value.
+//# It returns False for a NaN value.
+template<typename T>
+inline Bool valueRange (T value, Double& minVal, Double& maxVal)
+{
+    minVal = maxVal = value;
+    return True;
+}
+template<>
+inline Bool valueRange (Float value, Double& minVal, Double& maxVal)
+{
+    minVal = maxVal = value;
+    return !isNaN(value);
+}
+template<>
+inline Bool valueRange (Double value, Double& minVal, Double& maxVal)
+{
+    minVal = maxVal = value;
+    return !isNaN(value);
+}
+template<>
+inline Bool valueRange (Int64 value, Double& minVal, Double& maxVal)
+{
+    // Beyond 2^53 not all Int64 values can be represented by a Double,
+    // so take the adjacent Doubles to be sure the value is in the range.
+    Double val = value;
+    if (std::abs(val) >= 9007199254740992.) {
+        minVal = std::nextafter (val, -std::numeric_limits<Double>::infinity());
+        maxVal = std::nextafter (val, std::numeric_limits<Double>::infinity());
+    } else {
+        minVal = maxVal = val;
+    }
+    return True;
+}
+
+//# Determine minimum and maximum of the non-NaN values in the given rows.
+//# The rows are read in chunks to limit the memory usage.
+template<typename T>
+static void zoneMinMax (DataManagerColumn& column, rownr_t startRow,
+                        rownr_t endRow, Double& minVal, Double& maxVal)
+{
+    const rownr_t chunkSize = 32768;
+    Vector<T> vals;
+    for (rownr_t st=startRow; st<endRow; st+=chunkSize) {
+        rownr_t nr = std::min (chunkSize, endRow-st);
+        if (vals.size() != nr) {
+            vals.resize (nr);
+        }
+        column.getScalarColumnCellsV (RefRows(st, st+nr-1), vals);
+        Double minv, maxv;
+        for (rownr_t i=0; i<nr; ++i) {
+            if (valueRange (vals[i], minv, maxv)) {
+                if (minv < minVal) minVal = minv;
+                if (maxv > maxVal) maxVal = maxv;
+            }
+        }
+    }
+}
+
+
+ZoneMap::ZoneMap (int dataType)
+: dtype_p    (dataType),
+  valid_p    (True),
+  modified_p (False),
+  nrrow_p    (0),
+  nadded_p   (0)
+{}
+
+Bool ZoneMap::isSupported (int dataType)
+{
+    switch (dataType) {
+    case TpBool:
+    case TpUChar:
+    case TpShort:
+    case TpUShort:
+    case TpInt:
+    case TpUInt:
+    case TpInt64:
+    case TpFloat:
+    case TpDouble:
+        return True;
+    default:
+        break;
+    }
+    return False;
+}
+
+void ZoneMap::invalidate()
+{
+    valid_p = False;
+    clearAdded();
+}
+
+void ZoneMap::clearAdded()
+{
+    nadded_p = 0;
+    addedPut_p.clear();
+    addedMin_p.clear();
+    addedMax_p.clear();
+}
+
+void ZoneMap::addRows (rownr_t nrrow)
+{
+    if (valid_p  &&  nrrow > nrrow_p + nadded_p) {
+        nadded_p = nrrow - nrrow_p;
+        addedPut_p.resize (nadded_p, false);
+        size_t nchunk = (nadded_p + theirChunkRows - 1) / theirChunkRows;
+        addedMin_p.resize (nchunk, std::numeric_limits<Double>::infinity());
+        addedMax_p.resize (nchunk, -std::numeric_limits<Double>::infinity());
+    }
+}
+
+void ZoneMap::removeRow (rownr_t row)
+{
+    if (! valid_p) {
+        return;
+    }
+    modified_p = True;
+    if (row < nrrow_p) {
+        // The rows after it shift, so the zones after it start a row earlier.
+        for (uInt i=0; i<starts_p.size(); ++i) {
+            if (starts_p[i] > row) {
+                starts_p[i]--;
+            }
+        }
+        nrrow_p--;
+    } else if (row < nrrow_p + nadded_p) {
+        // The first row of each next chunk shifts to the previous chunk.
+        rownr_t inx = row - nrrow_p;
+        addedPut_p.erase (addedPut_p.begin() + inx);
+        for (size_t i=inx/theirChunkRows + 1; i<addedMin_p.size(); ++i) {
+            addedMin_p[i-1] = std::min (addedMin_p[i-1], addedMin_p[i]);
+            addedMax_p[i-1] = std::max (addedMax_p[i-1], addedMax_p[i]);
+        }
+        nadded_p--;
+        size_t nchunk = (nadded_p + theirChunkRows - 1) / theirChunkRows;
+        addedMin_p.resize (nchunk);
+        addedMax_p.resize (nchunk);
+    } else {
+        invalidate();
+    }
+}
+
+void ZoneMap::putValue (rownr_t startRow, rownr_t endRow, const void* value)
+{
+    rownr_t nrrow = nrrow_p + nadded_p;
+    if (!valid_p  ||  startRow >= nrrow) {
+        return;
+    }
+    endRow = std::min (endRow, nrrow-1);
+    Double minVal, maxVal;
+    Bool hasValue = toRange (value, minVal, maxVal);
+    // Widen the zones containing the rows.
+    if (hasValue  &&  startRow < nrrow_p) {
+        rownr_t lastRow = std::min (endRow, nrrow_p-1);
+        const rownr_t* starts = starts_p.data();
+        uInt i = std::upper_bound (starts, starts + starts_p.size(), startRow)
+                 - starts - 1;
+        for (; i<starts_p.size()  &&  starts_p[i] <= lastRow; ++i) {
+            if (minVal < min_p[i]) {
+                min_p[i] = minVal;
+                modified_p = True;
+            }
+            if (maxVal > max_p[i]) {
+                max_p[i] = maxVal;
+                modified_p = True;
+            }
+        }
+    }
+    // Mark the added rows as put and widen their chunks.
+    if (endRow >= nrrow_p) {
+        rownr_t st  = std::max (startRow, nrrow_p) - nrrow_p;
+        rownr_t end = endRow - nrrow_p;
+        std::fill (addedPut_p.begin() + st, addedPut_p.begin() + end + 1, true);
+        if (hasValue) {
+            for (rownr_t i=st/theirChunkRows; i<=end/theirChunkRows; ++i) {
+                addedMin_p[i] = std::min (addedMin_p[i], minVal);
+                addedMax_p[i] = std::max (addedMax_p[i], maxVal);
+            }
+        }
+    }
+}
+
+void ZoneMap::update (const Vector<rownr_t>& zoneStarts, rownr_t nrrow,
+                      DataManagerColumn& column)
+{
+    uInt nzone = zoneStarts.size();
+    // Calculate all zones if the zone map is not valid (anymore).
+    Bool full = (!valid_p  ||  nrrow != nrrow_p + nadded_p);
+    // Nothing to do if the zones have not changed.
+    if (!full  &&  nadded_p == 0  &&  nzone == starts_p.size()
+    &&  allEQ (zoneStarts, starts_p)) {
+        return;
+    }
+    Vector<Double> minValues(nzone);
+    Vector<Double> maxValues(nzone);
+    uInt nold = starts_p.size();
+    uInt j = 0;
+    for (uInt i=0; i<nzone; ++i) {
+        rownr_t st  = zoneStarts[i];
+        rownr_t end = (i+1 < nzone  ?  zoneStarts[i+1] : nrrow);
+        Double minVal = std::numeric_limits<Double>::infinity();
+        Double maxVal = -std::numeric_limits<Double>::infinity();
+        Bool calc = full;
+        if (!full) {
+            // Combine the old zones overlapping the zone.
+            rownr_t oldEnd = std::min (end, nrrow_p);
+            if (st < oldEnd) {
+                while (j+1 < nold  &&  starts_p[j+1] <= st) {
+                    ++j;
+                }
+                for (uInt k=j; k<nold  &&  starts_p[k] < oldEnd; ++k) {
+                    minVal = std::min (minVal, min_p[k]);
+                    maxVal = std::max (maxVal, max_p[k]);
+                }
+            }
+            // Combine the chunks of added rows overlapping the zone.
+            // The zone has to be calculated if a row has not been put.
+            if (end > nrrow_p) {
+                rownr_t ast  = std::max (st, nrrow_p) - nrrow_p;
+                rownr_t aend = end - nrrow_p;
+                if (std::find (addedPut_p.begin() + ast,
+                               addedPut_p.begin() + aend, false)
+                    != addedPut_p.begin() + aend) {
+                    calc = True;
+                } else {
+                    for (rownr_t k=ast/theirChunkRows;
+                         k<=(aend-1)/theirChunkRows; ++k) {
+                        minVal = std::min (minVal, addedMin_p[k]);
+                        maxVal = std::max (maxVal, addedMax_p[k]);
+                    }
+                }
+            }
+        }
+        if (calc) {
+            calculate (column, st, end, minVal, maxVal);
+        }
+        minValues[i] = minVal;
+        maxValues[i] = maxVal;
+    }
+    starts_p.reference (zoneStarts.copy());
+    min_p.reference (minValues);
+    max_p.reference (maxValues);
+    nrrow_p    = nrrow;
+    valid_p    = True;
+    modified_p = True;
+    clearAdded();
+}
+
+Bool ZoneMap::toRange (const void* value, Double& minVal,
+                       Double& maxVal) const
+{
+    switch (dtype_p) {
+    case TpBool:
+        return valueRange (*static_cast<const Bool*>(value), minVal, maxVal);
+    case TpUChar:
+        return valueRange (*static_cast<const uChar*>(value), minVal, maxVal);
+    case TpShort:
+        return valueRange (*static_cast<const Short*>(value), minVal, maxVal);
+    case TpUShort:
+        return valueRange (*static_cast<const uShort*>(value), minVal, maxVal);
+    case TpInt:
+        return valueRange (*static_cast<const Int*>(value), minVal, maxVal);
+    case TpUInt:
+        return valueRange (*static_cast<const uInt*>(value), minVal, maxVal);
+    case TpInt64:
+        return valueRange (*static_cast<const Int64*>(value), minVal, maxVal);
+    case TpFloat:
+        return valueRange (*static_cast<const Float*>(value), minVal, maxVal);
+    case TpDouble:
+        return valueRange (*static_cast<const Double*>(value), minVal, maxVal);
+    default:
+        break;
+    }
+    return False;
+}
+
+void ZoneMap::calculate (DataManagerColumn& column, rownr_t startRow,
+                         rownr_t endRow, Double& minVal, Double& maxVal) const
+{
+    minVal = std::numeric_limits<Double>::infinity();
+    maxVal = -std::numeric_limits<Double>::infinity();
+    switch (dtype_p) {
+    case TpBool:
+        zoneMinMax<Bool>   (column, startRow, endRow, minVal, maxVal);
+        break;
+    case TpUChar:
+        zoneMinMax<uChar>  (column, startRow, endRow, minVal, maxVal);
+        break;
+    case TpShort:
+        zoneMinMax<Short>  (column, startRow, endRow, minVal, maxVal);
+        break;
+    case TpUShort:
+        zoneMinMax<uShort> (column, startRow, endRow, minVal, maxVal);
+        break;
+    case TpInt:
+        zoneMinMax<Int>    (column, startRow, endRow, minVal, maxVal);
+        break;
+    case TpUInt:
+        zoneMinMax<uInt>   (column, startRow, endRow, minVal, maxVal);
+        break;
+    case TpInt64:
+        zoneMinMax<Int64>  (column, startRow, endRow, minVal, maxVal);
+        break;
+    case TpFloat:
+        zoneMinMax<Float>  (column, startRow, endRow, minVal, maxVal);
+        break;
+    case TpDouble:
+        zoneMinMax<Double> (column, startRow, endRow, minVal, maxVal);
+        break;
+    default:
+        throw DataManError ("ZoneMap: column " + column.columnName() +
+                            " does not have a numeric data type");
+    }
+}
+
+void ZoneMap::put (AipsIO& ios)
+{
+    ios.putstart ("ZoneMap", 1);
+    ios << dtype_p << nrrow_p << starts_p << min_p << max_p;
+    ios.putend();
+    modified_p = False;
+}
+
+void ZoneMap::get (AipsIO& ios)
+{
+    int dtype;
+    ios.getstart ("ZoneMap");
+    ios >> dtype >> nrrow_p >> starts_p >> min_p >> max_p;
+    ios.getend();
+    // Do not use a zone map written for another data type.
+    valid_p    = (dtype == dtype_p  &&
+                  starts_p.size() == min_p.size()  &&
+                  starts_p.size() == max_p.size()  &&
+                  (starts_p.empty()  ?  nrrow_p == 0 : starts_p[0] == 0));
+    modified_p = False;
+    clearAdded();
+}
+
+
+} //# NAMESPACE CASACORE - END
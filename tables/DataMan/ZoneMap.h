@@ -0,0 +1,191 @@
+//# ZoneMap.h: Minimum and maximum value per bucket of a scalar column
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_ZONEMAP_H
+#define TABLES_ZONEMAP_H
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward declarations
+class AipsIO;
+class DataManagerColumn;
+
+// <summary>
+// Minimum and maximum value per bucket of a scalar column
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tZoneMap.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=DataManagerColumn>DataManagerColumn</linkto>
+// </prerequisite>
+
+// <etymology>
+// A zone map is the common database name for a summary of the values
+// in each zone (here a bucket) of a column.
+// </etymology>
+
+// <synopsis>
+// A ZoneMap holds the minimum and maximum value of each zone of a numeric
+// scalar column. A zone is a range of rows, usually the rows stored in
+// a bucket of a storage manager. A selection on a range of values only
+// needs to look at the rows in the zones overlapping that range.
+// The values are held as Double; NaN values are ignored. An Int64 value
+// that cannot be represented exactly as a Double widens the zone to the
+// adjacent Double values, so a zone never excludes one of its values.
+// An empty zone (or a zone containing NaN values only) has a minimum
+// higher than its maximum, so it never overlaps a range.
+// <p>
+// The storage manager tells the zone map the values put and the rows
+// added or removed. A put widens the minimum and maximum of the zone
+// containing the row; the values are never read back for it. Hence the
+// minimum and maximum can be wider than the actual values in a zone after
+// a value has been overwritten, which is fine for skipping zones.
+// Rows added after the last update are kept in chunks of 32 rows.
+// <br>When the zone map is updated for a new zone layout (which is done
+// when the storage manager flushes or when the zone map is used), a zone
+// gets the combined minimum and maximum of the old zones and chunks it
+// overlaps. Only a zone containing an added row that has not been put is
+// calculated by reading its rows from the column. The same is done for
+// all zones if the zone map is not valid (e.g., when it is made for an
+// existing column).
+// <p>
+// The zone map can be written into and read back from an AipsIO object.
+// The storage manager is responsible for storing it.
+// </synopsis>
+
+// <motivation>
+// Selections on time ranges in large, time-ordered tables (such as
+// MeasurementSets) should only need to read the buckets containing
+// the selected times.
+// </motivation>
+
+class ZoneMap
+{
+public:
+    // Create an empty zone map for a column with the given data type.
+    explicit ZoneMap (int dataType);
+
+    // Can a zone map be made for a scalar column with the given data type?
+    // That is the case for the numeric data types (including Bool).
+    static Bool isSupported (int dataType);
+
+    // Get the data type.
+    int dataType() const
+      { return dtype_p; }
+
+    // Make the zone map invalid, so it is fully calculated by the next
+    // update.
+    void invalidate();
+
+    // Tell that rows have been added, so the column has the given number
+    // of rows now.
+    void addRows (rownr_t nrrow);
+
+    // Tell that a row has been removed.
+    void removeRow (rownr_t row);
+
+    // Tell that a value is put into the given row or rows. The value
+    // must have the data type of the column.
+    // <group>
+    void putValue (rownr_t row, const void* value)
+      { putValue (row, row, value); }
+    void putValue (rownr_t startRow, rownr_t endRow, const void* value);
+    // </group>
+
+    // Has the zone map changed since it was written?
+    Bool isChanged() const
+      { return modified_p; }
+
+    // Update the zone map for the given zones in the column with the
+    // given number of rows. The zones are given by their start rows,
+    // which must be in ascending order.
+    // Only zones containing added rows that have not been put are
+    // calculated by reading the values from the column.
+    void update (const Vector<rownr_t>& zoneStarts, rownr_t nrrow,
+                 DataManagerColumn& column);
+
+    // Get the start rows and the minimum and maximum of each zone.
+    // They are only valid after the last update.
+    // <group>
+    const Vector<rownr_t>& zoneStarts() const
+      { return starts_p; }
+    const Vector<Double>& minValues() const
+      { return min_p; }
+    const Vector<Double>& maxValues() const
+      { return max_p; }
+    // </group>
+
+    // Write the zone map into the AipsIO object.
+    // It clears the changed flag.
+    void put (AipsIO& ios);
+
+    // Read the zone map from the AipsIO object.
+    // The zone map is not used if it was written for another data type.
+    void get (AipsIO& ios);
+
+private:
+    // Convert a value to the range of Doubles containing it.
+    // It returns False if the value is NaN.
+    Bool toRange (const void* value, Double& minVal, Double& maxVal) const;
+
+    // Calculate the minimum and maximum of the rows [startRow,endRow).
+    void calculate (DataManagerColumn& column, rownr_t startRow,
+                    rownr_t endRow, Double& minVal, Double& maxVal) const;
+
+    // Clear the rows added since the last update.
+    void clearAdded();
+
+    //# Data members.
+    int             dtype_p;
+    Bool            valid_p;
+    Bool            modified_p;
+    // The number of rows at the last update.
+    rownr_t         nrrow_p;
+    Vector<rownr_t> starts_p;
+    Vector<Double>  min_p;
+    Vector<Double>  max_p;
+    // The rows added since the last update, which ones have been put,
+    // and the minimum and maximum per chunk of them.
+    rownr_t           nadded_p;
+    std::vector<bool> addedPut_p;
+    std::vector<Double> addedMin_p;
+    std::vector<Double> addedMax_p;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
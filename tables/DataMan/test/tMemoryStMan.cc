@@ -98,6 +98,9 @@ void restoreData(const Table aTable);
 // put/putColumn cache test
 void putColumnTest();
 
+// test arena mode and column views
+void arenaTest (Bool arena);
+
 
 int main ()
 {
@@ -136,6 +139,8 @@ int main ()
 	  aNewNrRows(i) = i;
 	}
 	deleteRows      (aNewNrRows);
+	arenaTest       (True);
+	arenaTest       (False);
 
 
     } catch (std::exception& x) {
@@ -703,6 +708,90 @@ void putColumnTest()
   saveData(aTable);
 }
 
+void arenaTest (Bool arena)
+{
+  cout << "arenaTest " << arena << endl;
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int> ("ID"));
+  td.addColumn (ArrayColumnDesc<Float> ("DATA", IPosition(2,2,3),
+                                        ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<String> ("NAMES", IPosition(1,2),
+                                         ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Int> ("VAR"));
+  SetupNewTable newtab ("", td, Table::New);
+  MemoryStMan stman ("arena", arena, 10);
+  newtab.bindAll (stman);
+  Table tab (newtab, Table::Memory);
+  Record dminfo = tab.dataManagerInfo();
+  AlwaysAssertExit (dminfo.nfields() == 1);
+  const Record& spec = dminfo.subRecord(0).subRecord("SPEC");
+  cout << dminfo.subRecord(0).asString("NAME")
+       << " ARENA=" << spec.asBool("ARENA")
+       << " ARENAROWS=" << spec.asInt64("ARENAROWS") << endl;
+  ScalarColumn<Int> idCol (tab, "ID");
+  ArrayColumn<Float> dataCol (tab, "DATA");
+  ArrayColumn<String> namesCol (tab, "NAMES");
+  ArrayColumn<Int> varCol (tab, "VAR");
+  // Add a few rows and then many rows at once, so the arena is reallocated.
+  Matrix<Float> arr(2,3);
+  Vector<String> names(2);
+  for (uInt n=0; n<2; ++n) {
+    rownr_t nrold = tab.nrow();
+    tab.addRow (n==0 ? 5 : 100);
+    for (rownr_t i=nrold; i<tab.nrow(); ++i) {
+      indgen (arr, Float(10*i));
+      names(0) = "a" + String::toString(i);
+      names(1) = "b" + String::toString(i);
+      idCol.put (i, i);
+      dataCol.put (i, arr);
+      namesCol.put (i, names);
+      varCol.put (i, Vector<Int>(1 + i%3, i));
+    }
+  }
+  // Remove a few rows, which shifts the other rows.
+  tab.removeRow (0);
+  tab.removeRow (50);
+  tab.removeRow (tab.nrow() - 1);
+  AlwaysAssertExit (tab.nrow() == 102);
+  Vector<Int> ids;
+  Array<Float> data;
+  Array<String> allNames;
+  cout << "ID view " << idCol.getColumnView (ids) << endl;
+  cout << "DATA view " << dataCol.getColumnView (data) << endl;
+  cout << "NAMES view " << namesCol.getColumnView (allNames) << endl;
+  AlwaysAssertExit (ids.shape() == IPosition(1,102));
+  AlwaysAssertExit (data.shape() == IPosition(3,2,3,102));
+  AlwaysAssertExit (allNames.shape() == IPosition(2,2,102));
+  AlwaysAssertExit (allEQ (ids, idCol.getColumn()));
+  AlwaysAssertExit (allEQ (data, dataCol.getColumn()));
+  AlwaysAssertExit (allEQ (allNames, namesCol.getColumn()));
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    Int id = i<50 ? i+1 : i+2;
+    AlwaysAssertExit (ids(i) == id);
+    indgen (arr, Float(10*id));
+    AlwaysAssertExit (allEQ (dataCol(i), arr));
+    AlwaysAssertExit (namesCol(i)(IPosition(1,1)) ==
+                      "b" + String::toString(id));
+    AlwaysAssertExit (allEQ (varCol(i), Array<Int>(IPosition(1,1+id%3), id)));
+    // A cell can always be viewed.
+    ArrayColumnView<Float> cell;
+    AlwaysAssertExit (dataCol.getView (i, cell));
+    AlwaysAssertExit (allEQ (cell.copy(), arr));
+    AlwaysAssertExit (dataCol.getSliceView (i, Slicer(IPosition(2,1,0),
+                                                      IPosition(2,1,3)),
+                                            cell));
+    AlwaysAssertExit (allEQ (cell.copy(),
+                             arr(IPosition(2,1,0), IPosition(2,1,2))));
+  }
+  // Put the entire column.
+  Array<Float> newData = data + Float(1);
+  dataCol.putColumn (newData);
+  AlwaysAssertExit (allEQ (dataCol.getColumn(), newData));
+  indgen (arr, Float(11));
+  AlwaysAssertExit (allEQ (dataCol(0), arr));
+  cout << "nrow " << tab.nrow() << endl;
+}
+
 
 
 
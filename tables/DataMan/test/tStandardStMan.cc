@@ -166,6 +166,56 @@ void testInd2()
   }
 }
 
+// Test filling a table with buckets written behind.
+void testWriteBehind()
+{
+  cout << endl << "testWriteBehind ..." << endl;
+  String tabName = "tStandardStMan_tmp.tabwb";
+  const uInt nrow = 1000;
+  Vector<Float> arr(10);
+  {
+    TableDesc td;
+    td.addColumn (ScalarColumnDesc<Int>("col1"));
+    td.addColumn (ArrayColumnDesc<Float>("col2", IPosition(1,10),
+                                         ColumnDesc::FixedShape));
+    SetupNewTable newt(tabName, td, Table::New);
+    StandardStMan ssm("SSMWB", -8);
+    newt.bindAll (ssm);
+    Table tab(newt);
+    ROStandardStManAccessor accessor(tab, "SSMWB");
+    Record props;
+    props.define ("WriteBehindSize", 4);
+    props.define ("SyncSizeMB", 1);
+    accessor.setProperties (props);
+    Record current = accessor.getProperties();
+    AlwaysAssertExit (current.asInt("WriteBehindSize") == 4);
+    AlwaysAssertExit (current.asInt("SyncSizeMB") == 1);
+    ScalarColumn<Int> col1(tab, "col1");
+    ArrayColumn<Float> col2(tab, "col2");
+    for (uInt i=0; i<nrow; ++i) {
+      tab.addRow();
+      col1.put (i, i);
+      indgen (arr, Float(i));
+      col2.put (i, arr);
+    }
+    // Read back, partly from buckets still waiting to be written.
+    for (uInt i=0; i<nrow; ++i) {
+      indgen (arr, Float(i));
+      AlwaysAssertExit (col1(i) == Int(i));
+      AlwaysAssertExit (allEQ (col2(i), arr));
+    }
+  }
+  Table tab(tabName);
+  ScalarColumn<Int> col1(tab, "col1");
+  ArrayColumn<Float> col2(tab, "col2");
+  for (uInt i=0; i<tab.nrow(); ++i) {
+    indgen (arr, Float(i));
+    AlwaysAssertExit (col1(i) == Int(i));
+    AlwaysAssertExit (allEQ (col2(i), arr));
+  }
+  cout << "checked " << tab.nrow() << " rows" << endl;
+}
+
 int main (int argc, const char* argv[])
 {
   ///DataManager::MAXROWNR32 = 0;
@@ -214,6 +264,7 @@ int main (int argc, const char* argv[])
         // increase the file size.
         testInd();
         testInd2();
+        testWriteBehind();
 
     } catch (std::exception& x) {
 	cout << "Caught an exception: " << x.what() << endl;
@@ -30,6 +30,7 @@
 #include <casacore/tables/Tables/ArrColDesc.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/tables/DataMan/TiledColumnStMan.h>
 #include <casacore/tables/DataMan/TiledStManAccessor.h>
 #include <casacore/casa/Containers/Record.h>
@@ -45,6 +46,10 @@
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
+#include <casacore/casa/sstream.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 #include <casacore/casa/namespace.h>
 // <summary>
@@ -59,6 +64,10 @@ void writeFixed(const TSMOption&);
 void readTable(const TSMOption&, Bool readKeys);
 void writeNoHyper(const TSMOption&);
 void extendOnly(const TSMOption&);
+void readPrefetch();
+void readConcurrent (uInt nthread);
+void readBatch (Bool useODirect);
+void writeBehind();
 
 int main () {
     try {
@@ -69,6 +78,11 @@ int main () {
         writeFixed(TSMOption::Buffer);
 	readTable(TSMOption::Cache, False);
         extendOnly(TSMOption::Cache);
+        readPrefetch();
+        readConcurrent (4);
+        readBatch (False);
+        readBatch (True);
+        writeBehind();
     } catch (std::exception& x) {
 	cout << "Caught an exception: " << x.what() << endl;
 	return 1;
@@ -473,3 +487,157 @@ void extendOnly(const TSMOption& tsmOpt)
     AlwaysAssertExit (accessor.getBucketSize(0) == accessor.bucketSize(2));
     AlwaysAssertExit (accessor.getCacheSize(0) == accessor.cacheSize(2));
 }
+
+// Read the data forward and backward with tile read-ahead.
+void readPrefetch()
+{
+    Table table("tTiledColumnStMan_tmp.data", Table::Old,
+                TSMOption(TSMOption::Cache, 0, 0, 4));
+    ArrayColumn<float> data (table, "Data");
+    Matrix<float> array(IPosition(2,16,20));
+    Matrix<float> result(IPosition(2,16,20));
+    indgen (array);
+    for (uInt i=0; i<table.nrow(); i++) {
+	data.get (i, result);
+	AlwaysAssertExit (allEQ (array, result));
+	array += float(200);
+    }
+    for (Int i=table.nrow()-1; i>=0; i--) {
+	array -= float(200);
+	data.get (i, result);
+	AlwaysAssertExit (allEQ (array, result));
+    }
+    // Check that tiles have been read ahead (the statistics only show
+    // the number of prefetched tiles if non-zero).
+    ROTiledStManAccessor accessor (table, "TSMExample");
+    std::ostringstream os;
+    accessor.showCacheStatistics (os);
+    AlwaysAssertExit (os.str().find ("#prefetch: ") != std::string::npos);
+    cout << "prefetched get's have been done" << endl;
+}
+
+void readConcurrent (uInt nthread)
+{
+    // Use a thread-safe cache with 4 shards.
+    Table table("tTiledColumnStMan_tmp.data",
+                TableLock(TableLock::PermanentLocking), Table::Old,
+                TSMOption(TSMOption::Cache, 0, 0, 0, 4));
+    std::atomic<uInt> nrError(0);
+    std::vector<std::thread> threads;
+    for (uInt t=0; t<nthread; ++t) {
+        threads.emplace_back ([&table, &nrError, nthread, t]() {
+            ArrayColumn<float> data (table, "Data");
+            Matrix<float> array(IPosition(2,16,20));
+            Matrix<float> result(IPosition(2,16,20));
+            for (rownr_t i=t; i<table.nrow(); i+=nthread) {
+                indgen (array, float(200*i));
+                data.get (i, result);
+                if (! allEQ (array, result)) {
+                    nrError++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    AlwaysAssertExit (nrError == 0);
+    cout << "concurrent get's have been done" << endl;
+    // Get slices of different shapes mixed with cells, so the threads
+    // keep changing the access type and slice shape of the cube.
+    threads.clear();
+    for (uInt t=0; t<nthread; ++t) {
+        threads.emplace_back ([&table, &nrError, nthread, t]() {
+            ArrayColumn<float> data (table, "Data");
+            Matrix<float> array(IPosition(2,16,20));
+            Slicer slicer(IPosition(2,t,1), IPosition(2,15-t,19-t),
+                          IPosition(2,1,t+1), Slicer::endIsLast);
+            for (uInt iter=0; iter<10; ++iter) {
+                for (rownr_t i=t; i<table.nrow(); i+=nthread) {
+                    indgen (array, float(200*i));
+                    Matrix<float> result = data.getSlice (i, slicer);
+                    if (! allEQ (array(slicer), result)) {
+                        nrError++;
+                    }
+                    if (! allEQ (array, data(i))) {
+                        nrError++;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    AlwaysAssertExit (nrError == 0);
+    cout << "concurrent getSlice's have been done" << endl;
+    // Read (parts of) the column in parallel and compare with a serial read.
+    ArrayColumn<float> data (table, "Data");
+    Cube<float> serial = data.getColumn();
+    Array<float> parallel;
+    data.getColumnRangeParallel (Slicer(IPosition(1,0),
+                                        IPosition(1,table.nrow())),
+                                 parallel, True, nthread);
+    AlwaysAssertExit (allEQ (serial, parallel));
+    RefRows rows(3, table.nrow()-1, 7);
+    Array<float> parallelCells;
+    data.getColumnCellsParallel (rows, parallelCells, True, nthread);
+    AlwaysAssertExit (allEQ (data.getColumnCells(rows), parallelCells));
+    cout << "parallel getColumn's have been done" << endl;
+}
+
+void readBatch (Bool useODirect)
+{
+    Table table("tTiledColumnStMan_tmp.data", Table::Old,
+                TSMOption(TSMOption::Batch, 0, 0, 0, 0, useODirect ? 1:0));
+    ArrayColumn<float> data (table, "Data");
+    Cube<float> result = data.getColumn();
+    Matrix<float> array(IPosition(2,16,20));
+    indgen (array);
+    for (uInt i=0; i<table.nrow(); i++) {
+	AlwaysAssertExit (allEQ (array, result.xyPlane(i)));
+	array += float(200);
+    }
+    // Get a slice for all rows, so multiple tiles per row are needed.
+    Slicer slicer (IPosition(2,2,3), IPosition(2,10,12));
+    Cube<float> slices = data.getColumn (slicer);
+    AlwaysAssertExit (allEQ (slices,
+                             result(IPosition(3,2,3,0),
+                                    IPosition(3,11,14,table.nrow()-1))));
+    cout << "batched get's have been done" << endl;
+}
+
+// Rewrite the data with tiles written behind and check them before and
+// after reopening the table.
+void writeBehind()
+{
+    {
+        Table table("tTiledColumnStMan_tmp.data", Table::Update,
+                    TSMOption(TSMOption::Cache, 0, 0, 0, 0, 0, 3, 1));
+        ArrayColumn<float> data (table, "Data");
+        Matrix<float> array(IPosition(2,16,20));
+        Matrix<float> result(IPosition(2,16,20));
+        indgen (array, float(1));
+        for (uInt i=0; i<table.nrow(); i++) {
+            data.put (i, array);
+            array += float(200);
+        }
+        // Read back, partly from tiles still waiting to be written.
+        for (Int i=table.nrow()-1; i>=0; i--) {
+            array -= float(200);
+            data.get (i, result);
+            AlwaysAssertExit (allEQ (array, result));
+        }
+    }
+    Table table("tTiledColumnStMan_tmp.data", Table::Old,
+                TSMOption(TSMOption::Cache, 0, 0));
+    ArrayColumn<float> data (table, "Data");
+    Cube<float> result = data.getColumn();
+    Matrix<float> array(IPosition(2,16,20));
+    indgen (array, float(1));
+    for (uInt i=0; i<table.nrow(); i++) {
+	AlwaysAssertExit (allEQ (array, result.xyPlane(i)));
+	array += float(200);
+    }
+    cout << "written behind put's have been done" << endl;
+}
@@ -0,0 +1,157 @@
+//# tTiledView.cc: Test program for zero-copy views of tiled columns
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
+#include <casacore/tables/DataMan/TSMOption.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/OS/HostInfo.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <algorithm>
+
+#include <casacore/casa/namespace.h>
+// <summary>
+// Test program for zero-copy views of tiled columns.
+// </summary>
+
+
+// Create the table with the given endianness.
+// Column DATA has tiles containing entire cells, while in column SPLIT
+// a cell is spread over two tiles.
+void makeTable (Table::EndianFormat endian)
+{
+  TableDesc td;
+  td.addColumn (ArrayColumnDesc<Float> ("DATA", IPosition(2,4,16),
+                                        ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Complex> ("CDATA", IPosition(2,4,16),
+                                          ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Float> ("SPLIT", IPosition(2,4,16),
+                                        ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Bool> ("FLAG", IPosition(2,4,16),
+                                       ColumnDesc::FixedShape));
+  SetupNewTable newtab("tTiledView_tmp.data", td, Table::New);
+  TiledColumnStMan sm1 ("TSM1", IPosition(3,4,16,8));
+  TiledColumnStMan sm2 ("TSM2", IPosition(3,4,8,8));
+  newtab.bindAll (sm1);
+  newtab.bindColumn ("SPLIT", sm2);
+  Table tab(newtab, 100, False, endian);
+  ArrayColumn<Float> data(tab, "DATA");
+  ArrayColumn<Complex> cdata(tab, "CDATA");
+  ArrayColumn<Float> split(tab, "SPLIT");
+  ArrayColumn<Bool> flag(tab, "FLAG");
+  Array<Float> arr(IPosition(2,4,16));
+  Array<Complex> carr(IPosition(2,4,16));
+  Array<Bool> barr(IPosition(2,4,16));
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    indgen (arr, Float(i*100));
+    convertArray (carr, arr);
+    barr = (arr > Float(i*100+10));
+    data.put (i, arr);
+    cdata.put (i, carr);
+    split.put (i, arr);
+    flag.put (i, barr);
+  }
+}
+
+// Check that the views of the full cells and some slices are correct
+// and if they reference the data.
+template<typename T>
+void checkColumn (const Table& tab, const String& name, Bool expFull,
+                  Bool expSlice)
+{
+  ArrayColumn<T> col(tab, name);
+  Slicer slicer (IPosition(2,1,0), IPosition(2,3,6), IPosition(2,2,3),
+                 Slicer::endIsLast);
+  ArrayColumnView<T> view;
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    AlwaysAssertExit (col.getView (i, view) == expFull);
+    AlwaysAssertExit (view.isView() == expFull);
+    AlwaysAssertExit (view.shape().isEqual (IPosition(2,4,16)));
+    AlwaysAssertExit (allEQ (view.copy(), col.get(i)));
+    AlwaysAssertExit (col.getSliceView (i, slicer, view) == expSlice);
+    AlwaysAssertExit (view.shape().isEqual (IPosition(2,2,3)));
+    AlwaysAssertExit (allEQ (view.copy(), col.getSlice(i, slicer)));
+    // Iterating through the view gives the same values.
+    Array<T> slice = col.getSlice(i, slicer);
+    AlwaysAssertExit (std::equal (view.begin(), view.end(), slice.begin()));
+    AlwaysAssertExit (view(IPosition(2,1,2)) == slice(IPosition(2,1,2)));
+  }
+}
+
+// Check all columns for the given TSM option and endianness.
+void checkTable (const TSMOption& tsmOpt, Bool native)
+{
+  Table tab("tTiledView_tmp.data", Table::Old, tsmOpt);
+  Bool mmap = (tsmOpt.option() == TSMOption::MMap  &&  native);
+  checkColumn<Float>   (tab, "DATA",  mmap, mmap);
+  checkColumn<Complex> (tab, "CDATA", mmap, mmap);
+  // A cell spans two tiles, but the slice is in the first tile.
+  checkColumn<Float>   (tab, "SPLIT", False, mmap);
+  // Bools are stored as bits, thus cannot be referenced.
+  checkColumn<Bool>    (tab, "FLAG",  False, False);
+  // A view on a selection.
+  Table sel = tab(tab.nodeRownr() % 3 == 1);
+  AlwaysAssertExit (sel.nrow() == 33);
+  checkColumn<Float>   (sel, "DATA",  mmap, mmap);
+  // Check that the view references the table data.
+  if (mmap) {
+    ArrayColumn<Float> data(tab, "DATA");
+    ArrayColumnView<Float> view1, view2;
+    AlwaysAssertExit (data.getView (10, view1));
+    AlwaysAssertExit (data.getView (10, view2));
+    AlwaysAssertExit (view1.data() == view2.data());
+  }
+}
+
+int main()
+{
+  try {
+    Table::EndianFormat local = Table::LocalEndian;
+    Table::EndianFormat other = (HostInfo::bigEndian() ?
+                                 Table::LittleEndian : Table::BigEndian);
+    makeTable (local);
+    checkTable (TSMOption::MMap, True);
+    checkTable (TSMOption::Cache, True);
+    checkTable (TSMOption::Buffer, True);
+    makeTable (other);
+    checkTable (TSMOption::MMap, False);
+    checkTable (TSMOption::Cache, False);
+  } catch (const std::exception& x) {
+    cout << "Exception caught: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,273 @@
+//# tZoneMap.cc: Test program for the zone maps of the SSM and ISM
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/DataMan/ZoneMap.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/IncrementalStMan.h>
+#include <casacore/tables/DataMan/SSMColumn.h>
+#include <casacore/tables/DataMan/ISMColumn.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Utilities/DataType.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <algorithm>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+// <summary>
+// Test program for the zone maps of the SSM and ISM.
+// </summary>
+
+
+// Get the zone map of a column from its storage manager.
+Bool getZoneMap (const Table& tab, const String& name,
+                 Vector<rownr_t>& starts, Vector<Double>& minv,
+                 Vector<Double>& maxv)
+{
+    DataManager* dm = tab.findDataManager (name, True);
+    if (SSMBase* ssm = dynamic_cast<SSMBase*>(dm)) {
+        for (uInt i=0; i<ssm->ncolumn(); ++i) {
+            if (ssm->getColumn(i).columnName() == name) {
+                return ssm->getColumn(i).getZoneMap (starts, minv, maxv);
+            }
+        }
+    } else if (ISMBase* ism = dynamic_cast<ISMBase*>(dm)) {
+        for (uInt i=0; i<ism->ncolumn(); ++i) {
+            if (ism->getColumn(i).columnName() == name) {
+                return ism->getColumn(i).getZoneMap (starts, minv, maxv);
+            }
+        }
+    }
+    return False;
+}
+
+// Check the zone map of a column against its values.
+// A put only widens a zone, so its range can be wider than its values.
+// It returns the number of zones.
+uInt checkZoneMap (const Table& tab, const String& name)
+{
+    Vector<rownr_t> starts;
+    Vector<Double> minv, maxv;
+    AlwaysAssertExit (getZoneMap (tab, name, starts, minv, maxv));
+    AlwaysAssertExit (starts.size() == minv.size()  &&
+                      starts.size() == maxv.size());
+    TableColumn col(tab, name);
+    Vector<Double> vals(tab.nrow());
+    for (rownr_t i=0; i<tab.nrow(); ++i) {
+        vals[i] = col.asdouble (i);
+    }
+    for (uInt i=0; i<starts.size(); ++i) {
+        rownr_t end = (i+1 < starts.size()  ?  starts[i+1] : tab.nrow());
+        Double mn = 1e30;
+        Double mx = -1e30;
+        for (rownr_t j=starts[i]; j<end; ++j) {
+            if (! isNaN(vals[j])) {
+                mn = std::min (mn, vals[j]);
+                mx = std::max (mx, vals[j]);
+            }
+        }
+        if (mn <= mx) {
+            AlwaysAssertExit (minv[i] <= mn  &&  maxv[i] >= mx);
+        }
+    }
+    return starts.size();
+}
+
+// Check that a selection gives the same rows as evaluating the expression
+// for each row.
+void checkSelect (const Table& tab, const TableExprNode& expr,
+                  rownr_t expNr)
+{
+    std::vector<rownr_t> exp;
+    for (rownr_t i=0; i<tab.nrow(); ++i) {
+        Bool val;
+        expr.get (i, val);
+        if (val) {
+            exp.push_back (i);
+        }
+    }
+    Table sel = tab(expr);
+    Vector<rownr_t> rows = sel.rowNumbers (tab);
+    if (rows.size() != exp.size()  ||  !allEQ (rows, Vector<rownr_t>(exp))) {
+        cout << "Selection mismatch: " << rows.size() << " rows selected, "
+             << exp.size() << " expected" << endl;
+        AlwaysAssertExit (False);
+    }
+    AlwaysAssertExit (rows.size() == expNr);
+}
+
+// Create the table.
+void a()
+{
+    TableDesc td;
+    td.addColumn (ScalarColumnDesc<Double>("TIME"));
+    td.addColumn (ScalarColumnDesc<Int>("SCAN"));
+    td.addColumn (ScalarColumnDesc<String>("NAME"));
+    td.addColumn (ScalarColumnDesc<Int>("FIELD"));
+    td.addColumn (ScalarColumnDesc<Int64>("ID"));
+    td.addColumn (ScalarColumnDesc<Int>("ANT"));
+    SetupNewTable newtab("tZoneMap_tmp.data", td, Table::New);
+    StandardStMan ssm("SSM", 1024);
+    ssm.setZoneMaps (True);
+    IncrementalStMan ism("ISM", 1024);
+    ism.setZoneMaps (True);
+    // Zone maps are not kept by default.
+    StandardStMan ssm2("SSM2", 1024);
+    newtab.bindAll (ssm);
+    newtab.bindColumn ("FIELD", ism);
+    newtab.bindColumn ("ANT", ssm2);
+    Table tab(newtab, 10000);
+    ScalarColumn<Double> time(tab, "TIME");
+    ScalarColumn<Int> scan(tab, "SCAN");
+    ScalarColumn<Int> field(tab, "FIELD");
+    ScalarColumn<Int64> id(tab, "ID");
+    ScalarColumn<Int> ant(tab, "ANT");
+    // Int64 values beyond 2^53 cannot all be represented as Double.
+    const Int64 idOffset = Int64(1) << 60;
+    for (uInt i=0; i<10000; ++i) {
+        time.put (i, i);
+        scan.put (i, i/1000);
+        field.put (i, i/10);
+        id.put (i, idOffset + i);
+        ant.put (i, i%10);
+    }
+    time.put (5, doubleNaN());
+    // A String column does not have a zone map.
+    Vector<rownr_t> starts;
+    Vector<Double> minv, maxv;
+    AlwaysAssertExit (! getZoneMap (tab, "NAME", starts, minv, maxv));
+    AlwaysAssertExit (! getZoneMap (tab, "ANT", starts, minv, maxv));
+    AlwaysAssertExit (checkZoneMap (tab, "TIME") > 10);
+    AlwaysAssertExit (checkZoneMap (tab, "SCAN") > 10);
+    AlwaysAssertExit (checkZoneMap (tab, "FIELD") > 10);
+    checkSelect (tab, tab.col("TIME") >= 1000  &&  tab.col("TIME") < 1100,
+                 100);
+    checkSelect (tab, tab.col("SCAN") == 3, 1000);
+    checkSelect (tab, tab.col("FIELD") == 3, 10);
+    checkSelect (tab, tab.col("TIME") < 10, 9);
+    checkSelect (tab, tab.col("ID") == idOffset + 4001, 1);
+    checkSelect (tab, tab.col("ID") > idOffset + 9990, 9);
+    checkSelect (tab, tab.col("ANT") == 3, 1000);
+    cout << "zone maps of new table are correct" << endl;
+}
+
+// Reopen the table and update it.
+void b()
+{
+    Table tab("tZoneMap_tmp.data", Table::Update);
+    checkZoneMap (tab, "TIME");
+    checkZoneMap (tab, "SCAN");
+    checkZoneMap (tab, "FIELD");
+    checkSelect (tab, tab.col("SCAN") == 3  &&  tab.col("TIME") >= 3500, 500);
+    Vector<rownr_t> starts;
+    Vector<Double> minv, maxv;
+    AlwaysAssertExit (! getZoneMap (tab, "ANT", starts, minv, maxv));
+    // Put a value out of order; it must be found.
+    ScalarColumn<Double> time(tab, "TIME");
+    ScalarColumn<Int> scan(tab, "SCAN");
+    ScalarColumn<Int> field(tab, "FIELD");
+    time.put (9000, 1050);
+    scan.put (100, 3);
+    field.put (5000, 3);
+    checkZoneMap (tab, "TIME");
+    checkZoneMap (tab, "FIELD");
+    checkSelect (tab, tab.col("TIME") >= 1000  &&  tab.col("TIME") < 1100,
+                 101);
+    checkSelect (tab, tab.col("SCAN") == 3, 1001);
+    checkSelect (tab, tab.col("FIELD") == 3, 11);
+    // Remove and add rows.
+    tab.removeRow (0);
+    tab.removeRow (2000);
+    tab.addRow (100);
+    for (uInt i=9998; i<10098; ++i) {
+        time.put (i, 20000+i);
+        scan.put (i, 20);
+        field.put (i, 3);
+    }
+    checkZoneMap (tab, "TIME");
+    checkZoneMap (tab, "SCAN");
+    checkZoneMap (tab, "FIELD");
+    checkSelect (tab, tab.col("SCAN") == 3, 1001);
+    checkSelect (tab, tab.col("SCAN") == 20, 100);
+    checkSelect (tab, tab.col("FIELD") == 3, 111);
+    checkSelect (tab, tab.col("TIME") > 25000, 100);
+    cout << "zone maps of updated table are correct" << endl;
+}
+
+// Reopen the table readonly and check the stored zone maps.
+void c()
+{
+    Table tab("tZoneMap_tmp.data");
+    AlwaysAssertExit (tab.nrow() == 10098);
+    // Only the storage managers keeping zone maps tell so.
+    Record dminfo = tab.dataManagerInfo();
+    for (uInt i=0; i<dminfo.nfields(); ++i) {
+        const Record& dm = dminfo.subRecord(i);
+        AlwaysAssertExit (dm.subRecord("SPEC").isDefined("ZoneMaps") ==
+                          (dm.asString("NAME") != "SSM2"));
+    }
+    checkZoneMap (tab, "TIME");
+    checkZoneMap (tab, "SCAN");
+    checkZoneMap (tab, "FIELD");
+    checkSelect (tab, tab.col("SCAN") == 20, 100);
+    checkSelect (tab, tab.col("FIELD") == 3, 111);
+    cout << "zone maps of reopened table are correct" << endl;
+}
+
+// Test a ZoneMap object directly.
+void d()
+{
+    AlwaysAssertExit (ZoneMap::isSupported (TpInt));
+    AlwaysAssertExit (ZoneMap::isSupported (TpBool));
+    AlwaysAssertExit (! ZoneMap::isSupported (TpComplex));
+    AlwaysAssertExit (ZoneMap::isSupported (TpInt64));
+    AlwaysAssertExit (! ZoneMap::isSupported (TpString));
+    ZoneMap zm(TpDouble);
+    AlwaysAssertExit (! zm.isChanged());
+}
+
+int main()
+{
+    try {
+        a();
+        b();
+        c();
+        d();
+    } catch (const std::exception& x) {
+        cout << "Exception caught: " << x.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -13,19 +13,7 @@ void DyscoDataColumn::Prepare(DyscoDistribution distribution,
   _normalization = normalization;
   ThreadedDyscoColumn::Prepare(distribution, normalization, studentsTNu,
                                distributionTruncation);
-  const size_t nPolarizations = shape()[0], nChannels = shape()[1];
-
-  switch (normalization) {
-    case Normalization::kAF:
-      _decoder.reset(new AFTimeBlockEncoder(nPolarizations, nChannels, true));
-      break;
-    case Normalization::kRF:
-      _decoder.reset(new RFTimeBlockEncoder(nPolarizations, nChannels));
-      break;
-    case Normalization::kRow:
-      _decoder.reset(new RowTimeBlockEncoder(nPolarizations, nChannels));
-      break;
-  }
+  _decoder = makeTimeBlockEncoder();
 
   switch (distribution) {
     case GaussianDistribution:
@@ -49,20 +37,8 @@ void DyscoDataColumn::Prepare(DyscoDistribution distribution,
   }
 }
 
-void DyscoDataColumn::initializeDecode(TimeBlockBuffer<data_t> * /*buffer*/,
-                                       const float *metaBuffer, size_t nRow,
-                                       size_t nAntennae) {
-  _decoder->InitializeDecode(metaBuffer, nRow, nAntennae);
-}
-
-void DyscoDataColumn::decode(TimeBlockBuffer<data_t> *buffer,
-                             const unsigned int *data, size_t blockRow,
-                             size_t a1, size_t a2) {
-  _decoder->Decode(*_gausEncoder, *buffer, data, blockRow, a1, a2);
-}
-
-std::unique_ptr<ThreadedDyscoColumn<std::complex<float>>::ThreadDataBase>
-DyscoDataColumn::initializeEncodeThread() {
+std::unique_ptr<TimeBlockEncoder> DyscoDataColumn::makeTimeBlockEncoder()
+    const {
   const size_t nPolarizations = shape()[0], nChannels = shape()[1];
   std::unique_ptr<TimeBlockEncoder> encoder;
   switch (_normalization) {
@@ -76,7 +52,35 @@ DyscoDataColumn::initializeEncodeThread() {
       encoder.reset(new RowTimeBlockEncoder(nPolarizations, nChannels));
       break;
   }
-  std::unique_ptr<ThreadData> newThreadData(new ThreadData(std::move(encoder)));
+  return encoder;
+}
+
+std::unique_ptr<ThreadedDyscoColumn<std::complex<float>>::ThreadDataBase>
+DyscoDataColumn::initializeDecodeThread() {
+  return std::unique_ptr<ThreadDataBase>(
+      new ThreadData(makeTimeBlockEncoder()));
+}
+
+void DyscoDataColumn::initializeDecode(ThreadDataBase *threadData,
+                                       TimeBlockBuffer<data_t> * /*buffer*/,
+                                       const float *metaBuffer, size_t nRow,
+                                       size_t nAntennae) {
+  ThreadData &data = static_cast<ThreadData &>(*threadData);
+  data.encoder->InitializeDecode(metaBuffer, nRow, nAntennae);
+}
+
+void DyscoDataColumn::decode(ThreadDataBase *threadData,
+                             TimeBlockBuffer<data_t> *buffer,
+                             const unsigned int *data, size_t blockRow,
+                             size_t a1, size_t a2) {
+  ThreadData &decoder = static_cast<ThreadData &>(*threadData);
+  decoder.encoder->Decode(*_gausEncoder, *buffer, data, blockRow, a1, a2);
+}
+
+std::unique_ptr<ThreadedDyscoColumn<std::complex<float>>::ThreadDataBase>
+DyscoDataColumn::initializeEncodeThread() {
+  std::unique_ptr<ThreadData> newThreadData(
+      new ThreadData(makeTimeBlockEncoder()));
   // Seed every thread from a random number
   if (_randomize)
     newThreadData->rnd.seed(_rnd());
@@ -104,13 +108,13 @@ size_t DyscoDataColumn::symbolCount(size_t nRowsInBlock, size_t nPolarizations,
   return _decoder->SymbolCount(nRowsInBlock, nPolarizations, nChannels);
 }
 
-size_t DyscoDataColumn::defaultThreadCount() const {
+size_t DyscoDataColumn::maxEncodingTaskCount() {
   if (!_randomize) {
     std::cout
         << "Warning: using only one thread to avoid randomizing the results.\n";
     return 1;
   } else {
-    return ThreadedDyscoColumn::defaultThreadCount();
+    return ThreadedDyscoColumn::maxEncodingTaskCount();
   }
 }
 
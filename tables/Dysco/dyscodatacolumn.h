@@ -48,11 +48,15 @@ class DyscoDataColumn final : public ThreadedDyscoColumn<std::complex<float>> {
   }
 
  protected:
-  virtual void initializeDecode(TimeBlockBuffer<data_t> *buffer,
+  virtual std::unique_ptr<ThreadDataBase> initializeDecodeThread() override;
+
+  virtual void initializeDecode(ThreadDataBase *threadData,
+                                TimeBlockBuffer<data_t> *buffer,
                                 const float *metaBuffer, size_t nRow,
                                 size_t nAntennae) override;
 
-  virtual void decode(TimeBlockBuffer<data_t> *buffer, const symbol_t *data,
+  virtual void decode(ThreadDataBase *threadData,
+                      TimeBlockBuffer<data_t> *buffer, const symbol_t *data,
                       size_t blockRow, size_t a1, size_t a2) override;
 
   virtual std::unique_ptr<ThreadDataBase> initializeEncodeThread() override;
@@ -68,9 +72,11 @@ class DyscoDataColumn final : public ThreadedDyscoColumn<std::complex<float>> {
   virtual size_t symbolCount(size_t nRowsInBlock, size_t nPolarizations,
                              size_t nChannels) const override;
 
-  virtual size_t defaultThreadCount() const override;
+  virtual size_t maxEncodingTaskCount() override;
 
  private:
+  std::unique_ptr<TimeBlockEncoder> makeTimeBlockEncoder() const;
+
   struct ThreadData final : public ThreadDataBase {
     ThreadData(std::unique_ptr<TimeBlockEncoder> timeBlockEncoder)
         : encoder(std::move(timeBlockEncoder)) {}
@@ -80,6 +86,8 @@ class DyscoDataColumn final : public ThreadedDyscoColumn<std::complex<float>> {
 
   std::mt19937 _rnd;
   std::unique_ptr<StochasticEncoder<float>> _gausEncoder;
+  // Only used for the sizes of blocks; decoding tasks have their own
+  // decoder.
   std::unique_ptr<TimeBlockEncoder> _decoder;
   DyscoDistribution _distribution;
   Normalization _normalization;
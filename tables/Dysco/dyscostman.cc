@@ -6,6 +6,10 @@
 
 #include "header.h"
 
+#include <unistd.h>
+
+#include <algorithm>
+
 void register_dyscostman() { dyscostman::DyscoStMan::registerClass(); }
 
 namespace dyscostman {
@@ -29,7 +33,8 @@ DyscoStMan::DyscoStMan(unsigned dataBitCount, unsigned weightBitCount,
       _normalization(Normalization::kAF),
       _studentTNu(0.0),
       _distributionTruncation(2.5),
-      _staticSeed(false) {}
+      _staticSeed(false),
+      _threadCount(0) {}
 
 DyscoStMan::DyscoStMan(const casacore::String &name,
                        const casacore::Record &spec)
@@ -47,7 +52,8 @@ DyscoStMan::DyscoStMan(const casacore::String &name,
       _normalization(Normalization::kAF),
       _studentTNu(0.0),
       _distributionTruncation(0.0),
-      _staticSeed(false) {
+      _staticSeed(false),
+      _threadCount(0) {
   setFromSpec(spec);
 }
 
@@ -66,7 +72,8 @@ DyscoStMan::DyscoStMan(const DyscoStMan &source)
       _normalization(source._normalization),
       _studentTNu(source._studentTNu),
       _distributionTruncation(source._distributionTruncation),
-      _staticSeed(source._staticSeed) {}
+      _staticSeed(source._staticSeed),
+      _threadCount(source._threadCount) {}
 
 void DyscoStMan::setFromSpec(const casacore::Record &spec) {
   // Here we need to load from _spec
@@ -106,6 +113,13 @@ void DyscoStMan::setFromSpec(const casacore::Record &spec) {
       _studentTNu = 0.0;
     _distributionTruncation = spec.asDouble("distributionTruncation");
   }
+  if (spec.description().fieldNumber("threadCount") >= 0) {
+    const int threadCount = spec.asInt("threadCount");
+    if (threadCount < 0)
+      throw DyscoStManError("Invalid thread count specified: " +
+                            std::to_string(threadCount));
+    _threadCount = threadCount;
+  }
 }
 
 void DyscoStMan::makeEmpty() {
@@ -152,9 +166,39 @@ casacore::Record DyscoStMan::dataManagerSpec() const {
   spec.define("normalization", normStr);
   spec.define("studentTNu", _studentTNu);
   spec.define("distributionTruncation", _distributionTruncation);
+  spec.define("threadCount", int(_threadCount));
   return spec;
 }
 
+casacore::Record DyscoStMan::getProperties() const {
+  casacore::Record properties;
+  properties.define("threadCount", int(_threadCount));
+  return properties;
+}
+
+void DyscoStMan::setProperties(const casacore::Record &properties) {
+  if (properties.isDefined("threadCount")) {
+    const int threadCount = properties.asInt("threadCount");
+    if (threadCount < 0)
+      throw DyscoStManError("Invalid thread count specified: " +
+                            std::to_string(threadCount));
+    _threadCount = threadCount;
+  }
+}
+
+size_t DyscoStMan::ThreadCount() const {
+  if (_threadCount != 0) return _threadCount;
+  // Don't spawn more than 8 threads; it causes problems in NDPPP.
+  // sysconf returns -1 if the number of processors cannot be determined.
+  return std::max(1l, std::min(8l, sysconf(_SC_NPROCESSORS_ONLN)));
+}
+
+ThreadPool &DyscoStMan::threadPool() {
+  std::lock_guard<std::mutex> lock(_threadPoolMutex);
+  if (!_threadPool) _threadPool.reset(new ThreadPool(ThreadCount()));
+  return *_threadPool;
+}
+
 void DyscoStMan::registerClass() {
   DataManager::registerCtor("DyscoStMan", makeObject);
 }
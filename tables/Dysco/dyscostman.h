@@ -13,7 +13,7 @@
 
 #include "dyscodistribution.h"
 #include "dysconormalization.h"
-#include "threadgroup.h"
+#include "threadpool.h"
 #include "uvector.h"
 
 /**
@@ -124,6 +124,21 @@ class DyscoStMan : public casacore::DataManager {
 
   void SetStaticSeed(bool staticSeed) { _staticSeed = staticSeed; }
 
+  /**
+   * Set the number of threads used for encoding and decoding. All columns of
+   * this storage manager share these threads. This method should only be
+   * called directly after creating DyscoStMan, before reading/writing data.
+   * @param threadCount Number of threads, or zero to use the default of one
+   * thread per core with a maximum of 8.
+   */
+  void SetThreadCount(size_t threadCount) { _threadCount = threadCount; }
+
+  /**
+   * Get the number of threads that are used for encoding and decoding.
+   * @returns Size of the thread pool shared by the columns.
+   */
+  size_t ThreadCount() const;
+
   /**
    * This constructor is called by Casa when it needs to create a DyscoStMan.
    * Casa will call makeObject() that will call this constructor.
@@ -176,6 +191,19 @@ class DyscoStMan : public casacore::DataManager {
    */
   virtual casacore::Record dataManagerSpec() const final override;
 
+  /** Get the modifiable properties (the thread count).
+   * @returns Record containing the field "threadCount".
+   */
+  virtual casacore::Record getProperties() const final override;
+
+  /** Set the modifiable properties. Only the field "threadCount" is used
+   * (see SetThreadCount()). Like SetThreadCount(), it should be called
+   * before data is read or written, because the thread pool is only
+   * created once.
+   * @param properties Record with the properties to set.
+   */
+  virtual void setProperties(const casacore::Record &properties) final override;
+
   /**
    * Get the number of rows in the measurement set.
    * @returns Number of rows in the measurement set.
@@ -309,6 +337,12 @@ class DyscoStMan : public casacore::DataManager {
 
   const static unsigned short VERSION_MAJOR, VERSION_MINOR;
 
+  /**
+   * The pool of threads shared by all columns. It is created when it is
+   * first needed.
+   */
+  ThreadPool &threadPool();
+
   void readCompressedData(size_t blockIndex, const DyscoStManColumn *column,
                           unsigned char *dest, size_t size);
 
@@ -400,7 +434,12 @@ class DyscoStMan : public casacore::DataManager {
   Normalization _normalization;
   double _studentTNu, _distributionTruncation;
   bool _staticSeed;
+  size_t _threadCount;
 
+  // The columns have to be destructed before the thread pool, because their
+  // remaining tasks are finished on destruction.
+  std::mutex _threadPoolMutex;
+  std::unique_ptr<ThreadPool> _threadPool;
   std::vector<std::unique_ptr<DyscoStManColumn>> _columns;
 };
 
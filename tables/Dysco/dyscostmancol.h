@@ -14,6 +14,7 @@
 namespace dyscostman {
 
 class DyscoStMan;
+class ThreadPool;
 
 /**
  * Base class for columns of the DyscoStMan.
@@ -95,6 +96,12 @@ class DyscoStManColumn : public casacore::StManColumnBase {
    */
   uint64_t nBlocksInFile() const;
 
+  /**
+   * Get the pool of threads that the columns of the storage manager share for
+   * encoding and decoding.
+   */
+  ThreadPool &threadPool();
+
   size_t getBlockIndex(uint64_t row) const;
 
   size_t getRowWithinBlock(uint64_t row) const;
@@ -135,6 +142,10 @@ inline void DyscoStManColumn::writeCompressedData(size_t blockIndex,
   _storageManager->writeCompressedData(blockIndex, this, data, size);
 }
 
+inline ThreadPool &DyscoStManColumn::threadPool() {
+  return _storageManager->threadPool();
+}
+
 inline uint64_t DyscoStManColumn::nBlocksInFile() const {
   return _storageManager->nBlocksInFile();
 }
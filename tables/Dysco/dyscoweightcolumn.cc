@@ -12,17 +12,25 @@ void DyscoWeightColumn::Prepare(DyscoDistribution distribution,
                                         1 << getBitsPerSymbol()));
 }
 
-void DyscoWeightColumn::initializeDecode(TimeBlockBuffer<data_t> * /*buffer*/,
+std::unique_ptr<ThreadedDyscoColumn<float>::ThreadDataBase>
+DyscoWeightColumn::initializeDecodeThread() {
+  return std::unique_ptr<ThreadDataBase>(new DecoderData(*_encoder));
+}
+
+void DyscoWeightColumn::initializeDecode(ThreadDataBase *threadData,
+                                         TimeBlockBuffer<data_t> * /*buffer*/,
                                          const float *metaBuffer,
                                          size_t /*nRow*/,
                                          size_t /*nAntennae*/) {
-  _encoder->InitializeDecode(metaBuffer);
+  static_cast<DecoderData &>(*threadData).decoder.InitializeDecode(metaBuffer);
 }
 
-void DyscoWeightColumn::decode(TimeBlockBuffer<data_t> *buffer,
+void DyscoWeightColumn::decode(ThreadDataBase *threadData,
+                               TimeBlockBuffer<data_t> *buffer,
                                const unsigned int *data, size_t blockRow,
                                size_t /*a1*/, size_t /*a2*/) {
-  _encoder->Decode(*buffer, data, blockRow);
+  static_cast<DecoderData &>(*threadData).decoder.Decode(*buffer, data,
+                                                         blockRow);
 }
 
 void DyscoWeightColumn::encode(ThreadDataBase * /*threadData*/,
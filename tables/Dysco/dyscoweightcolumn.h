@@ -35,11 +35,15 @@ class DyscoWeightColumn final : public ThreadedDyscoColumn<float> {
                        double distributionTruncation) override;
 
  protected:
-  virtual void initializeDecode(TimeBlockBuffer<data_t> *buffer,
+  virtual std::unique_ptr<ThreadDataBase> initializeDecodeThread() override;
+
+  virtual void initializeDecode(ThreadDataBase *threadData,
+                                TimeBlockBuffer<data_t> *buffer,
                                 const float *metaBuffer, size_t nRow,
                                 size_t nAntennae) override;
 
-  virtual void decode(TimeBlockBuffer<data_t> *buffer, const symbol_t *data,
+  virtual void decode(ThreadDataBase *threadData,
+                      TimeBlockBuffer<data_t> *buffer, const symbol_t *data,
                       size_t blockRow, size_t a1, size_t a2) override;
 
   virtual std::unique_ptr<ThreadDataBase> initializeEncodeThread() override {
@@ -62,6 +66,14 @@ class DyscoWeightColumn final : public ThreadedDyscoColumn<float> {
   }
 
  private:
+  // The decoder stores the scale of the block that is being decoded, so
+  // every decoding task has its own copy.
+  struct DecoderData final : public ThreadDataBase {
+    explicit DecoderData(const WeightBlockEncoder &encoder)
+        : decoder(encoder) {}
+    WeightBlockEncoder decoder;
+  };
+
   std::unique_ptr<WeightBlockEncoder> _encoder;
 };
 
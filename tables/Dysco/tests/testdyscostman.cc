@@ -10,6 +10,7 @@
 #include <casacore/tables/Tables/ScaColDesc.h>
 
 #include "../dyscostman.h"
+#include "../dyscostmanerror.h"
 
 using namespace casacore;
 using namespace dyscostman;
@@ -27,17 +28,23 @@ casacore::Record GetDyscoSpec() {
 }
 
 struct TestTableFixture {
-  explicit TestTableFixture(size_t nAnt) {
+  explicit TestTableFixture(size_t nAnt, size_t nTime = 2,
+                            const Record& spec = GetDyscoSpec()) {
     casacore::TableDesc tableDesc;
     IPosition shape(2, 1, 1);
     casacore::ArrayColumnDesc<casacore::Complex> columnDesc(
         "DATA", "", "DyscoStMan", "", shape);
     columnDesc.setOptions(casacore::ColumnDesc::Direct |
                           casacore::ColumnDesc::FixedShape);
+    casacore::ArrayColumnDesc<casacore::Complex> modelDesc(
+        "MODEL_DATA", "", "DyscoStMan", "", shape);
+    modelDesc.setOptions(casacore::ColumnDesc::Direct |
+                         casacore::ColumnDesc::FixedShape);
     casacore::ScalarColumnDesc<int> ant1Desc("ANTENNA1"), ant2Desc("ANTENNA2"),
         fieldDesc("FIELD_ID"), dataDescIdDesc("DATA_DESC_ID");
     casacore::ScalarColumnDesc<double> timeDesc("TIME");
     tableDesc.addColumn(columnDesc);
+    tableDesc.addColumn(modelDesc);
     tableDesc.addColumn(ant1Desc);
     tableDesc.addColumn(ant2Desc);
     tableDesc.addColumn(fieldDesc);
@@ -49,13 +56,14 @@ struct TestTableFixture {
     register_dyscostman();
     DataManagerCtor dyscoConstructor = DataManager::getCtor("DyscoStMan");
     std::unique_ptr<DataManager> dysco(
-        dyscoConstructor("DATA_dm", GetDyscoSpec()));
+        dyscoConstructor("DATA_dm", spec));
     setupNewTable.bindColumn("DATA", *dysco);
+    setupNewTable.bindColumn("MODEL_DATA", *dysco);
     casacore::Table newTable(setupNewTable);
 
     size_t a1 = 0, a2 = 1;
     double time = 10.0;
-    const size_t nRow = 2 * nAnt * (nAnt - 1) / 2;
+    const size_t nRow = nTime * nAnt * (nAnt - 1) / 2;
     newTable.addRow(nRow);
     casacore::ScalarColumn<int> a1Col(newTable, "ANTENNA1"),
         a2Col(newTable, "ANTENNA2"), fieldCol(newTable, "FIELD_ID"),
@@ -79,11 +87,14 @@ struct TestTableFixture {
       }
     }
 
-    casacore::ArrayColumn<casacore::Complex> dataCol(newTable, "DATA");
+    casacore::ArrayColumn<casacore::Complex> dataCol(newTable, "DATA"),
+        modelCol(newTable, "MODEL_DATA");
     for (size_t i = 0; i != nRow; ++i) {
       casacore::Array<casacore::Complex> arr(shape);
       *arr.cbegin() = i;
       dataCol.put(i, arr);
+      *arr.cbegin() = casacore::Complex(0, i);
+      modelCol.put(i, arr);
     }
   }
   ~TestTableFixture() { boost::filesystem::remove_all("TestTable"); }
@@ -94,6 +105,24 @@ BOOST_AUTO_TEST_CASE(spec) {
   Record spec = dysco.dataManagerSpec();
   BOOST_CHECK_EQUAL(spec.asInt("dataBitCount"), 8);
   BOOST_CHECK_EQUAL(spec.asInt("weightBitCount"), 12);
+  BOOST_CHECK_EQUAL(spec.asInt("threadCount"), 0);
+
+  dysco.SetThreadCount(3);
+  BOOST_CHECK_EQUAL(dysco.ThreadCount(), 3u);
+  BOOST_CHECK_EQUAL(dysco.dataManagerSpec().asInt("threadCount"), 3);
+
+  Record threadSpec = GetDyscoSpec();
+  threadSpec.define("threadCount", 2);
+  DyscoStMan fromSpec("withthreads", threadSpec);
+  BOOST_CHECK_EQUAL(fromSpec.ThreadCount(), 2u);
+
+  Record properties;
+  properties.define("threadCount", 5);
+  fromSpec.setProperties(properties);
+  BOOST_CHECK_EQUAL(fromSpec.ThreadCount(), 5u);
+  BOOST_CHECK_EQUAL(fromSpec.getProperties().asInt("threadCount"), 5);
+  properties.define("threadCount", -1);
+  BOOST_CHECK_THROW(fromSpec.setProperties(properties), DyscoStManError);
 }
 
 BOOST_AUTO_TEST_CASE(name) {
@@ -142,6 +171,34 @@ BOOST_AUTO_TEST_CASE(maketable) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(multiple_columns) {
+  // Many time blocks and two columns that share the thread pool, such that
+  // blocks of both columns are encoded at the same time, and sequential
+  // reading decodes blocks ahead.
+  const size_t nAnt = 4, nTime = 50;
+  Record spec = GetDyscoSpec();
+  spec.define("threadCount", 3);
+  TestTableFixture fixture(nAnt, nTime, spec);
+
+  casacore::Table table("TestTable");
+  BOOST_REQUIRE_EQUAL(table.nrow(), nTime * nAnt * (nAnt - 1) / 2);
+  casacore::ArrayColumn<casacore::Complex> dataCol(table, "DATA"),
+      modelCol(table, "MODEL_DATA");
+  std::vector<casacore::Complex> data(table.nrow());
+  for (size_t i = 0; i != table.nrow(); ++i) {
+    data[i] = *dataCol(i).cbegin();
+    // The values of a baseline differ in a time block, so the encoding is
+    // lossy.
+    BOOST_CHECK_SMALL(data[i].real() - float(i), 0.01f * float(i) + 0.01f);
+    BOOST_CHECK_SMALL((*modelCol(i).cbegin()).imag() - float(i),
+                      0.01f * float(i) + 0.01f);
+  }
+  // Reading backwards does not read ahead, and should decode the same values.
+  for (size_t i = table.nrow(); i != 0; --i) {
+    BOOST_CHECK_EQUAL(*dataCol(i - 1).cbegin(), data[i - 1]);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(read_past_end) {
   /**
    * While reading past the end of a file might seem wrong in any case, it can
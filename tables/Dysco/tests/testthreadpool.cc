@@ -0,0 +1,62 @@
+#include "../threadpool.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+using namespace dyscostman;
+
+BOOST_AUTO_TEST_SUITE(threadpool)
+
+BOOST_AUTO_TEST_CASE(size) {
+  ThreadPool pool(3);
+  BOOST_CHECK_EQUAL(pool.Size(), 3u);
+  ThreadPool minimal(0);
+  BOOST_CHECK_EQUAL(minimal.Size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(finishes_tasks) {
+  std::atomic<size_t> count(0);
+  {
+    ThreadPool pool(4);
+    for (size_t i = 0; i != 1000; ++i) pool.Submit([&count]() { ++count; });
+  }
+  BOOST_CHECK_EQUAL(count.load(), 1000u);
+}
+
+BOOST_AUTO_TEST_CASE(nested_submit) {
+  // Tasks that are submitted by a worker are added to its own queue, but
+  // should be stolen by the other workers.
+  std::atomic<size_t> count(0);
+  {
+    ThreadPool pool(4);
+    pool.Submit([&pool, &count]() {
+      for (size_t i = 0; i != 100; ++i) pool.Submit([&count]() { ++count; });
+    });
+  }
+  BOOST_CHECK_EQUAL(count.load(), 100u);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_tasks) {
+  // All threads must be running at the same time for this test to finish.
+  const size_t nThreads = 4;
+  std::mutex mutex;
+  std::condition_variable condition;
+  size_t nWaiting = 0;
+  {
+    ThreadPool pool(nThreads);
+    for (size_t i = 0; i != nThreads; ++i) {
+      pool.Submit([&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        ++nWaiting;
+        condition.notify_all();
+        while (nWaiting != nThreads) condition.wait(lock);
+      });
+    }
+  }
+  BOOST_CHECK_EQUAL(nWaiting, nThreads);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -4,12 +4,14 @@
 #include "dyscostmanerror.h"
 
 #include "bytepacker.h"
-#include "threadgroup.h"
+#include "threadpool.h"
 
+#include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/ms/MeasurementSets/MeasurementSet.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 
 #include <algorithm>
+#include <iostream>
 #include <limits>
 
 namespace dyscostman {
@@ -22,10 +24,12 @@ ThreadedDyscoColumn<DataType>::ThreadedDyscoColumn(DyscoStMan *parent,
       _ant1Col(),
       _ant2Col(),
       _fieldCol(),
-      _packedBlockReadBuffer(),
-      _unpackedSymbolReadBuffer(),
-      _stopThreads(false),
+      _isEncodingStarted(false),
+      _maxEncodingTasks(0),
+      _encodingTaskCount(0),
+      _decodingTaskCount(0),
       _currentBlock(std::numeric_limits<size_t>::max()),
+      _lastLoadedBlock(std::numeric_limits<size_t>::max()),
       _isCurrentBlockChanged(false),
       _blockSize(0),
       _antennaCount(0),
@@ -36,9 +40,14 @@ ThreadedDyscoColumn<DataType>::ThreadedDyscoColumn(DyscoStMan *parent,
 // called to empty the cache.
 template <typename DataType>
 void ThreadedDyscoColumn<DataType>::shutdown() {
-  if (_isCurrentBlockChanged) storeBlock();
+  // This is called from destructors, so errors can not be thrown.
+  try {
+    if (_isCurrentBlockChanged) storeBlock();
 
-  stopThreads();
+    stopThreads();
+  } catch (std::exception &e) {
+    std::cerr << "Error while writing DyscoStMan data: " << e.what() << '\n';
+  }
 }
 
 template <typename DataType>
@@ -50,22 +59,27 @@ template <typename DataType>
 void ThreadedDyscoColumn<DataType>::stopThreads() {
   std::unique_lock<std::mutex> lock(_mutex);
 
-  if (_threadGroup.empty()) {
+  if (!_isEncodingStarted) {
     if (!_cache.empty())
       throw DyscoStManError(
           "DyscoStMan is flushed before at least two timeblocks were stored. "
           "DyscoStMan can not handle this situation.");
   } else {
-    // Don't stop threads before cache is empty
-    while (!_cache.empty()) _cacheChangedCondition.wait(lock);
-
-    // Signal threads to stop
-    _stopThreads = true;
-    _cacheChangedCondition.notify_all();
-
-    // Wait for threads to end
-    lock.unlock();
-    _threadGroup.join_all();
+    // Wait until the cache is empty and all encoding tasks have finished
+    while (!_cache.empty() || _encodingTaskCount != 0)
+      _cacheChangedCondition.wait(lock);
+    _isEncodingStarted = false;
+  }
+  while (_decodingTaskCount != 0) _cacheChangedCondition.wait(lock);
+  _decodeCache.clear();
+  _encodingData.clear();
+  _decodingData.clear();
+  _lastLoadedBlock = std::numeric_limits<size_t>::max();
+
+  if (_encodingError) {
+    std::exception_ptr error = _encodingError;
+    _encodingError = nullptr;
+    std::rethrow_exception(error);
   }
 }
 
@@ -75,34 +89,157 @@ void ThreadedDyscoColumn<DataType>::setShapeColumn(
   _shape = shape;
 }
 
+template <typename DataType>
+void ThreadedDyscoColumn<DataType>::decodeBlock(
+    size_t blockIndex, const casacore::Vector<int> &antenna1,
+    const casacore::Vector<int> &antenna2, TimeBlockBuffer<data_t> &buffer,
+    TaskData &taskData) {
+  readCompressedData(blockIndex, taskData.packedSymbolBuffer.data(),
+                     _blockSize);
+  const size_t nPolarizations = _shape[0], nChannels = _shape[1],
+               nRows = nRowsInBlock(),
+               nMetaFloats = metaDataFloatCount(nRows, nPolarizations,
+                                                nChannels, _antennaCount);
+  unsigned char *symbolStart =
+      taskData.packedSymbolBuffer.data() + nMetaFloats * sizeof(float);
+  BytePacker::unpack(_bitsPerSymbol, taskData.unpackedSymbolBuffer.data(),
+                     symbolStart,
+                     symbolCount(nRows, nPolarizations, nChannels));
+  float *metaData =
+      reinterpret_cast<float *>(taskData.packedSymbolBuffer.data());
+  initializeDecode(taskData.threadData.get(), &buffer, metaData, nRows,
+                   _antennaCount);
+  buffer.resize(nRows);
+  for (size_t blockRow = 0; blockRow != nRows; ++blockRow) {
+    decode(taskData.threadData.get(), &buffer,
+           taskData.unpackedSymbolBuffer.data(), blockRow, antenna1[blockRow],
+           antenna2[blockRow]);
+  }
+}
+
 template <typename DataType>
 void ThreadedDyscoColumn<DataType>::loadBlock(size_t blockIndex) {
   if (blockIndex < nBlocksInFile()) {
-    readCompressedData(blockIndex, _packedBlockReadBuffer.data(), _blockSize);
-    const size_t nPolarizations = _shape[0], nChannels = _shape[1],
-                 nRows = nRowsInBlock(),
-                 nMetaFloats = metaDataFloatCount(nRows, nPolarizations,
-                                                  nChannels, _antennaCount);
-    unsigned char *symbolStart =
-        _packedBlockReadBuffer.data() + nMetaFloats * sizeof(float);
-    BytePacker::unpack(_bitsPerSymbol, _unpackedSymbolReadBuffer.data(),
-                       symbolStart,
-                       symbolCount(nRows, nPolarizations, nChannels));
-    float *metaData = reinterpret_cast<float *>(_packedBlockReadBuffer.data());
-    initializeDecode(_timeBlockBuffer.get(), metaData, nRows, _antennaCount);
-    uint64_t startRow = getRowIndex(blockIndex);
-    _timeBlockBuffer->resize(nRows);
-    for (size_t blockRow = 0; blockRow != nRows; ++blockRow) {
-      int a1 = (*_ant1Col)(startRow + blockRow),
-          a2 = (*_ant2Col)(startRow + blockRow);
-      decode(_timeBlockBuffer.get(), _unpackedSymbolReadBuffer.data(), blockRow,
-             a1, a2);
+    std::unique_lock<std::mutex> lock(_mutex);
+    typename decode_cache_t::iterator decoded = _decodeCache.find(blockIndex);
+    if (decoded != _decodeCache.end()) {
+      // The block was read ahead: wait until its decoding task is done
+      while (!decoded->second->isReady) _cacheChangedCondition.wait(lock);
+      std::unique_ptr<DecodedBlock> block = std::move(decoded->second);
+      _decodeCache.erase(decoded);
+      lock.unlock();
+      if (block->error) std::rethrow_exception(block->error);
+      _timeBlockBuffer = std::move(block->buffer);
+    } else {
+      std::unique_ptr<TaskData> taskData = acquireTaskData(false);
+      lock.unlock();
+      const casacore::Slicer rows(casacore::IPosition(1, getRowIndex(blockIndex)),
+                                  casacore::IPosition(1, nRowsInBlock()));
+      decodeBlock(blockIndex, _ant1Col->getColumnRange(rows),
+                  _ant2Col->getColumnRange(rows), *_timeBlockBuffer,
+                  *taskData);
+      lock.lock();
+      _decodingData.emplace_back(std::move(taskData));
+      lock.unlock();
     }
+    // Decode the next blocks in parallel when the blocks are read in order
+    if (_lastLoadedBlock + 1 == blockIndex) readAhead(blockIndex + 1);
+    _lastLoadedBlock = blockIndex;
   }
   _currentBlock = blockIndex;
   _isCurrentBlockChanged = false;
 }
 
+template <typename DataType>
+void ThreadedDyscoColumn<DataType>::readAhead(size_t firstBlock) {
+  const size_t endBlock =
+      std::min<size_t>(nBlocksInFile(), firstBlock + threadPool().Size());
+  std::vector<size_t> blocks;
+  std::unique_lock<std::mutex> lock(_mutex);
+  // Remove blocks that were read ahead but skipped
+  typename decode_cache_t::iterator i = _decodeCache.begin();
+  while (i != _decodeCache.end() && i->first < firstBlock) {
+    if (i->second->isReady)
+      i = _decodeCache.erase(i);
+    else
+      ++i;
+  }
+  // Blocks in the write cache are not read, because their data on disk is
+  // about to change.
+  for (size_t block = firstBlock; block < endBlock; ++block) {
+    if (_decodeCache.count(block) == 0 && _cache.count(block) == 0)
+      blocks.push_back(block);
+  }
+  lock.unlock();
+
+  const size_t nPolarizations = _shape[0], nChannels = _shape[1];
+  std::vector<std::unique_ptr<DecodedBlock>> decodedBlocks;
+  for (size_t block : blocks) {
+    // The antenna columns are read here, because the table can not be
+    // accessed from multiple threads.
+    std::unique_ptr<DecodedBlock> decoded(new DecodedBlock());
+    const casacore::Slicer rows(casacore::IPosition(1, getRowIndex(block)),
+                                casacore::IPosition(1, nRowsInBlock()));
+    decoded->antenna1 = _ant1Col->getColumnRange(rows);
+    decoded->antenna2 = _ant2Col->getColumnRange(rows);
+    decoded->buffer.reset(
+        new TimeBlockBuffer<data_t>(nPolarizations, nChannels));
+    decodedBlocks.emplace_back(std::move(decoded));
+  }
+
+  lock.lock();
+  for (size_t index = 0; index != blocks.size(); ++index) {
+    const size_t block = blocks[index];
+    DecodedBlock &decoded = *decodedBlocks[index];
+    _decodeCache.emplace(block, std::move(decodedBlocks[index]));
+    ++_decodingTaskCount;
+    threadPool().Submit(
+        [this, block, &decoded]() { decodingTask(block, decoded); });
+  }
+}
+
+template <typename DataType>
+void ThreadedDyscoColumn<DataType>::decodingTask(size_t blockIndex,
+                                                 DecodedBlock &block) {
+  std::unique_lock<std::mutex> lock(_mutex);
+  std::unique_ptr<TaskData> taskData;
+  try {
+    taskData = acquireTaskData(false);
+    lock.unlock();
+    decodeBlock(blockIndex, block.antenna1, block.antenna2, *block.buffer,
+                *taskData);
+    lock.lock();
+  } catch (...) {
+    if (!lock.owns_lock()) lock.lock();
+    block.error = std::current_exception();
+  }
+  if (taskData) _decodingData.emplace_back(std::move(taskData));
+  block.isReady = true;
+  --_decodingTaskCount;
+  _cacheChangedCondition.notify_all();
+}
+
+// This function should only be called with a locked mutex
+template <typename DataType>
+std::unique_ptr<typename ThreadedDyscoColumn<DataType>::TaskData>
+ThreadedDyscoColumn<DataType>::acquireTaskData(bool forEncoding) {
+  std::vector<std::unique_ptr<TaskData>> &available =
+      forEncoding ? _encodingData : _decodingData;
+  if (!available.empty()) {
+    std::unique_ptr<TaskData> taskData = std::move(available.back());
+    available.pop_back();
+    return taskData;
+  }
+  const size_t nPolarizations = _shape[0], nChannels = _shape[1];
+  std::unique_ptr<TaskData> taskData(new TaskData());
+  taskData->threadData =
+      forEncoding ? initializeEncodeThread() : initializeDecodeThread();
+  taskData->packedSymbolBuffer.resize(_blockSize);
+  taskData->unpackedSymbolBuffer.resize(
+      symbolCount(nRowsInBlock(), nPolarizations, nChannels));
+  return taskData;
+}
+
 template <typename DataType>
 void ThreadedDyscoColumn<DataType>::getValues(
     casacore::rownr_t rowNr, casacore::Array<DataType> *dataArr) {
@@ -155,7 +292,14 @@ void ThreadedDyscoColumn<DataType>::storeBlock() {
     _cacheChangedCondition.wait(lock);
     cacheItemPtr = _cache.find(_currentBlock);
   }
+  if (_encodingError) {
+    delete item;
+    std::exception_ptr error = _encodingError;
+    _encodingError = nullptr;
+    std::rethrow_exception(error);
+  }
   _cache.insert(typename cache_t::value_type(_currentBlock, item));
+  scheduleEncoding();
   _cacheChangedCondition.notify_all();
   lock.unlock();
 
@@ -240,9 +384,8 @@ void ThreadedDyscoColumn<DataType>::Prepare(DyscoDistribution, Normalization,
 }
 
 template <typename DataType>
-size_t ThreadedDyscoColumn<DataType>::defaultThreadCount() const {
-  // Don't spawn more than 8 threads; it causes problems in NDPPP
-  return std::min(8l, sysconf(_SC_NPROCESSORS_ONLN));
+size_t ThreadedDyscoColumn<DataType>::maxEncodingTaskCount() {
+  return threadPool().Size();
 }
 
 template <typename DataType>
@@ -254,24 +397,18 @@ void ThreadedDyscoColumn<DataType>::InitializeAfterNRowsPerBlockIsKnown() {
 
   _antennaCount = nAntennae();
   _blockSize = CalculateBlockSize(nRowsInBlock(), _antennaCount);
-  _packedBlockReadBuffer.resize(_blockSize);
-  const size_t nPolarizations = _shape[0], nChannels = _shape[1];
-  _unpackedSymbolReadBuffer.resize(
-      symbolCount(nRowsInBlock(), nPolarizations, nChannels));
   // TODO _timeBlockEncoder->SetNAntennae(_antennaCount);
 
-  // start the threads
-  size_t threadCount = defaultThreadCount();
-  EncodingThreadFunctor functor;
-  functor.parent = this;
-  _stopThreads = false;
-  for (size_t i = 0; i != threadCount; ++i) _threadGroup.create_thread(functor);
+  // Allow encoding tasks to start
+  std::lock_guard<std::mutex> lock(_mutex);
+  _maxEncodingTasks = maxEncodingTaskCount();
+  _isEncodingStarted = true;
 }
 
 template <typename DataType>
-void ThreadedDyscoColumn<DataType>::encodeAndWrite(
-    size_t blockIndex, const CacheItem &item, unsigned char *packedSymbolBuffer,
-    unsigned int *unpackedSymbolBuffer, ThreadDataBase *threadUserData) {
+void ThreadedDyscoColumn<DataType>::encodeAndWrite(size_t blockIndex,
+                                                   const CacheItem &item,
+                                                   TaskData &taskData) {
   const size_t nPolarizations = _shape[0], nChannels = _shape[1];
   const size_t metaDataSize =
       sizeof(float) * metaDataFloatCount(nRowsInBlock(), nPolarizations,
@@ -279,11 +416,13 @@ void ThreadedDyscoColumn<DataType>::encodeAndWrite(
   const size_t nSymbols =
       symbolCount(nRowsInBlock(), nPolarizations, nChannels);
 
+  unsigned char *packedSymbolBuffer = taskData.packedSymbolBuffer.data();
+  unsigned int *unpackedSymbolBuffer = taskData.unpackedSymbolBuffer.data();
   float *metaBuffer = reinterpret_cast<float *>(packedSymbolBuffer);
   unsigned char *binaryBuffer = packedSymbolBuffer + metaDataSize;
 
-  encode(threadUserData, item.encoder.get(), metaBuffer, unpackedSymbolBuffer,
-         _antennaCount);
+  encode(taskData.threadData.get(), item.encoder.get(), metaBuffer,
+         unpackedSymbolBuffer, _antennaCount);
 
   BytePacker::pack(_bitsPerSymbol, binaryBuffer, unpackedSymbolBuffer,
                    nSymbols);
@@ -293,46 +432,57 @@ void ThreadedDyscoColumn<DataType>::encodeAndWrite(
                       metaDataSize + binarySize);
 }
 
-// Continuously write items from the cache into the measurement
-// set untill asked to quit.
+// This function should only be called with a locked mutex
+template <typename DataType>
+void ThreadedDyscoColumn<DataType>::scheduleEncoding() {
+  if (!_isEncodingStarted) return;
+  size_t nWaiting = 0;
+  for (const typename cache_t::value_type &item : _cache) {
+    if (!item.second->isBeingWritten) ++nWaiting;
+  }
+  while (_encodingTaskCount < _maxEncodingTasks &&
+         _encodingTaskCount < nWaiting) {
+    ++_encodingTaskCount;
+    threadPool().Submit([this]() { encodingTask(); });
+  }
+}
+
+// Write items from the cache into the measurement set until no more items
+// are waiting.
 template <typename DataType>
-void ThreadedDyscoColumn<DataType>::EncodingThreadFunctor::operator()() {
-  const size_t nPolarizations = parent->_shape[0],
-               nChannels = parent->_shape[1];
-  const size_t nSymbols =
-      parent->symbolCount(parent->nRowsInBlock(), nPolarizations, nChannels);
-
-  std::unique_lock<std::mutex> lock(parent->_mutex);
-  ao::uvector<unsigned char> packedSymbolBuffer(parent->_blockSize);
-  ao::uvector<unsigned> unpackedSymbolBuffer(nSymbols);
-  cache_t &cache = parent->_cache;
-
-  std::unique_ptr<ThreadDataBase> threadUserData =
-      parent->initializeEncodeThread();
-
-  while (!parent->_stopThreads) {
-    typename cache_t::iterator i;
-    bool isItemAvailable = parent->isWriteItemAvailable(i);
-    while (!isItemAvailable && !parent->_stopThreads) {
-      parent->_cacheChangedCondition.wait(lock);
-      isItemAvailable = parent->isWriteItemAvailable(i);
-    }
+void ThreadedDyscoColumn<DataType>::encodingTask() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  std::unique_ptr<TaskData> taskData;
+  try {
+    taskData = acquireTaskData(true);
+  } catch (...) {
+    if (!_encodingError) _encodingError = std::current_exception();
+  }
 
-    if (isItemAvailable) {
-      size_t blockIndex = i->first;
-      CacheItem &item = *i->second;
-      item.isBeingWritten = true;
+  typename cache_t::iterator i;
+  while (isWriteItemAvailable(i)) {
+    size_t blockIndex = i->first;
+    CacheItem &item = *i->second;
+    item.isBeingWritten = true;
 
+    if (taskData) {
       lock.unlock();
-      parent->encodeAndWrite(blockIndex, item, &packedSymbolBuffer[0],
-                             &unpackedSymbolBuffer[0], threadUserData.get());
-
-      lock.lock();
-      delete &item;
-      cache.erase(i);
-      parent->_cacheChangedCondition.notify_all();
+      try {
+        encodeAndWrite(blockIndex, item, *taskData);
+        lock.lock();
+      } catch (...) {
+        lock.lock();
+        if (!_encodingError) _encodingError = std::current_exception();
+      }
     }
+
+    delete &item;
+    _cache.erase(i);
+    _cacheChangedCondition.notify_all();
   }
+  if (taskData) _encodingData.emplace_back(std::move(taskData));
+  --_encodingTaskCount;
+  _cacheChangedCondition.notify_all();
 }
 
 // This function should only be called with a locked mutex
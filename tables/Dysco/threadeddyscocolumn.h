@@ -8,15 +8,16 @@
 
 #include <condition_variable>
 #include <cstdint>
+#include <exception>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <random>
+#include <vector>
 
 #include "dyscostmancol.h"
 #include "serializable.h"
 #include "stochasticencoder.h"
-#include "threadgroup.h"
 #include "timeblockbuffer.h"
 
 namespace dyscostman {
@@ -26,6 +27,12 @@ class DyscoStMan;
 /**
  * A column for storing compressed values in a threaded way, tailored for the
  * data and weight columns that use a threaded approach for encoding.
+ *
+ * Blocks are encoded and decoded by tasks on the thread pool that is shared
+ * by all columns of the storage manager. Written blocks are placed in a
+ * cache, from which encoding tasks encode and write them. When blocks are
+ * read consecutively, the next blocks are decoded in advance by decoding
+ * tasks.
  * @author André Offringa
  */
 template <typename DataType>
@@ -69,8 +76,8 @@ class ThreadedDyscoColumn : public DyscoStManColumn {
 
   /**
    * Write values into a particular row. This will add the values into the cache
-   * and returns immediately afterwards. A pool of threads will encode the items
-   * in the cache and write them to disk.
+   * and returns immediately afterwards. The thread pool of the storage manager
+   * will encode the items in the cache and write them to disk.
    * @param rowNr The row number to write the values to.
    * @param dataPtr The data pointer, which should be a contiguous array.
    */
@@ -114,11 +121,19 @@ class ThreadedDyscoColumn : public DyscoStManColumn {
 
   typedef typename TimeBlockBuffer<data_t>::symbol_t symbol_t;
 
-  virtual void initializeDecode(TimeBlockBuffer<data_t> *buffer,
+  /**
+   * Create the state that is needed to decode a block. Every decoding task
+   * uses its own state, so that blocks can be decoded in parallel.
+   */
+  virtual std::unique_ptr<ThreadDataBase> initializeDecodeThread() = 0;
+
+  virtual void initializeDecode(ThreadDataBase *threadData,
+                                TimeBlockBuffer<data_t> *buffer,
                                 const float *metaBuffer, size_t nRow,
                                 size_t nAntennae) = 0;
 
-  virtual void decode(TimeBlockBuffer<data_t> *buffer, const symbol_t *data,
+  virtual void decode(ThreadDataBase *threadData,
+                      TimeBlockBuffer<data_t> *buffer, const symbol_t *data,
                       size_t blockRow, size_t a1, size_t a2) = 0;
 
   virtual std::unique_ptr<ThreadDataBase> initializeEncodeThread() = 0;
@@ -136,7 +151,12 @@ class ThreadedDyscoColumn : public DyscoStManColumn {
 
   virtual void shutdown() override final;
 
-  virtual size_t defaultThreadCount() const;
+  /**
+   * Maximum number of blocks of this column that are encoded at the same
+   * time. By default, blocks are encoded by as many tasks as there are threads
+   * in the pool.
+   */
+  virtual size_t maxEncodingTaskCount();
 
   size_t getBitsPerSymbol() const { return _bitsPerSymbol; }
 
@@ -151,10 +171,25 @@ class ThreadedDyscoColumn : public DyscoStManColumn {
     bool isBeingWritten;
   };
 
-  struct EncodingThreadFunctor {
-    void operator()();
-    ThreadedDyscoColumn *parent;
+  /**
+   * Buffers and the state of the encoder or decoder of a task.
+   */
+  struct TaskData {
+    std::unique_ptr<ThreadDataBase> threadData;
+    ao::uvector<unsigned char> packedSymbolBuffer;
+    ao::uvector<unsigned int> unpackedSymbolBuffer;
   };
+
+  /**
+   * A block that is read ahead by a decoding task.
+   */
+  struct DecodedBlock {
+    std::unique_ptr<TimeBlockBuffer<data_t>> buffer;
+    casacore::Vector<int> antenna1, antenna2;
+    bool isReady = false;
+    std::exception_ptr error;
+  };
+
   struct Header : public Serializable {
     uint32_t blockSize;
     uint32_t antennaCount;
@@ -173,21 +208,28 @@ class ThreadedDyscoColumn : public DyscoStManColumn {
   };
 
   typedef std::map<size_t, CacheItem *> cache_t;
+  typedef std::map<size_t, std::unique_ptr<DecodedBlock>> decode_cache_t;
 
   void getValues(casacore::rownr_t rowNr, casacore::Array<data_t> *dataPtr);
   void putValues(casacore::rownr_t rowNr, const casacore::Array<data_t> *dataPtr);
 
   void stopThreads();
   void encodeAndWrite(size_t blockIndex, const CacheItem &item,
-                      unsigned char *packedSymbolBuffer,
-                      unsigned int *unpackedSymbolBuffer,
-                      ThreadDataBase *threadUserData);
+                      TaskData &taskData);
+  // These functions should only be called with a locked mutex
   bool isWriteItemAvailable(typename cache_t::iterator &i);
+  void scheduleEncoding();
+  std::unique_ptr<TaskData> acquireTaskData(bool forEncoding);
+  // Task that encodes and writes blocks from the cache until it is empty.
+  void encodingTask();
+  void decodeBlock(size_t blockIndex, const casacore::Vector<int> &antenna1,
+                   const casacore::Vector<int> &antenna2,
+                   TimeBlockBuffer<data_t> &buffer, TaskData &taskData);
+  void decodingTask(size_t blockIndex, DecodedBlock &block);
+  void readAhead(size_t firstBlock);
   void loadBlock(size_t blockIndex);
   void storeBlock();
-  size_t maxCacheSize() const {
-    return ThreadedDyscoColumn::defaultThreadCount() * 12 / 10 + 1;
-  }
+  size_t maxCacheSize() { return threadPool().Size() * 12 / 10 + 1; }
 
   unsigned _bitsPerSymbol;
   casacore::IPosition _shape;
@@ -196,14 +238,20 @@ class ThreadedDyscoColumn : public DyscoStManColumn {
   std::unique_ptr<casacore::ScalarColumn<double>> _timeCol;
   double _lastWrittenTime;
   int _lastWrittenField, _lastWrittenDataDescId;
-  ao::uvector<unsigned char> _packedBlockReadBuffer;
-  ao::uvector<unsigned int> _unpackedSymbolReadBuffer;
   cache_t _cache;
-  bool _stopThreads;
+  decode_cache_t _decodeCache;
+  bool _isEncodingStarted;
+  size_t _maxEncodingTasks;
+  size_t _encodingTaskCount;
+  size_t _decodingTaskCount;
+  std::exception_ptr _encodingError;
+  // States of the encoders and decoders that are not in use by a task.
+  std::vector<std::unique_ptr<TaskData>> _encodingData;
+  std::vector<std::unique_ptr<TaskData>> _decodingData;
   std::mutex _mutex;
-  threadgroup _threadGroup;
   std::condition_variable _cacheChangedCondition;
   size_t _currentBlock;
+  size_t _lastLoadedBlock;
   bool _isCurrentBlockChanged;
   size_t _blockSize;
   size_t _antennaCount;
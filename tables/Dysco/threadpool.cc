@@ -0,0 +1,82 @@
+#include "threadpool.h"
+
+#include <algorithm>
+
+namespace dyscostman {
+
+namespace {
+// Index of the queue of the current thread, if it is a worker of a pool.
+thread_local const ThreadPool *currentPool = nullptr;
+thread_local size_t currentQueue = 0;
+}  // namespace
+
+ThreadPool::ThreadPool(size_t nThreads)
+    : _nextQueue(0), _nPending(0), _stop(false) {
+  nThreads = std::max<size_t>(1, nThreads);
+  for (size_t i = 0; i != nThreads; ++i)
+    _queues.emplace_back(new Queue());
+  for (size_t i = 0; i != nThreads; ++i)
+    _threads.emplace_back([this, i]() { run(i); });
+}
+
+ThreadPool::~ThreadPool() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _stop = true;
+  _taskAvailable.notify_all();
+  lock.unlock();
+  for (std::thread &thread : _threads) thread.join();
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+  const size_t index = currentPool == this
+                           ? currentQueue
+                           : _nextQueue.fetch_add(1) % _queues.size();
+  Queue &queue = *_queues[index];
+  std::unique_lock<std::mutex> queueLock(queue.mutex);
+  queue.tasks.emplace_front(std::move(task));
+  queueLock.unlock();
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  ++_nPending;
+  _taskAvailable.notify_one();
+}
+
+bool ThreadPool::takeTask(size_t index, std::function<void()> &task) {
+  // Take the most recently added task from the own queue, or steal the
+  // oldest task of another queue.
+  for (size_t i = 0; i != _queues.size(); ++i) {
+    Queue &queue = *_queues[(index + i) % _queues.size()];
+    std::lock_guard<std::mutex> queueLock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      if (i == 0) {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      } else {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::run(size_t index) {
+  currentPool = this;
+  currentQueue = index;
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (true) {
+    while (_nPending == 0 && !_stop) _taskAvailable.wait(lock);
+    if (_nPending == 0) return;
+    // A pending task is reserved by this worker before searching the queues,
+    // so that it is guaranteed to find one.
+    --_nPending;
+    lock.unlock();
+    std::function<void()> task;
+    while (!takeTask(index, task)) std::this_thread::yield();
+    task();
+    lock.lock();
+  }
+}
+
+}  // namespace dyscostman
@@ -0,0 +1,76 @@
+#ifndef DYSCO_THREAD_POOL_H
+#define DYSCO_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dyscostman {
+
+/**
+ * A pool of worker threads that execute submitted tasks. Every worker has
+ * its own queue of tasks. A worker takes tasks from the front of its own
+ * queue, and when that is empty, it steals tasks from the back of the queues
+ * of other workers. Tasks submitted from outside the pool are distributed
+ * over the queues round-robin; tasks submitted by a worker are added to the
+ * worker's own queue.
+ *
+ * The DyscoStMan uses one pool for all its columns, so that the encoding and
+ * decoding of several columns do not oversubscribe the cores.
+ *
+ * Tasks should not throw exceptions: a task has to pass errors to its owner
+ * itself.
+ */
+class ThreadPool {
+ public:
+  /**
+   * Start the threads of the pool.
+   * @param nThreads Number of threads; at least one thread is started.
+   */
+  explicit ThreadPool(size_t nThreads);
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * Finishes all tasks that were submitted and joins the threads.
+   */
+  ~ThreadPool();
+
+  /** Number of threads in the pool. */
+  size_t Size() const { return _threads.size(); }
+
+  /**
+   * Add a task to the pool. The task is executed asynchronously by one of
+   * the threads of the pool.
+   */
+  void Submit(std::function<void()> task);
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void run(size_t index);
+
+  bool takeTask(size_t index, std::function<void()> &task);
+
+  std::vector<std::unique_ptr<Queue>> _queues;
+  std::vector<std::thread> _threads;
+  std::atomic<size_t> _nextQueue;
+  // Number of tasks that are queued but not taken by a worker yet.
+  size_t _nPending;
+  bool _stop;
+  std::mutex _mutex;
+  std::condition_variable _taskAvailable;
+};
+
+}  // namespace dyscostman
+
+#endif
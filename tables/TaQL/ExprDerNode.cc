@@ -28,9 +28,11 @@
 #include <casacore/tables/Tables/TableRecord.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/ColumnDesc.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Utilities/DataType.h>
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/Quanta/MVTime.h>
@@ -113,7 +115,9 @@ TableExprNodeColumn::TableExprNodeColumn (const TableExprInfo& tableInfo,
   : TableExprNodeBinary (NTNumeric, VTScalar, OtColumn, Variable),
     tableInfo_p      (tableInfo),
     tabCol_p         (tableInfo.table(), name),
-    applySelection_p (True)
+    applySelection_p (True),
+    pfStart_p        (0),
+    pfEnd_p          (0)
 {
     //# Check if the column is a scalar.
     if (! tabCol_p.columnDesc().isScalar()) {
@@ -188,35 +192,230 @@ const TableColumn& TableExprNodeColumn::getColumn() const
 
 Bool TableExprNodeColumn::getBool (const TableExprId& id)
 {
+    if (isPrefetched (id.rownr())) {
+        return pfBool_p[id.rownr() - pfStart_p];
+    }
     Bool val;
     tabCol_p.getScalar (id.rownr(), val);
     return val;
 }
 Int64 TableExprNodeColumn::getInt (const TableExprId& id)
 {
+    if (isPrefetched (id.rownr())) {
+        return pfInt_p[id.rownr() - pfStart_p];
+    }
     Int64 val;
     tabCol_p.getScalar (id.rownr(), val);
     return val;
 }
 Double TableExprNodeColumn::getDouble (const TableExprId& id)
 {
+    if (isPrefetched (id.rownr())) {
+        rownr_t inx = id.rownr() - pfStart_p;
+        return (dataType() == NTInt  ?  pfInt_p[inx] : pfDouble_p[inx]);
+    }
     Double val;
     tabCol_p.getScalar (id.rownr(), val);
     return val;
 }
 DComplex TableExprNodeColumn::getDComplex (const TableExprId& id)
 {
+    if (isPrefetched (id.rownr())) {
+        rownr_t inx = id.rownr() - pfStart_p;
+        switch (dataType()) {
+        case NTInt:
+            return Double(pfInt_p[inx]);
+        case NTDouble:
+            return pfDouble_p[inx];
+        default:
+            return pfDComplex_p[inx];
+        }
+    }
     DComplex val;
     tabCol_p.getScalar (id.rownr(), val);
     return val;
 }
 String TableExprNodeColumn::getString (const TableExprId& id)
 {
+    if (isPrefetched (id.rownr())) {
+        return pfString_p[id.rownr() - pfStart_p];
+    }
     String val;
     tabCol_p.getScalar (id.rownr(), val);
     return val;
 }
 
+Bool TableExprNodeColumn::isPrefetched (const Vector<rownr_t>& rownrs) const
+{
+    if (pfEnd_p == 0) {
+        return False;
+    }
+    for (rownr_t rownr : rownrs) {
+        if (! isPrefetched (rownr)) {
+            return False;
+        }
+    }
+    return True;
+}
+
+// Copy the prefetched values of the given rows.
+template<typename T, typename U>
+static void copyPrefetched (const Vector<rownr_t>& rownrs, rownr_t pfStart,
+                            const Vector<T>& buffer, Vector<U>& values)
+{
+    values.resize (rownrs.size());
+    const T* in = buffer.data();
+    U* out = values.data();
+    for (size_t i=0; i<rownrs.size(); i++) {
+        out[i] = in[rownrs[i] - pfStart];
+    }
+}
+
+void TableExprNodeColumn::prefetch (rownr_t startRow, rownr_t nrow)
+{
+    clearPrefetch();
+    Vector<rownr_t> rownrs(nrow);
+    indgen (rownrs, startRow);
+    switch (tabCol_p.columnDesc().dataType()) {
+    case TpBool:
+        getBoolBatch (rownrs, pfBool_p);
+        break;
+    case TpComplex:
+        getConvertBatch<Complex> (rownrs, pfDComplex_p);
+        break;
+    case TpDComplex:
+        getConvertBatch<DComplex> (rownrs, pfDComplex_p);
+        break;
+    case TpString:
+        getConvertBatch<String> (rownrs, pfString_p);
+        break;
+    case TpFloat:
+    case TpDouble:
+        getDoubleBatch (rownrs, pfDouble_p);
+        break;
+    default:
+        getIntBatch (rownrs, pfInt_p);
+    }
+    pfStart_p = startRow;
+    pfEnd_p   = startRow + nrow;
+}
+
+void TableExprNodeColumn::clearPrefetch()
+{
+    pfStart_p = 0;
+    pfEnd_p   = 0;
+    pfBool_p.resize();
+    pfInt_p.resize();
+    pfDouble_p.resize();
+    pfDComplex_p.resize();
+    pfString_p.resize();
+}
+
+template<typename T, typename U>
+void TableExprNodeColumn::getConvertBatch (const Vector<rownr_t>& rownrs,
+                                           Vector<U>& values)
+{
+    // Let RefRows collapse the row numbers to ranges, so the storage
+    // manager can get the values of consecutive rows in one call.
+    ScalarColumn<T> col (tabCol_p);
+    Vector<T> vals (col.getColumnCells (RefRows(rownrs, False, True)));
+    values.resize (vals.size());
+    const T* in = vals.data();
+    U* out = values.data();
+    for (size_t i=0; i<vals.size(); i++) {
+        out[i] = in[i];
+    }
+}
+
+void TableExprNodeColumn::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                        Vector<Bool>& values)
+{
+    if (isPrefetched (rownrs)) {
+        copyPrefetched (rownrs, pfStart_p, pfBool_p, values);
+    } else if (tabCol_p.columnDesc().dataType() == TpBool) {
+        ScalarColumn<Bool> col (tabCol_p);
+        values.reference (col.getColumnCells (RefRows(rownrs, False, True)));
+    } else {
+        TableExprNodeRep::getBoolBatch (rownrs, values);
+    }
+}
+void TableExprNodeColumn::getIntBatch (const Vector<rownr_t>& rownrs,
+                                       Vector<Int64>& values)
+{
+    if (isPrefetched (rownrs)) {
+        copyPrefetched (rownrs, pfStart_p, pfInt_p, values);
+        return;
+    }
+    switch (tabCol_p.columnDesc().dataType()) {
+    case TpUChar:
+        getConvertBatch<uChar> (rownrs, values);
+        break;
+    case TpShort:
+        getConvertBatch<Short> (rownrs, values);
+        break;
+    case TpUShort:
+        getConvertBatch<uShort> (rownrs, values);
+        break;
+    case TpInt:
+        getConvertBatch<Int> (rownrs, values);
+        break;
+    case TpUInt:
+        getConvertBatch<uInt> (rownrs, values);
+        break;
+    case TpInt64:
+        {
+            ScalarColumn<Int64> col (tabCol_p);
+            values.reference (col.getColumnCells (RefRows(rownrs, False, True)));
+        }
+        break;
+    default:
+        TableExprNodeRep::getIntBatch (rownrs, values);
+    }
+}
+void TableExprNodeColumn::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                          Vector<Double>& values)
+{
+    if (isPrefetched (rownrs)) {
+        if (dataType() == NTInt) {
+            copyPrefetched (rownrs, pfStart_p, pfInt_p, values);
+        } else {
+            copyPrefetched (rownrs, pfStart_p, pfDouble_p, values);
+        }
+        return;
+    }
+    switch (tabCol_p.columnDesc().dataType()) {
+    case TpUChar:
+        getConvertBatch<uChar> (rownrs, values);
+        break;
+    case TpShort:
+        getConvertBatch<Short> (rownrs, values);
+        break;
+    case TpUShort:
+        getConvertBatch<uShort> (rownrs, values);
+        break;
+    case TpInt:
+        getConvertBatch<Int> (rownrs, values);
+        break;
+    case TpUInt:
+        getConvertBatch<uInt> (rownrs, values);
+        break;
+    case TpInt64:
+        getConvertBatch<Int64> (rownrs, values);
+        break;
+    case TpFloat:
+        getConvertBatch<Float> (rownrs, values);
+        break;
+    case TpDouble:
+        {
+            ScalarColumn<Double> col (tabCol_p);
+            values.reference (col.getColumnCells (RefRows(rownrs, False, True)));
+        }
+        break;
+    default:
+        TableExprNodeRep::getDoubleBatch (rownrs, values);
+    }
+}
+
 Bool TableExprNodeColumn::getColumnDataType (DataType& dt) const
 {
     dt = tabCol_p.columnDesc().dataType();
@@ -320,6 +320,17 @@ public:
     String   getString   (const TableExprId& id) override;
     const TableColumn& getColumn() const;
 
+    // Get the data for the given rows using the column's getColumnCells.
+    // A column with another data type uses the default implementation.
+    // <group>
+    void getBoolBatch   (const Vector<rownr_t>& rownrs,
+                         Vector<Bool>& values) override;
+    void getIntBatch    (const Vector<rownr_t>& rownrs,
+                         Vector<Int64>& values) override;
+    void getDoubleBatch (const Vector<rownr_t>& rownrs,
+                         Vector<Double>& values) override;
+    // </group>
+
     // Get the data for the given rows.
     Array<Bool>     getColumnBool (const Vector<rownr_t>& rownrs) override;
     Array<uChar>    getColumnuChar (const Vector<rownr_t>& rownrs) override;
@@ -337,10 +348,38 @@ public:
     // Get the column unit (can be empty).
     static Unit getColumnUnit (const TableColumn&);
 
+    // Read the values of the given row range into a buffer.
+    // Thereafter the get functions take the values of those rows from the
+    // buffer, so they can be used by multiple threads at the same time.
+    void prefetch (rownr_t startRow, rownr_t nrow);
+
+    // Clear the prefetch buffer.
+    void clearPrefetch();
+
 protected:
+    // Are the given rows in the prefetch buffer?
+    // <group>
+    Bool isPrefetched (rownr_t rownr) const
+      { return rownr >= pfStart_p  &&  rownr < pfEnd_p; }
+    Bool isPrefetched (const Vector<rownr_t>& rownrs) const;
+    // </group>
+
+    // Get the values in the given rows and convert them to the
+    // requested type.
+    template<typename T, typename U>
+    void getConvertBatch (const Vector<rownr_t>& rownrs, Vector<U>& values);
+
     TableExprInfo tableInfo_p;
     TableColumn   tabCol_p;
     Bool          applySelection_p;
+    // The prefetched rows and their values (only one buffer is used).
+    rownr_t          pfStart_p;
+    rownr_t          pfEnd_p;
+    Vector<Bool>     pfBool_p;
+    Vector<Int64>    pfInt_p;
+    Vector<Double>   pfDouble_p;
+    Vector<DComplex> pfDComplex_p;
+    Vector<String>   pfString_p;
 };
 
 
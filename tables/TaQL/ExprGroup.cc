@@ -32,6 +32,9 @@
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <algorithm>
+#include <functional>
 #include <limits>
 
 
@@ -45,7 +48,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     case TableExprNodeRep::NTInt:
       return itsInt64 == that.itsInt64;
     case TableExprNodeRep::NTDouble:
-      return itsDouble == that.itsDouble;
+      return itsDouble == that.itsDouble  ||
+        (isNaN(itsDouble)  &&  isNaN(that.itsDouble));
     default:
       return itsString == that.itsString;
     }
@@ -66,6 +70,22 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   }
 
 
+  size_t TableExprGroupKey::hash() const
+  {
+    switch (itsDT) {
+    case TableExprNodeRep::NTBool:
+      return std::hash<Bool>() (itsBool);
+    case TableExprNodeRep::NTInt:
+      return std::hash<Int64>() (itsInt64);
+    case TableExprNodeRep::NTDouble:
+      // All NaN values must have the same hash value.
+      return (isNaN(itsDouble)  ?  0 : std::hash<Double>() (itsDouble));
+    default:
+      return std::hash<std::string>() (itsString);
+    }
+  }
+
+
   TableExprGroupKeySet::TableExprGroupKeySet (const vector<TableExprNode>& nodes)
   {
     itsKeys.reserve (nodes.size());
@@ -122,6 +142,17 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   }
 
 
+  size_t TableExprGroupKeySet::hash() const
+  {
+    // Combine the hash values as done in boost::hash_combine.
+    size_t h = 0;
+    for (const TableExprGroupKey& key : itsKeys) {
+      h ^= key.hash() + 0x9e3779b9 + (h<<6) + (h>>2);
+    }
+    return h;
+  }
+
+
   TableExprGroupResult::TableExprGroupResult
   (const vector<std::shared_ptr<TableExprGroupFuncSet>>& funcSets)
   {
@@ -163,6 +194,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     { return False; }
   void TableExprGroupFuncBase::finish()
   {}
+  Bool TableExprGroupFuncBase::canMerge() const
+    { return False; }
+  void TableExprGroupFuncBase::merge (const TableExprGroupFuncBase&)
+  { throw TableInvExpr ("TableExprGroupFuncBase::merge not implemented"); }
   std::shared_ptr<vector<TableExprId>> TableExprGroupFuncBase::getIds() const
   { throw TableInvExpr ("TableExprGroupFuncBase::getIds not implemented"); }
   Bool TableExprGroupFuncBase::getBool (const vector<TableExprId>&)
@@ -216,6 +251,17 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       itsId = id;
     }
   }
+  Bool TableExprGroupFirst::canMerge() const
+    { return True; }
+  void TableExprGroupFirst::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprId& id =
+      dynamic_cast<const TableExprGroupFirst&>(that).itsId;
+    if (itsId.rownr() < 0  ||
+        (id.rownr() >= 0  &&  id.rownr() < itsId.rownr())) {
+      itsId = id;
+    }
+  }
   Bool TableExprGroupFirst::getBool (const vector<TableExprId>&)
     { return itsOperand->getBool (itsId); }
   Int64 TableExprGroupFirst::getInt (const vector<TableExprId>&)
@@ -250,6 +296,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsId = id;
   }
+  void TableExprGroupLast::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprId& id =
+      dynamic_cast<const TableExprGroupLast&>(that).itsId;
+    if (id.rownr() > itsId.rownr()) {
+      itsId = id;
+    }
+  }
 
   TableExprGroupExprId::TableExprGroupExprId (TableExprNodeRep* node)
     : TableExprGroupFuncBase (node)
@@ -266,6 +320,17 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsIds->push_back (id);
   }
+  Bool TableExprGroupExprId::canMerge() const
+    { return True; }
+  void TableExprGroupExprId::merge (const TableExprGroupFuncBase& that)
+  {
+    const vector<TableExprId>& ids = *that.getIds();
+    size_t nr = itsIds->size();
+    itsIds->insert (itsIds->end(), ids.begin(), ids.end());
+    std::inplace_merge (itsIds->begin(), itsIds->begin() + nr, itsIds->end(),
+                        [](const TableExprId& id1, const TableExprId& id2)
+                        { return id1.rownr() < id2.rownr(); });
+  }
   std::shared_ptr<vector<TableExprId>> TableExprGroupExprId::getIds() const
   {
     return itsIds;
@@ -489,5 +554,23 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     }
   }
 
+  Bool TableExprGroupFuncSet::canMerge() const
+  {
+    for (uInt i=0; i<itsFuncs.size(); ++i) {
+      if (! itsFuncs[i]->canMerge()) {
+        return False;
+      }
+    }
+    return True;
+  }
+
+  void TableExprGroupFuncSet::merge (const TableExprGroupFuncSet& that)
+  {
+    AlwaysAssert (itsFuncs.size() == that.itsFuncs.size(), AipsError);
+    for (uInt i=0; i<itsFuncs.size(); ++i) {
+      itsFuncs[i]->merge (*that.itsFuncs[i]);
+    }
+  }
+
 
 } //# NAMESPACE CASACORE - END
@@ -72,11 +72,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // </group>
 
     // Compare this and that key.
+    // Note that NaN values are considered to be equal.
     // <group>
     bool operator== (const TableExprGroupKey&) const;
     bool operator<  (const TableExprGroupKey&) const;
     // </group>
 
+    // Get the hash value of the key.
+    size_t hash() const;
+
   private:
     TableExprNodeRep::NodeDataType itsDT;
     Bool   itsBool = false;
@@ -97,8 +101,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   // TaQL expression with an arbitrary data type.
   // This class contains a set of TableExprGroupKey objects, each containing
   // the value of a key for a particular table row.
-  // <br>It contains comparison functions to make it possible to use them
-  // in a std::map object to map the groupby keyset to a group.
+  // <br>It contains comparison and hash functions to make it possible to
+  // use them in a std::map or std::unordered_map object to map the groupby
+  // keyset to a group.
   // </synopsis> 
   class TableExprGroupKeySet
   {
@@ -119,6 +124,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     bool operator== (const TableExprGroupKeySet&) const;
     bool operator<  (const TableExprGroupKeySet&) const;
 
+    // Get the hash value of all keys in the set.
+    size_t hash() const;
+
+    // Hash functor for use in a std::unordered_map.
+    struct Hash
+    {
+      size_t operator() (const TableExprGroupKeySet& keySet) const
+        { return keySet.hash(); }
+    };
+
   private:
     vector<TableExprGroupKey> itsKeys;
   };
@@ -221,6 +236,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // If needed, finish the aggregation.
     // By default nothing is done.
     virtual void finish();
+    // Can the partial result of another function object of the same type
+    // be merged into this one? It makes it possible that multiple threads
+    // aggregate parts of a table.
+    // The default implementation returns False.
+    virtual Bool canMerge() const;
+    // Merge the partial result of that function object (which must be of
+    // the same type) into this one. It must be done before <src>finish</src>.
+    // The default implementation throws an exception.
+    virtual void merge (const TableExprGroupFuncBase& that);
     // Get the assembled TableExprIds of a group. It is specifically meant
     // for TableExprGroupExprId used for lazy aggregation.
     virtual std::shared_ptr<vector<TableExprId>> getIds() const;
@@ -285,6 +309,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupFirst (TableExprNodeRep* node);
     virtual ~TableExprGroupFirst();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
     virtual Bool getBool (const vector<TableExprId>&);
     virtual Int64 getInt (const vector<TableExprId>&);
     virtual Double getDouble (const vector<TableExprId>&);
@@ -318,6 +344,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupLast (TableExprNodeRep* node);
     virtual ~TableExprGroupLast();
     virtual void apply (const TableExprId& id);
+    virtual void merge (const TableExprGroupFuncBase& that);
   };
 
   // <summary>
@@ -338,6 +365,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     virtual ~TableExprGroupExprId();
     virtual Bool isLazy() const;
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    // The ids are merged in order of row number.
+    virtual void merge (const TableExprGroupFuncBase& that);
     virtual std::shared_ptr<vector<TableExprId>> getIds() const;
   private:
     std::shared_ptr<vector<TableExprId>> itsIds;
@@ -815,6 +845,17 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Apply the functions to the given row.
     void apply (const TableExprId& id);
 
+    // Can all functions merge partial results?
+    Bool canMerge() const;
+
+    // Merge the partial results of the functions in that set into the
+    // functions of this set. The id is not changed.
+    void merge (const TableExprGroupFuncSet& that);
+
+    // Set the TableExprId.
+    void setId (const TableExprId& id)
+      { itsId = id; }
+
     // Get the vector of functions.
     const vector<std::shared_ptr<TableExprGroupFuncBase>>& getFuncs() const
       { return itsFuncs; }
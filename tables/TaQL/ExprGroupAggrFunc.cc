@@ -47,6 +47,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue++;
   }
+  Bool TableExprGroupCountAll::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupCountAll::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupCountAll& other =
+      dynamic_cast<const TableExprGroupCountAll&>(that);
+    itsValue += other.itsValue;
+  }
 
   TableExprGroupCount::TableExprGroupCount (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node),
@@ -71,6 +81,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       itsValue++;
     }
   }
+  Bool TableExprGroupCount::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupCount::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupCount& other =
+      dynamic_cast<const TableExprGroupCount&>(that);
+    itsValue += other.itsValue;
+  }
 
   TableExprGroupAny::TableExprGroupAny (TableExprNodeRep* node)
     : TableExprGroupFuncBool (node, False)
@@ -82,6 +102,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Bool v = itsOperand->getBool(id);
     if (v) itsValue = True;
   }
+  Bool TableExprGroupAny::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupAny::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupAny& other =
+      dynamic_cast<const TableExprGroupAny&>(that);
+    if (other.itsValue) itsValue = True;
+  }
 
   TableExprGroupAll::TableExprGroupAll (TableExprNodeRep* node)
     : TableExprGroupFuncBool (node, True)
@@ -93,6 +123,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Bool v = itsOperand->getBool(id);
     if (!v) itsValue = False;
   }
+  Bool TableExprGroupAll::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupAll::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupAll& other =
+      dynamic_cast<const TableExprGroupAll&>(that);
+    if (!other.itsValue) itsValue = False;
+  }
 
   TableExprGroupNTrue::TableExprGroupNTrue (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node)
@@ -104,6 +144,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Bool v = itsOperand->getBool(id);
     if (v) itsValue++;
   }
+  Bool TableExprGroupNTrue::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupNTrue::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupNTrue& other =
+      dynamic_cast<const TableExprGroupNTrue&>(that);
+    itsValue += other.itsValue;
+  }
 
   TableExprGroupNFalse::TableExprGroupNFalse (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node)
@@ -115,6 +165,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Bool v = itsOperand->getBool(id);
     if (!v) itsValue++;
   }
+  Bool TableExprGroupNFalse::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupNFalse::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupNFalse& other =
+      dynamic_cast<const TableExprGroupNFalse&>(that);
+    itsValue += other.itsValue;
+  }
 
   TableExprGroupMinInt::TableExprGroupMinInt (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node, std::numeric_limits<Int64>::max())
@@ -126,6 +186,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Int64 v = itsOperand->getInt(id);
     if (v<itsValue) itsValue = v;
   }
+  Bool TableExprGroupMinInt::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupMinInt::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupMinInt& other =
+      dynamic_cast<const TableExprGroupMinInt&>(that);
+    if (other.itsValue<itsValue) itsValue = other.itsValue;
+  }
 
   TableExprGroupMaxInt::TableExprGroupMaxInt (TableExprNodeRep* node)
     : TableExprGroupFuncInt (node, std::numeric_limits<Int64>::min())
@@ -137,6 +207,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Int64 v = itsOperand->getInt(id);
     if (v>itsValue) itsValue = v;
   }
+  Bool TableExprGroupMaxInt::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupMaxInt::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupMaxInt& other =
+      dynamic_cast<const TableExprGroupMaxInt&>(that);
+    if (other.itsValue>itsValue) itsValue = other.itsValue;
+  }
 
   TableExprGroupSumInt::TableExprGroupSumInt(TableExprNodeRep* node)
     : TableExprGroupFuncInt (node)
@@ -147,6 +227,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue += itsOperand->getInt(id);
   }
+  Bool TableExprGroupSumInt::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupSumInt::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupSumInt& other =
+      dynamic_cast<const TableExprGroupSumInt&>(that);
+    itsValue += other.itsValue;
+  }
 
   TableExprGroupProductInt::TableExprGroupProductInt(TableExprNodeRep* node)
     : TableExprGroupFuncInt (node, 1)
@@ -157,6 +247,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue *= itsOperand->getInt(id);
   }
+  Bool TableExprGroupProductInt::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupProductInt::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupProductInt& other =
+      dynamic_cast<const TableExprGroupProductInt&>(that);
+    itsValue *= other.itsValue;
+  }
 
   TableExprGroupSumSqrInt::TableExprGroupSumSqrInt(TableExprNodeRep* node)
     : TableExprGroupFuncInt (node)
@@ -168,6 +268,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Int64 v = itsOperand->getInt(id);
     itsValue += v*v;
   }
+  Bool TableExprGroupSumSqrInt::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupSumSqrInt::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupSumSqrInt& other =
+      dynamic_cast<const TableExprGroupSumSqrInt&>(that);
+    itsValue += other.itsValue;
+  }
 
 
   TableExprGroupMinDouble::TableExprGroupMinDouble(TableExprNodeRep* node)
@@ -180,6 +290,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Double v = itsOperand->getDouble(id);
     if (v<itsValue) itsValue = v;
   }
+  Bool TableExprGroupMinDouble::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupMinDouble::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupMinDouble& other =
+      dynamic_cast<const TableExprGroupMinDouble&>(that);
+    if (other.itsValue<itsValue) itsValue = other.itsValue;
+  }
 
   TableExprGroupMaxDouble::TableExprGroupMaxDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node, std::numeric_limits<Double>::min())
@@ -191,6 +311,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Double v = itsOperand->getDouble(id);
     if (v>itsValue) itsValue = v;
   }
+  Bool TableExprGroupMaxDouble::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupMaxDouble::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupMaxDouble& other =
+      dynamic_cast<const TableExprGroupMaxDouble&>(that);
+    if (other.itsValue>itsValue) itsValue = other.itsValue;
+  }
 
   TableExprGroupSumDouble::TableExprGroupSumDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node)
@@ -201,6 +331,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue += itsOperand->getDouble(id);
   }
+  Bool TableExprGroupSumDouble::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupSumDouble::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupSumDouble& other =
+      dynamic_cast<const TableExprGroupSumDouble&>(that);
+    itsValue += other.itsValue;
+  }
 
   TableExprGroupProductDouble::TableExprGroupProductDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node, 1)
@@ -211,6 +351,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue *= itsOperand->getDouble(id);
   }
+  Bool TableExprGroupProductDouble::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupProductDouble::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupProductDouble& other =
+      dynamic_cast<const TableExprGroupProductDouble&>(that);
+    itsValue *= other.itsValue;
+  }
 
   TableExprGroupSumSqrDouble::TableExprGroupSumSqrDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node)
@@ -222,6 +372,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Double v = itsOperand->getDouble(id);
     itsValue += v*v;
   }
+  Bool TableExprGroupSumSqrDouble::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupSumSqrDouble::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupSumSqrDouble& other =
+      dynamic_cast<const TableExprGroupSumSqrDouble&>(that);
+    itsValue += other.itsValue;
+  }
 
   TableExprGroupMeanDouble::TableExprGroupMeanDouble(TableExprNodeRep* node)
     : TableExprGroupFuncDouble (node),
@@ -234,6 +394,17 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     itsValue += itsOperand->getDouble(id);
     itsNr++;
   }
+  Bool TableExprGroupMeanDouble::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupMeanDouble::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupMeanDouble& other =
+      dynamic_cast<const TableExprGroupMeanDouble&>(that);
+    itsValue += other.itsValue;
+    itsNr    += other.itsNr;
+  }
   void TableExprGroupMeanDouble::finish()
   {
     if (itsNr > 0) {
@@ -260,6 +431,24 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     itsCurMean += delta/itsNr;
     itsValue   += delta*(v-itsCurMean);   // itsValue contains the M2 value
   }
+  Bool TableExprGroupVarianceDouble::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupVarianceDouble::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupVarianceDouble& other =
+      dynamic_cast<const TableExprGroupVarianceDouble&>(that);
+    // Combine the partial results as described in
+    // en.wikipedia.org/wiki/Algorithms_for_calculating_variance
+    if (other.itsNr > 0) {
+      Int64  nr    = itsNr + other.itsNr;
+      Double delta = other.itsCurMean - itsCurMean;
+      itsValue   += other.itsValue + delta*delta * itsNr * other.itsNr / nr;
+      itsCurMean += delta * other.itsNr / nr;
+      itsNr       = nr;
+    }
+  }
   void TableExprGroupVarianceDouble::finish()
   {
     if (itsNr > itsDdof) {
@@ -292,6 +481,17 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     itsValue += v*v;
     itsNr++;
   }
+  Bool TableExprGroupRmsDouble::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupRmsDouble::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupRmsDouble& other =
+      dynamic_cast<const TableExprGroupRmsDouble&>(that);
+    itsValue += other.itsValue;
+    itsNr    += other.itsNr;
+  }
   void TableExprGroupRmsDouble::finish()
   {
     if (itsNr > 0) {
@@ -337,6 +537,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue += itsOperand->getDComplex(id);
   }
+  Bool TableExprGroupSumDComplex::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupSumDComplex::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupSumDComplex& other =
+      dynamic_cast<const TableExprGroupSumDComplex&>(that);
+    itsValue += other.itsValue;
+  }
 
   TableExprGroupProductDComplex::TableExprGroupProductDComplex(TableExprNodeRep* node)
     : TableExprGroupFuncDComplex (node, DComplex(1,0))
@@ -347,6 +557,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     itsValue *= itsOperand->getDComplex(id);
   }
+  Bool TableExprGroupProductDComplex::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupProductDComplex::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupProductDComplex& other =
+      dynamic_cast<const TableExprGroupProductDComplex&>(that);
+    itsValue *= other.itsValue;
+  }
 
   TableExprGroupSumSqrDComplex::TableExprGroupSumSqrDComplex(TableExprNodeRep* node)
     : TableExprGroupFuncDComplex (node)
@@ -358,6 +578,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     DComplex v = itsOperand->getDComplex(id);
     itsValue += v*v;
   }
+  Bool TableExprGroupSumSqrDComplex::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupSumSqrDComplex::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupSumSqrDComplex& other =
+      dynamic_cast<const TableExprGroupSumSqrDComplex&>(that);
+    itsValue += other.itsValue;
+  }
 
   TableExprGroupMeanDComplex::TableExprGroupMeanDComplex(TableExprNodeRep* node)
     : TableExprGroupFuncDComplex (node),
@@ -370,6 +600,17 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     itsValue += itsOperand->getDComplex(id);
     itsNr++;
   }
+  Bool TableExprGroupMeanDComplex::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupMeanDComplex::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupMeanDComplex& other =
+      dynamic_cast<const TableExprGroupMeanDComplex&>(that);
+    itsValue += other.itsValue;
+    itsNr    += other.itsNr;
+  }
   void TableExprGroupMeanDComplex::finish()
   {
     if (itsNr > 0) {
@@ -396,6 +637,24 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     DComplex d = v - itsCurMean;
     itsValue += real(delta)*real(d) + imag(delta)*imag(d);
   }
+  Bool TableExprGroupVarianceDComplex::canMerge() const
+  {
+    return True;
+  }
+  void TableExprGroupVarianceDComplex::merge (const TableExprGroupFuncBase& that)
+  {
+    const TableExprGroupVarianceDComplex& other =
+      dynamic_cast<const TableExprGroupVarianceDComplex&>(that);
+    // Combine the partial results as described in
+    // en.wikipedia.org/wiki/Algorithms_for_calculating_variance
+    if (other.itsNr > 0) {
+      Int64    nr    = itsNr + other.itsNr;
+      DComplex delta = other.itsCurMean - itsCurMean;
+      itsValue   += other.itsValue + norm(delta) * itsNr * other.itsNr / nr;
+      itsCurMean += delta * Double(other.itsNr) / Double(nr);
+      itsNr       = nr;
+    }
+  }
   void TableExprGroupVarianceDComplex::finish()
   {
     if (itsNr > itsDdof) {
@@ -53,6 +53,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupCountAll (TableExprNodeRep* node);
     virtual ~TableExprGroupCountAll();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
     // Set result in case it is known directly.
     void setResult (Int64 cnt)
       { itsValue = cnt; }
@@ -73,6 +75,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupCount (TableExprNodeRep* node);
     virtual ~TableExprGroupCount();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
   private:
     TableExprNodeArrayColumn* itsColumn;
   };
@@ -92,6 +96,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupAny (TableExprNodeRep* node);
     virtual ~TableExprGroupAny();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
   };
 
   // <summary>
@@ -109,6 +115,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupAll (TableExprNodeRep* node);
     virtual ~TableExprGroupAll();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
   };
 
   // <summary>
@@ -126,6 +134,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupNTrue (TableExprNodeRep* node);
     virtual ~TableExprGroupNTrue();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
   };
 
   // <summary>
@@ -143,6 +153,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupNFalse (TableExprNodeRep* node);
     virtual ~TableExprGroupNFalse();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
   };
 
   // <summary>
@@ -160,6 +172,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupMinInt (TableExprNodeRep* node);
     virtual ~TableExprGroupMinInt();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
   };
 
   // <summary>
@@ -177,6 +191,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupMaxInt (TableExprNodeRep* node);
     virtual ~TableExprGroupMaxInt();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
   };
 
   // <summary>
@@ -194,6 +210,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupSumInt (TableExprNodeRep* node);
     virtual ~TableExprGroupSumInt();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
   };
 
   // <summary>
@@ -211,6 +229,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupProductInt (TableExprNodeRep* node);
     virtual ~TableExprGroupProductInt();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
   };
 
   // <summary>
@@ -228,6 +248,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupSumSqrInt (TableExprNodeRep* node);
     virtual ~TableExprGroupSumSqrInt();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
   };
 
 
@@ -246,6 +268,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupMinDouble (TableExprNodeRep* node);
     virtual ~TableExprGroupMinDouble();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
   };
 
   // <summary>
@@ -263,6 +287,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupMaxDouble (TableExprNodeRep* node);
     virtual ~TableExprGroupMaxDouble();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
   };
 
   // <summary>
@@ -280,6 +306,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupSumDouble (TableExprNodeRep* node);
     virtual ~TableExprGroupSumDouble();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
   };
 
   // <summary>
@@ -297,6 +325,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupProductDouble (TableExprNodeRep* node);
     virtual ~TableExprGroupProductDouble();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
   };
 
   // <summary>
@@ -314,6 +344,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupSumSqrDouble (TableExprNodeRep* node);
     virtual ~TableExprGroupSumSqrDouble();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
   };
 
   // <summary>
@@ -331,6 +363,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupMeanDouble (TableExprNodeRep* node);
     virtual ~TableExprGroupMeanDouble();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
     virtual void finish();
   private:
     Int64 itsNr;
@@ -353,6 +387,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupVarianceDouble (TableExprNodeRep* node, uInt ddof);
     virtual ~TableExprGroupVarianceDouble();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
     virtual void finish();
   protected:
     uInt   itsDdof;
@@ -394,6 +430,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupRmsDouble (TableExprNodeRep* node);
     virtual ~TableExprGroupRmsDouble();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
     virtual void finish();
   private:
     Int64 itsNr;
@@ -440,6 +478,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupSumDComplex (TableExprNodeRep* node);
     virtual ~TableExprGroupSumDComplex();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
   };
 
   // <summary>
@@ -457,6 +497,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupProductDComplex (TableExprNodeRep* node);
     virtual ~TableExprGroupProductDComplex();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
   };
 
   // <summary>
@@ -474,6 +516,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupSumSqrDComplex (TableExprNodeRep* node);
     virtual ~TableExprGroupSumSqrDComplex();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
   };
 
   // <summary>
@@ -491,6 +535,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupMeanDComplex (TableExprNodeRep* node);
     virtual ~TableExprGroupMeanDComplex();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
     virtual void finish();
   private:
     Int64 itsNr;
@@ -514,6 +560,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     explicit TableExprGroupVarianceDComplex (TableExprNodeRep* node, uInt ddof);
     virtual ~TableExprGroupVarianceDComplex();
     virtual void apply (const TableExprId& id);
+    virtual Bool canMerge() const;
+    virtual void merge (const TableExprGroupFuncBase& that);
     virtual void finish();
   protected:
     uInt     itsDdof;
@@ -30,12 +30,79 @@
 #include <casacore/tables/Tables/TableColumn.h>
 #include <casacore/tables/Tables/ColumnDesc.h>
 #include <casacore/casa/Quanta/MVTime.h>
+#include <vector>
 #include <float.h>                     // for DBL_MAX
 #include <limits.h>                     // for DBL_MAX
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+// Get the batch values of a node of the given type.
+// <group>
+inline void getNodeBatch (TableExprNodeRep& node,
+                          const Vector<rownr_t>& rownrs, Vector<Bool>& values)
+  { node.getBoolBatch (rownrs, values); }
+inline void getNodeBatch (TableExprNodeRep& node,
+                          const Vector<rownr_t>& rownrs, Vector<Int64>& values)
+  { node.getIntBatch (rownrs, values); }
+inline void getNodeBatch (TableExprNodeRep& node,
+                          const Vector<rownr_t>& rownrs, Vector<Double>& values)
+  { node.getDoubleBatch (rownrs, values); }
+// </group>
+
+// Compare the batch values of the left and right operand.
+// The simple loop over raw pointers can be vectorized by the compiler.
+template<typename T, typename OP>
+inline void compareBatch (TableExprNodeRep& lnode, TableExprNodeRep& rnode,
+                          const Vector<rownr_t>& rownrs,
+                          Vector<Bool>& values, OP op)
+{
+    Vector<T> lvalues, rvalues;
+    getNodeBatch (lnode, rownrs, lvalues);
+    getNodeBatch (rnode, rownrs, rvalues);
+    values.resize (rownrs.size());
+    const T* lvec = lvalues.data();
+    const T* rvec = rvalues.data();
+    Bool* vec = values.data();
+    size_t n = values.size();
+    for (size_t i=0; i<n; i++) {
+        vec[i] = op(lvec[i], rvec[i]);
+    }
+}
+
+// Evaluate the node for the rows where the given values equal the
+// given Bool and store the result in those values.
+// It is used for the short-circuit evaluation of AND and OR.
+inline void evalSubsetBatch (TableExprNodeRep& node,
+                             const Vector<rownr_t>& rownrs,
+                             Vector<Bool>& values, Bool which)
+{
+    const Bool* vec = values.data();
+    std::vector<size_t> inx;
+    inx.reserve (values.size());
+    for (size_t i=0; i<values.size(); i++) {
+        if (vec[i] == which) {
+            inx.push_back (i);
+        }
+    }
+    if (inx.empty()) {
+        return;
+    }
+    if (inx.size() == values.size()) {
+        node.getBoolBatch (rownrs, values);
+    } else {
+        Vector<rownr_t> subRows (inx.size());
+        Vector<Bool> subValues;
+        for (size_t i=0; i<inx.size(); i++) {
+            subRows[i] = rownrs[inx[i]];
+        }
+        node.getBoolBatch (subRows, subValues);
+        for (size_t i=0; i<inx.size(); i++) {
+            values[inx[i]] = subValues[i];
+        }
+    }
+}
+
 // Implement the comparison operators for each data type.
 
 TableExprNodeEQBool::TableExprNodeEQBool (const TableExprNodeRep& node)
@@ -45,6 +112,12 @@ Bool TableExprNodeEQBool::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) == rnode_p->getBool(id);
 }
+void TableExprNodeEQBool::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                        Vector<Bool>& values)
+{
+    compareBatch<Bool> (*lnode_p, *rnode_p, rownrs, values,
+                      [](Bool l, Bool r) { return l == r; });
+}
 
 TableExprNodeEQInt::TableExprNodeEQInt (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtEQ)
@@ -53,6 +126,12 @@ Bool TableExprNodeEQInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) == rnode_p->getInt(id);
 }
+void TableExprNodeEQInt::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                       Vector<Bool>& values)
+{
+    compareBatch<Int64> (*lnode_p, *rnode_p, rownrs, values,
+                      [](Int64 l, Int64 r) { return l == r; });
+}
 
 TableExprNodeEQDouble::TableExprNodeEQDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtEQ)
@@ -61,6 +140,12 @@ Bool TableExprNodeEQDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) == rnode_p->getDouble(id);
 }
+void TableExprNodeEQDouble::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                          Vector<Bool>& values)
+{
+    compareBatch<Double> (*lnode_p, *rnode_p, rownrs, values,
+                      [](Double l, Double r) { return l == r; });
+}
 
 TableExprNodeEQDComplex::TableExprNodeEQDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtEQ)
@@ -102,6 +187,12 @@ Bool TableExprNodeNEBool::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) != rnode_p->getBool(id);
 }
+void TableExprNodeNEBool::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                        Vector<Bool>& values)
+{
+    compareBatch<Bool> (*lnode_p, *rnode_p, rownrs, values,
+                      [](Bool l, Bool r) { return l != r; });
+}
 
 TableExprNodeNEInt::TableExprNodeNEInt (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtNE)
@@ -110,6 +201,12 @@ Bool TableExprNodeNEInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) != rnode_p->getInt(id);
 }
+void TableExprNodeNEInt::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                       Vector<Bool>& values)
+{
+    compareBatch<Int64> (*lnode_p, *rnode_p, rownrs, values,
+                      [](Int64 l, Int64 r) { return l != r; });
+}
 
 TableExprNodeNEDouble::TableExprNodeNEDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtNE)
@@ -118,6 +215,12 @@ Bool TableExprNodeNEDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) != rnode_p->getDouble(id);
 }
+void TableExprNodeNEDouble::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                          Vector<Bool>& values)
+{
+    compareBatch<Double> (*lnode_p, *rnode_p, rownrs, values,
+                      [](Double l, Double r) { return l != r; });
+}
 
 TableExprNodeNEDComplex::TableExprNodeNEDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtNE)
@@ -159,6 +262,12 @@ Bool TableExprNodeGTInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) > rnode_p->getInt(id);
 }
+void TableExprNodeGTInt::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                       Vector<Bool>& values)
+{
+    compareBatch<Int64> (*lnode_p, *rnode_p, rownrs, values,
+                      [](Int64 l, Int64 r) { return l > r; });
+}
 
 TableExprNodeGTDouble::TableExprNodeGTDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGT)
@@ -167,6 +276,12 @@ Bool TableExprNodeGTDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) > rnode_p->getDouble(id);
 }
+void TableExprNodeGTDouble::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                          Vector<Bool>& values)
+{
+    compareBatch<Double> (*lnode_p, *rnode_p, rownrs, values,
+                      [](Double l, Double r) { return l > r; });
+}
 
 TableExprNodeGTDComplex::TableExprNodeGTDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGT)
@@ -200,6 +315,12 @@ Bool TableExprNodeGEInt::getBool (const TableExprId& id)
 {
     return lnode_p->getInt(id) >= rnode_p->getInt(id);
 }
+void TableExprNodeGEInt::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                       Vector<Bool>& values)
+{
+    compareBatch<Int64> (*lnode_p, *rnode_p, rownrs, values,
+                      [](Int64 l, Int64 r) { return l >= r; });
+}
 
 TableExprNodeGEDouble::TableExprNodeGEDouble (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGE)
@@ -208,6 +329,12 @@ Bool TableExprNodeGEDouble::getBool (const TableExprId& id)
 {
     return lnode_p->getDouble(id) >= rnode_p->getDouble(id);
 }
+void TableExprNodeGEDouble::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                          Vector<Bool>& values)
+{
+    compareBatch<Double> (*lnode_p, *rnode_p, rownrs, values,
+                      [](Double l, Double r) { return l >= r; });
+}
 
 TableExprNodeGEDComplex::TableExprNodeGEDComplex (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtGE)
@@ -353,6 +480,14 @@ Bool TableExprNodeOR::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) || rnode_p->getBool(id);
 }
+void TableExprNodeOR::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                     Vector<Bool>& values)
+{
+    // Like getBool, evaluate the right operand only for the rows
+    // where the left operand is False.
+    lnode_p->getBoolBatch (rownrs, values);
+    evalSubsetBatch (*rnode_p, rownrs, values, False);
+}
 
 
 TableExprNodeAND::TableExprNodeAND (const TableExprNodeRep& node)
@@ -362,6 +497,14 @@ Bool TableExprNodeAND::getBool (const TableExprId& id)
 {
     return lnode_p->getBool(id) && rnode_p->getBool(id);
 }
+void TableExprNodeAND::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                      Vector<Bool>& values)
+{
+    // Like getBool, evaluate the right operand only for the rows
+    // where the left operand is True.
+    lnode_p->getBoolBatch (rownrs, values);
+    evalSubsetBatch (*rnode_p, rownrs, values, True);
+}
 
 
 TableExprNodeNOT::TableExprNodeNOT (const TableExprNodeRep& node)
@@ -371,94 +514,111 @@ Bool TableExprNodeNOT::getBool (const TableExprId& id)
 {
   return ! lnode_p->getBool(id);
 }
+void TableExprNodeNOT::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                      Vector<Bool>& values)
+{
+    lnode_p->getBoolBatch (rownrs, values);
+    Bool* vec = values.data();
+    for (size_t i=0; i<values.size(); i++) {
+        vec[i] = !vec[i];
+    }
+}
 
 
 
-void TableExprNodeEQDouble::ranges (Block<TableExprRange>& blrange)
+//# Test if a comparison is between a scalar column and a constant.
+//# If so, the column node is returned and the constant value is set.
+//# colLeft tells if the column is the left operand.
+//# Otherwise a null pointer is returned.
+static TableExprNodeColumn* getColumnLiteral (const TENShPtr& lnode,
+                                              const TENShPtr& rnode,
+                                              Double& value, Bool& colLeft)
+{
+    if (lnode->operType()  == TableExprNodeRep::OtColumn
+    &&  lnode->valueType() == TableExprNodeRep::VTScalar
+    &&  rnode->operType()  == TableExprNodeRep::OtLiteral) {
+        colLeft = True;
+        value = rnode->getDouble (0);
+        return dynamic_cast<TableExprNodeColumn*>(lnode.get());
+    }
+    if (rnode->operType()  == TableExprNodeRep::OtColumn
+    &&  rnode->valueType() == TableExprNodeRep::VTScalar
+    &&  lnode->operType()  == TableExprNodeRep::OtLiteral) {
+        colLeft = False;
+        value = lnode->getDouble (0);
+        return dynamic_cast<TableExprNodeColumn*>(rnode.get());
+    }
+    return 0;
+}
+
+//# Create the range for an == comparison of a column and a constant.
+static void eqRange (Block<TableExprRange>& blrange,
+                     const TENShPtr& lnode, const TENShPtr& rnode)
 {
     Double dval = 0;
-    TENShPtr tsncol = 0;
-    //# We can store a range if there is a scalar column and constant
-    //# (left or right).
-    if (lnode_p->operType()  == TableExprNodeRep::OtColumn
-    &&  lnode_p->valueType() == TableExprNodeRep::VTScalar
-    &&  rnode_p->operType()  == TableExprNodeRep::OtLiteral) {
-        tsncol = lnode_p;
-        dval = rnode_p->getDouble (0);
-    }else{
-        if (rnode_p->operType()  == TableExprNodeRep::OtColumn
-        &&  rnode_p->valueType() == TableExprNodeRep::VTScalar
-        &&  lnode_p->operType()  == TableExprNodeRep::OtLiteral) {
-            tsncol = rnode_p;
-            dval = lnode_p->getDouble (0);
-        }
+    Bool colLeft;
+    TableExprNodeColumn* colNode = getColumnLiteral (lnode, rnode,
+                                                     dval, colLeft);
+    TableExprNodeRep::createRange (blrange, colNode, dval, dval);
+}
+
+//# Create the range for a >= or > comparison of a column and a constant.
+//# The range of a > comparison is the same as for >=, thus a superset
+//# of the rows to select.
+static void geRange (Block<TableExprRange>& blrange,
+                     const TENShPtr& lnode, const TENShPtr& rnode)
+{
+    Double dval = 0;
+    Bool colLeft;
+    TableExprNodeColumn* colNode = getColumnLiteral (lnode, rnode,
+                                                     dval, colLeft);
+    if (colLeft) {
+        TableExprNodeRep::createRange (blrange, colNode, dval, DBL_MAX);
+    } else {
+        TableExprNodeRep::createRange (blrange, colNode, -DBL_MAX, dval);
     }
-    //# Now create a range (if possible).
-    //# The cast is harmless, since it is surely that object type.
-    TableExprNodeRep::createRange (blrange,
-                                   dynamic_cast<TableExprNodeColumn*>(tsncol.get()),
-                                   dval, dval);
+}
+
+void TableExprNodeEQInt::ranges (Block<TableExprRange>& blrange)
+{
+    eqRange (blrange, lnode_p, rnode_p);
+}
+
+void TableExprNodeEQDouble::ranges (Block<TableExprRange>& blrange)
+{
+    eqRange (blrange, lnode_p, rnode_p);
+}
+
+void TableExprNodeGEInt::ranges (Block<TableExprRange>& blrange)
+{
+    geRange (blrange, lnode_p, rnode_p);
 }
 
 void TableExprNodeGEDouble::ranges (Block<TableExprRange>& blrange)
 {
-    Double st = 0;
-    Double end = 0;
-    TENShPtr tsncol = 0;
-    //# We can store a range if there is a scalar column and constant
-    //# (left or right).
-    if (lnode_p->operType()  == TableExprNodeRep::OtColumn
-    &&  lnode_p->valueType() == TableExprNodeRep::VTScalar
-    &&  rnode_p->operType()  == TableExprNodeRep::OtLiteral) {
-        tsncol = lnode_p;
-        st = rnode_p->getDouble (0);
-        end = DBL_MAX;
-    }else{
-        if (rnode_p->operType()  == TableExprNodeRep::OtColumn
-        &&  rnode_p->valueType() == TableExprNodeRep::VTScalar
-        &&  lnode_p->operType()  == TableExprNodeRep::OtLiteral) {
-            tsncol = rnode_p;
-            end = lnode_p->getDouble (0);
-            st = -DBL_MAX;
-        }
-    }
-    //# Now create a range (if possible).
-    //# The cast is harmless, since it is surely that object type.
-    TableExprNodeRep::createRange (blrange,
-                                   dynamic_cast<TableExprNodeColumn*>(tsncol.get()),
-                                   st, end);
+    geRange (blrange, lnode_p, rnode_p);
+}
+
+void TableExprNodeGTInt::ranges (Block<TableExprRange>& blrange)
+{
+    geRange (blrange, lnode_p, rnode_p);
 }
 
 void TableExprNodeGTDouble::ranges (Block<TableExprRange>& blrange)
 {
-    Double st = 0;
-    Double end = 0;
-    TENShPtr tsncol = 0;
-    //# We can store a range if there is a scalar column and constant
-    //# (left or right).
-    if (lnode_p->operType()  == TableExprNodeRep::OtColumn
-    &&  lnode_p->valueType() == TableExprNodeRep::VTScalar
-    &&  rnode_p->operType()  == TableExprNodeRep::OtLiteral) {
-        tsncol = lnode_p;
-        st = rnode_p->getDouble (0);
-        end = DBL_MAX;
-    }else{
-        if (rnode_p->operType()  == TableExprNodeRep::OtColumn
-        &&  lnode_p->valueType() == TableExprNodeRep::VTScalar
-        &&  lnode_p->operType()  == TableExprNodeRep::OtLiteral) {
-            tsncol = rnode_p;
-            end = lnode_p->getDouble (0);
-            st = -DBL_MAX;
-        }
-    }
-    //# Now create a range (if possible).
-    //# The cast is harmless, since it is surely that object type.
-    TableExprNodeRep::createRange (blrange,
-                                   dynamic_cast<TableExprNodeColumn*>(tsncol.get()),
-                                   st, end);
+    geRange (blrange, lnode_p, rnode_p);
 }
 
 
+//# Test if two ranges are for the same column.
+static Bool isSameColumn (const TableExprRange& left,
+                          const TableExprRange& right)
+{
+    return left.getColumn().columnDesc().name() ==
+           right.getColumn().columnDesc().name()
+       &&  left.getColumn().table().isSameRoot (right.getColumn().table());
+}
+
 //# Or two blocks of ranges.
 void TableExprNodeOR::ranges (Block<TableExprRange>& blrange)
 {
@@ -474,8 +634,7 @@ void TableExprNodeOR::ranges (Block<TableExprRange>& blrange)
     size_t nr=0;
     for (size_t i=0; i<left.nelements(); i++) {
         for (size_t j=0; j<right.nelements(); j++) {
-            if (right[j].getColumn().columnDesc().name() ==
-                                left[i].getColumn().columnDesc().name()) {
+            if (isSameColumn (right[j], left[i])) {
                 blrange.resize(nr+1, True);
                 blrange[nr] = left[i];
                 blrange[nr].mixOr (right[j]);
@@ -509,8 +668,7 @@ void TableExprNodeAND::ranges (Block<TableExprRange>& blrange)
     vec = 0;
     for (size_t i=0; i<blrange.nelements(); i++) {
         for (size_t j=0; j<other.nelements(); j++) {
-            if (other[j].getColumn().columnDesc().name() ==
-                                blrange[i].getColumn().columnDesc().name()) {
+            if (isSameColumn (other[j], blrange[i])) {
                 blrange[i].mixAnd (other[j]);
                 vec(j) = 1;
             }
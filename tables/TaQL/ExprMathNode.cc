@@ -31,6 +31,20 @@
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+// Apply a binary operator to the batch values of the left and right operand.
+// The result is stored in the left values.
+// The simple loop over raw pointers can be vectorized by the compiler.
+template<typename T, typename OP>
+inline void applyBatch (Vector<T>& values, const Vector<T>& rvalues, OP op)
+{
+    T* lvec = values.data();
+    const T* rvec = rvalues.data();
+    size_t n = values.size();
+    for (size_t i=0; i<n; i++) {
+        lvec[i] = op(lvec[i], rvec[i]);
+    }
+}
+
 // Implement the arithmetic operators for each data type.
 
 TableExprNodePlus::TableExprNodePlus (NodeDataType dt,
@@ -51,6 +65,14 @@ Double TableExprNodePlusInt::getDouble (const TableExprId& id)
     { return lnode_p->getInt(id) + rnode_p->getInt(id); }
 DComplex TableExprNodePlusInt::getDComplex (const TableExprId& id)
     { return double(lnode_p->getInt(id) + rnode_p->getInt(id)); }
+void TableExprNodePlusInt::getIntBatch (const Vector<rownr_t>& rownrs,
+                                        Vector<Int64>& values)
+{
+    Vector<Int64> rvalues;
+    lnode_p->getIntBatch (rownrs, values);
+    rnode_p->getIntBatch (rownrs, rvalues);
+    applyBatch (values, rvalues, [](Int64 l, Int64 r) { return l + r; });
+}
 
 TableExprNodePlusDouble::TableExprNodePlusDouble (const TableExprNodeRep& node)
 : TableExprNodePlus (NTDouble, node)
@@ -61,6 +83,14 @@ Double TableExprNodePlusDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) + rnode_p->getDouble(id); }
 DComplex TableExprNodePlusDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) + rnode_p->getDouble(id); }
+void TableExprNodePlusDouble::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                              Vector<Double>& values)
+{
+    Vector<Double> rvalues;
+    lnode_p->getDoubleBatch (rownrs, values);
+    rnode_p->getDoubleBatch (rownrs, rvalues);
+    applyBatch (values, rvalues, [](Double l, Double r) { return l + r; });
+}
 
 TableExprNodePlusDComplex::TableExprNodePlusDComplex (const TableExprNodeRep& node)
 : TableExprNodePlus (NTComplex, node)
@@ -123,6 +153,14 @@ Double TableExprNodeMinusInt::getDouble (const TableExprId& id)
     { return lnode_p->getInt(id) - rnode_p->getInt(id); }
 DComplex TableExprNodeMinusInt::getDComplex (const TableExprId& id)
     { return double(lnode_p->getInt(id) - rnode_p->getInt(id)); }
+void TableExprNodeMinusInt::getIntBatch (const Vector<rownr_t>& rownrs,
+                                         Vector<Int64>& values)
+{
+    Vector<Int64> rvalues;
+    lnode_p->getIntBatch (rownrs, values);
+    rnode_p->getIntBatch (rownrs, rvalues);
+    applyBatch (values, rvalues, [](Int64 l, Int64 r) { return l - r; });
+}
 
 TableExprNodeMinusDouble::TableExprNodeMinusDouble (const TableExprNodeRep& node)
 : TableExprNodeMinus (NTDouble, node)
@@ -141,6 +179,14 @@ Double TableExprNodeMinusDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) - rnode_p->getDouble(id); }
 DComplex TableExprNodeMinusDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) - rnode_p->getDouble(id); }
+void TableExprNodeMinusDouble::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                               Vector<Double>& values)
+{
+    Vector<Double> rvalues;
+    lnode_p->getDoubleBatch (rownrs, values);
+    rnode_p->getDoubleBatch (rownrs, rvalues);
+    applyBatch (values, rvalues, [](Double l, Double r) { return l - r; });
+}
 
 TableExprNodeMinusDComplex::TableExprNodeMinusDComplex (const TableExprNodeRep& node)
 : TableExprNodeMinus (NTComplex, node)
@@ -196,6 +242,14 @@ Double TableExprNodeTimesInt::getDouble (const TableExprId& id)
     { return lnode_p->getInt(id) * rnode_p->getInt(id); }
 DComplex TableExprNodeTimesInt::getDComplex (const TableExprId& id)
     { return double(lnode_p->getInt(id) * rnode_p->getInt(id)); }
+void TableExprNodeTimesInt::getIntBatch (const Vector<rownr_t>& rownrs,
+                                         Vector<Int64>& values)
+{
+    Vector<Int64> rvalues;
+    lnode_p->getIntBatch (rownrs, values);
+    rnode_p->getIntBatch (rownrs, rvalues);
+    applyBatch (values, rvalues, [](Int64 l, Int64 r) { return l * r; });
+}
 
 TableExprNodeTimesDouble::TableExprNodeTimesDouble (const TableExprNodeRep& node)
 : TableExprNodeTimes (NTDouble, node)
@@ -206,6 +260,14 @@ Double TableExprNodeTimesDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) * rnode_p->getDouble(id); }
 DComplex TableExprNodeTimesDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) * rnode_p->getDouble(id); }
+void TableExprNodeTimesDouble::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                               Vector<Double>& values)
+{
+    Vector<Double> rvalues;
+    lnode_p->getDoubleBatch (rownrs, values);
+    rnode_p->getDoubleBatch (rownrs, rvalues);
+    applyBatch (values, rvalues, [](Double l, Double r) { return l * r; });
+}
 
 TableExprNodeTimesDComplex::TableExprNodeTimesDComplex (const TableExprNodeRep& node)
 : TableExprNodeTimes (NTComplex, node)
@@ -262,6 +324,14 @@ Double TableExprNodeDivideDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) / rnode_p->getDouble(id); }
 DComplex TableExprNodeDivideDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) / rnode_p->getDouble(id); }
+void TableExprNodeDivideDouble::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                                Vector<Double>& values)
+{
+    Vector<Double> rvalues;
+    lnode_p->getDoubleBatch (rownrs, values);
+    rnode_p->getDoubleBatch (rownrs, rvalues);
+    applyBatch (values, rvalues, [](Double l, Double r) { return l / r; });
+}
 
 TableExprNodeDivideDComplex::TableExprNodeDivideDComplex (const TableExprNodeRep& node)
 : TableExprNodeDivide (NTComplex, node)
@@ -354,6 +424,24 @@ Double TableExprNodeMIN::getDouble (const TableExprId& id)
     { return -(lnode_p->getDouble(id)); }
 DComplex TableExprNodeMIN::getDComplex (const TableExprId& id)
     { return -(lnode_p->getDComplex(id)); }
+void TableExprNodeMIN::getIntBatch (const Vector<rownr_t>& rownrs,
+                                    Vector<Int64>& values)
+{
+    lnode_p->getIntBatch (rownrs, values);
+    Int64* vec = values.data();
+    for (size_t i=0; i<values.size(); i++) {
+        vec[i] = -vec[i];
+    }
+}
+void TableExprNodeMIN::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                       Vector<Double>& values)
+{
+    lnode_p->getDoubleBatch (rownrs, values);
+    Double* vec = values.data();
+    for (size_t i=0; i<values.size(); i++) {
+        vec[i] = -vec[i];
+    }
+}
 
 
 TableExprNodeBitNegate::TableExprNodeBitNegate (const TableExprNodeRep& node)
@@ -100,6 +100,7 @@ public:
     ~TableExprNodePlusInt();
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
+    void getIntBatch (const Vector<rownr_t>& rownrs, Vector<Int64>& values);
     DComplex getDComplex (const TableExprId& id);
 };
 
@@ -132,6 +133,8 @@ public:
     TableExprNodePlusDouble (const TableExprNodeRep&);
     ~TableExprNodePlusDouble();
     Double   getDouble   (const TableExprId& id);
+    void getDoubleBatch (const Vector<rownr_t>& rownrs,
+                         Vector<Double>& values);
     DComplex getDComplex (const TableExprId& id);
 };
 
@@ -288,6 +291,7 @@ public:
     virtual void handleUnits();
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
+    void getIntBatch (const Vector<rownr_t>& rownrs, Vector<Int64>& values);
     DComplex getDComplex (const TableExprId& id);
 };
 
@@ -320,6 +324,8 @@ public:
     ~TableExprNodeMinusDouble();
     virtual void handleUnits();
     Double   getDouble   (const TableExprId& id);
+    void getDoubleBatch (const Vector<rownr_t>& rownrs,
+                         Vector<Double>& values);
     DComplex getDComplex (const TableExprId& id);
 };
 
@@ -443,6 +449,7 @@ public:
     ~TableExprNodeTimesInt();
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
+    void getIntBatch (const Vector<rownr_t>& rownrs, Vector<Int64>& values);
     DComplex getDComplex (const TableExprId& id);
 };
 
@@ -474,6 +481,8 @@ public:
     TableExprNodeTimesDouble (const TableExprNodeRep&);
     ~TableExprNodeTimesDouble();
     Double   getDouble   (const TableExprId& id);
+    void getDoubleBatch (const Vector<rownr_t>& rownrs,
+                         Vector<Double>& values);
     DComplex getDComplex (const TableExprId& id);
 };
 
@@ -564,6 +573,8 @@ public:
     TableExprNodeDivideDouble (const TableExprNodeRep&);
     ~TableExprNodeDivideDouble();
     Double   getDouble   (const TableExprId& id);
+    void getDoubleBatch (const Vector<rownr_t>& rownrs,
+                         Vector<Double>& values);
     DComplex getDComplex (const TableExprId& id);
 };
 
@@ -807,6 +818,9 @@ public:
     ~TableExprNodeMIN();
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
+    void getIntBatch (const Vector<rownr_t>& rownrs, Vector<Int64>& values);
+    void getDoubleBatch (const Vector<rownr_t>& rownrs,
+                         Vector<Double>& values);
     DComplex getDComplex (const TableExprId& id);
 };
 
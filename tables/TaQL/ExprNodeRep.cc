@@ -230,6 +230,65 @@ MVTime TableExprNodeRep::getDate (const TableExprId&)
     TableExprNode::throwInvDT ("(getDate not implemented)");
     return MVTime(0.);
 }
+
+void TableExprNodeRep::getBoolBatch (const Vector<rownr_t>& rownrs,
+                                     Vector<Bool>& values)
+{
+    rownr_t nrrow = rownrs.size();
+    values.resize (nrrow);
+    if (isConstant()) {
+        values = getBool (TableExprId(0));
+    } else {
+        TableExprId id;
+        Bool* vec = values.data();
+        for (rownr_t i=0; i<nrrow; i++) {
+            id.setRownr (rownrs[i]);
+            vec[i] = getBool (id);
+        }
+    }
+}
+void TableExprNodeRep::getIntBatch (const Vector<rownr_t>& rownrs,
+                                    Vector<Int64>& values)
+{
+    rownr_t nrrow = rownrs.size();
+    values.resize (nrrow);
+    if (isConstant()) {
+        values = getInt (TableExprId(0));
+    } else {
+        TableExprId id;
+        Int64* vec = values.data();
+        for (rownr_t i=0; i<nrrow; i++) {
+            id.setRownr (rownrs[i]);
+            vec[i] = getInt (id);
+        }
+    }
+}
+void TableExprNodeRep::getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                       Vector<Double>& values)
+{
+    rownr_t nrrow = rownrs.size();
+    values.resize (nrrow);
+    if (isConstant()) {
+        values = getDouble (TableExprId(0));
+    } else if (dataType() == NTInt) {
+        // Integer nodes can be evaluated in batch as well.
+        Vector<Int64> ivalues;
+        getIntBatch (rownrs, ivalues);
+        const Int64* ivec = ivalues.data();
+        Double* vec = values.data();
+        for (rownr_t i=0; i<nrrow; i++) {
+            vec[i] = ivec[i];
+        }
+    } else {
+        TableExprId id;
+        Double* vec = values.data();
+        for (rownr_t i=0; i<nrrow; i++) {
+            id.setRownr (rownrs[i]);
+            vec[i] = getDouble (id);
+        }
+    }
+}
+
 MArray<Bool> TableExprNodeRep::getArrayBool (const TableExprId&)
 {
     TableExprNode::throwInvDT ("(getArrayBool not implemented)");
@@ -319,6 +319,24 @@ public:
     virtual MVTime getDate       (const TableExprId& id);
     // </group>
 
+    // Get the scalar values for this node in the given rows.
+    // The values vector is resized as needed.
+    // It is used to evaluate an expression for a chunk of rows at once,
+    // which makes it possible to use tight loops instead of a
+    // virtual function call per row per node.
+    // The default implementations evaluate a constant node only once,
+    // and call the scalar get function for each row otherwise.
+    // Column nodes and the common arithmetic, comparison and logical
+    // operators override them.
+    // <group>
+    virtual void getBoolBatch   (const Vector<rownr_t>& rownrs,
+                                 Vector<Bool>& values);
+    virtual void getIntBatch    (const Vector<rownr_t>& rownrs,
+                                 Vector<Int64>& values);
+    virtual void getDoubleBatch (const Vector<rownr_t>& rownrs,
+                                 Vector<Double>& values);
+    // </group>
+
     // Get an array value for this node in the given row.
     // The appropriate functions are implemented in the derived classes and
     // will usually invoke the get in their children and apply the
@@ -25,6 +25,9 @@
 
 //# Includes
 #include <casacore/tables/TaQL/ExprNodeUtil.h>
+#include <casacore/tables/TaQL/ExprDerNode.h>
+#include <casacore/tables/TaQL/ExprFuncNode.h>
+#include <casacore/tables/TaQL/ExprUnitNode.h>
 #include <casacore/tables/Tables/TableError.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -65,6 +68,61 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       return colNodes;
     }
 
+    Bool getConcurrentColumns (TableExprNodeRep* node,
+                               std::vector<TableExprNodeColumn*>& columns)
+    {
+      columns.clear();
+      std::vector<TableExprNodeRep*> allNodes;
+      node->flattenTree (allNodes);
+      for (auto nodeP : allNodes) {
+        // Constant parts (e.g., a set used in IN) have been evaluated.
+        if (nodeP->isConstant()) {
+          continue;
+        }
+        if (nodeP->valueType() != TableExprNodeRep::VTScalar) {
+          return False;
+        }
+        switch (nodeP->operType()) {
+        case TableExprNodeRep::OtColumn:
+          {
+            TableExprNodeColumn* colNode =
+              dynamic_cast<TableExprNodeColumn*>(nodeP);
+            if (!colNode) {
+              return False;
+            }
+            columns.push_back (colNode);
+          }
+          break;
+        case TableExprNodeRep::OtFunc:
+          // Only builtin functions; UDFs and aggregates can have state.
+          if (!dynamic_cast<TableExprFuncNode*>(nodeP)  ||
+              nodeP->isAggregate()) {
+            return False;
+          }
+          break;
+        case TableExprNodeRep::OtRownr:
+          if (!dynamic_cast<TableExprNodeRownr*>(nodeP)  &&
+              !dynamic_cast<TableExprNodeRowid*>(nodeP)) {
+            return False;
+          }
+          break;
+        case TableExprNodeRep::OtUndef:
+          if (!dynamic_cast<TableExprNodeUnit*>(nodeP)) {
+            return False;
+          }
+          break;
+        case TableExprNodeRep::OtField:
+        case TableExprNodeRep::OtSlice:
+        case TableExprNodeRep::OtRandom:
+          return False;
+        default:
+          // The arithmetic, comparison and logical operators.
+          break;
+        }
+      }
+      return True;
+    }
+
     std::vector<Table> getNodeTables (TableExprNodeRep* node,
                                       Bool properMain)
     {
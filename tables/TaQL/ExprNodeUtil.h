@@ -33,6 +33,9 @@
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+//# Forward declarations
+class TableExprNodeColumn;
+
 // <summary>
 // Class to handle a Regex or StringDistance.
 // </summary>
@@ -66,6 +69,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Get the column nodes used in the node and its children.
     std::vector<TableExprNodeRep*> getColumnNodes (TableExprNodeRep* node);
 
+    // Get the scalar column nodes used in the node and its children
+    // if the expression can be evaluated by multiple threads at the same
+    // time after the values of those columns have been prefetched.
+    // False is returned if the expression contains nodes which cannot be
+    // evaluated concurrently, such as array columns, UDFs, and random
+    // numbers.
+    Bool getConcurrentColumns (TableExprNodeRep* node,
+                               std::vector<TableExprNodeColumn*>& columns);
+
     // Get the (unique) tables used in the node and its children.
     // If <src>properMain</src> only proper main tables (i.e., tables
     // specified in the FROM clause) are returned.
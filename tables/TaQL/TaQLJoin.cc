@@ -259,6 +259,63 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   }
 
 
+  TaQLJoinHash::TaQLJoinHash (const std::vector<TableExprNode>& mainNodes,
+                              const std::vector<TableExprNode>& joinNodes,
+                              const std::vector<rownr_t>& rows,
+                              size_t nlevel)
+    : itsMainNodes (mainNodes.begin(), mainNodes.begin() + nlevel),
+      itsKey       (itsMainNodes)
+  {
+    std::vector<TableExprNode> keyNodes (joinNodes.begin(),
+                                         joinNodes.begin() + nlevel);
+    for (size_t i=0; i<nlevel; ++i) {
+      TableExprNodeRep::NodeDataType dtype = keyNodes[i].getRep()->dataType();
+      if (!((dtype == TableExprNodeRep::NTInt  ||
+             dtype == TableExprNodeRep::NTString)  &&
+            dtype == itsMainNodes[i].getRep()->dataType())) {
+        throw TableInvExpr ("In a equality join condition only Int and String "
+                            "data types are possible");
+      }
+    }
+    // Build phase: get the key for each join table row and add it to the map
+    // if not there yet.
+    // If there are more levels, collect the rows per key to build the
+    // children for the next levels.
+    Bool hasChildren = (nlevel < mainNodes.size());
+    std::vector<std::vector<rownr_t>> childRows;
+    TableExprGroupKeySet key (keyNodes);
+    itsMap.reserve (rows.size());
+    for (rownr_t row : rows) {
+      key.fill (keyNodes, TableExprId(row));
+      auto res = itsMap.emplace (key, hasChildren ? childRows.size() : row);
+      if (hasChildren) {
+        if (res.second) {
+          childRows.push_back (std::vector<rownr_t>());
+        }
+        childRows[res.first->second].push_back (row);
+      }
+    }
+    for (const std::vector<rownr_t>& crows : childRows) {
+      itsChildren.push_back (TaQLJoin::createRecursive
+                             (mainNodes, joinNodes, crows, nlevel));
+    }
+  }
+
+  Int64 TaQLJoinHash::findRow (const TableExprId& id)
+  {
+    // Probe phase: look up the key of the main table row.
+    itsKey.fill (itsMainNodes, id);
+    auto iter = itsMap.find (itsKey);
+    if (iter == itsMap.end()) {
+      return -1;
+    }
+    if (itsChildren.empty()) {
+      return iter->second;
+    }
+    return itsChildren[iter->second]->findRow (id);
+  }
+
+
   
   TaQLJoinColumn::TaQLJoinColumn (const TENShPtr& columnNode,
                                   const TableParseJoin& join)
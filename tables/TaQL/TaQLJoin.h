@@ -29,6 +29,8 @@
 #include <casacore/casa/aips.h>
 #include <casacore/tables/TaQL/ExprDerNode.h>
 #include <casacore/tables/TaQL/ExprNodeSetOpt.h>
+#include <casacore/tables/TaQL/ExprGroup.h>
+#include <unordered_map>
 #include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -198,6 +200,56 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   };
 
 
+  // <summary>
+  // Class handling the equality parts of a join condition using a hash map
+  // </summary>
+  // <use visibility=local>
+  // <reviewed reviewer="" date="" tests="tTaQLJoin">
+  // </reviewed>
+  // <synopsis>
+  // TaQLJoinHash does a hash join on all equality parts of a join condition
+  // at once. In the build phase the values of the join expressions are read
+  // for each row in the join table and the combination of them is used as
+  // the key in a hash map. In the probe phase the values of the main
+  // expressions are evaluated for a row in the main table and looked up
+  // in the map.
+  // <br>If the join condition also contains interval (IN) parts, the map
+  // contains for each key the index of a child tree (created by
+  // <linkto class=TaQLJoin>TaQLJoin::createRecursive</linkto>) handling
+  // those parts for the join table rows having that key. Otherwise the
+  // map contains the join table row number. If multiple join table rows
+  // have the same key, the first one is used.
+  // <br>Contrary to the TaQLJoin tree, it does not need to sort the values
+  // and to create an object per unique value and per row, which makes it
+  // much faster and leaner for large join tables and for joins on multiple
+  // columns (e.g. TIME and baseline).
+  // </synopsis>
+
+  class TaQLJoinHash : public TaQLJoinBase
+  {
+  public:
+    // Build the hash map from the first <src>nlevel</src> join expressions
+    // for the given rows in the join table. The remaining levels
+    // (if any) must be interval parts.
+    TaQLJoinHash (const std::vector<TableExprNode>& mainNodes,
+                  const std::vector<TableExprNode>& joinNodes,
+                  const std::vector<rownr_t>& rows,
+                  size_t nlevel);
+
+    ~TaQLJoinHash() override = default;
+
+    // Find the row number in the join table for the given row in the main table.
+    Int64 findRow (const TableExprId&) override;
+
+  private:
+    std::vector<TableExprNode> itsMainNodes;
+    TableExprGroupKeySet       itsKey;       // key used in the probe phase
+    std::unordered_map<TableExprGroupKeySet, Int64,
+                       TableExprGroupKeySet::Hash> itsMap;
+    std::vector<std::shared_ptr<TaQLJoinBase>> itsChildren;
+  };
+
+
   // <summary>
   // A column in a join table
   // </summary>
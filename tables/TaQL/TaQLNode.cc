@@ -184,6 +184,10 @@ TaQLNode TaQLNode::restoreNode (AipsIO& aio)
     return TaQLCopyColNodeRep::restore (aio);
   case TaQLNode_DropTab:
     return TaQLDropTabNodeRep::restore (aio);
+  case TaQLNode_CreView:
+    return TaQLCreViewNodeRep::restore (aio);
+  case TaQLNode_Explain:
+    return TaQLExplainNodeRep::restore (aio);
   default:
     throw AipsError ("TaQLNode::restoreNode - unknown node type");
   }
@@ -2021,5 +2021,63 @@ TaQLNode TaQLDropTabNodeRep::restore (AipsIO& aio)
   return new TaQLDropTabNodeRep (with, tables);
 }
 
+TaQLCreViewNodeRep::TaQLCreViewNodeRep (const String& name,
+                                        const TaQLNode& query)
+  : TaQLNodeRep (TaQLNode_CreView),
+    itsName  (name),
+    itsQuery (query)
+{}
+TaQLNodeResult TaQLCreViewNodeRep::visit (TaQLNodeVisitor& visitor) const
+{
+  return visitor.visitCreViewNode (*this);
+}
+void TaQLCreViewNodeRep::show (std::ostream& os) const
+{
+  os << "CREATE VIEW " << addEscape(itsName) << " INCREMENTAL AS ";
+  itsQuery.show (os);
+}
+void TaQLCreViewNodeRep::save (AipsIO& aio) const
+{
+  aio << itsName;
+  itsQuery.saveNode(aio);
+}
+TaQLNode TaQLCreViewNodeRep::restore (AipsIO& aio)
+{
+  String name;
+  aio >> name;
+  TaQLNode query = TaQLNode::restoreNode (aio);
+  return new TaQLCreViewNodeRep (name, query);
+}
+
+TaQLExplainNodeRep::TaQLExplainNodeRep (Bool analyze, const TaQLNode& query)
+  : TaQLNodeRep (TaQLNode_Explain),
+    itsAnalyze (analyze),
+    itsQuery   (query)
+{}
+TaQLNodeResult TaQLExplainNodeRep::visit (TaQLNodeVisitor& visitor) const
+{
+  return visitor.visitExplainNode (*this);
+}
+void TaQLExplainNodeRep::show (std::ostream& os) const
+{
+  os << "EXPLAIN ";
+  if (itsAnalyze) {
+    os << "ANALYZE ";
+  }
+  itsQuery.show (os);
+}
+void TaQLExplainNodeRep::save (AipsIO& aio) const
+{
+  aio << itsAnalyze;
+  itsQuery.saveNode(aio);
+}
+TaQLNode TaQLExplainNodeRep::restore (AipsIO& aio)
+{
+  Bool analyze;
+  aio >> analyze;
+  TaQLNode query = TaQLNode::restoreNode (aio);
+  return new TaQLExplainNodeRep (analyze, query);
+}
+
 
 } //# NAMESPACE CASACORE - END
@@ -1375,6 +1375,65 @@ public:
 };
 
 
+// <summary>
+// Raw TaQL parse tree node defining a CREATE VIEW command.
+// </summary>
+// <use visibility=local>
+// <reviewed reviewer="" date="" tests="tTaQLNode">
+// </reviewed>
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=TaQLNodeRep>TaQLNodeRep</linkto>
+// </prerequisite>
+// <synopsis> 
+// This class is a TaQLNodeRep holding the name and query of a create view
+// command. Only incremental views are supported, thus views storing the
+// query result which are updated using the rows added to the queried table.
+// </synopsis> 
+
+class TaQLCreViewNodeRep: public TaQLNodeRep
+{
+public:
+  TaQLCreViewNodeRep (const String& name, const TaQLNode& query);
+  virtual TaQLNodeResult visit (TaQLNodeVisitor&) const override;
+  virtual void show (std::ostream& os) const override;
+  virtual void save (AipsIO& aio) const override;
+  static TaQLNode restore (AipsIO& aio);
+
+  String   itsName;
+  TaQLNode itsQuery;
+};
+
+
+// <summary>
+// Raw TaQL parse tree node defining an EXPLAIN command.
+// </summary>
+// <use visibility=local>
+// <reviewed reviewer="" date="" tests="tTaQLNode">
+// </reviewed>
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=TaQLNodeRep>TaQLNodeRep</linkto>
+// </prerequisite>
+// <synopsis> 
+// This class is a TaQLNodeRep holding the query of an EXPLAIN command
+// and telling if the query has to be executed (EXPLAIN ANALYZE).
+// </synopsis> 
+
+class TaQLExplainNodeRep: public TaQLNodeRep
+{
+public:
+  TaQLExplainNodeRep (Bool analyze, const TaQLNode& query);
+  virtual TaQLNodeResult visit (TaQLNodeVisitor&) const override;
+  virtual void show (std::ostream& os) const override;
+  virtual void save (AipsIO& aio) const override;
+  static TaQLNode restore (AipsIO& aio);
+
+  Bool     itsAnalyze;
+  TaQLNode itsQuery;
+};
+
+
 } //# NAMESPACE CASACORE - END
 
 #endif
@@ -28,6 +28,7 @@
 #include <casacore/tables/TaQL/TableParseSortKey.h>
 #include <casacore/tables/TaQL/TableParseUpdate.h>
 #include <casacore/tables/TaQL/TableParseUtil.h>
+#include <casacore/tables/TaQL/TableParseView.h>
 #include <casacore/tables/TaQL/TaQLShow.h>
 #include <casacore/tables/DataMan/DataManInfo.h>
 #include <casacore/tables/Tables/TableError.h>
@@ -569,6 +570,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Add an entry to the stack.
     Bool outer = itsStack.empty();
     TableParseQuery* curSel = pushStack (TableParseQuery::PSELECT);
+    curSel->setNThreads (node.style().nthreads());
     // First handle LIMIT/OFFSET, because limit is needed when creating
     // a temp table for a select without a FROM.
     // In its turn limit/offset might use WITH tables, so do them very first.
@@ -618,6 +620,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   TaQLNodeResult TaQLNodeHandler::visitUpdateNode (const TaQLUpdateNodeRep& node)
   {
     TableParseQuery* curSel = pushStack (TableParseQuery::PUPDATE);
+    curSel->setNThreads (node.style().nthreads());
     // First handle LIMIT/OFFSET, because limit is needed when creating
     // a temp table for a select without a FROM.
     // In its turn limit/offset might use WITH tables, so do them very first.
@@ -678,6 +681,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   TaQLNodeResult TaQLNodeHandler::visitDeleteNode (const TaQLDeleteNodeRep& node)
   {
     TableParseQuery* curSel = pushStack (TableParseQuery::PDELETE);
+    curSel->setNThreads (node.style().nthreads());
     handleTables  (node.itsWith, False);
     handleTables  (node.itsTables);
     handleWhere   (node.itsWhere);
@@ -696,6 +700,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   {
     Bool outer = itsStack.empty();
     TableParseQuery* curSel = pushStack (TableParseQuery::PCOUNT);
+    curSel->setNThreads (node.style().nthreads());
     handleTables  (node.itsWith, False);
     handleTables  (node.itsTables);
     visitNode     (node.itsColumns);
@@ -721,6 +726,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   TaQLNodeResult TaQLNodeHandler::visitCalcNode (const TaQLCalcNodeRep& node)
   {
     TableParseQuery* curSel = pushStack (TableParseQuery::PCALC);
+    curSel->setNThreads (node.style().nthreads());
     handleTables (node.itsWith, False);
     handleTables (node.itsTables);
     // If where, orderby, limit and/or offset is given, handle as FROM query.
@@ -1150,6 +1156,59 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return TaQLNodeResult (new TaQLNodeHRValue());
   }
   
+  TaQLNodeResult TaQLNodeHandler::visitCreViewNode
+  (const TaQLCreViewNodeRep& node)
+  {
+    // The view is identified by its (normalized) query.
+    ostringstream oss;
+    node.itsQuery.show (oss);
+    TableParseView view (node.itsName, oss.str());
+    // The query is not executed by visitSelectNode, but here using
+    // the rows added since the previous evaluation.
+    visitNode (node.itsQuery);
+    TableParseQuery* curSel = topStack();
+    curSel->setIncremental (view.firstRow (curSel->tableList().firstTable()));
+    curSel->execute (node.style().doTiming(), False, False, 0,
+                     node.style().doTracing(), itsTempTables, itsStack);
+    Table viewTable = view.update (*curSel);
+    popStack();
+    TaQLNodeHRValue* hrval = new TaQLNodeHRValue();
+    TaQLNodeResult res(hrval);
+    hrval->setTable (viewTable);
+    hrval->setString ("create view");
+    return res;
+  }
+
+  TaQLNodeResult TaQLNodeHandler::visitExplainNode
+  (const TaQLExplainNodeRep& node)
+  {
+    // The query is not executed by visitSelectNode, but only here if
+    // its execution has to be analyzed.
+    // A GIVING table is already created when handling the query.
+    const TaQLSelectNodeRep* selNode =
+      dynamic_cast<const TaQLSelectNodeRep*>(node.itsQuery.getRep());
+    if (!node.itsAnalyze  &&  selNode  &&  selNode->itsGiving.isValid()) {
+      throw TableInvExpr ("EXPLAIN cannot be used for a query with "
+                          "GIVING or INTO; use EXPLAIN ANALYZE");
+    }
+    visitNode (node.itsQuery);
+    TableParseQuery* curSel = topStack();
+    ostringstream oss;
+    node.itsQuery.show (oss);
+    String info = "\n" + String(oss.str()) + "\n\n" + curSel->explainPlan();
+    if (node.itsAnalyze) {
+      curSel->setExplain();
+      curSel->execute (node.style().doTiming(), False, False, 0,
+                       node.style().doTracing(), itsTempTables, itsStack);
+      info += "\n" + curSel->explainProfile();
+    }
+    popStack();
+    TaQLNodeHRValue* hrval = new TaQLNodeHRValue();
+    hrval->setString ("explain");
+    hrval->setExpr (TableExprNode(info));
+    return hrval;
+  }
+
   void TaQLNodeHandler::handleWhere (const TaQLNode& node)
   {
     if (node.isValid()) {
@@ -140,6 +140,8 @@ public:
   virtual TaQLNodeResult visitShowNode     (const TaQLShowNodeRep& node);
   virtual TaQLNodeResult visitCopyColNode  (const TaQLCopyColNodeRep& node);
   virtual TaQLNodeResult visitDropTabNode  (const TaQLDropTabNodeRep& node);
+  virtual TaQLNodeResult visitCreViewNode  (const TaQLCreViewNodeRep& node);
+  virtual TaQLNodeResult visitExplainNode  (const TaQLExplainNodeRep& node);
   // </group>
 
   // Get the actual result object from the result.
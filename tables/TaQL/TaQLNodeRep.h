@@ -117,6 +117,8 @@ public:
   #define TaQLNode_Show     char(36)
   #define TaQLNode_CopyCol  char(37)
   #define TaQLNode_DropTab  char(38)
+  #define TaQLNode_CreView  char(39)
+  #define TaQLNode_Explain  char(40)
   // </group>
 
   // Constructor for derived classes specifying the type.
@@ -113,6 +113,8 @@ public:
   virtual TaQLNodeResult visitShowNode     (const TaQLShowNodeRep& node) = 0;
   virtual TaQLNodeResult visitCopyColNode  (const TaQLCopyColNodeRep& node) = 0;
   virtual TaQLNodeResult visitDropTabNode  (const TaQLDropTabNodeRep& node) = 0;
+  virtual TaQLNodeResult visitCreViewNode  (const TaQLCreViewNodeRep& node) = 0;
+  virtual TaQLNodeResult visitExplainNode  (const TaQLExplainNodeRep& node) = 0;
   // </group>
 
 protected:
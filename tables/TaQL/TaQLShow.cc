@@ -124,6 +124,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     "  CREATE TABLE table [AS options] [LIKE table [DROP COLUMN col, col, ...]]",
     "    [ADD COLUMN] [(column_specs)] [LIMIT ...] [DMINFO datamanagers]",
     "",
+    "Create or update a table holding the result of a query on a growing table.",
+    "  CREATE VIEW table INCREMENTAL AS SELECT_command",
+    "",
     "Alter a table (add/copy/rename/remove columns/keywords; add rows).",
     "  ALTER TABLE table [FROM table_list]",
     "    [ADD COLUMN [column_specs] [DMINFO datamanagers]]",
@@ -139,6 +142,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     "Count number of rows per group (subset of SELECT/GROUPBY).",
     "  COUNT [column_list] FROM table_list [WHERE ...]",
     "",
+    "Show the execution plan of a query, possibly executing it for statistics.",
+    "  EXPLAIN [ANALYZE] SELECT_command",
+    "",
     "All commands can be preceded by 'WITH table-list' having temporary tables.",
     "Use 'show command <command>' for more information about a command.",
     "    'show expr(essions)'     for more information about forming expressions.",
@@ -466,6 +472,34 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     "  The expression gives the number of rows to be added to the table."
   };
 
+  const char* viewHelp[] = {
+    "CREATE VIEW table INCREMENTAL AS SELECT_command",
+    "  Store the result of the query in the table. If the table already exists",
+    "  and was created with the same query, only the rows added to the (first)",
+    "  queried table since the previous evaluation are processed and merged",
+    "  into the table. If rows have been removed, the table is created again.",
+    "  Without aggregation, the new result rows are appended.",
+    "  Otherwise, the groups are matched on the SELECT columns not being aggregates,",
+    "  so the GROUPBY keys must be SELECT columns. Only the aggregate functions",
+    "  gcount, gsum, gsumsqr, gproduct, gmin, gmax, gany, gall, gntrue, gnfalse,",
+    "  gfirst and glast can be used.",
+    "  The query cannot contain DISTINCT, HAVING, ORDERBY, LIMIT, OFFSET or GIVING."
+  };
+
+  const char* explainHelp[] = {
+    "EXPLAIN [ANALYZE] SELECT_command",
+    "  Show the steps (WHERE, GROUPBY, HAVING, ORDERBY, LIMIT/OFFSET, PROJECTION,",
+    "  DISTINCT, GIVING) in the order they are executed for the query.",
+    "  EXPLAIN does not execute the query; nested queries in the FROM clause are",
+    "  executed though. Because a GIVING table is created when preparing the",
+    "  query, GIVING (or INTO) can only be used with EXPLAIN ANALYZE.",
+    "  EXPLAIN ANALYZE executes the query (thus also GIVING)",
+    "  and shows for each step the number of rows going in and out, the time",
+    "  spent and the number of bytes read from the columns in the FROM tables.",
+    "  The bytes are also shown per column with the type of its data manager.",
+    "  The query result itself is not returned."
+  };
+
   const char* countHelp[] = {
     " [WITH table_list]",
     "COUNT [column_list] FROM table_list [WHERE expression]",
@@ -1180,11 +1214,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       return getHelp (alterHelp);
     } else if (cmd == "count") {
       return getHelp (countHelp);
+    } else if (cmd == "view") {
+      return getHelp (viewHelp);
+    } else if (cmd == "explain") {
+      return getHelp (explainHelp);
     }
     throw TableInvExpr (cmd +
                         " is an unknown command for 'show command <command>'\n"
                         "   use select, calc, update, insert, delete, create,"
-                        " alter or count\n");
+                        " view, alter, count or explain\n");
   }
 
   String TaQLShow::showFuncs (const String& type,
@@ -25,7 +25,10 @@
 
 #include <casacore/tables/TaQL/TaQLStyle.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/System/AipsrcValue.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <algorithm>
+#include <stdlib.h>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -35,7 +38,8 @@ TaQLStyle::TaQLStyle (uInt origin)
     itsEndExcl   (False),
     itsCOrder    (False),
     itsDoTiming  (False),
-    itsDoTracing (False)
+    itsDoTracing (False),
+    itsNThreads  (1)
 {
   // Define mscal as a synonym for derivedmscal.
   defineSynonym ("mscal", "derivedmscal");
@@ -73,6 +77,13 @@ void TaQLStyle::set (const String& value)
     itsDoTracing = True;
   } else if (val == "NOTRACE") {
     itsDoTracing = False;
+  } else if (val == "NOPARALLEL") {
+    itsNThreads = 1;
+  } else if (val == "PARALLEL") {
+    itsNThreads = 0;
+  } else if (val.size() > 8  &&  val.substr(0,8) == "PARALLEL"  &&
+             val.find_first_not_of ("0123456789", 8) == String::npos) {
+    itsNThreads = atoi (val.substr(8).c_str());
   } else {
     throw TableError(value + " is an invalid TaQL STYLE value");
   }
@@ -83,6 +94,9 @@ void TaQLStyle::reset()
   set ("GLISH");
   itsDoTiming  = False;
   itsDoTracing = False;
+  Int nthreads;
+  AipsrcValue<Int>::find (nthreads, "table.taql.nthreads", 1);
+  itsNThreads = std::max (nthreads, 0);
 }
 
 void TaQLStyle::defineSynonym (const String& synonym, const String& udfLibName)
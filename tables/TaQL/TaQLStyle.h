@@ -53,6 +53,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //
 // The class is also used to tell the TaQL execution engine if timings
 // or tracing of the various parts of the TaQL command need to be done.
+// Furthermore it tells how many threads can be used to evaluate the
+// WHERE clause. Style PARALLEL means that all available threads
+// (see OMP_NUM_THREADS) can be used, PARALLELn that n threads can be used,
+// and NOPARALLEL that it is done sequentially. The default is given by
+// the aipsrc variable <src>table.taql.nthreads</src> (0 means all
+// available threads) which defaults to 1.
 //
 // Finally it is possible to define synonyms for UDF library names.
 // For example, 'derivedmscal' is a lot to type, so a synonym 'mscal'
@@ -70,7 +76,7 @@ public:
 
   // Set the style according to the (case-insensitive) value.
   // Possible values are Glish, Python, Base0, Base1, FortranOrder, Corder,
-  // InclEnd, and ExclEnd.
+  // InclEnd, ExclEnd, Parallel, Parallel<n>, and NoParallel.
   void set (const String& value);
 
   // Define a UDF library name synonym.
@@ -113,12 +119,21 @@ public:
   Bool doTracing() const
     { return itsDoTracing; }
 
+  // Set the number of threads to use (0 means all available threads).
+  void setNThreads (uInt nthreads)
+    { itsNThreads = nthreads; }
+
+  // Get the number of threads to use (0 means all available threads).
+  uInt nthreads() const
+    { return itsNThreads; }
+
 private:
   uInt itsOrigin;
   Bool itsEndExcl;
   Bool itsCOrder;
   Bool itsDoTiming;
   Bool itsDoTracing;
+  uInt itsNThreads;
   std::map<String,String> itsUDFLibNameMap;
 };
 
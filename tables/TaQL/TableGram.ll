@@ -116,6 +116,8 @@ EXCEPT    ([Ee][Xx][Cc][Ee][Pp][Tt])|([Mm][Ii][Nn][Uu][Ss])
 STYLE     [Uu][Ss][Ii][Nn][Gg]{WHITE}[Ss][Tt][Yy][Ll][Ee]{WHITE1}
 TIMEWORD  [Tt][Ii][Mm][Ee]
 SHOW      ([Ss][Hh][Oo][Ww])|([Hh][Ee][Ll][Pp])
+EXPLAIN   [Ee][Xx][Pp][Ll][Aa][Ii][Nn]
+EXPLAINAN {EXPLAIN}{WHITE1}{WHITE}[Aa][Nn][Aa][Ll][Yy][Zz][Ee]
 WITH      [Ww][Ii][Tt][Hh]
 TABLE     [Tt][Aa][Bb][Ll][Ee]
 SELECT    [Ss][Ee][Ll][Ee][Cc][Tt]
@@ -137,6 +139,8 @@ CALC      [Cc][Aa][Ll][Cc]
 CREATETAB [Cc][Rr][Ee][Aa][Tt][Ee]{WHITE}{TABLE}{WHITE1}
 ALTERTAB  [Aa][Ll][Tt][Ee][Rr]{WHITE}{TABLE}{WHITE1}
 DROPTAB   {DROP}{WHITE}{TABLE}{WHITE1}
+CREATEVIEW [Cc][Rr][Ee][Aa][Tt][Ee]{WHITE}[Vv][Ii][Ee][Ww]{WHITE1}
+INCREMENTAL [Ii][Nn][Cc][Rr][Ee][Mm][Ee][Nn][Tt][Aa][Ll]
 /* Optionally the ALTER TABLE subcommands can be separated by commas;
    they need a space after the subcommand name. */
 ADDCOL    ,?{WHITE}{ADD}{WHITE}{COLUMN}{WHITE1}
@@ -345,6 +349,15 @@ PATTREX   {OPERREX}{WHITE}({PATTEX}|{DISTEX})
             BEGIN(TABLENAMEstate);
             return DROPTAB;
           }
+{CREATEVIEW} {
+            tableGramPosition() += yyleng;
+            BEGIN(TABLENAMEstate);
+            return CREATEVIEW;
+          }
+{INCREMENTAL} {
+            tableGramPosition() += yyleng;
+            return INCREMENTAL;
+          }
 {ADDCOL}  {
             tableGramPosition() += yyleng;
             BEGIN(EXPRstate);
@@ -674,7 +687,7 @@ PATTREX   {OPERREX}{WHITE}({PATTEX}|{DISTEX})
 
  /* In most states the word TIME is a normal column or function name.
     Otherwise it is the TIME keyword (to show timings).
-    The same for SHOW.
+    The same for SHOW and EXPLAIN.
  */
 <EXPRstate,TABLENAMEstate>{TIMEWORD} { 
             tableGramPosition() += yyleng;
@@ -699,6 +712,21 @@ PATTREX   {OPERREX}{WHITE}({PATTEX}|{DISTEX})
             BEGIN(SHOWstate);
             return SHOW;
           }
+<EXPRstate,TABLENAMEstate>{EXPLAIN} { 
+            tableGramPosition() += yyleng;
+            lvalp->val = new TaQLConstNode(
+                new TaQLConstNodeRep (tableGramRemoveEscapes (TableGramtext)));
+            TaQLNode::theirNodesCreated.push_back (lvalp->val);
+            return NAME;
+          }
+{EXPLAINAN} {
+            tableGramPosition() += yyleng;
+            return EXPLAINAN;
+          }
+{EXPLAIN} {
+            tableGramPosition() += yyleng;
+            return EXPLAIN;
+          }
             
  /* In the FROM clause a shorthand (for a table) can be given.
     In the WHERE and ORDERBY clause a function name can be given.
@@ -56,6 +56,10 @@ Expect them, so bison does not generate an error message.
 %token CREATETAB
 %token ALTERTAB
 %token DROPTAB
+%token CREATEVIEW
+%token INCREMENTAL
+%token EXPLAIN
+%token EXPLAINAN
 %token WITH
 %token FROM
 %token JOIN
@@ -136,6 +140,8 @@ Expect them, so bison does not generate an error message.
 %type <node> inscomm
 %type <node> delcomm
 %type <node> dropcomm
+%type <node> creviewcomm
+%type <node> explcomm
 %type <node> calccomm
 %type <nodeselect> nestedcomm
 %type <nodeselect> countcomm
@@ -326,6 +332,10 @@ command:   selcomm
              { TaQLNode::theirNode = *$1; }
          | dropcomm
              { TaQLNode::theirNode = *$1; }
+         | creviewcomm
+             { TaQLNode::theirNode = *$1; }
+         | explcomm
+             { TaQLNode::theirNode = *$1; }
          | calccomm
              { TaQLNode::theirNode = *$1; }
          | nestedcomm
@@ -625,6 +635,29 @@ dropcomm:  withpart DROPTAB tables {
            }
          ;
 
+/* The CREATE VIEW command; the query is executed by the view itself */
+creviewcomm: CREATEVIEW tabname INCREMENTAL AS selcomm {
+               $5->setNoExecute();
+               $$ = new TaQLNode(
+                    new TaQLCreViewNodeRep ($2->getString(), *$5));
+	       TaQLNode::theirNodesCreated.push_back ($$);
+           }
+         ;
+
+/* EXPLAIN shows the execution plan of a query;
+   EXPLAIN ANALYZE executes it to show the statistics of each step */
+explcomm:  EXPLAIN selcomm {
+               $2->setNoExecute();
+               $$ = new TaQLNode(new TaQLExplainNodeRep (False, *$2));
+	       TaQLNode::theirNodesCreated.push_back ($$);
+           }
+         | EXPLAINAN selcomm {
+               $2->setNoExecute();
+               $$ = new TaQLNode(new TaQLExplainNodeRep (True, *$2));
+	       TaQLNode::theirNodesCreated.push_back ($$);
+           }
+         ;
+
 /* The CALC command can calculate a single expression */
 calccomm:  withpart CALC FROM tables CALC orexpr {
 	       $$ = new TaQLNode(
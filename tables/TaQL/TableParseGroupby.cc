@@ -29,7 +29,13 @@
 #include <casacore/tables/TaQL/ExprNodeSet.h>
 #include <casacore/tables/TaQL/TableExprIdAggr.h>
 #include <casacore/tables/TaQL/ExprNodeUtil.h>
+#include <casacore/tables/TaQL/ExprAggrNode.h>
+#include <casacore/tables/TaQL/ExprDerNode.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/OS/OMP.h>
+#include <algorithm>
+#include <exception>
+#include <numeric>
 
 using namespace std;
 
@@ -134,7 +140,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   }
 
   std::shared_ptr<TableExprGroupResult> TableParseGroupby::execGroupAggr
-  (Vector<rownr_t>& rownrs) const
+  (Vector<rownr_t>& rownrs, uInt nthreads) const
   {
     // If only 'select count(*)' was given, get the size of the WHERE,
     // thus the size of rownrs_p.
@@ -142,7 +148,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
         (itsGroupAggrUsed & GROUPBY) == 0) {
       return countAll (rownrs);
     }
-    return aggregate (rownrs);
+    return aggregate (rownrs, nthreads);
   }
 
   Bool TableParseGroupby::execHaving
@@ -168,7 +174,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   }
 
   std::shared_ptr<TableExprGroupResult> TableParseGroupby::aggregate
-  (Vector<rownr_t>& rownrs) const
+  (Vector<rownr_t>& rownrs, uInt nthreads) const
   {
     // Get the aggregate functions to be evaluated lazily.
     std::vector<TableExprNodeRep*> immediateNodes;
@@ -195,9 +201,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       immediateNodes.push_back (&expridNode);
     }
     std::vector<std::shared_ptr<TableExprGroupFuncSet>> funcSets;
-    // Use a faster way for a single groupby key.
-    if (itsGroupbyNodes.size() == 1  &&
-        itsGroupbyNodes[0].dataType() == TpDouble) {
+    // Use multiple threads if possible.
+    // Otherwise use a faster way for a single groupby key.
+    if (multiKeyParallel (immediateNodes, rownrs, nthreads, funcSets)) {
+      // Done in parallel.
+    } else if (itsGroupbyNodes.size() == 1  &&
+               itsGroupbyNodes[0].dataType() == TpDouble) {
       funcSets = singleKey<Double> (immediateNodes, rownrs);
     } else if (itsGroupbyNodes.size() == 1  &&
                itsGroupbyNodes[0].dataType() == TpInt) {
@@ -257,10 +266,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Group the data according to the (maybe empty) groupby.
     // Step through the table in the normal order which may not be the
     // groupby order.
-    // A map<key,int> is used to keep track of the results where the int
+    // A hash map<key,int> is used to keep track of the results where the int
     // is the index in a vector of a set of aggregate function objects.
     std::vector<std::shared_ptr<TableExprGroupFuncSet>> funcSets;
-    std::map<TableExprGroupKeySet, Int> keyFuncMap;
+    std::unordered_map<TableExprGroupKeySet, Int,
+                       TableExprGroupKeySet::Hash> keyFuncMap;
     // Create the set of groupby key objects.
     TableExprGroupKeySet keySet(itsGroupbyNodes);
     // Loop through all rows.
@@ -270,7 +280,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       rowid.setRownr (rownrs[i]);
       keySet.fill (itsGroupbyNodes, rowid);
       Int groupnr = funcSets.size();
-      std::map<TableExprGroupKeySet, Int>::iterator iter=keyFuncMap.find (keySet);
+      auto iter = keyFuncMap.find (keySet);
       if (iter == keyFuncMap.end()) {
         keyFuncMap[keySet] = groupnr;
         funcSets.push_back (std::make_shared<TableExprGroupFuncSet>(nodes));
@@ -282,5 +292,179 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return funcSets;
   }
 
+  Bool TableParseGroupby::multiKeyParallel
+  (const std::vector<TableExprNodeRep*>& nodes, const Vector<rownr_t>& rownrs,
+   uInt nthreads,
+   std::vector<std::shared_ptr<TableExprGroupFuncSet>>& funcSets) const
+  {
+    // Nr of rows handled by a thread in a single step.
+    const rownr_t chunkSize = 16384;
+    if (nthreads == 0) {
+      nthreads = OMP::maxThreads();
+    }
+    rownr_t nrow = rownrs.size();
+    if (nthreads <= 1  ||  nrow < 2*chunkSize) {
+      return False;
+    }
+    // All aggregate functions must be able to merge partial results.
+    if (! TableExprGroupFuncSet(nodes).canMerge()) {
+      return False;
+    }
+    // The groupby keys and the operands of the aggregate functions must
+    // be evaluated using prefetched column values.
+    std::vector<TableExprNodeRep*> exprs;
+    for (const TableExprNode& node : itsGroupbyNodes) {
+      exprs.push_back (node.getRep().get());
+    }
+    for (TableExprNodeRep* node : nodes) {
+      TableExprAggrNode* aggrNode = dynamic_cast<TableExprAggrNode*>(node);
+      if (!aggrNode) {
+        return False;
+      }
+      for (const TENShPtr& operand : aggrNode->operands()) {
+        exprs.push_back (operand.get());
+      }
+    }
+    std::vector<TableExprNodeColumn*> colNodes;
+    for (TableExprNodeRep* expr : exprs) {
+      std::vector<TableExprNodeColumn*> cols;
+      if (! TableExprNodeUtil::getConcurrentColumns (expr, cols)) {
+        return False;
+      }
+      colNodes.insert (colNodes.end(), cols.begin(), cols.end());
+    }
+    std::sort (colNodes.begin(), colNodes.end());
+    colNodes.erase (std::unique (colNodes.begin(), colNodes.end()),
+                    colNodes.end());
+    // The rows are prefetched in ranges, so they must be in ascending order.
+    for (rownr_t i=1; i<nrow; ++i) {
+      if (rownrs[i] <= rownrs[i-1]) {
+        return False;
+      }
+    }
+    // The partial result of a thread.
+    struct Partial
+    {
+      explicit Partial (const std::vector<TableExprNode>& keyNodes)
+        : keySet (keyNodes)
+      {}
+      TableExprGroupKeySet keySet;
+      std::unordered_map<TableExprGroupKeySet, Int,
+                         TableExprGroupKeySet::Hash> keyFuncMap;
+      std::vector<std::shared_ptr<TableExprGroupFuncSet>> funcSets;
+      std::vector<rownr_t> firstRows;
+    };
+    std::vector<Partial> parts (nthreads, Partial(itsGroupbyNodes));
+    // Step through the rows. In each step the values of the columns are
+    // read (sequentially) for a range of rows, whereafter each thread
+    // groups and aggregates a part of them.
+    // Limit the range to avoid reading many unused rows for a sparse
+    // selection.
+    const rownr_t maxSpan = 4 * nthreads * chunkSize;
+    std::exception_ptr excp;
+    try {
+      rownr_t st = 0;
+      while (st < nrow) {
+        rownr_t end = std::min (nrow, st + nthreads*chunkSize);
+        end = std::upper_bound (rownrs.data() + st, rownrs.data() + end,
+                                rownrs[st] + maxSpan - 1) - rownrs.data();
+        for (TableExprNodeColumn* col : colNodes) {
+          col->prefetch (rownrs[st], rownrs[end-1] - rownrs[st] + 1);
+        }
+        rownr_t step = (end - st + nthreads - 1) / nthreads;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads)
+#endif
+        for (Int thr=0; thr<Int(nthreads); ++thr) {
+          try {
+            Partial& part = parts[thr];
+            TableExprId rowid(0);
+            rownr_t last = std::min (end, st + (thr+1)*step);
+            for (rownr_t i=st + thr*step; i<last; ++i) {
+              rowid.setRownr (rownrs[i]);
+              part.keySet.fill (itsGroupbyNodes, rowid);
+              Int groupnr;
+              auto iter = part.keyFuncMap.find (part.keySet);
+              if (iter == part.keyFuncMap.end()) {
+                groupnr = part.funcSets.size();
+                part.keyFuncMap[part.keySet] = groupnr;
+                // Making the function objects changes the aggregate nodes.
+                std::shared_ptr<TableExprGroupFuncSet> funcSet;
+#ifdef _OPENMP
+#pragma omp critical(TableParseGroupby_multiKeyParallel)
+#endif
+                funcSet = std::make_shared<TableExprGroupFuncSet>(nodes);
+                part.funcSets.push_back (funcSet);
+                part.firstRows.push_back (rownrs[i]);
+              } else {
+                groupnr = iter->second;
+              }
+              part.funcSets[groupnr]->apply (rowid);
+            }
+          } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical(TableParseGroupby_multiKeyParallel)
+#endif
+            {
+              if (!excp) {
+                excp = std::current_exception();
+              }
+            }
+          }
+        }
+        if (excp) {
+          std::rethrow_exception (excp);
+        }
+        st = end;
+      }
+    } catch (...) {
+      for (TableExprNodeColumn* col : colNodes) {
+        col->clearPrefetch();
+      }
+      throw;
+    }
+    for (TableExprNodeColumn* col : colNodes) {
+      col->clearPrefetch();
+    }
+    // Merge the partial results.
+    // The id of a group is the one of its last row.
+    std::unordered_map<TableExprGroupKeySet, Int,
+                       TableExprGroupKeySet::Hash> keyFuncMap;
+    std::vector<std::shared_ptr<TableExprGroupFuncSet>> sets;
+    std::vector<rownr_t> firstRows;
+    for (Partial& part : parts) {
+      for (const auto& keyFunc : part.keyFuncMap) {
+        const std::shared_ptr<TableExprGroupFuncSet>& funcSet =
+          part.funcSets[keyFunc.second];
+        auto iter = keyFuncMap.find (keyFunc.first);
+        if (iter == keyFuncMap.end()) {
+          keyFuncMap[keyFunc.first] = sets.size();
+          sets.push_back (funcSet);
+          firstRows.push_back (part.firstRows[keyFunc.second]);
+        } else {
+          TableExprGroupFuncSet& set = *sets[iter->second];
+          set.merge (*funcSet);
+          if (funcSet->getId().rownr() > set.getId().rownr()) {
+            set.setId (funcSet->getId());
+          }
+          firstRows[iter->second] = std::min (firstRows[iter->second],
+                                              part.firstRows[keyFunc.second]);
+        }
+      }
+    }
+    // Order the groups in order of their first row as done by multiKey.
+    std::vector<size_t> order(sets.size());
+    std::iota (order.begin(), order.end(), 0);
+    std::sort (order.begin(), order.end(),
+               [&firstRows](size_t i, size_t j)
+               { return firstRows[i] < firstRows[j]; });
+    funcSets.clear();
+    funcSets.reserve (sets.size());
+    for (size_t i : order) {
+      funcSets.push_back (sets[i]);
+    }
+    return True;
+  }
+
 
 } //# NAMESPACE CASACORE - END
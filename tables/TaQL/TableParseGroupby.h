@@ -30,6 +30,9 @@
 #include <casacore/casa/aips.h>
 #include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/tables/TaQL/ExprGroup.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -51,6 +54,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   // This class is used by TableParseQuery to handle TaQL's GROUPBY and HAVING
   // clauses and to setup and evaluate aggregate functions.
   // It checks that the commands and functions are given in a valid way.
+  // <br>The groups are found using a hash map of the groupby keys.
+  // If multiple threads can be used (see
+  // <linkto class=TaQLStyle>TaQLStyle</linkto>), each thread groups and
+  // aggregates a part of the rows, whereafter the partial results are merged.
+  // That is only possible if all aggregate functions can merge partial
+  // results (which is the case for the immediate scalar functions like
+  // gsum, gmean, gvariance, gmin and gcount) and if the groupby keys and
+  // operands of the aggregate functions only use scalar columns and
+  // builtin functions. Otherwise a single thread is used.
   // <br>Note that some hooks are present for the ROLLUP keyword, but it is not
   // possible to use it yet.
   // </synopsis>
@@ -91,6 +103,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Get the number of aggregation ndes.
     uInt size() const
       { return itsAggrNodes.size(); }
+
+    // Get the number of GROUPBY keys.
+    uInt nkeys() const
+      { return itsGroupbyNodes.size(); }
+
+    // Is a HAVING clause given?
+    Bool hasHaving() const
+      { return ! itsHavingNode.isNull(); }
     
     // Disable applySelection for the column nodes of aggregate functions.
     uInt disableApplySelection();
@@ -101,7 +121,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Execute the grouping and aggregation and return the results.
     // The rownrs are adapted to the resulting rownrs consisting of the
     // first row of each group.
-    std::shared_ptr<TableExprGroupResult> execGroupAggr (Vector<rownr_t>& rownrs) const;
+    // If possible, the given number of threads is used (0 means all).
+    std::shared_ptr<TableExprGroupResult> execGroupAggr (Vector<rownr_t>& rownrs,
+                                                         uInt nthreads=1) const;
 
     // Execute the HAVING clause (if present).
     // Return False in no HAVING.
@@ -113,7 +135,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // It distinguishes the immediate and lazy aggregate functions.
     // The rownrs are adapted to the resulting rownrs consisting of the
     // first row of each group.
-    std::shared_ptr<TableExprGroupResult> aggregate (Vector<rownr_t>& rownrs) const;
+    std::shared_ptr<TableExprGroupResult> aggregate (Vector<rownr_t>& rownrs,
+                                                     uInt nthreads) const;
 
     // Do the grouping and aggregation and return the results.
     // It consists of a single COUNTALL operation.
@@ -125,9 +148,19 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     std::vector<std::shared_ptr<TableExprGroupFuncSet>> multiKey
     (const std::vector<TableExprNodeRep*>&, const Vector<rownr_t>& rownrs) const;
 
+    // Create the set of aggregate functions and groupby keys using
+    // multiple threads. Each thread handles part of the rows, whereafter
+    // the results are merged.
+    // It returns False if that cannot be done.
+    Bool multiKeyParallel
+    (const std::vector<TableExprNodeRep*>&, const Vector<rownr_t>& rownrs,
+     uInt nthreads,
+     std::vector<std::shared_ptr<TableExprGroupFuncSet>>& funcSets) const;
+
     // Create the set of aggregate functions and groupby keys in case
     // a single groupby key is given.
     // This offers much faster map access then the general multipleKeys.
+    // All NaN keys form a single group.
     template<typename T>
     std::vector<std::shared_ptr<TableExprGroupFuncSet>> singleKey
     (const std::vector<TableExprNodeRep*>& nodes,
@@ -136,21 +169,37 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       // We have to group the data according to the (possibly empty) groupby.
       // We step through the table in the normal order which may not be the
       // groupby order.
-      // A map<key,int> is used to keep track of the results where the int
-      // is the index in a vector of a set of aggregate function objects.
+      // A hash map<key,int> is used to keep track of the results where the
+      // int is the index in a vector of a set of aggregate function objects.
       std::vector<std::shared_ptr<TableExprGroupFuncSet>> funcSets;
-      std::map<T, int> keyFuncMap;
+      std::unordered_map<T, int> keyFuncMap;
       T lastKey = std::numeric_limits<T>::max();
+      Bool lastNaN = False;
+      int nanGroupnr = -1;
       int groupnr = -1;
       // Loop through all rows.
       // For each row generate the key to get the right entry.
+      // The map lookup is skipped if the key is the same as the last one.
       TableExprId rowid(0);
       T key;
       for (rownr_t i=0; i<rownrs.size(); ++i) {
         rowid.setRownr (rownrs[i]);
         itsGroupbyNodes[0].get (rowid, key);
-        if (key != lastKey) {
-          typename std::map<T, int>::iterator iter = keyFuncMap.find (key);
+        // A NaN cannot be used as a key in a map, so handle it separately.
+        Bool keyNaN = False;
+        if constexpr (std::is_floating_point<T>::value) {
+          keyNaN = isNaN(key);
+        }
+        if (keyNaN) {
+          if (nanGroupnr < 0) {
+            nanGroupnr = funcSets.size();
+            funcSets.push_back (std::shared_ptr<TableExprGroupFuncSet>
+                                (new TableExprGroupFuncSet (nodes)));
+          }
+          groupnr = nanGroupnr;
+        } else if (groupnr < 0  ||  lastNaN  ||  key != lastKey) {
+          typename std::unordered_map<T, int>::iterator iter =
+            keyFuncMap.find (key);
           if (iter == keyFuncMap.end()) {
             groupnr = funcSets.size();
             keyFuncMap[key] = groupnr;
@@ -160,6 +209,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
             groupnr = iter->second;
           }
         }
+        lastKey = key;
+        lastNaN = keyNaN;
         rowid.setRownr (rownrs[i]);
         funcSets[groupnr]->apply (rowid);
       }
@@ -185,6 +185,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       }
     }
     // Append the IN parts to the EQ parts, so the faster EQ lookups are done first.
+    size_t neq = eqParts.size();
     eqParts.insert (eqParts.end(), inParts.begin(), inParts.end());
     eqMainParts.insert (eqMainParts.end(), inMainParts.begin(), inMainParts.end());
     // Everything seems to be fine.
@@ -194,7 +195,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     for (size_t i=0; i<nrow; ++i) {
       rows[i] = i;
     }
-    itsJoin = TaQLJoin::createRecursive(eqMainParts, eqParts, rows, 0);
+    // Use a hash join for the EQ parts if the join table is large or
+    // if joining on multiple EQ parts. Otherwise the TaQLJoin tree is
+    // built which is fine for small (sub)tables.
+    if (neq > 1  ||  (neq == 1  &&  nrow >= hashJoinMinRows)) {
+      itsJoin.reset (new TaQLJoinHash (eqMainParts, eqParts, rows, neq));
+    } else {
+      itsJoin = TaQLJoin::createRecursive(eqMainParts, eqParts, rows, 0);
+    }
     // Clear the cache in the TaQLJoinColumn nodes of the join conditions.
     for (const auto& tnode : eqParts) {
       std::vector<TableExprNodeRep*> nodes;
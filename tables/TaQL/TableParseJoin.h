@@ -65,6 +65,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   // A tree, consisting of TaQLJoinBase objects, is built to execute the condition.
   // It finds the matching row in the join table given a row in the main table.
   // Each level in the tree is an AND part in the condition.
+  // <br>If the join table is large or if the condition contains multiple
+  // equality parts, the equality parts are handled by a hash join
+  // (see <linkto class=TaQLJoinHash>TaQLJoinHash</linkto>). It builds a
+  // hash map of the join table values, which is probed for each row in the
+  // main table. The interval parts (if any) are handled by a tree
+  // per key in the hash map.
   // </synopsis> 
 
   class TableParseJoin
@@ -87,6 +93,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     //# is not set. In that case the given row id is already the original
     //# rownr in the join table and should be returned as such. 
     Int64 findRow (const TableExprId& id) const;
+
+    // The minimum number of rows in the join table to use a hash join
+    // for a single equality part.
+    static const rownr_t hashJoinMinRows = 1000;
     
   private:
     // Split the ON condition recursively into its AND parts.
@@ -57,8 +57,11 @@
 #include <casacore/casa/Utilities/GenSort.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/OS/PrecTimer.h>
 #include <casacore/casa/ostream.h>
 #include <algorithm>
+#include <iomanip>
+#include <sstream>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -73,6 +76,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       endianFormat_p  (Table::AipsrcEndian),
       overwrite_p     (True),
       resultSet_p     (0),
+      nthreads_p      (1),
       distinct_p      (False),
       limit_p         (0),
       endrow_p        (0),
@@ -80,7 +84,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       stride_p        (1),
       insSel_p        (0),
       noDupl_p        (False),
-      order_p         (Sort::Ascending)
+      order_p         (Sort::Ascending),
+      incremental_p   (False),
+      firstRow_p      (0),
+      fromNRow_p      (0),
+      explain_p       (False)
   {}
 
   TableParseQuery::~TableParseQuery()
@@ -781,7 +789,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   (Bool showTimings)
   {
     Timer timer;
-    std::shared_ptr<TableExprGroupResult> result = groupby_p.execGroupAggr(rownrs_p);
+    std::shared_ptr<TableExprGroupResult> result = groupby_p.execGroupAggr(rownrs_p, nthreads_p);
     if (showTimings) {
       timer.show ("  Groupby     ");
     }
@@ -813,6 +821,208 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     return done;
   }
 
+  void TableParseQuery::checkIncremental() const
+  {
+    if (commandType_p != PSELECT) {
+      throw TableInvExpr ("An incremental view can only use a SELECT command");
+    }
+    if (resultSet_p != 0  ||  !resultName_p.empty()) {
+      throw TableInvExpr ("The query of an incremental view cannot have "
+                          "GIVING or INTO");
+    }
+    if (distinct_p  ||  groupby_p.hasHaving()  ||  !sort_p.empty()  ||
+        limit_p != 0  ||  endrow_p != 0  ||  offset_p != 0  ||  stride_p != 1) {
+      throw TableInvExpr ("The query of an incremental view cannot have "
+                          "DISTINCT, HAVING, ORDERBY, LIMIT or OFFSET");
+    }
+  }
+
+  std::map<String,uInt64> TableParseQuery::columnBytesRead() const
+  {
+    std::map<String,uInt64> nbytes;
+    const std::vector<TableParsePair>& tables = tableList_p.fromTables();
+    for (const TableParsePair& pair : tables) {
+      const Table& tab = pair.table();
+      if (tab.isNull()) {
+        continue;
+      }
+      // Qualify the column names if multiple tables are used.
+      String prefix;
+      if (tables.size() > 1  &&  ! pair.shorthand().empty()) {
+        prefix = pair.shorthand() + '.';
+      }
+      const TableDesc& td = tab.tableDesc();
+      for (uInt i=0; i<td.ncolumn(); ++i) {
+        const ColumnDesc& cd = td[i];
+        String label = prefix + cd.name();
+        if (! cd.dataManagerType().empty()) {
+          label += " (" + cd.dataManagerType() + ')';
+        }
+        nbytes[label] += TableColumn(tab, cd.name()).nbytesRead();
+      }
+    }
+    return nbytes;
+  }
+
+  void TableParseQuery::setCountRead (Bool countRead) const
+  {
+    for (const TableParsePair& pair : tableList_p.fromTables()) {
+      const Table& tab = pair.table();
+      if (! tab.isNull()) {
+        const TableDesc& td = tab.tableDesc();
+        for (uInt i=0; i<td.ncolumn(); ++i) {
+          TableColumn(tab, td[i].name()).setCountRead (countRead);
+        }
+      }
+    }
+  }
+
+  void TableParseQuery::explainStep (const String& name, rownr_t nrowIn,
+                                     rownr_t nrowOut, PrecTimer& timer)
+  {
+    if (explain_p) {
+      timer.stop();
+      ExplainStep step;
+      step.name    = name;
+      step.nrowIn  = nrowIn;
+      step.nrowOut = nrowOut;
+      step.time    = timer.getReal();
+      // Determine the bytes read in this step.
+      std::map<String,uInt64> nbytes = columnBytesRead();
+      for (const auto& col : nbytes) {
+        uInt64 prev = explainBytes_p[col.first];
+        if (col.second > prev) {
+          step.nbytes.push_back (std::make_pair (col.first, col.second - prev));
+        }
+      }
+      explainBytes_p = nbytes;
+      explainSteps_p.push_back (step);
+      // Do not count the time needed to gather the statistics.
+      timer.reset();
+      timer.start();
+    }
+  }
+
+  String TableParseQuery::explainPlan() const
+  {
+    std::ostringstream os;
+    os << "Execution plan:" << endl;
+    // The steps are shown in the order they are executed.
+    const char* indent = "                ";
+    Bool first = True;
+    for (const TableParsePair& pair : tableList_p.fromTables()) {
+      os << (first ? "  FROM          " : indent) << pair.name();
+      if (! pair.shorthand().empty()  &&  pair.shorthand() != pair.name()) {
+        os << " AS " << pair.shorthand();
+      }
+      if (! pair.table().isNull()) {
+        os << "  (" << pair.table().nrow() << " rows)";
+      }
+      os << endl;
+      first = False;
+    }
+    if (! joins_p.empty()) {
+      os << "  JOIN          " << joins_p.size() << " join(s)" << endl;
+    }
+    if (! node_p.isNull()) {
+      os << "  WHERE" << endl;
+    }
+    const Block<String>& names = tableProject_p.getColumnNames();
+    const Block<TableExprNode>& exprs = tableProject_p.getColumnExpr();
+    uInt naggr = 0;
+    for (uInt i=0; i<exprs.size(); ++i) {
+      if (! exprs[i].isNull()) {
+        naggr += TableExprNodeUtil::getAggrNodes(exprs[i].getRep().get()).size();
+      }
+    }
+    if (groupby_p.nkeys() > 0  ||  naggr > 0) {
+      os << "  GROUPBY       " << groupby_p.nkeys() << " key(s), "
+         << naggr << " aggregate function(s)" << endl;
+    }
+    if (groupby_p.hasHaving()) {
+      os << "  HAVING" << endl;
+    }
+    if (! sort_p.empty()) {
+      os << "  ORDERBY       " << sort_p.size() << " key(s)";
+      if (noDupl_p) {
+        os << ", unique";
+      }
+      os << endl;
+    }
+    Bool limoff = (offset_p != 0  ||  limit_p != 0  ||  endrow_p != 0  ||
+                   stride_p != 1);
+    std::ostringstream limoffStr;
+    if (limoff) {
+      limoffStr << "  LIMIT/OFFSET ";
+      if (limit_p != 0) {
+        limoffStr << " limit=" << limit_p;
+      }
+      if (endrow_p != 0) {
+        limoffStr << " endrow=" << endrow_p;
+      }
+      if (offset_p != 0) {
+        limoffStr << " offset=" << offset_p;
+      }
+      if (stride_p != 1) {
+        limoffStr << " stride=" << stride_p;
+      }
+      limoffStr << endl;
+    }
+    if (limoff  &&  !distinct_p) {
+      os << limoffStr.str();
+    }
+    if (! names.empty()) {
+      os << "  PROJECTION    " << names.size() << " column(s):";
+      for (uInt i=0; i<names.size(); ++i) {
+        os << ' ' << names[i];
+      }
+      os << endl;
+    }
+    if (distinct_p) {
+      os << "  DISTINCT" << endl;
+      if (limoff) {
+        os << limoffStr.str();
+      }
+    }
+    if (! resultName_p.empty()) {
+      os << "  GIVING        " << resultName_p << endl;
+    } else if (resultSet_p) {
+      os << "  GIVING        set" << endl;
+    }
+    return os.str();
+  }
+
+  String TableParseQuery::explainProfile() const
+  {
+    std::ostringstream os;
+    os << "Execution profile:" << endl;
+    os << "  Step             Rows in    Rows out    Time (s)   Bytes read"
+       << endl;
+    Double totalTime = 0;
+    uInt64 totalBytes = 0;
+    for (const ExplainStep& step : explainSteps_p) {
+      uInt64 nbytes = 0;
+      for (const auto& col : step.nbytes) {
+        nbytes += col.second;
+      }
+      os << "  " << std::left << std::setw(14) << step.name << std::right
+         << std::setw(10) << step.nrowIn << std::setw(12) << step.nrowOut
+         << std::setw(12) << std::fixed << std::setprecision(6) << step.time
+         << std::setw(13) << nbytes << endl;
+      // Show the bytes per column (with its data manager type).
+      for (const auto& col : step.nbytes) {
+        os << "      " << std::left << std::setw(44) << col.first
+           << std::right << std::setw(13) << col.second << endl;
+      }
+      totalTime  += step.time;
+      totalBytes += nbytes;
+    }
+    os << "  " << std::left << std::setw(36) << "Total" << std::right
+       << std::setw(12) << std::fixed << std::setprecision(6) << totalTime
+       << std::setw(13) << totalBytes << endl;
+    return os.str();
+  }
+
   //# Execute the sort.
   void TableParseQuery::doSort (Bool showTimings)
   {
@@ -1172,6 +1382,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     //# If GROUPBY/aggr is used, all clauses can contain other columns than
     //# aggregate or GROUPBY columns. The last row in a group is used for them.
 
+    //# An incremental view cannot use all clauses.
+    if (incremental_p) {
+      checkIncremental();
+    }
     //# Set limit if not given.
     if (limit_p == 0) {
       limit_p = maxRow;
@@ -1221,6 +1435,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     }
     //# The first table in the list is the source table.
     Table table = tableList_p.firstTable();
+    //# When profiling, the time of a step is the time since the previous one.
+    PrecTimer explainTimer;
+    if (explain_p) {
+      explainSteps_p.clear();
+      setCountRead (True);
+      explainBytes_p = columnBytesRead();
+      explainTimer.start();
+    }
     //# Set endrow_p if positive limit and positive or no offset.
     if (offset_p >= 0  &&  limit_p > 0) {
       endrow_p = offset_p + limit_p * stride_p;
@@ -1237,8 +1459,23 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       }
     }
     //# First do the where selection.
+    //# For an incremental view only the rows added since the previous
+    //# evaluation are used.
     Table resultTable(table);
-    if (! node_p.isNull()) {
+    fromNRow_p = table.nrow();
+    if (firstRow_p > 0) {
+      Timer timer;
+      resultTable = table(node_p, 0, 0, nthreads_p, firstRow_p);
+      if (showTimings) {
+        timer.show ("  Where       ");
+      }
+      if (doTracing) {
+        cerr << "WHERE on rows " << firstRow_p << '-' << fromNRow_p
+             << " resulted in " << resultTable.nrow() << " rows" << endl;
+      }
+      explainStep ("WHERE", fromNRow_p - firstRow_p, resultTable.nrow(),
+                   explainTimer);
+    } else if (! node_p.isNull()) {
       //#//        cout << "Showing TableExprRange values ..." << endl;
       //#//        Block<TableExprRange> rang;
       //#//        node_p->ranges(rang);
@@ -1247,19 +1484,21 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       //#//                 << rang[i].end() << endl;
       //#//        }
       Timer timer;
-      resultTable = table(node_p, nrmax);
+      resultTable = table(node_p, nrmax, 0, nthreads_p);
       if (showTimings) {
         timer.show ("  Where       ");
       }
       if (doTracing) {
         cerr << "WHERE resulted in " << resultTable.nrow() << " rows" << endl;
       }
+      explainStep ("WHERE", table.nrow(), resultTable.nrow(), explainTimer);
     }
     // Get the row numbers of the result of the possible first step.
     rownrs_p.reference (resultTable.rowNumbers(table));
     // Execute possible groupby/aggregate.
     std::shared_ptr<TableExprGroupResult> groupResult;
     if (groupby_p.isUsed() != 0) {
+      rownr_t nrowIn = rownrs_p.size();
       groupResult = doGroupby (showTimings);
       // Aggregate results and normal table rows need to have the same rownrs,
       // so set the selected rows in the table column objects.
@@ -1270,6 +1509,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
         cerr << "  applySelection called for " << applySelNodes_p.size()
              << " nodes" << endl;
       }
+      explainStep ("GROUPBY", nrowIn, table.nrow(), explainTimer);
     }
     // Do the projection of SELECT columns used in HAVING or ORDERBY.
     // Thereafter the column nodes need to use rownrs 0..n.
@@ -1283,12 +1523,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
         cerr << "  applySelection called for " << applySelNodes_p.size()
              << " nodes" << endl;
       }
+      explainStep ("PREPROJECTION", table.nrow(), table.nrow(), explainTimer);
     }
     // Do the possible HAVING step.
+    rownr_t nrowIn = rownrs_p.size();
     if (doHaving (showTimings, groupResult)) {
       if (doTracing) {
         cerr << "HAVING resulted in " << rownrs_p.size() << " rows" << endl;
       }
+      explainStep ("HAVING", nrowIn, rownrs_p.size(), explainTimer);
     }
     //# Then do the sort.
     if (sort_p.size() > 0) {
@@ -1296,15 +1539,18 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       if (doTracing) {
         cerr << "ORDERBY resulted in " << rownrs_p.size() << " rows" << endl;
       }
+      explainStep ("ORDERBY", rownrs_p.size(), rownrs_p.size(), explainTimer);
     }
     // If select distinct is given, limit/offset can only be done thereafter
     // because duplicate rows will be removed.
     if (!distinct_p  &&  (offset_p != 0  ||  limit_p != 0  ||
                           endrow_p != 0  || stride_p != 1)) {
+      nrowIn = rownrs_p.size();
       doLimOff (showTimings);
       if (doTracing) {
         cerr << "LIMIT/OFFSET resulted in " << rownrs_p.size() << " rows" << endl;
       }
+      explainStep ("LIMIT/OFFSET", nrowIn, rownrs_p.size(), explainTimer);
     }
     // Take the correct rows of the projected table (if not empty).
     resultTable = table(rownrs_p);
@@ -1343,6 +1589,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     } else {
       //# Then do the projection.
       if (tableProject_p.getColumnNames().size() > 0) {
+        nrowIn = rownrs_p.size();
         resultTable = doProject (showTimings, table, groupResult);
         if (doTracing) {
           cerr << "Final projection done of "
@@ -1351,15 +1598,19 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
                << " columns resulting in " << resultTable.nrow()
                << " rows" << endl;
         }
+        explainStep ("PROJECTION", nrowIn, resultTable.nrow(), explainTimer);
       }
       // If select distinct is given, limit/offset must be done at the end.
       if (distinct_p  &&  (offset_p != 0  ||  limit_p != 0  ||
                            endrow_p != 0  || stride_p != 1)) {
+        nrowIn = resultTable.nrow();
         resultTable = doLimOff (showTimings, resultTable);
         if (doTracing) {
           cerr << "LIMIT/OFFSET resulted in " << resultTable.nrow()
                << " rows" << endl;
         }
+        explainStep ("LIMIT/OFFSET", nrowIn, resultTable.nrow(),
+                     explainTimer);
       }
       //# Finally rename or copy using the given name (and flush it).
       if (resultType_p != 0  ||  ! resultName_p.empty()) {
@@ -1367,8 +1618,13 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
         if (doTracing) {
           cerr << "Finished the GIVING command" << endl;
         }
+        explainStep ("GIVING", resultTable.nrow(), resultTable.nrow(),
+                     explainTimer);
       }
     }
+    if (explain_p) {
+      setCountRead (False);
+    }
     //# Keep the table for later.
     table_p = resultTable;
   }
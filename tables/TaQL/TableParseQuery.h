@@ -41,6 +41,7 @@
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/Containers/Block.h>
+#include <map>
 #include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -55,6 +56,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   class Record;
   class TableRecord;
   template<class T> class ArrayColumn;
+  class PrecTimer;
 
 
   // <summary>
@@ -302,10 +304,46 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     void setDMInfo (const Record& dminfo)
       { tableProject_p.setDMInfo (dminfo); }
 
+    // Set the number of threads to use for the WHERE selection
+    // (0 means all available threads).
+    void setNThreads (uInt nthreads)
+      { nthreads_p = nthreads; }
+
     // Get the projected column names.
     const Block<String>& getColumnNames() const
       { return tableProject_p.getColumnNames(); }
 
+    // Get the projected column expressions.
+    const Block<TableExprNode>& getColumnExpr() const
+      { return tableProject_p.getColumnExpr(); }
+
+    // Get the GROUPBY and aggregate info.
+    const TableParseGroupby& groupby() const
+      { return groupby_p; }
+
+    // Tell that the query is used for an incremental view, so only the rows
+    // of the first table from <src>firstRow</src> on are processed.
+    // The execution checks if the query can be used incrementally.
+    void setIncremental (rownr_t firstRow)
+      { incremental_p = True; firstRow_p = firstRow; }
+
+    // Get the number of rows in the first table at the time of execution.
+    rownr_t fromNRow() const
+      { return fromNRow_p; }
+
+    // Tell that the execution has to be profiled (for EXPLAIN ANALYZE).
+    // For each step the number of rows, the time and the number of bytes
+    // read per column are gathered.
+    void setExplain()
+      { explain_p = True; }
+
+    // Get the execution plan of the query as text.
+    // It should be called before the query is executed.
+    String explainPlan() const;
+
+    // Get the statistics gathered during the profiled execution as text.
+    String explainProfile() const;
+
     // Get the resulting table.
     const Table& getTable() const
       { return table_p; }
@@ -324,6 +362,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
                        const std::vector<const Table*>& tempTables,
                        const std::vector<TableParseQuery*>& stack);
   private:
+    // The statistics of an executed step (for EXPLAIN ANALYZE).
+    struct ExplainStep {
+      String  name;
+      rownr_t nrowIn;
+      rownr_t nrowOut;
+      Double  time;
+      // The number of bytes read per column.
+      std::vector<std::pair<String,uInt64>> nbytes;
+    };
+
     // Do the update step.
     // Rows 0,1,2,.. in UpdTable are updated from the expression result
     // for the rows in the given rownrs vector.
@@ -374,6 +422,23 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Bool doHaving (Bool showTimings,
                    const std::shared_ptr<TableExprGroupResult>& groups);
 
+    // Check if the query can be used for an incremental view, thus has no
+    // clauses requiring all rows or changing the order of the result.
+    void checkIncremental() const;
+
+    // Get the number of bytes read so far from each column in the tables
+    // in the FROM clause.
+    std::map<String,uInt64> columnBytesRead() const;
+
+    // Switch the counting of the bytes read on or off for the columns
+    // in the tables in the FROM clause.
+    void setCountRead (Bool countRead) const;
+
+    // Add the statistics of a step if the execution is profiled.
+    // The time is the time since the previous step, so the timer is reset.
+    void explainStep (const String& name, rownr_t nrowIn, rownr_t nrowOut,
+                      PrecTimer& timer);
+
     // Do the sort step.
     void doSort (Bool showTimings);
 
@@ -418,6 +483,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     TableExprNodeSet* resultSet_p;
     //# The WHERE expression tree.
     TableExprNode node_p;
+    //# The number of threads to use in the WHERE selection.
+    uInt nthreads_p;
     //# The GROUPBY, aggregate and HAVING info.
     TableParseGroupby groupby_p;
     //# Distinct values in output?
@@ -453,6 +520,18 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     Table projectExprTable_p;
     //# The resulting row numbers.
     Vector<rownr_t> rownrs_p;
+    //# Is the query used for an incremental view?
+    Bool incremental_p;
+    //# The first row to process in an incremental view.
+    rownr_t firstRow_p;
+    //# The number of rows in the first table at the time of execution.
+    rownr_t fromNRow_p;
+    //# Is the execution profiled (for EXPLAIN ANALYZE)?
+    Bool explain_p;
+    //# The statistics of the executed steps.
+    std::vector<ExplainStep> explainSteps_p;
+    //# The number of bytes read per column at the end of the previous step.
+    std::map<String,uInt64> explainBytes_p;
   };
 
 
@@ -0,0 +1,288 @@
+//# TableParseView.cc: Class handling an incremental view
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/TableParseView.h>
+#include <casacore/tables/TaQL/TableParseQuery.h>
+#include <casacore/tables/TaQL/ExprAggrNode.h>
+#include <casacore/tables/TaQL/ExprGroup.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/TaQL/ExprNodeUtil.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/Tables/TableCopy.h>
+#include <casacore/tables/Tables/TableLocker.h>
+#include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <map>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+  TableParseView::TableParseView (const String& name, const String& query)
+    : name_p   (name),
+      query_p  (query),
+      exists_p (False),
+      nrow_p   (0)
+  {
+    if (Table::isReadable (name_p)) {
+      Table view(name_p);
+      const TableRecord& keyset = view.keywordSet();
+      Int fld = keyset.fieldNumber ("TAQL_VIEW");
+      if (fld < 0  ||  keyset.type(fld) != TpRecord) {
+        throw TableInvExpr ("Table " + name_p + " already exists, "
+                            "but is no TaQL view");
+      }
+      const TableRecord& rec = keyset.subRecord (fld);
+      if (rec.asString ("query") != query_p) {
+        throw TableInvExpr ("View " + name_p + " has been created with "
+                            "another query: " + rec.asString ("query"));
+      }
+      nrow_p   = rec.asInt64 ("nrow");
+      exists_p = True;
+    }
+  }
+
+  rownr_t TableParseView::firstRow (const Table& source)
+  {
+    // If rows have been removed, the view has to be made from scratch.
+    if (exists_p  &&  source.nrow() < nrow_p) {
+      exists_p = False;
+      nrow_p   = 0;
+    }
+    return exists_p ? nrow_p : 0;
+  }
+
+  Table TableParseView::update (const TableParseQuery& query)
+  {
+    const Table& result = query.getTable();
+    const Block<String>& names = query.getColumnNames();
+    // Determine how the columns of a grouped result are merged.
+    // Do it also for a new view, so errors are reported right away.
+    Bool grouped = query.groupby().isUsed();
+    std::vector<MergeType> types;
+    if (grouped) {
+      const Block<TableExprNode>& exprs = query.getColumnExpr();
+      uInt nkey = 0;
+      for (uInt i=0; i<names.size(); ++i) {
+        types.push_back (mergeType (exprs[i], names[i]));
+        if (types.back() == KEY) {
+          nkey++;
+        }
+      }
+      if (nkey < query.groupby().nkeys()) {
+        throw TableInvExpr ("All GROUPBY keys of the query of incremental "
+                            "view " + name_p + " must be SELECT columns");
+      }
+    }
+    if (! exists_p) {
+      result.deepCopy (name_p, Table::New, True);
+    }
+    Table view(name_p, Table::Update);
+    {
+      // Merge and update the keyword under a single write lock, so other
+      // processes do not see a partially updated view.
+      TableLocker locker(view, FileLocker::Write);
+      if (exists_p) {
+        if (grouped) {
+          merge (view, result, names, types);
+        } else {
+          TableCopy::copyRows (view, result, view.nrow(), 0, result.nrow());
+        }
+      }
+      // Only after a successful merge, keep the query and the number of
+      // rows processed.
+      TableRecord rec;
+      rec.define ("query", query_p);
+      rec.define ("nrow", Int64(query.fromNRow()));
+      view.rwKeywordSet().defineRecord ("TAQL_VIEW", rec);
+      view.flush();
+    }
+    exists_p = True;
+    nrow_p   = query.fromNRow();
+    return view;
+  }
+
+  TableParseView::MergeType TableParseView::mergeType
+  (const TableExprNode& expr, const String& name)
+  {
+    TableExprNodeRep* rep = expr.getRep().get();
+    const TableExprAggrNode* aggr = dynamic_cast<const TableExprAggrNode*>(rep);
+    if (! aggr) {
+      if (! TableExprNodeUtil::getAggrNodes(rep).empty()) {
+        throw TableInvExpr ("Column " + name + " of an incremental view "
+                            "cannot be an expression of aggregate functions");
+      }
+      if (! expr.isScalar()) {
+        throw TableInvExpr ("Column " + name + " of an incremental view "
+                            "must be an aggregate or scalar key");
+      }
+      return KEY;
+    }
+    switch (aggr->funcType()) {
+    case TableExprFuncNode::countallFUNC:
+    case TableExprFuncNode::gcountFUNC:
+    case TableExprFuncNode::gsumFUNC:
+    case TableExprFuncNode::gsumsqrFUNC:
+    case TableExprFuncNode::gntrueFUNC:
+    case TableExprFuncNode::gnfalseFUNC:
+      return SUM;
+    case TableExprFuncNode::gproductFUNC:
+      return PRODUCT;
+    case TableExprFuncNode::gminFUNC:
+      return MIN;
+    case TableExprFuncNode::gmaxFUNC:
+      return MAX;
+    case TableExprFuncNode::ganyFUNC:
+      return ANY;
+    case TableExprFuncNode::gallFUNC:
+      return ALL;
+    case TableExprFuncNode::gfirstFUNC:
+      return FIRST;
+    case TableExprFuncNode::glastFUNC:
+      return LAST;
+    default:
+      break;
+    }
+    throw TableInvExpr ("Aggregate function of column " + name +
+                        " cannot be updated incrementally; only gcount, "
+                        "gsum, gsumsqr, gproduct, gmin, gmax, gany, gall, "
+                        "gntrue, gnfalse, gfirst and glast can");
+  }
+
+  void TableParseView::merge (Table& view, const Table& result,
+                              const Block<String>& names,
+                              const std::vector<MergeType>& types) const
+  {
+    std::vector<TableColumn> viewCols;
+    std::vector<TableColumn> resCols;
+    for (uInt i=0; i<names.size(); ++i) {
+      viewCols.push_back (TableColumn(view, names[i]));
+      resCols.push_back (TableColumn(result, names[i]));
+    }
+    // Index the groups in the view on their keys.
+    std::vector<TableExprNode> viewNodes = keyNodes (view, names, types);
+    std::vector<TableExprNode> resNodes  = keyNodes (result, names, types);
+    TableExprGroupKeySet key(viewNodes);
+    std::map<TableExprGroupKeySet,rownr_t> groups;
+    for (rownr_t row=0; row<view.nrow(); ++row) {
+      key.fill (viewNodes, TableExprId(row));
+      groups.insert (std::make_pair (key, row));
+    }
+    for (rownr_t row=0; row<result.nrow(); ++row) {
+      key.fill (resNodes, TableExprId(row));
+      std::map<TableExprGroupKeySet,rownr_t>::const_iterator iter =
+        groups.find (key);
+      if (iter == groups.end()) {
+        // A new group.
+        rownr_t viewRow = view.nrow();
+        view.addRow();
+        for (uInt i=0; i<viewCols.size(); ++i) {
+          viewCols[i].put (viewRow, resCols[i], row);
+        }
+        groups.insert (std::make_pair (key, viewRow));
+      } else {
+        for (uInt i=0; i<viewCols.size(); ++i) {
+          mergeValue (types[i], viewCols[i], iter->second, resCols[i], row);
+        }
+      }
+    }
+  }
+
+  std::vector<TableExprNode> TableParseView::keyNodes
+  (const Table& table, const Block<String>& names,
+   const std::vector<MergeType>& types)
+  {
+    std::vector<TableExprNode> nodes;
+    for (uInt i=0; i<names.size(); ++i) {
+      if (types[i] == KEY) {
+        nodes.push_back (table.col (names[i]));
+      }
+    }
+    return nodes;
+  }
+
+  void TableParseView::mergeValue (MergeType type, TableColumn& viewCol,
+                                   rownr_t viewRow, const TableColumn& resCol,
+                                   rownr_t resRow)
+  {
+    DataType dtype = viewCol.columnDesc().dataType();
+    Bool isInt = (dtype == TpUChar  ||  dtype == TpShort  ||
+                  dtype == TpUShort  ||  dtype == TpInt  ||
+                  dtype == TpUInt  ||  dtype == TpInt64);
+    Bool isReal = (dtype == TpFloat  ||  dtype == TpDouble);
+    Bool isComplex = (dtype == TpComplex  ||  dtype == TpDComplex);
+    switch (type) {
+    case KEY:
+    case FIRST:
+      break;
+    case LAST:
+      viewCol.put (viewRow, resCol, resRow);
+      break;
+    case SUM:
+    case PRODUCT:
+      if (isInt) {
+        Int64 v1 = viewCol.asInt64 (viewRow);
+        Int64 v2 = resCol.asInt64 (resRow);
+        viewCol.putScalar (viewRow, type==SUM ? v1+v2 : v1*v2);
+      } else if (isReal) {
+        Double v1 = viewCol.asdouble (viewRow);
+        Double v2 = resCol.asdouble (resRow);
+        viewCol.putScalar (viewRow, type==SUM ? v1+v2 : v1*v2);
+      } else if (isComplex) {
+        DComplex v1 = viewCol.asDComplex (viewRow);
+        DComplex v2 = resCol.asDComplex (resRow);
+        viewCol.putScalar (viewRow, type==SUM ? v1+v2 : v1*v2);
+      } else {
+        throw TableInvExpr ("Column " + viewCol.columnDesc().name() +
+                            " of an incremental view cannot be summed");
+      }
+      break;
+    case MIN:
+    case MAX:
+      if (isInt) {
+        Int64 v1 = viewCol.asInt64 (viewRow);
+        Int64 v2 = resCol.asInt64 (resRow);
+        viewCol.putScalar (viewRow, type==MIN ? std::min(v1,v2)
+                                              : std::max(v1,v2));
+      } else if (isReal) {
+        Double v1 = viewCol.asdouble (viewRow);
+        Double v2 = resCol.asdouble (resRow);
+        viewCol.putScalar (viewRow, type==MIN ? std::min(v1,v2)
+                                              : std::max(v1,v2));
+      } else {
+        throw TableInvExpr ("Column " + viewCol.columnDesc().name() +
+                            " of an incremental view cannot be compared");
+      }
+      break;
+    case ANY:
+      viewCol.putScalar (viewRow, Bool(viewCol.asBool(viewRow) ||
+                                       resCol.asBool(resRow)));
+      break;
+    case ALL:
+      viewCol.putScalar (viewRow, Bool(viewCol.asBool(viewRow) &&
+                                       resCol.asBool(resRow)));
+      break;
+    }
+  }
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,156 @@
+//# TableParseView.h: Class handling an incremental view
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_TABLEPARSEVIEW_H
+#define TABLES_TABLEPARSEVIEW_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+  //# Forward declarations.
+  class TableParseQuery;
+  class TableColumn;
+  class TableExprNode;
+
+  // <summary>
+  // Class handling an incremental view in a TaQL command
+  // </summary>
+
+  // <use visibility=local>
+
+  // <reviewed reviewer="" date="" tests="tTableGramView">
+  // </reviewed>
+
+  // <prerequisite>
+  //# Classes you should understand before using this one.
+  //  <li> TableParseQuery
+  // </prerequisite>
+
+  // <synopsis>
+  // The TaQL command
+  // <srcblock>
+  //   CREATE VIEW name INCREMENTAL AS SELECT ... FROM table ...
+  // </srcblock>
+  // stores the result of the query in a plain table. Its keyword TAQL_VIEW
+  // holds the query and the number of rows of the queried table processed
+  // so far. When the same command is given again, only the rows added to the
+  // queried table since the previous evaluation are processed and the
+  // result is merged into the view. If rows have been removed from the
+  // queried table, the view is created again from scratch.
+  // <p>
+  // The result of a query without aggregation is appended to the view.
+  // For a query with GROUPBY and/or aggregate functions the groups are
+  // matched on the values of the non-aggregate (scalar) columns, so the
+  // GROUPBY keys have to be part of the SELECT columns. The result of an
+  // aggregate column is merged with the stored value, which is only possible
+  // for aggregate functions whose partial results can be combined:
+  // gcount, gsum, gsumsqr, gproduct, gmin, gmax, gany, gall, gntrue, gnfalse,
+  // gfirst and glast. A new group is added to the view.
+  // <br>The query cannot contain DISTINCT, HAVING, ORDERBY, LIMIT, OFFSET or
+  // GIVING. Only the first table in the FROM clause is processed
+  // incrementally.
+  // <br>The view is updated while holding a write lock and the keyword
+  // TAQL_VIEW is only updated after the merge succeeded.
+  // </synopsis>
+
+  // <motivation>
+  // Monitoring tools regularly evaluate the same aggregation query on
+  // tables growing by appending rows. Reprocessing all rows every time
+  // gets expensive.
+  // </motivation>
+
+  class TableParseView
+  {
+  public:
+    // Open the view if it already exists.
+    // An exception is thrown if the table exists, but is no view or
+    // is a view created with another query.
+    TableParseView (const String& name, const String& query);
+
+    // Get the first row in the queried table to be processed.
+    // It is 0 if the view does not exist yet or if rows have been removed
+    // from the queried table.
+    rownr_t firstRow (const Table& source);
+
+    // Create the view from the query result or merge the query result
+    // into the existing view. It returns the view.
+    Table update (const TableParseQuery& query);
+
+  private:
+    // Define how a column is merged.
+    enum MergeType {
+      // A key used to match the groups.
+      KEY,
+      // Sum, count or sum of squares.
+      SUM,
+      PRODUCT,
+      MIN,
+      MAX,
+      ANY,
+      ALL,
+      // Keep the old value.
+      FIRST,
+      // Take the new value.
+      LAST
+    };
+
+    // Determine how the result of a projected expression can be merged.
+    // An exception is thrown if that is not possible.
+    static MergeType mergeType (const TableExprNode& expr,
+                                const String& name);
+
+    // Merge the result rows into the matching groups in the view.
+    // New groups are added.
+    void merge (Table& view, const Table& result,
+                const Block<String>& names,
+                const std::vector<MergeType>& types) const;
+
+    // Make the expressions for the key columns in the table, which are
+    // used to match the groups in the same way as GROUPBY does.
+    static std::vector<TableExprNode> keyNodes
+    (const Table& table, const Block<String>& names,
+     const std::vector<MergeType>& types);
+
+    // Merge the value of a result cell into a view cell.
+    static void mergeValue (MergeType type, TableColumn& viewCol,
+                            rownr_t viewRow, const TableColumn& resCol,
+                            rownr_t resRow);
+
+    //# Data members.
+    String  name_p;
+    String  query_p;
+    Bool    exists_p;
+    rownr_t nrow_p;
+  };
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
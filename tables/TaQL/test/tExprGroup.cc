@@ -26,11 +26,13 @@
 #include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/tables/TaQL/ExprAggrNode.h>
 #include <casacore/tables/TaQL/ExprGroupAggrFunc.h>
+#include <casacore/tables/TaQL/ExprGroup.h>
 #include <casacore/tables/TaQL/RecordExpr.h>
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/IO/ArrayIO.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/stdvector.h>
@@ -58,6 +60,29 @@ Bool foundError = False;
   }\
 }
 
+// Apply the aggregate function to two parts of the records and merge them.
+// It returns a null pointer if the function cannot merge.
+std::shared_ptr<TableExprGroupFuncBase> applyMerged (TableExprAggrNode& aggr,
+                                                     const vector<Record>& recs)
+{
+  std::shared_ptr<TableExprGroupFuncBase> func1 = aggr.makeGroupAggrFunc();
+  if (! func1->canMerge()) {
+    return std::shared_ptr<TableExprGroupFuncBase>();
+  }
+  std::shared_ptr<TableExprGroupFuncBase> func2 = aggr.makeGroupAggrFunc();
+  for (uInt i=0; i<recs.size(); ++i) {
+    TableExprId id(recs[i]);
+    if (i < recs.size()/3) {
+      func1->apply (id);
+    } else {
+      func2->apply (id);
+    }
+  }
+  func1->merge (*func2);
+  func1->finish();
+  return func1;
+}
+
 void check (const TableExprNode& expr,
             const vector<Record>& recs,
             Bool expVal, const String& str)
@@ -78,6 +103,15 @@ void check (const TableExprNode& expr,
     cout << str << ": found value " << val << "; expected "
          << expVal << endl;
   }
+  func = applyMerged (aggr, recs);
+  if (func) {
+    val = func->getBool();
+    if (val != expVal) {
+      foundError = True;
+      cout << str << ": found merged value " << val << "; expected "
+           << expVal << endl;
+    }
+  }
 }
 
 void check (const TableExprNode& expr,
@@ -100,6 +134,15 @@ void check (const TableExprNode& expr,
     cout << str << ": found value " << val << "; expected "
          << expVal << endl;
   }
+  func = applyMerged (aggr, recs);
+  if (func) {
+    val = func->getInt();
+    if (val != expVal) {
+      foundError = True;
+      cout << str << ": found merged value " << val << "; expected "
+           << expVal << endl;
+    }
+  }
 }
 
 void check (const TableExprNode& expr,
@@ -122,6 +165,15 @@ void check (const TableExprNode& expr,
     cout << str << ": found value " << val << "; expected "
          << expVal << endl;
   }
+  func = applyMerged (aggr, recs);
+  if (func) {
+    val = func->getDouble();
+    if (!near (val, expVal, 1.e-10)) {
+      foundError = True;
+      cout << str << ": found merged value " << val << "; expected "
+           << expVal << endl;
+    }
+  }
 }
 
 void check (const TableExprNode& expr,
@@ -144,6 +196,15 @@ void check (const TableExprNode& expr,
     cout << str << ": found value " << val << "; expected "
          << expVal << endl;
   }
+  func = applyMerged (aggr, recs);
+  if (func) {
+    val = func->getDComplex();
+    if (!near (val, expVal, 1.e-10)) {
+      foundError = True;
+      cout << str << ": found merged value " << val << "; expected "
+           << expVal << endl;
+    }
+  }
 }
 
 void checkLazy (const TableExprNode& expr,
@@ -467,9 +528,31 @@ void doDComplexArr()
 }
 
 
+void doGroupKey()
+{
+  cout << "Test group keys" << endl;
+  TableExprGroupKey k1(TableExprNodeRep::NTDouble);
+  TableExprGroupKey k2(TableExprNodeRep::NTDouble);
+  k1.set (2.5);
+  k2.set (2.5);
+  AlwaysAssertExit (k1 == k2  &&  k1.hash() == k2.hash());
+  k2.set (3.);
+  AlwaysAssertExit (! (k1 == k2));
+  // NaN values form a single group.
+  k1.set (doubleNaN());
+  k2.set (doubleNaN());
+  AlwaysAssertExit (k1 == k2  &&  k1.hash() == k2.hash());
+  TableExprGroupKey k3(TableExprNodeRep::NTString);
+  TableExprGroupKey k4(TableExprNodeRep::NTString);
+  k3.set (String("abc"));
+  k4.set (String("abc"));
+  AlwaysAssertExit (k3 == k4  &&  k3.hash() == k4.hash());
+}
+
 int main()
 {
   try {
+    doGroupKey();
     cout << "test Scalar aggregation ..." << endl;
     doBool();
     doInt();
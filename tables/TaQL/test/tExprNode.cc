@@ -27,6 +27,12 @@
 #include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/tables/TaQL/ExprNodeSet.h>
 #include <casacore/tables/TaQL/RecordExpr.h>
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/Table.h>
 #include <casacore/casa/Arrays/Matrix.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
@@ -1107,6 +1113,105 @@ void doIt()
   checkFailure ("min sz", min(esz1));
 }
 
+// Check that selecting rows (which evaluates the expression in chunks)
+// gives the same result as evaluating the expression row by row.
+void checkBatch (const String& str, const Table& tab,
+                 const TableExprNode& expr, rownr_t maxRow=0, rownr_t offset=0,
+                 uInt nthreads=1)
+{
+  Vector<rownr_t> rownrs = tab(expr, maxRow, offset, nthreads).rowNumbers(tab);
+  std::vector<rownr_t> expRownrs;
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    if (expr.getBool(i)) {
+      if (offset > 0) {
+        offset--;
+      } else {
+        expRownrs.push_back (i);
+        if (expRownrs.size() == maxRow) {
+          break;
+        }
+      }
+    }
+  }
+  if (! allEQ (rownrs, Vector<rownr_t>(expRownrs))) {
+    foundError = True;
+    cout << str << ": batch selection (nthreads=" << nthreads << ") of "
+         << rownrs.size()
+         << " rows differs from row-wise selection of "
+         << expRownrs.size() << " rows" << endl;
+  }
+}
+
+void doBatch()
+{
+  // Create a table with more rows than the chunk size used in select.
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Bool>("colb"));
+  td.addColumn (ScalarColumnDesc<Int>("coli"));
+  td.addColumn (ScalarColumnDesc<uShort>("colus"));
+  td.addColumn (ScalarColumnDesc<Float>("colf"));
+  td.addColumn (ScalarColumnDesc<Double>("cold"));
+  td.addColumn (ScalarColumnDesc<String>("cols"));
+  SetupNewTable newtab("tExprNode_tmp.tab", td, Table::New);
+  Table tab(newtab, 10000);
+  ScalarColumn<Bool> colb(tab, "colb");
+  ScalarColumn<Int> coli(tab, "coli");
+  ScalarColumn<uShort> colus(tab, "colus");
+  ScalarColumn<Float> colf(tab, "colf");
+  ScalarColumn<Double> cold(tab, "cold");
+  ScalarColumn<String> cols(tab, "cols");
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    colb.put (i, i%3 == 0);
+    coli.put (i, Int(i%101) - 50);
+    colus.put (i, i%7);
+    colf.put (i, i/10.);
+    cold.put (i, i*0.5 - 100);
+    cols.put (i, String::toString(i%5));
+  }
+  TableExprNode eb(tab.col("colb"));
+  TableExprNode ei(tab.col("coli"));
+  TableExprNode eus(tab.col("colus"));
+  TableExprNode ef(tab.col("colf"));
+  TableExprNode ed(tab.col("cold"));
+  TableExprNode es(tab.col("cols"));
+  // Evaluate sequentially and in parallel (also if no threads available).
+  // The random number expression is always evaluated sequentially.
+  for (uInt nthreads=1; nthreads<=4; nthreads+=3) {
+    checkBatch ("b", tab, eb, 0, 0, nthreads);
+    checkBatch ("!b", tab, !eb, 0, 0, nthreads);
+    checkBatch ("i>0", tab, ei > 0, 0, 0, nthreads);
+    checkBatch ("i+us>=3", tab, ei + eus >= 3, 0, 0, nthreads);
+    checkBatch ("-i*2==us", tab, -ei * 2 == eus, 0, 0, nthreads);
+    checkBatch ("i-1!=us", tab, ei - 1 != eus, 0, 0, nthreads);
+    checkBatch ("f<d/3", tab, ef < ed/3, 0, 0, nthreads);
+    checkBatch ("f*2+d>=i", tab, ef*2 + ed >= ei, 0, 0, nthreads);
+    checkBatch ("d-f==i", tab, ed - ef == ei, 0, 0, nthreads);
+    checkBatch ("b==(i<0)", tab, eb == (ei < 0), 0, 0, nthreads);
+    checkBatch ("b!=(d>0)", tab, eb != (ed > 0), 0, 0, nthreads);
+    checkBatch ("b&&i>10", tab, eb && ei > 10, 0, 0, nthreads);
+    checkBatch ("b||f>500", tab, eb || ef > 500, 0, 0, nthreads);
+    checkBatch ("!(b||i<0)&&d<1000", tab, !(eb || ei < 0) && ed < 1000,
+                0, 0, nthreads);
+    checkBatch ("s=='3'&&i>0", tab, es == "3" && ei > 0, 0, 0, nthreads);
+    checkBatch ("sqrt(f)>i", tab, sqrt(ef) > ei, 0, 0, nthreads);
+    checkBatch ("rownr%7==us", tab, tab.nodeRownr() % 7 == eus,
+                0, 0, nthreads);
+    checkBatch ("i>0 max", tab, ei > 0, 3000, 0, nthreads);
+    checkBatch ("i>0 max,offset", tab, ei > 0, 3000, 2500, nthreads);
+    checkBatch ("i>0 offset", tab, ei > 0, 0, 4500, nthreads);
+  }
+  Table sel = tab(tab.nodeRandom() >= 0, 0, 0, 4);
+  AlwaysAssertExit (sel.nrow() == tab.nrow());
+  // Check if the number of threads can be set in a TaQL command.
+  for (String style : {"PARALLEL", "PARALLEL4", "NOPARALLEL"}) {
+    Table res = tableCommand ("using style " + style +
+                              " select from tExprNode_tmp.tab"
+                              " where coli>0 && cold<1000").table();
+    AlwaysAssertExit (allEQ (res.rowNumbers(),
+                             tab(ei>0 && ed<1000).rowNumbers()));
+  }
+}
+
 void doShow()
 {
   // Make some expressions where constants should have been pre-evaluated.
@@ -1123,6 +1228,7 @@ int main()
   try {
     doIt();
     doShow();
+    doBatch();
   } catch (std::exception& x) {
     cout << "Unexpected exception: " << x.what() << endl;
     return 1;
@@ -0,0 +1,140 @@
+//# tTaQLJoin.cc: Test program for the hash join in TaQL
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/TaQLJoin.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/DataMan/MemoryStMan.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for the hash join in TaQL.
+// </summary>
+
+
+// Create a table with an Int and a String column.
+Table makeTable (uInt nrow, Int modInt, Int modStr)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>("ID"));
+  td.addColumn (ScalarColumnDesc<String>("NAME"));
+  SetupNewTable newtab("", td, Table::Scratch);
+  MemoryStMan stman;
+  newtab.bindAll (stman);
+  Table tab(newtab, Table::Memory, nrow);
+  ScalarColumn<Int> idCol(tab, "ID");
+  ScalarColumn<String> nameCol(tab, "NAME");
+  for (uInt i=0; i<nrow; ++i) {
+    idCol.put (i, (i*7) % modInt);
+    nameCol.put (i, "n" + String::toString((i*3) % modStr));
+  }
+  return tab;
+}
+
+// Find the first matching join row by brute force.
+Int64 bruteForce (const Table& mainTab, const Table& joinTab,
+                  rownr_t row, Bool useName)
+{
+  ScalarColumn<Int> mainId(mainTab, "ID");
+  ScalarColumn<String> mainName(mainTab, "NAME");
+  ScalarColumn<Int> joinId(joinTab, "ID");
+  ScalarColumn<String> joinName(joinTab, "NAME");
+  for (rownr_t i=0; i<joinTab.nrow(); ++i) {
+    if (mainId(row) == joinId(i)  &&
+        (!useName  ||  mainName(row) == joinName(i))) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void doJoin (Bool useName)
+{
+  Table mainTab = makeTable (500, 97, 5);
+  Table joinTab = makeTable (2000, 83, 7);
+  std::vector<TableExprNode> mainNodes (1, mainTab.col("ID"));
+  std::vector<TableExprNode> joinNodes (1, joinTab.col("ID"));
+  if (useName) {
+    mainNodes.push_back (mainTab.col("NAME"));
+    joinNodes.push_back (joinTab.col("NAME"));
+  }
+  std::vector<rownr_t> rows(joinTab.nrow());
+  for (rownr_t i=0; i<rows.size(); ++i) {
+    rows[i] = i;
+  }
+  TaQLJoinHash hashJoin (mainNodes, joinNodes, rows, mainNodes.size());
+  std::shared_ptr<TaQLJoinBase> treeJoin =
+    TaQLJoin::createRecursive (mainNodes, joinNodes, rows, 0);
+  uInt nfound = 0;
+  for (rownr_t i=0; i<mainTab.nrow(); ++i) {
+    TableExprId id(i);
+    Int64 row = hashJoin.findRow (id);
+    AlwaysAssertExit (row == bruteForce (mainTab, joinTab, i, useName));
+    // The tree join finds an arbitrary row with the same values.
+    Int64 row2 = treeJoin->findRow (id);
+    AlwaysAssertExit ((row < 0) == (row2 < 0));
+    if (row >= 0) {
+      nfound++;
+    }
+  }
+  AlwaysAssertExit (nfound > 0  &&  nfound < mainTab.nrow());
+}
+
+void doError()
+{
+  Table tab = makeTable (10, 5, 5);
+  std::vector<TableExprNode> mainNodes (1, tab.col("ID"));
+  std::vector<TableExprNode> joinNodes (1, tab.col("NAME"));
+  std::vector<rownr_t> rows(1, 0);
+  Bool failed = False;
+  try {
+    TaQLJoinHash hashJoin (mainNodes, joinNodes, rows, 1);
+  } catch (const std::exception&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+}
+
+int main()
+{
+  try {
+    doJoin (False);
+    doJoin (True);
+    doError();
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
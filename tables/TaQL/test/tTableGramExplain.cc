@@ -0,0 +1,183 @@
+//# tTableGramExplain.cc: Test program for EXPLAIN [ANALYZE] in TaQL
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <casacore/casa/sstream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for EXPLAIN [ANALYZE] in TaQL.
+// </summary>
+
+
+void makeTable()
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>("ANT"));
+  td.addColumn (ScalarColumnDesc<Double>("X"));
+  td.addColumn (ArrayColumnDesc<Float>("D", IPosition(1,4),
+                                       ColumnDesc::FixedShape));
+  SetupNewTable newtab("tTableGramExplain_tmp.tab", td, Table::New);
+  StandardStMan stman;
+  newtab.bindAll (stman);
+  Table tab(newtab, 100);
+  ScalarColumn<Int> antCol(tab, "ANT");
+  ScalarColumn<Double> xCol(tab, "X");
+  ArrayColumn<Float> dCol(tab, "D");
+  for (uInt i=0; i<tab.nrow(); ++i) {
+    antCol.put (i, i%4);
+    xCol.put (i, i);
+    dCol.put (i, Vector<Float>(4, i));
+  }
+}
+
+// Execute the command and return the explanation.
+String explain (const String& command)
+{
+  Vector<String> colNames;
+  String cmd;
+  TaQLResult res = tableCommand (command, std::vector<const Table*>(),
+                                 colNames, cmd);
+  AlwaysAssertExit (cmd == "explain");
+  AlwaysAssertExit (! res.isTable());
+  String str = res.node().getString(0);
+  cout << str << endl;
+  return str;
+}
+
+// Check if the text contains the given line, where leading blanks are
+// ignored and multiple blanks are treated as a single one.
+Bool hasLine (const String& text, const String& line)
+{
+  std::istringstream iss(text);
+  std::string textLine;
+  while (std::getline (iss, textLine)) {
+    std::istringstream words(textLine);
+    String collapsed;
+    std::string word;
+    while (words >> word) {
+      if (! collapsed.empty()) {
+        collapsed += ' ';
+      }
+      collapsed += word;
+    }
+    if (collapsed == line) {
+      return True;
+    }
+  }
+  return False;
+}
+
+void testPlan()
+{
+  String str = explain ("explain select ANT, gsum(X) as S "
+                        "from tTableGramExplain_tmp.tab where X >= 20 "
+                        "groupby ANT orderby ANT limit 3");
+  AlwaysAssertExit (str.find("Execution plan:") != String::npos);
+  AlwaysAssertExit (hasLine (str, "FROM tTableGramExplain_tmp.tab (100 rows)"));
+  AlwaysAssertExit (hasLine (str, "WHERE"));
+  AlwaysAssertExit (hasLine (str, "GROUPBY 1 key(s), "
+                                  "1 aggregate function(s)"));
+  AlwaysAssertExit (hasLine (str, "ORDERBY 1 key(s)"));
+  AlwaysAssertExit (hasLine (str, "LIMIT/OFFSET limit=3"));
+  AlwaysAssertExit (hasLine (str, "PROJECTION 2 column(s): ANT S"));
+  // The query has not been executed.
+  AlwaysAssertExit (str.find("Execution profile:") == String::npos);
+  // The result table would be created when preparing the query.
+  Bool failed = False;
+  try {
+    explain ("explain select ANT, X+1 as Y from tTableGramExplain_tmp.tab "
+             "where X >= 0 giving tTableGramExplain_tmp.res");
+  } catch (const AipsError& x) {
+    cout << x.getMesg() << endl;
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+  AlwaysAssertExit (! Table::isReadable ("tTableGramExplain_tmp.res"));
+  // With ANALYZE the result table is created.
+  str = explain ("explain analyze select ANT, X+1 as Y "
+                 "from tTableGramExplain_tmp.tab where X >= 0 "
+                 "giving tTableGramExplain_tmp.res");
+  AlwaysAssertExit (hasLine (str, "GIVING tTableGramExplain_tmp.res"));
+  AlwaysAssertExit (Table("tTableGramExplain_tmp.res").nrow() == 100);
+}
+
+void testAnalyze()
+{
+  String str = explain ("explain analyze select ANT, gsum(X) as S, "
+                        "gsum(D) as SD from tTableGramExplain_tmp.tab "
+                        "where X >= 20 groupby ANT orderby ANT limit 3");
+  AlwaysAssertExit (str.find("Execution profile:") != String::npos);
+  // WHERE reads all values of X.
+  AlwaysAssertExit (str.find("WHERE                100          80")
+                    != String::npos);
+  AlwaysAssertExit (hasLine (str, "X (StandardStMan) 800"));
+  // GROUPBY reads the selected rows of the columns used.
+  AlwaysAssertExit (str.find("GROUPBY               80           4")
+                    != String::npos);
+  AlwaysAssertExit (hasLine (str, "D (StandardStMan) 1280"));
+  AlwaysAssertExit (str.find("LIMIT/OFFSET           4           3")
+                    != String::npos);
+  AlwaysAssertExit (str.find("Total") != String::npos);
+}
+
+void testDistinct()
+{
+  // DISTINCT is done in the projection, thereafter LIMIT/OFFSET.
+  String str = explain ("explain analyze select distinct ANT "
+                        "from tTableGramExplain_tmp.tab offset 1");
+  AlwaysAssertExit (str.find ("DISTINCT") < str.find ("LIMIT/OFFSET"));
+  AlwaysAssertExit (str.find("PROJECTION           100           4")
+                    != String::npos);
+  AlwaysAssertExit (str.find("LIMIT/OFFSET           4           3")
+                    != String::npos);
+}
+
+int main()
+{
+  try {
+    makeTable();
+    testPlan();
+    testAnalyze();
+    testDistinct();
+  } catch (const std::exception& x) {
+    cout << "Exception caught: " << x.what() << endl;
+    return 1;
+  }
+  cout << "ok" << endl;
+  return 0;
+}
@@ -0,0 +1,113 @@
+//# tTableGramGroupParallel.cc: Test program for parallel GROUPBY in TaQL
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for the parallel GROUPBY in TaQL.
+// </summary>
+
+// The parallel GROUPBY is only used for at least 32768 rows.
+// The values of X are integral, so sums do not depend on the order
+// in which the rows are aggregated.
+void makeTable (uInt nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>("KEY1"));
+  td.addColumn (ScalarColumnDesc<String>("KEY2"));
+  td.addColumn (ScalarColumnDesc<Double>("X"));
+  SetupNewTable newtab("tTableGramGroupParallel_tmp.tab", td, Table::New);
+  StandardStMan stman;
+  newtab.bindAll (stman);
+  Table tab(newtab, nrow);
+  ScalarColumn<Int> key1Col(tab, "KEY1");
+  ScalarColumn<String> key2Col(tab, "KEY2");
+  ScalarColumn<Double> xCol(tab, "X");
+  for (uInt i=0; i<nrow; ++i) {
+    key1Col.put (i, i%7);
+    key2Col.put (i, "s" + String::toString((i*13)%11));
+    xCol.put (i, Double((i*31)%1000));
+  }
+}
+
+// Execute the query serially and in parallel and compare the results.
+void checkQuery (const String& query)
+{
+  Table serial = tableCommand ("using style noparallel " + query).table();
+  Table parallel = tableCommand ("using style parallel4 " + query).table();
+  AlwaysAssertExit (serial.nrow() > 0);
+  AlwaysAssertExit (serial.nrow() == parallel.nrow());
+  const TableDesc& td = serial.tableDesc();
+  AlwaysAssertExit (td.ncolumn() == parallel.tableDesc().ncolumn());
+  for (uInt i=0; i<td.ncolumn(); ++i) {
+    TableColumn scol(serial, td[i].name());
+    TableColumn pcol(parallel, td[i].name());
+    for (rownr_t row=0; row<serial.nrow(); ++row) {
+      if (td[i].dataType() == TpString) {
+        AlwaysAssertExit (scol.asString(row) == pcol.asString(row));
+      } else {
+        AlwaysAssertExit (near (scol.asdouble(row), pcol.asdouble(row),
+                                1e-10));
+      }
+    }
+  }
+}
+
+int main()
+{
+  try {
+    makeTable (50000);
+    // Multiple keys with various immediate aggregates.
+    checkQuery ("select KEY1, KEY2, gcount() as N, gsum(X) as S, "
+                "gmin(X) as MN, gmax(X) as MX, gmean(X) as ME, "
+                "gvariance(X) as V, gfirst(X) as F, glast(X) as L, "
+                "gntrue(X>500) as NT "
+                "from tTableGramGroupParallel_tmp.tab groupby KEY1, KEY2");
+    // A single key expression with a selection and ordering.
+    checkQuery ("select KEY1%3 as K, gsum(X) as S, grms(X) as R "
+                "from tTableGramGroupParallel_tmp.tab where X > 100 "
+                "groupby KEY1%3 orderby K");
+    // A lazy aggregate uses the collected row ids.
+    checkQuery ("select KEY2, gmedian(X) as MED, gcount() as N "
+                "from tTableGramGroupParallel_tmp.tab groupby KEY2 "
+                "having gcount() > 10");
+  } catch (const std::exception& x) {
+    cout << "Exception caught: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,201 @@
+//# tTableGramView.cc: Test program for incremental views in TaQL
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/TaQL/TableParse.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for incremental views in TaQL.
+// </summary>
+
+
+// Add rows to the table. ANT is i%3, X is i-2.
+void addRows (Table& tab, uInt nrow)
+{
+  ScalarColumn<Int> antCol(tab, "ANT");
+  ScalarColumn<Double> xCol(tab, "X");
+  rownr_t start = tab.nrow();
+  tab.addRow (nrow);
+  for (rownr_t i=start; i<tab.nrow(); ++i) {
+    antCol.put (i, i%3);
+    xCol.put (i, Double(i) - 2);
+  }
+}
+
+void makeTable (uInt nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>("ANT"));
+  td.addColumn (ScalarColumnDesc<Double>("X"));
+  SetupNewTable newtab("tTableGramView_tmp.tab", td, Table::New);
+  StandardStMan stman;
+  newtab.bindAll (stman);
+  Table tab(newtab);
+  addRows (tab, nrow);
+}
+
+// Check the grouped view against the brute force result of the source.
+void checkGrouped (const Table& view, rownr_t nrow)
+{
+  AlwaysAssertExit (view.nrow() == 3);
+  ScalarColumn<Int64> antCol(view, "ANT");
+  ScalarColumn<Double> sumCol(view, "S");
+  ScalarColumn<Int64> cntCol(view, "N");
+  ScalarColumn<Double> maxCol(view, "MX");
+  for (rownr_t row=0; row<view.nrow(); ++row) {
+    Int64 ant = antCol(row);
+    Double sum = 0;
+    Int64 cnt = 0;
+    Double mx = 0;
+    for (rownr_t i=0; i<nrow; ++i) {
+      Double x = Double(i) - 2;
+      if (Int64(i%3) == ant  &&  x > 0) {
+        sum += x;
+        cnt++;
+        mx = x;
+      }
+    }
+    AlwaysAssertExit (sumCol(row) == sum);
+    AlwaysAssertExit (cntCol(row) == cnt);
+    AlwaysAssertExit (maxCol(row) == mx);
+  }
+}
+
+void testGrouped()
+{
+  String command ("create view tTableGramView_tmp.grp incremental as "
+                  "select ANT, gsum(X) as S, gcount() as N, gmax(X) as MX "
+                  "from tTableGramView_tmp.tab where X > 0 groupby ANT");
+  makeTable (4);
+  {
+    // Only ANT 0 has a row with X>0, so the others are added later.
+    TaQLResult res = tableCommand (command);
+    AlwaysAssertExit (res.table().nrow() == 1);
+  }
+  for (uInt i=0; i<3; ++i) {
+    {
+      Table tab("tTableGramView_tmp.tab", Table::Update);
+      addRows (tab, 10 + i);
+    }
+    TaQLResult res = tableCommand (command);
+    checkGrouped (res.table(), 4 + 10*(i+1) + i*(i+1)/2);
+  }
+  {
+    // Nothing is added.
+    TaQLResult res = tableCommand (command);
+    checkGrouped (res.table(), 37);
+  }
+  {
+    // Removing rows recreates the view.
+    Table tab("tTableGramView_tmp.tab", Table::Update);
+    tab.removeRow (36);
+  }
+  TaQLResult res = tableCommand (command);
+  checkGrouped (res.table(), 36);
+}
+
+void testAppend()
+{
+  String command ("create view tTableGramView_tmp.sel incremental as "
+                  "select ANT, X*2 as Y from tTableGramView_tmp.tab "
+                  "where ANT == 1");
+  {
+    TaQLResult res = tableCommand (command);
+    AlwaysAssertExit (res.table().nrow() == 12);
+  }
+  {
+    Table tab("tTableGramView_tmp.tab", Table::Update);
+    addRows (tab, 9);
+  }
+  TaQLResult res = tableCommand (command);
+  Table view = res.table();
+  AlwaysAssertExit (view.nrow() == 15);
+  ScalarColumn<Int64> antCol(view, "ANT");
+  ScalarColumn<Double> yCol(view, "Y");
+  for (rownr_t i=0; i<view.nrow(); ++i) {
+    AlwaysAssertExit (antCol(i) == 1);
+    AlwaysAssertExit (yCol(i) == 2 * (Double(3*i + 1) - 2));
+  }
+}
+
+// Check that the command fails.
+void checkError (const String& command)
+{
+  Bool failed = False;
+  try {
+    tableCommand (command);
+  } catch (const AipsError& x) {
+    cout << x.getMesg() << endl;
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+}
+
+void testErrors()
+{
+  // Another query for an existing view.
+  checkError ("create view tTableGramView_tmp.sel incremental as "
+              "select ANT from tTableGramView_tmp.tab");
+  // A table which is no view.
+  checkError ("create view tTableGramView_tmp.tab incremental as "
+              "select ANT from tTableGramView_tmp.tab");
+  // Non-mergeable parts.
+  checkError ("create view tTableGramView_tmp.err incremental as "
+              "select ANT, gmean(X) as M from tTableGramView_tmp.tab "
+              "groupby ANT");
+  checkError ("create view tTableGramView_tmp.err incremental as "
+              "select ANT from tTableGramView_tmp.tab orderby ANT");
+  checkError ("create view tTableGramView_tmp.err incremental as "
+              "select ANT, gcount() as N from tTableGramView_tmp.tab "
+              "groupby ANT having gcount() > 2");
+  checkError ("create view tTableGramView_tmp.err incremental as "
+              "select gcount() as N from tTableGramView_tmp.tab "
+              "groupby ANT");
+  AlwaysAssertExit (! Table::isReadable ("tTableGramView_tmp.err"));
+}
+
+int main()
+{
+  try {
+    testGrouped();
+    testAppend();
+    testErrors();
+  } catch (const std::exception& x) {
+    cout << "Exception caught: " << x.what() << endl;
+    return 1;
+  }
+  cout << "ok" << endl;
+  return 0;
+}
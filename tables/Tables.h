@@ -42,6 +42,7 @@
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/ArrayColumn.h>
 #include <casacore/tables/Tables/TableRow.h>
+#include <casacore/tables/Tables/TableCopier.h>
 #include <casacore/tables/Tables/TableCopy.h>
 #include <casacore/tables/Tables/TableUtil.h>
 #include <casacore/casa/Arrays/Array.h>
@@ -161,6 +161,12 @@ Bool ArrayColumnData::canChangeShape() const
 }
 
 
+void ArrayColumnData::countArrayRead (const ArrayBase& array) const
+{
+    countRead (array.nelements() *
+               ValType::getTypeSize (colDescPtr_p->dataType()));
+}
+
 void ArrayColumnData::getArray (rownr_t rownr, ArrayBase& array) const
 {
     if (rtraceColumn_p) {
@@ -169,6 +175,7 @@ void ArrayColumnData::getArray (rownr_t rownr, ArrayBase& array) const
     }
     checkReadLock (True);
     dataColPtr_p->getArrayV (rownr, array);
+    countArrayRead (array);
     autoReleaseLock();
 }
 
@@ -182,7 +189,27 @@ void ArrayColumnData::getSlice (rownr_t rownr, const Slicer& ns,
     }
     checkReadLock (True);
     dataColPtr_p->getSliceV (rownr, ns, array);
+    countArrayRead (array);
+    autoReleaseLock();
+}
+
+Bool ArrayColumnData::getArrayView (rownr_t rownr, const Slicer* slicer,
+                                    const void*& data, IPosition& blockShape,
+                                    Slicer& section) const
+{
+    checkReadLock (True);
+    Bool fnd = dataColPtr_p->getArrayViewV (rownr, slicer, data,
+                                            blockShape, section);
+    autoReleaseLock();
+    return fnd;
+}
+
+Bool ArrayColumnData::getColumnView (const void*& data, IPosition& shape) const
+{
+    checkReadLock (True);
+    Bool fnd = dataColPtr_p->getColumnViewV (data, shape);
     autoReleaseLock();
+    return fnd;
 }
 
 
@@ -229,6 +256,7 @@ void ArrayColumnData::getArrayColumn (ArrayBase& array) const
     }
     checkReadLock (True);
     dataColPtr_p->getArrayColumnV (array);
+    countArrayRead (array);
     autoReleaseLock();
 }
 
@@ -242,6 +270,21 @@ void ArrayColumnData::getArrayColumnCells (const RefRows& rownrs,
     }
     checkReadLock (True);
     dataColPtr_p->getArrayColumnCellsV (rownrs, array);
+    countArrayRead (array);
+    autoReleaseLock();
+}
+
+void ArrayColumnData::getArrayColumnCellsParallel (const RefRows& rownrs,
+                                                   ArrayBase& array,
+                                                   uInt nthreads) const
+{
+    if (rtraceColumn_p) {
+      TableTrace::trace (traceId(), columnDesc().name(), 'r', rownrs,
+                         array.shape());
+    }
+    checkReadLock (True);
+    dataColPtr_p->getArrayColumnCellsParallel (rownrs, array, nthreads);
+    countArrayRead (array);
     autoReleaseLock();
 }
 
@@ -255,6 +298,7 @@ void ArrayColumnData::getColumnSlice (const Slicer& ns,
     }
     checkReadLock (True);
     dataColPtr_p->getColumnSliceV (ns, array);
+    countArrayRead (array);
     autoReleaseLock();
 }
 
@@ -269,6 +313,7 @@ void ArrayColumnData::getColumnSliceCells (const RefRows& rownrs,
     }
     checkReadLock (True);
     dataColPtr_p->getColumnSliceCellsV (rownrs, ns, array);
+    countArrayRead (array);
     autoReleaseLock();
 }
 
@@ -161,6 +161,16 @@ public:
     // the actual length. This is checked by ArrayColumn.
     void getSlice (rownr_t rownr, const Slicer&, ArrayBase& arrayPtr) const;
 
+    // Get a read-only view of an array (or a slice of it) in a particular
+    // cell without copying the data, if the data manager supports it.
+    Bool getArrayView (rownr_t rownr, const Slicer* slicer,
+                       const void*& data, IPosition& blockShape,
+                       Slicer& section) const;
+
+    // Get a read-only view of the arrays in the entire column without
+    // copying the data, if the data manager supports it.
+    Bool getColumnView (const void*& data, IPosition& shape) const;
+
     // Get the array of all values in a column.
     // If the column contains n-dim arrays, the resulting array is (n+1)-dim.
     // The arrays in the column have to have the same shape in all cells.
@@ -175,6 +185,12 @@ public:
     // the actual length. This is checked by ArrayColumn.
     void getArrayColumnCells (const RefRows& rownrs, ArrayBase& arrayPtr) const;
 
+    // Get some arrays in the column using multiple threads.
+    // See DataManagerColumn::getArrayColumnCellsParallel.
+    void getArrayColumnCellsParallel (const RefRows& rownrs,
+                                      ArrayBase& arrayPtr,
+                                      uInt nthreads) const;
+
     // Get subsections from all arrays in the column.
     // If the column contains n-dim arrays, the resulting array is (n+1)-dim.
     // The arrays in the column have to have the same shape in all cells.
@@ -246,6 +262,9 @@ private:
     // correctly (i.e. if matching possible #dim in column description).
     void checkShape (const IPosition& shape) const;
 
+    // Count the number of bytes in the array read.
+    void countArrayRead (const ArrayBase& array) const;
+
     // Write the column data.
     // The control information is written into the given AipsIO object,
     // while the data is written/flushed by the data manager.
@@ -37,6 +37,93 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 //# Forward Declarations
 class ColumnSlicer;
+template<class T> class ArrayColumn;
+
+
+// <summary>
+// Read-only view of the array in a table cell
+// </summary>
+
+// <use visibility=export>
+
+// <synopsis>
+// An ArrayColumnView is filled by the functions
+// <src>ArrayColumn::getView</src> and <src>ArrayColumn::getSliceView</src>.
+// It can reference the data in the data manager directly (e.g. in a
+// memory-mapped tile), so it only gives const access to the data
+// to ensure that they cannot be changed behind the data manager's back.
+// An ordinary array with a copy of the data can be obtained with
+// function <src>copy</src>.
+// <br>A view is only valid as long as the table is open and the column
+// is not changed (e.g., by adding rows or putting data).
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   ArrayColumn<Float> data(table, "DATA");
+//   ArrayColumnView<Float> view;
+//   data.getView (0, view);
+//   Float sum = 0;
+//   for (Float v : view) sum += v;
+// </srcblock>
+// </example>
+
+template<class T>
+class ArrayColumnView
+{
+public:
+    typedef typename Array<T>::const_iterator const_iterator;
+
+    ArrayColumnView()
+      : isView_p (False)
+    {}
+
+    // Does the view reference the data in the data manager?
+    // If False, it contains a copy of the data.
+    Bool isView() const
+      { return isView_p; }
+
+    // Get the shape, dimensionality and number of elements.
+    // <group>
+    const IPosition& shape() const
+      { return array_p.shape(); }
+    size_t ndim() const
+      { return array_p.ndim(); }
+    size_t nelements() const
+      { return array_p.nelements(); }
+    // </group>
+
+    // Get a pointer to the first element. The elements are only
+    // contiguous if <src>contiguousStorage()</src> is True.
+    // <group>
+    const T* data() const
+      { return array_p.data(); }
+    Bool contiguousStorage() const
+      { return array_p.contiguousStorage(); }
+    // </group>
+
+    // Get the value at the given index.
+    const T& operator() (const IPosition& index) const
+      { return array_p(index); }
+
+    // Iterate through the elements.
+    // <group>
+    const_iterator begin() const
+      { return array_p.begin(); }
+    const_iterator end() const
+      { return array_p.end(); }
+    // </group>
+
+    // Copy the data into a new array.
+    Array<T> copy() const
+      { return array_p.copy(); }
+
+private:
+    friend class ArrayColumn<T>;
+
+    Array<T> array_p;
+    Bool     isView_p;
+};
 
 
 // <summary>
@@ -76,6 +163,19 @@ class ColumnSlicer;
 // isNull and throwIfNull can be used to test on this.
 // The functions attach and reference can fill in the object.
 //
+// The functions getView and getSliceView give read-only access to the data
+// in a cell (using class ArrayColumnView) without copying them, if the underlying data manager supports it.
+// Currently that is the case for the tiled storage managers when the
+// table is opened with memory-mapped IO (see
+// <linkto class=TSMOption>TSMOption</linkto>), the data are stored
+// in the local byte order, and the cell (slice) lies within a single tile.
+// The resulting array references the memory-mapped data directly, which
+// avoids allocation and copying for large read-mostly workloads.
+// It is also the case for fixed shaped arrays held by the MemoryStMan.
+// Similarly, getColumnView gives a view of the arrays in the entire column
+// if the MemoryStMan holds them in a single block (i.e. in arena mode).
+// If a view is not possible, the data are copied as usual.
+//
 // The assignment operator is not defined for this class, because it was
 // felt it would be too confusing. Instead the function reference can
 // be used to do assignment with reference semantics. An assignment
@@ -185,6 +285,18 @@ public:
     Array<T> getSlice (rownr_t rownr, const Slicer& arraySection) const;
     // </group>
 
+    // Get a read-only view of the array (or a slice of it) in a particular
+    // cell. If possible, the view references the data in the data manager
+    // directly and True is returned. Otherwise the data are copied into
+    // the view and False is returned.
+    // <br>The view is only valid as long as the table is open and the
+    // column is not changed (e.g., by adding rows or putting data).
+    // <group>
+    Bool getView (rownr_t rownr, ArrayColumnView<T>& view) const;
+    Bool getSliceView (rownr_t rownr, const Slicer& arraySection,
+                       ArrayColumnView<T>& view) const;
+    // </group>
+
     // Get an irregular slice of an N-dimensional array in a particular cell
     // (i.e. table row)  as given by the vectors of Slice objects.
     // The outer vector represents the array axes.
@@ -231,6 +343,17 @@ public:
     Array<T> getColumn() const;
     // </group>
 
+    // Get a read-only view of the arrays in all cells of the column
+    // as an (n+1)-dim array with the last dimension representing the
+    // number of rows. If possible, the array references the data in the
+    // data manager directly and True is returned. That is the case for
+    // fixed shaped arrays in a MemoryStMan in arena mode (see
+    // <linkto class=MemoryStMan>MemoryStMan</linkto>).
+    // Otherwise the data are copied into a new array and False is returned.
+    // <br>The array referencing the data must not be changed. It is only
+    // valid as long as the table is open and no rows are added or removed.
+    Bool getColumnView (Array<T>& view) const;
+
     // Get regular slices from all arrays in the column.
     // If the column contains n-dim arrays, the resulting array is (n+1)-dim.
     // with the last dimension representing the number of rows and the
@@ -296,6 +419,22 @@ public:
     Array<T> getColumnCells (const RefRows& rownrs) const;
     // </group>
 
+    // Get the array of some values in a column like the functions above,
+    // but split the rows in chunks that are read by multiple threads.
+    // The chunks are aligned with the tiles and read directly into the
+    // destination array, so no intermediate copies are made.
+    // The rows are only read in parallel if the data manager supports
+    // concurrent access (e.g., a tiled storage manager opened with a
+    // TSMOption using a thread-safe cache, i.e., a positive number of
+    // shards); otherwise the rows are read in the usual way.
+    // A value 0 for <src>nthreads</src> means using OMP::maxThreads().
+    // <group>
+    void getColumnRangeParallel (const Slicer& rowRange, Array<T>& arr,
+                                 Bool resize = False, uInt nthreads = 0) const;
+    void getColumnCellsParallel (const RefRows& rownrs, Array<T>& arr,
+                                 Bool resize = False, uInt nthreads = 0) const;
+    // </group>
+
     // Get slices from some arrays in a column.
     // The first Slicer object can be used to specify start, end (or length),
     // and stride of the rows to get. The second Slicer object can be
@@ -444,6 +583,11 @@ public:
 private:
     // Check if the data type matches the column data type.
     void checkDataType() const;
+
+    // Make a view of the array (slice) in a cell, or copy it if that
+    // cannot be done. The slicer pointer is null for the full array.
+    Bool makeView (rownr_t rownr, const Slicer* arraySection,
+                   ArrayColumnView<T>& view) const;
 };
 
 
@@ -150,6 +150,49 @@ void ArrayColumn<T>::getSlice (rownr_t rownr, const Slicer& arraySection,
 }
 
 
+template<class T>
+Bool ArrayColumn<T>::getView (rownr_t rownr,
+                              ArrayColumnView<T>& view) const
+{
+    return makeView (rownr, 0, view);
+}
+
+template<class T>
+Bool ArrayColumn<T>::getSliceView (rownr_t rownr, const Slicer& arraySection,
+                                   ArrayColumnView<T>& view) const
+{
+    return makeView (rownr, &arraySection, view);
+}
+
+template<class T>
+Bool ArrayColumn<T>::makeView (rownr_t rownr, const Slicer* arraySection,
+                               ArrayColumnView<T>& view) const
+{
+    TABLECOLUMNCHECKROW(rownr);
+    const void* data;
+    IPosition blockShape;
+    Slicer section;
+    if (baseColPtr_p->getArrayView (rownr, arraySection, data,
+                                    blockShape, section)) {
+        // Reference the block and take the section from it.
+        // The trailing (degenerate) axes of the block are removed.
+        Array<T> block (blockShape,
+                        static_cast<T*>(const_cast<void*>(data)), SHARE);
+        uInt ndim = (arraySection == 0  ?  baseColPtr_p->ndim(rownr) :
+                                           arraySection->ndim());
+        view.array_p.reference (block(section).nonDegenerate (ndim, False));
+        view.isView_p = True;
+        return True;
+    }
+    if (arraySection == 0) {
+        view.array_p.reference (get (rownr));
+    } else {
+        view.array_p.reference (getSlice (rownr, *arraySection));
+    }
+    view.isView_p = False;
+    return False;
+}
+
 template<class T>
 Array<T> ArrayColumn<T>::getSlice
 (rownr_t rownr, const Vector<Vector<Slice> >& arraySlices) const
@@ -229,6 +272,21 @@ void ArrayColumn<T>::getColumn (Array<T>& arr, Bool resize) const
     acbGetColumn (arr, resize);
 }
 
+template<class T>
+Bool ArrayColumn<T>::getColumnView (Array<T>& view) const
+{
+    const void* data;
+    IPosition shape;
+    if (baseColPtr_p->getColumnView (data, shape)) {
+        view.reference (Array<T> (shape,
+                                  static_cast<T*>(const_cast<void*>(data)),
+                                  SHARE));
+        return True;
+    }
+    view.reference (getColumn());
+    return False;
+}
+
 
 template<class T>
 Array<T> ArrayColumn<T>::getColumn (const Slicer& arraySection) const
@@ -293,6 +351,22 @@ void ArrayColumn<T>::getColumnCells (const RefRows& rownrs,
     acbGetColumnCells (rownrs, arr, resize);
 }
 
+template<class T>
+void ArrayColumn<T>::getColumnRangeParallel (const Slicer& rowRange,
+                                             Array<T>& arr, Bool resize,
+                                             uInt nthreads) const
+{
+    acbGetColumnRangeParallel (rowRange, arr, resize, nthreads);
+}
+
+template<class T>
+void ArrayColumn<T>::getColumnCellsParallel (const RefRows& rownrs,
+                                             Array<T>& arr, Bool resize,
+                                             uInt nthreads) const
+{
+    acbGetColumnCellsParallel (rownrs, arr, resize, nthreads);
+}
+
 
 template<class T>
 Array<T> ArrayColumn<T>::getColumnRange (const Slicer& rowRange,
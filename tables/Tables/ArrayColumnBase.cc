@@ -237,6 +237,34 @@ void ArrayColumnBase::acbGetColumnCells (const RefRows& rownrs,
   baseColPtr_p->getArrayColumnCells (rownrs, arr);
 }
 
+void ArrayColumnBase::acbGetColumnRangeParallel (const Slicer& rowRange,
+                                                 ArrayBase& arr, Bool resize,
+                                                 uInt nthreads) const
+{
+  rownr_t nrrow = nrow();
+  IPosition shp, blc, trc, inc;
+  shp = rowRange.inferShapeFromSource (IPosition(1,nrrow), blc, trc, inc);
+  acbGetColumnCellsParallel (RefRows(blc(0), trc(0), inc(0)), arr, resize,
+                             nthreads);
+}
+
+void ArrayColumnBase::acbGetColumnCellsParallel (const RefRows& rownrs,
+                                                 ArrayBase& arr, Bool resize,
+                                                 uInt nthreads) const
+{
+  rownr_t nrrow = rownrs.nrow();
+  //# Take shape of array in first row.
+  IPosition arrshp;
+  if (nrrow > 0) {
+    arrshp = shape(rownrs.firstRow());
+  }
+  //# Total shape is array shape plus nr of table rows.
+  arrshp.append (IPosition(1,nrrow));
+  // Check array conformance and resize if needed and possible.
+  adaptShape (arrshp, arr, resize, -1, "ArrayColumn::getColumnCellsParallel");
+  baseColPtr_p->getArrayColumnCellsParallel (rownrs, arr, nthreads);
+}
+
 void ArrayColumnBase::acbGetColumnRange (const Slicer& rowRange,
                                          const Slicer& arraySection,
                                          ArrayBase& arr, Bool resize) const
@@ -216,6 +216,10 @@ class String;
                             Bool resize) const;
     void acbGetColumnCells (const RefRows& rownrs, ArrayBase& arr,
                             Bool resize) const;
+    void acbGetColumnRangeParallel (const Slicer& rowRange, ArrayBase& arr,
+                                    Bool resize, uInt nthreads) const;
+    void acbGetColumnCellsParallel (const RefRows& rownrs, ArrayBase& arr,
+                                    Bool resize, uInt nthreads) const;
 
     // Get slices from some arrays in a column.
     // The first Slicer object can be used to specify start, end (or length),
@@ -93,6 +93,14 @@ Bool BaseColumn::canChangeShape() const
     return False;                      // can not be changed
 }
 
+uInt64 BaseColumn::nbytesRead() const
+{
+    return 0;
+}
+
+void BaseColumn::setCountRead (Bool)
+{}
+
 void BaseColumn::get (rownr_t, void*) const
 {
   throw (TableInvOper ("get() not implemented for column " +
@@ -111,6 +119,17 @@ void BaseColumn::getSlice (rownr_t, const Slicer&, ArrayBase&) const
                        colDescPtr_p->name() + "; only valid for an array"));
 }
 
+Bool BaseColumn::getArrayView (rownr_t, const Slicer*, const void*&,
+                               IPosition&, Slicer&) const
+{
+  return False;
+}
+
+Bool BaseColumn::getColumnView (const void*&, IPosition&) const
+{
+  return False;
+}
+
 void BaseColumn::getScalarColumn (ArrayBase&) const
 {
   throw (TableInvOper ("getScalarColumn() not implemented for column " +
@@ -135,6 +154,13 @@ void BaseColumn::getArrayColumnCells (const RefRows&, ArrayBase&) const
                        colDescPtr_p->name() + "; only valid for an array"));
 }
 
+void BaseColumn::getArrayColumnCellsParallel (const RefRows& rownrs,
+                                              ArrayBase& dataPtr,
+                                              uInt) const
+{
+  getArrayColumnCells (rownrs, dataPtr);
+}
+
 void BaseColumn::getColumnSliceCells (const RefRows&,
 				      const Slicer&, ArrayBase&) const
 {
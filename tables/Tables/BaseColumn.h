@@ -162,6 +162,20 @@ public:
     // Get a slice of an N-dimensional array in a particular cell.
     virtual void getSlice (rownr_t rownr, const Slicer&, ArrayBase& dataPtr) const;
 
+    // Get a read-only view of an array (or a slice of it) in a particular
+    // cell without copying the data (see DataManagerColumn::getArrayViewV).
+    // It returns False if that is not possible.
+    // The default implementation returns False.
+    virtual Bool getArrayView (rownr_t rownr, const Slicer* slicer,
+                               const void*& data, IPosition& blockShape,
+                               Slicer& section) const;
+
+    // Get a read-only view of the values in the entire column without
+    // copying the data (see DataManagerColumn::getColumnViewV).
+    // It returns False if that is not possible.
+    // The default implementation returns False.
+    virtual Bool getColumnView (const void*& data, IPosition& shape) const;
+
     // Get the vector of all scalar values in a column.
     virtual void getScalarColumn (ArrayBase& dataPtr) const;
 
@@ -185,6 +199,13 @@ public:
     virtual void getArrayColumnCells (const RefRows& rownrs,
 				      ArrayBase& dataPtr) const;
 
+    // Get the array of some array values in a column using multiple
+    // threads (if the underlying data manager supports it).
+    // The default implementation calls getArrayColumnCells.
+    virtual void getArrayColumnCellsParallel (const RefRows& rownrs,
+                                              ArrayBase& dataPtr,
+                                              uInt nthreads) const;
+
     // Get subsections from some arrays in the column.
     // If the column contains n-dim arrays, the resulting array is (n+1)-dim.
     // The arrays in the column have to have the same shape in all cells.
@@ -279,6 +300,14 @@ public:
     // Set the maximum cache size (in bytes) to be used by a storage manager.
     virtual void setMaximumCacheSize (uInt nbytes) = 0;
 
+    // Get the number of bytes read so far from the data manager(s) of
+    // the column. By default 0 is returned.
+    virtual uInt64 nbytesRead() const;
+
+    // Switch the counting of the bytes read on or off.
+    // By default it does nothing.
+    virtual void setCountRead (Bool countRead);
+
     // Add this column and its data to the Sort object.
     // It may allocate some storage on the heap, which will be saved
     // in the argument dataSave.
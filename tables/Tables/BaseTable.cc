@@ -23,8 +23,12 @@
 //#                        520 Edgemont Road
 //#                        Charlottesville, VA 22903-2475 USA
 
+#include <algorithm>
+#include <exception>
+#include <iterator>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include <casacore/casa/aips.h>
 #include <casacore/tables/Tables/BaseTable.h>
@@ -32,14 +36,18 @@
 #include <casacore/tables/Tables/PlainTable.h>
 #include <casacore/tables/Tables/RefTable.h>
 #include <casacore/tables/Tables/TableCopy.h>
+#include <casacore/tables/Tables/PersistentColumnIndex.h>
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/BaseColumn.h>
 #include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/tables/TaQL/ExprNodeUtil.h>
+#include <casacore/tables/TaQL/ExprDerNode.h>
+#include <casacore/tables/TaQL/ExprRange.h>
 #include <casacore/tables/Tables/BaseTabIter.h>
 #include <casacore/tables/DataMan/DataManager.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Slice.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/BasicSL/STLMath.h>
@@ -54,6 +62,8 @@
 #include <casacore/casa/OS/File.h>
 #include <casacore/casa/OS/RegularFile.h>
 #include <casacore/casa/OS/Directory.h>
+#include <casacore/casa/OS/OMP.h>
+#include <casacore/casa/Utilities/Copy.h>
 #include <casacore/casa/Utilities/Assert.h>
 
 
@@ -595,6 +605,14 @@ void BaseTable::addRow (rownr_t, Bool)
 void BaseTable::removeRow (rownr_t)
     { throw (TableInvOper ("Table: cannot remove a row from table " + name_p)); }
 
+//# By default a table has no persistent column indices.
+std::shared_ptr<PersistentColumnIndex> BaseTable::columnIndex (const String&)
+    { return std::shared_ptr<PersistentColumnIndex>(); }
+
+Bool BaseTable::columnZoneMap (const String&, Vector<rownr_t>&,
+                               Vector<Double>&, Vector<Double>&)
+    { return False; }
+
 void BaseTable::removeRow (const Vector<rownr_t>& rownrs)
 {
     //# Copy the rownrs and sort them.
@@ -762,15 +780,139 @@ std::shared_ptr<BaseTable> BaseTable::select (rownr_t maxRow, rownr_t offset)
     return select(rownrs);
 }
 
+// Evaluate a select expression for the given rows using multiple threads.
+// Each thread evaluates a chunk of rows.
+static void evalParallel (const TableExprNode& node,
+                          const std::vector<TableExprNodeColumn*>& colNodes,
+                          rownr_t startRow, rownr_t nrow,
+                          rownr_t chunkSize, uInt nthreads,
+                          Vector<Bool>& values)
+{
+    // Read the column values sequentially, because a data manager can
+    // usually not be accessed by multiple threads.
+    for (auto colNode : colNodes) {
+      colNode->prefetch (startRow, nrow);
+    }
+    values.resize (nrow);
+    Bool* valPtr = values.data();
+    Int64 nchunk = (nrow + chunkSize - 1) / chunkSize;
+    // An exception cannot leave a parallel loop, so rethrow it thereafter.
+    std::exception_ptr excp;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+#else
+    (void)nthreads;
+#endif
+    for (Int64 i=0; i<nchunk; ++i) {
+      try {
+        rownr_t st = i*chunkSize;
+        Vector<rownr_t> rownrs (std::min (chunkSize, nrow-st));
+        indgen (rownrs, startRow+st);
+        Vector<Bool> vals;
+        node.getRep()->getBoolBatch (rownrs, vals);
+        objcopy (valPtr+st, vals.data(), vals.size());
+      } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical(BaseTable_evalParallel)
+#endif
+        {
+          if (!excp) {
+            excp = std::current_exception();
+          }
+        }
+      }
+    }
+    if (excp) {
+      std::rethrow_exception (excp);
+    }
+}
+
+// Use the zone map of a column to find the rows in the zones overlapping
+// the value range. It is only used if many rows can be skipped.
+Bool BaseTable::getZoneRows (const String& columnName,
+                             const TableExprRange& range,
+                             Vector<rownr_t>& rownrs)
+{
+    Vector<rownr_t> zoneStarts;
+    Vector<Double> minValues, maxValues;
+    if (! columnZoneMap (columnName, zoneStarts, minValues, maxValues)) {
+      return False;
+    }
+    // Take the rows of the zones overlapping one of the intervals.
+    const Vector<Double>& st  = range.start();
+    const Vector<Double>& end = range.end();
+    std::vector<rownr_t> rows;
+    uInt nzone = zoneStarts.size();
+    for (uInt i=0; i<nzone; ++i) {
+      for (uInt j=0; j<st.size(); ++j) {
+        if (minValues[i] <= end[j]  &&  maxValues[i] >= st[j]) {
+          rownr_t endRow = (i+1 < nzone  ?  zoneStarts[i+1] : nrow());
+          for (rownr_t row=zoneStarts[i]; row<endRow; ++row) {
+            rows.push_back (row);
+          }
+          break;
+        }
+      }
+    }
+    // It is only worthwhile if many rows can be skipped, because
+    // the selection on candidate rows is done by a single thread.
+    if (rows.size() > nrow() / 2) {
+      return False;
+    }
+    rownrs.reference (Vector<rownr_t>(rows));
+    return True;
+}
+
+// Use the persistent indices (or else the zone maps) of columns in the
+// table to find the rows possibly matching a select expression.
+// The expression gives the value ranges of the columns it compares with
+// a constant. The rows found for the indexed columns are intersected.
+// The result is a superset of the matching rows, because the ranges of
+// an expression are a superset. It returns False if no index can be used.
+Bool BaseTable::getIndexedRows (const TableExprNode& node,
+                                Vector<rownr_t>& rownrs)
+{
+    Block<TableExprRange> ranges;
+    node.getRep()->ranges (ranges);
+    Bool found = False;
+    for (const TableExprRange& range : ranges) {
+      const TableColumn& col = range.getColumn();
+      if (col.table().baseTablePtr() != this) {
+        continue;
+      }
+      const String& name = col.columnDesc().name();
+      Vector<rownr_t> rows;
+      std::shared_ptr<PersistentColumnIndex> index = columnIndex (name);
+      if (index) {
+        rows.reference (index->getRowNumbers (range.start(), range.end()));
+      } else if (! getZoneRows (name, range, rows)) {
+        continue;
+      }
+      if (found) {
+        std::vector<rownr_t> both;
+        std::set_intersection (rownrs.begin(), rownrs.end(),
+                               rows.begin(), rows.end(),
+                               std::back_inserter(both));
+        rownrs.reference (Vector<rownr_t>(both));
+      } else {
+        rownrs.reference (rows);
+        found = True;
+      }
+    }
+    return found;
+}
+
 // Do the row selection.
 std::shared_ptr<BaseTable> BaseTable::select (const TableExprNode& node,
-                                              rownr_t maxRow, rownr_t offset)
+                                              rownr_t maxRow, rownr_t offset,
+                                              uInt nthreads, rownr_t startRow)
 {
     // Check we don't deal with a null table.
     AlwaysAssert (!isNull(), AipsError);
     // If it is a null expression, return maxrows.
+    // Skipping the rows before startRow is the same as a larger offset.
     if (node.isNull()) {
-      return select (maxRow, offset);
+      return select (maxRow, offset + startRow);
     }
     //# First check if the node is a Bool.
     if (node.dataType() != TpBool  ||  !node.isScalar()) {
@@ -781,7 +923,7 @@ std::shared_ptr<BaseTable> BaseTable::select (const TableExprNode& node,
     if (node.getNodeRep()->isConstant()) {
         if (node.getBool(0)) {
             // Select maxRow rows.
-            return select (maxRow, offset);
+            return select (maxRow, offset + startRow);
         }
         // Select no rows.
         return select(Vector<rownr_t>());
@@ -798,30 +940,88 @@ std::shared_ptr<BaseTable> BaseTable::select (const TableExprNode& node,
                              " is used on a differently sized table " + name_p));
       }
     }
+    //# If persistent column indices can be used, only the candidate rows
+    //# found in them need to be evaluated (by a single thread).
+    Vector<rownr_t> candRows;
+    Bool useIndex = getIndexedRows (node, candRows);
+    if (useIndex  &&  startRow > 0) {
+      // The candidate rows are in ascending order.
+      const rownr_t* cand = candRows.data();
+      rownr_t nskip = std::lower_bound (cand, cand + candRows.size(),
+                                        startRow) - cand;
+      candRows.reference (candRows(Slice(nskip, candRows.size() - nskip)));
+    }
+    //# The expression can be evaluated by multiple threads if the
+    //# values of the columns used can be read in advance.
+    std::vector<TableExprNodeColumn*> colNodes;
+    if (nthreads == 0) {
+      nthreads = OMP::maxThreads();
+    }
+    if (useIndex  ||  (nthreads > 1  &&
+        !TableExprNodeUtil::getConcurrentColumns (node.getRep().get(),
+                                                  colNodes))) {
+      nthreads = 1;
+    }
     //# Create a reference table, which will be in row order.
     //# Loop through all rows and add to reference table if true.
+    //# The expression is evaluated in chunks of rows, so column values can
+    //# be read and operators be applied for many rows at once.
+    //# In parallel mode each thread evaluates a chunk.
     //# Add the rownr of the root table (one may search a reference table).
     //# Adjust the row numbers to reflect row numbers in the root table.
     std::shared_ptr<RefTable> resultTable = makeRefTable (True, 0);
     DebugAssert (static_cast<bool>(resultTable), AipsError);
-    Bool val;
-    rownr_t nrrow = nrow();
-    TableExprId id;
-    for (rownr_t i=0; i<nrrow; i++) {
-      id.setRownr (i);
-      node.get (id, val);
-      if (val) {
-        if (offset == 0) {
-          resultTable->addRownr (i);                  // add row
-          // Stop if max #rows reached (note that maxRow==0 means no limit).
-          if (resultTable->nrow() == maxRow) {
-            break;
-          }
+    const rownr_t chunkSize = 4096;
+    rownr_t nrrow = (useIndex  ?  candRows.size() : nrow());
+    Vector<rownr_t> rownrs;
+    Vector<Bool> vals;
+    Bool done = False;
+    rownr_t start = (useIndex  ?  0 : std::min (startRow, nrrow));
+    try {
+      while (start < nrrow  &&  !done) {
+        // Do not evaluate more rows than can be needed.
+        rownr_t nr = std::min (nthreads*chunkSize, nrrow-start);
+        if (maxRow > 0) {
+          nr = std::min (nr, maxRow - resultTable->nrow() + offset);
+        }
+        if (nthreads > 1) {
+          evalParallel (node, colNodes, start, nr, chunkSize, nthreads, vals);
+        } else if (useIndex) {
+          rownrs.reference (candRows(Slice(start, nr)));
+          node.getRep()->getBoolBatch (rownrs, vals);
         } else {
-          // Skip first offset matching rows.
-          offset--;
+          if (rownrs.size() != nr) {
+            rownrs.resize (nr);
+          }
+          indgen (rownrs, start);
+          node.getRep()->getBoolBatch (rownrs, vals);
+        }
+        const Bool* valPtr = vals.data();
+        for (rownr_t i=0; i<nr; i++) {
+          if (valPtr[i]) {
+            if (offset == 0) {
+              resultTable->addRownr (useIndex ? candRows[start+i] : start+i);
+              // Stop if max #rows reached (note that maxRow==0 means no limit).
+              if (resultTable->nrow() == maxRow) {
+                done = True;
+                break;
+              }
+            } else {
+              // Skip first offset matching rows.
+              offset--;
+            }
+          }
         }
+        start += nr;
       }
+    } catch (...) {
+      for (auto colNode : colNodes) {
+        colNode->clearPrefetch();
+      }
+      throw;
+    }
+    for (auto colNode : colNodes) {
+      colNode->clearPrefetch();
     }
     adjustRownrs (resultTable->nrow(), resultTable->rowStorage(), False);
     return resultTable;
@@ -55,6 +55,8 @@ class Record;
 class TableExprNode;
 class BaseTableIterator;
 class DataManager;
+class PersistentColumnIndex;
+class TableExprRange;
 class IPosition;
 template<class T> class Block;
 template<class T> class PtrBlock;
@@ -351,11 +353,32 @@ public:
     virtual DataManager* findDataManager (const String& name,
                                           Bool byColumn) const = 0;
 
+    // Get the persistent index of the given column (see
+    // <linkto class=PersistentColumnIndex>PersistentColumnIndex</linkto>).
+    // A null pointer is returned if the column has no usable index.
+    // The default implementation returns a null pointer, because
+    // only a PlainTable can have persistent indices.
+    virtual std::shared_ptr<PersistentColumnIndex> columnIndex
+                                           (const String& columnName);
+
+    // Get the zone map of the given column, i.e., the minimum and maximum
+    // value in each zone (range of rows) of the column as kept by the
+    // data manager (see <src>DataManagerColumn::getZoneMap</src>).
+    // It returns False if no zone map is available, which is the default.
+    virtual Bool columnZoneMap (const String& columnName,
+                                Vector<rownr_t>& zoneStarts,
+                                Vector<Double>& minValues,
+                                Vector<Double>& maxValues);
+
     // Select rows using the given expression (which can be null).
     // Skip first <src>offset</src> matching rows.
     // Return at most <src>maxRow</src> matching rows.
+    // If possible, the expression is evaluated by <src>nthreads</src>
+    // threads (0 means all available threads).
+    // Only the rows from <src>startRow</src> on are evaluated.
     std::shared_ptr<BaseTable> select (const TableExprNode&,
-                                       rownr_t maxRow, rownr_t offset);
+                                       rownr_t maxRow, rownr_t offset,
+                                       uInt nthreads=1, rownr_t startRow=0);
 
     // Select maxRow rows and skip first offset rows. maxRow=0 means all.
     std::shared_ptr<BaseTable> select (rownr_t maxRow, rownr_t offset);
@@ -576,6 +599,16 @@ private:
     // used in the logical operation on the table.
     Vector<rownr_t> logicRows();
 
+    // Use the persistent column indices or zone maps to find the candidate
+    // rows of a select expression. It returns False if none could be used.
+    Bool getIndexedRows (const TableExprNode& node, Vector<rownr_t>& rownrs);
+
+    // Use the zone map of a column to find the rows in the zones that can
+    // contain values in the given range. It returns False if the column
+    // has no zone map or if too few rows could be skipped.
+    Bool getZoneRows (const String& columnName, const TableExprRange& range,
+                      Vector<rownr_t>& rownrs);
+
     // Make an empty table description.
     // This is used if one asks for the description of a NullTable.
     // Creating an empty TableDesc in the NullTable takes too much time.
@@ -297,6 +297,10 @@ void ColumnSet::removeRow (rownr_t rownr)
     for (uInt i=0; i<blockDataMan_p.nelements(); i++) {
 	BLOCKDATAMANVAL(i)->removeRow64 (rownr);
     }
+    //# The rows after the removed one shift, so persistent indices change.
+    for (auto& x : colMap_p) {
+	COLMAPCAST(x.second)->setIndexChanged (rownr);
+    }
     nrrow_p--;
 }
 
@@ -920,6 +924,16 @@ DataManager* ColumnSet::getDataManager (uInt seqnr) const
     return 0;
 }
 
+uInt ColumnSet::dataManagerIndex (const DataManager* dataManager) const
+{
+    for (uInt i=0; i<blockDataMan_p.nelements(); i++) {
+	if (BLOCKDATAMANVAL(i) == dataManager) {
+	    return i;
+	}
+    }
+    throw (TableInternalError ("ColumnSet::dataManagerIndex"));
+}
+
 
 Bool ColumnSet::userLock (FileLocker::LockType type, Bool wait)
 {
@@ -253,6 +253,10 @@ public:
     // correct datamanagers when they are read back.
     DataManager* getDataManager (uInt seqnr) const;
 
+    // Get the index of a data manager in the list of data managers,
+    // which is also the index in the <src>dataManChanged</src> block.
+    uInt dataManagerIndex (const DataManager* dataManager) const;
+
     // Check if no double data manager names have been given.
     void checkDataManagerNames (const String& tableName) const;
 
@@ -172,6 +172,17 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     refColPtr_p[tableNr]->getSlice (tabRownr, ns, arr);
   }
 
+  Bool ConcatColumn::getArrayView (rownr_t rownr, const Slicer* slicer,
+                                   const void*& data, IPosition& blockShape,
+                                   Slicer& section) const
+  {
+    uInt tableNr;
+    rownr_t tabRownr;
+    refTabPtr_p->rows().mapRownr (tableNr, tabRownr, rownr);
+    return refColPtr_p[tableNr]->getArrayView (tabRownr, slicer, data,
+                                               blockShape, section);
+  }
+
   void ConcatColumn::put (rownr_t rownr, const void* dataPtr)
   {
     uInt tableNr;
@@ -206,6 +217,22 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     }
   }
 
+  uInt64 ConcatColumn::nbytesRead() const
+  {
+    uInt64 nbytes = 0;
+    for (uInt i=0; i<refColPtr_p.nelements(); ++i) {
+      nbytes += refColPtr_p[i]->nbytesRead();
+    }
+    return nbytes;
+  }
+
+  void ConcatColumn::setCountRead (Bool countRead)
+  {
+    for (uInt i=0; i<refColPtr_p.nelements(); ++i) {
+      refColPtr_p[i]->setCountRead (countRead);
+    }
+  }
+
   void ConcatColumn::allocIterBuf (void*& lastVal, void*& curVal,
                                    std::shared_ptr<BaseCompare>& cmpObj)
     { refColPtr_p[0]->allocIterBuf (lastVal, curVal, cmpObj); }
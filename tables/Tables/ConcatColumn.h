@@ -150,6 +150,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Get a slice of an N-dimensional array in a particular cell.
     virtual void getSlice (rownr_t rownr, const Slicer&, ArrayBase& dataPtr) const;
 
+    // Get a read-only view of an array (or a slice of it) in a particular
+    // cell without copying the data, if the underlying column supports it.
+    virtual Bool getArrayView (rownr_t rownr, const Slicer* slicer,
+                               const void*& data, IPosition& blockShape,
+                               Slicer& section) const;
+
     // Get the array of all array values in a column.
     // If the column contains n-dim arrays, the resulting array is (n+1)-dim.
     // The arrays in the column have to have the same shape in all cells.
@@ -212,6 +218,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Set the maximum cache size (in bytes) to be used by a storage manager.
     virtual void setMaximumCacheSize (uInt nbytes);
 
+    // Get the number of bytes read from the data manager(s) of the
+    // referenced columns.
+    virtual uInt64 nbytesRead() const;
+
+    // Switch the counting of the bytes read on or off for the
+    // referenced columns.
+    virtual void setCountRead (Bool countRead);
+
     // Allocate value buffers for the table iterator.
     // Also get a comparison function if undefined.
     // The function freeIterBuf must be called to free the buffers.
@@ -50,12 +50,15 @@ MemoryTable::MemoryTable (SetupNewTable& newtab, rownr_t nrrow, Bool initialize)
 	   ("SetupNewTable object already used for another Table"));
   }
   //# Use MemoryStMan for stored and unbound columns.
+  //# Keep columns already bound to a MemoryStMan (e.g. in arena mode).
   std::shared_ptr<TableDesc> tdescPtr  = newtab.tableDescPtr();
   std::shared_ptr<ColumnSet> colSetPtr = newtab.columnSetPtr();
   MemoryStMan stman(colSetPtr->uniqueDataManagerName("MSMTAB"));
   for (uInt i=0; i<tdescPtr->ncolumn(); i++) {
     PlainColumn* col = colSetPtr->getColumn(i);
-    if (!col->isBound()  ||  col->isStored()) {
+    if (!col->isBound()  ||
+        (col->isStored()  &&
+         col->dataManager()->dataManagerType() != "MemoryStMan")) {
       newtab.bindColumn (tdescPtr->columnDesc(i).name(), stman);
     }
   }
@@ -271,7 +274,8 @@ void MemoryTable::addColumn (const ColumnDesc& columnDesc,
 {
   Table tab(this);   // a temporary Table object
   // Make sure the MemoryStMan is used if no virtual engine is used.
-  if (dataManager.isStorageManager()) {
+  if (dataManager.isStorageManager()  &&
+      dataManager.dataManagerType() != "MemoryStMan") {
     addColumn (columnDesc, False);
   } else {
     colSetPtr_p->addColumn (columnDesc, dataManager, False,
@@ -283,7 +287,8 @@ void MemoryTable::addColumn (const TableDesc& tableDesc,
 {
   Table tab(this);
   // Make sure the MemoryStMan is used if no virtual engine is used.
-  if (dataManager.isStorageManager()) {
+  if (dataManager.isStorageManager()  &&
+      dataManager.dataManagerType() != "MemoryStMan") {
     MemoryStMan stman(dataManager.dataManagerName());
     colSetPtr_p->addColumn (tableDesc, stman, False,
                             TSMOption(TSMOption::Cache,0,0), tab);
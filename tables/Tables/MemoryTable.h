@@ -65,10 +65,12 @@ class TableLockData;
 // be used.
 //
 // The constructor accepts a SetupNewTable object which can contain
-// bindings of columns to any data manager. All bindings to storage
+// bindings of columns to any data manager. All bindings to other storage
 // managers will be replaced by a binding to the memory based storage
 // manager <linkto class=MemoryStMan>MemoryStMan</linkto>. Also all
 // unbound columns will be bound to MemoryStMan.
+// Bindings to a MemoryStMan are kept, so columns can be bound to a
+// MemoryStMan in arena mode to hold them in a single block of memory.
 // Thus it is still possible that a column is bound to a virtual column
 // engine like <linkto class=CompressComplex>CompressComplex</linkto>.
 // </synopsis> 
@@ -194,7 +196,8 @@ public:
   virtual void removeRow (rownr_t rownr);
 
   // Add a column to the table.
-  // If the DataManager is not a virtual engine, MemoryStMan will be used.
+  // If the DataManager is not a virtual engine, MemoryStMan will be used
+  // (as is if the given data manager is a MemoryStMan).
   // The last Bool argument is not used in MemoryTable, but can be used in
   // other classes derived from BaseTable.
   // <group>
@@ -0,0 +1,363 @@
+//# PersistentColumnIndex.cc: Persistent index on a scalar column in a table
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables/PersistentColumnIndex.h>
+#include <casacore/tables/Tables/PlainTable.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/ColumnDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Utilities/Regex.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/IO/AipsIO.h>
+#include <casacore/casa/IO/MMapIO.h>
+#include <casacore/casa/IO/RegularFileIO.h>
+#include <casacore/casa/OS/CanonicalConversion.h>
+#include <casacore/casa/OS/Directory.h>
+#include <casacore/casa/OS/DirectoryIterator.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# The prefix of the index file names.
+static const String theIndexPrefix ("table.idx_");
+
+//# Read the values of the given rows in a column and add the non-NaN ones
+//# to the entries. The column is read in chunks to limit memory usage.
+template<typename T>
+static void readIndexValues (const Table& table, const String& columnName,
+                             rownr_t startRow, rownr_t endRow,
+                             std::vector<std::pair<Double,rownr_t>>& entries)
+{
+    const rownr_t chunkSize = 1048576;
+    ScalarColumn<T> col (table, columnName);
+    for (rownr_t st=startRow; st<endRow; st+=chunkSize) {
+        rownr_t nr = std::min (chunkSize, endRow-st);
+        Vector<T> vals = col.getColumnRange (Slicer(IPosition(1,st),
+                                                    IPosition(1,nr)));
+        for (rownr_t i=0; i<nr; ++i) {
+            Double val = vals[i];
+            if (! isNaN(val)) {
+                entries.emplace_back (val, st+i);
+            }
+        }
+    }
+}
+
+
+void PersistentColumnIndex::create (Table& table, const String& columnName)
+{
+    PlainTable* ptab = dynamic_cast<PlainTable*>(table.baseTablePtr());
+    if (ptab == 0) {
+        throw TableError ("PersistentColumnIndex can only be created for "
+                          "column " + columnName + " in a plain table");
+    }
+    ptab->createColumnIndex (columnName);
+}
+
+void PersistentColumnIndex::remove (Table& table, const String& columnName)
+{
+    PlainTable* ptab = dynamic_cast<PlainTable*>(table.baseTablePtr());
+    if (ptab) {
+        ptab->removeColumnIndex (columnName);
+    }
+}
+
+Vector<String> PersistentColumnIndex::indexedColumns (const String& tableName)
+{
+    std::vector<String> names;
+    Directory dir(tableName);
+    if (dir.exists()) {
+        DirectoryIterator iter(dir, Regex(Regex::fromString(theIndexPrefix)
+                                          + ".+"));
+        for (; !iter.pastEnd(); iter++) {
+            names.push_back (iter.name().after (theIndexPrefix));
+        }
+    }
+    std::sort (names.begin(), names.end());
+    return Vector<String>(names);
+}
+
+String PersistentColumnIndex::fileName (const String& tableName,
+                                        const String& columnName)
+{
+    return tableName + '/' + theIndexPrefix + columnName;
+}
+
+void PersistentColumnIndex::build (const Table& table,
+                                   const String& columnName, rownr_t startRow,
+                                   uInt changeCounter)
+{
+    const ColumnDesc& cdesc = table.tableDesc().columnDesc (columnName);
+    if (! cdesc.isScalar()) {
+        throw TableError ("PersistentColumnIndex: column " + columnName +
+                          " is not a scalar column");
+    }
+    String name = fileName (table.tableName(), columnName);
+    rownr_t nrow = table.nrow();
+    // Keep the entries of the unchanged rows in the old index (if any).
+    // Note they are in sorted order.
+    std::vector<std::pair<Double,rownr_t>> oldEntries;
+    if (startRow > 0  &&  File(name).exists()) {
+        PersistentColumnIndex old (table.tableName(), columnName);
+        // If rows were removed without knowing where, rebuild fully.
+        startRow = std::min (startRow, old.nrow());
+        if (startRow > nrow) {
+            startRow = 0;
+        }
+        if (startRow > 0) {
+            oldEntries.reserve (old.nvalues());
+            for (rownr_t i=0; i<old.nvalues(); ++i) {
+                rownr_t row = old.getRow(i);
+                if (row < startRow) {
+                    oldEntries.emplace_back (old.getValue(i), row);
+                }
+            }
+        }
+    } else {
+        startRow = 0;
+    }
+    // Read the values of the other rows and sort them.
+    std::vector<std::pair<Double,rownr_t>> newEntries;
+    switch (cdesc.dataType()) {
+    case TpBool:
+        readIndexValues<Bool>   (table, columnName, startRow, nrow, newEntries);
+        break;
+    case TpUChar:
+        readIndexValues<uChar>  (table, columnName, startRow, nrow, newEntries);
+        break;
+    case TpShort:
+        readIndexValues<Short>  (table, columnName, startRow, nrow, newEntries);
+        break;
+    case TpUShort:
+        readIndexValues<uShort> (table, columnName, startRow, nrow, newEntries);
+        break;
+    case TpInt:
+        readIndexValues<Int>    (table, columnName, startRow, nrow, newEntries);
+        break;
+    case TpUInt:
+        readIndexValues<uInt>   (table, columnName, startRow, nrow, newEntries);
+        break;
+    case TpInt64:
+        // Not all Int64 values can be represented exactly as a Double.
+        throw TableError ("PersistentColumnIndex: Int64 column " + columnName +
+                          " cannot be indexed");
+    case TpFloat:
+        readIndexValues<Float>  (table, columnName, startRow, nrow, newEntries);
+        break;
+    case TpDouble:
+        readIndexValues<Double> (table, columnName, startRow, nrow, newEntries);
+        break;
+    default:
+        throw TableError ("PersistentColumnIndex: column " + columnName +
+                          " does not have a numeric data type");
+    }
+    std::sort (newEntries.begin(), newEntries.end());
+    std::vector<std::pair<Double,rownr_t>> entries;
+    if (oldEntries.empty()) {
+        entries.swap (newEntries);
+    } else {
+        entries.resize (oldEntries.size() + newEntries.size());
+        std::merge (oldEntries.begin(), oldEntries.end(),
+                    newEntries.begin(), newEntries.end(), entries.begin());
+    }
+    // Write the index into a temporary file and rename it thereafter.
+    // In this way a mapped old index file remains valid.
+    // The values and rownrs are written in chunks, because AipsIO uses
+    // a uInt for the number of values.
+    String tmpName = table.tableName() + "/table.tmpidx_" + columnName;
+    {
+        rownr_t nval = entries.size();
+        AipsIO ios (tmpName, ByteIO::New);
+        ios.putstart ("PersistentColumnIndex", 2);
+        ios << columnName << nrow << nval << changeCounter;
+        const size_t chunkSize = 1048576;
+        std::vector<Double> values;
+        for (size_t st=0; st<nval; st+=chunkSize) {
+            size_t nr = std::min (chunkSize, size_t(nval-st));
+            values.resize (nr);
+            for (size_t i=0; i<nr; ++i) {
+                values[i] = entries[st+i].first;
+            }
+            ios.put (nr, values.data(), False);
+        }
+        std::vector<uInt64> rownrs;
+        for (size_t st=0; st<nval; st+=chunkSize) {
+            size_t nr = std::min (chunkSize, size_t(nval-st));
+            rownrs.resize (nr);
+            for (size_t i=0; i<nr; ++i) {
+                rownrs[i] = entries[st+i].second;
+            }
+            ios.put (nr, rownrs.data(), False);
+        }
+        ios.putend();
+    }
+    RegularFile(tmpName).move (name);
+}
+
+void PersistentColumnIndex::setChangeCounter (const String& tableName,
+                                              const String& columnName,
+                                              uInt changeCounter)
+{
+    // The counter is the last item in the header, so it can be replaced
+    // without rewriting the index.
+    String name = fileName (tableName, columnName);
+    Int64 offset;
+    {
+        AipsIO ios (name);
+        if (ios.getstart ("PersistentColumnIndex") < 2) {
+            throw TableError ("PersistentColumnIndex: index " + name +
+                              " has no change counter");
+        }
+        String colName;
+        rownr_t nrow, nval;
+        ios >> colName >> nrow >> nval;
+        offset = ios.getpos();
+    }
+    char buf[SIZE_CAN_UINT];
+    CanonicalConversion::fromLocal (buf, changeCounter);
+    RegularFileIO file (RegularFile(name), ByteIO::Update);
+    file.seek (offset);
+    file.write (sizeof(buf), buf);
+}
+
+
+PersistentColumnIndex::PersistentColumnIndex (const String& tableName,
+                                              const String& columnName)
+: changeCounter_p (0),
+  values_p (0),
+  rownrs_p (0)
+{
+    String name = fileName (tableName, columnName);
+    Int64 offset;
+    {
+        AipsIO ios (name);
+        uInt version = ios.getstart ("PersistentColumnIndex");
+        ios >> colName_p >> nrow_p >> nval_p;
+        // An index without counter is treated as outdated.
+        changeCounter_p = std::numeric_limits<uInt>::max();
+        if (version > 1) {
+            ios >> changeCounter_p;
+        }
+        offset = ios.getpos();
+    }
+    if (nval_p > 0) {
+        file_p.reset (new MMapIO (RegularFile(name)));
+        values_p = static_cast<const char*>(file_p->getReadPointer (offset));
+        rownrs_p = values_p + nval_p * sizeof(Double);
+    }
+}
+
+PersistentColumnIndex::~PersistentColumnIndex()
+{}
+
+Double PersistentColumnIndex::getValue (rownr_t i) const
+{
+    Double val;
+    CanonicalConversion::toLocal (val, values_p + i*sizeof(Double));
+    return val;
+}
+
+rownr_t PersistentColumnIndex::getRow (rownr_t i) const
+{
+    uInt64 row;
+    CanonicalConversion::toLocal (row, rownrs_p + i*sizeof(uInt64));
+    return row;
+}
+
+rownr_t PersistentColumnIndex::lowerBound (Double val) const
+{
+    rownr_t st = 0;
+    rownr_t end = nval_p;
+    while (st < end) {
+        rownr_t mid = st + (end-st)/2;
+        if (getValue(mid) < val) {
+            st = mid+1;
+        } else {
+            end = mid;
+        }
+    }
+    return st;
+}
+
+rownr_t PersistentColumnIndex::upperBound (Double val) const
+{
+    rownr_t st = 0;
+    rownr_t end = nval_p;
+    while (st < end) {
+        rownr_t mid = st + (end-st)/2;
+        if (getValue(mid) <= val) {
+            st = mid+1;
+        } else {
+            end = mid;
+        }
+    }
+    return st;
+}
+
+void PersistentColumnIndex::addRows (std::vector<rownr_t>& rows,
+                                     rownr_t st, rownr_t end) const
+{
+    if (st < end) {
+        size_t nr = rows.size();
+        rows.resize (nr + end - st);
+        CanonicalConversion::toLocal (&(rows[nr]),
+                                      rownrs_p + st*sizeof(uInt64), end-st);
+    }
+}
+
+Vector<rownr_t> PersistentColumnIndex::getRowNumbers (Double start,
+                                                      Double end) const
+{
+    return getRowNumbers (Vector<Double>(1, start), Vector<Double>(1, end));
+}
+
+Vector<rownr_t> PersistentColumnIndex::getRowNumbers
+                                        (const Vector<Double>& start,
+                                         const Vector<Double>& end) const
+{
+    AlwaysAssert (start.size() == end.size(), AipsError);
+    std::vector<rownr_t> rows;
+    for (size_t i=0; i<start.size(); ++i) {
+        if (start[i] <= end[i]) {
+            addRows (rows, lowerBound(start[i]), upperBound(end[i]));
+        }
+    }
+    // Intervals can overlap, so remove duplicates.
+    std::sort (rows.begin(), rows.end());
+    rows.erase (std::unique (rows.begin(), rows.end()), rows.end());
+    return Vector<rownr_t>(rows);
+}
+
+
+} //# NAMESPACE CASACORE - END
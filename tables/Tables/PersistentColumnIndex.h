@@ -0,0 +1,203 @@
+//# PersistentColumnIndex.h: Persistent index on a scalar column in a table
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_PERSISTENTCOLUMNINDEX_H
+#define TABLES_PERSISTENTCOLUMNINDEX_H
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <memory>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class Table;
+class MMapIO;
+
+// <summary>
+// Persistent index on a scalar column in a table.
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tPersistentColumnIndex.cc" demos="">
+// </reviewed>
+
+// <prerequisite>
+//   <li> <linkto class=Table>Table</linkto>
+//   <li> <linkto class=ColumnsIndex>ColumnsIndex</linkto>
+// </prerequisite>
+
+// <synopsis>
+// Unlike <linkto class=ColumnsIndex>ColumnsIndex</linkto>, which is a
+// transient index held in memory, this class makes it possible to keep
+// an index of a scalar column in a file in the table directory
+// (named <src>table.idx_COLNAME</src>). In this way the index does not
+// need to be created each time a table is opened.
+// <br>Only numeric scalar columns (including Bool) are supported. The values
+// are held as Double, which is exact for all values of these types except
+// Int64, so Int64 columns cannot be indexed.
+// The index file contains the values in ascending order followed by the
+// row numbers in the same order. Rows containing a NaN value are not part
+// of the index. The file is memory-mapped when the index is used,
+// so a lookup only needs a binary search and only reads the part of the
+// file needed.
+// <p>
+// A persistent index can only be created for a column in a plain table.
+// The table keeps the index up-to-date. It registers which rows are
+// changed by a put or removed and it knows which rows have been added.
+// When the table is flushed or when the index is used, the index is
+// updated, which is done by merging the changed rows into the index.
+// <br>The index file also contains the change counter of the column's
+// data manager (kept in the table's lock file) at the time the index was
+// brought up-to-date. If it does not match the current counter, another
+// process (e.g. an older version of Casacore not knowing about the index)
+// has changed the data. In that case the index is fully rebuilt if the
+// table is writable, otherwise it is not used.
+// <p>
+// TaQL and <src>Table::operator()</src> use the index automatically.
+// When selecting rows, equality and range comparisons of an indexed column
+// with a constant (e.g. <src>ANTENNA1==3 AND TIME>x</src>) are used to look
+// up the candidate rows in the index. Only these rows are evaluated by the
+// full selection expression.
+// </synopsis>
+
+// <example>
+// <srcblock>
+// // Create the index once.
+// Table tab("my.ms", Table::Update);
+// PersistentColumnIndex::create (tab, "ANTENNA1");
+// // The index is used by the selection.
+// Table sel = tableCommand ("select from my.ms where ANTENNA1==3").table();
+// </srcblock>
+// </example>
+
+// <motivation>
+// Selections on a few values of a column in a large table should not
+// require reading the entire column.
+// </motivation>
+
+class PersistentColumnIndex
+{
+public:
+    // Create an index for the given scalar column and write it into the
+    // table directory. An existing index of the column is replaced.
+    // An exception is thrown if the table is not a plain table, is not
+    // writable, or if the column is not a numeric scalar column.
+    static void create (Table& table, const String& columnName);
+
+    // Remove the index of the given column (if existing).
+    static void remove (Table& table, const String& columnName);
+
+    // Get the names of the columns in the table having a persistent index.
+    static Vector<String> indexedColumns (const String& tableName);
+
+    // Get the name of the index file of a column.
+    static String fileName (const String& tableName,
+                            const String& columnName);
+
+    // Build the index from the data in the column and write it.
+    // The index is built incrementally if an index file exists. In that case
+    // only the rows from <src>startRow</src> on are reread (they may have
+    // been changed or removed); the rows before are taken from the old index.
+    // Use <src>startRow=0</src> to rebuild the index fully.
+    // The change counter is stored in the index file.
+    static void build (const Table& table, const String& columnName,
+                       rownr_t startRow, uInt changeCounter);
+
+    // Replace the change counter in an existing index file.
+    static void setChangeCounter (const String& tableName,
+                                  const String& columnName,
+                                  uInt changeCounter);
+
+    // Open the (existing) index of a column in the given table.
+    PersistentColumnIndex (const String& tableName, const String& columnName);
+
+    ~PersistentColumnIndex();
+
+    // Copy constructor and assignment cannot be used.
+    // <group>
+    PersistentColumnIndex (const PersistentColumnIndex&) = delete;
+    PersistentColumnIndex& operator= (const PersistentColumnIndex&) = delete;
+    // </group>
+
+    // Get the name of the column.
+    const String& columnName() const
+      { return colName_p; }
+
+    // Get the number of rows in the table when the index was written.
+    rownr_t nrow() const
+      { return nrow_p; }
+
+    // Get the number of values in the index (rows with NaN are excluded).
+    rownr_t nvalues() const
+      { return nval_p; }
+
+    // Get the change counter of the data manager when the index was written.
+    uInt changeCounter() const
+      { return changeCounter_p; }
+
+    // Get the row numbers (in ascending order) of the rows having a value
+    // in the given closed interval.
+    Vector<rownr_t> getRowNumbers (Double start, Double end) const;
+
+    // Get the row numbers (in ascending order) of the rows having a value
+    // in one of the given closed intervals.
+    Vector<rownr_t> getRowNumbers (const Vector<Double>& start,
+                                   const Vector<Double>& end) const;
+
+private:
+    // Get the i-th value or row number in the index.
+    // <group>
+    Double getValue (rownr_t i) const;
+    rownr_t getRow (rownr_t i) const;
+    // </group>
+
+    // Find the index of the first value >= val.
+    rownr_t lowerBound (Double val) const;
+
+    // Find the index of the first value > val.
+    rownr_t upperBound (Double val) const;
+
+    // Add the row numbers in the index interval [st,end) to the vector.
+    void addRows (std::vector<rownr_t>& rows, rownr_t st, rownr_t end) const;
+
+    //# Data members
+    String                  colName_p;
+    rownr_t                 nrow_p;
+    rownr_t                 nval_p;
+    uInt                    changeCounter_p;
+    std::unique_ptr<MMapIO> file_p;
+    const char*             values_p;
+    const char*             rownrs_p;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -33,6 +33,7 @@
 #include <casacore/casa/Arrays/ArrayIter.h>
 #include <casacore/casa/IO/AipsIO.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <limits>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -42,7 +43,11 @@ PlainColumn::PlainColumn (const BaseColumnDesc* cdp, ColumnSet* csp)
   dataManPtr_p  (0),
   dataColPtr_p  (0),
   colSetPtr_p   (csp),
-  originalName_p(cdp->name())
+  originalName_p(cdp->name()),
+  indexed_p     (False),
+  indexChangedRow_p (std::numeric_limits<rownr_t>::max()),
+  countRead_p   (False),
+  nbytesRead_p  (0)
 {
   int trace = TableTrace::traceColumn (columnDesc());
   rtraceColumn_p = (trace&TableTrace::READ)  != 0;
@@ -99,6 +104,24 @@ ColumnCache& PlainColumn::columnCache()
 void PlainColumn::setMaximumCacheSize (uInt nbytes)
     { dataManPtr_p->setMaximumCacheSize (nbytes); }
 
+uInt64 PlainColumn::nbytesRead() const
+    { return nbytesRead_p.load (std::memory_order_relaxed); }
+
+void PlainColumn::setCountRead (Bool countRead)
+    { countRead_p = countRead; }
+
+
+void PlainColumn::setIndexed (Bool indexed)
+{
+    indexed_p = indexed;
+    clearIndexChanged();
+}
+
+void PlainColumn::clearIndexChanged()
+{
+    indexChangedRow_p = std::numeric_limits<rownr_t>::max();
+}
+
 
 //# Read/write the column.
 //# Its data will be read/written by the appropriate storage manager.
@@ -33,6 +33,7 @@
 #include <casacore/tables/Tables/BaseColumn.h>
 #include <casacore/tables/Tables/ColumnSet.h>
 #include <casacore/tables/Tables/TableRecord.h>
+#include <atomic>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -129,19 +130,63 @@ public:
     // Set the maximum cache size (in bytes) to be used by a storage manager.
     virtual void setMaximumCacheSize (uInt nbytes);
 
+    // Get the number of bytes read so far from the data manager.
+    // It is the in-memory size of the values obtained, thus the size of
+    // a String object for strings. Values obtained directly from the
+    // column cache are not counted.
+    virtual uInt64 nbytesRead() const;
+
+    // Switch the counting of the bytes read on or off.
+    // By default the bytes are not counted.
+    virtual void setCountRead (Bool countRead);
+
     // Write the column.
     void putFile (AipsIO&, const TableAttr&);
 
     // Read the column.
     void getFile (AipsIO&, const ColumnSet&, const TableAttr&);
 
+    // Test if the column has a persistent index
+    // (see <linkto class=PersistentColumnIndex>PersistentColumnIndex</linkto>).
+    Bool isIndexed() const
+      { return indexed_p; }
+
+    // Set if the column has a persistent index.
+    // It clears the change information of the index.
+    void setIndexed (Bool indexed);
+
+    // Get the first row that might have been changed since the persistent
+    // index has been brought up-to-date. It is the highest possible row
+    // number if nothing changed.
+    rownr_t indexChangedRow() const
+      { return indexChangedRow_p; }
+
+    // Clear the change information of the persistent index.
+    void clearIndexChanged();
+
+    // Tell that the data in the rows from the given row on might have
+    // changed (e.g. because a row is removed).
+    // It is a no-op if the column does not have a persistent index.
+    void setIndexChanged (rownr_t rownr)
+      { if (indexed_p  &&  rownr < indexChangedRow_p) indexChangedRow_p = rownr; }
+
 protected:
+    // Count the number of bytes read from the data manager
+    // if counting is switched on.
+    void countRead (uInt64 nbytes) const
+      { if (countRead_p) nbytesRead_p.fetch_add (nbytes,
+                                                 std::memory_order_relaxed); }
+
     DataManager*        dataManPtr_p;    //# Pointer to data manager.
     DataManagerColumn*  dataColPtr_p;    //# Pointer to column in data manager.
     ColumnSet*          colSetPtr_p;
     String              originalName_p;  //# Column name before any rename
     Bool                rtraceColumn_p;  //# trace reads of the column?
     Bool                wtraceColumn_p;  //# trace writes of the column?
+    Bool                indexed_p;       //# has a persistent index?
+    rownr_t             indexChangedRow_p; //# first row changed for index
+    Bool                countRead_p;     //# count the bytes read?
+    mutable std::atomic<uInt64> nbytesRead_p; //# nr of bytes read
 
     // Get the trace-id of the table.
     int traceId() const
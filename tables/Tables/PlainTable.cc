@@ -34,12 +34,19 @@
 #include <casacore/tables/Tables/TableTrace.h>
 #include <casacore/tables/Tables/PlainColumn.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/Tables/PersistentColumnIndex.h>
+#include <casacore/tables/DataMan/DataManager.h>
+#include <casacore/tables/DataMan/DataManagerColumn.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/OS/HostInfo.h>
 #include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/RegularFile.h>
 #include <casacore/casa/System/AipsrcValue.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
 #include <time.h>    //# for nanosleep
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -266,6 +273,8 @@ PlainTable::PlainTable (AipsIO&, uInt version, const String& tabname,
                                     tsmOption_p);
     //# Read the TableInfo object.
     getTableInfo();
+    //# Find the columns having a persistent index.
+    initColumnIndices();
     //# Release the read lock if UserLocking is used.
     if (lockPtr_p->option() == TableLock::UserLocking) {
 	lockPtr_p->release();
@@ -541,6 +550,15 @@ void PlainTable::resync()
 Bool PlainTable::putFile (Bool always)
 {
     TableTrace::traceFile (itsTraceId, "flush");
+    // Keep the change counters of the persistent column indices,
+    // because they change when the data are written.
+    std::vector<std::pair<PlainColumn*,uInt>> indexCounters;
+    for (uInt i=0; i<tdescPtr_p->ncolumn(); ++i) {
+        PlainColumn* col = colSetPtr_p->getColumn(i);
+        if (col->isIndexed()) {
+            indexCounters.emplace_back (col, indexChangeCounter (col));
+        }
+    }
     Bool writeTab = always || tableChanged_p;
     Bool written = writeTab;
     {  // use scope to ensure AipsIO is closed (thus flushed) before lockfile
@@ -576,6 +594,12 @@ Bool PlainTable::putFile (Bool always)
     // Clear the change-flags for the next round.
     tableChanged_p = False;
     colSetPtr_p->dataManChanged() = False;
+    // Bring the persistent column indices up-to-date.
+    // A change counter incremented by this flush is not a change made
+    // by another process.
+    for (const auto& colCounter : indexCounters) {
+        updateColumnIndex (colCounter.first, colCounter.second);
+    }
     return writeTab;
 }
 
@@ -733,6 +757,9 @@ void PlainTable::addColumn (const TableDesc& tableDesc,
 void PlainTable::removeColumn (const Vector<String>& columnNames)
 {
     checkWritable("removeColumn");
+    for (const String& name : columnNames) {
+        removeColumnIndex (name);
+    }
     colSetPtr_p->removeColumn (columnNames);
     tableChanged_p = True;
 }
@@ -740,7 +767,16 @@ void PlainTable::removeColumn (const Vector<String>& columnNames)
 void PlainTable::renameColumn (const String& newName, const String& oldName)
 {
     checkWritable("renameColumn");
+    Bool indexed = colSetPtr_p->getColumn(oldName)->isIndexed();
     colSetPtr_p->renameColumn (newName, oldName);
+    if (indexed) {
+        // The index file might have been removed by another process.
+        RegularFile file(PersistentColumnIndex::fileName (tableName(),
+                                                          oldName));
+        if (file.exists()) {
+            file.move (PersistentColumnIndex::fileName (tableName(), newName));
+        }
+    }
     tableChanged_p = True;
 }
 
@@ -759,6 +795,115 @@ DataManager* PlainTable::findDataManager (const String& name,
 }
 
 
+void PlainTable::initColumnIndices()
+{
+    Vector<String> names = PersistentColumnIndex::indexedColumns (tableName());
+    for (const String& name : names) {
+        if (tdescPtr_p->isColumn (name)) {
+            colSetPtr_p->getColumn(name)->setIndexed (True);
+        }
+    }
+}
+
+void PlainTable::createColumnIndex (const String& columnName)
+{
+    checkWritable("createColumnIndex");
+    PlainColumn* col = colSetPtr_p->getColumn (columnName);
+    PersistentColumnIndex::build (Table(this), columnName, 0,
+                                  indexChangeCounter (col));
+    col->setIndexed (True);
+}
+
+void PlainTable::removeColumnIndex (const String& columnName)
+{
+    checkWritable("removeColumnIndex");
+    PlainColumn* col = colSetPtr_p->getColumn (columnName);
+    if (col->isIndexed()) {
+        RegularFile file(PersistentColumnIndex::fileName (tableName(),
+                                                          columnName));
+        if (file.exists()) {
+            file.remove();
+        }
+        col->setIndexed (False);
+    }
+}
+
+std::shared_ptr<PersistentColumnIndex> PlainTable::columnIndex
+                                           (const String& columnName)
+{
+    PlainColumn* col = colSetPtr_p->getColumn (columnName);
+    if (! col->isIndexed()) {
+        return std::shared_ptr<PersistentColumnIndex>();
+    }
+    return updateColumnIndex (col, indexChangeCounter (col));
+}
+
+uInt PlainTable::indexChangeCounter (const PlainColumn* col) const
+{
+    // The data of a virtual column are stored by other data managers,
+    // so use the counter of the entire table for it.
+    const DataManager* dataMan = col->dataManager();
+    if (! dataMan->isStorageManager()) {
+        return lockSync_p.getModifyCounter();
+    }
+    return lockSync_p.getDataManChangeCounter
+                              (colSetPtr_p->dataManagerIndex (dataMan));
+}
+
+Bool PlainTable::columnZoneMap (const String& columnName,
+                                Vector<rownr_t>& zoneStarts,
+                                Vector<Double>& minValues,
+                                Vector<Double>& maxValues)
+{
+    PlainColumn* col = colSetPtr_p->getColumn (columnName);
+    colSetPtr_p->checkReadLock (True);
+    Bool fnd = col->dataManagerColumn()->getZoneMap (zoneStarts,
+                                                     minValues, maxValues);
+    colSetPtr_p->autoReleaseLock();
+    return fnd;
+}
+
+std::shared_ptr<PersistentColumnIndex> PlainTable::updateColumnIndex
+                                                   (PlainColumn* col,
+                                                    uInt prevCounter)
+{
+    const String& name = col->columnDesc().name();
+    // The index file might have been removed by another process.
+    if (! File(PersistentColumnIndex::fileName (tableName(), name)).exists()) {
+        col->setIndexed (False);
+        return std::shared_ptr<PersistentColumnIndex>();
+    }
+    std::shared_ptr<PersistentColumnIndex> index =
+      std::make_shared<PersistentColumnIndex> (tableName(), name);
+    // If the change counter differs, another process changed the data,
+    // so the index has to be rebuilt fully. Otherwise only the rows
+    // changed, removed or added by this process have to be merged.
+    uInt counter = indexChangeCounter (col);
+    Bool valid = (index->changeCounter() == counter  ||
+                  index->changeCounter() == prevCounter);
+    rownr_t startRow = 0;
+    if (valid) {
+        startRow = std::min (col->indexChangedRow(), index->nrow());
+    }
+    if (!valid  ||  startRow < nrrow_p  ||  index->nrow() != nrrow_p) {
+        if (! isWritable()) {
+            return std::shared_ptr<PersistentColumnIndex>();
+        }
+        // Release the old index (its file gets replaced).
+        index.reset();
+        PersistentColumnIndex::build (Table(this), name, startRow, counter);
+        index = std::make_shared<PersistentColumnIndex> (tableName(), name);
+    } else if (index->changeCounter() != counter) {
+        // The counter was only changed by a flush of this process.
+        index.reset();
+        PersistentColumnIndex::setChangeCounter (tableName(), name, counter);
+        index = std::make_shared<PersistentColumnIndex> (tableName(), name);
+    }
+    col->clearIndexChanged();
+    return index;
+}
+
+
 ByteIO::OpenOption PlainTable::toAipsIOFoption (int tabOpt)
 {
     switch (tabOpt) {
@@ -43,6 +43,7 @@ class SetupNewTable;
 class TableLock;
 class TableLockData;
 class ColumnSet;
+class PlainColumn;
 class IPosition;
 class AipsIO;
 class MemoryIO;
@@ -263,6 +264,25 @@ public:
     virtual DataManager* findDataManager (const String& name,
                                           Bool byColumn) const;
 
+    // Create a persistent index for the given scalar column.
+    // An existing index is rebuilt.
+    void createColumnIndex (const String& columnName);
+
+    // Remove the persistent index of the given column (if existing).
+    void removeColumnIndex (const String& columnName);
+
+    // Get the persistent index of the given column after bringing it
+    // up-to-date. A null pointer is returned if the column has no index
+    // or if the index is outdated and the table is not writable.
+    virtual std::shared_ptr<PersistentColumnIndex> columnIndex
+                                           (const String& columnName);
+
+    // Get the zone map of the given column from its data manager.
+    virtual Bool columnZoneMap (const String& columnName,
+                                Vector<rownr_t>& zoneStarts,
+                                Vector<Double>& minValues,
+                                Vector<Double>& maxValues);
+
 
     // Get access to the TableCache.
     static TableCache& tableCache()
@@ -299,6 +319,22 @@ private:
     // Determine and set the endian format (big or little).
     void setEndian (int endianFormat);
 
+    // Mark the columns having a persistent index.
+    void initColumnIndices();
+
+    // Get the change counter to be stored in the persistent index of
+    // a column. It is the counter of the column's storage manager.
+    uInt indexChangeCounter (const PlainColumn* column) const;
+
+    // Bring the persistent index of a column up-to-date if data in the
+    // column have changed and return it. The index is rebuilt fully if its
+    // change counter does not match the current or the given previous
+    // counter. A null pointer is returned if the update is needed, but not
+    // possible because the table is not writable.
+    std::shared_ptr<PersistentColumnIndex> updateColumnIndex
+                                                   (PlainColumn* column,
+                                                    uInt prevCounter);
+
     // Throw an exception if the table is not writable.
     void checkWritable (const char* func) const;
 
@@ -103,6 +103,12 @@ void RefColumn::getArray (rownr_t rownr, ArrayBase& data) const
 void RefColumn::getSlice (rownr_t rownr, const Slicer& ns, ArrayBase& data) const
     { colPtr_p->getSlice (refTabPtr_p->rootRownr(rownr), ns, data); }
 
+Bool RefColumn::getArrayView (rownr_t rownr, const Slicer* slicer,
+                              const void*& data, IPosition& blockShape,
+                              Slicer& section) const
+    { return colPtr_p->getArrayView (refTabPtr_p->rootRownr(rownr), slicer,
+                                     data, blockShape, section); }
+
 void RefColumn::put (rownr_t rownr, const void* dataPtr)
     { colPtr_p->put (refTabPtr_p->rootRownr(rownr), dataPtr); }
 
@@ -114,16 +120,16 @@ void RefColumn::putSlice (rownr_t rownr, const Slicer& ns, const ArrayBase& data
 
 void RefColumn::getScalarColumn (ArrayBase& data) const
 {
-    colPtr_p->getScalarColumnCells (refTabPtr_p->rowNumbers(), data);
+    colPtr_p->getScalarColumnCells (refTabPtr_p->rowRanges(), data);
 }
 void RefColumn::getArrayColumn (ArrayBase& data) const
 {
-    colPtr_p->getArrayColumnCells (refTabPtr_p->rowNumbers(), data);
+    colPtr_p->getArrayColumnCells (refTabPtr_p->rowRanges(), data);
 }
 void RefColumn::getColumnSlice (const Slicer& ns,
 				ArrayBase& data) const
 {
-    colPtr_p->getColumnSliceCells (refTabPtr_p->rowNumbers(), ns, data); 
+    colPtr_p->getColumnSliceCells (refTabPtr_p->rowRanges(), ns, data); 
 }
 void RefColumn::getScalarColumnCells (const RefRows& rownrs,
 				      ArrayBase& data) const
@@ -137,6 +143,13 @@ void RefColumn::getArrayColumnCells (const RefRows& rownrs,
     colPtr_p->getArrayColumnCells (rownrs.convert(refTabPtr_p->rowNumbers()),
 				   data);
 }
+void RefColumn::getArrayColumnCellsParallel (const RefRows& rownrs,
+                                             ArrayBase& data,
+                                             uInt nthreads) const
+{
+    colPtr_p->getArrayColumnCellsParallel
+                      (rownrs.convert(refTabPtr_p->rowNumbers()), data, nthreads);
+}
 void RefColumn::getColumnSliceCells (const RefRows& rownrs,
 				     const Slicer& ns,
 				     ArrayBase& data) const
@@ -146,16 +159,16 @@ void RefColumn::getColumnSliceCells (const RefRows& rownrs,
 }
 void RefColumn::putScalarColumn (const ArrayBase& data)
 {
-    colPtr_p->putScalarColumnCells (refTabPtr_p->rowNumbers(), data);
+    colPtr_p->putScalarColumnCells (refTabPtr_p->rowRanges(), data);
 }
 void RefColumn::putArrayColumn (const ArrayBase& data)
 {
-    colPtr_p->putArrayColumnCells (refTabPtr_p->rowNumbers(), data);
+    colPtr_p->putArrayColumnCells (refTabPtr_p->rowRanges(), data);
 }
 void RefColumn::putColumnSlice (const Slicer& ns,
 				const ArrayBase& data)
 {
-    colPtr_p->putColumnSliceCells (refTabPtr_p->rowNumbers(), ns, data); 
+    colPtr_p->putColumnSliceCells (refTabPtr_p->rowRanges(), ns, data); 
 }
 void RefColumn::putScalarColumnCells (const RefRows& rownrs,
 				      const ArrayBase& data)
@@ -184,6 +197,12 @@ ColumnCache& RefColumn::columnCache()
 void RefColumn::setMaximumCacheSize (uInt nbytes)
     { colPtr_p->setMaximumCacheSize (nbytes); }
 
+uInt64 RefColumn::nbytesRead() const
+    { return colPtr_p->nbytesRead(); }
+
+void RefColumn::setCountRead (Bool countRead)
+    { colPtr_p->setCountRead (countRead); }
+
 
 void RefColumn::makeSortKey (Sort& sortobj, std::shared_ptr<BaseCompare>& cmpObj,
 			     Int order, std::shared_ptr<ArrayBase>& dataSave)
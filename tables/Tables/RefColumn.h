@@ -152,6 +152,12 @@ public:
     // Get a slice of an N-dimensional array in a particular cell.
     virtual void getSlice (rownr_t rownr, const Slicer&, ArrayBase& dataPtr) const;
 
+    // Get a read-only view of an array (or a slice of it) in a particular
+    // cell without copying the data, if the underlying column supports it.
+    virtual Bool getArrayView (rownr_t rownr, const Slicer* slicer,
+                               const void*& data, IPosition& blockShape,
+                               Slicer& section) const;
+
     // Get the vector of all scalar values in a column.
     virtual void getScalarColumn (ArrayBase& dataPtr) const;
 
@@ -175,6 +181,11 @@ public:
     virtual void getArrayColumnCells (const RefRows& rownrs,
 				      ArrayBase& dataPtr) const;
 
+    // Get some array values in the column using multiple threads.
+    virtual void getArrayColumnCellsParallel (const RefRows& rownrs,
+                                              ArrayBase& dataPtr,
+                                              uInt nthreads) const;
+
     // Get subsections from some arrays in the column.
     // If the column contains n-dim arrays, the resulting array is (n+1)-dim.
     // The arrays in the column have to have the same shape in all cells.
@@ -226,6 +237,14 @@ public:
     // Set the maximum cache size (in bytes) to be used by a storage manager.
     virtual void setMaximumCacheSize (uInt nbytes);
 
+    // Get the number of bytes read from the data manager(s) of the
+    // referenced column.
+    virtual uInt64 nbytesRead() const;
+
+    // Switch the counting of the bytes read on or off for the
+    // referenced column.
+    virtual void setCountRead (Bool countRead);
+
     // Add this column and its data to the Sort object.
     // It may allocate some storage on the heap, which will be saved
     // in the argument dataSave.
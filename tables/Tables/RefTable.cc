@@ -25,6 +25,7 @@
 
 #include <casacore/tables/Tables/RefTable.h>
 #include <casacore/tables/Tables/RefColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/TableLock.h>
@@ -39,6 +40,7 @@
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/System/AipsrcValue.h>
 #include <casacore/casa/BasicSL/STLIO.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -47,6 +49,7 @@ RefTable::RefTable (AipsIO& ios, const String& name, rownr_t nrrow, int opt,
 		    const TableLock& lockOptions, const TSMOption& tsmOption)
 : BaseTable    (name, opt, nrrow),
   rowStorage_p (0),              // initially empty vector of rownrs
+  rowsExpanded_p (True),
   changed_p    (False)
 {
     //# Read the file in.
@@ -65,6 +68,7 @@ RefTable::RefTable (BaseTable* btp, Bool order, rownr_t nrall)
   baseTabPtr_p (btp->root()->shared_from_this()),
   rowOrd_p     (order),
   rowStorage_p (nrall),       // allocate vector of rownrs
+  rowsExpanded_p (True),
   changed_p    (True)
 {
     AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
@@ -80,6 +84,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<rownr_t>& rownrs)
   baseTabPtr_p (btp->root()->shared_from_this()),
   rowOrd_p     (True),
   rowStorage_p (0),
+  rowsExpanded_p (True),
   changed_p    (True)
 {
     //# Copy the table description and create the columns.
@@ -105,6 +110,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<Bool>& mask)
   baseTabPtr_p (btp->root()->shared_from_this()),
   rowOrd_p     (btp->rowOrder()),
   rowStorage_p (0),              // initially empty vector of rownrs
+  rowsExpanded_p (True),
   changed_p    (True)
 {
     //# Copy the table description and create the columns.
@@ -127,6 +133,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<String>& columnNames)
   baseTabPtr_p (btp->root()->shared_from_this()),
   rowOrd_p     (btp->rowOrder()),
   rowStorage_p (0),
+  rowsExpanded_p (True),
   changed_p    (True)
 {
     //# Create table description by copying the selected columns.
@@ -242,6 +249,7 @@ Bool RefTable::adjustRownrs (rownr_t nr, Vector<rownr_t>& rowStorage,
 			     Bool determineOrder) const
 {
     // Note that rowStorage can be the same as rowStorage_p.
+    expandRows();
     AlwaysAssert (nr <= rowStorage.size(), AipsError);
     rowStorage.resize (nr, True);
     AlwaysAssert (rowStorage.contiguousStorage(), AipsError);
@@ -270,12 +278,28 @@ void RefTable::writeRefTable (Bool)
     //# Do this only when something has changed.
     if (changed_p) {
         TableTrace::traceRefTable (baseTabPtr_p->tableName(), 'w');
-        // Write old version if all row numbers fit in 32 bits.
+        // Write the row numbers as slices (version 4) only if enabled and
+        // if they take at most 1/8 of the space, because older versions of
+        // Casacore cannot read it.
+        // Otherwise write old version if all row numbers fit in 32 bits.
         Int version = 3;
-        if (nrrow_p < std::numeric_limits<uInt>::max()  &&
-            baseTabPtr_p->nrow() < std::numeric_limits<uInt>::max()  &&
-            allLT (rowStorage_p, rownr_t(std::numeric_limits<uInt>::max()))) {
-          version = 2;
+        Vector<rownr_t> slices;
+        if (writeSlices()) {
+          RefRows ranges = rowRanges();
+          if (ranges.isSliced()  &&
+              ranges.rowVector().size() <= nrrow_p/8) {
+            slices.reference (ranges.rowVector());
+            version = 4;
+          }
+        }
+        if (version != 4) {
+          expandRows();
+          if (nrrow_p < std::numeric_limits<uInt>::max()  &&
+              baseTabPtr_p->nrow() < std::numeric_limits<uInt>::max()  &&
+              allLT (rowStorage_p,
+                     rownr_t(std::numeric_limits<uInt>::max()))) {
+            version = 2;
+          }
         }
 	AipsIO ios;
 	writeStart (ios, True);
@@ -307,13 +331,21 @@ void RefTable::writeRefTable (Bool)
           convertArray (rows32, rowStorage_p(Slice(0, nrrow_p)));
         }
         const uInt* rows32p = rows32.data();
+        const rownr_t* rowsp = rowStorage_p.data();
+        rownr_t nval = nrrow_p;
+        if (version == 4) {
+          // Write the start,end,incr values of the slices.
+          rowsp = slices.data();
+          nval  = slices.size();
+          ios << nval;
+        }
         rownr_t done = 0;
-        while (done < nrrow_p) {
-          rownr_t todo = std::min(nrrow_p-done, rownr_t(1048576));
+        while (done < nval) {
+          rownr_t todo = std::min(nval-done, rownr_t(1048576));
           if (version == 2) {
             ios.put (todo, rows32p+done, False);
           } else {
-            ios.put (todo, rowStorage_p.data()+done, False);
+            ios.put (todo, rowsp+done, False);
           }
           done += todo;
         }
@@ -333,7 +365,7 @@ void RefTable::getRef (AipsIO& ios, int opt, const TableLock& lockOptions,
     String rootName;
     rownr_t rootNrow, nrrow;
     Int version = ios.getstart ("RefTable");
-    if (version > 3) {
+    if (version > 4) {
       throw TableError ("RefTable version " + String::toString(version) +
                         " not supported by this version of Cassacore");
     }
@@ -353,13 +385,27 @@ void RefTable::getRef (AipsIO& ios, int opt, const TableLock& lockOptions,
       nrrow = n2;
     }
     DebugAssert (nrrow == nrrow_p, AipsError);
-    //# Resize the block of rownrs and read them in.
-    rowStorage_p.resize (nrrow);
-    AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
-    rownr_t* rows = rowStorage_p.data();
     rownr_t done = 0;
     // Do not read more than 2**20 rows at once (CAS-7020).
-    if (version > 2) {
+    if (version > 3) {
+      // The row numbers are stored as start,end,incr slices.
+      // Keep them as such; they are expanded when needed.
+      rownr_t nval;
+      ios >> nval;
+      rangeStorage_p.resize (nval);
+      while (done < nval) {
+        rownr_t todo = std::min(nval-done, rownr_t(1048576));
+        ios.get (todo, rangeStorage_p.data()+done);
+        done += todo;
+      }
+      AlwaysAssert (RefRows(rangeStorage_p, True).nrow() == nrrow,
+                    AipsError);
+      rowsExpanded_p = False;
+    } else if (version > 2) {
+      //# Resize the block of rownrs and read them in.
+      rowStorage_p.resize (nrrow);
+      AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
+      rownr_t* rows = rowStorage_p.data();
       while (done < nrrow) {
         rownr_t todo = std::min(nrrow_p-done, rownr_t(1048576));
         ios.get (todo, rows+done);
@@ -373,6 +419,7 @@ void RefTable::getRef (AipsIO& ios, int opt, const TableLock& lockOptions,
         ios.get (todo, p+done);
         done += todo;
       }
+      rowStorage_p.resize (nrrow);
       convertArray (rowStorage_p, rows);
     }
     ios.getend();
@@ -524,6 +571,7 @@ void RefTable::addRefCol (const TableDesc& tdesc)
 //# Add a row number of the root table.
 void RefTable::addRownr (rownr_t rnr)
 {
+    clearRanges();
     rownr_t nrow = rowStorage_p.nelements();
     if (nrrow_p >= nrow) {
         nrow = max ( nrow + 1024, rownr_t(1.2f * nrow));
@@ -537,6 +585,7 @@ void RefTable::addRownr (rownr_t rnr)
 //# Add a row number range of the root table.
 void RefTable::addRownrRange (rownr_t startRownr, rownr_t endRownr)
 {
+    clearRanges();
     rownr_t nrow = rowStorage_p.nelements();
     rownr_t new_nrrow_p = nrrow_p + endRownr - startRownr + 1;
     if (new_nrrow_p > nrow) {
@@ -556,6 +605,7 @@ void RefTable::setNrrow (rownr_t nrrow)
     if (nrrow > nrrow_p) {
 	throw (TableError ("RefTable::setNrrow: exceeds current nrrow"));
     }
+    clearRanges();
     AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
     nrrow_p = nrrow;
     changed_p = True;
@@ -709,11 +759,16 @@ BaseColumn* RefTable::getColumn (uInt columnIndex) const
     
 
 Vector<rownr_t>& RefTable::rowStorage()
-    { return rowStorage_p; }
+{
+    // The caller can change the row numbers.
+    clearRanges();
+    return rowStorage_p;
+}
 
 //# Convert a vector of row numbers to row numbers in this table.
 Vector<rownr_t> RefTable::rootRownr (const Vector<rownr_t>& rownrs) const
 {
+    expandRows();
     const rownr_t* rows = rowStorage_p.data();
     rownr_t nrow = rownrs.nelements();
     Vector<rownr_t> rnr(nrow);
@@ -731,6 +786,7 @@ Bool RefTable::rowOrder() const
 
 Vector<rownr_t> RefTable::rowNumbers() const
 {
+    expandRows();
     if (nrrow_p == rowStorage_p.nelements()) {
 	return rowStorage_p;
     }
@@ -738,6 +794,86 @@ Vector<rownr_t> RefTable::rowNumbers() const
     return vec(Slice(0, nrrow_p));
 }
 
+RefRows RefTable::rowRanges() const
+{
+    {
+        // Determine the slices only once, also if called by multiple threads.
+        std::lock_guard<std::mutex> lock(rowsMutex_p);
+        if (! rangeStorage_p.empty()) {
+            return RefRows (rangeStorage_p, True);
+        }
+        // Collapse the runs of consecutive row numbers into start,end,1
+        // slices. Stop if it does not save at least half of the space.
+        // The row numbers are expanded, because there are no slices.
+        const rownr_t* rows = rowStorage_p.data();
+        std::vector<rownr_t> slices;
+        rownr_t i = 0;
+        while (i < nrrow_p) {
+            rownr_t j = i+1;
+            while (j < nrrow_p  &&  rows[j] == rows[j-1] + 1) {
+                j++;
+            }
+            if (slices.size() + 3 > nrrow_p / 2) {
+                slices.clear();
+                break;
+            }
+            slices.push_back (rows[i]);
+            slices.push_back (rows[j-1]);
+            slices.push_back (1);
+            i = j;
+        }
+        if (! slices.empty()) {
+            rangeStorage_p = Vector<rownr_t>(slices);
+            return RefRows (rangeStorage_p, True);
+        }
+    }
+    return RefRows (rowNumbers());
+}
+
+void RefTable::fillRows() const
+{
+    std::lock_guard<std::mutex> lock(rowsMutex_p);
+    // Another thread might have filled them in the meantime.
+    if (rowsExpanded_p.load (std::memory_order_relaxed)) {
+        return;
+    }
+    rowStorage_p.resize (nrrow_p);
+    AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
+    rownr_t* rows = rowStorage_p.data();
+    rownr_t nr = 0;
+    for (RefRowsSliceIter iter(RefRows(rangeStorage_p, True));
+         !iter.pastEnd(); iter++) {
+        for (rownr_t row=iter.sliceStart(); row<=iter.sliceEnd();
+             row+=iter.sliceIncr()) {
+            rows[nr++] = row;
+        }
+    }
+    rowsExpanded_p.store (True, std::memory_order_release);
+}
+
+static uInt writeSlicesKey()
+{
+    static const uInt key = AipsrcValue<Bool>::registerRC
+      ("table.reftable.writeslices", False);
+    return key;
+}
+
+Bool RefTable::writeSlices()
+{
+    return AipsrcValue<Bool>::get (writeSlicesKey());
+}
+
+void RefTable::setWriteSlices (Bool writeSlices)
+{
+    AipsrcValue<Bool>::set (writeSlicesKey(), writeSlices);
+}
+
+void RefTable::clearRanges()
+{
+    expandRows();
+    rangeStorage_p.resize (0);
+}
+
 
 Bool RefTable::checkAddColumn (const String& name, Bool addToParent)
 {
@@ -817,6 +953,7 @@ void RefTable::removeRow (rownr_t rownr)
     if (rownr >= nrrow_p) {
 	throw (TableInvOper ("removeRow: rownr out of bounds"));
     }
+    clearRanges();
     rownr_t* rows = rowStorage_p.data();
     if (rownr < nrrow_p - 1) {
 	objmove (rows+rownr, rows+rownr+1, nrrow_p-rownr-1);
@@ -827,6 +964,7 @@ void RefTable::removeRow (rownr_t rownr)
 
 void RefTable::removeAllRow ()
 {
+    clearRanges();
     nrrow_p=0;
     changed_p = True;
 }
@@ -879,6 +1017,7 @@ void RefTable::refAnd (rownr_t nr1, const rownr_t* inx1,
 		       rownr_t nr2, const rownr_t* inx2)
 {
     rownr_t allrow = (nr1 < nr2  ?  nr1 : nr2);  // max #output rows
+    clearRanges();
     rowStorage_p.resize (allrow);             // allocate output storage
     AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
     rownr_t* rows = rowStorage_p.data();
@@ -916,6 +1055,7 @@ void RefTable::refOr (rownr_t nr1, const rownr_t* inx1,
 		      rownr_t nr2, const rownr_t* inx2)
 {
     rownr_t allrow = nr1 + nr2;                  // max #output rows
+    clearRanges();
     rowStorage_p.resize (allrow);             // allocate output storage
     AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
     rownr_t* rows = rowStorage_p.data();
@@ -955,6 +1095,7 @@ void RefTable::refSub (rownr_t nr1, const rownr_t* inx1,
 		       rownr_t nr2, const rownr_t* inx2)
 {
     rownr_t allrow = nr1;                        // max #output rows
+    clearRanges();
     rowStorage_p.resize (allrow);             // allocate output storage
     AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
     rownr_t* rows = rowStorage_p.data();
@@ -992,6 +1133,7 @@ void RefTable::refXor (rownr_t nr1, const rownr_t* inx1,
 		       rownr_t nr2, const rownr_t* inx2)
 {
     rownr_t allrow = nr1 + nr2;                  // max #output rows
+    clearRanges();
     rowStorage_p.resize (allrow);             // allocate output storage
     AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
     rownr_t* rows = rowStorage_p.data();
@@ -1032,6 +1174,7 @@ void RefTable::refNot (rownr_t nr, const rownr_t* inx, rownr_t nrtot)
     // The original table has NRTOT rows.
     // So loop through the inx-array and store all rownrs not in the array.
     rownr_t allrow = nrtot - nr;                 // #output rows
+    clearRanges();
     rowStorage_p.resize (allrow);             // allocate output storage
     AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
     rownr_t* rows = rowStorage_p.data();
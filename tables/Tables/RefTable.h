@@ -32,13 +32,16 @@
 #include <casacore/tables/Tables/BaseTable.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/Arrays/Vector.h>
+#include <atomic>
 #include <map>
+#include <mutex>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 //# Forward Declarations
 class TSMOption;
 class RefColumn;
+class RefRows;
 class AipsIO;
 
 
@@ -82,6 +85,19 @@ class AipsIO;
 // (like a join or a concatenation of similar tables), this cannot be
 // used anymore. Most software already anticipates on that. The only
 // exception is the code anding, oring tables (refAnd, etc.).
+//
+// Selections often consist of long runs of consecutive row numbers.
+// Function <src>rowRanges</src> gives the row numbers as a
+// <linkto class=RefRows>RefRows</linkto> object containing such runs as
+// slices, which is used by RefColumn to get or put an entire column.
+// In that way the data managers can access the data per range of rows.
+// When writing the RefTable, the row numbers can be stored as slices as
+// well if that takes much less space. Because older Casacore versions
+// cannot read such a RefTable, this has to be enabled explicitly (see
+// function <src>setWriteSlices</src>). When such a RefTable is read back,
+// the slices are kept and only expanded to a vector of row numbers
+// when the row numbers are accessed individually. The expansion is
+// thread-safe, so multiple threads can read the same RefTable.
 // </synopsis> 
 
 // <todo asof="$DATE:$">
@@ -157,6 +173,16 @@ public:
     // is stored in desc (its contents will be overwritten).
     static void getLayout (TableDesc& desc, AipsIO& ios);
 
+    // Get or set if the row numbers can be written as slices (version 4 of
+    // the RefTable file format) if that takes much less space. Note that
+    // older Casacore versions cannot read such a RefTable.
+    // The default is given by the aipsrc variable
+    // <src>table.reftable.writeslices</src> (default False).
+    // <group>
+    static Bool writeSlices();
+    static void setWriteSlices (Bool writeSlices);
+    // </group>
+
     // Try to reopen the table (the underlying one) for read/write access.
     // An exception is thrown if the table is not writable.
     // Nothing is done if the table is already open for read/write.
@@ -295,6 +321,13 @@ public:
     // Get a vector of row numbers.
     virtual Vector<rownr_t> rowNumbers() const;
 
+    // Get the row numbers as a RefRows object. Runs of consecutive row
+    // numbers are collapsed into slices if that takes much less space
+    // (e.g., because the table is a selection of time ranges).
+    // Otherwise it contains the vector of row numbers.
+    // The slices are kept, so they are only determined once.
+    RefRows rowRanges() const;
+
     // Get parent of this table.
     virtual BaseTable* root();
 
@@ -338,7 +371,10 @@ void addRownrRange (rownr_t startRownr, rownr_t endRownr);
 private:
     std::shared_ptr<BaseTable> baseTabPtr_p;//# pointer to parent table
     Bool            rowOrd_p;               //# True = table is in row order
-    Vector<rownr_t> rowStorage_p;           //# row numbers in parent table
+    mutable Vector<rownr_t> rowStorage_p;   //# row numbers in parent table
+    mutable Vector<rownr_t> rangeStorage_p; //# idem as start,end,incr slices
+    mutable std::atomic<Bool> rowsExpanded_p; //# False = only slices are known
+    mutable std::mutex rowsMutex_p;         //# guards the lazy fill of both
     std::map<String,String> nameMap_p;      //# map to column name in parent
     std::map<String,RefColumn*> colMap_p;   //# map name to column
     Bool            changed_p;              //# True = changed since last write
@@ -370,6 +406,16 @@ private:
     // Write a reference table.
     void writeRefTable (Bool fsync);
 
+    // Make sure the row numbers are filled from the slices.
+    // It can be called by multiple threads at the same time.
+    void expandRows() const
+      { if (!rowsExpanded_p.load (std::memory_order_acquire)) fillRows(); }
+    void fillRows() const;
+
+    // Expand the row numbers and remove the slices, because the
+    // row numbers are going to be changed.
+    void clearRanges();
+
     // Copy a RefTable that is not persistent. It requires some special logic.
     void copyRefTable (const String& newName, int tableOption);
 
@@ -386,7 +432,7 @@ private:
 
 
 inline rownr_t RefTable::rootRownr (rownr_t rnr) const
-    { return rowStorage_p[rnr]; }
+    { expandRows(); return rowStorage_p[rnr]; }
 
 
 
@@ -115,6 +115,10 @@ public:
     // the actual length. This is checked by ScalarColumn.
     virtual void getScalarColumn (ArrayBase& dataPtr) const;
 
+    // Get a read-only view of the values in the column without copying
+    // the data, if the data manager supports it.
+    virtual Bool getColumnView (const void*& data, IPosition& shape) const;
+
     // Get the array of some values in the column (on behalf of RefColumn).
     // The length of the buffer pointed to by dataPtr must match
     // the actual length. This is checked by ScalarColumn.
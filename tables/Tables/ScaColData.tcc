@@ -37,6 +37,7 @@
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/IO/AipsIO.h>
+#include <algorithm>
 
 
 
@@ -102,6 +103,7 @@ void ScalarColumnData<T>::get (rownr_t rownr, void* val) const
     }
     checkReadLock (True);
     dataColPtr_p->get (rownr, static_cast<T*>(val));
+    countRead (sizeof(T));
     autoReleaseLock();
 }
 
@@ -117,9 +119,20 @@ void ScalarColumnData<T>::getScalarColumn (ArrayBase& val) const
     }
     checkReadLock (True);
     dataColPtr_p->getScalarColumnV (val);
+    countRead (val.nelements() * sizeof(T));
     autoReleaseLock();
 }
 
+template<class T>
+Bool ScalarColumnData<T>::getColumnView (const void*& data,
+                                         IPosition& shape) const
+{
+    checkReadLock (True);
+    Bool fnd = dataColPtr_p->getColumnViewV (data, shape);
+    autoReleaseLock();
+    return fnd;
+}
+
 template<class T>
 void ScalarColumnData<T>::getScalarColumnCells (const RefRows& rownrs,
 						ArrayBase& val) const
@@ -132,6 +145,7 @@ void ScalarColumnData<T>::getScalarColumnCells (const RefRows& rownrs,
     }
     checkReadLock (True);
     dataColPtr_p->getScalarColumnCellsV (rownrs, val);
+    countRead (val.nelements() * sizeof(T));
     autoReleaseLock();
 }
 
@@ -144,6 +158,7 @@ void ScalarColumnData<T>::put (rownr_t rownr, const void* val)
     }
     checkValueLength (static_cast<const T*>(val));
     checkWriteLock (True);
+    setIndexChanged (rownr);
     dataColPtr_p->put (rownr, static_cast<const T*>(val));
     autoReleaseLock();
 }
@@ -159,6 +174,7 @@ void ScalarColumnData<T>::putScalarColumn (const ArrayBase& val)
     }
     checkValueLength (static_cast<const Array<T>*>(&val));
     checkWriteLock (True);
+    setIndexChanged (0);
     dataColPtr_p->putScalarColumnV (val);
     autoReleaseLock();
 }
@@ -175,6 +191,12 @@ void ScalarColumnData<T>::putScalarColumnCells (const RefRows& rownrs,
     }
     checkValueLength (static_cast<const Array<T>*>(&val));
     checkWriteLock (True);
+    if (isIndexed()  &&  rownrs.nrow() > 0) {
+        // For sliced RefRows the minimum can be the increment, which is
+        // fine because it is a lower bound of the row numbers.
+        const Vector<rownr_t>& rows = rownrs.rowVector();
+        setIndexChanged (*std::min_element (rows.begin(), rows.end()));
+    }
     dataColPtr_p->putScalarColumnCellsV (rownrs, val);
     autoReleaseLock();
 }
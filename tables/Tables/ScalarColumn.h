@@ -165,6 +165,15 @@ public:
     // Get the vector of all values in the column.
     Vector<T> getColumn() const;
 
+    // Get a read-only view of all values in the column. If possible, the
+    // vector references the data in the data manager directly and True is
+    // returned. That is the case for a MemoryStMan in arena mode (see
+    // <linkto class=MemoryStMan>MemoryStMan</linkto>).
+    // Otherwise the data are copied into a new vector and False is returned.
+    // <br>The vector referencing the data must not be changed. It is only
+    // valid as long as the table is open and no rows are added or removed.
+    Bool getColumnView (Vector<T>& view) const;
+
     // Get the vector of a range of values in the column.
     // The Slicer object can be used to specify start, end (or length),
     // and stride of the rows to get.
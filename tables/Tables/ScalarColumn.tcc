@@ -133,6 +133,21 @@ void ScalarColumn<T>::getColumn (Vector<T>& vec, Bool resize) const
     baseColPtr_p->getScalarColumn (vec);
 }
 
+template<class T>
+Bool ScalarColumn<T>::getColumnView (Vector<T>& view) const
+{
+    const void* data;
+    IPosition shape;
+    if (baseColPtr_p->getColumnView (data, shape)) {
+        view.reference (Vector<T> (shape,
+                                   static_cast<T*>(const_cast<void*>(data)),
+                                   SHARE));
+        return True;
+    }
+    view.reference (getColumn());
+    return False;
+}
+
 
 template<class T>
 Vector<T> ScalarColumn<T>::getColumnRange (const Slicer& rowRange) const
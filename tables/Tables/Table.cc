@@ -775,8 +775,10 @@ TableExprNode Table::nodeRandom() const
 
 //# Select rows based on an expression.
 Table Table::operator() (const TableExprNode& expr,
-                         rownr_t maxRow, rownr_t offset) const
-    { return Table (baseTabPtr_p->select (expr, maxRow, offset)); }
+                         rownr_t maxRow, rownr_t offset, uInt nthreads,
+                         rownr_t startRow) const
+    { return Table (baseTabPtr_p->select (expr, maxRow, offset, nthreads,
+                                          startRow)); }
 //# Select rows based on row numbers.
 Table Table::operator() (const RowNumbers& rownrs) const
     { return Table (baseTabPtr_p->select (rownrs)); }
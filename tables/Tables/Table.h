@@ -163,6 +163,7 @@ friend class RefTable;
 friend class ConcatTable;
 friend class TableIterator;
 friend class RODataManAccessor;
+friend class PersistentColumnIndex;
 friend class TableExprNode;
 friend class TableExprNodeRep;
 
@@ -782,7 +783,15 @@ public:
     // when <src>maxRow</src> rows are selected.
     // <br>The TableExprNode argument can be empty (null) meaning that only
     // the <src>maxRow/offset</src> arguments are taken into account.
-    Table operator() (const TableExprNode&, rownr_t maxRow=0, rownr_t offset=0) const;
+    // <br>If <src>nthreads</src> is not 1, the expression is evaluated by
+    // that many threads (0 means all available threads) if possible.
+    // That is the case if the expression only uses scalar columns and no
+    // user defined functions or random numbers; otherwise it is evaluated
+    // by a single thread.
+    // <br>Only the rows from <src>startRow</src> on are evaluated, which
+    // can be used to select in the rows added since a previous selection.
+    Table operator() (const TableExprNode&, rownr_t maxRow=0, rownr_t offset=0,
+                      uInt nthreads=1, rownr_t startRow=0) const;
 
     // Select rows using a vector of row numbers.
     // This can, for instance, be used to select the same rows as
@@ -381,6 +381,19 @@ public:
     void setMaximumCacheSize (uInt nbytes) const
         { baseColPtr_p->setMaximumCacheSize (nbytes); }
 
+    // Get the number of bytes read so far from the data manager(s) of the
+    // column (by all objects accessing the column in this process).
+    // It is the in-memory size of the values read, where a String counts
+    // as the size of a String object. The bytes are only counted while
+    // counting is switched on using <src>setCountRead</src>.
+    uInt64 nbytesRead() const
+        { return baseColPtr_p->nbytesRead(); }
+
+    // Switch the counting of the bytes read on or off.
+    // It is switched on by TaQL's EXPLAIN ANALYZE.
+    void setCountRead (Bool countRead) const
+        { baseColPtr_p->setCountRead (countRead); }
+
 protected:
     BaseTable*  baseTabPtr_p;
     BaseColumn* baseColPtr_p;                //# pointer to real column object
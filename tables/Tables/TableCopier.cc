@@ -0,0 +1,729 @@
+//# TableCopier.cc: Copy the rows of a table using pipelined reads and writes
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+
+//# Includes
+#include <casacore/tables/Tables/TableCopier.h>
+#include <casacore/tables/Tables/TableRow.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/ColumnDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/StorageOption.h>
+#include <casacore/tables/Tables/TableLock.h>
+#include <casacore/tables/Tables/TableLocker.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/DataMan/TiledStMan.h>
+#include <casacore/tables/DataMan/TSMCube.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/OS/OMP.h>
+#include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/System/ProgressMeter.h>
+#include <casacore/casa/Utilities/DataType.h>
+#include <casacore/casa/iostream.h>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# The number of bytes aimed at for a block.
+//# Two blocks are held in memory; one being read, one being written.
+static const Int64 theBlockBytes = 32*1024*1024;
+static const uInt  theNrSlots    = 2;
+
+
+//# Get the number of rows in a tile of a column stored in a tiled
+//# storage manager with the rows mapped to the last axis.
+//# It returns 1 for other columns.
+static rownr_t tiledRows (const Table& tab, const String& name, uInt ndim)
+{
+  const TiledStMan* tsm = dynamic_cast<const TiledStMan*>
+                                  (tab.findDataManager (name, True));
+  if (tsm == 0  ||  tsm->nrCoordVector() != ndim) {
+    return 1;
+  }
+  IPosition tileShape;
+  if (tsm->nrow() > 0  &&  tsm->nhypercubes() > 0) {
+    tileShape = tsm->getHypercube(0)->tileShape();
+  }
+  if (tileShape.size() != ndim + 1) {
+    tileShape = tsm->defaultTileShape();
+  }
+  if (tileShape.size() != ndim + 1  ||  tileShape[ndim] <= 0) {
+    return 1;
+  }
+  return tileShape[ndim];
+}
+
+//# Get the number of bytes in a value or an array.
+template<typename T>
+inline Int64 copierBytes (const T&)
+  { return sizeof(T); }
+inline Int64 copierBytes (const String& str)
+  { return str.size(); }
+template<typename T>
+inline Int64 copierBytes (const Array<T>& arr)
+  { return arr.size() * sizeof(T); }
+inline Int64 copierBytes (const Array<String>& arr)
+{
+  Int64 nbytes = 0;
+  for (const String& str : arr) {
+    nbytes += str.size();
+  }
+  return nbytes;
+}
+
+
+// <summary>
+// Abstract base class to copy the data of a column in a TableCopier
+// </summary>
+// <synopsis>
+// A TableCopierColumn holds the input and output column and a buffer for
+// each slot in the pipeline of a TableCopier. The derived classes are
+// templated on the data type.
+// </synopsis>
+class TableCopierColumn
+{
+public:
+  TableCopierColumn (const Table& out, const Table& in, const String& name)
+    : name_p (name)
+  {
+    uInt ndim = 0;
+    const ColumnDesc& cdesc = in.tableDesc()[name];
+    if (cdesc.isArray()) {
+      ndim = std::max (0, cdesc.ndim());
+    }
+    tileRows_p = std::max (tiledRows (in, name, ndim),
+                           tiledRows (out, name, ndim));
+  }
+
+  virtual ~TableCopierColumn()
+  {}
+
+  // Get the name of the column.
+  const String& name() const
+    { return name_p; }
+
+  // Get the number of rows in a tile of the input or output column.
+  rownr_t tileRows() const
+    { return tileRows_p; }
+
+  // Get the (estimated) number of bytes in the given input row.
+  virtual Int64 rowBytes (rownr_t rownr) const = 0;
+
+  // Read the given input rows into the buffer of the given slot.
+  // It returns the number of bytes read.
+  virtual Int64 read (uInt slot, rownr_t startin, rownr_t nrow,
+                      uInt nthreads) = 0;
+
+  // Write the buffer of the given slot into the given output rows.
+  virtual void write (uInt slot, rownr_t startout, rownr_t nrow) = 0;
+
+protected:
+  String  name_p;
+  rownr_t tileRows_p;
+};
+
+
+// <summary>
+// Copy the data of a scalar column in a TableCopier
+// </summary>
+template<typename T>
+class TableCopierScalar : public TableCopierColumn
+{
+public:
+  TableCopierScalar (Table& out, const Table& in, const String& name)
+    : TableCopierColumn (out, in, name),
+      incol_p  (in, name),
+      outcol_p (out, name),
+      buffer_p (theNrSlots)
+  {}
+
+  virtual Int64 rowBytes (rownr_t) const
+    { return sizeof(T); }
+
+  virtual Int64 read (uInt slot, rownr_t startin, rownr_t nrow, uInt)
+  {
+    Vector<T>& buf = buffer_p[slot];
+    incol_p.getColumnRange (Slicer(IPosition(1,startin), IPosition(1,nrow)),
+                            buf, True);
+    Int64 nbytes = 0;
+    for (const T& val : buf) {
+      nbytes += copierBytes (val);
+    }
+    return nbytes;
+  }
+
+  virtual void write (uInt slot, rownr_t startout, rownr_t nrow)
+  {
+    outcol_p.putColumnRange (Slicer(IPosition(1,startout), IPosition(1,nrow)),
+                             buffer_p[slot]);
+  }
+
+private:
+  ScalarColumn<T> incol_p;
+  ScalarColumn<T> outcol_p;
+  std::vector<Vector<T>> buffer_p;
+};
+
+
+// <summary>
+// Copy the data of an array column in a TableCopier
+// </summary>
+// <synopsis>
+// The data of a block are read as a single array if the cells in the block
+// have the same shape, which is always the case for a FixedShape column.
+// Otherwise they are read cell by cell, where undefined cells are skipped.
+// </synopsis>
+template<typename T>
+class TableCopierArray : public TableCopierColumn
+{
+public:
+  TableCopierArray (Table& out, const Table& in, const String& name)
+    : TableCopierColumn (out, in, name),
+      incol_p  (in, name),
+      outcol_p (out, name),
+      fixed_p  (incol_p.columnDesc().isFixedShape()),
+      slots_p  (theNrSlots)
+  {}
+
+  virtual Int64 rowBytes (rownr_t rownr) const
+  {
+    if (incol_p.isDefined (rownr)) {
+      return incol_p.shape(rownr).product() * sizeof(T);
+    }
+    return 0;
+  }
+
+  virtual Int64 read (uInt slot, rownr_t startin, rownr_t nrow,
+                      uInt nthreads)
+  {
+    Slot& buf = slots_p[slot];
+    buf.isBlock = fixed_p  ||  sameShape (startin, nrow);
+    if (buf.isBlock) {
+      incol_p.getColumnRangeParallel
+        (Slicer(IPosition(1,startin), IPosition(1,nrow)), buf.block,
+         True, nthreads);
+      return copierBytes (buf.block);
+    }
+    Int64 nbytes = 0;
+    buf.cells.resize (nrow);
+    buf.defined.resize (nrow);
+    for (rownr_t i=0; i<nrow; ++i) {
+      buf.defined[i] = incol_p.isDefined (startin+i);
+      if (buf.defined[i]) {
+        incol_p.get (startin+i, buf.cells[i], True);
+        nbytes += copierBytes (buf.cells[i]);
+      } else {
+        buf.cells[i].resize();
+      }
+    }
+    return nbytes;
+  }
+
+  virtual void write (uInt slot, rownr_t startout, rownr_t nrow)
+  {
+    Slot& buf = slots_p[slot];
+    if (buf.isBlock) {
+      outcol_p.putColumnRange
+        (Slicer(IPosition(1,startout), IPosition(1,nrow)), buf.block);
+    } else {
+      for (rownr_t i=0; i<nrow; ++i) {
+        if (buf.defined[i]) {
+          outcol_p.put (startout+i, buf.cells[i]);
+        }
+      }
+    }
+  }
+
+private:
+  // Are all cells in the given rows defined with the same shape?
+  Bool sameShape (rownr_t startin, rownr_t nrow) const
+  {
+    if (! incol_p.isDefined (startin)) {
+      return False;
+    }
+    IPosition shp = incol_p.shape (startin);
+    for (rownr_t i=1; i<nrow; ++i) {
+      if (! incol_p.isDefined (startin+i)  ||
+          ! shp.isEqual (incol_p.shape (startin+i))) {
+        return False;
+      }
+    }
+    return True;
+  }
+
+  struct Slot {
+    Bool isBlock;
+    Array<T> block;
+    std::vector<Array<T>> cells;
+    std::vector<Bool> defined;
+  };
+  ArrayColumn<T> incol_p;
+  ArrayColumn<T> outcol_p;
+  Bool fixed_p;
+  std::vector<Slot> slots_p;
+};
+
+
+//# Make the copier object for a column of a standard data type.
+//# It returns a null pointer for other data types.
+template<typename T>
+static std::shared_ptr<TableCopierColumn> makeCopierColumn
+(Table& out, const Table& in, const String& name, Bool isScalar)
+{
+  if (isScalar) {
+    return std::make_shared<TableCopierScalar<T>> (out, in, name);
+  }
+  return std::make_shared<TableCopierArray<T>> (out, in, name);
+}
+
+static std::shared_ptr<TableCopierColumn> makeCopierColumn
+(Table& out, const Table& in, const String& name, DataType dtype,
+ Bool isScalar)
+{
+  switch (dtype) {
+  case TpBool:
+    return makeCopierColumn<Bool> (out, in, name, isScalar);
+  case TpUChar:
+    return makeCopierColumn<uChar> (out, in, name, isScalar);
+  case TpShort:
+    return makeCopierColumn<Short> (out, in, name, isScalar);
+  case TpUShort:
+    return makeCopierColumn<uShort> (out, in, name, isScalar);
+  case TpInt:
+    return makeCopierColumn<Int> (out, in, name, isScalar);
+  case TpUInt:
+    return makeCopierColumn<uInt> (out, in, name, isScalar);
+  case TpInt64:
+    return makeCopierColumn<Int64> (out, in, name, isScalar);
+  case TpFloat:
+    return makeCopierColumn<Float> (out, in, name, isScalar);
+  case TpDouble:
+    return makeCopierColumn<Double> (out, in, name, isScalar);
+  case TpComplex:
+    return makeCopierColumn<Complex> (out, in, name, isScalar);
+  case TpDComplex:
+    return makeCopierColumn<DComplex> (out, in, name, isScalar);
+  case TpString:
+    return makeCopierColumn<String> (out, in, name, isScalar);
+  default:
+    break;
+  }
+  return std::shared_ptr<TableCopierColumn>();
+}
+
+//# Test if the column has a data type supported by the TableCopier.
+static Bool isCopierType (DataType dtype)
+{
+  switch (dtype) {
+  case TpBool:
+  case TpUChar:
+  case TpShort:
+  case TpUShort:
+  case TpInt:
+  case TpUInt:
+  case TpInt64:
+  case TpFloat:
+  case TpDouble:
+  case TpComplex:
+  case TpDComplex:
+  case TpString:
+    return True;
+  default:
+    break;
+  }
+  return False;
+}
+
+
+TableCopier::TableCopier (Table& out, const Table& in, uInt nthreads)
+: out_p           (out),
+  in_p            (in),
+  nthreads_p      (nthreads == 0  ?  OMP::maxThreads() : nthreads),
+  blockRows_p     (0),
+  usedBlockRows_p (0),
+  progress_p      (False),
+  concurrent_p    (False),
+  nrTileColumns_p (0),
+  nbytes_p        (0),
+  readTime_p      (0),
+  writeTime_p     (0),
+  elapsedTime_p   (0)
+{
+  if (! canCopy (out, in)) {
+    throw TableError ("TableCopier: table " + in.tableName() +
+                      " cannot be copied to " + out.tableName() +
+                      " in blocks");
+  }
+  // The columns of different data managers can be read concurrently,
+  // unless AutoLocking is used (because getting and releasing the lock
+  // is not thread-safe) or the data managers share a MultiFile.
+  concurrent_p = (nthreads_p > 1  &&
+                  in.lockOptions().option() != TableLock::AutoLocking  &&
+                  in.storageOption().option() == StorageOption::SepFile);
+  // The columns are grouped per data manager that can be accessed
+  // concurrently. All other columns (including virtual ones, which can
+  // read any other column) form a single group read by one thread.
+  Vector<String> columns = columnsToCopy (out, in);
+  std::map<const DataManager*,uInt> groupMap;
+  for (uInt i=0; i<columns.size(); ++i) {
+    const ColumnDesc& cdesc = in.tableDesc()[columns[i]];
+    columns_p.push_back (makeCopierColumn (out_p, in_p, columns[i],
+                                           cdesc.dataType(),
+                                           cdesc.isScalar()));
+    const DataManager* dm = in.findDataManager (columns[i], True);
+    if (! (dm->isStorageManager()  &&  dm->canAccessConcurrently())) {
+      dm = 0;
+    }
+    auto iter = groupMap.find (dm);
+    if (iter == groupMap.end()) {
+      iter = groupMap.insert (std::make_pair (dm, groups_p.size())).first;
+      groups_p.push_back (std::vector<uInt>());
+    }
+    groups_p[iter->second].push_back (i);
+  }
+  if (groups_p.size() < 2) {
+    concurrent_p = False;
+  }
+}
+
+TableCopier::~TableCopier()
+{}
+
+Bool TableCopier::canReadConcurrently (const Table& out, const Table& in)
+{
+  Vector<String> columns = columnsToCopy (out, in);
+  for (uInt i=0; i<columns.size(); ++i) {
+    const DataManager* dm = in.findDataManager (columns[i], True);
+    if (! (dm->isStorageManager()  &&  dm->canAccessConcurrently())) {
+      return False;
+    }
+  }
+  return True;
+}
+
+Vector<String> TableCopier::columnsToCopy (const Table& out, const Table& in)
+{
+  // Get all columns in the output table.
+  // If there are multiple columns, only take the stored ones.
+  TableRow outrow(out, out.tableDesc().ncolumn() > 1);
+  Vector<String> columns = outrow.columnNames();
+  const TableDesc& tdesc = in.tableDesc();
+  // Only copy the columns that exist in the input table.
+  Vector<String> cols(columns.nelements());
+  uInt nrcol = 0;
+  for (uInt i=0; i<columns.nelements(); i++) {
+    if (tdesc.isColumn (columns(i))) {
+      cols(nrcol++) = columns(i);
+    }
+  }
+  cols.resize (nrcol, True);
+  return cols;
+}
+
+Bool TableCopier::canCopy (const Table& out, const Table& in)
+{
+  // The output is written while the input is read, so they must differ.
+  if (out.isSameRoot (in)) {
+    return False;
+  }
+  Vector<String> columns = columnsToCopy (out, in);
+  for (uInt i=0; i<columns.size(); ++i) {
+    const ColumnDesc& incdesc  = in.tableDesc()[columns[i]];
+    const ColumnDesc& outcdesc = out.tableDesc()[columns[i]];
+    if (incdesc.dataType() != outcdesc.dataType()  ||
+        incdesc.isScalar() != outcdesc.isScalar()  ||
+        ! isCopierType (incdesc.dataType())) {
+      return False;
+    }
+  }
+  return True;
+}
+
+rownr_t TableCopier::makeBlockRows (rownr_t startin, rownr_t nrrow) const
+{
+  rownr_t nrow = blockRows_p;
+  if (nrow == 0) {
+    // Determine the size of a row from the first row to copy and round
+    // the number of rows to a multiple of the tile size.
+    Int64 rowBytes = 1;
+    rownr_t tileRows = 1;
+    for (uInt i=0; i<columns_p.size(); ++i) {
+      if (! tileCopied_p[i]) {
+        rowBytes += columns_p[i]->rowBytes (startin);
+        tileRows = std::max (tileRows, columns_p[i]->tileRows());
+      }
+    }
+    nrow = std::max (Int64(1), theBlockBytes / rowBytes);
+    nrow = (nrow + tileRows - 1) / tileRows * tileRows;
+  }
+  return std::min (nrow, nrrow);
+}
+
+Int64 TableCopier::readBlock (uInt slot, rownr_t startin, rownr_t nrow)
+{
+  Int64 nbytes = 0;
+  if (concurrent_p) {
+    // Read the columns of each group in a separate thread.
+    // An exception cannot leave a parallel loop, so rethrow it thereafter.
+    std::exception_ptr excp;
+    Int ngroup = groups_p.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads_p) reduction(+:nbytes)
+#endif
+    for (Int i=0; i<ngroup; ++i) {
+      try {
+        for (uInt col : groups_p[i]) {
+          if (! tileCopied_p[col]) {
+            nbytes += columns_p[col]->read (slot, startin, nrow, 1);
+          }
+        }
+      } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical(TableCopier_readBlock)
+#endif
+        {
+          if (!excp) {
+            excp = std::current_exception();
+          }
+        }
+      }
+    }
+    if (excp) {
+      std::rethrow_exception (excp);
+    }
+  } else {
+    for (uInt i=0; i<columns_p.size(); ++i) {
+      if (! tileCopied_p[i]) {
+        nbytes += columns_p[i]->read (slot, startin, nrow, nthreads_p);
+      }
+    }
+  }
+  return nbytes;
+}
+
+void TableCopier::writeBlock (uInt slot, rownr_t startout, rownr_t nrow)
+{
+  for (uInt i=0; i<columns_p.size(); ++i) {
+    if (! tileCopied_p[i]) {
+      columns_p[i]->write (slot, startout, nrow);
+    }
+  }
+}
+
+void TableCopier::copy (rownr_t startout, rownr_t startin, rownr_t nrrow)
+{
+  // Check if startin and nrrow are correct for input.
+  if (startin + nrrow > in_p.nrow()) {
+    throw TableError ("TableCopier: startin+nrrow exceed nr of input rows");
+  }
+  nbytes_p      = 0;
+  readTime_p    = 0;
+  writeTime_p   = 0;
+  elapsedTime_p = 0;
+  usedBlockRows_p = 0;
+  nrTileColumns_p = 0;
+  tileCopied_p.assign (columns_p.size(), False);
+  if (columns_p.empty()  ||  nrrow == 0) {
+    return;
+  }
+  Timer totalTimer;
+  // Add rows as needed.
+  if (startout + nrrow > out_p.nrow()) {
+    out_p.addRow (startout + nrrow - out_p.nrow());
+  }
+  // Tiles can only be copied if the entire table is copied.
+  if (startin == 0  &&  startout == 0  &&
+      nrrow == in_p.nrow()  &&  nrrow == out_p.nrow()) {
+    Timer timer;
+    copyTiles();
+    writeTime_p += timer.real();
+    if (nrTileColumns_p == columns_p.size()) {
+      elapsedTime_p = totalTimer.real();
+      return;
+    }
+  }
+  rownr_t blockRows = makeBlockRows (startin, nrrow);
+  usedBlockRows_p = blockRows;
+  rownr_t nblock = (nrrow + blockRows - 1) / blockRows;
+  std::unique_ptr<ProgressMeter> progress;
+  if (progress_p) {
+    progress.reset (new ProgressMeter(0, nrrow, "Copying " +
+                                      in_p.tableName()));
+  }
+  if (nblock == 1) {
+    // No need to use a writer thread.
+    Timer timer;
+    nbytes_p = readBlock (0, startin, nrrow);
+    readTime_p = timer.real();
+    timer.mark();
+    writeBlock (0, startout, nrrow);
+    writeTime_p = timer.real();
+  } else {
+    // The writer thread writes the blocks in the order they are read.
+    // A slot can only be filled again after the block in it is written.
+    std::mutex mutex;
+    std::condition_variable cond;
+    rownr_t nread    = 0;
+    rownr_t nwritten = 0;
+    Bool    stop    = False;
+    std::exception_ptr writeExcp;
+    std::thread writer ([&]() {
+      try {
+        for (rownr_t blk=0; blk<nblock; ++blk) {
+          {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait (lock, [&]{ return nread > blk  ||  stop; });
+            if (stop) {
+              return;
+            }
+          }
+          Timer timer;
+          rownr_t st = blk * blockRows;
+          writeBlock (blk % theNrSlots, startout + st,
+                      std::min (blockRows, nrrow - st));
+          writeTime_p += timer.real();
+          std::lock_guard<std::mutex> lock(mutex);
+          nwritten = blk + 1;
+          cond.notify_all();
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        writeExcp = std::current_exception();
+        stop = True;
+        cond.notify_all();
+      }
+    });
+    std::exception_ptr readExcp;
+    try {
+      for (rownr_t blk=0; blk<nblock; ++blk) {
+        rownr_t written;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          cond.wait (lock, [&]{ return blk < nwritten + theNrSlots  ||
+                                       stop; });
+          if (stop) {
+            break;
+          }
+          written = nwritten;
+        }
+        if (progress) {
+          progress->update (std::min (written * blockRows, nrrow));
+        }
+        Timer timer;
+        rownr_t st = blk * blockRows;
+        nbytes_p += readBlock (blk % theNrSlots, startin + st,
+                               std::min (blockRows, nrrow - st));
+        readTime_p += timer.real();
+        std::lock_guard<std::mutex> lock(mutex);
+        nread = blk + 1;
+        cond.notify_all();
+      }
+    } catch (...) {
+      readExcp = std::current_exception();
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = True;
+      cond.notify_all();
+    }
+    writer.join();
+    if (readExcp) {
+      std::rethrow_exception (readExcp);
+    }
+    if (writeExcp) {
+      std::rethrow_exception (writeExcp);
+    }
+  }
+  if (progress) {
+    progress->update (nrrow, True);
+  }
+  elapsedTime_p = totalTimer.real();
+}
+
+void TableCopier::copyTiles()
+{
+  // The data managers are only known for plain tables.
+  if (in_p.tableType() != Table::Plain  ||  !in_p.isRootTable()  ||
+      out_p.tableType() != Table::Plain  ||  !out_p.isRootTable()) {
+    return;
+  }
+  // Group the columns per data manager.
+  std::map<const DataManager*,std::vector<uInt>> dmColumns;
+  for (uInt i=0; i<columns_p.size(); ++i) {
+    dmColumns[in_p.findDataManager (columns_p[i]->name(), True)].push_back(i);
+  }
+  for (const auto& dmCols : dmColumns) {
+    const std::vector<uInt>& group = dmCols.second;
+    const String& name = columns_p[group[0]]->name();
+    TiledStMan* intsm  = dynamic_cast<TiledStMan*>
+                                 (in_p.findDataManager (name, True));
+    TiledStMan* outtsm = dynamic_cast<TiledStMan*>
+                                 (out_p.findDataManager (name, True));
+    // All columns of the storage managers have to be copied.
+    if (intsm == 0  ||  outtsm == 0  ||
+        intsm->ncolumn() != group.size()  ||
+        outtsm->ncolumn() != group.size()) {
+      continue;
+    }
+    Bool sameOut = True;
+    for (uInt col : group) {
+      if (out_p.findDataManager (columns_p[col]->name(), True) != outtsm) {
+        sameOut = False;
+      }
+    }
+    // The tiles are accessed directly, so the tables have to be locked.
+    TableLocker inLocker (in_p, FileLocker::Read);
+    TableLocker outLocker (out_p, FileLocker::Write);
+    Int64 nbytes;
+    if (sameOut  &&  outtsm->copyTiles (*intsm, nbytes)) {
+      for (uInt col : group) {
+        tileCopied_p[col] = True;
+      }
+      nrTileColumns_p += group.size();
+      nbytes_p += nbytes;
+    }
+  }
+}
+
+void TableCopier::showStatistics (ostream& os) const
+{
+  Double mbytes = nbytes_p / (1024. * 1024.);
+  os << "Copied " << mbytes << " MB in " << elapsedTime_p << " sec ("
+     << (elapsedTime_p > 0  ?  mbytes / elapsedTime_p : 0.) << " MB/sec)"
+     << endl;
+  os << "  block size " << usedBlockRows_p << " rows; read "
+     << readTime_p << " sec, write " << writeTime_p << " sec" << endl;
+  if (nrTileColumns_p > 0) {
+    os << "  " << nrTileColumns_p << " of " << columns_p.size()
+       << " columns copied as raw tiles" << endl;
+  }
+}
+
+
+} //# NAMESPACE CASACORE - END
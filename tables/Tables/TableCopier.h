@@ -0,0 +1,238 @@
+//# TableCopier.h: Copy the rows of a table using pipelined reads and writes
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_TABLECOPIER_H
+#define TABLES_TABLECOPIER_H
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/iosfwd.h>
+#include <memory>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward declarations
+class TableCopierColumn;
+
+
+// <summary>
+// Copy the rows of a table using pipelined reads and writes
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tTableCopier.cc">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=TableCopy>TableCopy</linkto>
+// </prerequisite>
+
+// <synopsis>
+// TableCopier copies the contents of the columns of a table to another
+// table in the same way as <src>TableCopy::copyRows</src>, but it does
+// not copy row by row. Instead the rows are copied in blocks, where
+// a block is read and written using the column range functions.
+// <br>The size of a block is determined from the size of the rows, where
+// the number of rows in a block is rounded to a multiple of the number
+// of rows in a tile of the tiled columns. In this way the tiled storage
+// managers can read and write entire tiles.
+// <p>
+// The copy is pipelined. While a block is written by a separate writer
+// thread, the next block is read by the calling thread. The columns are
+// read using multiple threads as far as possible. If the input table is
+// not opened with AutoLocking (e.g., with UserNoReadLocking), the columns
+// of each data manager that can be accessed concurrently (such as a tiled
+// storage manager using a sharded cache) are read by a separate thread,
+// while the columns of the other data managers are read together by one
+// thread. Furthermore, a tiled column that can be accessed concurrently
+// is read using multiple threads itself.
+// <p>
+// If all rows of a plain table are copied into a table with the same number
+// of rows, the columns of a tiled storage manager are copied by copying
+// the tiles as raw bytes if the hypercubes in input and output have the
+// same layout (see <src>TiledStMan::copyTiles</src>). This is the case for
+// a copy made by <src>Table::deepCopy</src> (without changing the data
+// managers). It avoids the conversion and caching of the data.
+// <p>
+// Blocks can only be used for columns with the same data type in input
+// and output, where the data type is one of the standard types.
+// The cells of an array column are copied one by one if their shapes
+// in a block vary or if some of them are undefined.
+// <src>canCopy</src> tells if a TableCopier can be used for the given
+// tables; otherwise <src>TableCopy::copyRows</src> copies row by row.
+// <p>
+// Optionally the progress is shown using a
+// <linkto class=ProgressMeter>ProgressMeter</linkto>. After the copy
+// the number of bytes copied and the time used are available, which can
+// be shown using <src>showStatistics</src>.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   Table in("my.ms", TableLock(TableLock::UserNoReadLocking));
+//   Table out = TableCopy::makeEmptyTable ("new.ms", Record(), in,
+//                                          Table::New,
+//                                          Table::AipsrcEndian,
+//                                          True, True);
+//   TableCopier copier(out, in);
+//   copier.setProgress (True);
+//   copier.copy();
+//   copier.showStatistics (cout);
+// </srcblock>
+// </example>
+
+// <motivation>
+// Making a physical copy of a large MeasurementSet row by row takes
+// a long time, because reading and writing are done sequentially
+// for each cell.
+// </motivation>
+
+class TableCopier
+{
+public:
+  // Set up the copy of the columns of the input table to the output table.
+  // Only the columns existing in both tables are copied. If the output
+  // table has multiple columns, only its stored columns are copied.
+  // <br>A value 0 for <src>nthreads</src> means using OMP::maxThreads().
+  // <br>An exception is thrown if <src>canCopy</src> is False.
+  TableCopier (Table& out, const Table& in, uInt nthreads=0);
+
+  ~TableCopier();
+
+  // Can the columns of the input table be copied to the output table by
+  // a TableCopier? That is the case if they are in different tables and
+  // if all columns to copy have the same standard data type in input and
+  // output.
+  static Bool canCopy (const Table& out, const Table& in);
+
+  // Can the columns to copy be read concurrently? That is only the case
+  // if all of them are stored by storage managers that can be accessed
+  // concurrently. Virtual columns are never read concurrently, because
+  // a virtual column engine can read columns of other data managers.
+  static Bool canReadConcurrently (const Table& out, const Table& in);
+
+  // Get the names of the columns to copy, thus the columns existing
+  // in both tables. If the output table has multiple columns, only
+  // its stored columns are taken into account.
+  static Vector<String> columnsToCopy (const Table& out, const Table& in);
+
+  // Set the number of rows in a block. The default value 0 means that
+  // it is determined from the row size.
+  void setBlockRows (rownr_t nrow)
+    { blockRows_p = nrow; }
+
+  // Show the progress (on stderr) while copying?
+  void setProgress (Bool showProgress)
+    { progress_p = showProgress; }
+
+  // Copy the given rows of the input table to the output table.
+  // Rows are added to the output table as needed.
+  // The version without arguments copies all rows.
+  // <group>
+  void copy (rownr_t startout, rownr_t startin, rownr_t nrrow);
+  void copy()
+    { copy (0, 0, in_p.nrow()); }
+  // </group>
+
+  // Get the number of rows in a block used by the last copy.
+  rownr_t blockRows() const
+    { return usedBlockRows_p; }
+
+  // Are the columns of different data managers read concurrently?
+  Bool readsConcurrently() const
+    { return concurrent_p; }
+
+  // Get the number of columns copied as raw tiles by the last copy.
+  uInt nrTileColumns() const
+    { return nrTileColumns_p; }
+
+  // Get the statistics of the last copy: the number of bytes copied,
+  // the time spent on reading and writing, and the elapsed time
+  // (all in seconds).
+  // <group>
+  Int64 nbytes() const
+    { return nbytes_p; }
+  Double readTime() const
+    { return readTime_p; }
+  Double writeTime() const
+    { return writeTime_p; }
+  Double elapsedTime() const
+    { return elapsedTime_p; }
+  // </group>
+
+  // Show the statistics of the last copy.
+  void showStatistics (ostream& os) const;
+
+private:
+  // Forbid copy constructor and assignment.
+  TableCopier (const TableCopier&);
+  TableCopier& operator= (const TableCopier&);
+
+  // Copy the columns of tiled storage managers with the same layout
+  // in input and output as raw tiles.
+  void copyTiles();
+
+  // Determine the number of rows in a block.
+  rownr_t makeBlockRows (rownr_t startin, rownr_t nrrow) const;
+
+  // Read the given rows of all columns into the given buffer slot.
+  // It returns the number of bytes read.
+  Int64 readBlock (uInt slot, rownr_t startin, rownr_t nrow);
+
+  // Write the given buffer slot into the given rows of all columns.
+  void writeBlock (uInt slot, rownr_t startout, rownr_t nrow);
+
+  //# Data members.
+  Table    out_p;
+  Table    in_p;
+  uInt     nthreads_p;
+  rownr_t  blockRows_p;
+  rownr_t  usedBlockRows_p;
+  Bool     progress_p;
+  Bool     concurrent_p;
+  std::vector<std::shared_ptr<TableCopierColumn>> columns_p;
+  // Tells for each column if it is copied as raw tiles.
+  std::vector<Bool> tileCopied_p;
+  uInt     nrTileColumns_p;
+  // The indices of the columns for each data manager of the input table
+  // that can be accessed concurrently. The columns of other data managers
+  // are in a single group.
+  std::vector<std::vector<uInt>> groups_p;
+  Int64    nbytes_p;
+  Double   readTime_p;
+  Double   writeTime_p;
+  Double   elapsedTime_p;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -26,6 +26,7 @@
 
 //# Includes
 #include <casacore/tables/Tables/TableCopy.h>
+#include <casacore/tables/Tables/TableCopier.h>
 #include <casacore/tables/Tables/SetupNewTab.h>
 #include <casacore/tables/Tables/TableRow.h>
 #include <casacore/tables/Tables/TableDesc.h>
@@ -38,6 +39,8 @@
 #include <casacore/casa/Utilities/LinearSearch.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/OS/Path.h>
+#include <casacore/casa/OS/OMP.h>
+#include <casacore/casa/System/AipsrcValue.h>
 #include <casacore/casa/BasicSL/String.h>
 
 
@@ -86,33 +89,37 @@ Table TableCopy::makeEmptyMemoryTable (const String& newName,
 }
 
 void TableCopy::copyRows (Table& out, const Table& in, rownr_t startout,
-			  rownr_t startin, rownr_t nrrow, Bool flush)
+			  rownr_t startin, rownr_t nrrow, Bool flush,
+                          Int nthreads)
 {
   // Check if startin and nrrow are correct for input.
   if (startin + nrrow > in.nrow()) {
     throw TableError ("TableCopy: startin+nrrow exceed nr of input rows");
   }
-  // Get all columns in the output table.
-  // If there are multiple columns, only take the stored ones.
-  TableRow outrow(out, out.tableDesc().ncolumn() > 1);
-  Vector<String> columns = outrow.columnNames();
-  const TableDesc& tdesc = in.tableDesc();
-  // Only copy the columns that exist in the input table.
-  Vector<String> cols(columns.nelements());
-  uInt nrcol = 0;
-  for (uInt i=0; i<columns.nelements(); i++) {
-    if (tdesc.isColumn (columns(i))) {
-      cols(nrcol++) = columns(i);
+  // Get the columns to copy.
+  Vector<String> cols = TableCopier::columnsToCopy (out, in);
+  if (cols.size() > 0) {
+    // Copy in blocks if multiple threads are requested and if possible.
+    if (nthreads < 0) {
+      nthreads = TableCopy::nthreads();
+    }
+    if (nthreads == 0) {
+      nthreads = OMP::maxThreads();
+    }
+    if (nthreads > 1  &&  TableCopier::canCopy (out, in)) {
+      TableCopier copier(out, in, nthreads);
+      copier.copy (startout, startin, nrrow);
+      if (flush) {
+        out.flush();
+      }
+      return;
     }
-  }
-  if (nrcol > 0) {
-    cols.resize (nrcol, True);
     // Add rows as needed.
     if (startout + nrrow > out.nrow()) {
       out.addRow (startout + nrrow - out.nrow());
     }
     ROTableRow inrow(in, cols);
-    outrow = TableRow(out, cols);
+    TableRow outrow(out, cols);
     for (rownr_t i=0; i<nrrow; i++) {
       inrow.get (startin + i);
       outrow.put (startout + i, inrow.record(), inrow.getDefined(), False);
@@ -123,6 +130,23 @@ void TableCopy::copyRows (Table& out, const Table& in, rownr_t startout,
   }
 }
 
+static uInt nthreadsKey()
+{
+  static const uInt key = AipsrcValue<Int>::registerRC
+    ("table.copy.nthreads", 1);
+  return key;
+}
+
+Int TableCopy::nthreads()
+{
+  return AipsrcValue<Int>::get (nthreadsKey());
+}
+
+void TableCopy::setNThreads (Int nthreads)
+{
+  AipsrcValue<Int>::set (nthreadsKey(), nthreads);
+}
+
 void TableCopy::copyInfo (Table& out, const Table& in)
 {
   out.tableInfo() = in.tableInfo();
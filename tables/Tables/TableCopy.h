@@ -112,12 +112,30 @@ public:
   // column with the same name in table <src>in</src>. In principle only
   // stored columns will be filled; however if the output table has only
   // one column, it can also be a virtual one.
+  // <br>By default the rows are copied row by row. If multiple threads
+  // are requested, the rows are copied in blocks using a
+  // <linkto class=TableCopier>TableCopier</linkto> if possible (see
+  // <src>TableCopier::canCopy</src>). It writes a block while reading the
+  // next one. The columns of different data managers are read in parallel
+  // as far as the data managers can be accessed concurrently.
+  // <br><src>nthreads</src> gives the number of threads to use;
+  // 0 means OMP::maxThreads() and -1 means using the default
+  // (see <src>nthreads</src> below).
   // <group>
-  static void copyRows (Table& out, const Table& in, Bool flush=True)
-    { copyRows (out, in, 0, 0, in.nrow(), flush); }
+  static void copyRows (Table& out, const Table& in, Bool flush=True,
+                        Int nthreads=-1)
+    { copyRows (out, in, 0, 0, in.nrow(), flush, nthreads); }
   static void copyRows (Table& out, const Table& in,
 			rownr_t startout, rownr_t startin, rownr_t nrrow,
-                        Bool flush=True);
+                        Bool flush=True, Int nthreads=-1);
+  // </group>
+
+  // Get or set the default number of threads used by <src>copyRows</src>,
+  // thus also by <src>Table::deepCopy</src>. It is given by the aipsrc
+  // variable <src>table.copy.nthreads</src> (default 1).
+  // <group>
+  static Int nthreads();
+  static void setNThreads (Int nthreads);
   // </group>
 
   // Copy the table info block from input to output table.
@@ -137,5 +137,12 @@ Bool TableLock::lockingDisabled()
 #endif
 }
 
+Bool TableLock::notificationEnabled()
+{
+  Bool opt;
+  AipsrcValue<Bool>::find (opt, "table.lock.notify", False);
+  return opt;
+}
+
 } //# NAMESPACE CASACORE - END
 
@@ -57,6 +57,10 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //
 // It is possible to disable locking by building casacore with -DAIPS_TABLE_NOLOCKING
 // or by setting the aipsrc variable table.nolocking=true.
+// <br>On Linux, setting the aipsrc variable table.lock.notify=true makes
+// the lock file be watched using inotify, so a process waiting for a lock
+// is woken up as soon as the lock is released and a process holding a
+// lock notices a lock request without waiting for the inspection interval.
 
 // <motivation> 
 // Encapsulate Table locking info.
@@ -163,6 +167,14 @@ public:
     // Is table locking disabled (because AIPS_TABLE_NOLOCKING or table.nolocking is set)?
     static Bool lockingDisabled();
 
+    // Should the lock file be watched for changes (using inotify) to
+    // acquire a lock or to release it on request without delay?
+    // It is set by the aipsrc variable table.lock.notify (default False).
+    // It should only be used for tables on a local file system, because
+    // changes made on other hosts are not noticed (in that case the
+    // inspection interval is still used).
+    static Bool notificationEnabled();
+
 
 private:
     LockOption  itsOption;
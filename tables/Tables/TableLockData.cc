@@ -57,6 +57,9 @@ void TableLockData::makeLock (const String& name, Bool create,
 	itsLock = new LockFile (name + "/table.lock", interval(), create,
 				True, False, locknr, isPermanent(),
                                 option() == NoLocking);
+        if (option() != NoLocking  &&  notificationEnabled()) {
+            itsLock->enableNotification();
+        }
     }
     //# Acquire a lock when permanent locking is in use.
     if (isPermanent()) {
@@ -112,6 +112,10 @@ public:
     // Get the modify counter.
     uInt getModifyCounter() const;
 
+    // Get the change counter of the i-th data manager.
+    // It is 0 if not known.
+    uInt getDataManChangeCounter (uInt i) const;
+
 
 private:
     //# Member variables.
@@ -134,6 +138,11 @@ inline uInt TableSyncData::getModifyCounter() const
 {
     return itsModifyCounter;
 }
+inline uInt TableSyncData::getDataManChangeCounter (uInt i) const
+{
+    return (i < itsDataManChangeCounter.nelements()  ?
+            itsDataManChangeCounter[i] : 0);
+}
 
 
 
@@ -0,0 +1,244 @@
+//# tPersistentColumnIndex.cc: Test program for class PersistentColumnIndex
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables/PersistentColumnIndex.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/IO/ArrayIO.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+// <summary>
+// Test program for class PersistentColumnIndex
+// </summary>
+
+
+// Check that a selection gives the same rows as evaluating the expression
+// for each row.
+void checkSelect (const Table& tab, const TableExprNode& expr,
+                  rownr_t expNr)
+{
+    std::vector<rownr_t> exp;
+    for (rownr_t i=0; i<tab.nrow(); ++i) {
+        Bool val;
+        expr.get (i, val);
+        if (val) {
+            exp.push_back (i);
+        }
+    }
+    Table sel = tab(expr);
+    Vector<rownr_t> rows = sel.rowNumbers (tab);
+    if (rows.size() != exp.size()  ||  !allEQ (rows, Vector<rownr_t>(exp))) {
+        cout << "Selection mismatch: " << rows.size() << " rows selected, "
+             << exp.size() << " expected" << endl;
+        AlwaysAssertExit (False);
+    }
+    AlwaysAssertExit (rows.size() == expNr);
+}
+
+// Create the table.
+void a()
+{
+    TableDesc td;
+    td.addColumn (ScalarColumnDesc<Int>("ANT"));
+    td.addColumn (ScalarColumnDesc<Double>("TIME"));
+    td.addColumn (ScalarColumnDesc<String>("NAME"));
+    td.addColumn (ScalarColumnDesc<Int64>("ID"));
+    SetupNewTable newtab("tPersistentColumnIndex_tmp.data", td, Table::New);
+    Table tab(newtab, 1000);
+    ScalarColumn<Int> ant(tab, "ANT");
+    ScalarColumn<Double> time(tab, "TIME");
+    for (uInt i=0; i<1000; ++i) {
+        ant.put (i, (999-i) % 10);
+        time.put (i, i*0.5);
+    }
+    time.put (10, doubleNaN());
+    PersistentColumnIndex::create (tab, "ANT");
+    PersistentColumnIndex::create (tab, "TIME");
+    // A String column cannot be indexed.
+    Bool ok = False;
+    try {
+        PersistentColumnIndex::create (tab, "NAME");
+    } catch (const AipsError& x) {
+        ok = True;
+    }
+    AlwaysAssertExit (ok);
+    // Neither can an Int64 column.
+    ok = False;
+    try {
+        PersistentColumnIndex::create (tab, "ID");
+    } catch (const AipsError& x) {
+        ok = True;
+    }
+    AlwaysAssertExit (ok);
+    Vector<String> names =
+      PersistentColumnIndex::indexedColumns ("tPersistentColumnIndex_tmp.data");
+    AlwaysAssertExit (names.size() == 2);
+    AlwaysAssertExit (names[0] == "ANT"  &&  names[1] == "TIME");
+    cout << "created indices for " << names << endl;
+}
+
+// Use the index directly.
+void b()
+{
+    PersistentColumnIndex index ("tPersistentColumnIndex_tmp.data", "ANT");
+    AlwaysAssertExit (index.columnName() == "ANT");
+    AlwaysAssertExit (index.nrow() == 1000);
+    AlwaysAssertExit (index.nvalues() == 1000);
+    Vector<rownr_t> rows = index.getRowNumbers (3, 3);
+    AlwaysAssertExit (rows.size() == 100);
+    for (uInt i=0; i<rows.size(); ++i) {
+        AlwaysAssertExit (rows[i] == 6 + 10*i);
+    }
+    rows = index.getRowNumbers (Vector<Double>(2, 2.), Vector<Double>(2, 3.));
+    AlwaysAssertExit (rows.size() == 200);
+    AlwaysAssertExit (index.getRowNumbers (3.5, 3.5).empty());
+    AlwaysAssertExit (index.getRowNumbers (20, 10).empty());
+    // The NaN value is not part of the index.
+    PersistentColumnIndex tindex ("tPersistentColumnIndex_tmp.data", "TIME");
+    AlwaysAssertExit (tindex.nvalues() == 999);
+    rows = tindex.getRowNumbers (4, 6);
+    AlwaysAssertExit (rows.size() == 4);
+    AlwaysAssertExit (rows[0] == 8  &&  rows[1] == 9  &&  rows[2] == 11);
+}
+
+// Select using the indices and update the table.
+void c()
+{
+    Table tab("tPersistentColumnIndex_tmp.data", Table::Update);
+    checkSelect (tab, tab.col("ANT") == 3, 100);
+    checkSelect (tab, 3 == tab.col("ANT"), 100);
+    checkSelect (tab, tab.col("ANT") == 3  &&  tab.col("TIME") > 100, 80);
+    checkSelect (tab, tab.col("ANT") == 3  &&  tab.col("TIME") >= 103, 80);
+    checkSelect (tab, tab.col("ANT") >= 8  ||  tab.col("ANT") < 1, 300);
+    checkSelect (tab, tab.col("TIME") < 5, 10);
+    checkSelect (tab, tab.col("ANT") == 3.5, 0);
+    checkSelect (tab, tab.col("ANT") == 3  &&  tab.col("ANT") == 4, 0);
+    checkSelect (tab, !(tab.col("ANT") == 3), 900);
+    checkSelect (tab, tab.col("ANT") == 3  ||  tab.col("TIME") < 5, 109);
+    // Change some values; the index is updated when used.
+    ScalarColumn<Int> ant(tab, "ANT");
+    ant.put (5, 3);
+    ant.put (999, 3);
+    checkSelect (tab, tab.col("ANT") == 3, 102);
+    // Add rows and check the index has been updated by the flush.
+    tab.addRow (10);
+    ScalarColumn<Double> time(tab, "TIME");
+    for (uInt i=1000; i<1010; ++i) {
+        ant.put (i, 3);
+        time.put (i, i*0.5);
+    }
+    tab.flush();
+    {
+        PersistentColumnIndex index ("tPersistentColumnIndex_tmp.data", "ANT");
+        AlwaysAssertExit (index.nrow() == 1010);
+        AlwaysAssertExit (index.getRowNumbers (3, 3).size() == 112);
+    }
+    checkSelect (tab, tab.col("ANT") == 3  &&  tab.col("TIME") > 400, 31);
+    // Removing rows shifts the row numbers.
+    tab.removeRow (0);
+    tab.removeRow (0);
+    checkSelect (tab, tab.col("ANT") == 3, 112);
+    checkSelect (tab, tab.col("TIME") >= 4  &&  tab.col("TIME") <= 6, 4);
+    cout << "selections using indices are correct" << endl;
+}
+
+// Reopen the table, rename a column and remove an index.
+void d()
+{
+    Table tab("tPersistentColumnIndex_tmp.data", Table::Update);
+    checkSelect (tab, tab.col("ANT") == 3, 112);
+    tab.renameColumn ("ANTENNA", "ANT");
+    checkSelect (tab, tab.col("ANTENNA") == 3, 112);
+    AlwaysAssertExit (File(PersistentColumnIndex::fileName
+                           ("tPersistentColumnIndex_tmp.data",
+                            "ANTENNA")).exists());
+    PersistentColumnIndex::remove (tab, "TIME");
+    Vector<String> names =
+      PersistentColumnIndex::indexedColumns ("tPersistentColumnIndex_tmp.data");
+    AlwaysAssertExit (names.size() == 1  &&  names[0] == "ANTENNA");
+    checkSelect (tab, tab.col("TIME") < 5, 8);
+    tab.removeColumn ("ANTENNA");
+    AlwaysAssertExit (PersistentColumnIndex::indexedColumns
+                      ("tPersistentColumnIndex_tmp.data").empty());
+    cout << "renamed and removed indices" << endl;
+}
+
+// An index outdated by a change made without updating the index
+// must not be used.
+void e()
+{
+    String idxName = PersistentColumnIndex::fileName
+      ("tPersistentColumnIndex_tmp.data", "TIME");
+    {
+        Table tab("tPersistentColumnIndex_tmp.data", Table::Update);
+        PersistentColumnIndex::create (tab, "TIME");
+        tab.flush();
+        RegularFile(idxName).copy (idxName + "_old");
+        // Change a value, but not the number of rows.
+        ScalarColumn<Double> time(tab, "TIME");
+        time.put (0, 1000.);
+    }
+    // Put back the old index as if the change was made by a process
+    // not knowing about it.
+    RegularFile(idxName + "_old").move (idxName);
+    {
+        // The outdated index cannot be rebuilt in a readonly table.
+        Table tab("tPersistentColumnIndex_tmp.data");
+        checkSelect (tab, tab.col("TIME") == 1000., 1);
+        checkSelect (tab, tab.col("TIME") == 1., 0);
+    }
+    Table tab("tPersistentColumnIndex_tmp.data", Table::Update);
+    checkSelect (tab, tab.col("TIME") == 1000., 1);
+    PersistentColumnIndex index ("tPersistentColumnIndex_tmp.data", "TIME");
+    AlwaysAssertExit (index.getRowNumbers (1000, 1000).size() == 1);
+    cout << "outdated index is not used" << endl;
+}
+
+int main()
+{
+    try {
+        a();
+        b();
+        c();
+        d();
+        e();
+    } catch (const std::exception& x) {
+        cout << "Exception caught: " << x.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -28,10 +28,17 @@
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/ScaColDesc.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/RefTable.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayUtil.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
 #include <casacore/casa/stdio.h>
+#include <thread>
+#include <vector>
 
 #include <casacore/casa/namespace.h>
 
@@ -106,6 +113,89 @@ void makeRef()
   readTab ("tRefTable_tmp.dataref", 10, 4);
 }
 
+// Check the row numbers of a persistent selection.
+void checkRows (const String& name, const Vector<rownr_t>& expRows)
+{
+  Table tab(name);
+  // Get the column first, so slices are used before being expanded.
+  ScalarColumn<Int> col(tab, "ab");
+  Vector<Int> vals = col.getColumn();
+  AlwaysAssertExit (vals.size() == expRows.size());
+  for (uInt i=0; i<vals.size(); ++i) {
+    AlwaysAssertExit (vals[i] == Int(expRows[i]));
+  }
+  AlwaysAssertExit (allEQ (tab.rowNumbers(), expRows));
+}
+
+void doRanges()
+{
+  cout << "test row ranges" << endl;
+  TableDesc td("", "1", TableDesc::Scratch);
+  td.addColumn (ScalarColumnDesc<Int>("ab"));
+  SetupNewTable newtab("tRefTable_tmp.rng", td, Table::New);
+  Table tab(newtab, 1000);
+  ScalarColumn<Int> ab(tab,"ab");
+  for (Int i=0; i<1000; i++) {
+    ab.put (i, i);
+  }
+  // By default, row ranges are not stored as slices.
+  Table sel1 = tab(tab.col("ab") < 100  ||  tab.col("ab") >= 500);
+  Vector<rownr_t> rows1 = sel1.rowNumbers();
+  AlwaysAssertExit (! RefTable::writeSlices());
+  Table(tab(tab.col("ab") < 100  ||  tab.col("ab") >= 500))
+    .rename ("tRefTable_tmp.rng0", Table::New);
+  // If enabled, a selection of row ranges is stored as slices.
+  RefTable::setWriteSlices (True);
+  sel1.rename ("tRefTable_tmp.rng1", Table::New);
+  // Scattered rows are stored as is.
+  Table sel2 = tab(tab.col("ab") % 3 == 0);
+  Vector<rownr_t> rows2 = sel2.rowNumbers();
+  sel2.rename ("tRefTable_tmp.rng2", Table::New);
+  // A sorted selection has no simple ranges.
+  Table sel3 = sel1.sort ("ab", Sort::Descending);
+  Vector<rownr_t> rows3 = sel3.rowNumbers();
+  sel3.rename ("tRefTable_tmp.rng3", Table::New);
+  sel1 = Table();
+  sel2 = Table();
+  sel3 = Table();
+  RefTable::setWriteSlices (False);
+  // The slices take much less space than the 334 or 600 row numbers.
+  AlwaysAssertExit (RegularFile("tRefTable_tmp.rng1/table.dat").size() + 1000 <
+                    RegularFile("tRefTable_tmp.rng2/table.dat").size());
+  AlwaysAssertExit (RegularFile("tRefTable_tmp.rng1/table.dat").size() + 1000 <
+                    RegularFile("tRefTable_tmp.rng0/table.dat").size());
+  checkRows ("tRefTable_tmp.rng0", rows1);
+  checkRows ("tRefTable_tmp.rng1", rows1);
+  // The slices can be expanded by multiple threads at the same time.
+  {
+    Table tab1("tRefTable_tmp.rng1");
+    std::vector<std::thread> threads;
+    std::vector<Int> ok(4, 0);
+    for (uInt i=0; i<ok.size(); ++i) {
+      threads.emplace_back ([&tab1, &rows1, &ok, i]()
+                            { ok[i] = allEQ (tab1.rowNumbers(), rows1); });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    for (Int okThread : ok) {
+      AlwaysAssertExit (okThread);
+    }
+  }
+  checkRows ("tRefTable_tmp.rng2", rows2);
+  checkRows ("tRefTable_tmp.rng3", rows3);
+  // Removing a row from a table read as slices updates the row numbers.
+  {
+    Table tab1("tRefTable_tmp.rng1", Table::Update);
+    ScalarColumn<Int> col(tab1, "ab");
+    AlwaysAssertExit (col(100) == 500);
+    tab1.removeRow (100);
+    AlwaysAssertExit (col(100) == 501);
+  }
+  checkRows ("tRefTable_tmp.rng1",
+             concatenateArray (rows1(Slice(0,100)), rows1(Slice(101,499))));
+}
+
 int main()
 {
   try {
@@ -113,6 +203,7 @@ int main()
     makeRef();
     readTab ("tRefTable_tmp.data", 10, 5);
     readTab ("tRefTable_tmp.dataref", 10, 4);
+    doRanges();
   } catch (std::exception& x) {
     cout << "Caught an exception: " << x.what() << endl;
     return 1;
@@ -0,0 +1,290 @@
+//# tTableCopier.cc: Test program for class TableCopier
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables.h>
+#include <casacore/tables/DataMan/IncrementalStMan.h>
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <stdexcept>
+#include <iostream>
+using namespace casacore;
+using namespace std;
+
+// <summary>
+// Test program for class TableCopier.
+// </summary>
+
+// Create the input table.
+// DATA is a fixed shape tiled column, WEIGHT a variable shaped one
+// where some cells are undefined.
+void makeTable (const String& name, rownr_t nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Double>("TIME"));
+  td.addColumn (ScalarColumnDesc<Int>("ANTENNA"));
+  td.addColumn (ScalarColumnDesc<String>("NAME"));
+  td.addColumn (ScalarColumnDesc<Bool>("FLAG_ROW"));
+  td.addColumn (ArrayColumnDesc<Complex>("DATA", IPosition(2,4,8),
+                                         ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Float>("WEIGHT", 1));
+  td.addColumn (ArrayColumnDesc<Int>("IDS", 1));
+  SetupNewTable newtab(name, td, Table::New);
+  StandardStMan ssm("SSM", 1024);
+  IncrementalStMan ism("ISM");
+  TiledColumnStMan tcsm("TCSM", IPosition(3,4,8,16));
+  TiledShapeStMan tssm("TSSM", IPosition(2,8,5));
+  newtab.bindAll (ssm);
+  newtab.bindColumn ("ANTENNA", ism);
+  newtab.bindColumn ("DATA", tcsm);
+  newtab.bindColumn ("WEIGHT", tssm);
+  Table tab(newtab, nrow);
+  ScalarColumn<Double> time(tab, "TIME");
+  ScalarColumn<Int> ant(tab, "ANTENNA");
+  ScalarColumn<String> names(tab, "NAME");
+  ScalarColumn<Bool> flag(tab, "FLAG_ROW");
+  ArrayColumn<Complex> data(tab, "DATA");
+  ArrayColumn<Float> weight(tab, "WEIGHT");
+  ArrayColumn<Int> ids(tab, "IDS");
+  Array<Complex> arr(IPosition(2,4,8));
+  for (rownr_t i=0; i<nrow; ++i) {
+    time.put (i, i*10.);
+    ant.put (i, i/20);
+    names.put (i, "name" + String::toString(i));
+    flag.put (i, i%3 == 0);
+    indgen (arr, Complex(i, -Float(i)));
+    data.put (i, arr);
+    // WEIGHT has the same shape for most rows.
+    if (i%50 != 7) {
+      Vector<Float> vec(i < nrow/2 ? 8 : 1 + i%4);
+      indgen (vec, Float(i));
+      weight.put (i, vec);
+    }
+    if (i%5 != 0) {
+      ids.put (i, Vector<Int>(i%4, i));
+    }
+  }
+}
+
+// Check if the output table has the same contents as the input table.
+void checkTable (const Table& out, const Table& in, rownr_t startout,
+                 rownr_t startin, rownr_t nrow)
+{
+  AlwaysAssertExit (out.nrow() >= startout + nrow);
+  const TableDesc& td = in.tableDesc();
+  for (uInt j=0; j<td.ncolumn(); ++j) {
+    const String& name = td[j].name();
+    TableColumn incol(in, name);
+    TableColumn outcol(out, name);
+    for (rownr_t i=0; i<nrow; ++i) {
+      AlwaysAssertExit (incol.isDefined(startin+i) ==
+                        outcol.isDefined(startout+i));
+    }
+  }
+  ScalarColumn<Double> intime(in, "TIME");
+  ScalarColumn<Double> outtime(out, "TIME");
+  ScalarColumn<String> inname(in, "NAME");
+  ScalarColumn<String> outname(out, "NAME");
+  ScalarColumn<Int> inant(in, "ANTENNA");
+  ScalarColumn<Int> outant(out, "ANTENNA");
+  ScalarColumn<Bool> inflag(in, "FLAG_ROW");
+  ScalarColumn<Bool> outflag(out, "FLAG_ROW");
+  ArrayColumn<Complex> indata(in, "DATA");
+  ArrayColumn<Complex> outdata(out, "DATA");
+  ArrayColumn<Float> inweight(in, "WEIGHT");
+  ArrayColumn<Float> outweight(out, "WEIGHT");
+  ArrayColumn<Int> inids(in, "IDS");
+  ArrayColumn<Int> outids(out, "IDS");
+  for (rownr_t i=0; i<nrow; ++i) {
+    rownr_t ri = startin+i;
+    rownr_t ro = startout+i;
+    AlwaysAssertExit (intime(ri) == outtime(ro));
+    AlwaysAssertExit (inname(ri) == outname(ro));
+    AlwaysAssertExit (inant(ri) == outant(ro));
+    AlwaysAssertExit (inflag(ri) == outflag(ro));
+    AlwaysAssertExit (allEQ (indata(ri), outdata(ro)));
+    if (inweight.isDefined(ri)) {
+      AlwaysAssertExit (inweight.shape(ri).isEqual (outweight.shape(ro)));
+      AlwaysAssertExit (allEQ (inweight(ri), outweight(ro)));
+    }
+    if (inids.isDefined(ri)) {
+      AlwaysAssertExit (inids.shape(ri).isEqual (outids.shape(ro)));
+      AlwaysAssertExit (allEQ (inids(ri), outids(ro)));
+    }
+  }
+}
+
+// Copy using the given block size and number of threads.
+// <src>concurrent</src> tells if columns are expected to be read concurrently.
+void testCopy (const Table& in, rownr_t blockRows, uInt nthreads,
+               Bool concurrent)
+{
+  Table out = TableCopy::makeEmptyTable ("tTableCopier_tmp.copy", Record(),
+                                         in, Table::New,
+                                         Table::AipsrcEndian, True, True);
+  AlwaysAssertExit (TableCopier::canCopy (out, in));
+  // SSM and ISM cannot be read concurrently.
+  AlwaysAssertExit (! TableCopier::canReadConcurrently (out, in));
+  TableCopier copier(out, in, nthreads);
+  AlwaysAssertExit (copier.readsConcurrently() == concurrent);
+  copier.setBlockRows (blockRows);
+  copier.copy();
+  AlwaysAssertExit (out.nrow() == in.nrow());
+  // The tiled columns DATA and WEIGHT are copied as raw tiles.
+  AlwaysAssertExit (copier.nrTileColumns() == 2);
+  if (blockRows > 0) {
+    AlwaysAssertExit (copier.blockRows() == std::min(blockRows, in.nrow()));
+  }
+  AlwaysAssertExit (copier.nbytes() > 0);
+  checkTable (out, in, 0, 0, in.nrow());
+  // Copy part of the table to the end of the output.
+  copier.copy (out.nrow(), 13, 111);
+  AlwaysAssertExit (copier.nrTileColumns() == 0);
+  AlwaysAssertExit (out.nrow() == in.nrow() + 111);
+  checkTable (out, in, in.nrow(), 13, 111);
+  // Check the contents after reopening the copy.
+  out = Table();
+  Table tab("tTableCopier_tmp.copy");
+  checkTable (tab, in, 0, 0, in.nrow());
+  checkTable (tab, in, in.nrow(), 13, 111);
+}
+
+// Copy into a table where DATA has another tile shape, so only the
+// tiles of WEIGHT can be copied directly.
+void testTileShape (const Table& in)
+{
+  SetupNewTable newtab("tTableCopier_tmp.copy", in.tableDesc(), Table::New);
+  StandardStMan ssm("SSM", 1024);
+  TiledColumnStMan tcsm("TCSM", IPosition(3,4,8,32));
+  TiledShapeStMan tssm("TSSM", IPosition(2,8,5));
+  newtab.bindAll (ssm);
+  newtab.bindColumn ("DATA", tcsm);
+  newtab.bindColumn ("WEIGHT", tssm);
+  Table out(newtab, in.nrow());
+  TableCopier copier(out, in);
+  copier.copy();
+  AlwaysAssertExit (copier.nrTileColumns() == 1);
+  checkTable (out, in, 0, 0, in.nrow());
+}
+
+// Copy a selection of the table, thus using a RefTable.
+void testSelection (const Table& in)
+{
+  Table sel = in(in.col("ANTENNA") > 3);
+  AlwaysAssertExit (sel.nrow() > 0);
+  Table out = TableCopy::makeEmptyTable ("tTableCopier_tmp.copy", Record(),
+                                         sel, Table::New,
+                                         Table::AipsrcEndian, True, True);
+  TableCopier copier(out, sel, 2);
+  copier.setBlockRows (20);
+  copier.copy();
+  checkTable (out, sel, 0, 0, sel.nrow());
+}
+
+// Check that copying row by row is done if data types differ.
+void testFallback (const Table& in)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Float>("TIME"));
+  td.addColumn (ScalarColumnDesc<Int>("ANTENNA"));
+  SetupNewTable newtab("tTableCopier_tmp.copy", td, Table::New);
+  Table out(newtab);
+  AlwaysAssertExit (! TableCopier::canCopy (out, in));
+  AlwaysAssertExit (! TableCopier::canCopy (in, in));
+  bool failed = false;
+  try {
+    TableCopier copier(out, in);
+  } catch (const TableError&) {
+    failed = true;
+  }
+  AlwaysAssertExit (failed);
+  TableCopy::copyRows (out, in, True, 4);
+  AlwaysAssertExit (out.nrow() == in.nrow());
+  ScalarColumn<Float> outtime(out, "TIME");
+  ScalarColumn<Int> outant(out, "ANTENNA");
+  for (rownr_t i=0; i<out.nrow(); ++i) {
+    AlwaysAssertExit (outtime(i) == Float(i*10.));
+    AlwaysAssertExit (outant(i) == Int(i/20));
+  }
+}
+
+int main()
+{
+  try {
+    makeTable ("tTableCopier_tmp.data", 500);
+    {
+      // Use AutoLocking, so the columns are read sequentially.
+      Table in("tTableCopier_tmp.data");
+      testCopy (in, 0, 1, False);
+      testCopy (in, 7, 2, False);
+      testCopy (in, 64, 4, False);
+      testSelection (in);
+      testTileShape (in);
+      testFallback (in);
+    }
+    {
+      // Without read locking the columns could be read concurrently,
+      // but none of the storage managers can be accessed concurrently.
+      Table in("tTableCopier_tmp.data",
+               TableLock(TableLock::UserNoReadLocking));
+      testCopy (in, 16, 4, False);
+      testCopy (in, 1000, 2, False);
+      // A deep copy only uses the TableCopier if multiple threads are
+      // requested.
+      AlwaysAssertExit (TableCopy::nthreads() == 1);
+      in.deepCopy ("tTableCopier_tmp.deep", Table::New);
+      Table deep("tTableCopier_tmp.deep");
+      checkTable (deep, in, 0, 0, in.nrow());
+    }
+    {
+      // With a sharded cache DATA (in a TiledColumnStMan) can be accessed
+      // concurrently, so it is read in parallel with the other columns.
+      Table in("tTableCopier_tmp.data",
+               TableLock(TableLock::UserNoReadLocking), Table::Old,
+               TSMOption(TSMOption::Cache, 0, 0, 0, 4));
+      testCopy (in, 16, 4, True);
+      testCopy (in, 0, 1, False);
+      // Let a deep copy use the TableCopier.
+      TableCopy::setNThreads (4);
+      in.deepCopy ("tTableCopier_tmp.deep", Table::New);
+      TableCopy::setNThreads (1);
+      Table deep("tTableCopier_tmp.deep");
+      checkTable (deep, in, 0, 0, in.nrow());
+      // Copy a selection (thus in blocks) using copyRows.
+      Table sel = in(in.col("ANTENNA") > 3);
+      Table out = TableCopy::makeEmptyTable ("tTableCopier_tmp.copy",
+                                             Record(), sel, Table::New,
+                                             Table::AipsrcEndian, True, True);
+      TableCopy::copyRows (out, sel, True, 4);
+      checkTable (out, sel, 0, 0, sel.nrow());
+    }
+  } catch (const std::exception& x) {
+    cout << "Exception caught: " << x.what() << endl;
+    return 1;
+  }
+  cout << "ok" << endl;
+  return 0;
+}
@@ -0,0 +1,110 @@
+//# tablecopy.cc: This program makes a deep copy of a table
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: casa-feedback@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableCopier.h>
+#include <casacore/tables/Tables/TableCopy.h>
+#include <casacore/tables/Tables/TableLock.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/OS/Timer.h>
+#include <stdexcept>
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+
+using namespace casacore;
+using namespace std;
+
+void showUsage()
+{
+  cerr << "Run as:  tablecopy [-n nthreads] [-b blockrows] [-q] intable outtable"
+       << endl;
+  cerr << "         -n   number of threads to read (default all cores)"
+       << endl;
+  cerr << "         -b   number of rows per block (default determined"
+       << " from row size)" << endl;
+  cerr << "         -q   do not show the progress" << endl;
+  cerr << "  The output table gets the same data managers as the input table,"
+       << endl;
+  cerr << "  where TiledDataStMan is replaced by TiledShapeStMan." << endl;
+}
+
+int main (int argc, char* argv[])
+{
+  try {
+    uInt nthreads = 0;
+    rownr_t blockRows = 0;
+    Bool showProgress = True;
+    vector<String> names;
+    for (int argnr=1; argnr<argc; ++argnr) {
+      String arg(argv[argnr]);
+      if (arg == "-n"  &&  argnr+1 < argc) {
+        nthreads = atoi (argv[++argnr]);
+      } else if (arg == "-b"  &&  argnr+1 < argc) {
+        blockRows = atol (argv[++argnr]);
+      } else if (arg == "-q") {
+        showProgress = False;
+      } else if (arg.size() > 0  &&  arg[0] == '-') {
+        showUsage();
+        return 1;
+      } else {
+        names.push_back (arg);
+      }
+    }
+    if (names.size() != 2) {
+      showUsage();
+      return 1;
+    }
+    // Open the input without read locking, so the columns of different
+    // data managers can be read concurrently.
+    Table in(names[0], TableLock(TableLock::UserNoReadLocking));
+    Table out = TableCopy::makeEmptyTable (names[1], Record(), in,
+                                           Table::NewNoReplace,
+                                           Table::AipsrcEndian, True, True);
+    Timer timer;
+    if (TableCopier::canCopy (out, in)) {
+      TableCopier copier(out, in, nthreads);
+      copier.setBlockRows (blockRows);
+      copier.setProgress (showProgress);
+      copier.copy();
+      copier.showStatistics (cout);
+    } else {
+      cout << "tablecopy: columns cannot be copied in blocks;"
+           << " copying row by row" << endl;
+      TableCopy::copyRows (out, in, False);
+    }
+    out.flush();
+    TableCopy::copyInfo (out, in);
+    TableCopy::copySubTables (out, in);
+    cout << "Copied " << in.nrow() << " rows of " << in.tableName()
+         << " to " << out.tableName() << " in " << timer.real()
+         << " sec" << endl;
+  } catch (const std::exception& x) {
+    cerr << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -722,7 +722,7 @@ Table taqlCommand (const Options& options, const String& varName,
     }
     String s = command.substr(spos, epos-spos);
     s.downcase();
-    showHelp = (s=="show" || s=="help");
+    showHelp = (s=="show" || s=="help" || s=="explain");
     addComm = !(s=="with" || s=="select" || s=="update" || s=="insert" ||
                 s=="calc" || s=="delete" || s=="count"  || 
                 s=="create" || s=="createtable" ||